@@ -0,0 +1,139 @@
+#include <cstring>
+#include "fdcan_bus.hpp"
+#include "main.h"
+
+// TX complete for every TX FIFO element (TxFifoQueueElmtsNbr = 8)
+static constexpr uint32_t FDCAN_TX_FIFO_BUFFERS = 0xFFU;
+
+// Payload bytes for each DLC code, 9 to 15 only go past 8 bytes on FD frames
+static constexpr uint8_t DLC_TO_LENGTH[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64};
+static_assert(FDCAN_DLC_BYTES_8 == 8 && FDCAN_DLC_BYTES_64 == 15, "HAL DLC codes are used as table indices");
+
+// Data phase time quanta per bit, the widest split the kernel clock divides into wins
+static constexpr uint32_t FD_DATA_MIN_TQ = 8;
+static constexpr uint32_t FD_DATA_MAX_TQ = 25;
+static constexpr uint32_t FD_DATA_MAX_PRESCALER = 32;
+
+FDCANBus::FDCANBus(FDCAN_HandleTypeDef *hfdcan) : hfdcan(hfdcan), filters{}, filterCount(0), filtersRejected(false), fdEnabled(false) {}
+
+void FDCANBus::init() {
+    #if CANARD_ENABLE_CANFD
+        fdEnabled = enableFd();
+    #endif
+
+    // ExtFiltersNbr in MX_FDCAN1_Init is smaller than the filter list, running open would bury the bus task in traffic
+    if (filtersRejected) {
+        Error_Handler();
+    }
+    configureFilters();
+
+    // RX and TX complete wake the bus task, message lost and bus off are counted
+    HAL_FDCAN_ActivateNotification(hfdcan, FDCAN_IT_BUS_OFF, 0);
+    HAL_FDCAN_ActivateNotification(hfdcan, FDCAN_IT_RX_FIFO0_NEW_MESSAGE | FDCAN_IT_RX_FIFO0_MESSAGE_LOST, 0);
+    HAL_FDCAN_ActivateNotification(hfdcan, FDCAN_IT_TX_COMPLETE, FDCAN_TX_FIFO_BUFFERS);
+
+    if (HAL_FDCAN_Start(hfdcan) != HAL_OK) {
+        Error_Handler();
+    }
+}
+
+bool FDCANBus::enableFd() {
+    // CubeMX sets up classic CAN, the data phase timing comes from whatever kernel clock it chose
+    const uint32_t kernelHz = HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_FDCAN);
+
+    for (uint32_t tq = FD_DATA_MAX_TQ; tq >= FD_DATA_MIN_TQ; tq--) {
+        const uint32_t tqHz = CAN_FD_DATA_BITRATE_BPS * tq;
+        if (kernelHz % tqHz != 0 || kernelHz / tqHz > FD_DATA_MAX_PRESCALER) continue;
+
+        // Sample point at 75%
+        const uint32_t seg2 = tq / 4;
+        hfdcan->Init.FrameFormat = FDCAN_FRAME_FD_BRS;
+        hfdcan->Init.DataPrescaler = kernelHz / tqHz;
+        hfdcan->Init.DataTimeSeg1 = tq - 1 - seg2;
+        hfdcan->Init.DataTimeSeg2 = seg2;
+        hfdcan->Init.DataSyncJumpWidth = seg2;
+        hfdcan->Init.RxFifo0ElmtSize = FDCAN_DATA_BYTES_64;
+        hfdcan->Init.TxElmtSize = FDCAN_DATA_BYTES_64;
+        if (HAL_FDCAN_Init(hfdcan) != HAL_OK) {
+            Error_Handler();
+        }
+
+        // The transceiver loop delay is a good part of a data phase bit, check our own bits late
+        HAL_FDCAN_ConfigTxDelayCompensation(hfdcan, hfdcan->Init.DataPrescaler * hfdcan->Init.DataTimeSeg1, 0);
+        HAL_FDCAN_EnableTxDelayCompensation(hfdcan);
+        return true;
+    }
+
+    return false;
+}
+
+bool FDCANBus::setAcceptanceFilters(const CANAcceptanceFilter_t *newFilters, uint8_t count) {
+    if (count > MAX_FILTERS || count > hfdcan->Init.ExtFiltersNbr) {
+        filterCount = 0;
+        filtersRejected = true;
+        return false;
+    }
+
+    memcpy(filters, newFilters, count * sizeof(filters[0]));
+    filterCount = count;
+    filtersRejected = false;
+    return true;
+}
+
+void FDCANBus::configureFilters() {
+    FDCAN_FilterTypeDef sFilterConfig;
+    sFilterConfig.IdType = FDCAN_EXTENDED_ID;
+    sFilterConfig.FilterType = FDCAN_FILTER_MASK;
+    sFilterConfig.FilterConfig = FDCAN_FILTER_TO_RXFIFO0;
+
+    if (filterCount == 0) {
+        sFilterConfig.FilterIndex = 0;
+        sFilterConfig.FilterID1 = 0x000;
+        sFilterConfig.FilterID2 = 0x000;  // Mask=0 accepts everything
+        HAL_FDCAN_ConfigFilter(hfdcan, &sFilterConfig);
+        return;
+    }
+
+    for (uint8_t i = 0; i < filterCount; i++) {
+        sFilterConfig.FilterIndex = i;
+        sFilterConfig.FilterID1 = filters[i].id;
+        sFilterConfig.FilterID2 = filters[i].mask;
+        HAL_FDCAN_ConfigFilter(hfdcan, &sFilterConfig);
+    }
+
+    // Frames matching no filter are dropped in hardware instead of landing in FIFO0
+    HAL_FDCAN_ConfigGlobalFilter(hfdcan, FDCAN_REJECT, FDCAN_REJECT, FDCAN_REJECT_REMOTE, FDCAN_REJECT_REMOTE);
+}
+
+bool FDCANBus::transmit(const CANFrame_t &frame) {
+    if (HAL_FDCAN_GetTxFifoFreeLevel(hfdcan) == 0) return false;
+
+    FDCAN_TxHeaderTypeDef txHeader;
+    txHeader.Identifier = frame.id;
+    txHeader.IdType = FDCAN_EXTENDED_ID;
+    txHeader.TxFrameType = FDCAN_DATA_FRAME;
+    txHeader.DataLength = lengthToDlc(frame.len);
+    txHeader.ErrorStateIndicator = FDCAN_ESI_ACTIVE;
+    txHeader.BitRateSwitch = frame.fd ? FDCAN_BRS_ON : FDCAN_BRS_OFF;
+    txHeader.FDFormat = frame.fd ? FDCAN_FD_CAN : FDCAN_CLASSIC_CAN;
+    txHeader.TxEventFifoControl = FDCAN_NO_TX_EVENTS;
+    txHeader.MessageMarker = 0;
+
+    uint8_t txData[CAN_FRAME_MAX_DATA_LEN] = {};
+    memcpy(txData, frame.data, frame.len);
+
+    return HAL_FDCAN_AddMessageToTxFifoQ(hfdcan, &txHeader, txData) == HAL_OK;
+}
+
+uint8_t FDCANBus::dlcToLength(uint32_t dlc) {
+    return dlc <= FDCAN_DLC_BYTES_64 ? DLC_TO_LENGTH[dlc] : 0;
+}
+
+// Smallest DLC that holds len bytes, the gap is sent as zeros
+uint32_t FDCANBus::lengthToDlc(uint8_t len) {
+    uint32_t dlc = FDCAN_DLC_BYTES_0;
+    while (dlc < FDCAN_DLC_BYTES_64 && DLC_TO_LENGTH[dlc] < len) {
+        dlc++;
+    }
+    return dlc;
+}
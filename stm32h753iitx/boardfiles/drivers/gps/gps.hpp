@@ -2,18 +2,15 @@
 
 #include "stm32h7xx_hal.h"
 #include "gps_iface.hpp"
-#include <cmath>
+#include "gps_stream_parser.hpp"
+#include "dma_rx_ring.hpp"
 
-static constexpr uint8_t MAX_NMEA_DATA_LENGTH_PER_LINE = 82;
-static constexpr uint8_t NUM_NMEA_DATA_LINES = 8;
-static constexpr uint16_t MAX_NMEA_DATA_LENGTH = MAX_NMEA_DATA_LENGTH_PER_LINE * NUM_NMEA_DATA_LINES;
-static constexpr uint32_t DECIMAL_PRECISION = 1e6;
-static constexpr uint16_t RX_BUFFER_PADDING_SIZE = 16;
-static constexpr uint16_t RX_BUFFER_SIZE = 2 * MAX_NMEA_DATA_LENGTH;
+static constexpr uint16_t GPS_RX_BUFFER_SIZE = 1024; // Circular DMA buffer, several navigation solutions deep
+static constexpr uint16_t GPS_DEFAULT_MEAS_RATE_MS = 200;
 
 class GPS : public IGPS {
     public:
-        GPS(UART_HandleTypeDef *huart);
+        GPS(UART_HandleTypeDef *huart, uint16_t measRateMs = GPS_DEFAULT_MEAS_RATE_MS);
 
         UART_HandleTypeDef* getHuart();
 
@@ -23,18 +20,20 @@ class GPS : public IGPS {
 
         bool init();
         void rxCallback(uint16_t size);
-        HAL_StatusTypeDef restartDMA();
+        HAL_StatusTypeDef restartDMA(); // Called from HAL_UART_ErrorCallback
+
+        const GpsParserStats_t &getParserStats() const;
+        uint32_t getOverrunBytes() const;
 
     private:
         GpsProtocol_t protocol = NMEA;
-        GpsData_t tempData{};
 
-        volatile uint8_t rxBuffer[MAX_NMEA_DATA_LENGTH] = {0};
-        volatile uint8_t processBuffer[MAX_NMEA_DATA_LENGTH] = {0};
-        volatile uint8_t *processBufferEnd = (uint8_t*)processBuffer;
-        volatile bool parsingData = false;
-        volatile bool dataReady = false;
+        // The DMA writes into rxBuffer circularly, readData() parses the unread bytes in place
+        volatile uint8_t rxBuffer[GPS_RX_BUFFER_SIZE] = {0};
+        DmaRxRing rxRing;
+        GpsStreamParser parser;
         UART_HandleTypeDef *huart;
+        const uint16_t measRateMs;
 
         bool configureUBX();
         bool setMessageRate(uint8_t msgClass, uint8_t msgId, uint8_t rate);
@@ -44,40 +43,4 @@ class GPS : public IGPS {
         bool receiveByte(uint8_t &byte, uint32_t deadline);
         bool sendUBX(uint8_t *msg, uint16_t len);
         void calcChecksum(uint8_t *msg, uint16_t len);
-
-        uint16_t processBufferLen();
-        bool incrementProcessBufferIndex(uint16_t &idx, uint16_t increment);
-
-        // Both advance idx past the frame they consumed, so readData() always makes progress even when the frame is corrupted 
-        bool consumeUBX(uint16_t &idx);
-        bool consumeNMEA(uint16_t &idx);
-
-        bool verifyChecksumUBX(uint16_t start, uint16_t frameLen);
-        bool verifyChecksumNMEA(uint16_t start, uint16_t end);
-        bool matchesSentenceType(uint16_t idx, const char *sentenceType);
-
-        bool parseRMC(uint16_t &idx);
-        bool parseGGA(uint16_t &idx);
-        bool parseVELECEF(uint16_t &idx);
-        bool parsePVT(uint16_t &idx);
-
-        // UBX helper functions
-        uint16_t getLenUBX(uint16_t &idx);
-
-        // RMC helper functions
-        bool getTimeRMC(uint16_t &idx);
-        bool getLatitudeRMC(uint16_t &idx);
-        bool getLongitudeRMC(uint16_t &idx);
-        bool getSpeedRMC(uint16_t &idx);
-        bool getTrackAngleRMC(uint16_t &idx);
-        bool getDateRMC(uint16_t &idx);
-
-        // GGA helper functions
-        bool getNumSatellitesGGA(uint16_t &idx);
-        bool getAltitudeGGA(uint16_t &idx);
-
-        // VELECEF helper functions
-        bool getVxVELECEF(uint16_t &idx);
-        bool getVyVELECEF(uint16_t &idx);
-        bool getVzVELECEF(uint16_t &idx);
 };
@@ -1,4 +1,5 @@
 #include "fused_imu.hpp"
+#include "tcm_placement.hpp"
 #include <cstring>
 
 FusedIMU::FusedIMU(SPI_HandleTypeDef* spiHandle, IMU *imu0, IMU *imu1) : 
@@ -36,19 +37,8 @@ RawImuBatch_t FusedIMU::readRawData() {
             if (count == 0) continue; // No data from this IMU, skip
             
             // Concatonate the batches based on imu order, sort the exact order later in scaleIMUData
+            // Each IMU driver already mapped its hardware timestamps to synchronized DWT time
             memcpy(rawFusedImuData + offset, rawImuBatch[i].data, sizeof(RawImu_t) * count);
-            
-            // Normalize IMU hardware timstamps to DWT ticks, cant compare hardware ticks between IMUs
-            uint32_t elapsed = 0;
-            uint32_t batchReadTime = rawImuBatch[i].readTime;
-            uint16_t prevHwTS = rawFusedImuData[offset + (count - 1)].timestamp;
-            rawFusedImuData[offset + (count - 1)].timestamp = batchReadTime;
-            for (int j = count - 2; j >= 0; j--) {
-                uint16_t currentHwTS = rawFusedImuData[offset + j].timestamp;
-                elapsed += (uint16_t)(prevHwTS - currentHwTS); // Cast to uint16_t so if delta > 65,536(2^16, hw timstamp limit) it wraps around
-                rawFusedImuData[offset + j].timestamp = batchReadTime - elapsed; // Both DWT and hw timestamp are in microseconds
-                prevHwTS = currentHwTS;
-            }
 
             offset += count;
         } 
@@ -64,7 +54,7 @@ RawImuBatch_t FusedIMU::readRawData() {
     return rawFusedImuBatch;
 }
 
-ScaledImuBatch_t FusedIMU::scaleIMUData(const RawImuBatch_t &rawDataBatch) {
+ZP_FAST_CODE ScaledImuBatch_t FusedIMU::scaleIMUData(const RawImuBatch_t &rawDataBatch) {
     // Guard to prevent recalculations when IMUs not filled with new data
     if (rawDataBatch.count == 0) {
         scaledFusedImuBatch.count = 0;
@@ -90,12 +80,12 @@ ScaledImuBatch_t FusedIMU::scaleIMUData(const RawImuBatch_t &rawDataBatch) {
     uint16_t k = 0; // Index for scaledFusedImuData
     while (true) {
         int smallestIMU = -1;
-        uint32_t smallestTimestamp = 0;
+        uint64_t smallestTimestamp = 0;
         for (int i = 0; i < NUM_IMU; i++) {
             if (idx[i] >= scaledImuBatch[i].count) continue; // This IMU is all merged
 
-            uint32_t timestamp = scaledImuBatch[i].data[idx[i]].timestamp;
-            if (smallestIMU == -1 || (int32_t)(timestamp - smallestTimestamp) < 0) { // First iteration or a smaller one
+            uint64_t timestamp = scaledImuBatch[i].data[idx[i]].timestampUs;
+            if (smallestIMU == -1 || timestamp < smallestTimestamp) { // First iteration or a smaller one
                 smallestIMU = i;
                 smallestTimestamp = timestamp;
             }
@@ -112,12 +102,12 @@ ScaledImuBatch_t FusedIMU::scaleIMUData(const RawImuBatch_t &rawDataBatch) {
     int start = 0;
     if (haveEmitted) {
         // merged array is sorted, so the stale samples are a contiguous prefix
-        while (start < k && (int32_t)(scaledFusedImuData[start].timestamp - lastEmittedTimestamp) <= 0) {
+        while (start < k && scaledFusedImuData[start].timestampUs <= lastEmittedTimestamp) {
             start++;   // drop: already covered by a previous round
         }
     }
     if (k > start) {
-        lastEmittedTimestamp = scaledFusedImuData[k - 1].timestamp;
+        lastEmittedTimestamp = scaledFusedImuData[k - 1].timestampUs;
         haveEmitted = true;
     }
     
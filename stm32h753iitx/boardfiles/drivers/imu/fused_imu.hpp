@@ -17,7 +17,7 @@ class FusedIMU : public IIMU {
 
         SPI_HandleTypeDef *getSPI();
 
-        float getODRHz() override; // Change when using a different ODR
+        float getODRHz() override; // Measured ODR of imu0, the FFT stream source
 
         GyroBias_t getGyroStartupBias(uint8_t imuId) override;        
 
@@ -41,6 +41,6 @@ class FusedIMU : public IIMU {
 
         volatile bool imuFilled[NUM_IMU] = {};
 
-        uint32_t lastEmittedTimestamp = 0;
+        uint64_t lastEmittedTimestamp = 0;
         bool haveEmitted = false;
 };
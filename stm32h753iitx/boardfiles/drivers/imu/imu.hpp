@@ -5,6 +5,7 @@
 #include "stm32h7xx_hal.h"
 #include <cstdint>
 #include "imu_datatypes.hpp"
+#include "imu_time_sync.hpp"
 
 typedef enum : uint8_t {
 	IMU_ODR_32KHZ = 0b0001,
@@ -46,8 +47,9 @@ class IMU : public IIMU {
 
 		void beginRead();
 		RawImuBatch_t getBatch();
-		float getODRHz() override;
+		float getODRHz() override; // Measured in MCU time once FIFO batches are flowing
 		GyroBias_t getGyroStartupBias(uint8_t imuId) override;
+		static ImuOdrConfig_t odrFromHz(float hz); // Falls back to 1 kHz for unsupported rates
 		
 		static constexpr float GYRO_SEN_SCALE_FACTOR = 16.4f;			 // Determined by GYRO_FS_SEL, page 11
 		static constexpr float ACCEL_SEN_SCALE_FACTOR = 2048.0f / 9.81f; // Determined by ACCEL_FS_SEL, page 12, scale to m/s^2
@@ -63,6 +65,9 @@ class IMU : public IIMU {
 		const float uiFiltCutoffHz;
 		const ImuUiFiltOrder_t uiFiltOrder;
 
+		static constexpr float TIMESTAMP_RES_US = 1.0f; // FIFO timestamp resolution, TMST_RES default
+		ImuTimeSync timeSync; // Maps FIFO hardware timestamps to DWT time
+
 		static constexpr uint8_t PACKET_SIZE = 16;
 		static constexpr uint8_t FIFO_HW_MAX_PACKETS = 128; // Hardware FIFO packet limit
 		static constexpr uint16_t RX_BUFFER_SIZE = MAX_PACKETS * PACKET_SIZE + 1;
@@ -109,6 +114,7 @@ class IMU : public IIMU {
 		float lowPassFilter(float rawValue, int select);
 
 		float getUIFiltBWHz(uint8_t bandwidth);
+		static float odrToHz(ImuOdrConfig_t odr);
 
 		// Internal variables
 		float alpha;
@@ -1,62 +1,288 @@
 #include "dshot.hpp"
-#include <cstring>
 
-static constexpr uint16_t DSHOT_1_CCR =	600; // CCR for dshot300 logic 1 
-static constexpr uint16_t DSHOT_0_CCR = 300; // CCR for dshot300 logic 0 
+static constexpr uint16_t MIN_THROTTLE = DSHOT_THROTTLE_MIN;
+static constexpr uint32_t CAPTURE_PERIOD = 0xFFFF;  // Free running while timestamping edges
 
-static constexpr uint16_t MAX_THROTTLE = 2047; // 11 bit max val
-static constexpr uint16_t MIN_THROTTLE = 48; // 0-47 reserved for special commands
+// TIM_CHANNEL_1-4 are 0x0, 0x4, 0x8, 0xC
+static uint8_t channelToSlot(uint32_t timerChannel) {
+    return (uint8_t)(timerChannel >> 2);
+}
+
+static uint32_t slotToChannel(uint8_t slot) {
+    return (uint32_t)slot << 2;
+}
+
+// Timers run at twice their APB clock whenever the APB is divided down
+static uint32_t timerClockHz(TIM_HandleTypeDef *timer) {
+    TIM_TypeDef *tim = timer->Instance;
+    if (tim == TIM1 || tim == TIM8 || tim == TIM15 || tim == TIM16 || tim == TIM17) {
+        uint32_t pclk = HAL_RCC_GetPCLK2Freq();
+        return (RCC->D2CFGR & RCC_D2CFGR_D2PPRE2_2) ? pclk * 2 : pclk;
+    }
+    uint32_t pclk = HAL_RCC_GetPCLK1Freq();
+    return (RCC->D2CFGR & RCC_D2CFGR_D2PPRE1_2) ? pclk * 2 : pclk;
+}
+
+// Applies the DShot bit period to the timer, unsupported rates fall back to DShot300
+static void initTiming(TIM_HandleTypeDef *timer, uint16_t rateKbps, DshotTiming_t &timing, DshotCompareTable &table) {
+    uint32_t clockHz = timerClockHz(timer);
+    if (!DshotCodec::timingForRate(clockHz, rateKbps, timing)) {
+        DshotCodec::timingForRate(clockHz, DSHOT_DEFAULT_RATE, timing);
+    }
+    table.build(timing.oneCompare, timing.zeroCompare);
+
+    timer->Init.Prescaler = 0;
+    timer->Init.Period = timing.period - 1;
+    if (HAL_TIM_Base_Init(timer) != HAL_OK) {
+        // Error_Handler();
+    }
+}
+
+DshotBurstGroup::DshotBurstGroup(TIM_HandleTypeDef *timer, uint32_t burstRequest, uint16_t rateKbps) :
+    timer_(timer),
+    burstRequest_(burstRequest),
+    rateKbps_(rateKbps),
+    timing_{},
+    activeMask_(0),
+    bidirMask_(0),
+    pendingMask_(0),
+    tickDropped_(false),
+    initialized_(false),
+    capturing_(false),
+    burstBuffer_{},
+    edgeBuffer_{},
+    erpm_{},
+    erpmValidMask_(0) {}
+
+int8_t DshotBurstGroup::addChannel(uint32_t timerChannel, bool bidirectional) {
+    uint8_t slot = channelToSlot(timerChannel);
+    if (initialized_ || slot >= DSHOT_BURST_CHANNELS || (activeMask_ & (1 << slot))) {
+        return -1;
+    }
+
+    activeMask_ |= 1 << slot;
+    if (bidirectional) {
+        bidirMask_ |= 1 << slot;
+    }
+    return (int8_t)slot;
+}
 
-static constexpr uint16_t THROTTLE_MASK = 0x7FF;
-static constexpr uint8_t THROTTLE_SHIFT = 5;
-static constexpr uint8_t TEL_MASK = 1;
-static constexpr uint8_t TEL_SHIFT = 4;
-static constexpr uint8_t CRC_MASK = 0x0F;
+void DshotBurstGroup::init() {
+    if (initialized_) return;
+    initialized_ = true;
 
-DshotMotorControl::DshotMotorControl(TIM_HandleTypeDef *timer, uint32_t timerChannel, bool telReq):
-    timer(timer), 
-    timerChannel(timerChannel), 
-    telReq(telReq){}
+    initTiming(timer_, rateKbps_, timing_, compareTable_);
+
+    for (uint8_t slot = 0; slot < DSHOT_BURST_CHANNELS; slot++) {
+        if (!(activeMask_ & (1 << slot))) continue;
+
+        // The channel DMA only ever captures reply edges, the burst stream carries the frames
+        if (bidirMask_ & (1 << slot)) {
+            DMA_HandleTypeDef *hdma = timer_->hdma[TIM_DMA_ID_CC1 + slot];
+            hdma->Init.Direction = DMA_PERIPH_TO_MEMORY;
+            if (HAL_DMA_Init(hdma) != HAL_OK) {
+                // Error_Handler();
+            }
+        }
+
+        configureOutput(slot);
+        HAL_TIM_PWM_Start(timer_, slotToChannel(slot));
+    }
+}
+
+void DshotBurstGroup::setFrame(uint8_t slot, uint16_t frame) {
+    if (slot >= DSHOT_BURST_CHANNELS || !(activeMask_ & (1 << slot))) return;
+
+    // Previous frame still going out, the buffer belongs to the DMA. Skip the rest of this tick too,
+    // otherwise its later slots would go out next tick next to fresher frames on the earlier ones
+    if (timer_->DMABurstState == HAL_DMA_BURST_STATE_BUSY) {
+        tickDropped_ = true;
+    } else if (!tickDropped_) {
+        compareTable_.frameToCompare(frame, &burstBuffer_[0][slot], DSHOT_BURST_CHANNELS);
+    }
+    pendingMask_ |= 1 << slot;
+
+    if (pendingMask_ == activeMask_) {
+        pendingMask_ = 0;
+        if (!tickDropped_) {
+            sendBurst();
+        }
+        tickDropped_ = false;
+    }
+}
+
+bool DshotBurstGroup::readErpm(uint8_t slot, uint32_t &erpm) {
+    if (slot >= DSHOT_BURST_CHANNELS || !(erpmValidMask_ & (1 << slot))) return false;
+
+    erpm = erpm_[slot];
+    return true;
+}
+
+void DshotBurstGroup::transferCompleteCallback() {
+    HAL_TIM_DMABurst_WriteStop(timer_, burstRequest_);
+    if (bidirMask_ == 0) return;
+
+    // The idle slot is loaded but the last bit is still on the line until the next update. Every flag
+    // read takes at least one timer clock, so 2 periods of reads is well past it. If the update never
+    // shows up (timer stopped under us), skip this reply rather than hang the ISR
+    __HAL_TIM_CLEAR_FLAG(timer_, TIM_FLAG_UPDATE);
+    uint32_t spins = 2 * (uint32_t)timing_.period;
+    while (!__HAL_TIM_GET_FLAG(timer_, TIM_FLAG_UPDATE)) {
+        if (--spins == 0) return;
+    }
+
+    startCapture();
+}
+
+TIM_HandleTypeDef *DshotBurstGroup::getTimer() {
+    return timer_;
+}
+
+void DshotBurstGroup::configureOutput(uint8_t slot) {
+    TIM_OC_InitTypeDef sConfigOC = {0};
+    sConfigOC.OCMode = TIM_OCMODE_PWM1;
+    sConfigOC.Pulse = 0;
+    // Bidirectional DShot is inverted so the line idles high and the ESC can pull it low to reply
+    sConfigOC.OCPolarity = (bidirMask_ & (1 << slot)) ? TIM_OCPOLARITY_LOW : TIM_OCPOLARITY_HIGH;
+    sConfigOC.OCNPolarity = TIM_OCNPOLARITY_HIGH;
+    sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
+    sConfigOC.OCIdleState = TIM_OCIDLESTATE_RESET;
+    sConfigOC.OCNIdleState = TIM_OCNIDLESTATE_RESET;
+    if (HAL_TIM_PWM_ConfigChannel(timer_, &sConfigOC, slotToChannel(slot)) != HAL_OK) {
+        // Error_Handler();
+    }
+}
+
+void DshotBurstGroup::startCapture() {
+    TIM_IC_InitTypeDef sConfigIC = {0};
+    sConfigIC.ICPolarity = TIM_ICPOLARITY_BOTHEDGE;
+    sConfigIC.ICSelection = TIM_ICSELECTION_DIRECTTI;
+    sConfigIC.ICPrescaler = TIM_ICPSC_DIV1;
+    sConfigIC.ICFilter = 0;
+
+    // One 16 bit wrap is far longer than a reply, edge deltas are taken modulo 2^16
+    __HAL_TIM_SET_AUTORELOAD(timer_, CAPTURE_PERIOD);
+
+    for (uint8_t slot = 0; slot < DSHOT_BURST_CHANNELS; slot++) {
+        if (!(bidirMask_ & (1 << slot))) continue;
+
+        uint32_t channel = slotToChannel(slot);
+        HAL_TIM_PWM_Stop(timer_, channel);
+        HAL_TIM_IC_ConfigChannel(timer_, &sConfigIC, channel);
+        HAL_TIM_IC_Start_DMA(timer_, channel, (uint32_t*)edgeBuffer_[slot], DSHOT_TELEM_MAX_EDGES);
+    }
+
+    capturing_ = true;
+}
+
+void DshotBurstGroup::finishCapture() {
+    for (uint8_t slot = 0; slot < DSHOT_BURST_CHANNELS; slot++) {
+        if (!(bidirMask_ & (1 << slot))) continue;
+
+        uint32_t channel = slotToChannel(slot);
+        uint8_t edges = DSHOT_TELEM_MAX_EDGES - (uint8_t)__HAL_DMA_GET_COUNTER(timer_->hdma[TIM_DMA_ID_CC1 + slot]);
+        HAL_TIM_IC_Stop_DMA(timer_, channel);
+
+        // A missed reply keeps the last good reading rather than dropping the notch for a loop
+        uint16_t periodCode;
+        if (DshotCodec::decodeEdges(edgeBuffer_[slot], edges, timing_.replyBitTicks, periodCode)) {
+            erpm_[slot] = DshotCodec::periodCodeToErpm(periodCode);
+            erpmValidMask_ |= 1 << slot;
+        }
+    }
+
+    __HAL_TIM_SET_AUTORELOAD(timer_, timing_.period - 1);
+    __HAL_TIM_SET_COUNTER(timer_, 0);
+
+    for (uint8_t slot = 0; slot < DSHOT_BURST_CHANNELS; slot++) {
+        if (!(bidirMask_ & (1 << slot))) continue;
+
+        configureOutput(slot);
+        HAL_TIM_PWM_Start(timer_, slotToChannel(slot));
+    }
+
+    // Load the idle compare values before the burst starts
+    timer_->Instance->EGR = TIM_EGR_UG;
+    capturing_ = false;
+}
+
+void DshotBurstGroup::sendBurst() {
+    if (capturing_) {
+        finishCapture();
+    }
+
+    if (HAL_TIM_DMABurst_MultiWriteStart(timer_, TIM_DMABASE_CCR1, burstRequest_, (uint32_t*)burstBuffer_,
+                                         TIM_DMABURSTLENGTH_4TRANSFERS, DSHOT_FRAME_SLOTS * DSHOT_BURST_CHANNELS) != HAL_OK) {
+        // Error_Handler();    Error handling to be done
+    }
+}
+
+DshotMotorControl::DshotMotorControl(TIM_HandleTypeDef *timer, uint32_t timerChannel, bool telReq, uint16_t rateKbps):
+    timer(timer),
+    timerChannel(timerChannel),
+    telReq(telReq),
+    rateKbps(rateKbps),
+    group(nullptr),
+    bidirectional(false),
+    slot(-1) {}
+
+DshotMotorControl::DshotMotorControl(DshotBurstGroup *group, uint32_t timerChannel, bool bidirectional):
+    timer(group->getTimer()),
+    timerChannel(timerChannel),
+    telReq(false),
+    rateKbps(DSHOT_DEFAULT_RATE),
+    group(group),
+    bidirectional(bidirectional),
+    slot(group->addChannel(timerChannel, bidirectional)) {}
 
 void DshotMotorControl::set(uint32_t percent) {
     percent =  (percent > 100) ? 100 : percent;
+    setThrottle((uint16_t)(percent * DSHOT_THROTTLE_FULL_SCALE / 100));
+}
 
+void DshotMotorControl::setNormalized(float command) {
+    if (!(command > 0.0f)) {
+        command = 0.0f;
+    } else if (command > 1.0f) {
+        command = 1.0f;
+    }
+    setThrottle((uint16_t)(command * DSHOT_THROTTLE_FULL_SCALE + 0.5f));
+}
+
+void DshotMotorControl::setThrottle(uint16_t throttle) {
     // Throttle 0 = disarm, 48-2047 = active throttle range
-    uint32_t throttleVal = 0;
+    uint16_t throttleVal = 0;
     if (armFlag) {
-        throttleVal = (percent == 0) ? MIN_THROTTLE : (percent / 100.0) * (MAX_THROTTLE - MIN_THROTTLE) + MIN_THROTTLE;
+        throttleVal = DshotCodec::scaleThrottle(throttle, DSHOT_THROTTLE_FULL_SCALE, MIN_THROTTLE);
     }
 
-    // 11 bits throttle + 1 bit telemetry request + 4 bits CRC
-    uint8_t crc = DshotMotorControl::calculateCrc(throttleVal, telReq);
-    uint16_t frame = ( (throttleVal & THROTTLE_MASK) << THROTTLE_SHIFT ) | ( (telReq & TEL_MASK) << TEL_SHIFT ) | (crc & CRC_MASK);
-
-    // Encode each bit to CRC val into temp buffer
-	for (int i = 0; i < DSHOT_FRAME_LEN; i++) {
-		uint8_t bit = (frame >> (DSHOT_FRAME_LEN - 1 - i)) & 1;
-        updateBuffer[i] = (bit == 1) ? DSHOT_1_CCR : DSHOT_0_CCR;
-	}
+    uint16_t frame = DshotCodec::encodeFrame(throttleVal, telReq, bidirectional);
 
-    // Set last index CRC to 0 to idle low after the frame until next PID call
-    updateBuffer[DSHOT_BUF_LEN - 1] = 0;
+    if (group != nullptr) {
+        if (slot >= 0) {
+            group->setFrame(slot, frame);
+        }
+        return;
+    }
 
-    memcpy(dmaBuffer, updateBuffer, sizeof(updateBuffer));
-    if (HAL_TIM_PWM_Start_DMA(timer, timerChannel, (uint32_t*)dmaBuffer, DSHOT_BUF_LEN) != HAL_OK) {
+    // Compare value per bit with a trailing 0 to idle low after the frame until next PID call
+    compareTable.frameToCompare(frame, dmaBuffer);
+    if (HAL_TIM_PWM_Start_DMA(timer, timerChannel, (uint32_t*)dmaBuffer, DSHOT_FRAME_SLOTS) != HAL_OK) {
         // Error_Handler();    Error handling to be done
     }
 }
 
 void DshotMotorControl::init() {
-    timer->Init.Prescaler = 0;
-    timer->Init.Period = 799;
-    if (HAL_TIM_Base_Init(timer) != HAL_OK) {
-        // Error_Handler();
+    if (group != nullptr) {
+        group->init();
+    } else {
+        initTiming(timer, rateKbps, timing, compareTable);
     }
     setArm(false);
     this->set(0);
 }
 
-uint8_t DshotMotorControl::calculateCrc(uint16_t throttleVal, uint8_t telReq) {
-    uint16_t preCrc = (throttleVal << 1) | telReq;
-    return (preCrc ^ (preCrc >> 4) ^ (preCrc >> 8)) & CRC_MASK;
+bool DshotMotorControl::readErpm(uint32_t &erpm) {
+    if (group == nullptr || slot < 0 || !bidirectional) return false;
+    return group->readErpm(slot, erpm);
 }
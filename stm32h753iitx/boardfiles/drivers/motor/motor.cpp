@@ -9,9 +9,17 @@ MotorControl::MotorControl(TIM_HandleTypeDef *timer, uint32_t timerChannel, uint
 
 void MotorControl::set(uint32_t percent) {
     percent = percent > 100 ? 100 : percent;
-    
-    uint32_t ticks = 0;
-    ticks = ((percent / 100.0) * (maxCCR - minCCR)) + minCCR;
+    setNormalized(percent / 100.0f);
+}
+
+void MotorControl::setNormalized(float command) {
+    if (!(command > 0.0f)) {
+        command = 0.0f;
+    } else if (command > 1.0f) {
+        command = 1.0f;
+    }
+
+    uint32_t ticks = (uint32_t)(command * (maxCCR - minCCR) + 0.5f) + minCCR;
 
     __HAL_TIM_SET_COMPARE(timer, timerChannel, ticks);
 }
@@ -3,10 +3,20 @@
 #include <cstdio>
 #include "rc_defines.hpp"
 #include "rc_crsf.hpp"
+#include "systemutils.hpp"
 
-CRSFReceiver::CRSFReceiver(UART_HandleTypeDef* uart) : uart_(uart) {
-    memset(crsfRxBuffer_, 0, CRSF_PACKET_SIZE);
-}
+CRSFReceiver::CRSFReceiver(UART_HandleTypeDef* uart, LatestValueSlot<RCChannelFrame_t> *fastPath, const LatestValueSlot<RCNavTelemetry_t> *navTelemetry) :
+    uart_(uart),
+    fastPath_(fastPath),
+    crsfRxBuffer_{},
+    rxRing_(crsfRxBuffer_, CRSF_RX_BUFFER_SIZE),
+    lastLinkStats_{},
+    linkStatsSeq_(0),
+    rxLinkStats_{},
+    systemTelemetrySeq_(0),
+    navTelemetry_(navTelemetry),
+    navTelemetrySeq_(0),
+    txBuffer_{} {}
 
 RCControl CRSFReceiver::getRCData() {
     RCControl tmp = rcData_;
@@ -14,75 +24,104 @@ RCControl CRSFReceiver::getRCData() {
     return tmp;
 }
 
+RCLinkStats_t CRSFReceiver::getLinkStats() {
+    linkStats_.readIfNew(lastLinkStats_, linkStatsSeq_);
+    return lastLinkStats_;
+}
+
+void CRSFReceiver::setTelemetry(const RCSystemTelemetry_t &telemetry) {
+    systemTelemetry_.publish(telemetry);
+}
+
 void CRSFReceiver::init() {
-    // start circular DMA
     rcData_.isDataNew = false;
-    HAL_UARTEx_ReceiveToIdle_DMA(uart_, crsfRxBuffer_, CRSF_PACKET_SIZE);
+    rxRing_.reset();
+    parser_.reset();
+    HAL_UARTEx_ReceiveToIdle_DMA(uart_, (uint8_t*)crsfRxBuffer_, CRSF_RX_BUFFER_SIZE);
 }
 
 void CRSFReceiver::startDMA() {
-    // start circular DMA
-    HAL_UARTEx_ReceiveToIdle_DMA(uart_, crsfRxBuffer_, CRSF_PACKET_SIZE);
+    // Runs on every UART error. Restarting rewinds the DMA to the start of the buffer, the next
+    // rxCallback() drops the partial frame but keeps the parser counters and last link stats
+    rxRing_.onDmaRestart();
+    HAL_UARTEx_ReceiveToIdle_DMA(uart_, (uint8_t*)crsfRxBuffer_, CRSF_RX_BUFFER_SIZE);
 }
 
-// Polynomial used in CRSF: 0xD5
-static uint8_t crsf_crc8(const uint8_t *data, uint8_t len) {
-    uint8_t crc = 0;
-    while (len--) {
-        crc ^= *data++;
-        for (int i = 0; i < 8; i++) {
-            if (crc & 0x80)
-                crc = (crc << 1) ^ 0xD5;
-            else
-                crc <<= 1;
+void CRSFReceiver::rxCallback(uint16_t size) {
+    // Circular DMA keeps running, parse whatever arrived since the last event
+    rxRing_.onDmaEvent(size);
+
+    const uint8_t *span;
+    uint16_t len;
+    while ((len = rxRing_.readSpan(span)) > 0) {
+        // An overrun or DMA restart skipped bytes before this span
+        if (rxRing_.takeDiscontinuity()) {
+            parser_.resync();
         }
+        parser_.feed(span, len);
+        rxRing_.advance(len);
     }
-    return crc;
-}
 
-void CRSFReceiver::parse() {
+    CrsfLinkStats_t stats;
+    if (parser_.takeLinkStats(stats)) {
+        RCLinkStats_t link;
+        link.isValid = true;
+        link.linkQuality = stats.uplinkLinkQuality;
+        link.rssiDbm = -(int16_t)((stats.activeAntenna == 0) ? stats.uplinkRssi1 : stats.uplinkRssi2);
+        link.snrDb = stats.uplinkSnr;
+        rxLinkStats_ = link;
+        linkStats_.publish(link);
+    }
 
-    uint8_t *buf = crsfRxBuffer_;
+    uint16_t channels[CRSF_CHANNEL_COUNT];
+    if (parser_.takeChannels(channels)) {
+        onChannels(channels);
+        sendTelemetry();
+    }
+}
 
-    // Validate sync byte and frame type
-   if (buf[0] != CRSF_SYNC_BYTE || buf[2] != CRSF_FRAMETYPE_RC_CHANNELS_PACKED) {
-       return;
-   }
+void CRSFReceiver::onChannels(const uint16_t (&channels)[CRSF_CHANNEL_COUNT]) {
+    for (int i = 0; i < CRSF_CHANNEL_COUNT; ++i) {
+        // Map to desired range
+        rcData_.controlSignals[i] = static_cast<float>((channels[i] - CRSF_PULSE_MIN) * (100.0f / CRSF_PULSE_RANGE));
+    }
 
-    uint8_t length = buf[1];
-    // Extract payload
-    const uint8_t *payload = &buf[3];
+    rcData_.isDataNew = true;
 
-    // The CRC is the last byte of the frame
-    const uint8_t crcFromPacket = buf[1 + length];
-    const uint8_t crcCalc = crsf_crc8(&buf[2], length - 1); // TYPE+PAYLOAD
-    
-    if (crcFromPacket != crcCalc) {
-        return; // corrupted frame, ignore
+    if (fastPath_ != nullptr) {
+        RCChannelFrame_t frame;
+        memcpy(frame.controlSignals, rcData_.controlSignals, sizeof(frame.controlSignals));
+        frame.linkStats = rxLinkStats_;
+        fastPath_->publish(frame);
     }
+}
 
-    // Decode channels
-    uint16_t channels[16];
-    uint32_t bitBuffer = 0;
-    uint8_t bitsInBuffer = 0;
-    uint8_t payloadIndex = 0;
-
-    for (int i = 0; i < 16; ++i) {
-        while (bitsInBuffer < 11) {
-            bitBuffer |= ((uint32_t)payload[payloadIndex++]) << bitsInBuffer;
-            bitsInBuffer += 8;
-        }
-        channels[i] = bitBuffer & 0x7FF; // Extract 11 bits
-        bitBuffer >>= 11;
-        bitsInBuffer -= 11;
+void CRSFReceiver::sendTelemetry() {
+    RCSystemTelemetry_t system;
+    if (systemTelemetry_.readIfNew(system, systemTelemetrySeq_)) {
+        telemetry_.setSystem(system);
+    }
 
-        // Map to desired range
-        rcData_.controlSignals[i] = static_cast<float>((channels[i] - CRSF_PULSE_MIN) * (100.0f / CRSF_PULSE_RANGE));
+    RCNavTelemetry_t nav;
+    if (navTelemetry_ != nullptr && navTelemetry_->readIfNew(nav, navTelemetrySeq_)) {
+        telemetry_.setNav(nav);
     }
 
-    rcData_.isDataNew = true;
+    // The slot right after an RC frame, HAL_BUSY means the previous frame is still going out
+    uint8_t len = telemetry_.onRcFrame(SystemUtils::getDWTMicroSec(), txBuffer_, sizeof(txBuffer_));
+    if (len > 0) {
+        HAL_UART_Transmit_IT(uart_, txBuffer_, len);
+    }
 }
 
 UART_HandleTypeDef * CRSFReceiver::getHuart() {
     return uart_;
 }
+
+const CrsfParserStats_t &CRSFReceiver::getParserStats() const {
+    return parser_.getStats();
+}
+
+uint32_t CRSFReceiver::getOverrunBytes() const {
+    return rxRing_.getOverrunBytes();
+}
@@ -10,10 +10,17 @@
 #include "rc_crsf.hpp"
 #include "rc_motor_control.hpp"
 #include "tm_queue.hpp"
+#include "battery_voltage.hpp"
+#include "sysid_log.hpp"
 #include "mavlink.h"
 #include "queue.hpp"
 #include "gps.hpp"
+#include "blended_gps.hpp"
 #include "can_controller.hpp"
+#include "fdcan_bus.hpp"
+#include "can_bus_stats.hpp"
+#include "dronecan_outputs.hpp"
+#include "dronecan_sensors.hpp"
 #include "rfd.hpp"
 #include "imu.hpp"
 #include "power_module.hpp"
@@ -27,25 +34,43 @@
 extern SystemUtils *systemUtilsHandle;
 extern MathUtils *mathUtilsHandle;
 extern FFT *fftHandle;
+extern FFT *sysIdFftHandle;
 
 extern IndependentWatchdog *iwdgHandle;
 extern Logger *loggerHandle;
 
 extern IMotorControl *motorHandles[8];
+extern DshotBurstGroup *dshotGroupHandle;
 
+extern FDCANBus *canBusHandle;
 extern CANController *canControllerHandle;
+extern DroneCANOutputGroup *canOutputGroupHandle;
+extern DroneCANGPS *canGpsHandle;
+extern DroneCANBarometer *canBarometerHandle;
+extern DroneCANMagnetometer *canMagnetometerHandle;
+extern DroneCANAirspeed *canAirspeedHandle;
 extern SafetySwitch *safetySwitchHandle;
 extern CRSFReceiver *rcHandle;
 extern GPS *gps1Handle;
 extern GPS *gps2Handle;
+extern BlendedGPS *gpsHandle;
 extern FusedIMU *imuHandle;
 extern RFD *telemLinkHandle;
 extern PowerModule *pmHandle;
 extern Rangefinder *rangefinderHandle;
 extern Barometer *barometerHandle;
+extern IGPS *amGpsHandle;
+extern IBarometer *amBarometerHandle;
 
 extern MessageQueue<RCMotorControlMessage_t> *amRCQueueHandle;
+extern LatestValueSlot<RCChannelFrame_t> *rcFastPathHandle;
+extern LatestValueSlot<RCNavTelemetry_t> *rcNavTelemetryHandle;
+extern LatestValueSlot<BatteryVoltage_t> *batteryVoltageHandle;
+extern LatestValueSlot<CANBusStats_t> *canBusStatsHandle;
+extern LatestValueSlot<ActuatorCommand_t> *actuatorCommandHandle;
+extern EscStatusTable *escStatusHandle;
 extern MessageQueue<char[100]> *smLoggerQueueHandle;
+extern MessageQueue<SysIdLogBlock_t> *sysIdLogQueueHandle;
 extern MessageQueue<TMMessage_t> *tmQueueHandle;
 extern MessageQueue<mavlink_message_t> *messageBufferHandle;
 
@@ -1,10 +1,20 @@
 #include "drivers.hpp"
+#include "bus_threads.hpp"
 #include "museq.hpp"
 #include "stm32h7xx_hal.h"
 #include "zp_params.hpp"
+#include "tcm_placement.hpp"
 
 #define MOT_TYPE_PWM 0
-#define MOT_TYPE_DSHOT 5
+#define MOT_TYPE_DSHOT150 4
+#define MOT_TYPE_DSHOT300 5
+#define MOT_TYPE_DSHOT600 6
+#define MOT_TYPE_DSHOT1200 7
+
+#define GPS_TYPE_DRONECAN 9
+#define BARO_PRIMARY_DRONECAN 1
+
+static const uint16_t DSHOT_RATE_KBPS[] = {150, 300, 600, 1200}; // Indexed from MOT_TYPE_DSHOT150
 
 // External hardware handles
 extern IWDG_HandleTypeDef hiwdg1;
@@ -30,24 +40,42 @@ extern FDCAN_HandleTypeDef hfdcan1;
 SystemUtils *systemUtilsHandle = nullptr;
 MathUtils *mathUtilsHandle = nullptr;
 FFT *fftHandle = nullptr;
+FFT *sysIdFftHandle = nullptr;
 IndependentWatchdog *iwdgHandle = nullptr;
 Logger *loggerHandle = nullptr;
 
 IMotorControl *motorHandles[8] = {0};
+DshotBurstGroup *dshotGroupHandle = nullptr;
 
+FDCANBus *canBusHandle = nullptr;
 CANController *canControllerHandle = nullptr;
+DroneCANOutputGroup *canOutputGroupHandle = nullptr;
+DroneCANGPS *canGpsHandle = nullptr;
+DroneCANBarometer *canBarometerHandle = nullptr;
+DroneCANMagnetometer *canMagnetometerHandle = nullptr;
+DroneCANAirspeed *canAirspeedHandle = nullptr;
 SafetySwitch *safetySwitchHandle = nullptr;
 GPS *gps1Handle = nullptr;
 GPS *gps2Handle = nullptr;
+BlendedGPS *gpsHandle = nullptr;
 CRSFReceiver *rcHandle = nullptr;
 RFD *telemLinkHandle = nullptr;
 FusedIMU *imuHandle = nullptr;
 PowerModule *pmHandle = nullptr;
 Rangefinder *rangefinderHandle = nullptr;
 Barometer *barometerHandle = nullptr;
+IGPS *amGpsHandle = nullptr;
+IBarometer *amBarometerHandle = nullptr;
 
 MessageQueue<RCMotorControlMessage_t> *amRCQueueHandle = nullptr;
+LatestValueSlot<RCChannelFrame_t> *rcFastPathHandle = nullptr;
+LatestValueSlot<RCNavTelemetry_t> *rcNavTelemetryHandle = nullptr;
+LatestValueSlot<BatteryVoltage_t> *batteryVoltageHandle = nullptr;
+LatestValueSlot<CANBusStats_t> *canBusStatsHandle = nullptr;
+LatestValueSlot<ActuatorCommand_t> *actuatorCommandHandle = nullptr;
+EscStatusTable *escStatusHandle = nullptr;
 MessageQueue<char[100]> *smLoggerQueueHandle = nullptr;
+MessageQueue<SysIdLogBlock_t> *sysIdLogQueueHandle = nullptr;
 MessageQueue<TMMessage_t> *tmQueueHandle = nullptr;
 MessageQueue<mavlink_message_t> *messageBufferHandle = nullptr;
 
@@ -93,11 +121,19 @@ void initDrivers() {
     systemUtilsHandle = new SystemUtils();
     mathUtilsHandle = new MathUtils();
     fftHandle = new FFT();
+    sysIdFftHandle = new FFT(); // Own instance so the SYSID estimate doesn't change the notch FFT length
     iwdgHandle = new IndependentWatchdog(&hiwdg1);
     loggerHandle = new Logger(); // Initialized later in RTOS task
 
     // Motors (servo index matches SERVOx param)
     uint32_t servoType = int(ZP_PARAM::get(ZP_PARAM_ID::MOT_PWM_TYPE));
+    uint16_t canEscMask = (uint16_t)ZP_PARAM::get(ZP_PARAM_ID::CAN_D1_UC_ESC_BM);
+    uint16_t canServoMask = (uint16_t)ZP_PARAM::get(ZP_PARAM_ID::CAN_D1_UC_SRV_BM);
+    actuatorCommandHandle = new LatestValueSlot<ActuatorCommand_t>();
+    escStatusHandle = new EscStatusTable();
+    canOutputGroupHandle = new DroneCANOutputGroup(actuatorCommandHandle, escStatusHandle, systemUtilsHandle,
+        (uint8_t)ZP_PARAM::get(ZP_PARAM_ID::SERVO_BLH_POLES) / 2, &busCommandsReady);
+    uint16_t bdMask = (uint16_t)ZP_PARAM::get(ZP_PARAM_ID::SERVO_BLH_BDMASK);
     for (int i = 0; i < 8; i++) {
         // Determine if it is brushless DC motor
         bool isBLDC = false; 
@@ -105,12 +141,29 @@ void initDrivers() {
         isBLDC = int(ZP_PARAM::get(SERVO_FUNC[i])) == int(MotorFunction_e::THROTTLE);
         #endif
         #ifdef QUADCOPTER
-        isBLDC = int(ZP_PARAM::get(SERVO_FUNC[i])) == int(MotorFunction_e::MOTOR_1) || int(ZP_PARAM::get(SERVO_FUNC[i])) == int(MotorFunction_e::MOTOR_2) || int(ZP_PARAM::get(SERVO_FUNC[i])) == int(MotorFunction_e::MOTOR_3) || int(ZP_PARAM::get(SERVO_FUNC[i])) == int(MotorFunction_e::MOTOR_4);
+        isBLDC = int(ZP_PARAM::get(SERVO_FUNC[i])) >= int(MotorFunction_e::MOTOR_1) && int(ZP_PARAM::get(SERVO_FUNC[i])) <= int(MotorFunction_e::MOTOR_8);
         #endif
-        if (isBLDC) {
+        // Outputs in the DroneCAN masks skip the timer pin, a disabled servo output stays off the bus
+        bool isCanServo = ((canServoMask >> i) & 1) && int(ZP_PARAM::get(SERVO_FUNC[i])) > int(MotorFunction_e::DISABLED);
+        if (isBLDC && ((canEscMask >> i) & 1)) {
+            motorHandles[i] = new DroneCANMotorControl(canOutputGroupHandle, DroneCANOutputType_e::ESC, i);
+        } else if (!isBLDC && isCanServo) {
+            motorHandles[i] = new DroneCANMotorControl(canOutputGroupHandle, DroneCANOutputType_e::SERVO, i + 1);
+        } else if (isBLDC) {
             switch (servoType) {
-            case MOT_TYPE_DSHOT: // DShot
-                motorHandles[i] = new DshotMotorControl(MOTOR_MAP[i].timer, MOTOR_MAP[i].channel, false);
+            case MOT_TYPE_DSHOT150:
+            case MOT_TYPE_DSHOT300:
+            case MOT_TYPE_DSHOT600:
+            case MOT_TYPE_DSHOT1200: // DShot
+                if (MOTOR_MAP[i].timer == &htim1) {
+                    // TIM1 outputs share one burst DMA, bidirectional ESCs report eRPM back on the same pin
+                    if (dshotGroupHandle == nullptr) {
+                        dshotGroupHandle = new DshotBurstGroup(&htim1, TIM_DMA_UPDATE, DSHOT_RATE_KBPS[servoType - MOT_TYPE_DSHOT150]);
+                    }
+                    motorHandles[i] = new DshotMotorControl(dshotGroupHandle, MOTOR_MAP[i].channel, (bdMask >> i) & 1);
+                } else {
+                    motorHandles[i] = new DshotMotorControl(MOTOR_MAP[i].timer, MOTOR_MAP[i].channel, false, DSHOT_RATE_KBPS[servoType - MOT_TYPE_DSHOT150]);
+                }
                 break;
             case MOT_TYPE_PWM: // PWM
             default:
@@ -125,24 +178,42 @@ void initDrivers() {
 
     // Peripherals
     safetySwitchHandle = new SafetySwitch(GPIOH, GPIO_PIN_12, GPIOH, GPIO_PIN_11);    
-    gps1Handle = new GPS(&huart6);
-    gps2Handle = new GPS(&huart3);
-    rcHandle = new CRSFReceiver(&huart4);
+    uint16_t gpsRateMs = (uint16_t)ZP_PARAM::get(ZP_PARAM_ID::GPS_RATE_MS);
+    gps1Handle = new GPS(&huart6, gpsRateMs);
+    gps2Handle = new GPS(&huart3, gpsRateMs);
+    gpsHandle = new BlendedGPS(gps1Handle, gps2Handle, systemUtilsHandle);
+    rcFastPathHandle = new LatestValueSlot<RCChannelFrame_t>();
+    rcNavTelemetryHandle = new LatestValueSlot<RCNavTelemetry_t>();
+    rcHandle = new CRSFReceiver(&huart4, rcFastPathHandle, rcNavTelemetryHandle);
     telemLinkHandle = new RFD(&huart1);
-    IMU *imu0 = new IMU(&hspi1, GPIOC, GPIO_PIN_4, 0, IMU_ODR_1KHZ);
-    IMU *imu1 = new IMU(&hspi1, GPIOC, GPIO_PIN_5, 1, IMU_ODR_1KHZ);
-    imuHandle = new FusedIMU(&hspi1, imu0, imu1);
+    ImuOdrConfig_t imuOdr = IMU::odrFromHz(ZP_PARAM::get(ZP_PARAM_ID::INS_GYRO_RATE));
+    // The IMUs hold their SPI DMA buffers and stay out of DTCM, the fused batches the AM reads every loop go in it
+    alignas(FusedIMU) ZP_FAST_BSS static uint8_t fusedImuStorage[sizeof(FusedIMU)];
+    IMU *imu0 = new IMU(&hspi1, GPIOC, GPIO_PIN_4, 0, imuOdr);
+    IMU *imu1 = new IMU(&hspi1, GPIOC, GPIO_PIN_5, 1, imuOdr);
+    imuHandle = new (&fusedImuStorage) FusedIMU(&hspi1, imu0, imu1);
     pmHandle = new PowerModule(&hi2c1);
     if (ZP_PARAM::get(ZP_PARAM_ID::RNGFND_ENABLE) == 1) {
         rangefinderHandle = new Rangefinder(&hi2c3);
     }
     barometerHandle = new Barometer(&hi2c2);
 
+    canGpsHandle = new DroneCANGPS();
+    canBarometerHandle = new DroneCANBarometer();
+    canMagnetometerHandle = new DroneCANMagnetometer();
+    canAirspeedHandle = new DroneCANAirspeed();
+
+    // The AM navigates from either the onboard drivers or the DroneCAN sensors
+    amGpsHandle = (int(ZP_PARAM::get(ZP_PARAM_ID::GPS_TYPE)) == GPS_TYPE_DRONECAN) ? static_cast<IGPS *>(canGpsHandle) : gpsHandle;
+    amBarometerHandle = (int(ZP_PARAM::get(ZP_PARAM_ID::BARO_PRIMARY)) == BARO_PRIMARY_DRONECAN) ? static_cast<IBarometer *>(canBarometerHandle) : barometerHandle;
+
     // Queues
     amRCQueueHandle = new MessageQueue<RCMotorControlMessage_t>(&amQueueId);
     smLoggerQueueHandle = new MessageQueue<char[100]>(&smLoggerQueueId);
+    sysIdLogQueueHandle = new MessageQueue<SysIdLogBlock_t>(&sysIdLogQueueId);
     tmQueueHandle = new MessageQueue<TMMessage_t>(&tmQueueId);
     messageBufferHandle = new MessageQueue<mavlink_message_t>(&messageBufferId);
+    batteryVoltageHandle = new LatestValueSlot<BatteryVoltage_t>();
 
     // Initialize hardware components
     for (int i = 0; i < 8; i++) {
@@ -151,7 +222,15 @@ void initDrivers() {
     MotorControl::enableServo(GPIOF, GPIO_PIN_1);
     MotorControl::enableServoSwitch(GPIOE, GPIO_PIN_3, &hspi4);
 
-    canControllerHandle = new CANController(&hfdcan1, systemUtilsHandle);
+    canBusHandle = new FDCANBus(&hfdcan1);
+    canBusStatsHandle = new LatestValueSlot<CANBusStats_t>();
+    canControllerHandle = new CANController(canBusHandle, systemUtilsHandle, canBusStatsHandle, actuatorCommandHandle, escStatusHandle,
+        canGpsHandle, canBarometerHandle, canMagnetometerHandle, canAirspeedHandle);
+    canBusHandle->init();
+    #if CANARD_ENABLE_CANFD
+        // Every node on an FD bus must be FD capable, our transfers go out as FD once the peripheral is
+        canControllerHandle->setFdTransmit(canBusHandle->isFdEnabled());
+    #endif
 
     rcHandle->init();
     gps1Handle->init();
@@ -1,9 +1,10 @@
 #include "direct_mapping.hpp"
 #include "drivers.hpp"
 #include "managers.hpp"
+#include "tcm_placement.hpp"
 
-// Pre-allocated static storage (global, not stack)
-alignas(AttitudeManager) static uint8_t amHandleStorage[sizeof(AttitudeManager)];
+// Pre-allocated static storage (global, not stack), the AM state runs the control loop out of DTCM
+alignas(AttitudeManager) ZP_FAST_BSS static uint8_t amHandleStorage[sizeof(AttitudeManager)];
 alignas(SystemManager) static uint8_t smHandleStorage[sizeof(SystemManager)];
 alignas(TelemetryManager) static uint8_t tmHandleStorage[sizeof(TelemetryManager)];
 
@@ -18,15 +19,20 @@ void initManagers()
     amHandle = new (&amHandleStorage) AttitudeManager(
         systemUtilsHandle,
         mathUtilsHandle,
-        gps1Handle,
+        amGpsHandle,
         imuHandle,
         fftHandle,
         rangefinderHandle,
-        barometerHandle,
+        amBarometerHandle,
         amRCQueueHandle, 
         tmQueueHandle, 
         smLoggerQueueHandle, 
-        &mainMotorGroup
+        &mainMotorGroup,
+        rcFastPathHandle,
+        rcNavTelemetryHandle,
+        batteryVoltageHandle,
+        sysIdFftHandle,
+        sysIdLogQueueHandle
     );
 
     // SM initialization
@@ -39,7 +45,10 @@ void initManagers()
         pmHandle,
         amRCQueueHandle,
         tmQueueHandle,
-        smLoggerQueueHandle
+        smLoggerQueueHandle,
+        batteryVoltageHandle,
+        sysIdLogQueueHandle,
+        canBusStatsHandle
     );
 
     // TM initialization
@@ -1,6 +1,7 @@
 #include "museq.hpp"
 #include "rc_motor_control.hpp"
 #include "tm_queue.hpp"
+#include "sysid_log.hpp"
 #include "mavlink.h"
 
 /* --- mutexes --- */
@@ -8,6 +9,7 @@
 osMutexId_t itmMutex;
 osMessageQueueId_t amQueueId;
 osMessageQueueId_t smLoggerQueueId;
+osMessageQueueId_t sysIdLogQueueId;
 osMessageQueueId_t tmQueueId;
 osMessageQueueId_t messageBufferId;
 
@@ -41,6 +43,7 @@ void initQueues()
 {
   amQueueId = osMessageQueueNew(16, sizeof(RCMotorControlMessage_t), NULL);
   smLoggerQueueId = osMessageQueueNew(16, sizeof(char[100]), NULL);
+  sysIdLogQueueId = osMessageQueueNew(8, sizeof(SysIdLogBlock_t), NULL);
   tmQueueId = osMessageQueueNew(16, sizeof(TMMessage_t), NULL);
   messageBufferId = osMessageQueueNew(16, sizeof(mavlink_message_t), NULL);
 }
@@ -1,12 +1,23 @@
 #include "am_threads.hpp"
 #include "managers.hpp"
 #include "utils.h"
+#include "tcm_placement.hpp"
+#include "FreeRTOS.h"
+#include "task.h"
 
 osThreadId_t amMainHandle;
 
+// Control loop stack and TCB in DTCM next to the AM state
+static constexpr uint32_t AM_MAIN_STACK_SIZE = 8192;
+ZP_FAST_BSS static uint64_t amMainStack[AM_MAIN_STACK_SIZE / sizeof(uint64_t)];
+ZP_FAST_BSS static StaticTask_t amMainControlBlock;
+
 static const osThreadAttr_t amMainLoopAttr = {
     .name = "amMain",
-    .stack_size = 8192,
+    .cb_mem = &amMainControlBlock,
+    .cb_size = sizeof(amMainControlBlock),
+    .stack_mem = amMainStack,
+    .stack_size = AM_MAIN_STACK_SIZE,
     .priority = (osPriority_t) osPriorityNormal
 };
 
@@ -16,7 +27,7 @@ void amMainLoopWrapper(void *arg)
   while(true)
   {
     amHandle->amUpdate();
-    nextWakeUp += timeToTicks(AM_UPDATE_LOOP_DELAY_MS);
+    nextWakeUp += timeToTicks(amHandle->getUpdateLoopDelayMs());
     osDelayUntil(nextWakeUp);
   }
 }
@@ -26,9 +26,10 @@ set(OPTIMIZATION_FLAGS_DEBUG "-O0 -ffunction-sections -fdata-sections")
 set(OPTIMIZATION_FLAGS_RELEASE "-O3 -ffunction-sections -fdata-sections")
 set(WARNING_FLAGS      "-Wall")
 set(DEBUG_FLAGS        "-fstack-usage -g3")
+set(BOARD_FLAGS        "-DZP_TCM_PLACEMENT")
 
-set(CMAKE_C_FLAGS_DEBUG   "${C_FLAGS} ${MCU_FLAGS} ${OPTIMIZATION_FLAGS_DEBUG} ${WARNING_FLAGS} ${DEBUG_FLAGS}")
-set(CMAKE_CXX_FLAGS_DEBUG "${CPP_FLAGS} ${MCU_FLAGS} ${OPTIMIZATION_FLAGS_DEBUG} ${WARNING_FLAGS} ${DEBUG_FLAGS}")
+set(CMAKE_C_FLAGS_DEBUG   "${C_FLAGS} ${MCU_FLAGS} ${OPTIMIZATION_FLAGS_DEBUG} ${WARNING_FLAGS} ${DEBUG_FLAGS} ${BOARD_FLAGS}")
+set(CMAKE_CXX_FLAGS_DEBUG "${CPP_FLAGS} ${MCU_FLAGS} ${OPTIMIZATION_FLAGS_DEBUG} ${WARNING_FLAGS} ${DEBUG_FLAGS} ${BOARD_FLAGS}")
 
-set(CMAKE_C_FLAGS_RELEASE   "${C_FLAGS} ${MCU_FLAGS} ${OPTIMIZATION_FLAGS_RELEASE} ${WARNING_FLAGS}")
-set(CMAKE_CXX_FLAGS_RELEASE "${CPP_FLAGS} ${MCU_FLAGS} ${OPTIMIZATION_FLAGS_RELEASE} ${WARNING_FLAGS}")
+set(CMAKE_C_FLAGS_RELEASE   "${C_FLAGS} ${MCU_FLAGS} ${OPTIMIZATION_FLAGS_RELEASE} ${WARNING_FLAGS} ${BOARD_FLAGS}")
+set(CMAKE_CXX_FLAGS_RELEASE "${CPP_FLAGS} ${MCU_FLAGS} ${OPTIMIZATION_FLAGS_RELEASE} ${WARNING_FLAGS} ${BOARD_FLAGS}")
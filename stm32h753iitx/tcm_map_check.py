@@ -0,0 +1,207 @@
+"""Report what the link placed in ITCM and DTCM and fail if the control hot path doesn't fit.
+
+Reads the GNU ld map file of the firmware. Lists every allocated output section in each TCM
+region with the objects and symbols that went into it, then checks that the ZP_FAST_CODE,
+ZP_FAST_DATA and ZP_FAST_BSS input sections all landed in their TCM region and that each
+region stays within its budget (the full region unless given).
+
+Usage: python tcm_map_check.py <firmware.map> [--itcm-budget BYTES] [--dtcm-budget BYTES]
+"""
+import argparse
+import os
+import re
+import sys
+
+# Input sections from tcm_placement.hpp and the region each one has to end up in
+FAST_SECTIONS = {
+    '.itcm_text': 'ITCMRAM',
+    '.dtcm_data': 'DTCMRAM',
+    '.dtcm_bss': 'DTCMRAM',
+}
+TCM_REGIONS = ('ITCMRAM', 'DTCMRAM')
+
+# Not allocated on the target, ld still gives them address 0 which falls inside ITCM
+NON_ALLOC_PREFIXES = ('.debug', '.comment', '.ARM.attributes', '.stab', '.gnu.attributes')
+
+REGION_RE = re.compile(r'^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)')
+ADDR_SIZE_RE = re.compile(r'^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+(.*))?$')
+SECTION_RE = re.compile(r'^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+(.*))?$')
+SYMBOL_RE = re.compile(r'^\s{16}0x([0-9a-fA-F]+)\s{2,}(\S.*)$')
+
+
+class OutputSection:
+    def __init__(self, name, addr, size):
+        self.name = name
+        self.addr = addr
+        self.size = size
+        self.inputs = []
+
+
+class InputSection:
+    def __init__(self, name, addr, size, obj):
+        self.name = name
+        self.addr = addr
+        self.size = size
+        self.obj = obj
+        self.symbols = []
+
+
+def parse_size(text):
+    # Bytes, hex or a K suffix like the linker script lengths
+    text = text.strip()
+    if text[-1:] in ('k', 'K'):
+        return int(text[:-1], 0) * 1024
+    return int(text, 0)
+
+
+def short_object(path):
+    # libzeropilot4.0.a(attitude_manager.cpp.obj) instead of the full build path
+    return os.path.basename(path.split('(')[0]) + ('(' + path.split('(', 1)[1] if '(' in path else '')
+
+
+def fast_region(name):
+    for section, region in FAST_SECTIONS.items():
+        if name == section or name.startswith(section + '.'):
+            return region
+    return None
+
+
+def parse_map(path):
+    with open(path, errors='replace') as f:
+        lines = f.read().splitlines()
+
+    regions = {}
+    sections = []
+    i = 0
+
+    while i < len(lines) and not lines[i].startswith('Memory Configuration'):
+        i += 1
+    while i < len(lines) and not lines[i].startswith('Linker script and memory map'):
+        m = REGION_RE.match(lines[i])
+        if m and m.group(1) not in ('Name', '*default*'):
+            regions[m.group(1)] = (int(m.group(2), 16), int(m.group(3), 16))
+        i += 1
+
+    current_out = None
+    current_in = None
+    while i < len(lines):
+        line = lines[i]
+        i += 1
+        if not line.strip():
+            continue
+
+        # Long names put the address and size on the next line
+        if not line[0].isspace() and line.startswith('.') and len(line.split()) == 1:
+            if i < len(lines):
+                m = ADDR_SIZE_RE.match(lines[i])
+                if m:
+                    line = line + ' ' + lines[i].strip()
+                    i += 1
+        elif line.startswith(' ') and not line.startswith('  ') and len(line.split()) == 1 \
+                and line.strip().startswith('.'):
+            if i < len(lines):
+                m = ADDR_SIZE_RE.match(lines[i])
+                if m and m.group(3):
+                    line = line + ' ' + lines[i].strip()
+                    i += 1
+
+        if not line[0].isspace():
+            m = SECTION_RE.match(line)
+            if m:
+                current_out = OutputSection(m.group(1), int(m.group(2), 16), int(m.group(3), 16))
+                sections.append(current_out)
+            else:
+                current_out = None
+            current_in = None
+            continue
+
+        if current_out is None:
+            continue
+
+        if line.startswith(' ') and not line.startswith('  '):
+            m = SECTION_RE.match(line[1:])
+            if m and m.group(4) and m.group(1) != '*fill*':
+                current_in = InputSection(m.group(1), int(m.group(2), 16), int(m.group(3), 16),
+                                          short_object(m.group(4).strip()))
+                current_out.inputs.append(current_in)
+            else:
+                current_in = None
+            continue
+
+        m = SYMBOL_RE.match(line)
+        if m and current_in is not None:
+            name = m.group(2).strip()
+            # Linker script assignments and PROVIDEs, not symbols from the objects
+            if ' = ' in name or name.startswith(('.', 'PROVIDE', 'ASSERT')):
+                continue
+            current_in.symbols.append((int(m.group(1), 16), name))
+
+    return regions, sections
+
+
+def in_region(addr, region):
+    origin, length = region
+    return origin <= addr < origin + length
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Report and check the ITCM/DTCM placement of the control hot path.")
+    parser.add_argument('map', help="GNU ld map file of the firmware")
+    parser.add_argument('--itcm-budget', type=parse_size, default=None, help="Bytes the ITCM may use (default whole region)")
+    parser.add_argument('--dtcm-budget', type=parse_size, default=None, help="Bytes the DTCM may use (default whole region)")
+    parser.add_argument('--no-symbols', action='store_true', help="Only list objects, not the symbols in them")
+    args = parser.parse_args()
+
+    regions, sections = parse_map(args.map)
+    budgets = {'ITCMRAM': args.itcm_budget, 'DTCMRAM': args.dtcm_budget}
+    errors = []
+
+    print("TCM placement in {}".format(args.map))
+    for region_name in TCM_REGIONS:
+        if region_name not in regions:
+            errors.append("memory region {} not in the map".format(region_name))
+            continue
+
+        region = regions[region_name]
+        budget = budgets[region_name] if budgets[region_name] is not None else region[1]
+        placed = [s for s in sections
+                  if s.size > 0 and in_region(s.addr, region) and not s.name.startswith(NON_ALLOC_PREFIXES)]
+        used = sum(s.size for s in placed)
+
+        print()
+        print("{:<10} 0x{:08x}  {:>8} / {:>8} bytes ({:.1f}%)".format(
+            region_name, region[0], used, budget, 100.0 * used / budget if budget else 0.0))
+        for s in placed:
+            print("  {:<20} 0x{:08x} {:>8}".format(s.name, s.addr, s.size))
+            for inp in s.inputs:
+                if inp.size == 0:
+                    continue
+                print("    {:>8}  {}".format(inp.size, inp.obj))
+                if not args.no_symbols:
+                    for addr, name in inp.symbols:
+                        print("              0x{:08x}  {}".format(addr, name))
+
+        if used > budget:
+            errors.append("{} uses {} bytes, over its {} byte budget by {}".format(
+                region_name, used, budget, used - budget))
+
+    # A linker script without the TCM sections leaves the fast sections as orphans in flash or RAM_D1
+    for s in sections:
+        for inp in s.inputs:
+            region_name = fast_region(inp.name)
+            if region_name is None or inp.size == 0 or region_name not in regions:
+                continue
+            if not in_region(inp.addr, regions[region_name]):
+                errors.append("{} from {} is at 0x{:08x}, outside {}".format(
+                    inp.name, inp.obj, inp.addr, region_name))
+
+    print()
+    for e in errors:
+        print("error: " + e, file=sys.stderr)
+    if errors:
+        sys.exit(1)
+    print("TCM placement OK")
+
+
+if __name__ == '__main__':
+    main()
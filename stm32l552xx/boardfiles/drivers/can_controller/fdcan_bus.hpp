@@ -0,0 +1,43 @@
+#pragma once
+
+#include "can_bus_iface.hpp"
+#include "stm32l5xx_hal.h"
+
+/*
+ * DroneCAN bus on an FDCAN peripheral, frames passing the acceptance filters go to RX FIFO0.
+ * Classic CAN unless built with CANARD_ENABLE_CANFD, which switches the peripheral to FD frames
+ * with bit rate switching. Classic frames are received and sent either way.
+ */
+class FDCANBus : public ICANBus {
+    public:
+        FDCANBus(FDCAN_HandleTypeDef *hfdcan);
+
+        // Frame format, filters, interrupts and start, call once the bus task and CAN controller exist
+        void init();
+
+        bool transmit(const CANFrame_t &frame) override;
+
+        // Programmed by init(), up to the ExtFiltersNbr elements CubeMX gave the peripheral. init() halts
+        // in Error_Handler if a filter list was rejected
+        bool setAcceptanceFilters(const CANAcceptanceFilter_t *filters, uint8_t count) override;
+
+        // False in classic builds and when the kernel clock can't make CAN_FD_DATA_BITRATE_BPS
+        bool isFdEnabled() const { return fdEnabled; }
+
+        FDCAN_HandleTypeDef *getHandle() const { return hfdcan; }
+
+        static uint8_t dlcToLength(uint32_t dlc);
+        static uint32_t lengthToDlc(uint8_t length);
+
+    private:
+        static constexpr uint8_t MAX_FILTERS = CAN_MAX_ACCEPTANCE_FILTERS;
+
+        FDCAN_HandleTypeDef *hfdcan;
+        CANAcceptanceFilter_t filters[MAX_FILTERS];
+        uint8_t filterCount;
+        bool filtersRejected;
+        bool fdEnabled;
+
+        void configureFilters();
+        bool enableFd();
+};
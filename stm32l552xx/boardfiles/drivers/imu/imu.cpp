@@ -84,6 +84,7 @@ IMU::IMU(SPI_HandleTypeDef *spiHandle,
     imuOdr(odrConfig),
     uiFiltCutoffHz(uiFiltCutoffHz),
     uiFiltOrder(uiFiltOrder),
+    timeSync(TIMESTAMP_RES_US, odrToHz(odrConfig)),
     alpha(0.1f) {
 
     filteredGyro[0] = filteredGyro[1] = filteredGyro[2] = 0.0f;
@@ -168,7 +169,7 @@ ScaledImuBatch_t IMU::scaleIMUData(const RawImuBatch_t &rawDataBatch) {
         scaledData[i].xgyro = (float)rawDataBatch.data[i].xgyro / GYRO_SEN_SCALE_FACTOR * ZP_UNITS::DEG_TO_RAD;
         scaledData[i].ygyro = (float)rawDataBatch.data[i].ygyro / GYRO_SEN_SCALE_FACTOR * ZP_UNITS::DEG_TO_RAD;
         scaledData[i].zgyro = (float)rawDataBatch.data[i].zgyro / GYRO_SEN_SCALE_FACTOR * ZP_UNITS::DEG_TO_RAD;
-        scaledData[i].timestamp = rawDataBatch.data[i].timestamp;
+        scaledData[i].timestampUs = rawDataBatch.data[i].timestampUs;
         scaledData[i].imuId = rawDataBatch.data[i].imuId;
     }
     scaledImuDataBatch.count = rawDataBatch.count;
@@ -344,7 +345,7 @@ void IMU::setODR() {
 }
 
 void IMU::setAAF() {
-    uint16_t desiredBandwidth = getODRHz() / 4; // Set AAF bandwidth to 1/4 of ODR
+    uint16_t desiredBandwidth = odrToHz(imuOdr) / 4; // Set AAF bandwidth to 1/4 of ODR
     uint8_t bestIndex = 0;
     uint16_t bestDistance = UINT16_MAX;
     // Table is sorted ascending, so distance falls to a minimum then rises again.
@@ -380,7 +381,7 @@ float IMU::getUIFiltBWHz(uint8_t bandwidthSelect) {
     if (bandwidthSelect >= UIFILT_BW_SEL_COUNT) {
         return 0.0f;
     }
-    float odr = getODRHz();
+    float odr = odrToHz(imuOdr);
     float max = (bandwidthSelect == 0 || odr > 400.0f) ? odr : 400.0f;
     return max / divisors[bandwidthSelect];
 }
@@ -437,6 +438,9 @@ void IMU::processRawData() {
     rawImuDataBatch.data = rawData;
     rawImuDataBatch.count = validData;
     rawImuDataBatch.readTime = SystemUtils::getDWTMicroSec();
+
+    // Convert hardware timestamps to synchronized DWT time
+    timeSync.stampBatch(rawData, validData, rawImuDataBatch.readTime);
 }
 
 float IMU::lowPassFilter(float rawValue, int select) {
@@ -445,7 +449,11 @@ float IMU::lowPassFilter(float rawValue, int select) {
 }
 
 float IMU::getODRHz() {
-    switch (imuOdr) {
+    return timeSync.getMeasuredODRHz();
+}
+
+float IMU::odrToHz(ImuOdrConfig_t odr) {
+    switch (odr) {
         case IMU_ODR_32KHZ: return 32000.0f;
         case IMU_ODR_16KHZ: return 16000.0f;
         case IMU_ODR_8KHZ:  return 8000.0f;
@@ -462,6 +470,17 @@ float IMU::getODRHz() {
     }
 }
 
+ImuOdrConfig_t IMU::odrFromHz(float hz) {
+    switch (static_cast<int>(hz)) {
+        case 8000: return IMU_ODR_8KHZ;
+        case 4000: return IMU_ODR_4KHZ;
+        case 2000: return IMU_ODR_2KHZ;
+        case 1000: return IMU_ODR_1KHZ;
+        case 500:  return IMU_ODR_500HZ;
+        default:   return IMU_ODR_1KHZ;
+    }
+}
+
 GyroBias_t IMU::getGyroStartupBias(uint8_t imuId) {
     return (this->imuId == imuId) ? gyroBias : GyroBias_t{0.0f, 0.0f, 0.0f};
 }
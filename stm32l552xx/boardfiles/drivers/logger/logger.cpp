@@ -19,6 +19,7 @@ int Logger::init() {
 
     while (exist == FR_OK) {
         snprintf(file, 100, "log%d.txt", count);
+        snprintf(binFile, 100, "log%d.bin", count);
         exist = f_stat(file, &fno);
         count++;
     }
@@ -82,3 +83,21 @@ int Logger::log(const char message[][100], int count) {
     return 0;
 #endif
 }
+
+int Logger::logBinary(const void *data, uint32_t len) {
+#if defined(SD_CARD_LOGGING)
+    FRESULT res;
+    UINT written = 0;
+    res = f_open(&fil, binFile, FA_WRITE | FA_OPEN_APPEND);
+    if (res != FR_OK) {
+        return res;
+    }
+
+    res = f_write(&fil, data, len, &written);
+    f_close(&fil);
+
+    return (res == FR_OK && written != len) ? FR_DENIED : res;
+#elif defined(SWO_LOGGING)
+    return 0; // No binary channel over SWO, records are dropped
+#endif
+}
@@ -9,6 +9,7 @@ class Logger : public ILogger {
         FATFS FatFs;
         FIL fil;
         char file[100];
+        char binFile[100];
 
     public:
         Logger() = default;
@@ -27,6 +28,14 @@ class Logger : public ILogger {
          */
         int log(const char messages[][100], int count);
 
+        /**
+         * @brief appends raw records to the binary log next to the text log (logN.bin)
+         * @param data: records to be written
+         * @param len: number of bytes
+         * @retval DRESULT: Operation result
+         */
+        int logBinary(const void *data, uint32_t len);
+
         /**
          * @brief mounts SD card and selects file to write to, call before starting kernel
          */
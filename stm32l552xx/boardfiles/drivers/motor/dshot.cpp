@@ -1,64 +1,161 @@
 #include "dshot.hpp"
-#include <cstring>
 
-static constexpr uint16_t DSHOT_1_CCR =	275;    // CCR for dshot300 logic 1 
-static constexpr uint16_t DSHOT_0_CCR =	137;    // CCR for dshot300 logic 0 
-
-static constexpr uint16_t MAX_THROTTLE = 2047;  // 11 bit max val
 static constexpr uint16_t OFFSET = 100;     // Armed standby throttle
-static constexpr uint16_t MIN_THROTTLE = 48 + OFFSET;    // 0-47 reserved for special commands
+static constexpr uint16_t MIN_THROTTLE = DSHOT_THROTTLE_MIN + OFFSET;
+
+// TIM_CHANNEL_1-4 are 0x0, 0x4, 0x8, 0xC
+static uint8_t channelToSlot(uint32_t timerChannel) {
+    return (uint8_t)(timerChannel >> 2);
+}
+
+static uint32_t slotToChannel(uint8_t slot) {
+    return (uint32_t)slot << 2;
+}
+
+// Timers run at twice their APB clock whenever the APB is divided down
+static uint32_t timerClockHz(TIM_HandleTypeDef *timer) {
+    TIM_TypeDef *tim = timer->Instance;
+    if (tim == TIM1 || tim == TIM8 || tim == TIM15 || tim == TIM16 || tim == TIM17) {
+        uint32_t pclk = HAL_RCC_GetPCLK2Freq();
+        return (RCC->CFGR & RCC_CFGR_PPRE2_2) ? pclk * 2 : pclk;
+    }
+    uint32_t pclk = HAL_RCC_GetPCLK1Freq();
+    return (RCC->CFGR & RCC_CFGR_PPRE1_2) ? pclk * 2 : pclk;
+}
+
+// Applies the DShot bit period to the timer, unsupported rates fall back to DShot300
+static void initTiming(TIM_HandleTypeDef *timer, uint16_t rateKbps, DshotTiming_t &timing, DshotCompareTable &table) {
+    uint32_t clockHz = timerClockHz(timer);
+    if (!DshotCodec::timingForRate(clockHz, rateKbps, timing)) {
+        DshotCodec::timingForRate(clockHz, DSHOT_DEFAULT_RATE, timing);
+    }
+    table.build(timing.oneCompare, timing.zeroCompare);
+
+    timer->Init.Prescaler = 0;
+    timer->Init.Period = timing.period - 1;
+    if (HAL_TIM_Base_Init(timer) != HAL_OK) {
+        // Error_Handler();
+    }
+}
+
+DshotBurstGroup::DshotBurstGroup(TIM_HandleTypeDef *timer, uint32_t burstRequest, uint16_t rateKbps) :
+    timer_(timer),
+    burstRequest_(burstRequest),
+    rateKbps_(rateKbps),
+    timing_{},
+    activeMask_(0),
+    pendingMask_(0),
+    initialized_(false),
+    burstBuffer_{} {}
+
+int8_t DshotBurstGroup::addChannel(uint32_t timerChannel) {
+    uint8_t slot = channelToSlot(timerChannel);
+    if (initialized_ || slot >= DSHOT_BURST_CHANNELS || (activeMask_ & (1 << slot))) {
+        return -1;
+    }
+
+    activeMask_ |= 1 << slot;
+    return (int8_t)slot;
+}
+
+void DshotBurstGroup::init() {
+    if (initialized_) return;
+    initialized_ = true;
+
+    initTiming(timer_, rateKbps_, timing_, compareTable_);
 
-static constexpr uint16_t THROTTLE_MASK = 0x7FF;
-static constexpr uint8_t THROTTLE_SHIFT = 5;
-static constexpr uint8_t TEL_MASK = 1;
-static constexpr uint8_t TEL_SHIFT = 4;
-static constexpr uint8_t CRC_MASK = 0x0F;
+    for (uint8_t slot = 0; slot < DSHOT_BURST_CHANNELS; slot++) {
+        if (activeMask_ & (1 << slot)) {
+            HAL_TIM_PWM_Start(timer_, slotToChannel(slot));
+        }
+    }
+}
+
+void DshotBurstGroup::setFrame(uint8_t slot, uint16_t frame) {
+    if (slot >= DSHOT_BURST_CHANNELS || !(activeMask_ & (1 << slot))) return;
+
+    // Previous frame still going out, the buffer belongs to the DMA
+    if (timer_->DMABurstState == HAL_DMA_BURST_STATE_BUSY) return;
+
+    compareTable_.frameToCompare(frame, &burstBuffer_[0][slot], DSHOT_BURST_CHANNELS);
+    pendingMask_ |= 1 << slot;
+
+    if (pendingMask_ == activeMask_) {
+        pendingMask_ = 0;
+        if (HAL_TIM_DMABurst_MultiWriteStart(timer_, TIM_DMABASE_CCR1, burstRequest_, (uint32_t*)burstBuffer_,
+                                             TIM_DMABURSTLENGTH_4TRANSFERS, DSHOT_FRAME_SLOTS * DSHOT_BURST_CHANNELS) != HAL_OK) {
+            // Error_Handler();    Error handling to be done
+        }
+    }
+}
+
+void DshotBurstGroup::transferCompleteCallback() {
+    HAL_TIM_DMABurst_WriteStop(timer_, burstRequest_);
+}
 
+TIM_HandleTypeDef *DshotBurstGroup::getTimer() {
+    return timer_;
+}
 
-DshotMotorControl::DshotMotorControl(TIM_HandleTypeDef *timer, uint32_t timerChannel, bool telReq):
+DshotMotorControl::DshotMotorControl(TIM_HandleTypeDef *timer, uint32_t timerChannel, bool telReq, uint16_t rateKbps):
     timer(timer), 
     timerChannel(timerChannel), 
-    telReq(telReq){}
+    telReq(telReq),
+    rateKbps(rateKbps),
+    group(nullptr),
+    slot(-1) {}
+
+DshotMotorControl::DshotMotorControl(DshotBurstGroup *group, uint32_t timerChannel):
+    timer(group->getTimer()),
+    timerChannel(timerChannel),
+    telReq(false),
+    rateKbps(DSHOT_DEFAULT_RATE),
+    group(group),
+    slot(group->addChannel(timerChannel)) {}
 
 void DshotMotorControl::set(uint32_t percent) {
     percent =  (percent > 100) ? 100 : percent;
+    setThrottle((uint16_t)(percent * DSHOT_THROTTLE_FULL_SCALE / 100));
+}
+
+void DshotMotorControl::setNormalized(float command) {
+    if (!(command > 0.0f)) {
+        command = 0.0f;
+    } else if (command > 1.0f) {
+        command = 1.0f;
+    }
+    setThrottle((uint16_t)(command * DSHOT_THROTTLE_FULL_SCALE + 0.5f));
+}
 
+void DshotMotorControl::setThrottle(uint16_t throttle) {
     // Throttle 0 = disarm, 48-2047 = active throttle range
-    uint32_t throttleVal = 0;
+    uint16_t throttleVal = 0;
     if (armFlag) {
-        throttleVal = (percent == 0) ? MIN_THROTTLE : (percent / 100.0) * (MAX_THROTTLE - MIN_THROTTLE) + MIN_THROTTLE;
+        throttleVal = DshotCodec::scaleThrottle(throttle, DSHOT_THROTTLE_FULL_SCALE, MIN_THROTTLE);
     }
 
-    // 11 bits throttle + 1 bit telemetry request + 4 bits CRC
-    uint8_t crc = DshotMotorControl::calculateCrc(throttleVal, telReq);
-    uint16_t frame = ( (throttleVal & THROTTLE_MASK) << THROTTLE_SHIFT ) | ( (telReq & TEL_MASK) << TEL_SHIFT ) | (crc & CRC_MASK);
-
-    // Encode each bit to CRC val into temp buffer
-	for (int i = 0; i < DSHOT_FRAME_LEN; i++) {
-		uint8_t bit = (frame >> (DSHOT_FRAME_LEN - 1 - i)) & 1;
-        updateBuffer[i] = (bit == 1) ? DSHOT_1_CCR : DSHOT_0_CCR;
-	}
+    uint16_t frame = DshotCodec::encodeFrame(throttleVal, telReq, false);
 
-    // Set last index CRC to 0 to idle low after the frame until next PID call
-    updateBuffer[DSHOT_BUF_LEN - 1] = 0;
+    if (group != nullptr) {
+        if (slot >= 0) {
+            group->setFrame(slot, frame);
+        }
+        return;
+    }
 
-    memcpy(dmaBuffer, updateBuffer, sizeof(updateBuffer));
-    if (HAL_TIM_PWM_Start_DMA(timer, timerChannel, (uint32_t*)dmaBuffer, DSHOT_BUF_LEN) != HAL_OK) {
+    // Compare value per bit with a trailing 0 to idle low after the frame until next PID call
+    compareTable.frameToCompare(frame, dmaBuffer);
+    if (HAL_TIM_PWM_Start_DMA(timer, timerChannel, (uint32_t*)dmaBuffer, DSHOT_FRAME_SLOTS) != HAL_OK) {
         // Error_Handler();    Error handling to be done
     }
 }
 
 void DshotMotorControl::init() {
-    timer->Init.Prescaler = 0;
-    timer->Init.Period = 366;
-    if (HAL_TIM_Base_Init(timer) != HAL_OK) {
-        // Error_Handler();
+    if (group != nullptr) {
+        group->init();
+    } else {
+        initTiming(timer, rateKbps, timing, compareTable);
     }
     setArm(false);
     this->set(0);
 }
-
-uint8_t DshotMotorControl::calculateCrc(uint16_t throttleVal, uint8_t telReq) {
-    uint16_t preCrc = (throttleVal << 1) | telReq;
-    return (preCrc ^ (preCrc >> 4) ^ (preCrc >> 8)) & CRC_MASK;
-}
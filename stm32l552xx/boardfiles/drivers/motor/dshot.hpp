@@ -1,14 +1,74 @@
 #pragma once
 
 #include "motor_iface.hpp"
+#include "dshot_codec.hpp"
 #include "stm32l5xx_hal.h"
 
-static constexpr uint8_t DSHOT_FRAME_LEN = 16;  // 11 bits throttle + 1 bit telem + 4 bits CRC
-static constexpr uint8_t DSHOT_BUF_LEN = DSHOT_FRAME_LEN + 1;   // Extra idle slot to hold line low after frame
+static constexpr uint8_t DSHOT_BURST_CHANNELS = 4;  // CCR1-CCR4 of one timer
+static constexpr uint16_t DSHOT_DEFAULT_RATE = 300;  // Used when the requested rate does not fit the timer clock
+static constexpr uint16_t DSHOT_THROTTLE_FULL_SCALE = 0xFFFF;
+
+/**
+ * @class DshotBurstGroup
+ * @brief Drives every DShot channel of one timer with a single DMA burst so all motors get
+ * their frame at the same time. Every DMA channel on this board is taken, so the burst rides
+ * on the channel 1 compare request and bidirectional replies are not captured.
+ */
+class DshotBurstGroup {
+    public:
+        /**
+         * @param timer timer whose CCR1-CCR4 are written
+         * @param burstRequest TIM_DMA_xxx request linked to the burst DMA channel
+         * @param rateKbps DShot150/300/600/1200
+         */
+        DshotBurstGroup(TIM_HandleTypeDef *timer, uint32_t burstRequest, uint16_t rateKbps);
+
+        /**
+         * @brief registers a channel before init
+         * @return slot used for setFrame, -1 if the channel is invalid or taken
+         */
+        int8_t addChannel(uint32_t timerChannel);
+
+        /**
+         * @brief configures the timer for DShot, safe to call once per channel
+         */
+        void init();
+
+        /**
+         * @brief queues a frame, the burst goes out once every registered slot has a new frame
+         */
+        void setFrame(uint8_t slot, uint16_t frame);
+
+        /**
+         * @brief called from the HAL callback when the burst DMA completes
+         */
+        void transferCompleteCallback();
+
+        TIM_HandleTypeDef *getTimer();
+
+    private:
+        TIM_HandleTypeDef * const timer_;
+        const uint32_t burstRequest_;
+        const uint16_t rateKbps_;
+
+        DshotTiming_t timing_;
+        DshotCompareTable compareTable_;
+
+        uint8_t activeMask_;
+        uint8_t pendingMask_;
+        bool initialized_;
+
+        uint16_t burstBuffer_[DSHOT_FRAME_SLOTS][DSHOT_BURST_CHANNELS];
+};
 
 class DshotMotorControl : public IMotorControl{
     public:
-        DshotMotorControl(TIM_HandleTypeDef *timer, uint32_t timerChannel, bool telReq);
+        DshotMotorControl(TIM_HandleTypeDef *timer, uint32_t timerChannel, bool telReq, uint16_t rateKbps = DSHOT_DEFAULT_RATE);
+
+        /**
+         * @brief DShot output sharing a burst DMA with the other channels of its timer
+         */
+        DshotMotorControl(DshotBurstGroup *group, uint32_t timerChannel);
 
         /**
          * @brief sets dshot throttle output
@@ -16,6 +76,18 @@ class DshotMotorControl : public IMotorControl{
          */
         void set(uint32_t percent) override;
 
+        /**
+         * @brief sets dshot throttle output at full 11 bit resolution
+         * @param throttle 0 to DSHOT_THROTTLE_FULL_SCALE
+         */
+        void setThrottle(uint16_t throttle);
+
+        /**
+         * @brief sets dshot throttle output from the mixer command
+         * @param command 0-1, mapped onto the active throttle range
+         */
+        void setNormalized(float command) override;
+
         /**
          * @brief starts arming sequence for ESC
          */
@@ -25,9 +97,13 @@ class DshotMotorControl : public IMotorControl{
         TIM_HandleTypeDef * const timer;
         const uint32_t timerChannel;
         const uint8_t telReq;
+        const uint16_t rateKbps;
+
+        DshotTiming_t timing = {};
+        DshotCompareTable compareTable;
 
-        uint16_t updateBuffer[DSHOT_BUF_LEN] = {0};
-        uint16_t dmaBuffer[DSHOT_BUF_LEN] = {0};
+        DshotBurstGroup * const group;
+        int8_t slot;
 
-        static uint8_t calculateCrc(uint16_t throttleVal, uint8_t telReq);
+        uint16_t dmaBuffer[DSHOT_FRAME_SLOTS] = {0};
 };
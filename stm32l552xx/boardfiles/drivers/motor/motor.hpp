@@ -13,6 +13,12 @@ class MotorControl : public IMotorControl {
          */
         void set(uint32_t percent) override;
 
+        /**
+         * @brief sets PWM motor output at timer tick resolution
+         * @param command 0-1 across the min to max duty cycle
+         */
+        void setNormalized(float command) override;
+
         /**
          * @brief starts PWM output
          */
@@ -3,10 +3,20 @@
 #include <cstdio>
 #include "rc_defines.hpp"
 #include "rc_crsf.hpp"
+#include "systemutils.hpp"
 
-CRSFReceiver::CRSFReceiver(UART_HandleTypeDef* uart) : uart(uart) {
-    memset(crsfRxBuffer, 0, CRSF_BYTE_COUNT);
-}
+CRSFReceiver::CRSFReceiver(UART_HandleTypeDef* uart, LatestValueSlot<RCChannelFrame_t> *fastPath, const LatestValueSlot<RCNavTelemetry_t> *navTelemetry) :
+    uart(uart),
+    fastPath(fastPath),
+    crsfRxBuffer{},
+    rxRing(crsfRxBuffer, CRSF_RX_BUFFER_SIZE),
+    lastLinkStats{},
+    linkStatsSeq(0),
+    rxLinkStats{},
+    systemTelemetrySeq(0),
+    navTelemetry(navTelemetry),
+    navTelemetrySeq(0),
+    txBuffer{} {}
 
 RCControl CRSFReceiver::getRCData() {
     RCControl tmp = rcData;
@@ -14,80 +24,109 @@ RCControl CRSFReceiver::getRCData() {
     return tmp;
 }
 
+RCLinkStats_t CRSFReceiver::getLinkStats() {
+    linkStats.readIfNew(lastLinkStats, linkStatsSeq);
+    return lastLinkStats;
+}
+
+void CRSFReceiver::setTelemetry(const RCSystemTelemetry_t &telemetry) {
+    systemTelemetry.publish(telemetry);
+}
+
 void CRSFReceiver::init() {
-    // start circular DMA
     rcData.isDataNew = false;
-    HAL_UARTEx_ReceiveToIdle_DMA(uart, crsfRxBuffer, CRSF_BYTE_COUNT);
+    rxRing.reset();
+    parser.reset();
+    HAL_UARTEx_ReceiveToIdle_DMA(uart, (uint8_t*)crsfRxBuffer, CRSF_RX_BUFFER_SIZE);
 }
 
 void CRSFReceiver::startDMA() {
-    // start circular DMA
-    HAL_UARTEx_ReceiveToIdle_DMA(uart, crsfRxBuffer, CRSF_BYTE_COUNT);
+    // Runs on every UART error. Restarting rewinds the DMA to the start of the buffer, the next
+    // rxCallback() drops the partial frame but keeps the parser counters and last link stats
+    rxRing.onDmaRestart();
+    HAL_UARTEx_ReceiveToIdle_DMA(uart, (uint8_t*)crsfRxBuffer, CRSF_RX_BUFFER_SIZE);
 }
 
-// Polynomial used in CRSF: 0xD5
-static uint8_t crsf_crc8(const uint8_t *data, uint8_t len) {
-    uint8_t crc = 0;
-    while (len--) {
-        crc ^= *data++;
-        for (int i = 0; i < 8; i++) {
-            if (crc & 0x80)
-                crc = (crc << 1) ^ 0xD5;
-            else
-                crc <<= 1;
+void CRSFReceiver::rxCallback(uint16_t size) {
+    // Circular DMA keeps running, parse whatever arrived since the last event
+    rxRing.onDmaEvent(size);
+
+    const uint8_t *span;
+    uint16_t len;
+    while ((len = rxRing.readSpan(span)) > 0) {
+        // An overrun or DMA restart skipped bytes before this span
+        if (rxRing.takeDiscontinuity()) {
+            parser.resync();
         }
+        parser.feed(span, len);
+        rxRing.advance(len);
     }
-    return crc;
-}
-
-void CRSFReceiver::parse() {
 
-    uint8_t *buf = crsfRxBuffer;
-
-    // Validate sync byte and frame type
-   if (buf[0] != CRSF_SYNC_BYTE || buf[2] != CRSF_FRAMETYPE_RC_CHANNELS_PACKED) {
-       return;
-   }
-
-    uint8_t length = buf[1];
-    // Extract payload
-    const uint8_t *payload = &buf[3];
-
-    // The CRC is the last byte of the frame
-    const uint8_t crcFromPacket = buf[1 + length];
-    const uint8_t crcCalc = crsf_crc8(&buf[2], length - 1); // TYPE+PAYLOAD
-    
-    if (crcFromPacket != crcCalc) {
-        return; // corrupted frame, ignore
+    CrsfLinkStats_t stats;
+    if (parser.takeLinkStats(stats)) {
+        RCLinkStats_t link;
+        link.isValid = true;
+        link.linkQuality = stats.uplinkLinkQuality;
+        link.rssiDbm = -(int16_t)((stats.activeAntenna == 0) ? stats.uplinkRssi1 : stats.uplinkRssi2);
+        link.snrDb = stats.uplinkSnr;
+        rxLinkStats = link;
+        linkStats.publish(link);
     }
 
-    // Decode channels
-    uint16_t channels[16];
-    uint32_t bitBuffer = 0;
-    uint8_t bitsInBuffer = 0;
-    uint8_t payloadIndex = 0;
-
-    for (int i = 0; i < 16; ++i) {
-        while (bitsInBuffer < 11) {
-            bitBuffer |= ((uint32_t)payload[payloadIndex++]) << bitsInBuffer;
-            bitsInBuffer += 8;
-        }
-        channels[i] = bitBuffer & 0x7FF; // Extract 11 bits
-        bitBuffer >>= 11;
-        bitsInBuffer -= 11;
+    uint16_t channels[CRSF_CHANNEL_COUNT];
+    if (parser.takeChannels(channels)) {
+        onChannels(channels);
+        sendTelemetry();
+    }
+}
 
+void CRSFReceiver::onChannels(const uint16_t (&channels)[CRSF_CHANNEL_COUNT]) {
+    for (int i = 0; i < CRSF_CHANNEL_COUNT; ++i) {
         if (i < 4) { //stick channels
             rcData.controlSignals[i] = static_cast<float>((channels[i] - CRSF_PULSE_MIN) * (100.0f / CRSF_PULSE_RANGE));
-        } 
-        else{
+        }
+        else {
             // ARM and AUX channels
             rcData.controlSignals[i] = static_cast<float>((channels[i] - CRSF_AUX_MIN) * (100.0f / CRSF_AUX_RANGE));
         }
     }
 
     rcData.isDataNew = true;
+
+    if (fastPath != nullptr) {
+        RCChannelFrame_t frame;
+        memcpy(frame.controlSignals, rcData.controlSignals, sizeof(frame.controlSignals));
+        frame.linkStats = rxLinkStats;
+        fastPath->publish(frame);
+    }
+}
+
+void CRSFReceiver::sendTelemetry() {
+    RCSystemTelemetry_t system;
+    if (systemTelemetry.readIfNew(system, systemTelemetrySeq)) {
+        crsfTelemetry.setSystem(system);
+    }
+
+    RCNavTelemetry_t nav;
+    if (navTelemetry != nullptr && navTelemetry->readIfNew(nav, navTelemetrySeq)) {
+        crsfTelemetry.setNav(nav);
+    }
+
+    // The slot right after an RC frame, HAL_BUSY means the previous frame is still going out
+    uint8_t len = crsfTelemetry.onRcFrame(SystemUtils::getDWTMicroSec(), txBuffer, sizeof(txBuffer));
+    if (len > 0) {
+        HAL_UART_Transmit_IT(uart, txBuffer, len);
+    }
 }
 
 UART_HandleTypeDef * CRSFReceiver::getHuart() {
-	return uart;
+    return uart;
+}
+
+const CrsfParserStats_t &CRSFReceiver::getParserStats() const {
+    return parser.getStats();
+}
+
+uint32_t CRSFReceiver::getOverrunBytes() const {
+    return rxRing.getOverrunBytes();
 }
@@ -2,17 +2,21 @@
 
 #include "rc_defines.hpp"
 #include "rc_iface.hpp"
+#include "latest_value_slot.hpp"
+#include "dma_rx_ring.hpp"
+#include "crsf_stream_parser.hpp"
+#include "crsf_telemetry.hpp"
 #include "stm32l5xx_hal.h"
 /**
  * @class CRSFReceiver
- * @brief A class to receive and parse CRSF RC channel data via UART.
+ * @brief A class to receive and parse CRSF RC channel data and send CRSF telemetry via UART.
  *
  * @note UART Configuration Requirements:
  * - BaudRate: 420000
  * - WordLength: UART_WORDLENGTH_8B
  * - Parity: UART_PARITY_NONE
  * - StopBits: UART_STOPBITS_1
- * - Mode: UART_MODE_RX
+ * - Mode: UART_MODE_TX_RX
  * - HwFlowCtl: UART_HWCONTROL_NONE
  * - OverSampling: UART_OVERSAMPLING_16
  * - OneBitSampling: UART_ONE_BIT_SAMPLE_DISABLE
@@ -21,18 +25,48 @@
  */
 class CRSFReceiver : public IRCReceiver {
     public:
-        CRSFReceiver(UART_HandleTypeDef *uart);
+        CRSFReceiver(UART_HandleTypeDef *uart, LatestValueSlot<RCChannelFrame_t> *fastPath = nullptr,
+                     const LatestValueSlot<RCNavTelemetry_t> *navTelemetry = nullptr);
 
         RCControl getRCData() override;
+        RCLinkStats_t getLinkStats() override;
+        void setTelemetry(const RCSystemTelemetry_t &telemetry) override;
 
         void init();
         void startDMA();
 
-        void parse();
+        // Half/full transfer and idle events, size is the DMA position in the ring
+        void rxCallback(uint16_t size);
+
         UART_HandleTypeDef * getHuart();
-       
+
+        const CrsfParserStats_t &getParserStats() const;
+        uint32_t getOverrunBytes() const;
+
     private:
         UART_HandleTypeDef *uart;
         RCControl rcData;
-        uint8_t crsfRxBuffer[CRSF_BYTE_COUNT];
+        LatestValueSlot<RCChannelFrame_t> *fastPath; // Every valid frame goes straight to the attitude loop
+
+        // The DMA writes into crsfRxBuffer circularly, frames are parsed in place from the ISR
+        volatile uint8_t crsfRxBuffer[CRSF_RX_BUFFER_SIZE];
+        DmaRxRing rxRing;
+        CrsfStreamParser parser;
+
+        // Link statistics from the ISR for the system manager
+        LatestValueSlot<RCLinkStats_t> linkStats;
+        RCLinkStats_t lastLinkStats;
+        uint32_t linkStatsSeq;
+        RCLinkStats_t rxLinkStats; // ISR private, stamped on every fast path frame
+
+        // Telemetry inputs from the managers, sent from the ISR in the slot after each RC frame
+        CrsfTelemetry crsfTelemetry;
+        LatestValueSlot<RCSystemTelemetry_t> systemTelemetry;
+        uint32_t systemTelemetrySeq;
+        const LatestValueSlot<RCNavTelemetry_t> *navTelemetry;
+        uint32_t navTelemetrySeq;
+        uint8_t txBuffer[CRSF_MAX_FRAME_LEN];
+
+        void onChannels(const uint16_t (&channels)[CRSF_CHANNEL_COUNT]);
+        void sendTelemetry();
 };
@@ -14,11 +14,9 @@ static constexpr uint16_t SBUS_RANGE_RANGE = (SBUS_RANGE_MAX - SBUS_RANGE_MIN);
 static constexpr uint8_t HEADER_ = 0x0F;
 static constexpr uint8_t FOOTER_ = 0x00;
 
-//---CRSF Defines----
+//---CRSF Defines---- (frame types and addresses live in crsf_stream_parser.hpp)
 
-static constexpr uint8_t  CRSF_BYTE_COUNT     = 64;
-static constexpr uint8_t  CRSF_SYNC_BYTE      = 0xC8;     // CRSF SYNC for most packets
-static constexpr uint8_t  CRSF_SYNC_ALT       = 0xEE;     // EdgeTX “outgoing” SYNC
+static constexpr uint16_t CRSF_RX_BUFFER_SIZE = 128;   // Circular DMA buffer, a few frames deep
 
 static constexpr uint16_t CRSF_PULSE_MIN = 172; //represents 988us (microseconds)
 static constexpr uint16_t CRSF_PULSE_MAX = 1811; //represents 2012us (microseconds)
@@ -27,7 +25,3 @@ static constexpr uint16_t CRSF_PULSE_RANGE = (CRSF_PULSE_MAX - CRSF_PULSE_MIN);
 static constexpr uint16_t CRSF_AUX_MIN = 191; //represents 1000us (microseconds)
 static constexpr uint16_t CRSF_AUX_MAX = 1792; //represents 2000us (microseconds)
 static constexpr uint16_t CRSF_AUX_RANGE = (CRSF_AUX_MAX - CRSF_AUX_MIN);
-
-//Frame types (can add more when implementing other frame types. Only adding RC channel frametype for now)
-static constexpr uint8_t  CRSF_FRAMETYPE_RC_CHANNELS_PACKED = 0x16;
-
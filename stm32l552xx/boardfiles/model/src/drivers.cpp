@@ -1,10 +1,19 @@
 #include "drivers.hpp"
+#include "bus_threads.hpp"
 #include "museq.hpp"
 #include "stm32l5xx_hal.h"
 #include "zp_params.hpp"
 
-#define MOT_TYPE_PWM   0
-#define MOT_TYPE_DSHOT 5
+#define MOT_TYPE_PWM       0
+#define MOT_TYPE_DSHOT150  4
+#define MOT_TYPE_DSHOT300  5
+#define MOT_TYPE_DSHOT600  6
+#define MOT_TYPE_DSHOT1200 7
+
+#define GPS_TYPE_DRONECAN 9
+#define BARO_PRIMARY_DRONECAN 1
+
+static const uint16_t DSHOT_RATE_KBPS[] = {150, 300, 600, 1200}; // Indexed from MOT_TYPE_DSHOT150
 
 // External hardware handles
 extern IWDG_HandleTypeDef hiwdg;
@@ -26,22 +35,39 @@ extern FDCAN_HandleTypeDef hfdcan1;
 SystemUtils *systemUtilsHandle = nullptr;
 MathUtils *mathUtilsHandle = nullptr;
 FFT *fftHandle = nullptr;
+FFT *sysIdFftHandle = nullptr;
 IndependentWatchdog *iwdgHandle = nullptr;
 Logger *loggerHandle = nullptr;
 
 IMotorControl *motorHandles[8] = {0};
+DshotBurstGroup *dshotGroupHandle = nullptr;
 
+FDCANBus *canBusHandle = nullptr;
 CANController *canControllerHandle = nullptr;
+DroneCANOutputGroup *canOutputGroupHandle = nullptr;
+DroneCANGPS *canGpsHandle = nullptr;
+DroneCANBarometer *canBarometerHandle = nullptr;
+DroneCANMagnetometer *canMagnetometerHandle = nullptr;
+DroneCANAirspeed *canAirspeedHandle = nullptr;
 GPS *gpsHandle = nullptr;
 CRSFReceiver *rcHandle = nullptr;
 RFD *telemLinkHandle = nullptr;
 IMU *imuHandle = nullptr;
 Barometer *barometerHandle = nullptr;
+IGPS *amGpsHandle = nullptr;
+IBarometer *amBarometerHandle = nullptr;
 PowerModule *pmHandle = nullptr;
 Rangefinder *rangefinderHandle = nullptr;
 
 MessageQueue<RCMotorControlMessage_t> *amRCQueueHandle = nullptr;
+LatestValueSlot<RCChannelFrame_t> *rcFastPathHandle = nullptr;
+LatestValueSlot<RCNavTelemetry_t> *rcNavTelemetryHandle = nullptr;
+LatestValueSlot<BatteryVoltage_t> *batteryVoltageHandle = nullptr;
+LatestValueSlot<CANBusStats_t> *canBusStatsHandle = nullptr;
+LatestValueSlot<ActuatorCommand_t> *actuatorCommandHandle = nullptr;
+EscStatusTable *escStatusHandle = nullptr;
 MessageQueue<char[100]> *smLoggerQueueHandle = nullptr;
+MessageQueue<SysIdLogBlock_t> *sysIdLogQueueHandle = nullptr;
 MessageQueue<TMMessage_t> *tmQueueHandle = nullptr;
 MessageQueue<mavlink_message_t> *messageBufferHandle = nullptr;
 
@@ -75,6 +101,7 @@ void initDrivers()
 {
     // Core utilities
     fftHandle = new FFT();
+    sysIdFftHandle = new FFT(); // Own instance so the SYSID estimate doesn't change the notch FFT length
     systemUtilsHandle = new SystemUtils();
     mathUtilsHandle = new MathUtils();
     iwdgHandle = new IndependentWatchdog(&hiwdg);
@@ -82,21 +109,42 @@ void initDrivers()
 
     // Motors (servo index matches SERVOx param)
     uint32_t servoType = int(ZP_PARAM::get(ZP_PARAM_ID::MOT_PWM_TYPE));
+    uint16_t canEscMask = (uint16_t)ZP_PARAM::get(ZP_PARAM_ID::CAN_D1_UC_ESC_BM);
+    uint16_t canServoMask = (uint16_t)ZP_PARAM::get(ZP_PARAM_ID::CAN_D1_UC_SRV_BM);
+    actuatorCommandHandle = new LatestValueSlot<ActuatorCommand_t>();
+    escStatusHandle = new EscStatusTable();
+    canOutputGroupHandle = new DroneCANOutputGroup(actuatorCommandHandle, escStatusHandle, systemUtilsHandle,
+        (uint8_t)ZP_PARAM::get(ZP_PARAM_ID::SERVO_BLH_POLES) / 2, &busCommandsReady);
     for (int i = 0; i < 8; i++) {
         bool isBLDC = false;
     #ifdef PLANE
         isBLDC = int(ZP_PARAM::get(SERVO_FUNC[i])) == int(MotorFunction_e::THROTTLE);
     #endif
     #ifdef QUADCOPTER
-        isBLDC = int(ZP_PARAM::get(SERVO_FUNC[i])) == int(MotorFunction_e::MOTOR_1)
-                        || int(ZP_PARAM::get(SERVO_FUNC[i])) == int(MotorFunction_e::MOTOR_2)
-                        || int(ZP_PARAM::get(SERVO_FUNC[i])) == int(MotorFunction_e::MOTOR_3)
-                        || int(ZP_PARAM::get(SERVO_FUNC[i])) == int(MotorFunction_e::MOTOR_4);
+        isBLDC = int(ZP_PARAM::get(SERVO_FUNC[i])) >= int(MotorFunction_e::MOTOR_1)
+                        && int(ZP_PARAM::get(SERVO_FUNC[i])) <= int(MotorFunction_e::MOTOR_8);
     #endif
-        if (isBLDC) {
+        // Outputs in the DroneCAN masks skip the timer pin, a disabled servo output stays off the bus
+        bool isCanServo = ((canServoMask >> i) & 1) && int(ZP_PARAM::get(SERVO_FUNC[i])) > int(MotorFunction_e::DISABLED);
+        if (isBLDC && ((canEscMask >> i) & 1)) {
+            motorHandles[i] = new DroneCANMotorControl(canOutputGroupHandle, DroneCANOutputType_e::ESC, i);
+        } else if (!isBLDC && isCanServo) {
+            motorHandles[i] = new DroneCANMotorControl(canOutputGroupHandle, DroneCANOutputType_e::SERVO, i + 1);
+        } else if (isBLDC) {
             switch (servoType) {
-                case MOT_TYPE_DSHOT: // DShot
-                    motorHandles[i] = new DshotMotorControl(MOTOR_MAP[i].timer, MOTOR_MAP[i].channel, false);
+                case MOT_TYPE_DSHOT150:
+                case MOT_TYPE_DSHOT300:
+                case MOT_TYPE_DSHOT600:
+                case MOT_TYPE_DSHOT1200: // DShot
+                    if (MOTOR_MAP[i].timer == &htim3) {
+                        // TIM3 outputs share one burst on the channel 1 DMA
+                        if (dshotGroupHandle == nullptr) {
+                            dshotGroupHandle = new DshotBurstGroup(&htim3, TIM_DMA_CC1, DSHOT_RATE_KBPS[servoType - MOT_TYPE_DSHOT150]);
+                        }
+                        motorHandles[i] = new DshotMotorControl(dshotGroupHandle, MOTOR_MAP[i].channel);
+                    } else {
+                        motorHandles[i] = new DshotMotorControl(MOTOR_MAP[i].timer, MOTOR_MAP[i].channel, false, DSHOT_RATE_KBPS[servoType - MOT_TYPE_DSHOT150]);
+                    }
                     break;
                 case MOT_TYPE_PWM: // PWM
                 default:
@@ -109,24 +157,44 @@ void initDrivers()
     }
 
 
-    canControllerHandle = new CANController(&hfdcan1, systemUtilsHandle);
+    canBusHandle = new FDCANBus(&hfdcan1);
+    canBusStatsHandle = new LatestValueSlot<CANBusStats_t>();
+    canGpsHandle = new DroneCANGPS();
+    canBarometerHandle = new DroneCANBarometer();
+    canMagnetometerHandle = new DroneCANMagnetometer();
+    canAirspeedHandle = new DroneCANAirspeed();
+    canControllerHandle = new CANController(canBusHandle, systemUtilsHandle, canBusStatsHandle, actuatorCommandHandle, escStatusHandle,
+        canGpsHandle, canBarometerHandle, canMagnetometerHandle, canAirspeedHandle);
+    canBusHandle->init();
+    #if CANARD_ENABLE_CANFD
+        // Every node on an FD bus must be FD capable, our transfers go out as FD once the peripheral is
+        canControllerHandle->setFdTransmit(canBusHandle->isFdEnabled());
+    #endif
 
     // Peripherals
-    gpsHandle = new GPS(&huart2);
-    rcHandle = new CRSFReceiver(&huart4);
+    gpsHandle = new GPS(&huart2, (uint16_t)ZP_PARAM::get(ZP_PARAM_ID::GPS_RATE_MS));
+    rcFastPathHandle = new LatestValueSlot<RCChannelFrame_t>();
+    rcNavTelemetryHandle = new LatestValueSlot<RCNavTelemetry_t>();
+    rcHandle = new CRSFReceiver(&huart4, rcFastPathHandle, rcNavTelemetryHandle);
     telemLinkHandle = new RFD(&huart3);
-    imuHandle = new IMU(&hspi2, GPIOF, GPIO_PIN_12, 0, IMU_ODR_1KHZ);
+    imuHandle = new IMU(&hspi2, GPIOF, GPIO_PIN_12, 0, IMU::odrFromHz(ZP_PARAM::get(ZP_PARAM_ID::INS_GYRO_RATE)));
     pmHandle = new PowerModule(&hi2c1);
     if (ZP_PARAM::get(ZP_PARAM_ID::RNGFND_ENABLE) == 1) {
         rangefinderHandle = new Rangefinder(&hi2c3);
     }
     barometerHandle = new Barometer(&hi2c2);
 
+    // The AM navigates from either the onboard drivers or the DroneCAN sensors
+    amGpsHandle = (int(ZP_PARAM::get(ZP_PARAM_ID::GPS_TYPE)) == GPS_TYPE_DRONECAN) ? static_cast<IGPS *>(canGpsHandle) : gpsHandle;
+    amBarometerHandle = (int(ZP_PARAM::get(ZP_PARAM_ID::BARO_PRIMARY)) == BARO_PRIMARY_DRONECAN) ? static_cast<IBarometer *>(canBarometerHandle) : barometerHandle;
+
     // Queues
     amRCQueueHandle = new MessageQueue<RCMotorControlMessage_t>(&amQueueId);
     smLoggerQueueHandle = new MessageQueue<char[100]>(&smLoggerQueueId);
+    sysIdLogQueueHandle = new MessageQueue<SysIdLogBlock_t>(&sysIdLogQueueId);
     tmQueueHandle = new MessageQueue<TMMessage_t>(&tmQueueId);
     messageBufferHandle = new MessageQueue<mavlink_message_t>(&messageBufferId);
+    batteryVoltageHandle = new LatestValueSlot<BatteryVoltage_t>();
 
     // Initialize hardware components
     for (int i = 0; i < 8; i++) {
@@ -18,15 +18,20 @@ void initManagers()
     amHandle = new (&amHandleStorage) AttitudeManager(
         systemUtilsHandle,
         mathUtilsHandle,
-        gpsHandle,
+        amGpsHandle,
         imuHandle,
         fftHandle,
         rangefinderHandle,
-        barometerHandle,
+        amBarometerHandle,
         amRCQueueHandle, 
         tmQueueHandle, 
         smLoggerQueueHandle, 
-        &mainMotorGroup
+        &mainMotorGroup,
+        rcFastPathHandle,
+        rcNavTelemetryHandle,
+        batteryVoltageHandle,
+        sysIdFftHandle,
+        sysIdLogQueueHandle
     );
 
     // SM initialization
@@ -39,7 +44,10 @@ void initManagers()
         pmHandle,
         amRCQueueHandle,
         tmQueueHandle,
-        smLoggerQueueHandle
+        smLoggerQueueHandle,
+        batteryVoltageHandle,
+        sysIdLogQueueHandle,
+        canBusStatsHandle
     );
 
     // TM initialization
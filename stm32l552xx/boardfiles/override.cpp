@@ -3,6 +3,7 @@
 #include "museq.hpp"
 #include "rfd.hpp"
 #include "drivers.hpp"
+#include "bus_threads.hpp"
 #include "utils.h"
 #include "imu.hpp"
 #include "user_diskio_spi.h"
@@ -43,8 +44,7 @@ void HAL_Delay(uint32_t Delay) {
 
 void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size) {
     if (huart == rcHandle->getHuart()) {
-        rcHandle->parse();
-        rcHandle->startDMA();
+        rcHandle->rxCallback(Size);
     } else if (huart == telemLinkHandle->getHuart()) {
       telemLinkHandle->receiveCallback(Size);
     }
@@ -93,7 +93,7 @@ void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
 	  if (error & HAL_UART_ERROR_ORE) {
 		__HAL_UART_CLEAR_OREFLAG(huart);
 	  }
-	  gpsHandle->rxCallback(0);
+	  gpsHandle->restartDMA();
   }
 }
 
@@ -138,24 +138,45 @@ void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
   }
 }
 
+void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim) {
+  if (dshotGroupHandle != nullptr && htim == dshotGroupHandle->getTimer()) {
+    dshotGroupHandle->transferCompleteCallback();
+  }
+}
+
 void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo0ITs) {
+  if (canControllerHandle == nullptr) return;
+
+  if ((RxFifo0ITs & FDCAN_IT_RX_FIFO0_MESSAGE_LOST) != RESET) {
+    canControllerHandle->noteRxFifoOverrun();
+  }
+
   if ((RxFifo0ITs & FDCAN_IT_RX_FIFO0_NEW_MESSAGE) != RESET) {
     FDCAN_RxHeaderTypeDef rxHeader;
-    uint8_t rxData[8];
+    uint8_t rxData[64];  // The HAL copies as many bytes as the DLC code allows an FD frame, even for classic frames
 
     uint32_t count = HAL_FDCAN_GetRxFifoFillLevel(hfdcan, FDCAN_RX_FIFO0);
-    while (count-- && HAL_FDCAN_GetRxMessage(hfdcan, FDCAN_RX_FIFO0, &rxHeader, rxData) == HAL_OK
-        && canControllerHandle) {
-      (void)canControllerHandle->enqueueRxFrame(rxHeader.Identifier, rxHeader.DataLength, rxData);
+    while (count-- && HAL_FDCAN_GetRxMessage(hfdcan, FDCAN_RX_FIFO0, &rxHeader, rxData) == HAL_OK) {
+      (void)canControllerHandle->enqueueRxFrame(rxHeader.Identifier, FDCANBus::dlcToLength(rxHeader.DataLength), rxData,
+        rxHeader.FDFormat == FDCAN_FD_CAN);
     }
+    busNotify(BUS_FLAG_RX);
   }
 }
 
+void HAL_FDCAN_TxBufferCompleteCallback(FDCAN_HandleTypeDef *hfdcan, uint32_t BufferIndexes) {
+  // A FIFO slot freed up, refill it from the libcanard queue
+  busNotify(BUS_FLAG_TX);
+}
+
 void HAL_FDCAN_ErrorStatusCallback(FDCAN_HandleTypeDef *hfdcan, uint32_t ErrorStatusITs) {
     FDCAN_ProtocolStatusTypeDef protocol_status;
     HAL_FDCAN_GetProtocolStatus(hfdcan, &protocol_status);
 
     if (protocol_status.BusOff != 0) {
+        if (canControllerHandle != nullptr) {
+            canControllerHandle->noteBusOff();
+        }
         CLEAR_BIT(hfdcan->Instance->CCCR, FDCAN_CCCR_INIT); // Clear INIT bit to recover from Bus-Off
     }
 }
@@ -19,6 +19,7 @@ void initSemphrs();
 /* declare queues begin */
 extern osMessageQueueId_t amQueueId;
 extern osMessageQueueId_t smLoggerQueueId;
+extern osMessageQueueId_t sysIdLogQueueId;
 extern osMessageQueueId_t tmQueueId;
 extern osMessageQueueId_t messageBufferId;
 /* declare queues end */
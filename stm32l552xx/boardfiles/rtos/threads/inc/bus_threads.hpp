@@ -3,8 +3,20 @@
 #include "cmsis_os2.h"
 #include <cstdint>
 
-static constexpr uint16_t BUS_UPDATE_LOOP_DELAY_MS = 50; // 20 Hz
+// Thread flags the CAN ISRs and the DroneCAN outputs raise to wake the bus task
+static constexpr uint32_t BUS_FLAG_RX = 0x1U;
+static constexpr uint32_t BUS_FLAG_TX = 0x2U;
+static constexpr uint32_t BUS_FLAG_CMD = 0x4U;
+
+// Longest the bus task sleeps without a CAN event, runs the 1 Hz node tasks on a quiet bus
+static constexpr uint16_t BUS_IDLE_WAKE_MS = 10;
 
 extern osThreadId_t busMainHandle;
 
 void busInitThreads();
+
+// ISR safe
+void busNotify(uint32_t flags);
+
+// DroneCANOutputGroup hook, the AM task published a new actuator command set
+void busCommandsReady();
@@ -16,7 +16,7 @@ void amMainLoopWrapper(void *arg)
   while(true)
   {
     amHandle->amUpdate();
-    nextWakeUp += timeToTicks(AM_UPDATE_LOOP_DELAY_MS);
+    nextWakeUp += timeToTicks(amHandle->getUpdateLoopDelayMs());
     osDelayUntil(nextWakeUp);
   }
 }
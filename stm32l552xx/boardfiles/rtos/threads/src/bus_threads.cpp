@@ -9,29 +9,41 @@ osThreadId_t busMainHandle = nullptr;
 static StaticTask_t busMainControlBlock;
 static StackType_t busMainStack[1024 / sizeof(StackType_t)];
 
+// Above the managers so frames are drained well inside CAN_BUS_MAX_SERVICE_LATENCY_MS, each wake is short
 static const osThreadAttr_t busMainLoopAttr = {
     .name = "busMain",
     .cb_mem = &busMainControlBlock,
     .cb_size = sizeof(busMainControlBlock),
     .stack_mem = busMainStack,
     .stack_size = sizeof(busMainStack),
-    .priority = (osPriority_t) osPriorityNormal
+    .priority = (osPriority_t) osPriorityAboveNormal
 };
 
 void busMainLoopWrapper(void *arg)
 {
-  uint32_t nextWakeUp = osKernelGetTickCount();
   while(true)
   {
+    // Woken by RX and TX complete interrupts and new actuator commands, times out on a quiet bus
+    (void)osThreadFlagsWait(BUS_FLAG_RX | BUS_FLAG_TX | BUS_FLAG_CMD, osFlagsWaitAny, timeToTicks(BUS_IDLE_WAKE_MS));
+
     if (canControllerHandle) {
       canControllerHandle->routineTasks();
     }
+  }
+}
 
-    nextWakeUp += timeToTicks(BUS_UPDATE_LOOP_DELAY_MS);
-    osDelayUntil(nextWakeUp);
+void busNotify(uint32_t flags)
+{
+  if (busMainHandle != nullptr) {
+    (void)osThreadFlagsSet(busMainHandle, flags);
   }
 }
 
+void busCommandsReady()
+{
+  busNotify(BUS_FLAG_CMD);
+}
+
 void busInitThreads()
 {
     busMainHandle = osThreadNew(busMainLoopWrapper, NULL, &busMainLoopAttr);
@@ -3,13 +3,21 @@ set(AM_SRC
     "src/attitude_manager/acro_mapping.cpp"
     "src/attitude_manager/attitude_manager.cpp"
     "src/attitude_manager/am_param_setup.cpp"
+    "src/attitude_manager/autotune_mapping.cpp"
+    "src/attitude_manager/chirp_generator.cpp"
     "src/attitude_manager/direct_mapping.cpp"
     "src/attitude_manager/fbwa_mapping.cpp"
     "src/attitude_manager/fft_harmonic_notch.cpp"
+    "src/attitude_manager/frequency_response.cpp"
+    "src/attitude_manager/imu_decimator.cpp"
+    "src/attitude_manager/imu_time_sync.cpp"
     "src/attitude_manager/pid.cpp"
+    "src/attitude_manager/pid3.cpp"
     "src/attitude_manager/MahonyAHRS.cpp"
     "src/attitude_manager/motor_mixing.cpp"
     "src/attitude_manager/stabilize_mapping.cpp"
+    "src/attitude_manager/sysid_mapping.cpp"
+    "src/attitude_manager/thrust_curve.cpp"
     "src/attitude_manager/ahrs_ekf.cpp"
 )
 set(AM_INC
@@ -44,9 +52,49 @@ set(ZP_PARAM_INC
     "include/zp_param/"
 )
 
+# Driver utility files (platform independent helpers shared by board and SITL drivers)
+set(DRIVER_UTILS_SRC
+    "src/driver_utils/blended_gps.cpp"
+    "src/driver_utils/can_controller.cpp"
+    "src/driver_utils/can_node.cpp"
+    "src/driver_utils/crsf_stream_parser.cpp"
+    "src/driver_utils/crsf_telemetry.cpp"
+    "src/driver_utils/dma_rx_ring.cpp"
+    "src/driver_utils/dronecan_outputs.cpp"
+    "src/driver_utils/dronecan_sensors.cpp"
+    "src/driver_utils/dshot_codec.cpp"
+    "src/driver_utils/gps_stream_parser.cpp"
+)
+set(DRIVER_UTILS_INC
+    "include/driver_utils/"
+)
+
+# Host DSP backend for SITL, log replay and tests, standing in for CMSIS-DSP (not built for the boards)
+set(HOST_DSP_SRC
+    "src/driver_utils/host_fft.cpp"
+    "src/driver_utils/host_mathutils.cpp"
+)
+
 # External library files (does not apply compiler warnings)
 set(EXTERNAL_INC
     "../external/c_library_v2/all/"
+    "../external/dronecan/libcanard/"
+    "../external/dronecan/generated/include/"
+)
+
+# DroneCAN sources for host builds, the board projects compile these themselves
+set(DRONECAN_SRC
+    "../external/dronecan/libcanard/canard.c"
+    "../external/dronecan/generated/src/uavcan.protocol.NodeStatus.c"
+    "../external/dronecan/generated/src/uavcan.protocol.dynamic_node_id.Allocation.c"
+    "../external/dronecan/generated/src/uavcan.equipment.esc.RawCommand.c"
+    "../external/dronecan/generated/src/uavcan.equipment.esc.Status.c"
+    "../external/dronecan/generated/src/uavcan.equipment.actuator.ArrayCommand.c"
+    "../external/dronecan/generated/src/uavcan.equipment.gnss.Fix2.c"
+    "../external/dronecan/generated/src/uavcan.equipment.air_data.StaticPressure.c"
+    "../external/dronecan/generated/src/uavcan.equipment.air_data.StaticTemperature.c"
+    "../external/dronecan/generated/src/uavcan.equipment.air_data.RawAirData.c"
+    "../external/dronecan/generated/src/uavcan.equipment.ahrs.MagneticFieldStrength2.c"
 )
 
 # Combined files
@@ -55,6 +103,7 @@ set(ZP_SRC
     ${SM_SRC}
     ${TM_SRC}
     ${ZP_PARAM_SRC}
+    ${DRIVER_UTILS_SRC}
 )
 set(ZP_INC
     "include/driver_ifaces/"
@@ -63,4 +112,5 @@ set(ZP_INC
     ${SM_INC}
     ${TM_INC}
     ${ZP_PARAM_INC}
+    ${DRIVER_UTILS_INC}
 )
@@ -2,7 +2,7 @@
 
 #include <cstdint>
 #include "flightmode.hpp"
-#include "pid.hpp"
+#include "pid3.hpp"
 
 class AcroMapping : public Flightmode{
     public: 
@@ -33,19 +33,15 @@ class AcroMapping : public Flightmode{
         // Resetter for all roll, pitch and yaw PIDs (needed for unit testing)
         void resetControlLoopState() noexcept;
 
-        // Getter for PID objects
-        PID *getRollPID() noexcept;
-        PID *getPitchPID() noexcept;
-        PID *getYawPID() noexcept;
+        // Getter for the roll, pitch and yaw rate PID
+        PID3 *getRatePID() noexcept;
 
         // Destructor
         ~AcroMapping() noexcept override = default;
 
     private: 
-         // Roll, pitch and yaw PID class objects
-        PID rollPID;
-        PID pitchPID;
-        PID yawPID;
+        // Roll, pitch and yaw rate PID, updated together
+        PID3 ratePID;
 
         // Values for roll, pitch and yaw limits
         float rollLimitRate;
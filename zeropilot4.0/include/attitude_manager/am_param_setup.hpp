@@ -52,6 +52,15 @@ class AMParamSetup : public IParamSetup {
     static bool updateRatePIDYawIMax(AttitudeManager* ctx, float val);
     static bool updateRollPitchLimitRate(AttitudeManager* ctx, float val);
     static bool updateYawLimitRate(AttitudeManager* ctx, float val);
+    static bool updateRatePIDRollFF(AttitudeManager* ctx, float val);
+    static bool updateRatePIDRollFltD(AttitudeManager* ctx, float val);
+    static bool updateRatePIDPitchFF(AttitudeManager* ctx, float val);
+    static bool updateRatePIDPitchFltD(AttitudeManager* ctx, float val);
+    static bool updateRatePIDYawFF(AttitudeManager* ctx, float val);
+    static bool updateRatePIDYawFltD(AttitudeManager* ctx, float val);
+    static bool updateRatePIDSetpointWeightP(AttitudeManager* ctx, float val);
+    static bool updateRatePIDSetpointWeightD(AttitudeManager* ctx, float val);
+    static bool updateRatePIDAntiWindup(AttitudeManager* ctx, float val);
 
     static bool updateAngPIDRollKp(AttitudeManager* ctx, float val);
     static bool updateAngPIDRollKi(AttitudeManager* ctx, float val);
@@ -67,6 +76,13 @@ class AMParamSetup : public IParamSetup {
     static bool updateMotSpinMin(AttitudeManager* ctx, float val);
     static bool updateMotSpinMax(AttitudeManager* ctx, float val);
     static bool updateMotSpinArm(AttitudeManager* ctx, float val);
+    static bool updateFrameClass(AttitudeManager* ctx, float val);
+    static bool updateFrameType(AttitudeManager* ctx, float val);
+    static bool updateMotThstExpo(AttitudeManager* ctx, float val);
+    static bool updateMotBatVoltMax(AttitudeManager* ctx, float val);
+    static bool updateMotBatVoltMin(AttitudeManager* ctx, float val);
+    static bool updateAutotuneAxes(AttitudeManager* ctx, float val);
+    static bool updateAutotuneTc(AttitudeManager* ctx, float val);
     #endif
 
     // FFT Harmonic Notch Filter param callbacks
@@ -76,6 +92,25 @@ class AMParamSetup : public IParamSetup {
     static bool updateHarmonicNotchBandwidthHz(AttitudeManager* ctx, float val);
     static bool updateHarmonicNotchAttenuationDB(AttitudeManager* ctx, float val);
     static bool updateHarmonicNotchHarmonicsMask(AttitudeManager* ctx, float val);
+    static bool updateHarmonicNotchMode(AttitudeManager* ctx, float val);
+    static bool updateMotorPoles(AttitudeManager* ctx, float val);
+
+    // IMU sampling and scheduling param callbacks
+    static bool updateSchedulingRate(AttitudeManager* ctx, float val);
+    static bool updateImuGyroRate(AttitudeManager* ctx, float val);
+    static bool updateImuDecimationType(AttitudeManager* ctx, float val);
+
+    // GPS param callbacks
+    static bool updateGpsRate(AttitudeManager* ctx, float val);
+
+    // SYSID param callbacks
+    static bool updateSysIdAxis(AttitudeManager* ctx, float val);
+    static bool updateSysIdMagnitude(AttitudeManager* ctx, float val);
+    static bool updateSysIdFStartHz(AttitudeManager* ctx, float val);
+    static bool updateSysIdFStopHz(AttitudeManager* ctx, float val);
+    static bool updateSysIdTRec(AttitudeManager* ctx, float val);
+    static bool updateSysIdTFadeIn(AttitudeManager* ctx, float val);
+    static bool updateSysIdTFadeOut(AttitudeManager* ctx, float val);
 
     // Servo param callback helpers
     static bool setServoTrim(AttitudeManager* ctx, uint8_t ch, float val);
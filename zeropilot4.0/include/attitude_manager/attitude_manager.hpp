@@ -14,13 +14,22 @@
 #include "am_param_setup.hpp"
 #include "acro_mapping.hpp"
 #include "stabilize_mapping.hpp"
+#include "autotune_mapping.hpp"
+#include "sysid_mapping.hpp"
 #include "motor_mixing.hpp"
 #include "fft_harmonic_notch.hpp"
 #include "rangefinder_iface.hpp"
 #include "barometer_iface.hpp"
 #include "MahonyAHRS.hpp"
-
-#define AM_SCHEDULING_RATE_HZ 1000
+#include "imu_decimator.hpp"
+#include "rc_datatypes.hpp"
+#include "latest_value_slot.hpp"
+#include "battery_voltage.hpp"
+#include "thrust_curve.hpp"
+#include "sysid_log.hpp"
+#include "zp_params.hpp"
+
+#define AM_DEFAULT_SCHEDULING_RATE_HZ 1000 // Used when SCHED_LOOP_RATE is invalid
 #define AM_TELEMETRY_GPS_DATA_RATE_HZ 5
 #define AM_TELEMETRY_SCALED_PRESSURE_DATA_RATE_HZ 5
 #define AM_TELEMETRY_RAW_IMU_DATA_RATE_HZ 10
@@ -28,11 +37,6 @@
 #define AM_TELEMETRY_SERVO_OUTPUT_RAW_RATE_HZ 2
 #define AM_TELEMETRY_DISTANCE_SENSOR_DATA_RATE_HZ 2
 
-#define AM_UPDATE_LOOP_DELAY_MS (1000 / AM_SCHEDULING_RATE_HZ)
-#define AM_CONTROL_LOOP_PERIOD_S (static_cast<float>(AM_UPDATE_LOOP_DELAY_MS) / 1000.0f)
-
-static_assert(AM_CONTROL_LOOP_PERIOD_S != 0.0f, "AM_CONTROL_LOOP_PERIOD_S must be nonzero.");
-
 class AttitudeManager
 {
     friend class AMParamSetup;
@@ -49,18 +53,45 @@ public:
         IMessageQueue<RCMotorControlMessage_t> *amQueue,
         IMessageQueue<TMMessage_t> *tmQueue,
         IMessageQueue<char[100]> *smLoggerQueue,
-        MotorGroupInstance_t *mainMotorGroup
+        MotorGroupInstance_t *mainMotorGroup,
+        const LatestValueSlot<RCChannelFrame_t> *rcFastPath = nullptr,
+        LatestValueSlot<RCNavTelemetry_t> *rcNavTelemetry = nullptr,
+        const LatestValueSlot<BatteryVoltage_t> *batteryVoltage = nullptr,
+        IFFT *sysIdFftDriver = nullptr,
+        IMessageQueue<SysIdLogBlock_t> *sysIdLogQueue = nullptr,
+        ParamRegistry *params = nullptr // Falls back to the firmware registry
     );
 
     void amUpdate();
 
+    // Control loop rate from SCHED_LOOP_RATE, read once at boot
+    static uint16_t getConfiguredSchedulingRateHz(const ParamRegistry &params);
+    static bool isValidSchedulingRateHz(int rateHz);
+
+    uint16_t getSchedulingRateHz() const { return amSchedulingRateHz; }
+    uint32_t getUpdateLoopDelayMs() const { return 1000 / amSchedulingRateHz; }
+
+    #ifdef QUADCOPTER
+    const AutotuneMapping &getAutotune() const { return autotuneCLAW; }
+    #endif
+    const SysIdMapping &getSysId() const { return sysidCLAW; }
+
 private:
+    static constexpr uint16_t MIN_SCHEDULING_RATE_HZ = 50;
+    static constexpr uint16_t RTOS_TICK_RATE_HZ = 1000;
+
+    ParamRegistry *params; // This vehicle's parameters
+
+    const uint16_t amSchedulingRateHz;
+    const float controlLoopPeriodS;
+
     static constexpr uint8_t NUM_MOTORS = 8;
 
     ISystemUtils *systemUtilsDriver;
 
     IGPS *gpsDriver;
     GpsData_t lastValidGps = {};
+    bool haveGpsFix = false;
     bool gpsUnsent = false;
     IIMU *imuDriver;
     IRangefinder *rangefinderDriver;
@@ -69,21 +100,42 @@ private:
 
     FFTHarmonicNotch harmonicNotchFilter;
     FFTHarmonicNotchConfig harmonicNotchConfig;
+    uint8_t motorPolePairs; // eRPM to mechanical RPM for the ESC_RPM notch
+    ImuDecimator imuDecimator;
+    ImuDecimatorConfig imuDecimatorConfig;
     // AHRSEKF ekf;
     Mahony mahonyFilter;
 
     IMessageQueue<RCMotorControlMessage_t> *amQueue;
     IMessageQueue<TMMessage_t> *tmQueue;
     IMessageQueue<char[100]> *smLoggerQueue;
+    IMessageQueue<SysIdLogBlock_t> *sysIdLogQueue;
+
+    // Stick channels straight from the receiver, SM still owns arming, mode and failsafe through amQueue
+    const LatestValueSlot<RCChannelFrame_t> *rcFastPath;
+    RCChannelFrame_t rcFastFrame;
+    uint32_t rcFastSeq;
+    uint32_t rcFastAgeMs;
+    bool haveRcFastFrame;
+
+    // Attitude and position for the receiver telemetry downlink
+    LatestValueSlot<RCNavTelemetry_t> *rcNavTelemetry;
+
+    // Filtered bus voltage from SM for the multirotor output stage
+    const LatestValueSlot<BatteryVoltage_t> *batteryVoltage;
+    uint32_t batteryVoltageSeq;
 
     Flightmode *activeCLAW; // Pointer to current active Control Law
     #ifdef PLANE
     DirectMapping manualCLAW; // Manual Control Law (Direct Passthrough)
     FBWAMapping fbwaCLAW;     // Fly-By-Wire A Control Law (Roll and Pitch PID + Yaw Rudder Mixing)
+    SysIdMapping sysidCLAW;   // System Identification Control Law (FBWA + chirp injection)
     #endif
     #ifdef QUADCOPTER
     AcroMapping acroCLAW;           // Acro Control Law (Roll, Pitch and Yaw PID)
     StabilizeMapping stabilizeCLAW; // Stabilize Control Law (Roll, Pitch and Yaw PID + Angle Limiting)
+    AutotuneMapping autotuneCLAW;   // Autotune Control Law (Stabilize + per axis twitches that retune the rate loop)
+    SysIdMapping sysidCLAW;         // System Identification Control Law (Stabilize + chirp injection)
     #endif
     RCMotorControlMessage_t controlMsg;
     FlightMode_e currentFlightMode;
@@ -104,16 +156,26 @@ private:
     float motSpinMin;
     float motSpinMax;
     float motSpinArm;
+    #ifdef QUADCOPTER
+    const MixerFrame_t *mixerFrame; // Flash resident table picked by FRAME_CLASS and FRAME_TYPE
+    ThrustCurve thrustCurve;        // MOT_THST_EXPO linearization and MOT_BAT_VOLT_* compensation
+    #endif
 
     static constexpr float MOT_GND_IDLE_THR = 0.02f;
     bool groundIdlePrev;
 
-    static constexpr uint16_t MAX_TIMESTAMP = 65535;
-    static constexpr float TIMESTAMP_RESOLUTION = 0.000001f; // Default IMU timestamp resolution 1us
-    uint32_t lastTimestamp;
+    static constexpr float US_TO_S = 0.000001f;
+    static constexpr uint64_t IMU_MAX_DT_US = 100000; // Larger gaps restart attitude integration instead of taking one huge step
+    static constexpr float ODR_UPDATE_THRESHOLD = 0.002f; // Relative ODR change that retunes the harmonic notch
+    uint64_t lastTimestampUs;
     bool haveLastImuTimestamp;
 
+    void updateNotchSampleRate();
+    void updateNotchFromMotorRpm();
+    static bool isThrottleMotor(MotorFunction_e function);
+
     bool getControlInputs(RCMotorControlMessage_t *pControlMsg);
+    void applyFastPathSticks(RCMotorControlMessage_t *pControlMsg);
 
     void outputToMotors(RCMotorControlMessage_t outputControlMsg, bool groundIdle);
 
@@ -123,6 +185,11 @@ private:
     void sendPressureDataToTelemetryManager(const BaroData_t &baroData);
     void sendRangefinderDataToTelemetryManager(const RangefinderData_t &rangefinderData);
     void sendServoOutputRawToTelemetryManager();
+    void publishNavTelemetry(const Attitude_t &attitude);
+    #ifdef QUADCOPTER
+    void logAutotuneResults();
+    #endif
+    void logSysIdData();
 
     uint8_t profilerId;
 
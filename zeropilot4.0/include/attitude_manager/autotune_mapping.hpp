@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include "flightmode.hpp"
+#include "stabilize_mapping.hpp"
+#include "zp_params.hpp"
+
+#ifdef QUADCOPTER
+enum class AutotuneAxisStatus_e : uint8_t {
+    PENDING = 0,    // Waiting for the axes before it
+    TUNING = 1,
+    CONVERGED = 2,  // Gains committed to the ATC_RAT_* and ATC_ANG_* params
+    FAILED = 3,     // Estimates never settled or a param was rejected, gains left alone
+    SKIPPED = 4     // Masked out by AUTOTUNE_AXES
+};
+
+typedef struct {
+    AutotuneAxisStatus_e status;
+    uint8_t twitches;   // Twitches attempted on this axis
+    float elapsedS;     // Time from the first twitch on this axis until it converged or failed
+    float plantGain;    // Angular acceleration per unit of rate loop effort (rad/s^2)
+    float delayS;       // Apparent dead time from effort to measured rate
+    float kp, ki, kd;   // Rate gains committed on convergence
+    float angleKp;      // Angle P committed on convergence, 0 for yaw
+} AutotuneAxisResult_t;
+
+/*
+ * AUTOTUNE flies like STABILIZE and, while the sticks are centred, twitches one axis at a time
+ * with an open loop rate effort step. Each twitch fits an integrator plus dead time model
+ * (rate' = K * effort delayed by L) to the gyro response. Once K and L settle, rate gains come
+ * from the SIMC rules for that model and are committed through the vehicle's ParamRegistry, bounded
+ * to MAX_GAIN_RATIO either side of the gains the mode was entered with and always kept inside the
+ * ArduPilot range of each param. A gain entered at 0 can move anywhere in its range.
+ */
+class AutotuneMapping : public Flightmode {
+    public:
+        // Gains are read from and committed to paramRegistry, the firmware registry when null
+        AutotuneMapping(float control_iter_period_s, StabilizeMapping &stabilize, ParamRegistry *paramRegistry = nullptr) noexcept;
+
+        // Restarts tuning from the first selected axis with the current params as the baseline
+        void activateFlightMode() override;
+
+        RCMotorControlMessage_t runControl(RCMotorControlMessage_t controlInput, const DroneState_t &droneState) override;
+
+        // Bit 0 roll, bit 1 pitch, bit 2 yaw, applied on the next activation
+        bool setAxesMask(uint8_t newAxesMask) noexcept;
+
+        // Closed loop rate time constant as a multiple of the measured delay, lower is more aggressive
+        bool setTimeConstantRatio(float newRatio) noexcept;
+
+        const AutotuneAxisResult_t &getAxisResult(PIDAxis_e axis) const noexcept;
+
+        // True once every selected axis has converged or failed
+        bool isComplete() const noexcept;
+
+        // Hands out each axis that converged or failed since the last call, once
+        bool takeFinishedAxis(PIDAxis_e &finishedAxis) noexcept;
+
+        ~AutotuneMapping() noexcept override = default;
+
+    private:
+        enum class Phase_e : uint8_t {
+            SETTLE,     // Stabilize holds level until the vehicle is quiet
+            TWITCH,     // Open loop effort step on the axis under test
+            DONE
+        };
+
+        static constexpr float STICK_DEADBAND = 10.0f;          // Stick travel from centre that hands control back to the pilot
+        static constexpr float SETTLE_TIME_S = 0.5f;
+        static constexpr float SETTLE_RATE_RAD_S = 0.2f;        // Every axis must be quieter than this to start a twitch
+        static constexpr float TWITCH_EFFORT = 0.25f;           // Rate loop effort, [-1, 1] scale
+        static constexpr float TWITCH_RATE_RP_RAD_S = 1.5708f;  // 90 deg/s ends a roll or pitch twitch
+        static constexpr float TWITCH_RATE_YAW_RAD_S = 0.7854f; // 45 deg/s ends a yaw twitch
+        static constexpr float TWITCH_ANGLE_LIMIT_RAD = 0.3491f; // 20 deg excursion ends a roll or pitch twitch
+        static constexpr float TWITCH_MAX_S = 0.3f;
+        static constexpr uint16_t MAX_TWITCH_SAMPLES = 512;
+        static constexpr float MIN_RESPONSE_RATIO = 0.25f;      // Of the target rate, weaker twitches are discarded
+        static constexpr float FIT_START_RATIO = 0.4f;          // Fit the ramp above this fraction of the peak, past the motor lag
+        static constexpr float ESTIMATE_FILTER = 0.3f;          // Weight of each new twitch in the running estimate
+        static constexpr float CONVERGE_TOLERANCE = 0.15f;      // Relative spread of consecutive estimates counted as settled
+        static constexpr uint8_t CONVERGE_COUNT = 3;
+        static constexpr uint8_t MIN_TWITCHES = 4;
+        static constexpr uint8_t MAX_TWITCHES = 20;
+        static constexpr float MAX_GAIN_RATIO = 4.0f;
+        static constexpr float ANGLE_TO_RATE_TC_RATIO = 2.5f;   // Angle loop time constant over rate loop time constant
+        static constexpr float ANGLE_P_MIN = 3.0f;              // ATC_ANG_*_P range in 1/s, divided by the acro rate limit
+        static constexpr float ANGLE_P_MAX = 12.0f;             // for this firmware's rate fraction output
+
+        typedef struct {
+            float min, max;
+        } GainRange_t;
+
+        // Params each axis commits to and their ranges, the angle loop only exists for roll and pitch
+        typedef struct {
+            ZP_PARAM_ID rateP, rateI, rateD;
+            ZP_PARAM_ID angleP;
+            bool hasAngleLoop;
+            GainRange_t ratePRange, rateIRange, rateDRange;
+        } AxisParams_t;
+        static const AxisParams_t AXIS_PARAMS[PID3_AXES];
+
+        const float controlPeriodS;
+        StabilizeMapping &stabilizeCLAW;
+        ParamRegistry *paramRegistry;
+
+        uint8_t axesMask;
+        uint8_t activeAxesMask;
+        float timeConstantRatio;
+
+        Phase_e phase;
+        uint8_t axis;
+        AutotuneAxisResult_t results[PID3_AXES];
+        uint8_t unreportedMask;
+
+        // Gains on entry, the centre of the safety bounds
+        float entryKp[PID3_AXES], entryKi[PID3_AXES], entryKd[PID3_AXES], entryAngleKp[PID3_AXES];
+
+        float settleTimeS;
+        float direction;
+        float twitchStartRate;
+        float twitchStartAngle;
+        uint16_t twitchSamples;
+        float twitchRate[MAX_TWITCH_SAMPLES];
+
+        bool haveEstimate;
+        uint8_t settledCount;
+        float estPlantGain;
+        float estDelayS;
+
+        static bool sticksCentred(const RCMotorControlMessage_t &controlInput) noexcept;
+        static float axisRate(const DroneState_t &droneState, uint8_t axisIdx) noexcept;
+        static float axisAngle(const DroneState_t &droneState, uint8_t axisIdx) noexcept;
+        static float clampToBounds(float value, float entry, GainRange_t range) noexcept;
+        bool commitParam(ZP_PARAM_ID id, float value) noexcept;
+
+        void startAxis(uint8_t first) noexcept;
+        void finishAxis(AutotuneAxisStatus_e status) noexcept;
+        bool fitTwitch(float &plantGain, float &delayS) const noexcept;
+        void updateEstimate(float plantGain, float delayS) noexcept;
+        bool commitGains() noexcept;
+};
+#endif
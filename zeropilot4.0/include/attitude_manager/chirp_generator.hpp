@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ * Log swept sine for system identification. Holds fStart while the amplitude fades in, sweeps
+ * exponentially up to fStop over the record time so every octave gets equal time, then holds fStop
+ * while the amplitude fades back out. The phase is integrated from the instantaneous frequency so
+ * the waveform stays continuous across the three segments.
+ */
+class ChirpGenerator {
+    public:
+        ChirpGenerator() noexcept;
+
+        // Rejects a sweep that doesn't go upwards from a positive frequency, keeps the old one
+        bool init(float fStartHz, float fStopHz, float recordS, float fadeInS, float fadeOutS) noexcept;
+
+        // Back to the start of the fade in
+        void reset() noexcept;
+
+        // Advances by dtS and returns the waveform in [-1, 1], 0 once complete
+        float update(float dtS) noexcept;
+
+        float getFrequencyHz() const noexcept;
+        float getElapsedS() const noexcept;
+        float getDurationS() const noexcept;
+        bool isComplete() const noexcept;
+
+    private:
+        float fStartHz;
+        float fStopHz;
+        float recordS;
+        float fadeInS;
+        float fadeOutS;
+        float logRatio;     // ln(fStop / fStart)
+
+        float elapsedS;
+        float phaseRad;
+        float frequencyHz;
+};
@@ -6,6 +6,12 @@
 
 #define FFT_NOTCH_MAX_HARMONICS 16
 
+// Values match ArduPilot INS_HNTCH_MODE
+enum class HarmonicNotchMode_e : uint8_t {
+    ESC_RPM = 3,    // One notch set per motor from bidirectional DShot eRPM
+    FFT = 4         // Track the dominant peak of the gyro spectrum
+};
+
 enum class GyroAxis_e {
     X,
     Y,
@@ -14,6 +20,7 @@ enum class GyroAxis_e {
 
 struct FFTHarmonicNotchConfig {
     bool enabled;           // Enable/disable the FFT harmonic notch filter
+    HarmonicNotchMode_e mode; // Source of the notch centre frequency
     uint16_t fftWindowSize; // FFT window size (must be a power of 2)
     float sampleFreqHz;     // IMU Sample Rate
     float minFreqHz;        // Minimum frequency to track
@@ -32,12 +39,19 @@ class FFTHarmonicNotch {
         // Push a raw sample into the FFT buffer. 
         // Returns true if the buffer filled and an FFT was calculated this cycle.
         bool pushSample(float gx, float gy, float gz);
+
+        // ESC_RPM mode: place a notch on every enabled harmonic of each motor, filled in harmonic
+        // order until the filters run out. Motors at 0 Hz (stopped or no telemetry) get no notch.
+        void updateFromMotorFreqs(const float *motorFreqHz, uint8_t motorCount);
         
         // Apply the filter cascade to all three gyro axes in-place
         void apply(float& gx, float& gy, float& gz);
         
         // Reset filter delay states
         void reset();
+
+        // Update the sample rate used for bin-to-Hz mapping and notch design, keeps the FFT buffer
+        bool setSampleFreqHz(float sampleFreqHz);
     
     private:
         static constexpr uint16_t FFT_MAX_WINDOW_SIZE = 1024;
@@ -47,6 +61,9 @@ class FFTHarmonicNotch {
         // Calculates coefficients based on the new peak frequency
         void updateFilters(float peakFreqHz);
 
+        // Retune one filter, disables it outside [minFreqHz, Nyquist)
+        void setFilterFreq(uint8_t index, float freqHz);
+
         struct BiquadState {
             float b0, b1, b2, a1, a2;
             float x1X = 0, x2X = 0, y1X = 0, y2X = 0;
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include "fft_iface.hpp"
+
+typedef struct {
+    float freqHz;
+    float gain;         // Output units per input unit
+    float phaseDeg;     // (-180, 180], negative is output lagging input
+    float coherence;    // [0, 1], how much of the output is linearly explained by the input
+} FrequencyResponsePoint_t;
+
+/*
+ * Running cross-spectral estimate of the response from an input signal to an output signal.
+ * Samples are collected into Hann windowed blocks with 50% overlap, each block goes through the
+ * FFT driver and is added to the input, output and cross power spectra (Welch's method), so the
+ * estimate H = Suy / Suu and its coherence sharpen as more of the excitation is averaged in.
+ */
+class FrequencyResponse {
+    public:
+        static constexpr uint16_t WINDOW_LEN = 256;
+        static constexpr uint16_t BIN_COUNT = WINDOW_LEN / 2;   // Bin 0 is DC and never reported
+
+        explicit FrequencyResponse(IFFT *fftDriver) noexcept;
+
+        // Sets the rate samples are pushed at and clears the spectra
+        bool init(float sampleRateHz) noexcept;
+
+        // Clears the spectra and the partially filled window
+        void reset() noexcept;
+
+        // Returns true when this sample completed a window and it was added to the spectra
+        bool pushSample(float input, float output) noexcept;
+
+        uint16_t getWindowCount() const noexcept;
+        float getBinFreqHz(uint16_t bin) const noexcept;
+
+        // False for DC, out of range bins, before the first window, or bins the input never excited
+        bool getPoint(uint16_t bin, FrequencyResponsePoint_t &point) const noexcept;
+
+    private:
+        IFFT *fftDriver;
+        bool initialized;
+        float sampleRateHz;
+
+        float inputBuf[WINDOW_LEN];
+        float outputBuf[WINDOW_LEN];
+        uint16_t fill;
+
+        // FFT scratch, the driver may use its input buffer as workspace
+        float window[WINDOW_LEN];
+        float fftInput[WINDOW_LEN];
+        float inputSpectrum[WINDOW_LEN];
+        float outputSpectrum[WINDOW_LEN];
+
+        uint16_t windowCount;
+        float inputPower[BIN_COUNT];
+        float outputPower[BIN_COUNT];
+        float crossRe[BIN_COUNT];
+        float crossIm[BIN_COUNT];
+
+        void transform(const float *samples, float *spectrum) noexcept;
+        void accumulateWindow() noexcept;
+};
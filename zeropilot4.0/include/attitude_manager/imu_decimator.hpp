@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include "imu_datatypes.hpp"
+
+enum class DecimationFilter_e : uint8_t {
+    NONE = 0,   // Plain downsampling, no anti-alias filter
+    FIR = 1,    // Polyphase windowed-sinc FIR
+    CIC = 2     // 3rd order cascaded integrator-comb
+};
+
+struct ImuDecimatorConfig {
+    DecimationFilter_e filter;
+    float inputRateHz;      // IMU ODR
+    float outputRateHz;     // Control loop rate
+};
+
+/*
+ * Decimates the fused IMU stream from the raw ODR to the control rate.
+ * Each IMU keeps its own filter state; all six axes are processed as one
+ * padded lane vector so the tap loops vectorize.
+ */
+class ImuDecimator {
+    public:
+        ImuDecimator() = default;
+
+        bool init(const ImuDecimatorConfig &decimatorConfig);
+
+        // Filter and decimate a time-ordered batch. Returns the input batch untouched when the factor is 1
+        ScaledImuBatch_t process(const ScaledImuBatch_t &in);
+
+        void reset();
+
+        uint8_t getFactor() const { return factor; }
+        float getOutputRateHz() const { return outputRateHz; }
+        float getGroupDelayS() const { return groupDelayS; }
+        uint32_t getOverflowCount() const { return overflowCount; }
+
+        static constexpr uint8_t MAX_FACTOR = 32;
+        static constexpr uint16_t FIR_MAX_TAPS = 64;
+        static constexpr uint8_t CIC_ORDER = 3;
+
+    private:
+        static constexpr uint8_t MAX_IMUS = 2;
+        static constexpr uint8_t LANES = 8;            // accel xyz, gyro xyz, 2 pad
+        static constexpr uint8_t FIR_TAPS_PER_PHASE = 8;
+        static constexpr float FIR_CUTOFF_RATIO = 0.8f; // Passband edge as a fraction of output Nyquist
+        static constexpr float CIC_SCALE = 65536.0f;   // Q16 fixed point for the integrators
+        static constexpr uint16_t MAX_OUTPUT = 128;
+
+        struct ImuState {
+            float history[2 * FIR_MAX_TAPS][LANES];    // Mirrored so the newest taps are always contiguous
+            uint16_t head;
+            uint64_t integrator[CIC_ORDER][LANES];     // Modular arithmetic, wraparound cancels in the combs
+            uint64_t combDelay[CIC_ORDER][LANES];
+            uint8_t phase;
+        };
+
+        ImuDecimatorConfig config = {DecimationFilter_e::NONE, 0.0f, 0.0f};
+        uint8_t factor = 1;
+        float outputRateHz = 0.0f;
+        float groupDelayS = 0.0f;
+        bool initialized = false;
+
+        float taps[FIR_MAX_TAPS] = {};
+        uint16_t numTaps = 0;
+        float cicGain = 1.0f;
+
+        ImuState state[MAX_IMUS] = {};
+        ScaledImu_t output[MAX_OUTPUT] = {};
+        uint32_t overflowCount = 0;
+
+        void designFir();
+        bool pushSample(ImuState &s, const float (&lane)[LANES], float (&out)[LANES]);
+        void runFir(const ImuState &s, float (&out)[LANES]) const;
+        void runCicComb(ImuState &s, float (&out)[LANES]);
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include "imu_datatypes.hpp"
+
+/*
+ * Maps 16-bit IMU hardware timestamps onto the 32-bit MCU (DWT) microsecond clock.
+ * The IMU oscillator drifts against the MCU clock, so the tick ratio and offset are
+ * tracked online with a second-order PLL that is fed once per FIFO batch.
+ * Output timestamps are 64-bit, monotonic and in MCU microseconds.
+ */
+class ImuTimeSync {
+    public:
+        // nominalTickUs: IMU timestamp resolution, nominalOdrHz: configured ODR
+        ImuTimeSync(float nominalTickUs, float nominalOdrHz) noexcept;
+
+        // Drop the clock model, next batch performs a hard sync. Output stays monotonic across resets
+        void reset() noexcept;
+
+        // Stamp every sample in the batch using its hardware ticks (data[i].timestamp)
+        // readTimeUs is the DWT time at which the FIFO (last sample) was read
+        void stampBatch(RawImu_t *data, uint16_t count, uint32_t readTimeUs) noexcept;
+
+        // Measured sample rate in MCU time, nominal ODR until the first batches arrive
+        float getMeasuredODRHz() const noexcept;
+
+        // MCU microseconds per IMU tick
+        float getTickRatio() const noexcept;
+
+        bool isLocked() const noexcept;
+
+    private:
+        static constexpr uint32_t HW_TICK_RANGE = 65536;        // 16-bit hardware timestamp
+        static constexpr float MAX_RATIO_DEVIATION = 0.05f;     // Oscillator tolerance clamp (+-5%)
+        static constexpr float PLL_KP = 0.1f;                   // Phase correction gain
+        static constexpr float PLL_KI = 0.01f;                  // Frequency correction gain
+        static constexpr float RESYNC_THRESHOLD_US = 5000.0f;   // Phase error that forces a hard sync
+        static constexpr float ODR_FILTER_ALPHA = 0.05f;
+        static constexpr uint8_t LOCK_BATCHES = 20;             // Batches inside threshold before reporting lock
+
+        const float nominalTickUs;
+        const float nominalOdrHz;
+
+        float ratio;                // MCU us per IMU tick
+        double offsetUs;            // MCU time of refTicks
+        int64_t refTicks;           // Unwrapped IMU ticks of the last sample seen
+        uint16_t lastHwTicks;
+
+        uint64_t lastReadUs;        // Unwrapped DWT time of the last read
+        uint32_t lastReadRawUs;
+        bool haveReadTime;
+
+        uint64_t lastEmittedUs;
+        float samplePeriodTicks;
+        uint8_t lockCount;
+        bool synced;
+
+        uint64_t unwrapReadTime(uint32_t readTimeUs) noexcept;
+        uint64_t ticksToUs(int64_t ticks) const noexcept;
+};
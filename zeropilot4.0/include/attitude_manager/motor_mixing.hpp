@@ -3,13 +3,60 @@
 #include "motor_datatype.hpp"
 #include <cmath>
 
+#ifdef QUADCOPTER
+static constexpr uint8_t MIXER_MAX_MOTORS = 8;
+
+// Values follow the ArduPilot FRAME_CLASS and FRAME_TYPE params
+enum class FrameClass_e : uint8_t {
+    QUAD = 1,
+    HEXA = 2,
+    OCTA = 3,
+    Y6 = 5
+};
+
+enum class FrameType_e : uint8_t {
+    PLUS = 0,
+    X = 1
+};
+
+// Per motor roll, pitch and yaw factors, MOTOR_n uses index n - 1. Lanes past motorCount are zero
+typedef struct {
+    uint8_t motorCount;
+    float roll[MIXER_MAX_MOTORS];
+    float pitch[MIXER_MAX_MOTORS];
+    float yaw[MIXER_MAX_MOTORS];
+} MixerFrame_t;
+#endif
+
 class MotorMixing{
     public:
         #ifdef PLANE
         static void fixedWingMoterMixer(const RCMotorControlMessage_t outputControlMsg, MotorGroupInstance_t *mainMotorGroup, float* motorPercent);
         #endif
         #ifdef QUADCOPTER
-        static void quadMotorMixer(const RCMotorControlMessage_t outputControlMsg, MotorGroupInstance_t *mainMotorGroup, float* motorPercent);
-        static void quadGroundIdle(MotorGroupInstance_t *mainMotorGroup, float* motorPercent, float motSpinArm);
+        /**
+         * @brief built in frame table
+         * @return nullptr if the class and type have no table, Y6 ignores the type
+         */
+        static const MixerFrame_t *frameFor(FrameClass_e frameClass, FrameType_e frameType);
+
+        /**
+         * @brief mixes roll, pitch, yaw in [-1, 1] and throttle in [0, 1] through any frame table,
+         * including custom ones, and places the result on the MOTOR_n outputs
+         */
+        static void multirotorMixer(const MixerFrame_t &frame, const RCMotorControlMessage_t outputControlMsg, MotorGroupInstance_t *mainMotorGroup, float* motorPercent);
+
+        /**
+         * @brief desaturating mix kernel, always runs all MIXER_MAX_MOTORS lanes
+         * @param mixed output per frame motor in [0, 1]
+         */
+        static void mixFrame(const MixerFrame_t &frame, float roll, float pitch, float yaw, float throttle, float *mixed);
+
+        static void multirotorGroundIdle(const MixerFrame_t &frame, MotorGroupInstance_t *mainMotorGroup, float* motorPercent, float motSpinArm);
+
+        /**
+         * @return frame index of a MOTOR_n function, -1 for anything else
+         */
+        static int8_t motorIndex(MotorFunction_e function);
         #endif
 };
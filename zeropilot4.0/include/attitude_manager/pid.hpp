@@ -31,7 +31,7 @@ class PID {
         // Gains
         float kp, ki, kd;      // PID constants
         float tau;             // Derivative low-pass filter constant
-        float t;               // Sample time (set to AM_CONTROL_LOOP_PERIOD_S)
+        float t;               // Sample time (set to the AM control loop period)
 
         // Output and Integral Limits
         float outputMinLim, outputMaxLim;       // Output limits
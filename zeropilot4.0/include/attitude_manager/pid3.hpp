@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+
+static constexpr uint8_t PID3_AXES = 3;
+
+enum class PIDAxis_e : uint8_t {
+    ROLL = 0,
+    PITCH = 1,
+    YAW = 2
+};
+
+enum class PIDAntiWindup_e : uint8_t {
+    CLAMP = 0,          // Integral clamped to the IMAX limits only, as PID does
+    CONDITIONAL = 1     // Also hold the integral while the output is saturated in the direction of the error
+};
+
+/*
+ * Roll, pitch and yaw rate PID updated in one pass over structure-of-arrays state.
+ * With default shaping (no feedforward, full setpoint weight on P, derivative on measurement,
+ * tau filtered D-term, clamp anti-windup) every axis matches PID::pidOutput.
+ * The D-term is smoothed by either the tau first order stage or, once setDtermLpfHz is set, a
+ * biquad low-pass, never both: the biquad zeroes dDecay so the first order stage becomes a plain
+ * backward difference. An optional notch follows. Disabled stages get pass-through coefficients so
+ * all axes share the same loop.
+ * Derived coefficients are only recomputed by the setters, never in update().
+ */
+class PID3 {
+    public:
+        PID3(float outputMinLim, float outputMaxLim, float t) noexcept;
+
+        // Reset integrator, derivative and filter state of all axes
+        void pidInitState() noexcept;
+
+        // Same meaning as PID::setConstants, for one axis
+        void setConstants(PIDAxis_e axis, float newKp, float newKi, float newKd, float newTau, uint8_t newIMaxPct) noexcept;
+
+        void setKp(PIDAxis_e axis, float newKp) noexcept;
+        void setKi(PIDAxis_e axis, float newKi) noexcept;
+        void setKd(PIDAxis_e axis, float newKd) noexcept;
+        void setTau(PIDAxis_e axis, float newTau) noexcept;
+        void setIntegralMaxPct(PIDAxis_e axis, uint8_t pct) noexcept;
+
+        // Output += kff * setpoint
+        void setFeedforward(PIDAxis_e axis, float newKff) noexcept;
+
+        // P acts on pWeight * setpoint - measurement, D on dWeight * setpoint - measurement
+        void setSetpointWeights(PIDAxis_e axis, float newPWeight, float newDWeight) noexcept;
+
+        // Second order Butterworth low-pass on the D-term in place of the tau filter, 0 Hz restores tau
+        bool setDtermLpfHz(PIDAxis_e axis, float cutoffHz) noexcept;
+
+        // Notch applied to the D-term of every axis, 0 Hz centre disables it. Unchanged values are ignored
+        bool setDtermNotch(float centerHz, float bandwidthHz, float attenuationDB) noexcept;
+
+        void setAntiWindup(PIDAntiWindup_e mode) noexcept;
+
+        // Computes all three axes, arrays are indexed by PIDAxis_e
+        void update(const float setpoint[PID3_AXES], const float measurement[PID3_AXES], float output[PID3_AXES]) noexcept;
+
+    private:
+        // Coefficients of one biquad per axis, b0 = 1 and the rest 0 passes the input through
+        struct BiquadCoeffs {
+            float b0[PID3_AXES], b1[PID3_AXES], b2[PID3_AXES], a1[PID3_AXES], a2[PID3_AXES];
+        };
+        struct BiquadDelay {
+            float x1[PID3_AXES], x2[PID3_AXES], y1[PID3_AXES], y2[PID3_AXES];
+        };
+
+        static constexpr float BUTTERWORTH_Q = 0.70710678f;
+        static constexpr float MAX_FILTER_NYQUIST_RATIO = 0.9f; // Highest usable cutoff as a fraction of Nyquist
+
+        const float t;  // Sample time (set to the AM control loop period)
+        const float outputMinLim, outputMaxLim;
+        PIDAntiWindup_e antiWindup;
+
+        // Parameters the D-term coefficients are derived from, per axis
+        float kd[PID3_AXES], tau[PID3_AXES];
+        float dLpfHz[PID3_AXES];
+        float notchCenterHz, notchBandwidthHz, notchAttenuationDB;
+
+        // Derived coefficients
+        float pGain[PID3_AXES];
+        float iGain[PID3_AXES];         // Trapezoidal, applied to error + previous error
+        float dGain[PID3_AXES];         // First order D stage input gain
+        float dDecay[PID3_AXES];        // First order D stage feedback, 0 with the biquad low-pass
+        float ffGain[PID3_AXES];
+        float pWeight[PID3_AXES];
+        float dWeight[PID3_AXES];
+        float integralMinLim[PID3_AXES], integralMaxLim[PID3_AXES];
+        BiquadCoeffs dLpf;
+        BiquadCoeffs dNotch;
+
+        // State
+        float integral[PID3_AXES];
+        float prevError[PID3_AXES];
+        float prevDError[PID3_AXES];
+        float dFirstOrder[PID3_AXES];
+        BiquadDelay dLpfDelay;
+        BiquadDelay dNotchDelay;
+
+        void recomputeDerivative(uint8_t axis) noexcept;
+        static void setPassThrough(BiquadCoeffs &coeffs, uint8_t axis) noexcept;
+        static void resetDelay(BiquadDelay &delay) noexcept;
+};
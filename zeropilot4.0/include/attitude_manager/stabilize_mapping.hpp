@@ -22,6 +22,9 @@ class StabilizeMapping : public Flightmode{
         // Setter for *rollLimitAngle* and *pitchLimitAngle* in rad
         void setRollPitchLimitAngle(float newRollPitchLimitAngle) noexcept;
 
+        // Added to the rate commands the angle loop hands to acro, in RC units of [-50, 50]. Cleared with the loop state
+        void setRateCommandOffset(float rollOffset, float pitchOffset, float yawOffset) noexcept;
+
         // Resetter for all roll, pitch and yaw PIDs (needed for unit testing)
         void resetControlLoopState() noexcept;
 
@@ -50,6 +53,10 @@ class StabilizeMapping : public Flightmode{
         float stabilizeRollCmd;
         float stabilizePitchCmd;
 
+        float rollRateOffset;
+        float pitchRateOffset;
+        float yawRateOffset;
+
         // Output limits (for control effort)
         static constexpr float OUTPUT_MIN = -1.0f;
         static constexpr float OUTPUT_MAX = +1.0f;
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include "flightmode.hpp"
+#include "stabilize_mapping.hpp"
+#include "chirp_generator.hpp"
+#include "frequency_response.hpp"
+#include "sysid_log.hpp"
+
+// Values match ArduPilot SID_AXIS, the recovery inputs (4-6) are not supported
+enum class SysIdAxis_e : uint8_t {
+    NONE = 0,
+    INPUT_ROLL = 1,     // Added to the pilot roll stick, the attitude setpoint in stabilized modes
+    INPUT_PITCH = 2,
+    INPUT_YAW = 3,
+    RATE_ROLL = 7,      // Added to the rate setpoint behind the angle loop
+    RATE_PITCH = 8,
+    RATE_YAW = 9,
+    MIX_ROLL = 10,      // Added to the control law output ahead of the mixer
+    MIX_PITCH = 11,
+    MIX_YAW = 12
+};
+
+enum class SysIdInjection_e : uint8_t {
+    INPUT,
+    RATE,
+    MIXER
+};
+
+/*
+ * SYSID flies the base stabilized mode and adds a log swept chirp on one axis at the injection
+ * point picked by SID_AXIS. The injected and measured signals stream out as SysIdLogBlock_t for the
+ * binary log and feed an on board FrequencyResponse estimate, decimated to a rate that keeps
+ * SID_F_STOP_HZ well under Nyquist. Once the chirp completes the mode carries on as the base mode.
+ */
+class SysIdMapping : public Flightmode {
+    public:
+        // rateLoopHost is the stabilize mode whose rate setpoint RATE_* injects into, nullptr rejects RATE_* axes
+        SysIdMapping(float control_iter_period_s, Flightmode &base, IFFT *fftDriver, StabilizeMapping *rateLoopHost = nullptr) noexcept;
+
+        // Restarts the chirp and the estimate with the current settings
+        void activateFlightMode() override;
+
+        RCMotorControlMessage_t runControl(RCMotorControlMessage_t controlInput, const DroneState_t &droneState) override;
+
+        // Settings below are applied on the next activation
+        bool setAxis(uint8_t newAxis) noexcept;
+
+        // Chirp amplitude as a fraction of the injection point's full scale
+        bool setMagnitude(float newMagnitude) noexcept;
+
+        bool setChirp(float fStartHz, float fStopHz, float recordS, float fadeInS, float fadeOutS) noexcept;
+
+        SysIdAxis_e getAxis() const noexcept;
+        bool isRunning() const noexcept;
+
+        // True from the end of the chirp until the next activation
+        bool isComplete() const noexcept;
+
+        const FrequencyResponse &getResponse() const noexcept;
+
+        // Hands out each filled log block once, including the partial block that ends a run
+        bool takeLogBlock(SysIdLogBlock_t &block) noexcept;
+
+        // Hands out the end of each run once
+        bool takeCompletion() noexcept;
+
+        ~SysIdMapping() noexcept override = default;
+
+    private:
+        static constexpr float MAX_MAGNITUDE = 0.5f;
+        static constexpr float ESTIMATE_SAMPLES_PER_STOP_CYCLE = 2.5f;  // Decimated rate over SID_F_STOP_HZ
+
+        // Scale from a fraction of full scale to the units each injection point works in
+        static constexpr float RC_HALF_RANGE = 50.0f;
+        #ifdef PLANE
+        static constexpr float MIXER_FULL_SCALE = 50.0f;    // Surfaces in [0, 100] centred on 50
+        #endif
+        #ifdef QUADCOPTER
+        static constexpr float MIXER_FULL_SCALE = 1.0f;     // Efforts in [-1, 1]
+        #endif
+
+        const float controlPeriodS;
+        Flightmode &baseCLAW;
+        StabilizeMapping *rateLoopHost;
+
+        ChirpGenerator chirp;
+        FrequencyResponse response;
+
+        // Applied on activation
+        SysIdAxis_e pendingAxis;
+        float pendingMagnitude;
+        float pendingFStartHz, pendingFStopHz, pendingRecordS, pendingFadeInS, pendingFadeOutS;
+
+        SysIdAxis_e axis;
+        float magnitude;
+        bool running;
+        bool complete;
+        bool completionUnreported;
+
+        uint16_t decimation;
+        uint16_t decimationCount;
+        float injectedSum;
+        float measuredSum;
+
+        SysIdLogBlock_t block;
+        bool blockReady;
+        SysIdLogBlock_t readyBlock;
+
+        static SysIdInjection_e injectionFor(SysIdAxis_e sysIdAxis) noexcept;
+        static uint8_t axisIndex(SysIdAxis_e sysIdAxis) noexcept;
+        static float measuredSignal(SysIdAxis_e sysIdAxis, const DroneState_t &droneState) noexcept;
+
+        void recordSample(float injected, float measured) noexcept;
+        void flushBlock() noexcept;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ * Thrust linearization and battery voltage compensation for the multirotor output stage.
+ * Thrust is modelled as (1 - expo) * u + expo * u^2 of the effective actuator command u,
+ * as with the ArduPilot MOT_THST_EXPO param, and a sagging battery scales u by V / Vmax.
+ * The inverse curve is precomputed into a LUT whenever the expo changes, so each motor
+ * only costs one interpolated lookup and a multiply per loop.
+ */
+class ThrustCurve {
+    public:
+        ThrustCurve();
+
+        // Rebuilds the LUT only when the value changes, false outside [-1, 1]
+        bool setExpo(float newExpo);
+
+        // Either limit at 0 disables voltage compensation, false for negative or crossed limits
+        bool setVoltageLimits(float newMinVoltage, float newMaxVoltage);
+
+        // Filtered bus voltage, readings far below the minimum are treated as no battery
+        void updateVoltage(float newFilteredVoltage);
+
+        // Desired thrust in [0, 1] to actuator command in [0, 1], ahead of the spin min/max mapping
+        float thrustToActuator(float thrust) const;
+
+        float getExpo() const { return expo; }
+        float getVoltageScale() const { return voltageScale; }
+
+        static constexpr uint8_t LUT_SEGMENTS = 64;
+
+    private:
+        static constexpr float NO_BATTERY_RATIO = 0.25f; // Below this fraction of the minimum voltage nothing is connected
+
+        float expo;
+        float minVoltage;
+        float maxVoltage;
+        float filteredVoltage;
+        float voltageScale; // Vmax / V, 1 with compensation disabled
+        float lut[LUT_SEGMENTS + 1];
+
+        void buildLut();
+        void updateVoltageScale();
+};
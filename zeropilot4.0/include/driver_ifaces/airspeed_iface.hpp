@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+typedef struct {
+    float differentialPressurePa; // Pa, pitot minus static
+    float temperatureC; // Celsius
+    float airspeed; // m/s, indicated
+} AirspeedData_t;
+
+class IAirspeed {
+    protected:
+        IAirspeed() = default;
+    public:
+        virtual ~IAirspeed() = default;
+
+        virtual bool readData(AirspeedData_t &data) = 0;
+};
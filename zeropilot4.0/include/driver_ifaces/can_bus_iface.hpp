@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+// CANARD_ENABLE_CANFD is a project wide define, it has to agree with the libcanard build
+#if CANARD_ENABLE_CANFD
+#define CAN_FRAME_MAX_DATA_LEN 64
+#else
+#define CAN_FRAME_MAX_DATA_LEN 8
+#endif
+
+// Arbitration and, for CAN FD frames, data phase after the bit rate switch
+static constexpr uint32_t CAN_BITRATE_BPS = 1000000;
+static constexpr uint32_t CAN_FD_DATA_BITRATE_BPS = 4000000;
+
+typedef struct {
+    uint32_t id;    // 29 bit extended identifier
+    uint8_t len;    // Payload bytes, not the DLC code
+    bool fd;        // CAN FD frame with bit rate switching, classic CAN otherwise
+    uint8_t data[CAN_FRAME_MAX_DATA_LEN];
+} CANFrame_t;
+
+// Extended filter elements (ExtFiltersNbr) every board gives its CAN peripheral, all the L5 has
+static constexpr uint8_t CAN_MAX_ACCEPTANCE_FILTERS = 8;
+
+// An extended frame passes when (frame id & mask) == (id & mask)
+typedef struct {
+    uint32_t id;
+    uint32_t mask;
+} CANAcceptanceFilter_t;
+
+class ICANBus {
+    protected:
+        ICANBus() = default;
+
+    public:
+        virtual ~ICANBus() = default;
+
+        // Hand a frame to the controller, false when its TX FIFO is full
+        virtual bool transmit(const CANFrame_t &frame) = 0;
+
+        // Only frames passing one of the filters are received. False if the controller has fewer
+        // filter elements than count, it then keeps receiving everything.
+        virtual bool setAcceptanceFilters(const CANAcceptanceFilter_t *filters, uint8_t count) = 0;
+};
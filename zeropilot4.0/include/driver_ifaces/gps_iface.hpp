@@ -4,6 +4,7 @@
 
 static constexpr float INVALID_TRACK_ANGLE = -1.0f;
 static constexpr float INVALID_ALTITUDE = -1.0f;
+static constexpr float INVALID_ACCURACY = -1.0f;
 
 typedef enum {
     NMEA,
@@ -23,6 +24,7 @@ typedef struct {
     Positive lat -> N else S
     Positive lon -> E else W
     Invalid track angle is indicated by INVALID_TRACK_ANGLE = -1
+    solutionTimeMs is GPS time of week for UBX and UTC time of day for NMEA
 */
 typedef struct {
     GpsTime_t time;
@@ -36,6 +38,9 @@ typedef struct {
     float vx; // m/s
     float vy; // m/s
     float vz; // m/s
+    float hAcc; // m, -1 if not valid
+    float vAcc; // m, -1 if not valid
+    uint32_t solutionTimeMs; // ms
 } GpsData_t;
 
 
@@ -10,7 +10,8 @@ typedef struct {
     int16_t xgyro;
     int16_t ygyro;
     int16_t zgyro;
-    uint32_t timestamp;
+    uint32_t timestamp; // Hardware timestamp, in IMU ticks
+    uint64_t timestampUs; // Synchronized monotonic MCU time, in us
     uint8_t imuId;
 } RawImu_t;
 
@@ -21,7 +22,7 @@ typedef struct {
     float xgyro; // rad/s
     float ygyro; // rad/s
     float zgyro; // rad/s
-    uint32_t timestamp;
+    uint64_t timestampUs; // Synchronized monotonic MCU time, in us
     uint8_t imuId;
 } ScaledImu_t;
 
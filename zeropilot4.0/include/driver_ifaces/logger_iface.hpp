@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 class ILogger {
     protected:
         ILogger() = default;
@@ -9,4 +11,7 @@ class ILogger {
 
         virtual int log(const char message[100]) = 0;
         virtual int log(const char message[][100], int count) = 0;
+
+        // Appends raw records to the binary log, kept apart from the text log
+        virtual int logBinary(const void *data, uint32_t len) = 0;
 };
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+// Field strength in the sensor frame
+typedef struct {
+    float x; // Gauss
+    float y; // Gauss
+    float z; // Gauss
+} MagData_t;
+
+class IMagnetometer {
+    protected:
+        IMagnetometer() = default;
+    public:
+        virtual ~IMagnetometer() = default;
+
+        virtual bool readData(MagData_t &data) = 0;
+};
@@ -14,9 +14,13 @@ enum class MotorFunction_e : int16_t {
     THROTTLE        = 70,
     #endif
     #ifdef QUADCOPTER
-    MOTOR_1 = 33, // Front right
-    MOTOR_2 = 34, // Rear left 
-    MOTOR_3 = 35, // Front left
-    MOTOR_4 = 36  // Rear right
+    MOTOR_1 = 33, // Quad X front right, other frames follow the mixer frame table
+    MOTOR_2 = 34, // Quad X rear left 
+    MOTOR_3 = 35, // Quad X front left
+    MOTOR_4 = 36, // Quad X rear right
+    MOTOR_5 = 37,
+    MOTOR_6 = 38,
+    MOTOR_7 = 39,
+    MOTOR_8 = 40
     #endif
 };
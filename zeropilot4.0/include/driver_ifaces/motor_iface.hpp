@@ -14,9 +14,23 @@ class IMotorControl {
         // Set pwm percentage of servo motors
         virtual void set(uint32_t percent) = 0;
 
+        // Normalized command in [0, 1] at the full resolution of the output, outputs that only
+        // take whole percent fall back to set()
+        virtual void setNormalized(float command) {
+            if (!(command > 0.0f)) {
+                command = 0.0f;
+            } else if (command > 1.0f) {
+                command = 1.0f;
+            }
+            set(static_cast<uint32_t>(command * 100.0f + 0.5f));
+        }
+
         // Initialize/start motor output
         virtual void init() = 0;
 
         // Set arm flag
         virtual void setArm(bool arm) { armFlag = arm; };
+
+        // Latest electrical RPM from ESC telemetry, false if the output has none or it went stale
+        virtual bool readErpm(uint32_t &erpm) { (void)erpm; return false; }
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 
 #define INPUT_CHANNELS 16
 
@@ -63,3 +64,43 @@ class RCControl {
             aux11       = 0.0f;
         }
 };
+
+// Link quality reported by the receiver, isValid is false when the protocol does not report it
+typedef struct {
+    bool isValid;
+    uint8_t linkQuality;    // Uplink packets received, %
+    int16_t rssiDbm;        // Uplink RSSI of the active antenna
+    int8_t snrDb;
+} RCLinkStats_t;
+
+// Decoded channels, same 0-100 scaling as RCControl, published by the receiver for the attitude loop fast path
+typedef struct {
+    float controlSignals[INPUT_CHANNELS];
+    RCLinkStats_t linkStats;    // Newest link stats when the frame was decoded, so the AM can apply RC_FS_LQ like SM
+} RCChannelFrame_t;
+
+static constexpr uint8_t RC_TELEM_FLIGHT_MODE_LEN = 16;
+
+// System state for receivers with a telemetry downlink, provided by the system manager
+typedef struct {
+    bool batteryValid;
+    float batteryVoltage;   // V
+    float batteryCurrent;   // A
+    float consumedMah;
+    uint8_t batteryRemaining; // %
+    char flightMode[RC_TELEM_FLIGHT_MODE_LEN];
+} RCSystemTelemetry_t;
+
+// Attitude and position for the telemetry downlink, published by the attitude manager
+typedef struct {
+    float roll;             // rad
+    float pitch;            // rad
+    float yaw;              // rad
+    bool gpsValid;
+    float latitude;         // deg
+    float longitude;        // deg
+    float altitude;         // m
+    float groundSpeed;      // cm/s
+    float trackAngle;       // deg
+    uint8_t numSatellites;
+} RCNavTelemetry_t;
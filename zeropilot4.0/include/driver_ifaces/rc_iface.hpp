@@ -11,4 +11,10 @@ class IRCReceiver {
 
         // get RCControl data that is parsed from sbus
         virtual RCControl getRCData() = 0;
+
+        // Link quality reported by the receiver, isValid is false when the protocol has none
+        virtual RCLinkStats_t getLinkStats() { return RCLinkStats_t{}; }
+
+        // System state for receivers with a telemetry downlink, ignored by the others
+        virtual void setTelemetry(const RCSystemTelemetry_t &telemetry) { (void)telemetry; }
 };
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include "gps_iface.hpp"
+#include "systemutils_iface.hpp"
+
+/*
+ * Merges two receivers into a single IGPS.
+ * Position and velocity are weighted by the inverse variance of each receiver's reported
+ * accuracy (hAcc horizontally, vAcc vertically). The older solution is propagated along its
+ * velocity to the epoch of the newer one before blending. A receiver that stops producing
+ * solutions for longer than RECEIVER_TIMEOUT_MS is dropped and the other one is passed through.
+ */
+class BlendedGPS : public IGPS {
+    public:
+        static constexpr uint8_t NUM_RECEIVERS = 2;
+        static constexpr uint32_t RECEIVER_TIMEOUT_MS = 500;
+        static constexpr uint32_t MAX_TIME_OFFSET_MS = 1000; // Larger offsets mean the receivers use different time bases
+        static constexpr float DEFAULT_ACCURACY_M = 10.0f; // Used when a receiver does not report accuracy
+        static constexpr float MIN_ACCURACY_M = 0.01f;
+
+        BlendedGPS(IGPS *gps1, IGPS *gps2, ISystemUtils *sysUtils) noexcept;
+
+        GpsData_t readData() override;
+
+        // Bit i set when receiver i is currently contributing
+        uint8_t getHealthyMask() const noexcept { return healthyMask; }
+
+        // Number of times the healthy set shrank, i.e. a receiver was dropped
+        uint32_t getFailoverCount() const noexcept { return failoverCount; }
+
+        // Horizontal weight of gps1 in the last blended solution, 0 or 1 when only one receiver is healthy
+        float getGps1Weight() const noexcept { return gps1Weight; }
+
+    private:
+        IGPS *receivers[NUM_RECEIVERS];
+        ISystemUtils *sysUtils;
+
+        GpsData_t latest[NUM_RECEIVERS];
+        uint32_t lastUpdateMs[NUM_RECEIVERS];
+        bool hasData[NUM_RECEIVERS];
+
+        GpsData_t output;
+        uint8_t healthyMask;
+        uint32_t failoverCount;
+        float gps1Weight;
+
+        GpsData_t blend(const GpsData_t &a, const GpsData_t &b) noexcept;
+
+        static GpsData_t propagate(const GpsData_t &data, float dt) noexcept;
+        static float inverseVariance(float accuracy) noexcept;
+        static int32_t timeOffsetMs(uint32_t later, uint32_t earlier) noexcept;
+};
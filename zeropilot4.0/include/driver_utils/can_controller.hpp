@@ -0,0 +1,286 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "can_node.hpp"
+#include "canard.h"
+#include "uavcan.protocol.NodeStatus.h"
+#include "uavcan.protocol.dynamic_node_id.Allocation.h"
+#include "uavcan.equipment.esc.RawCommand.h"
+#include "uavcan.equipment.esc.Status.h"
+#include "uavcan.equipment.actuator.ArrayCommand.h"
+#include "can_bus_iface.hpp"
+#include "systemutils_iface.hpp"
+#include "latest_value_slot.hpp"
+#include "can_bus_stats.hpp"
+#include "actuator_command.hpp"
+#include "esc_status.hpp"
+#include "dronecan_sensors.hpp"
+
+// RX buffering covers a saturated bus for as long as the bus task may be held off by higher priority work
+#if CANARD_ENABLE_CANFD
+static constexpr uint32_t CAN_MIN_FRAME_BITS = 59;              // FD frame with a 1 byte payload, data phase in nominal bit times, no stuffing
+#else
+static constexpr uint32_t CAN_MIN_FRAME_BITS = 75;              // Extended frame with a 1 byte payload (tail byte only), no stuffing
+#endif
+static constexpr uint32_t CAN_BUS_MAX_SERVICE_LATENCY_MS = 10;
+
+// libcanard pool budget, in CANARD_MEM_BLOCK_SIZE blocks
+static constexpr uint32_t CAN_RX_TRANSFER_BUDGET = 32;          // Multi-frame transfers being reassembled at once
+static constexpr uint32_t CAN_RX_BLOCKS_PER_TRANSFER = 3;       // State and head, plus payload blocks for transfers up to ~60 bytes
+static constexpr uint32_t CAN_TX_FRAME_BUDGET = 64;             // Frames waiting for the TX FIFO
+
+// Servos don't follow faster than this, ESC commands go out on every AM tick
+static constexpr uint32_t CAN_SERVO_COMMAND_PERIOD_MS = 20;
+
+/*
+ * DroneCAN node on top of libcanard: node status, dynamic node ID allocation, bus statistics and,
+ * when given the slots, ESC and servo outputs with esc.Status feedback and GNSS, air data and
+ * compass sensors. Each sensor follows the first node that broadcasts it until that node goes offline.
+ * The bus is given acceptance filters for the transfers the controller handles, so the rest of the
+ * traffic never reaches the CPU.
+ * The RX ISR copies frames into a single producer, single consumer ring which the bus task drains
+ * through libcanard in routineTasks(). TX frames stay in the libcanard queue until the controller
+ * FIFO takes them, so routineTasks() should also run on every TX complete event.
+ * Everything except the ISR entry points must be called from the bus task.
+ */
+class CANController {
+    public:
+        static constexpr uint32_t RX_RING_SLOTS = 256;
+        static constexpr size_t CANARD_POOL_SIZE =
+            (CAN_RX_TRANSFER_BUDGET * CAN_RX_BLOCKS_PER_TRANSFER + CAN_TX_FRAME_BUDGET) * CANARD_MEM_BLOCK_SIZE;
+
+        CANController(
+            ICANBus *bus,
+            ISystemUtils *systemUtilsDriver,
+            LatestValueSlot<CANBusStats_t> *busStats = nullptr,
+            LatestValueSlot<ActuatorCommand_t> *actuatorCommands = nullptr,
+            EscStatusTable *escStatus = nullptr,
+            DroneCANGPS *gps = nullptr,
+            DroneCANBarometer *barometer = nullptr,
+            DroneCANMagnetometer *magnetometer = nullptr,
+            DroneCANAirspeed *airspeed = nullptr
+        );
+
+        // ISR side: len is the payload length in bytes, false if the ring was full and the frame dropped
+        bool enqueueRxFrame(uint32_t id, uint8_t len, const uint8_t *data, bool fd = false);
+
+        // ISR side: hardware FIFO overflow and bus off notifications
+        void noteRxFifoOverrun();
+        void noteBusOff();
+
+        // Drain RX, queue new actuator commands, run the 1 Hz tasks when due and refill the TX FIFO
+        bool routineTasks();
+
+        #if CANARD_ENABLE_CANFD
+            // Send our transfers as CAN FD frames, only for buses where every node is FD capable.
+            // Both frame formats are received either way.
+            void setFdTransmit(bool enable) { fdTransmit = enable; }
+        #endif
+
+        bool hasPendingRx() const;
+        CANBusStats_t getStats();
+        const CanNode &getNode(uint8_t nodeId) const;
+
+        bool CanardShouldAcceptTransfer(const CanardInstance* ins,
+            uint64_t* outDataTypeSignature,
+            uint16_t dataTypeId,
+            CanardTransferType transferType,
+            uint8_t sourceNodeId);
+
+        void CanardOnTransferReception(CanardInstance* ins,
+            CanardRxTransfer* transfer);
+
+        int16_t broadcastObj(CanardTxTransfer* transfer);
+
+        int16_t broadcast(
+            CanardTransferType transferType,
+            uint64_t dataTypeSignature,
+            uint16_t dataTypeId,
+            uint8_t* inoutTransferId,
+            uint8_t priority,
+            const uint8_t* payload,
+            uint16_t payloadLen
+            #if CANARD_ENABLE_CANFD
+                , bool canfd              // True to send as a CAN FD frame
+            #endif
+            #if CANARD_ENABLE_DEADLINE
+                , uint64_t deadlineUsec  // Transfer deadline in microseconds
+            #endif
+            #if CANARD_MULTI_IFACE
+                , uint8_t ifaceMask      // Bitmask of interfaces to send the transfer on
+            #endif
+            #if CANARD_ENABLE_TAO_OPTION
+                , bool tao                // True to enable tail array optimization
+            #endif
+        );
+
+    private:
+        struct DnaAllocationEntry {
+            uint8_t uniqueId[16];
+            uint8_t nodeId;
+        };
+
+        enum DnaStage {
+            INVALID = 0,
+            FIRST_UNIQUE_ID_PART = 1,
+            SECOND_UNIQUE_ID_PART = 2,
+            FINAL_UNIQUE_ID_PART = 3,
+        };
+
+        typedef void (CANController::*TransferHandler)(CanardRxTransfer *transfer);
+
+        // Transfers that are only accepted when the controller was given somewhere to put them
+        enum Feature : uint8_t {
+            FEATURE_NONE = 0,
+            FEATURE_ESC_STATUS = 1 << 0,
+            FEATURE_GPS = 1 << 1,
+            FEATURE_BAROMETER = 1 << 2,
+            FEATURE_MAGNETOMETER = 1 << 3,
+            FEATURE_AIRSPEED = 1 << 4,
+        };
+
+        struct AcceptedTransfer {
+            uint16_t dataTypeId;
+            CanardTransferType transferType;
+            uint64_t signature;
+            TransferHandler handler;
+            uint8_t feature;
+        };
+
+        struct RawCanFrame {
+            uint32_t id;
+            uint32_t timestampMs;
+            uint8_t len;
+            bool fd;
+            uint8_t data[CAN_FRAME_MAX_DATA_LEN];
+        };
+
+        static_assert((RX_RING_SLOTS & (RX_RING_SLOTS - 1)) == 0, "RX ring size must be a power of two");
+        static_assert(RX_RING_SLOTS >= CAN_BITRATE_BPS / CAN_MIN_FRAME_BITS * CAN_BUS_MAX_SERVICE_LATENCY_MS / 1000,
+            "RX ring must hold every frame a saturated bus can deliver within the service latency");
+
+        static constexpr uint8_t NODE_ID = CANARD_MIN_NODE_ID;
+        static constexpr uint8_t MAX_ALLOCATION_ENTRIES = 125;
+        static constexpr uint8_t UAVCAN_UNIQUE_ID_LENGTH = 16;
+
+        ICANBus *bus;
+        ISystemUtils *systemUtilsDriver;
+        LatestValueSlot<CANBusStats_t> *busStats;
+        LatestValueSlot<ActuatorCommand_t> *actuatorCommands;
+        EscStatusTable *escStatus;
+        DroneCANGPS *gps;
+        DroneCANBarometer *barometer;
+        DroneCANMagnetometer *magnetometer;
+        DroneCANAirspeed *airspeed;
+        uint8_t features;
+        uint8_t profilerId;
+        #if CANARD_ENABLE_CANFD
+            bool fdTransmit;
+        #endif
+
+        // Written by the ISR only
+        RawCanFrame rxRing[RX_RING_SLOTS];
+        std::atomic<uint32_t> rxHead;
+        volatile uint32_t rxRingOverruns;
+        volatile uint32_t rxFifoOverruns;
+        volatile uint32_t busOffEvents;
+        volatile uint16_t rxRingPeak;
+
+        // Written by the bus task only
+        std::atomic<uint32_t> rxTail;
+        uint32_t rxFrames;
+        uint32_t txFrames;
+        uint32_t rxPoolExhausted;
+        uint32_t txQueueFull;
+
+        CanardInstance canard;
+        alignas(8) uint8_t canardMemoryPool[CANARD_POOL_SIZE];
+
+        uint8_t nodeStatusTransferId;
+        uint8_t dnaAllocationTransferId;
+        uint8_t escCommandTransferId;
+        uint8_t servoCommandTransferId;
+
+        // Node each sensor is taken from, 0 until one is heard
+        uint8_t gpsNodeId;
+        uint8_t barometerNodeId;
+        uint8_t magnetometerNodeId;
+        uint8_t airspeedNodeId;
+
+        uint32_t actuatorCommandSeq;
+        uint32_t lastServoCommandMs;
+
+        CanNode canNodes[CANARD_MAX_NODE_ID + 1];
+        uint8_t nextAvailableID;
+        DnaAllocationEntry allocationTable[MAX_ALLOCATION_ENTRIES];
+        uint8_t allocationCount;
+
+        uavcan_protocol_NodeStatus nodeStatus;
+        uint32_t last1HzTick;
+
+        uint8_t dnaCurrentUniqueId[UAVCAN_UNIQUE_ID_LENGTH];
+        uint8_t dnaCurrentUniqueIdLen;
+        uint8_t dnaPreferredNodeId;
+        uint32_t dnaLastAcceptedTick;
+
+        void sendNodeStatus();
+        void sendCanTx();
+        void handleNodeAllocation(CanardRxTransfer* transfer);
+        void handleNodeStatus(CanardRxTransfer* transfer);
+        void handleEscStatus(CanardRxTransfer* transfer);
+        void handleGnssFix2(CanardRxTransfer* transfer);
+        void handleStaticPressure(CanardRxTransfer* transfer);
+        void handleStaticTemperature(CanardRxTransfer* transfer);
+        void handleMagneticField(CanardRxTransfer* transfer);
+        void handleRawAirData(CanardRxTransfer* transfer);
+        bool acceptSensorNode(uint8_t &sensorNodeId, uint8_t sourceNodeId) const;
+        void releaseOfflineSensorNodes();
+        const AcceptedTransfer *findAcceptedTransfer(uint16_t dataTypeId, CanardTransferType transferType) const;
+        uint8_t buildAcceptanceFilters(CANAcceptanceFilter_t *filters) const;
+        bool useTailArrayOptimization() const;
+        int16_t broadcastMessage(uint64_t dataTypeSignature, uint16_t dataTypeId, uint8_t *inoutTransferId,
+            uint8_t priority, const uint8_t *payload, uint16_t payloadLen);
+        void sendActuatorCommands();
+        int8_t allocateNode();
+        int8_t lookupAllocation(const uint8_t unique_id[16]) const;
+        bool isNodeIdAllocated(uint8_t nodeId) const;
+        void process1HzTasks();
+        DnaStage detectDnaRequestStage(const uavcan_protocol_dynamic_node_id_Allocation& msg) const;
+        DnaStage getExpectedDnaStage() const;
+        void resetDnaInProgress();
+        int16_t publishDnaAllocationResponse(uint8_t nodeId, const uint8_t* unique_id, uint8_t unique_id_len);
+
+        bool dequeueRxFrame(RawCanFrame *frame);
+        void handleRxFrame(const RawCanFrame &frame);
+
+        // Sorted by data type ID for the binary search in findAcceptedTransfer
+        static constexpr AcceptedTransfer ACCEPTED_TRANSFERS[] = {
+            {UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_ID, CanardTransferTypeBroadcast,
+                UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_SIGNATURE, &CANController::handleNodeAllocation, FEATURE_NONE},
+            {UAVCAN_PROTOCOL_NODESTATUS_ID, CanardTransferTypeBroadcast,
+                UAVCAN_PROTOCOL_NODESTATUS_SIGNATURE, &CANController::handleNodeStatus, FEATURE_NONE},
+            {UAVCAN_EQUIPMENT_AHRS_MAGNETICFIELDSTRENGTH2_ID, CanardTransferTypeBroadcast,
+                UAVCAN_EQUIPMENT_AHRS_MAGNETICFIELDSTRENGTH2_SIGNATURE, &CANController::handleMagneticField, FEATURE_MAGNETOMETER},
+            {UAVCAN_EQUIPMENT_AIR_DATA_RAWAIRDATA_ID, CanardTransferTypeBroadcast,
+                UAVCAN_EQUIPMENT_AIR_DATA_RAWAIRDATA_SIGNATURE, &CANController::handleRawAirData, FEATURE_AIRSPEED},
+            {UAVCAN_EQUIPMENT_AIR_DATA_STATICPRESSURE_ID, CanardTransferTypeBroadcast,
+                UAVCAN_EQUIPMENT_AIR_DATA_STATICPRESSURE_SIGNATURE, &CANController::handleStaticPressure, FEATURE_BAROMETER},
+            {UAVCAN_EQUIPMENT_AIR_DATA_STATICTEMPERATURE_ID, CanardTransferTypeBroadcast,
+                UAVCAN_EQUIPMENT_AIR_DATA_STATICTEMPERATURE_SIGNATURE, &CANController::handleStaticTemperature, FEATURE_BAROMETER},
+            {UAVCAN_EQUIPMENT_ESC_STATUS_ID, CanardTransferTypeBroadcast,
+                UAVCAN_EQUIPMENT_ESC_STATUS_SIGNATURE, &CANController::handleEscStatus, FEATURE_ESC_STATUS},
+            {UAVCAN_EQUIPMENT_GNSS_FIX2_ID, CanardTransferTypeBroadcast,
+                UAVCAN_EQUIPMENT_GNSS_FIX2_SIGNATURE, &CANController::handleGnssFix2, FEATURE_GPS},
+        };
+        static constexpr size_t ACCEPTED_TRANSFER_COUNT = sizeof(ACCEPTED_TRANSFERS) / sizeof(ACCEPTED_TRANSFERS[0]);
+
+        static constexpr bool acceptedTransfersSorted() {
+            for (size_t i = 1; i < ACCEPTED_TRANSFER_COUNT; i++) {
+                if (ACCEPTED_TRANSFERS[i - 1].dataTypeId >= ACCEPTED_TRANSFERS[i].dataTypeId) return false;
+            }
+            return true;
+        }
+};
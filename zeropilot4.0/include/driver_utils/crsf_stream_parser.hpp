@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+
+static constexpr uint8_t CRSF_SYNC_BYTE = 0xC8;                 // Flight controller address, also used as sync
+static constexpr uint8_t CRSF_ADDRESS_RADIO_TRANSMITTER = 0xEA;
+static constexpr uint8_t CRSF_ADDRESS_CRSF_RECEIVER = 0xEC;
+static constexpr uint8_t CRSF_ADDRESS_CRSF_TRANSMITTER = 0xEE;
+
+static constexpr uint8_t CRSF_FRAMETYPE_GPS = 0x02;
+static constexpr uint8_t CRSF_FRAMETYPE_BATTERY_SENSOR = 0x08;
+static constexpr uint8_t CRSF_FRAMETYPE_LINK_STATISTICS = 0x14;
+static constexpr uint8_t CRSF_FRAMETYPE_RC_CHANNELS_PACKED = 0x16;
+static constexpr uint8_t CRSF_FRAMETYPE_ATTITUDE = 0x1E;
+static constexpr uint8_t CRSF_FRAMETYPE_FLIGHT_MODE = 0x21;
+
+static constexpr uint8_t CRSF_CHANNEL_COUNT = 16;
+static constexpr uint8_t CRSF_RC_CHANNELS_PAYLOAD_LEN = 22;     // 16 channels, 11 bits each
+static constexpr uint8_t CRSF_LINK_STATISTICS_PAYLOAD_LEN = 10;
+
+static constexpr uint8_t CRSF_MAX_FRAME_LEN = 64;               // Address, length and up to 62 bytes of type, payload and CRC
+static constexpr uint8_t CRSF_MAX_PAYLOAD_LEN = CRSF_MAX_FRAME_LEN - 4;
+
+typedef struct {
+    uint8_t uplinkRssi1;        // -dBm
+    uint8_t uplinkRssi2;        // -dBm
+    uint8_t uplinkLinkQuality;  // %
+    int8_t uplinkSnr;           // dB
+    uint8_t activeAntenna;
+    uint8_t rfMode;
+    uint8_t uplinkTxPower;
+    uint8_t downlinkRssi;       // -dBm
+    uint8_t downlinkLinkQuality; // %
+    int8_t downlinkSnr;         // dB
+} CrsfLinkStats_t;
+
+typedef struct {
+    uint32_t framesOk;          // Frames with a valid CRC, of any type
+    uint32_t crcErrors;
+    uint32_t droppedFrames;     // Invalid length, or a known type with the wrong payload size
+    uint32_t droppedBytes;      // Noise between frames
+} CrsfParserStats_t;
+
+/*
+ * CRSF stream parser.
+ * Bytes are appended to a one-frame buffer that is scanned for complete frames, so a single
+ * feed() may carry any number of frames and a frame may be split across any number of feed()
+ * calls. On a CRC failure the scan restarts one byte after the rejected sync byte, so a frame
+ * hidden behind noise that looked like a header is still found.
+ */
+class CrsfStreamParser {
+    public:
+        CrsfStreamParser() noexcept;
+
+        void feed(const uint8_t *data, uint16_t len) noexcept;
+        void feedByte(uint8_t byte) noexcept;
+
+        // Raw 11 bit channel values of the newest RC frame, true only on the first call after it arrived
+        bool takeChannels(uint16_t (&out)[CRSF_CHANNEL_COUNT]) noexcept;
+
+        // Newest link statistics, true only on the first call after they arrived
+        bool takeLinkStats(CrsfLinkStats_t &out) noexcept;
+
+        // Number of valid RC channel frames since reset
+        uint32_t getChannelFrameCount() const noexcept { return channelFrames; }
+
+        const CrsfParserStats_t &getStats() const noexcept { return stats; }
+
+        void reset() noexcept;
+
+        // Drop the frame in progress after a gap in the stream, keeps the stats, channels and link stats
+        void resync() noexcept;
+
+        // CRC8 with polynomial 0xD5 over type and payload
+        static uint8_t crc8(const uint8_t *data, uint8_t len) noexcept;
+
+        // Build a complete frame into out, returns the frame length or 0 if it does not fit
+        static uint8_t encodeFrame(uint8_t type, const uint8_t *payload, uint8_t payloadLen, uint8_t *out, uint8_t outSize) noexcept;
+
+    private:
+        static const uint8_t CRC8_TABLE[256];
+
+        uint8_t frame[CRSF_MAX_FRAME_LEN];
+        uint8_t frameLen;
+        CrsfParserStats_t stats;
+
+        uint16_t channels[CRSF_CHANNEL_COUNT];
+        bool newChannels;
+        uint32_t channelFrames;
+
+        CrsfLinkStats_t linkStats;
+        bool newLinkStats;
+
+        void scan() noexcept;
+        void dispatch(uint8_t type, const uint8_t *payload, uint8_t payloadLen) noexcept;
+        void decodeChannels(const uint8_t *payload) noexcept;
+        void decodeLinkStats(const uint8_t *payload) noexcept;
+        void discard(uint8_t count) noexcept;
+
+        static bool isSyncByte(uint8_t byte) noexcept;
+};
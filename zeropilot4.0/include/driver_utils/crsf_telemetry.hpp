@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include "rc_datatypes.hpp"
+
+/*
+ * CRSF telemetry encoder and downlink scheduler.
+ * The receiver forwards telemetry in the downlink slots of its air protocol, so the flight
+ * controller answers each RC frame with at most one telemetry frame, sent right after it.
+ * A frame is only sent if it finishes on the wire SLOT_GUARD_US before the next RC frame
+ * is due, based on the measured RC frame period. Frame types with data are sent round robin.
+ */
+class CrsfTelemetry {
+    public:
+        static constexpr uint32_t UART_BAUD = 420000;
+        static constexpr uint32_t SLOT_GUARD_US = 200;
+        static constexpr uint32_t MIN_FRAME_INTERVAL_US = 4000;    // Caps the downlink at 250 frames/s
+        static constexpr uint32_t MAX_RC_FRAME_PERIOD_US = 100000; // Longer gaps are link drops, not the frame rate
+
+        CrsfTelemetry() noexcept;
+
+        void setSystem(const RCSystemTelemetry_t &system) noexcept;
+        void setNav(const RCNavTelemetry_t &nav) noexcept;
+
+        // Call as each RC frame completes, writes the frame for this slot into out, returns its length or 0 to stay silent
+        uint8_t onRcFrame(uint32_t nowUs, uint8_t *out, uint8_t outSize) noexcept;
+
+        // Smoothed interval between RC frames, 0 until two frames have been seen
+        uint32_t getRcFramePeriodUs() const noexcept { return rcPeriodUs; }
+        uint32_t getFramesSent() const noexcept { return framesSent; }
+
+        static uint8_t encodeBattery(const RCSystemTelemetry_t &system, uint8_t *out, uint8_t outSize) noexcept;
+        static uint8_t encodeFlightMode(const RCSystemTelemetry_t &system, uint8_t *out, uint8_t outSize) noexcept;
+        static uint8_t encodeAttitude(const RCNavTelemetry_t &nav, uint8_t *out, uint8_t outSize) noexcept;
+        static uint8_t encodeGps(const RCNavTelemetry_t &nav, uint8_t *out, uint8_t outSize) noexcept;
+
+        // Time on the wire for a frame of frameLen bytes, 10 bits per byte
+        static uint32_t frameAirtimeUs(uint8_t frameLen) noexcept;
+
+    private:
+        enum class Frame_e : uint8_t {
+            BATTERY,
+            ATTITUDE,
+            GPS,
+            FLIGHT_MODE,
+            COUNT
+        };
+
+        RCSystemTelemetry_t system;
+        RCNavTelemetry_t nav;
+        bool haveSystem;
+        bool haveNav;
+
+        uint32_t lastRcFrameUs;
+        bool haveRcFrame;
+        uint32_t rcPeriodUs;
+
+        uint32_t lastSentUs;
+        bool haveSent;
+        uint32_t framesSent;
+        uint8_t nextFrame;
+
+        uint8_t encode(Frame_e frameType, uint8_t *out, uint8_t outSize) const noexcept;
+};
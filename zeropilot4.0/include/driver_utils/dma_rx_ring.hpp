@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ * Reader side of a circular DMA receive buffer.
+ * The DMA keeps writing into the buffer; the ISR reports the write position and the
+ * consumer parses unread bytes in place, without copying them out first.
+ * Requires at least one DMA event (half/full transfer or idle) per half buffer so the
+ * write position can never lap unnoticed.
+ */
+class DmaRxRing {
+    public:
+        DmaRxRing(const volatile uint8_t *buffer, uint16_t size) noexcept;
+
+        // ISR side: writePos is the DMA position in the buffer (size wraps to 0)
+        void onDmaEvent(uint16_t writePos) noexcept;
+
+        // ISR side: the DMA was restarted from the start of the buffer. The reader drops what it
+        // had not consumed on its next readSpan()
+        void onDmaRestart() noexcept;
+
+        // Longest contiguous run of unread bytes, returns its length (0 when empty)
+        uint16_t readSpan(const uint8_t *&data) noexcept;
+
+        // Mark count bytes returned by readSpan as consumed
+        void advance(uint16_t count) noexcept;
+
+        // True once after readSpan() skipped bytes, from an overrun or a DMA restart. The next span
+        // doesn't continue the stream before it, so a parser has to drop its partial frame
+        bool takeDiscontinuity() noexcept;
+
+        // Drop all unread data. Not safe against a running ISR, use onDmaRestart() from there
+        void reset() noexcept;
+
+        uint16_t available() const noexcept;
+        uint32_t getOverrunBytes() const noexcept { return overrunBytes; }
+
+    private:
+        const volatile uint8_t *buffer;
+        const uint16_t size;
+
+        volatile uint32_t writeTotal;   // Bytes written by the DMA since reset, only changed by the ISR
+        uint16_t lastWritePos;          // ISR private
+        uint32_t readTotal;             // Bytes consumed since reset, only changed by the reader
+        uint16_t readPos;
+        uint32_t overrunBytes;
+
+        volatile uint32_t restartTotal; // writeTotal at the last DMA restart, only changed by the ISR
+        volatile uint32_t restarts;     // Only changed by the ISR
+        uint32_t seenRestarts;          // Reader private
+        bool discontinuity;             // Reader private
+};
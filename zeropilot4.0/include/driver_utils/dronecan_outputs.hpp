@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include "motor_iface.hpp"
+#include "systemutils_iface.hpp"
+#include "latest_value_slot.hpp"
+#include "actuator_command.hpp"
+#include "esc_status.hpp"
+
+enum class DroneCANOutputType_e : uint8_t {
+    ESC,
+    SERVO
+};
+
+/*
+ * Collects the DroneCAN outputs of one AM tick into a single ActuatorCommand_t.
+ * Like the DShot burst group, the command set is published once every registered output has a
+ * new value, so the bus task sends all ESCs in one RawCommand and all servos in one ArrayCommand.
+ * An output set twice before the others publishes the set early with their previous values.
+ * The optional hook runs right after publishing, the board uses it to wake the bus task.
+ */
+class DroneCANOutputGroup {
+    public:
+        typedef void (*CommandsReadyHook)();
+
+        static constexpr uint8_t MAX_OUTPUTS = ACTUATOR_COMMAND_MAX_ESCS + ACTUATOR_COMMAND_MAX_SERVOS;
+        static constexpr uint32_t ESC_STATUS_TIMEOUT_MS = 250;
+
+        /**
+         * @param commands slot read by the bus task
+         * @param escStatus table filled by the bus task from esc.Status, nullptr if unused
+         * @param motorPolePairs esc.Status reports mechanical RPM, readErpm scales it back to eRPM
+         * @param commandsReady called from the AM task every time a command set is published
+         */
+        DroneCANOutputGroup(LatestValueSlot<ActuatorCommand_t> *commands, const EscStatusTable *escStatus,
+            ISystemUtils *sysUtils, uint8_t motorPolePairs, CommandsReadyHook commandsReady = nullptr) noexcept;
+
+        /**
+         * @brief registers an output before the first command
+         * @return slot used for setEsc/setServo/readErpm, -1 if the index is invalid, taken or the group is full
+         */
+        int8_t addEsc(uint8_t escIndex);
+        int8_t addServo(uint8_t actuatorId);
+
+        void setEsc(uint8_t slot, int16_t raw);
+        void setServo(uint8_t slot, float command);
+
+        /**
+         * @brief eRPM from the last esc.Status of the ESC behind slot
+         * @return false if the slot is not an ESC or its status is older than ESC_STATUS_TIMEOUT_MS
+         */
+        bool readErpm(uint8_t slot, uint32_t &erpm);
+
+        uint32_t getPublishCount() const { return publishCount; }
+
+    private:
+        typedef struct {
+            bool isEsc;
+            uint8_t index;          // ESC index, or position in the servo arrays
+            uint32_t statusSeq;
+            EscStatus_t status;
+            bool haveStatus;
+        } Output_t;
+
+        LatestValueSlot<ActuatorCommand_t> * const commands;
+        const EscStatusTable * const escStatus;
+        ISystemUtils * const sysUtils;
+        const uint8_t motorPolePairs;
+        const CommandsReadyHook commandsReady;
+
+        Output_t outputs[MAX_OUTPUTS];
+        uint8_t outputCount;
+        uint16_t escIndexMask;
+        uint16_t activeMask;
+        uint16_t pendingMask;
+        ActuatorCommand_t pending;
+        uint32_t publishCount;
+
+        void flushIfRepeated(uint8_t slot);
+        void markPending(uint8_t slot);
+        void publish();
+};
+
+class DroneCANMotorControl : public IMotorControl {
+    public:
+        /**
+         * @param type ESC outputs go out as RawCommand entry index, servos in ArrayCommand with actuator_id index
+         */
+        DroneCANMotorControl(DroneCANOutputGroup *group, DroneCANOutputType_e type, uint8_t index);
+
+        /**
+         * @brief sets output in percent (0-100)
+         */
+        void set(uint32_t percent) override;
+
+        /**
+         * @brief 0-1 maps to 0-ESC_RAW_COMMAND_FULL_SCALE for ESCs and to -1 to 1 for servos.
+         * A disarmed ESC is sent 0.
+         */
+        void setNormalized(float command) override;
+
+        void init() override;
+
+        bool readErpm(uint32_t &erpm) override;
+
+    private:
+        DroneCANOutputGroup * const group;
+        const DroneCANOutputType_e type;
+        const int8_t slot;
+};
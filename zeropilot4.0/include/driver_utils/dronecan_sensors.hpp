@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include "gps_iface.hpp"
+#include "barometer_iface.hpp"
+#include "magnetometer_iface.hpp"
+#include "airspeed_iface.hpp"
+#include "latest_value_slot.hpp"
+#include "uavcan.equipment.gnss.Fix2.h"
+#include "uavcan.equipment.air_data.StaticPressure.h"
+#include "uavcan.equipment.air_data.StaticTemperature.h"
+#include "uavcan.equipment.air_data.RawAirData.h"
+#include "uavcan.equipment.ahrs.MagneticFieldStrength2.h"
+
+/*
+ * Latest sample of one DroneCAN sensor. The bus task publishes, any one task reads.
+ * read() copies the newest sample and reports whether it arrived since the previous read,
+ * out is left untouched until the first sample arrives.
+ */
+template <typename T>
+class DroneCANSensorSlot {
+    public:
+        DroneCANSensorSlot() noexcept : lastSeq(0), last{} {}
+
+        void publish(const T &sample) noexcept { slot.publish(sample); }
+
+        bool read(T &out) noexcept {
+            const bool fresh = slot.readIfNew(last, lastSeq);
+            if (lastSeq != 0) {
+                out = last;
+            }
+            return fresh;
+        }
+
+        uint32_t getPublishCount() const noexcept { return slot.getPublishCount(); }
+
+    private:
+        LatestValueSlot<T> slot;
+        uint32_t lastSeq;
+        T last;
+};
+
+/*
+ * The publish* methods below run on the bus task with a decoded broadcast, the readData
+ * methods are the driver interface seen by the managers.
+ */
+class DroneCANGPS : public IGPS {
+    public:
+        // Solutions without a 2D or 3D fix are dropped, as with the serial receivers
+        void publishFix2(const uavcan_equipment_gnss_Fix2 &msg) noexcept;
+
+        // isNew is set only on the first call after a fix arrived
+        GpsData_t readData() override;
+
+        uint32_t getPublishCount() const noexcept { return fix.getPublishCount(); }
+
+    private:
+        DroneCANSensorSlot<GpsData_t> fix;
+};
+
+class DroneCANBarometer : public IBarometer {
+    public:
+        DroneCANBarometer() noexcept;
+
+        // StaticPressure carries no temperature, the latest StaticTemperature is paired with it
+        void publishStaticPressure(const uavcan_equipment_air_data_StaticPressure &msg) noexcept;
+        void publishStaticTemperature(const uavcan_equipment_air_data_StaticTemperature &msg) noexcept;
+
+        // True if a pressure sample arrived since the last call, data holds the latest sample either way
+        bool readData(BaroData_t &data) override;
+
+    private:
+        DroneCANSensorSlot<BaroData_t> sample;
+        float staticTemperatureC;   // Bus task only
+};
+
+class DroneCANMagnetometer : public IMagnetometer {
+    public:
+        DroneCANMagnetometer() noexcept;
+
+        // A node with several compasses reports each under its own sensor_id, only the first one seen is used
+        void publishMagneticField(const uavcan_equipment_ahrs_MagneticFieldStrength2 &msg) noexcept;
+
+        bool readData(MagData_t &data) override;
+
+        // Forget the compass in use, the next sensor_id seen takes over
+        void resetSource() noexcept { sensorId = -1; }
+
+    private:
+        DroneCANSensorSlot<MagData_t> field;
+        int16_t sensorId;           // Bus task only
+};
+
+class DroneCANAirspeed : public IAirspeed {
+    public:
+        void publishRawAirData(const uavcan_equipment_air_data_RawAirData &msg) noexcept;
+
+        bool readData(AirspeedData_t &data) override;
+
+    private:
+        DroneCANSensorSlot<AirspeedData_t> sample;
+};
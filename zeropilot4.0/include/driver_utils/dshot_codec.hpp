@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+
+static constexpr uint8_t DSHOT_FRAME_BITS = 16;                     // 11 bits value + 1 bit telemetry request + 4 bits CRC
+static constexpr uint8_t DSHOT_FRAME_SLOTS = DSHOT_FRAME_BITS + 1;  // Extra idle slot to hold the line after the frame
+static constexpr uint16_t DSHOT_VALUE_MAX = 2047;
+static constexpr uint16_t DSHOT_THROTTLE_MIN = 48;                  // 0-47 reserved for special commands
+
+// Bidirectional reply, 16 bits GCR encoded to 20 bits and sent as transitions after a start bit
+static constexpr uint8_t DSHOT_TELEM_LINE_BITS = 21;
+static constexpr uint8_t DSHOT_TELEM_MAX_EDGES = DSHOT_TELEM_LINE_BITS + 1;
+static constexpr uint16_t DSHOT_TELEM_STOPPED = 0x0FFF;             // Period code for a stopped motor
+
+static constexpr uint16_t DSHOT_MIN_PERIOD_TICKS = 20;              // Below this 0 and 1 bits are too close to tell apart
+
+// Bit timing in timer ticks for one DShot rate
+typedef struct {
+    uint16_t period;        // Ticks per bit, ARR is one less
+    uint16_t oneCompare;    // High time of a 1, 3/4 of the bit
+    uint16_t zeroCompare;   // High time of a 0, 3/8 of the bit
+    uint16_t replyBitTicks; // Bidirectional reply bit, sent at 5/4 the rate
+} DshotTiming_t;
+
+/*
+ * Platform independent DShot frame encoding and bidirectional eRPM reply decoding.
+ * Boards turn frames into timer compare values for DMA and hand back the input capture
+ * timestamps of the reply, all bit timing is passed in as timer ticks.
+ */
+class DshotCodec {
+    public:
+        // 16 bit frame, bidirectional frames carry an inverted CRC so the ESC knows to reply
+        static uint16_t encodeFrame(uint16_t value, bool telemetryRequest, bool bidirectional) noexcept;
+
+        // Timing for DShot150/300/600/1200 from the timer input clock, false for other rates or
+        // when the timer is too slow or too fast for a 16 bit period
+        static bool timingForRate(uint32_t timerClockHz, uint16_t rateKbps, DshotTiming_t &timing) noexcept;
+
+        // Integer scaling of num/den into the throttle range starting at minValue, num is clamped to den.
+        // 16 bit inputs keep the product in 32 bits so there is no 64 bit divide on the MCU
+        static uint16_t scaleThrottle(uint16_t num, uint16_t den, uint16_t minValue) noexcept;
+
+        // One compare value per bit, MSB first, followed by an idle slot. Stride interleaves
+        // several channels into one burst buffer, out must hold DSHOT_FRAME_SLOTS * stride entries
+        static void frameToCompare(uint16_t frame, uint16_t oneCompare, uint16_t zeroCompare, uint16_t *out, uint8_t stride = 1) noexcept;
+
+        // Reply from the input capture timestamps of every edge, bitTicks is one reply bit (5/4 of the
+        // DShot bitrate). Returns false on a malformed reply or a bad CRC, periodCode is the 12 bit eeem mmmm mmmm
+        static bool decodeEdges(const uint16_t *edges, uint8_t count, uint16_t bitTicks, uint16_t &periodCode) noexcept;
+
+        // 21 line bits, MSB is the start bit
+        static bool decodeLine(uint32_t line, uint16_t &periodCode) noexcept;
+
+        // Electrical RPM from a period code, 0 for a stopped motor
+        static uint32_t periodCodeToErpm(uint16_t periodCode) noexcept;
+
+        // ESC side of the reply, used by tests and the simulator
+        static uint16_t erpmToPeriodCode(uint32_t erpm) noexcept;
+        static uint32_t encodeLine(uint16_t periodCode) noexcept;
+
+    private:
+        static uint8_t frameCrc(uint16_t data12) noexcept;
+};
+
+/*
+ * Nibble to compare value lookup for one bit timing, expands a frame four bits at a time.
+ * Built once at init, output matches DshotCodec::frameToCompare.
+ */
+class DshotCompareTable {
+    public:
+        void build(uint16_t oneCompare, uint16_t zeroCompare) noexcept;
+
+        void frameToCompare(uint16_t frame, uint16_t *out, uint8_t stride = 1) const noexcept;
+
+    private:
+        uint16_t nibbles_[16][4] = {};
+};
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include "gps_iface.hpp"
+
+typedef struct {
+    uint32_t framesOk;          // UBX frames and NMEA sentences with a valid checksum
+    uint32_t crcErrors;
+    uint32_t droppedFrames;     // Truncated, oversized or interrupted frames
+    uint32_t droppedBytes;      // Noise between frames
+} GpsParserStats_t;
+
+/*
+ * Byte-at-a-time UBX (NAV-PVT, NAV-VELECEF) and NMEA (RMC, GGA) parser.
+ * Fields are decoded as the bytes stream in, so frames may be split across any number
+ * of feed() calls and no frame is ever buffered. Decoded values are only committed once
+ * the frame checksum passes. Any unexpected byte drops the current frame and the parser
+ * resynchronizes on the next sync char.
+ */
+class GpsStreamParser {
+    public:
+        GpsStreamParser() noexcept;
+
+        void feed(const uint8_t *data, uint16_t len) noexcept;
+        void feedByte(uint8_t byte) noexcept;
+
+        // Latest solution, isNew is set only on the first call after a frame updated it
+        GpsData_t takeData() noexcept;
+
+        const GpsParserStats_t &getStats() const noexcept { return stats; }
+
+        void reset() noexcept;
+
+        // Drop the frame in progress after a gap in the stream, keeps the stats and last solution
+        void resync() noexcept;
+
+        // Fletcher checksum over class, ID, length and payload
+        static void ubxChecksum(const uint8_t *data, uint16_t len, uint8_t &ckA, uint8_t &ckB) noexcept;
+
+        // Build a complete UBX frame into out, returns the frame length or 0 if out is too small
+        static uint16_t encodeUBX(uint8_t msgClass, uint8_t msgId, const uint8_t *payload, uint16_t payloadLen, uint8_t *out, uint16_t outSize) noexcept;
+
+        static constexpr uint16_t UBX_MAX_PAYLOAD_LEN = 1024;
+        static constexpr uint8_t NMEA_MAX_SENTENCE_LEN = 82;
+
+    private:
+        enum class State_e : uint8_t {
+            IDLE,
+            UBX_SYNC_2,
+            UBX_CLASS,
+            UBX_ID,
+            UBX_LEN_1,
+            UBX_LEN_2,
+            UBX_PAYLOAD,
+            UBX_CK_A,
+            UBX_CK_B,
+            NMEA_BODY,
+            NMEA_CK_1,
+            NMEA_CK_2
+        };
+
+        enum class UbxMsg_e : uint8_t {
+            OTHER,
+            PVT,
+            VELECEF
+        };
+
+        enum class NmeaMsg_e : uint8_t {
+            OTHER,
+            RMC,
+            GGA
+        };
+
+        // Little endian payload field, decoded into rawField[slot] as it streams in
+        typedef struct {
+            uint8_t offset;
+            uint8_t size;
+            uint8_t slot;
+        } UbxField_t;
+
+        // Numeric NMEA field accumulated digit by digit
+        typedef struct {
+            uint32_t intPart;
+            uint32_t fracPart;
+            uint32_t fracDiv;
+            uint8_t len;
+            char first;
+            bool negative;
+            bool seenDot;
+        } NmeaField_t;
+
+        static constexpr uint8_t MAX_UBX_FIELDS = 24;
+        static const UbxField_t PVT_FIELDS[];
+        static const UbxField_t VELECEF_FIELDS[];
+
+        State_e state;
+        GpsParserStats_t stats;
+
+        GpsData_t data;
+        bool newData;
+
+        // UBX frame state
+        uint8_t ubxClass;
+        uint8_t ubxId;
+        uint16_t ubxLen;
+        uint16_t ubxOffset;
+        uint8_t ckA;
+        uint8_t ckB;
+        UbxMsg_e ubxMsg;
+        const UbxField_t *ubxFields;
+        uint8_t ubxFieldCount;
+        uint8_t ubxFieldIdx;
+        uint32_t rawField[MAX_UBX_FIELDS];
+
+        // NMEA sentence state
+        uint8_t nmeaLen;
+        uint8_t nmeaChecksum;
+        uint8_t nmeaReceivedChecksum;
+        uint8_t nmeaFieldIdx;
+        NmeaMsg_e nmeaMsg;
+        char nmeaType[3];
+        NmeaField_t field;
+        GpsData_t pending;
+        bool pendingValid;
+
+        void startUBX() noexcept;
+        void ubxHeaderDone() noexcept;
+        void ubxPayloadByte(uint8_t byte) noexcept;
+        void ubxCommit() noexcept;
+        void commitPVT() noexcept;
+        void commitVELECEF() noexcept;
+
+        void startNMEA() noexcept;
+        void nmeaBodyByte(uint8_t byte) noexcept;
+        void nmeaFieldDone() noexcept;
+        void nmeaCommit() noexcept;
+        void resetField() noexcept;
+        float fieldValue() const noexcept;
+        float fieldDegrees() const noexcept;
+        uint32_t fieldTimeOfDayMs() const noexcept;
+
+        void dropFrame() noexcept;
+};
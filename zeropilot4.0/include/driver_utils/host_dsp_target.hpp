@@ -0,0 +1,18 @@
+#pragma once
+
+/*
+ * Runtime ISA dispatch for the host DSP kernels. With GCC or Clang on x86-64 Linux each marked
+ * function is compiled for AVX2, SSE4.2 and baseline x86-64 and an ifunc resolver picks one when
+ * the binary loads, so the same SITL module or test binary runs on any x86-64 machine.
+ * Elsewhere, or with ZP_HOST_DSP_NO_DISPATCH defined, the kernels build once for the target flags.
+ * The loops rely on the -O3 vectorizer, GCC's -O2 cost model leaves loops of unknown length scalar.
+ */
+#if defined(__x86_64__) && defined(__linux__) && defined(__has_attribute) && !defined(ZP_HOST_DSP_NO_DISPATCH)
+#if __has_attribute(target_clones)
+#define HOST_DSP_KERNEL __attribute__((target_clones("avx2", "sse4.2", "default")))
+#endif
+#endif
+
+#ifndef HOST_DSP_KERNEL
+#define HOST_DSP_KERNEL
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "fft_iface.hpp"
+#include <vector>
+
+/*
+ * Real FFT for host builds, a drop-in for the CMSIS-DSP arm_rfft_fast_f32 driver.
+ * Takes the same power of two lengths from 32 to 4096 and uses the same packed spectrum layout:
+ * out[0] = DC, out[1] = Nyquist, then re/im pairs for bins 1 to N/2 - 1. The inverse
+ * (direction 1) takes that layout back to N samples and is scaled so a round trip returns the input.
+ *
+ * The N real samples are transformed as an N/2 point complex FFT followed by a split pass. The
+ * complex FFT runs radix-2 stages over separate real and imaginary arrays, with each stage's
+ * twiddles stored contiguously, so every butterfly loop is unit stride and vectorizes.
+ * init() allocates the tables and work arrays, runFFT() never allocates.
+ */
+class HostFFT : public IFFT {
+    public:
+        static constexpr uint16_t MIN_LENGTH = 32;
+        static constexpr uint16_t MAX_LENGTH = 4096;
+
+        HostFFT() : length(0) {}
+
+        // false for lengths CMSIS would reject, the previous setup is kept
+        bool init(uint16_t fftLen) override;
+
+        // Direction 0 is forward, 1 is inverse. in is left untouched, unlike CMSIS which uses it as scratch
+        void runFFT(float *in, float *out, uint8_t dir) override;
+
+        void complexMag(const float *in, float *out, uint32_t n) override;
+
+    private:
+        uint16_t length;
+
+        std::vector<uint16_t> bitReverse;   // N/2 point complex FFT input permutation
+        std::vector<float> stageCos;        // Twiddles for every stage back to back, N/2 - 1 of each
+        std::vector<float> stageSin;
+        std::vector<float> splitCos;        // e^(-2 pi i k / N) for k = 0 .. N/4
+        std::vector<float> splitSin;
+        std::vector<float> workRe;
+        std::vector<float> workIm;
+
+        void complexForward();
+        void forward(const float *in, float *out);
+        void inverse(const float *in, float *out);
+};
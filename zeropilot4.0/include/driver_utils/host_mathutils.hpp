@@ -0,0 +1,49 @@
+#pragma once
+
+#include "mathutils_iface.hpp"
+
+/*
+ * IMathUtils for host builds (SITL, log replay, tests) in place of the CMSIS-DSP board driver.
+ * The 3x3, 4x4 and row vector shapes the EKF and Mahony filters use go through fixed-size
+ * kernels the compiler unrolls, everything else through contiguous inner loops it can vectorize.
+ * On x86-64 Linux those loops are built for AVX2, SSE4.2 and baseline x86-64, and the loader
+ * picks the best one the CPU supports at startup.
+ * Results match the CMSIS-DSP functions to float rounding, except dspSinf/dspCosf which use the
+ * C library instead of the CMSIS table interpolation.
+ */
+class HostMathUtils : public IMathUtils {
+    public:
+        float dspSinf(float x) override;
+        float dspCosf(float x) override;
+
+        float vectorNorm(const float* src, uint16_t dim) override;
+        bool vectorNormalize(const float* src, float* dst, uint16_t dim) override;
+
+        bool matrixAdd(const float* srcA, const float* srcB, float* dst, uint16_t rows, uint16_t cols) override;
+        bool matrixSub(const float* srcA, const float* srcB, float* dst, uint16_t rows, uint16_t cols) override;
+        bool matrixMult(const float* srcA, uint16_t rowsA, uint16_t colsA,
+                        const float* srcB, uint16_t colsB, float* dst) override;
+        bool matrixTranspose(const float* src, uint16_t rows, uint16_t cols, float* dst) override;
+        bool matrixScale(const float* src, float scale, float* dst, uint16_t rows, uint16_t cols) override;
+        bool matrixInverse(const float* src, uint16_t dim, float* dst) override; // false when singular
+        void skewSymmetric(const float* v3, float* dst3x3) override;
+        bool ensureSymmetric(float* m, uint16_t dim) override;
+
+        void quatMultiply(const float* q1, const float* q2, float* qOut) override;
+        void quatInverse(const float* q, float* qOut) override;
+        void quatNormalize(const float* q, float* qOut) override;
+
+        void quatAverage(const float* q1, const float* q2, float* qOut) override;
+        void quatExponential(const float* rotVec3, float* qOut) override;
+        float quatAngularDistanceDeg(const float* qTrue, const float* qEst) override;
+
+        void quatToRotationMatrix(const float* q, float* mat3x3) override;
+        void quatToRotationMatrixInverse(const float* q, float* mat3x3) override;
+        void quatRotateVector(const float* q, const float* v3, float* vOut3) override;
+
+        void quatToEuler(const float* q, float* euler3) override;
+
+    private:
+        // Largest matrixInverse dimension worked on the stack, bigger ones allocate
+        static constexpr uint16_t INVERSE_STACK_DIM = 16;
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+/*
+ * Tightly coupled memory placement for the control hot path. On boards built with ZP_TCM_PLACEMENT
+ * the linker script collects these sections into the Cortex-M7 ITCM and DTCM, which run at core
+ * clock with no wait states and sit outside the caches, and the startup code copies them from flash.
+ *
+ *   ZP_FAST_CODE  function runs from ITCM
+ *   ZP_FAST_DATA  initialized object in DTCM
+ *   ZP_FAST_BSS   object in DTCM zeroed at startup, any initializer is dropped
+ *
+ * The general purpose DMA controllers can't reach DTCM, never mark a DMA buffer or an object that
+ * holds one. Host builds and boards without TCM get empty macros.
+ */
+#if defined(ZP_TCM_PLACEMENT)
+#define ZP_FAST_CODE __attribute__((section(".itcm_text")))
+#define ZP_FAST_DATA __attribute__((section(".dtcm_data")))
+#define ZP_FAST_BSS __attribute__((section(".dtcm_bss")))
+#else
+#define ZP_FAST_CODE
+#define ZP_FAST_DATA
+#define ZP_FAST_BSS
+#endif
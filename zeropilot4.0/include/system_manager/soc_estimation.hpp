@@ -3,6 +3,7 @@
 #include <cstdint>
 #include "power_module_iface.hpp"
 #include "mavlink.h"
+#include "zp_params.hpp"
 
 #define SOC_IDLE_MODE 0
 #define SOC_CHARGE_DISCHARGE_MODE 1
@@ -54,12 +55,13 @@ constexpr size_t SOC_LUT_SIZE = sizeof(SOC_LUT) / sizeof(SOC_LUT[0]);
 
 class SocEstimator {
     public:
-        SocEstimator(BatteryData_t batteryData);
+        SocEstimator(BatteryData_t batteryData, const ParamRegistry *params);
         uint8_t getSocPercentage();
         int32_t getTimeRemaining();
         void calcStateOfCharge(BatteryData_t batteryData, int mode);
 
     private:
+        const ParamRegistry *params;
         StateOfCharge_t socData;
         float initialSocPercentage = -1.0f;
 };
@@ -13,6 +13,11 @@
 #include "power_module_iface.hpp"
 #include "sm_param_setup.hpp"
 #include "soc_estimation.hpp"
+#include "latest_value_slot.hpp"
+#include "battery_voltage.hpp"
+#include "sysid_log.hpp"
+#include "can_bus_stats.hpp"
+#include "zp_params.hpp"
 
 #define SM_SCHEDULING_RATE_HZ 20
 #define SM_TELEMETRY_HEARTBEAT_RATE_HZ 1
@@ -21,6 +26,9 @@
 
 #define SM_UPDATE_LOOP_DELAY_MS (1000 / SM_SCHEDULING_RATE_HZ)
 
+// Bus voltage low-pass cutoff for motor voltage compensation, slow enough to ride through throttle transients
+static constexpr float SM_BATT_VOLT_FILTER_HZ = 0.5f;
+
 // RC Arm threshold
 static constexpr float SM_RC_ARM_THRESHOLD = 50.0f;
 
@@ -38,6 +46,10 @@ static constexpr float SM_FLIGHTMODE5_MAX = 75.0f; // (1685 + 1815) / 2 = 1750 -
 static constexpr uint32_t SM_SAFETY_SWITCH_HOLD_THRESHOLD_MS = 2000;
 static constexpr uint32_t SM_SAFETY_SWITCH_BLINK_RATE_HZ = 2;
 static constexpr uint32_t SM_SAFETY_SWITCH_PREARM_MSG_INTERVAL_S = 10; // Send safety switch prearm message every 10 seconds
+
+// SYSID blocks written per cycle, 20 blocks/s at a 1 kHz AM leaves room for faster loop rates
+static constexpr int SM_SYSID_LOG_BLOCKS_PER_WRITE = 4;
+
 class SystemManager {
     friend class SMParamSetup;
 
@@ -51,7 +63,11 @@ class SystemManager {
             IPowerModule *pmDriver,
             IMessageQueue<RCMotorControlMessage_t> *amRCQueue,
             IMessageQueue<TMMessage_t> *tmQueue,
-            IMessageQueue<char[100]> *smLoggerQueue
+            IMessageQueue<char[100]> *smLoggerQueue,
+            LatestValueSlot<BatteryVoltage_t> *batteryVoltage = nullptr,
+            IMessageQueue<SysIdLogBlock_t> *sysIdLogQueue = nullptr,
+            LatestValueSlot<CANBusStats_t> *canBusStats = nullptr,
+            ParamRegistry *params = nullptr // Falls back to the firmware registry
         );
 
         void smUpdate(); // This function is the main function of SM, it should be called in the main loop of the system.
@@ -68,6 +84,11 @@ class SystemManager {
         IMessageQueue<RCMotorControlMessage_t> *amRCQueue; // Queue driver for tx communication to the Attitude Manager
         IMessageQueue<TMMessage_t> *tmQueue; // Queue driver for tx communication to the Telemetry Manager
         IMessageQueue<char[100]> *smLoggerQueue; // Queue driver for rx communication from other modules to the System Manager for logging
+        LatestValueSlot<BatteryVoltage_t> *batteryVoltage; // Filtered bus voltage for the Attitude Manager output stage
+        IMessageQueue<SysIdLogBlock_t> *sysIdLogQueue; // Queue driver for rx of raw SYSID samples from the Attitude Manager for the binary log
+        LatestValueSlot<CANBusStats_t> *canBusStats; // DroneCAN bus counters from the CAN controller
+        ParamRegistry *params; // This vehicle's parameters
+        const uint32_t amBudgetUs; // AM loop period, SCHED_LOOP_RATE only takes effect on reboot
 
         uint8_t smSchedulingCounter;
 
@@ -86,6 +107,9 @@ class SystemManager {
         
         BatteryData_t batteryData;
         bool updateBatteryFSM();
+        float filteredBusVoltage;
+        bool haveFilteredBusVoltage;
+        void publishFilteredBusVoltage(float busVoltage);
         SocEstimator socEstimator;
 
         void sendRCDataToAttitudeManager(const RCControl &rcData);
@@ -93,10 +117,21 @@ class SystemManager {
         void sendHeartbeatDataToTelemetryManager(uint8_t baseMode, uint32_t customMode, MAV_STATE systemStatus);
         void sendBatteryDataToTelemetryManager(const BatteryData_t &batteryData, const uint8_t batteryId);
         void sendStatusTextToTelemetryManager(MAV_SEVERITY severity, const char text[50], uint16_t id = 0, uint8_t chunk_seq = 0);
+        void sendTelemetryToRCReceiver(FlightMode_e flightMode, bool armed);
 
         FlightMode_e decodeRawFlightMode(float flightModeRawValue);
+        static const char *flightModeName(FlightMode_e flightMode);
 
         void sendMessagesToLogger();
+        void sendSysIdBlocksToLogger();
+
+        char loggerMessages[16][100];
+        SysIdLogBlock_t sysIdLogBlocks[SM_SYSID_LOG_BLOCKS_PER_WRITE];
+
+        uint32_t canBusStatsSeq;
+        CANBusStats_t lastCanBusStats;
+        bool haveCanBusStats;
+        void checkCanBusStats(); // Warn over telemetry when the CAN controller starts dropping frames
 
         uint8_t profilerId;
 
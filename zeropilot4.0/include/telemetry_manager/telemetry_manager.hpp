@@ -20,6 +20,7 @@
 #include "rc_motor_control.hpp"
 #include "telemlink_iface.hpp"
 #include "tm_param_setup.hpp"
+#include "zp_params.hpp"
 class TelemetryManager {
     friend class TMParamSetup;
 
@@ -29,7 +30,11 @@ class TelemetryManager {
     IMessageQueue<TMMessage_t> *tmTXQueueDriver;            // Driver that receives messages from other managers
     IMessageQueue<RCMotorControlMessage_t> *amQueueDriver;   // Driver that currently is only used to set arm/disarm
     IMessageQueue<mavlink_message_t> *packedMsgBuffer{};    // GPOS, Attitude and Heartbeat/Connection Messages
+    ParamRegistry *params;                                  // This vehicle's parameters, served over PARAM_* messages
+    mavlink_message_t rxParseBuffer;                        // Frame being parsed, kept here instead of MAVLink's per channel static
+    mavlink_status_t rxParseStatus;
     mavlink_status_t status;
+    mavlink_status_t txStatus;                              // Sequence numbers for packing, kept here instead of MAVLINK_COMM_0's static
     mavlink_message_t overflowBuf;
     bool overflowMsgPending;
 
@@ -48,7 +53,8 @@ class TelemetryManager {
     uint8_t profilerId;
     
   public:
-    TelemetryManager(ISystemUtils *systemUtilsDriver, ITelemLink *telemLinkDriver, IMessageQueue<TMMessage_t>  *tmTXQueueDriver,  IMessageQueue<RCMotorControlMessage_t> *amQueueDriver,IMessageQueue<mavlink_message_t> *packedMsgBuffer);
+    TelemetryManager(ISystemUtils *systemUtilsDriver, ITelemLink *telemLinkDriver, IMessageQueue<TMMessage_t>  *tmTXQueueDriver,  IMessageQueue<RCMotorControlMessage_t> *amQueueDriver,IMessageQueue<mavlink_message_t> *packedMsgBuffer,
+        ParamRegistry *params = nullptr); // Falls back to the firmware registry
     ~TelemetryManager();
 
     void tmUpdate();
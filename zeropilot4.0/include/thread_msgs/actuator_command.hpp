@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+
+static constexpr uint8_t ACTUATOR_COMMAND_MAX_ESCS = 8;
+static constexpr uint8_t ACTUATOR_COMMAND_MAX_SERVOS = 8;
+static constexpr int16_t ESC_RAW_COMMAND_FULL_SCALE = 8191;
+
+// One AM tick worth of DroneCAN outputs, handed to the bus task which owns libcanard
+typedef struct {
+    uint8_t escCount;                                       // RawCommand length, ESC index i is escRaw[i]
+    int16_t escRaw[ACTUATOR_COMMAND_MAX_ESCS];              // 0 stops the ESC, up to ESC_RAW_COMMAND_FULL_SCALE
+    uint8_t servoCount;
+    uint8_t servoId[ACTUATOR_COMMAND_MAX_SERVOS];           // actuator_id on the bus
+    float servoCommand[ACTUATOR_COMMAND_MAX_SERVOS];        // Unitless, -1 to 1
+} ActuatorCommand_t;
@@ -0,0 +1,6 @@
+#pragma once
+
+// Low-pass filtered bus voltage, published by the system manager for the multirotor output stage
+typedef struct {
+    float filteredVoltage; // V
+} BatteryVoltage_t;
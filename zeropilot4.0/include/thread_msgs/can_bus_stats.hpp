@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+
+// DroneCAN bus health, published by the CAN controller once a second. Counters run from boot.
+typedef struct {
+    uint32_t rxFrames;          // Frames handed to libcanard
+    uint32_t txFrames;          // Frames accepted by the controller TX FIFO
+    uint32_t rxRingOverruns;    // Frames dropped by the ISR because the bus task fell behind
+    uint32_t rxFifoOverruns;    // Frames lost in the hardware RX FIFO before the ISR read them
+    uint32_t rxPoolExhausted;   // Transfers dropped because the libcanard pool was full
+    uint32_t txQueueFull;       // Transfers not queued because the libcanard pool was full
+    uint32_t busOffEvents;
+    uint16_t rxRingPeak;        // Deepest the RX ring has been
+    uint16_t poolPeakBlocks;
+    uint16_t poolCapacityBlocks;
+} CANBusStats_t;
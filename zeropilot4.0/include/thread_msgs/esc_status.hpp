@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include "latest_value_slot.hpp"
+
+static constexpr uint8_t ESC_STATUS_MAX_ESCS = 8;
+
+// Latest uavcan.equipment.esc.Status of one ESC, as reported
+typedef struct {
+    uint32_t timestampMs;       // Bus task time the status arrived
+    uint32_t errorCount;
+    float voltage;              // V
+    float current;              // A
+    float temperature;          // K
+    int32_t rpm;                // Mechanical, negative when spinning in reverse
+    uint8_t powerRatingPct;
+} EscStatus_t;
+
+/*
+ * Per-ESC status written by the bus task and read by any task, one sequence lock per ESC so a
+ * reader of one ESC never waits on an update to another.
+ */
+class EscStatusTable {
+    public:
+        void publish(uint8_t escIndex, const EscStatus_t &status) noexcept {
+            if (escIndex < ESC_STATUS_MAX_ESCS) {
+                slots[escIndex].publish(status);
+            }
+        }
+
+        // Copy the status of escIndex if it changed since lastSeq, updating lastSeq
+        bool readIfNew(uint8_t escIndex, EscStatus_t &out, uint32_t &lastSeq) const noexcept {
+            if (escIndex >= ESC_STATUS_MAX_ESCS) return false;
+            return slots[escIndex].readIfNew(out, lastSeq);
+        }
+
+    private:
+        LatestValueSlot<EscStatus_t> slots[ESC_STATUS_MAX_ESCS];
+};
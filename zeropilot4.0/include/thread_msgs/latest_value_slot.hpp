@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/*
+ * Single producer, latest-value slot built on a sequence lock.
+ * The producer (task or ISR) never blocks. A reader that overlaps a write either retries,
+ * if the write landed mid-copy, or reports nothing new, if it preempted the writer mid-write.
+ * Intermediate values are overwritten, readers only ever see the newest complete one.
+ * T must be trivially copyable.
+ */
+template <typename T>
+class LatestValueSlot {
+    public:
+        LatestValueSlot() noexcept : sequence(0), value{} {}
+
+        void publish(const T &newValue) noexcept {
+            uint32_t seq = sequence.load(std::memory_order_relaxed);
+            sequence.store(seq + 1, std::memory_order_relaxed); // Odd while the value is being written
+            std::atomic_thread_fence(std::memory_order_release);
+            value = newValue;
+            sequence.store(seq + 2, std::memory_order_release);
+        }
+
+        // Copy the value if one was published since lastSeq, updating lastSeq
+        bool readIfNew(T &out, uint32_t &lastSeq) const noexcept {
+            for (uint8_t attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+                uint32_t before = sequence.load(std::memory_order_acquire);
+                if (before == lastSeq || (before & 1u)) return false;
+
+                T copy = value;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence.load(std::memory_order_relaxed) == before) {
+                    out = copy;
+                    lastSeq = before;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Number of values published so far
+        uint32_t getPublishCount() const noexcept { return sequence.load(std::memory_order_acquire) / 2; }
+
+    private:
+        static constexpr uint8_t MAX_READ_ATTEMPTS = 4;
+
+        std::atomic<uint32_t> sequence;
+        T value;
+};
@@ -5,11 +5,14 @@
 enum class FlightMode_e : uint32_t {
     #ifdef PLANE
     MANUAL  = 0,
-    FBWA    = 5
+    FBWA    = 5,
+    SYSID   = 27  // ArduPlane has no SYSID mode, first number it leaves free
     #endif
     #ifdef QUADCOPTER
     STABILIZE = 0,
-    ACRO = 1
+    ACRO = 1,
+    AUTOTUNE = 15,
+    SYSID = 25
     #endif
 };
 
@@ -18,10 +21,13 @@ inline bool isValidFlightMode(uint32_t val) {
         #ifdef PLANE
         case FlightMode_e::MANUAL:
         case FlightMode_e::FBWA:
+        case FlightMode_e::SYSID:
         #endif
         #ifdef QUADCOPTER
         case FlightMode_e::ACRO:
         case FlightMode_e::STABILIZE:
+        case FlightMode_e::AUTOTUNE:
+        case FlightMode_e::SYSID:
         #endif
             return true;
         default:
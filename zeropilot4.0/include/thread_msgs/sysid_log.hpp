@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+
+#define SYSID_LOG_BLOCK_SAMPLES 50
+#define SYSID_LOG_SYNC 0x5153 // "SQ" little endian, lets the host tool resync inside a damaged file
+
+// Raw SYSID samples from the attitude manager, written to the binary log verbatim by the system manager.
+// Every field is 4 byte aligned so the struct has no padding and the file layout is the struct layout.
+typedef struct {
+    uint16_t sync;          // SYSID_LOG_SYNC
+    uint8_t axis;           // SID_AXIS the samples were taken with
+    uint8_t count;          // Valid samples, SYSID_LOG_BLOCK_SAMPLES except for the last block of a run
+    uint32_t seq;           // Block number within the run, 0 starts a new run
+    float sampleRateHz;
+    float startTimeS;       // Chirp time of the first sample
+    float injected[SYSID_LOG_BLOCK_SAMPLES];    // Fraction of the injection point's full scale
+    float measured[SYSID_LOG_BLOCK_SAMPLES];    // rad for attitude injection on roll and pitch, rad/s otherwise
+} SysIdLogBlock_t;
@@ -114,6 +114,15 @@ enum class ZP_PARAM_ID : uint16_t { // NOLINT
     ATC_RAT_YAW_D,
     ATC_RAT_YAW_TAU,
     ATC_RAT_YAW_IMAX,
+    ATC_RAT_RLL_FF,
+    ATC_RAT_RLL_FLTD,
+    ATC_RAT_PIT_FF,
+    ATC_RAT_PIT_FLTD,
+    ATC_RAT_YAW_FF,
+    ATC_RAT_YAW_FLTD,
+    ATC_RAT_P_WGT,
+    ATC_RAT_D_WGT,
+    ATC_RAT_AWU,
     ACRO_RP_RATE,
     ACRO_Y_RATE,
     ATC_ANG_RLL_P,
@@ -130,6 +139,13 @@ enum class ZP_PARAM_ID : uint16_t { // NOLINT
     MOT_SPIN_MIN,
     MOT_SPIN_MAX,
     MOT_SPIN_ARM,
+    FRAME_CLASS,
+    FRAME_TYPE,
+    MOT_THST_EXPO,
+    MOT_BAT_VOLT_MAX,
+    MOT_BAT_VOLT_MIN,
+    AUTOTUNE_AXES,
+    AUTOTUNE_TC,
     #endif
     FLTMODE1,
     FLTMODE2,
@@ -153,13 +169,71 @@ enum class ZP_PARAM_ID : uint16_t { // NOLINT
     INS_HNTCH_BW,
     INS_HNTCH_ATT,
     INS_HNTCH_HMNCS,
+    SCHED_LOOP_RATE,
+    INS_GYRO_RATE,
+    INS_DECIM_TYPE,
     RNGFND_ENABLE,
     RNGFND_MIN,
     RNGFND_MAX,
+    GPS_RATE_MS,
+    GPS_TYPE,
+    BARO_PRIMARY,
+    RC_FS_LQ,
+    INS_HNTCH_MODE,
+    SERVO_BLH_POLES,
+    SERVO_BLH_BDMASK,
+    CAN_D1_UC_ESC_BM,
+    CAN_D1_UC_SRV_BM,
+    SID_AXIS,
+    SID_MAGNITUDE,
+    SID_F_START_HZ,
+    SID_F_STOP_HZ,
+    SID_T_REC,
+    SID_T_FADE_IN,
+    SID_T_FADE_OUT,
     PARAM_COUNT
 };
 
+// One vehicle's parameter table. Firmware uses the single registry behind the ZP_PARAM functions,
+// a simulator running several vehicles in one process gives each its own and hands it to the managers.
+class ParamRegistry {
+    public:
+        ParamRegistry(); // Loaded with the defaults
+
+        // Restore the defaults and drop all callbacks
+        void init();
+
+        // Bind a callback to a specific parameter
+        void bindCallbackInternal(ZP_PARAM_ID id, void* context, ParamSetterCb_t setter);
+
+        // Templated wrapper for bindCallbackInternal
+        template <typename T>
+        void bindCallback(ZP_PARAM_ID id, T* context, bool (*setter)(T*, float)) {
+            bindCallbackInternal(id, static_cast<void*>(context), reinterpret_cast<ParamSetterCb_t>(setter));
+        }
+
+        // Get current config value
+        float get(ZP_PARAM_ID id) const;
+
+        // MAVLink/Telemetry interaction
+        bool setParamById(const char* paramId, float new_value);
+
+        // Accessors
+        Param_t* getParamByIndex(uint16_t index);
+        int16_t getIndexById(const char* paramId) const;
+        static uint16_t getCount();
+
+    private:
+        Param_t params[static_cast<uint16_t>(ZP_PARAM_ID::PARAM_COUNT)];
+
+        void initParam(ZP_PARAM_ID id, const char* name, float default_val, uint8_t type);
+};
+
+// Firmware facade over the process wide registry
 namespace ZP_PARAM {
+    // The process wide registry, managers fall back to it when not given their own
+    ParamRegistry& registry();
+
     // Initialize the registry (call once during system boot)
     void init();
 
@@ -169,7 +243,7 @@ namespace ZP_PARAM {
     // Templated wrapper for bindCallbackInternal
     template <typename T>
     void bindCallback(ZP_PARAM_ID id, T* context, bool (*setter)(T*, float)) {
-        bindCallbackInternal(id, static_cast<void*>(context), reinterpret_cast<ParamSetterCb_t>(setter));
+        registry().bindCallback(id, context, setter);
     }
 
     // Get current config value
@@ -22,6 +22,7 @@
 // Header files
 
 #include "MahonyAHRS.hpp"
+#include "tcm_placement.hpp"
 #include <math.h>
 
 //-------------------------------------------------------------------------------------------
@@ -55,7 +56,7 @@ Mahony::Mahony()
 //-------------------------------------------------------------------------------------------
 // IMU algorithm update
 
-void Mahony::updateIMU(float gx, float gy, float gz, float ax, float ay, float az, float dt)
+ZP_FAST_CODE void Mahony::updateIMU(float gx, float gy, float gz, float ax, float ay, float az, float dt)
 {
 	float recipNorm;
 	float halfvx, halfvy, halfvz;
@@ -131,7 +132,7 @@ void Mahony::updateIMU(float gx, float gy, float gz, float ax, float ay, float a
 //-------------------------------------------------------------------------------------------
 // Fast inverse square-root
 
-float Mahony::invSqrt(float x)
+ZP_FAST_CODE float Mahony::invSqrt(float x)
 {
 	float halfx = 0.5f * x;
 	union { float f; long l; } i;
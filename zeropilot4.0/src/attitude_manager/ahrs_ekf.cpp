@@ -1,4 +1,5 @@
 #include "ahrs_ekf.hpp"
+#include "tcm_placement.hpp"
 #include <cstring>
 #include <cmath>
 #include <algorithm>
@@ -67,12 +68,12 @@ void NominalState::init(const float* quatInit) {
     std::copy(quaternionPrev, quaternionPrev + 4, quaternionNew);
 }
 
-void NominalState::stateExtrapolation(const float* gyroNew, const float* gyroPrev, float dt) {
+ZP_FAST_CODE void NominalState::stateExtrapolation(const float* gyroNew, const float* gyroPrev, float dt) {
     std::copy(quaternionNew, quaternionNew + 4, quaternionPrev);
     extrapolateQuaternion(gyroNew, gyroPrev, dt, quaternionNew);
 }
 
-void NominalState::extrapolateQuaternion(const float* gyroNewVec, const float* gyroPrevVec, float dt, float* qOut) {
+ZP_FAST_CODE void NominalState::extrapolateQuaternion(const float* gyroNewVec, const float* gyroPrevVec, float dt, float* qOut) {
     float gyroBar[3];
     for (int i = 0; i < 3; ++i) gyroBar[i] = (gyroNewVec[i] + gyroPrevVec[i]) * 0.5f;
 
@@ -109,7 +110,7 @@ void NominalState::extrapolateQuaternion(const float* gyroNewVec, const float* g
     math->quatNormalize(qUnnorm, qOut);
 }
 
-void NominalState::correctState(const float* smallAngleError) {
+ZP_FAST_CODE void NominalState::correctState(const float* smallAngleError) {
     float qErr[4] = {
         1.0f, 
         0.5f * smallAngleError[0], 
@@ -178,7 +179,7 @@ static void setBlock3x3(float* m9x9, int blockRow, int blockCol, const float* sr
     }
 }
 
-void AHRSEKF::stateExtrapolation(const float* gyroNew, float dt) {
+ZP_FAST_CODE void AHRSEKF::stateExtrapolation(const float* gyroNew, float dt) {
     meas.updateGyro(gyroNew);
     nom.stateExtrapolation(meas.gyroNew, meas.gyroPrev, dt);
     // We only calculate the non-zero parts of the 9x9 matrix thru CMSIS DSP to optimize performance, 
@@ -256,7 +257,7 @@ void AHRSEKF::stateExtrapolation(const float* gyroNew, float dt) {
     math->ensureSymmetric(p, 9);
 }
 
-void AHRSEKF::correctionAccelerometer(const float* accelNew) {
+ZP_FAST_CODE void AHRSEKF::correctionAccelerometer(const float* accelNew) {
     meas.updateAccel(accelNew);
 
     // Calculate dynamic covariance scaling
@@ -289,7 +290,7 @@ void AHRSEKF::correctionAccelerometer(const float* accelNew) {
     applyUpdate(innovation, h0, true, dynamicAccelCovMat, cfg.accelGateThreshold);
 }
 
-void AHRSEKF::correctionMagnetometer(const float* magNew) {
+ZP_FAST_CODE void AHRSEKF::correctionMagnetometer(const float* magNew) {
     float magNorm[3];
     math->vectorNormalize(magNew, magNorm, 3);
     meas.updateMag(magNorm);
@@ -319,7 +320,7 @@ H is assumed to be a 3x9 matrix of form [skew(accelPred), 0, I] and [skew(magPre
 bc we only pass in non-zero entries of each
 observesAccelBias determines which form of the two it is
 */
-void AHRSEKF::applyUpdate(const float* y, const float* h0, bool observesAccelBias,
+ZP_FAST_CODE void AHRSEKF::applyUpdate(const float* y, const float* h0, bool observesAccelBias,
                               const float* R, float gateThreshold) {
     // H = [h0, 0, H2] with H2 = I for the accelerometer (which observes the
     // accel bias states) and H2 = 0 for the magnetometer, so H @ p is a single
@@ -14,91 +14,133 @@ void AMParamSetup::loadAllParams() {
     #ifdef PLANE
     // FBWA params
     am->fbwaCLAW.setRollPIDConstants(
-        ZP_PARAM::get(ZP_PARAM_ID::RLL2SRV_P),
-        ZP_PARAM::get(ZP_PARAM_ID::RLL2SRV_I),
-        ZP_PARAM::get(ZP_PARAM_ID::RLL2SRV_D),
-        ZP_PARAM::get(ZP_PARAM_ID::RLL2SRV_TAU),
-        ZP_PARAM::get(ZP_PARAM_ID::RLL2SRV_IMAX)
+        am->params->get(ZP_PARAM_ID::RLL2SRV_P),
+        am->params->get(ZP_PARAM_ID::RLL2SRV_I),
+        am->params->get(ZP_PARAM_ID::RLL2SRV_D),
+        am->params->get(ZP_PARAM_ID::RLL2SRV_TAU),
+        am->params->get(ZP_PARAM_ID::RLL2SRV_IMAX)
     );
     am->fbwaCLAW.setPitchPIDConstants(
-        ZP_PARAM::get(ZP_PARAM_ID::PTCH2SRV_P),
-        ZP_PARAM::get(ZP_PARAM_ID::PTCH2SRV_I),
-        ZP_PARAM::get(ZP_PARAM_ID::PTCH2SRV_D),
-        ZP_PARAM::get(ZP_PARAM_ID::PTCH2SRV_TAU),
-        ZP_PARAM::get(ZP_PARAM_ID::PTCH2SRV_IMAX)
+        am->params->get(ZP_PARAM_ID::PTCH2SRV_P),
+        am->params->get(ZP_PARAM_ID::PTCH2SRV_I),
+        am->params->get(ZP_PARAM_ID::PTCH2SRV_D),
+        am->params->get(ZP_PARAM_ID::PTCH2SRV_TAU),
+        am->params->get(ZP_PARAM_ID::PTCH2SRV_IMAX)
     );
-    am->fbwaCLAW.setRollFFConstant(ZP_PARAM::get(ZP_PARAM_ID::RLL2SRV_FF));
-    am->fbwaCLAW.setPitchFFConstant(ZP_PARAM::get(ZP_PARAM_ID::PTCH2SRV_FF));
-    am->fbwaCLAW.setYawRudderMixingConstant(ZP_PARAM::get(ZP_PARAM_ID::KFF_RDDRMIX));
-    am->fbwaCLAW.setRollLimitDeg(ZP_PARAM::get(ZP_PARAM_ID::ROLL_LIMIT_DEG));
-    am->fbwaCLAW.setPitchLimitMaxDeg(ZP_PARAM::get(ZP_PARAM_ID::PTCH_LIM_MAX_DEG));
-    am->fbwaCLAW.setPitchLimitMinDeg(ZP_PARAM::get(ZP_PARAM_ID::PTCH_LIM_MIN_DEG));
+    am->fbwaCLAW.setRollFFConstant(am->params->get(ZP_PARAM_ID::RLL2SRV_FF));
+    am->fbwaCLAW.setPitchFFConstant(am->params->get(ZP_PARAM_ID::PTCH2SRV_FF));
+    am->fbwaCLAW.setYawRudderMixingConstant(am->params->get(ZP_PARAM_ID::KFF_RDDRMIX));
+    am->fbwaCLAW.setRollLimitDeg(am->params->get(ZP_PARAM_ID::ROLL_LIMIT_DEG));
+    am->fbwaCLAW.setPitchLimitMaxDeg(am->params->get(ZP_PARAM_ID::PTCH_LIM_MAX_DEG));
+    am->fbwaCLAW.setPitchLimitMinDeg(am->params->get(ZP_PARAM_ID::PTCH_LIM_MIN_DEG));
     #endif
     #ifdef QUADCOPTER
     // ACRO params
     am->acroCLAW.setRollPIDConstants(
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_RLL_P),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_RLL_I),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_RLL_D),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_RLL_TAU),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_RLL_IMAX)
+        am->params->get(ZP_PARAM_ID::ATC_RAT_RLL_P),
+        am->params->get(ZP_PARAM_ID::ATC_RAT_RLL_I),
+        am->params->get(ZP_PARAM_ID::ATC_RAT_RLL_D),
+        am->params->get(ZP_PARAM_ID::ATC_RAT_RLL_TAU),
+        am->params->get(ZP_PARAM_ID::ATC_RAT_RLL_IMAX)
     );
     am->acroCLAW.setPitchPIDConstants(
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_PIT_P),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_PIT_I),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_PIT_D),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_PIT_TAU),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_PIT_IMAX)
+        am->params->get(ZP_PARAM_ID::ATC_RAT_PIT_P),
+        am->params->get(ZP_PARAM_ID::ATC_RAT_PIT_I),
+        am->params->get(ZP_PARAM_ID::ATC_RAT_PIT_D),
+        am->params->get(ZP_PARAM_ID::ATC_RAT_PIT_TAU),
+        am->params->get(ZP_PARAM_ID::ATC_RAT_PIT_IMAX)
     );
     am->acroCLAW.setYawPIDConstants(
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_YAW_P),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_YAW_I),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_YAW_D),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_YAW_TAU),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_YAW_IMAX)
+        am->params->get(ZP_PARAM_ID::ATC_RAT_YAW_P),
+        am->params->get(ZP_PARAM_ID::ATC_RAT_YAW_I),
+        am->params->get(ZP_PARAM_ID::ATC_RAT_YAW_D),
+        am->params->get(ZP_PARAM_ID::ATC_RAT_YAW_TAU),
+        am->params->get(ZP_PARAM_ID::ATC_RAT_YAW_IMAX)
     );
-    am->acroCLAW.setRollLimitRate(ZP_UNITS::deg2rad(ZP_PARAM::get(ZP_PARAM_ID::ACRO_RP_RATE)));
-    am->acroCLAW.setPitchLimitRate(ZP_UNITS::deg2rad(ZP_PARAM::get(ZP_PARAM_ID::ACRO_RP_RATE)));
-    am->acroCLAW.setYawLimitRate(ZP_UNITS::deg2rad(ZP_PARAM::get(ZP_PARAM_ID::ACRO_Y_RATE)));
+    PID3 *ratePID = am->acroCLAW.getRatePID();
+    ratePID->setFeedforward(PIDAxis_e::ROLL, am->params->get(ZP_PARAM_ID::ATC_RAT_RLL_FF));
+    ratePID->setFeedforward(PIDAxis_e::PITCH, am->params->get(ZP_PARAM_ID::ATC_RAT_PIT_FF));
+    ratePID->setFeedforward(PIDAxis_e::YAW, am->params->get(ZP_PARAM_ID::ATC_RAT_YAW_FF));
+    ratePID->setDtermLpfHz(PIDAxis_e::ROLL, am->params->get(ZP_PARAM_ID::ATC_RAT_RLL_FLTD));
+    ratePID->setDtermLpfHz(PIDAxis_e::PITCH, am->params->get(ZP_PARAM_ID::ATC_RAT_PIT_FLTD));
+    ratePID->setDtermLpfHz(PIDAxis_e::YAW, am->params->get(ZP_PARAM_ID::ATC_RAT_YAW_FLTD));
+    for (uint8_t axis = 0; axis < PID3_AXES; axis++) {
+        ratePID->setSetpointWeights(static_cast<PIDAxis_e>(axis), am->params->get(ZP_PARAM_ID::ATC_RAT_P_WGT), am->params->get(ZP_PARAM_ID::ATC_RAT_D_WGT));
+    }
+    ratePID->setAntiWindup(static_cast<PIDAntiWindup_e>(static_cast<uint8_t>(am->params->get(ZP_PARAM_ID::ATC_RAT_AWU))));
+    am->acroCLAW.setRollLimitRate(ZP_UNITS::deg2rad(am->params->get(ZP_PARAM_ID::ACRO_RP_RATE)));
+    am->acroCLAW.setPitchLimitRate(ZP_UNITS::deg2rad(am->params->get(ZP_PARAM_ID::ACRO_RP_RATE)));
+    am->acroCLAW.setYawLimitRate(ZP_UNITS::deg2rad(am->params->get(ZP_PARAM_ID::ACRO_Y_RATE)));
 
     // Stabilize params
     am->stabilizeCLAW.setRollPIDConstants(
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_ANG_RLL_P),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_ANG_RLL_I),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_ANG_RLL_D),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_ANG_RLL_TAU),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_ANG_RLL_IMAX)
+        am->params->get(ZP_PARAM_ID::ATC_ANG_RLL_P),
+        am->params->get(ZP_PARAM_ID::ATC_ANG_RLL_I),
+        am->params->get(ZP_PARAM_ID::ATC_ANG_RLL_D),
+        am->params->get(ZP_PARAM_ID::ATC_ANG_RLL_TAU),
+        am->params->get(ZP_PARAM_ID::ATC_ANG_RLL_IMAX)
     );
     am->stabilizeCLAW.setPitchPIDConstants(
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_ANG_PTCH_P),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_ANG_PTCH_I),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_ANG_PTCH_D),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_ANG_PTCH_TAU),
-        ZP_PARAM::get(ZP_PARAM_ID::ATC_ANG_PTCH_IMAX)
+        am->params->get(ZP_PARAM_ID::ATC_ANG_PTCH_P),
+        am->params->get(ZP_PARAM_ID::ATC_ANG_PTCH_I),
+        am->params->get(ZP_PARAM_ID::ATC_ANG_PTCH_D),
+        am->params->get(ZP_PARAM_ID::ATC_ANG_PTCH_TAU),
+        am->params->get(ZP_PARAM_ID::ATC_ANG_PTCH_IMAX)
     );
-    am->stabilizeCLAW.setRollPitchLimitAngle(ZP_PARAM::get(ZP_PARAM_ID::ATC_ANGLE_MAX));
-    am->motSpinMin = ZP_PARAM::get(ZP_PARAM_ID::MOT_SPIN_MIN);
-    am->motSpinMax = ZP_PARAM::get(ZP_PARAM_ID::MOT_SPIN_MAX);
-    am->motSpinArm = ZP_PARAM::get(ZP_PARAM_ID::MOT_SPIN_ARM);
+    am->stabilizeCLAW.setRollPitchLimitAngle(am->params->get(ZP_PARAM_ID::ATC_ANGLE_MAX));
+    am->motSpinMin = am->params->get(ZP_PARAM_ID::MOT_SPIN_MIN);
+    am->motSpinMax = am->params->get(ZP_PARAM_ID::MOT_SPIN_MAX);
+    am->motSpinArm = am->params->get(ZP_PARAM_ID::MOT_SPIN_ARM);
+
+    // Frames without a table keep the quad X default
+    const MixerFrame_t *frame = MotorMixing::frameFor(
+        static_cast<FrameClass_e>(static_cast<int>(am->params->get(ZP_PARAM_ID::FRAME_CLASS))),
+        static_cast<FrameType_e>(static_cast<int>(am->params->get(ZP_PARAM_ID::FRAME_TYPE)))
+    );
+    if (frame != nullptr) {
+        am->mixerFrame = frame;
+    }
+
+    am->thrustCurve.setExpo(am->params->get(ZP_PARAM_ID::MOT_THST_EXPO));
+    am->thrustCurve.setVoltageLimits(am->params->get(ZP_PARAM_ID::MOT_BAT_VOLT_MIN), am->params->get(ZP_PARAM_ID::MOT_BAT_VOLT_MAX));
+
+    am->autotuneCLAW.setAxesMask(static_cast<uint8_t>(am->params->get(ZP_PARAM_ID::AUTOTUNE_AXES)));
+    am->autotuneCLAW.setTimeConstantRatio(am->params->get(ZP_PARAM_ID::AUTOTUNE_TC));
     #endif
 
     // FFT Harmonic Notch Filter params 
-    am->harmonicNotchConfig.enabled = ZP_PARAM::get(ZP_PARAM_ID::FFT_ENABLE);
-    am->harmonicNotchConfig.fftWindowSize = ZP_PARAM::get(ZP_PARAM_ID::FFT_WINDOW_LEN);
-    am->harmonicNotchConfig.minFreqHz = ZP_PARAM::get(ZP_PARAM_ID::FFT_MINHZ);
-    am->harmonicNotchConfig.bandwidthHz = ZP_PARAM::get(ZP_PARAM_ID::INS_HNTCH_BW);
-    am->harmonicNotchConfig.attenuationDB = ZP_PARAM::get(ZP_PARAM_ID::INS_HNTCH_ATT);
-    am->harmonicNotchConfig.harmonicsMask = ZP_PARAM::get(ZP_PARAM_ID::INS_HNTCH_HMNCS);
+    am->harmonicNotchConfig.enabled = am->params->get(ZP_PARAM_ID::FFT_ENABLE);
+    am->harmonicNotchConfig.fftWindowSize = am->params->get(ZP_PARAM_ID::FFT_WINDOW_LEN);
+    am->harmonicNotchConfig.minFreqHz = am->params->get(ZP_PARAM_ID::FFT_MINHZ);
+    am->harmonicNotchConfig.bandwidthHz = am->params->get(ZP_PARAM_ID::INS_HNTCH_BW);
+    am->harmonicNotchConfig.attenuationDB = am->params->get(ZP_PARAM_ID::INS_HNTCH_ATT);
+    am->harmonicNotchConfig.harmonicsMask = am->params->get(ZP_PARAM_ID::INS_HNTCH_HMNCS);
+    am->harmonicNotchConfig.mode = static_cast<HarmonicNotchMode_e>(static_cast<int>(am->params->get(ZP_PARAM_ID::INS_HNTCH_MODE)));
+    am->motorPolePairs = static_cast<uint8_t>(am->params->get(ZP_PARAM_ID::SERVO_BLH_POLES)) / 2;
+
+    // IMU decimation params, rates are read by the constructor and the drivers
+    am->imuDecimatorConfig.filter = static_cast<DecimationFilter_e>(static_cast<int>(am->params->get(ZP_PARAM_ID::INS_DECIM_TYPE)));
+
+    // SYSID params, applied the next time SYSID is entered
+    am->sysidCLAW.setAxis(static_cast<uint8_t>(am->params->get(ZP_PARAM_ID::SID_AXIS)));
+    am->sysidCLAW.setMagnitude(am->params->get(ZP_PARAM_ID::SID_MAGNITUDE));
+    am->sysidCLAW.setChirp(
+        am->params->get(ZP_PARAM_ID::SID_F_START_HZ),
+        am->params->get(ZP_PARAM_ID::SID_F_STOP_HZ),
+        am->params->get(ZP_PARAM_ID::SID_T_REC),
+        am->params->get(ZP_PARAM_ID::SID_T_FADE_IN),
+        am->params->get(ZP_PARAM_ID::SID_T_FADE_OUT)
+    );
 
     // Servo params
     auto loadMotor = [&](uint8_t ch, ZP_PARAM_ID trim, ZP_PARAM_ID min, ZP_PARAM_ID max, ZP_PARAM_ID rev, ZP_PARAM_ID func) {
         if (ch >= am->mainMotorGroup->motorCount) return;
         MotorInstance_t* m = &am->mainMotorGroup->motors[ch];
-        m->trim       = usToPercent(ZP_PARAM::get(trim));
-        m->min        = usToPercent(ZP_PARAM::get(min));
-        m->max        = usToPercent(ZP_PARAM::get(max));
-        m->isInverted = static_cast<int>(ZP_PARAM::get(rev)) != 0;
-        m->function   = static_cast<MotorFunction_e>(static_cast<int16_t>(ZP_PARAM::get(func)));
+        m->trim       = usToPercent(am->params->get(trim));
+        m->min        = usToPercent(am->params->get(min));
+        m->max        = usToPercent(am->params->get(max));
+        m->isInverted = static_cast<int>(am->params->get(rev)) != 0;
+        m->function   = static_cast<MotorFunction_e>(static_cast<int16_t>(am->params->get(func)));
     };
     loadMotor(0,  ZP_PARAM_ID::SERVO1_TRIM,  ZP_PARAM_ID::SERVO1_MIN,  ZP_PARAM_ID::SERVO1_MAX,  ZP_PARAM_ID::SERVO1_REVERSED,  ZP_PARAM_ID::SERVO1_FUNCTION);
     loadMotor(1,  ZP_PARAM_ID::SERVO2_TRIM,  ZP_PARAM_ID::SERVO2_MIN,  ZP_PARAM_ID::SERVO2_MAX,  ZP_PARAM_ID::SERVO2_REVERSED,  ZP_PARAM_ID::SERVO2_FUNCTION);
@@ -116,74 +158,107 @@ void AMParamSetup::loadAllParams() {
 
 // Macro to bind all 5 fields for a single servo channel
 #define AM_PARAM_SETUP_BIND_SERVO_CB(N) \
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::SERVO##N##_TRIM,     am, cbServoTrim<N-1>);     \
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::SERVO##N##_MIN,      am, cbServoMin<N-1>);      \
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::SERVO##N##_MAX,      am, cbServoMax<N-1>);      \
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::SERVO##N##_REVERSED, am, cbServoReversed<N-1>); \
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::SERVO##N##_FUNCTION, am, cbServoFunction<N-1>);
+    am->params->bindCallback(ZP_PARAM_ID::SERVO##N##_TRIM,     am, cbServoTrim<N-1>);     \
+    am->params->bindCallback(ZP_PARAM_ID::SERVO##N##_MIN,      am, cbServoMin<N-1>);      \
+    am->params->bindCallback(ZP_PARAM_ID::SERVO##N##_MAX,      am, cbServoMax<N-1>);      \
+    am->params->bindCallback(ZP_PARAM_ID::SERVO##N##_REVERSED, am, cbServoReversed<N-1>); \
+    am->params->bindCallback(ZP_PARAM_ID::SERVO##N##_FUNCTION, am, cbServoFunction<N-1>);
 
 void AMParamSetup::bindAllParamCallbacks() {
     // FBWA
     #ifdef PLANE
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::RLL2SRV_P,           am, updatePIDRollKp);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::RLL2SRV_I,           am, updatePIDRollKi);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::RLL2SRV_D,           am, updatePIDRollKd);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::RLL2SRV_TAU,         am, updatePIDRollTau);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::RLL2SRV_IMAX,        am, updatePIDRollIMax);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::RLL2SRV_FF,          am, updatePIDRollFF);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::PTCH2SRV_P,          am, updatePIDPitchKp);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::PTCH2SRV_I,          am, updatePIDPitchKi);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::PTCH2SRV_D,          am, updatePIDPitchKd);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::PTCH2SRV_TAU,        am, updatePIDPitchTau);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::PTCH2SRV_IMAX,       am, updatePIDPitchIMax);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::PTCH2SRV_FF,         am, updatePIDPitchFF);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::KFF_RDDRMIX,         am, updateKffRddrmix);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ROLL_LIMIT_DEG,      am, updateRollLimitDeg);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::PTCH_LIM_MAX_DEG,    am, updatePitchLimMaxDeg);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::PTCH_LIM_MIN_DEG,    am, updatePitchLimMinDeg);
+    am->params->bindCallback(ZP_PARAM_ID::RLL2SRV_P,           am, updatePIDRollKp);
+    am->params->bindCallback(ZP_PARAM_ID::RLL2SRV_I,           am, updatePIDRollKi);
+    am->params->bindCallback(ZP_PARAM_ID::RLL2SRV_D,           am, updatePIDRollKd);
+    am->params->bindCallback(ZP_PARAM_ID::RLL2SRV_TAU,         am, updatePIDRollTau);
+    am->params->bindCallback(ZP_PARAM_ID::RLL2SRV_IMAX,        am, updatePIDRollIMax);
+    am->params->bindCallback(ZP_PARAM_ID::RLL2SRV_FF,          am, updatePIDRollFF);
+    am->params->bindCallback(ZP_PARAM_ID::PTCH2SRV_P,          am, updatePIDPitchKp);
+    am->params->bindCallback(ZP_PARAM_ID::PTCH2SRV_I,          am, updatePIDPitchKi);
+    am->params->bindCallback(ZP_PARAM_ID::PTCH2SRV_D,          am, updatePIDPitchKd);
+    am->params->bindCallback(ZP_PARAM_ID::PTCH2SRV_TAU,        am, updatePIDPitchTau);
+    am->params->bindCallback(ZP_PARAM_ID::PTCH2SRV_IMAX,       am, updatePIDPitchIMax);
+    am->params->bindCallback(ZP_PARAM_ID::PTCH2SRV_FF,         am, updatePIDPitchFF);
+    am->params->bindCallback(ZP_PARAM_ID::KFF_RDDRMIX,         am, updateKffRddrmix);
+    am->params->bindCallback(ZP_PARAM_ID::ROLL_LIMIT_DEG,      am, updateRollLimitDeg);
+    am->params->bindCallback(ZP_PARAM_ID::PTCH_LIM_MAX_DEG,    am, updatePitchLimMaxDeg);
+    am->params->bindCallback(ZP_PARAM_ID::PTCH_LIM_MIN_DEG,    am, updatePitchLimMinDeg);
     #endif
     #ifdef QUADCOPTER
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_RAT_RLL_P,       am, updateRatePIDRollKp);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_RAT_RLL_I,       am, updateRatePIDRollKi);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_RAT_RLL_D,       am, updateRatePIDRollKd);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_RAT_RLL_TAU,     am, updateRatePIDRollTau);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_RAT_RLL_IMAX,    am, updateRatePIDRollIMax);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_RAT_PIT_P,       am, updateRatePIDPitchKp);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_RAT_PIT_I,       am, updateRatePIDPitchKi);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_RAT_PIT_D,       am, updateRatePIDPitchKd);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_RAT_PIT_TAU,     am, updateRatePIDPitchTau);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_RAT_PIT_IMAX,    am, updateRatePIDPitchIMax);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_RAT_YAW_P,       am, updateRatePIDYawKp);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_RAT_YAW_I,       am, updateRatePIDYawKi);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_RAT_YAW_D,       am, updateRatePIDYawKd);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_RAT_YAW_TAU,     am, updateRatePIDYawTau);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_RAT_YAW_IMAX,    am, updateRatePIDYawIMax);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ACRO_RP_RATE,        am, updateRollPitchLimitRate);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ACRO_Y_RATE,         am, updateYawLimitRate);
-
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_ANG_RLL_P,       am, updateAngPIDRollKp);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_ANG_RLL_I,       am, updateAngPIDRollKi);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_ANG_RLL_D,       am, updateAngPIDRollKd);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_ANG_RLL_TAU,     am, updateAngPIDRollTau);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_ANG_RLL_IMAX,    am, updateAngPIDRollIMax);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_ANG_PTCH_P,      am, updateAngPIDPitchKp);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_ANG_PTCH_I,      am, updateAngPIDPitchKi);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_ANG_PTCH_D,      am, updateAngPIDPitchKd);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_ANG_PTCH_TAU,    am, updateAngPIDPitchTau);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_ANG_PTCH_IMAX,   am, updateAngPIDPitchIMax);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::ATC_ANGLE_MAX,       am, updateRollPitchLimitAng);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::MOT_SPIN_MIN,        am, updateMotSpinMin);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::MOT_SPIN_MAX,        am, updateMotSpinMax);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::MOT_SPIN_ARM,        am, updateMotSpinArm);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_RLL_P,       am, updateRatePIDRollKp);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_RLL_I,       am, updateRatePIDRollKi);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_RLL_D,       am, updateRatePIDRollKd);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_RLL_TAU,     am, updateRatePIDRollTau);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_RLL_IMAX,    am, updateRatePIDRollIMax);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_PIT_P,       am, updateRatePIDPitchKp);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_PIT_I,       am, updateRatePIDPitchKi);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_PIT_D,       am, updateRatePIDPitchKd);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_PIT_TAU,     am, updateRatePIDPitchTau);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_PIT_IMAX,    am, updateRatePIDPitchIMax);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_YAW_P,       am, updateRatePIDYawKp);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_YAW_I,       am, updateRatePIDYawKi);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_YAW_D,       am, updateRatePIDYawKd);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_YAW_TAU,     am, updateRatePIDYawTau);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_YAW_IMAX,    am, updateRatePIDYawIMax);
+    am->params->bindCallback(ZP_PARAM_ID::ACRO_RP_RATE,        am, updateRollPitchLimitRate);
+    am->params->bindCallback(ZP_PARAM_ID::ACRO_Y_RATE,         am, updateYawLimitRate);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_RLL_FF,      am, updateRatePIDRollFF);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_RLL_FLTD,    am, updateRatePIDRollFltD);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_PIT_FF,      am, updateRatePIDPitchFF);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_PIT_FLTD,    am, updateRatePIDPitchFltD);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_YAW_FF,      am, updateRatePIDYawFF);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_YAW_FLTD,    am, updateRatePIDYawFltD);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_P_WGT,       am, updateRatePIDSetpointWeightP);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_D_WGT,       am, updateRatePIDSetpointWeightD);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_RAT_AWU,         am, updateRatePIDAntiWindup);
+
+    am->params->bindCallback(ZP_PARAM_ID::ATC_ANG_RLL_P,       am, updateAngPIDRollKp);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_ANG_RLL_I,       am, updateAngPIDRollKi);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_ANG_RLL_D,       am, updateAngPIDRollKd);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_ANG_RLL_TAU,     am, updateAngPIDRollTau);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_ANG_RLL_IMAX,    am, updateAngPIDRollIMax);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_ANG_PTCH_P,      am, updateAngPIDPitchKp);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_ANG_PTCH_I,      am, updateAngPIDPitchKi);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_ANG_PTCH_D,      am, updateAngPIDPitchKd);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_ANG_PTCH_TAU,    am, updateAngPIDPitchTau);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_ANG_PTCH_IMAX,   am, updateAngPIDPitchIMax);
+    am->params->bindCallback(ZP_PARAM_ID::ATC_ANGLE_MAX,       am, updateRollPitchLimitAng);
+    am->params->bindCallback(ZP_PARAM_ID::MOT_SPIN_MIN,        am, updateMotSpinMin);
+    am->params->bindCallback(ZP_PARAM_ID::MOT_SPIN_MAX,        am, updateMotSpinMax);
+    am->params->bindCallback(ZP_PARAM_ID::MOT_SPIN_ARM,        am, updateMotSpinArm);
+    am->params->bindCallback(ZP_PARAM_ID::FRAME_CLASS,         am, updateFrameClass);
+    am->params->bindCallback(ZP_PARAM_ID::FRAME_TYPE,          am, updateFrameType);
+    am->params->bindCallback(ZP_PARAM_ID::MOT_THST_EXPO,       am, updateMotThstExpo);
+    am->params->bindCallback(ZP_PARAM_ID::MOT_BAT_VOLT_MAX,    am, updateMotBatVoltMax);
+    am->params->bindCallback(ZP_PARAM_ID::MOT_BAT_VOLT_MIN,    am, updateMotBatVoltMin);
+    am->params->bindCallback(ZP_PARAM_ID::AUTOTUNE_AXES,       am, updateAutotuneAxes);
+    am->params->bindCallback(ZP_PARAM_ID::AUTOTUNE_TC,         am, updateAutotuneTc);
     #endif
 
     // FFT Harmonic Notch Filter params
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::FFT_ENABLE,          am, updateHarmonicNotchEnabled);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::FFT_WINDOW_LEN,      am, updateHarmonicNotchWindowSize);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::FFT_MINHZ,           am, updateHarmonicNotchMinFreqHz);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::INS_HNTCH_BW,        am, updateHarmonicNotchBandwidthHz);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::INS_HNTCH_ATT,       am, updateHarmonicNotchAttenuationDB);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::INS_HNTCH_HMNCS,     am, updateHarmonicNotchHarmonicsMask);
+    am->params->bindCallback(ZP_PARAM_ID::FFT_ENABLE,          am, updateHarmonicNotchEnabled);
+    am->params->bindCallback(ZP_PARAM_ID::FFT_WINDOW_LEN,      am, updateHarmonicNotchWindowSize);
+    am->params->bindCallback(ZP_PARAM_ID::FFT_MINHZ,           am, updateHarmonicNotchMinFreqHz);
+    am->params->bindCallback(ZP_PARAM_ID::INS_HNTCH_BW,        am, updateHarmonicNotchBandwidthHz);
+    am->params->bindCallback(ZP_PARAM_ID::INS_HNTCH_ATT,       am, updateHarmonicNotchAttenuationDB);
+    am->params->bindCallback(ZP_PARAM_ID::INS_HNTCH_HMNCS,     am, updateHarmonicNotchHarmonicsMask);
+    am->params->bindCallback(ZP_PARAM_ID::INS_HNTCH_MODE,      am, updateHarmonicNotchMode);
+    am->params->bindCallback(ZP_PARAM_ID::SERVO_BLH_POLES,     am, updateMotorPoles);
+
+    // IMU sampling and scheduling params
+    am->params->bindCallback(ZP_PARAM_ID::SCHED_LOOP_RATE,     am, updateSchedulingRate);
+    am->params->bindCallback(ZP_PARAM_ID::INS_GYRO_RATE,       am, updateImuGyroRate);
+    am->params->bindCallback(ZP_PARAM_ID::INS_DECIM_TYPE,      am, updateImuDecimationType);
+    am->params->bindCallback(ZP_PARAM_ID::GPS_RATE_MS,         am, updateGpsRate);
+
+    // SYSID params
+    am->params->bindCallback(ZP_PARAM_ID::SID_AXIS,            am, updateSysIdAxis);
+    am->params->bindCallback(ZP_PARAM_ID::SID_MAGNITUDE,       am, updateSysIdMagnitude);
+    am->params->bindCallback(ZP_PARAM_ID::SID_F_START_HZ,      am, updateSysIdFStartHz);
+    am->params->bindCallback(ZP_PARAM_ID::SID_F_STOP_HZ,       am, updateSysIdFStopHz);
+    am->params->bindCallback(ZP_PARAM_ID::SID_T_REC,           am, updateSysIdTRec);
+    am->params->bindCallback(ZP_PARAM_ID::SID_T_FADE_IN,       am, updateSysIdTFadeIn);
+    am->params->bindCallback(ZP_PARAM_ID::SID_T_FADE_OUT,      am, updateSysIdTFadeOut);
 
     // Servo params: each AM_PARAM_SETUP_BIND_SERVO_CB expands to 5 bindCallback calls
     AM_PARAM_SETUP_BIND_SERVO_CB(1)
@@ -291,80 +366,77 @@ bool AMParamSetup::updatePitchLimMinDeg(AttitudeManager* ctx, float val) {
 // Acro callbacks
 bool AMParamSetup::updateRatePIDRollKp(AttitudeManager* ctx, float val) {
     if (val < 0.0f) return false;
-    ctx->acroCLAW.getRollPID()->setKp(val);
+    ctx->acroCLAW.getRatePID()->setKp(PIDAxis_e::ROLL, val);
     return true;
 }
 bool AMParamSetup::updateRatePIDRollKi(AttitudeManager* ctx, float val) {
     if (val < 0.0f) return false;
-    ctx->acroCLAW.getRollPID()->setKi(val);
+    ctx->acroCLAW.getRatePID()->setKi(PIDAxis_e::ROLL, val);
     return true;
 }
 bool AMParamSetup::updateRatePIDRollKd(AttitudeManager* ctx, float val) {
     if (val < 0.0f) return false;
-    ctx->acroCLAW.getRollPID()->setKd(val);
+    ctx->acroCLAW.getRatePID()->setKd(PIDAxis_e::ROLL, val);
     return true;
 }
 bool AMParamSetup::updateRatePIDRollTau(AttitudeManager* ctx, float val) {
     if (val < 0.0f) return false;
-    ctx->acroCLAW.getRollPID()->setTau(val);
+    ctx->acroCLAW.getRatePID()->setTau(PIDAxis_e::ROLL, val);
     return true;
 }
 bool AMParamSetup::updateRatePIDRollIMax(AttitudeManager* ctx, float val) {
     if (val < 0.0f || val > 100.0f) return false;
-    ctx->acroCLAW.getRollPID()->setIntegralMinLimPct(static_cast<uint8_t>(val));
-    ctx->acroCLAW.getRollPID()->setIntegralMaxLimPct(static_cast<uint8_t>(val));
+    ctx->acroCLAW.getRatePID()->setIntegralMaxPct(PIDAxis_e::ROLL, static_cast<uint8_t>(val));
     return true;
 }
 bool AMParamSetup::updateRatePIDPitchKp(AttitudeManager* ctx, float val) {
     if (val < 0.0f) return false;
-    ctx->acroCLAW.getPitchPID()->setKp(val);
+    ctx->acroCLAW.getRatePID()->setKp(PIDAxis_e::PITCH, val);
     return true;
 }
 bool AMParamSetup::updateRatePIDPitchKi(AttitudeManager* ctx, float val) {
     if (val < 0.0f) return false;
-    ctx->acroCLAW.getPitchPID()->setKi(val);
+    ctx->acroCLAW.getRatePID()->setKi(PIDAxis_e::PITCH, val);
     return true;
 }
 bool AMParamSetup::updateRatePIDPitchKd(AttitudeManager* ctx, float val) {
     if (val < 0.0f) return false;
-    ctx->acroCLAW.getPitchPID()->setKd(val);
+    ctx->acroCLAW.getRatePID()->setKd(PIDAxis_e::PITCH, val);
     return true;
 }
 bool AMParamSetup::updateRatePIDPitchTau(AttitudeManager* ctx, float val) {
     if (val < 0.0f) return false;
-    ctx->acroCLAW.getPitchPID()->setTau(val);
+    ctx->acroCLAW.getRatePID()->setTau(PIDAxis_e::PITCH, val);
     return true;
 }
 bool AMParamSetup::updateRatePIDPitchIMax(AttitudeManager* ctx, float val) {
     if (val < 0.0f || val > 100.0f) return false;
-    ctx->acroCLAW.getPitchPID()->setIntegralMinLimPct(static_cast<uint8_t>(val));
-    ctx->acroCLAW.getPitchPID()->setIntegralMaxLimPct(static_cast<uint8_t>(val));
+    ctx->acroCLAW.getRatePID()->setIntegralMaxPct(PIDAxis_e::PITCH, static_cast<uint8_t>(val));
     return true;
 }
 bool AMParamSetup::updateRatePIDYawKp(AttitudeManager* ctx, float val) {
     if (val < 0.0f) return false;
-    ctx->acroCLAW.getYawPID()->setKp(val);
+    ctx->acroCLAW.getRatePID()->setKp(PIDAxis_e::YAW, val);
     return true;
 }
 bool AMParamSetup::updateRatePIDYawKi(AttitudeManager* ctx, float val) {
     if (val < 0.0f) return false;
-    ctx->acroCLAW.getYawPID()->setKi(val);
+    ctx->acroCLAW.getRatePID()->setKi(PIDAxis_e::YAW, val);
     return true;
 }
 bool AMParamSetup::updateRatePIDYawKd(AttitudeManager* ctx, float val) {
     if (val < 0.0f) return false;
-    ctx->acroCLAW.getYawPID()->setKd(val);
+    ctx->acroCLAW.getRatePID()->setKd(PIDAxis_e::YAW, val);
     return true;
 }
 bool AMParamSetup::updateRatePIDYawTau(AttitudeManager* ctx, float val) {
     if (val < 0.0f) return false;
-    ctx->acroCLAW.getYawPID()->setTau(val);
+    ctx->acroCLAW.getRatePID()->setTau(PIDAxis_e::YAW, val);
     return true;
 }
 bool AMParamSetup::updateRatePIDYawIMax(AttitudeManager* ctx, float val) {
     if (val < 0.0f || val > 100.0f) return false;
-    ctx->acroCLAW.getYawPID()->setIntegralMinLimPct(static_cast<uint8_t>(val));
-    ctx->acroCLAW.getYawPID()->setIntegralMaxLimPct(static_cast<uint8_t>(val));
+    ctx->acroCLAW.getRatePID()->setIntegralMaxPct(PIDAxis_e::YAW, static_cast<uint8_t>(val));
     return true;
 }
 bool AMParamSetup::updateRollPitchLimitRate(AttitudeManager* ctx, float val) {
@@ -379,6 +451,49 @@ bool AMParamSetup::updateYawLimitRate(AttitudeManager* ctx, float val) {
     ctx->acroCLAW.setYawLimitRate(ZP_UNITS::deg2rad(val));
     return true;
 }
+bool AMParamSetup::updateRatePIDRollFF(AttitudeManager* ctx, float val) {
+    if (val < 0.0f) return false;
+    ctx->acroCLAW.getRatePID()->setFeedforward(PIDAxis_e::ROLL, val);
+    return true;
+}
+bool AMParamSetup::updateRatePIDRollFltD(AttitudeManager* ctx, float val) {
+    return ctx->acroCLAW.getRatePID()->setDtermLpfHz(PIDAxis_e::ROLL, val);
+}
+bool AMParamSetup::updateRatePIDPitchFF(AttitudeManager* ctx, float val) {
+    if (val < 0.0f) return false;
+    ctx->acroCLAW.getRatePID()->setFeedforward(PIDAxis_e::PITCH, val);
+    return true;
+}
+bool AMParamSetup::updateRatePIDPitchFltD(AttitudeManager* ctx, float val) {
+    return ctx->acroCLAW.getRatePID()->setDtermLpfHz(PIDAxis_e::PITCH, val);
+}
+bool AMParamSetup::updateRatePIDYawFF(AttitudeManager* ctx, float val) {
+    if (val < 0.0f) return false;
+    ctx->acroCLAW.getRatePID()->setFeedforward(PIDAxis_e::YAW, val);
+    return true;
+}
+bool AMParamSetup::updateRatePIDYawFltD(AttitudeManager* ctx, float val) {
+    return ctx->acroCLAW.getRatePID()->setDtermLpfHz(PIDAxis_e::YAW, val);
+}
+bool AMParamSetup::updateRatePIDSetpointWeightP(AttitudeManager* ctx, float val) {
+    if (val < 0.0f || val > 1.0f) return false;
+    for (uint8_t axis = 0; axis < PID3_AXES; axis++) {
+        ctx->acroCLAW.getRatePID()->setSetpointWeights(static_cast<PIDAxis_e>(axis), val, ctx->params->get(ZP_PARAM_ID::ATC_RAT_D_WGT));
+    }
+    return true;
+}
+bool AMParamSetup::updateRatePIDSetpointWeightD(AttitudeManager* ctx, float val) {
+    if (val < 0.0f || val > 1.0f) return false;
+    for (uint8_t axis = 0; axis < PID3_AXES; axis++) {
+        ctx->acroCLAW.getRatePID()->setSetpointWeights(static_cast<PIDAxis_e>(axis), ctx->params->get(ZP_PARAM_ID::ATC_RAT_P_WGT), val);
+    }
+    return true;
+}
+bool AMParamSetup::updateRatePIDAntiWindup(AttitudeManager* ctx, float val) {
+    if (val != static_cast<float>(PIDAntiWindup_e::CLAMP) && val != static_cast<float>(PIDAntiWindup_e::CONDITIONAL)) return false;
+    ctx->acroCLAW.getRatePID()->setAntiWindup(static_cast<PIDAntiWindup_e>(static_cast<uint8_t>(val)));
+    return true;
+}
 // Stabilize callbacks
 bool AMParamSetup::updateAngPIDRollKp(AttitudeManager* ctx, float val) {
     if (val < 0.0f) return false;
@@ -454,6 +569,34 @@ bool AMParamSetup::updateMotSpinArm(AttitudeManager* ctx, float val) {
     ctx->motSpinArm = val;
     return true;
 }
+bool AMParamSetup::updateFrameClass(AttitudeManager* ctx, float val) {
+    // Must have a mixer table for the current FRAME_TYPE, applied on reboot
+    return MotorMixing::frameFor(static_cast<FrameClass_e>(static_cast<int>(val)),
+        static_cast<FrameType_e>(static_cast<int>(ctx->params->get(ZP_PARAM_ID::FRAME_TYPE)))) != nullptr;
+}
+bool AMParamSetup::updateFrameType(AttitudeManager* ctx, float val) {
+    // Must have a mixer table for the current FRAME_CLASS, applied on reboot
+    return MotorMixing::frameFor(static_cast<FrameClass_e>(static_cast<int>(ctx->params->get(ZP_PARAM_ID::FRAME_CLASS))),
+        static_cast<FrameType_e>(static_cast<int>(val))) != nullptr;
+}
+bool AMParamSetup::updateMotThstExpo(AttitudeManager* ctx, float val) {
+    return ctx->thrustCurve.setExpo(val);
+}
+bool AMParamSetup::updateMotBatVoltMax(AttitudeManager* ctx, float val) {
+    return ctx->thrustCurve.setVoltageLimits(ctx->params->get(ZP_PARAM_ID::MOT_BAT_VOLT_MIN), val);
+}
+bool AMParamSetup::updateMotBatVoltMin(AttitudeManager* ctx, float val) {
+    return ctx->thrustCurve.setVoltageLimits(val, ctx->params->get(ZP_PARAM_ID::MOT_BAT_VOLT_MAX));
+}
+bool AMParamSetup::updateAutotuneAxes(AttitudeManager* ctx, float val) {
+    // Applied the next time AUTOTUNE is entered
+    int v = static_cast<int>(val);
+    if (v < 0 || v > 0xFF) return false;
+    return ctx->autotuneCLAW.setAxesMask(static_cast<uint8_t>(v));
+}
+bool AMParamSetup::updateAutotuneTc(AttitudeManager* ctx, float val) {
+    return ctx->autotuneCLAW.setTimeConstantRatio(val);
+}
 #endif
 
 // FFT Harmonic Notch Filter callbacks (only do bound checking as they cannot change at runtime)
@@ -496,6 +639,73 @@ bool AMParamSetup::updateHarmonicNotchHarmonicsMask(AttitudeManager* ctx, float
     return true;
 }
 
+bool AMParamSetup::updateHarmonicNotchMode(AttitudeManager* ctx, float val) {
+    // Must be 3 (ESC eRPM) or 4 (FFT), applied on reboot
+    int v = static_cast<int>(val);
+    return v == static_cast<int>(HarmonicNotchMode_e::ESC_RPM) || v == static_cast<int>(HarmonicNotchMode_e::FFT);
+}
+
+bool AMParamSetup::updateMotorPoles(AttitudeManager* ctx, float val) {
+    // Must be an even pole count between 2 and 64
+    int v = static_cast<int>(val);
+    if (v < 2 || v > 64 || (v % 2) != 0) return false;
+    ctx->motorPolePairs = static_cast<uint8_t>(v / 2);
+    return true;
+}
+
+bool AMParamSetup::updateSchedulingRate(AttitudeManager* ctx, float val) {
+    // Must evenly divide the 1 kHz RTOS tick, applied on reboot
+    return AttitudeManager::isValidSchedulingRateHz(static_cast<int>(val));
+}
+
+bool AMParamSetup::updateImuGyroRate(AttitudeManager* ctx, float val) {
+    // Must be a supported IMU ODR between 500 Hz and 8 kHz, applied on reboot. 8 kHz is the top of
+    // ArduPilot's INS_GYRO_RATE range and the fastest ODR the board IMU drivers' odrFromHz() maps
+    int v = static_cast<int>(val);
+    return v == 500 || v == 1000 || v == 2000 || v == 4000 || v == 8000;
+}
+
+bool AMParamSetup::updateImuDecimationType(AttitudeManager* ctx, float val) {
+    // Must be 0 (none), 1 (FIR) or 2 (CIC), applied on reboot
+    int v = static_cast<int>(val);
+    return v >= 0 && v <= 2;
+}
+
+bool AMParamSetup::updateGpsRate(AttitudeManager* ctx, float val) {
+    // Must be between 40 ms (25 Hz) and 1000 ms (1 Hz), applied on reboot
+    return val >= 40.0f && val <= 1000.0f;
+}
+
+// SYSID callbacks, each takes effect the next time SYSID is entered
+bool AMParamSetup::updateSysIdAxis(AttitudeManager* ctx, float val) {
+    int v = static_cast<int>(val);
+    if (v < 0 || v > 0xFF) return false;
+    return ctx->sysidCLAW.setAxis(static_cast<uint8_t>(v));
+}
+bool AMParamSetup::updateSysIdMagnitude(AttitudeManager* ctx, float val) {
+    return ctx->sysidCLAW.setMagnitude(val);
+}
+bool AMParamSetup::updateSysIdFStartHz(AttitudeManager* ctx, float val) {
+    return ctx->sysidCLAW.setChirp(val, ctx->params->get(ZP_PARAM_ID::SID_F_STOP_HZ), ctx->params->get(ZP_PARAM_ID::SID_T_REC),
+        ctx->params->get(ZP_PARAM_ID::SID_T_FADE_IN), ctx->params->get(ZP_PARAM_ID::SID_T_FADE_OUT));
+}
+bool AMParamSetup::updateSysIdFStopHz(AttitudeManager* ctx, float val) {
+    return ctx->sysidCLAW.setChirp(ctx->params->get(ZP_PARAM_ID::SID_F_START_HZ), val, ctx->params->get(ZP_PARAM_ID::SID_T_REC),
+        ctx->params->get(ZP_PARAM_ID::SID_T_FADE_IN), ctx->params->get(ZP_PARAM_ID::SID_T_FADE_OUT));
+}
+bool AMParamSetup::updateSysIdTRec(AttitudeManager* ctx, float val) {
+    return ctx->sysidCLAW.setChirp(ctx->params->get(ZP_PARAM_ID::SID_F_START_HZ), ctx->params->get(ZP_PARAM_ID::SID_F_STOP_HZ), val,
+        ctx->params->get(ZP_PARAM_ID::SID_T_FADE_IN), ctx->params->get(ZP_PARAM_ID::SID_T_FADE_OUT));
+}
+bool AMParamSetup::updateSysIdTFadeIn(AttitudeManager* ctx, float val) {
+    return ctx->sysidCLAW.setChirp(ctx->params->get(ZP_PARAM_ID::SID_F_START_HZ), ctx->params->get(ZP_PARAM_ID::SID_F_STOP_HZ),
+        ctx->params->get(ZP_PARAM_ID::SID_T_REC), val, ctx->params->get(ZP_PARAM_ID::SID_T_FADE_OUT));
+}
+bool AMParamSetup::updateSysIdTFadeOut(AttitudeManager* ctx, float val) {
+    return ctx->sysidCLAW.setChirp(ctx->params->get(ZP_PARAM_ID::SID_F_START_HZ), ctx->params->get(ZP_PARAM_ID::SID_F_STOP_HZ),
+        ctx->params->get(ZP_PARAM_ID::SID_T_REC), ctx->params->get(ZP_PARAM_ID::SID_T_FADE_IN), val);
+}
+
 // Servo field helpers
 bool AMParamSetup::setServoTrim(AttitudeManager* ctx, uint8_t ch, float val) {
     if (ch >= ctx->mainMotorGroup->motorCount || val < 0.0f || val > 2000.0f) return false;
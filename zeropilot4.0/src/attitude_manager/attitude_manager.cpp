@@ -1,9 +1,12 @@
 #include "attitude_manager.hpp"
+#include "tcm_placement.hpp"
 #include "rc_motor_control.hpp"
 #include "zp_params.hpp"
 #include "motor_functions.hpp"
 #include "unit_conversions.hpp"
 #include <limits>
+#include <cmath>
+#include <cstdio>
 
 AttitudeManager::AttitudeManager(
     ISystemUtils *systemUtilsDriver,
@@ -16,29 +19,51 @@ AttitudeManager::AttitudeManager(
     IMessageQueue<RCMotorControlMessage_t> *amQueue,
     IMessageQueue<TMMessage_t> *tmQueue,
     IMessageQueue<char[100]> *smLoggerQueue,
-    MotorGroupInstance_t *mainMotorGroup
+    MotorGroupInstance_t *mainMotorGroup,
+    const LatestValueSlot<RCChannelFrame_t> *rcFastPath,
+    LatestValueSlot<RCNavTelemetry_t> *rcNavTelemetry,
+    const LatestValueSlot<BatteryVoltage_t> *batteryVoltage,
+    IFFT *sysIdFftDriver,
+    IMessageQueue<SysIdLogBlock_t> *sysIdLogQueue,
+    ParamRegistry *params
 ) :
+    params(params != nullptr ? params : &ZP_PARAM::registry()),
+    amSchedulingRateHz(getConfiguredSchedulingRateHz(*this->params)),
+    controlLoopPeriodS(1.0f / amSchedulingRateHz),
     systemUtilsDriver(systemUtilsDriver),
     gpsDriver(gpsDriver),
     imuDriver(imuDriver),
     rangefinderDriver(rangefinderDriver),
     barometerDriver(barometerDriver),
     harmonicNotchFilter(mathUtilsDriver, fftDriver),
+    motorPolePairs(0),
     // ekf(mathUtilsDriver),
     amQueue(amQueue),
     tmQueue(tmQueue),
     smLoggerQueue(smLoggerQueue),
+    sysIdLogQueue(sysIdLogQueue),
+    rcFastPath(rcFastPath),
+    rcFastFrame{},
+    rcFastSeq(0),
+    rcFastAgeMs(0),
+    haveRcFastFrame(false),
+    rcNavTelemetry(rcNavTelemetry),
+    batteryVoltage(batteryVoltage),
+    batteryVoltageSeq(0),
     #ifdef PLANE
     activeCLAW(&manualCLAW),
     manualCLAW(),
-    fbwaCLAW(AM_CONTROL_LOOP_PERIOD_S),
+    fbwaCLAW(controlLoopPeriodS),
+    sysidCLAW(controlLoopPeriodS, fbwaCLAW, sysIdFftDriver),
     controlMsg({50, 50, 50, 0, 0, 0, FlightMode_e::MANUAL}),
     currentFlightMode(FlightMode_e::MANUAL),
     #endif
     #ifdef QUADCOPTER
     activeCLAW(&stabilizeCLAW),
-    acroCLAW(AM_CONTROL_LOOP_PERIOD_S),
-    stabilizeCLAW(AM_CONTROL_LOOP_PERIOD_S, acroCLAW),
+    acroCLAW(controlLoopPeriodS),
+    stabilizeCLAW(controlLoopPeriodS, acroCLAW),
+    autotuneCLAW(controlLoopPeriodS, stabilizeCLAW, this->params),
+    sysidCLAW(controlLoopPeriodS, stabilizeCLAW, sysIdFftDriver, &stabilizeCLAW),
     controlMsg({50, 50, 50, 0, 0, FlightMode_e::STABILIZE}),
     currentFlightMode(FlightMode_e::STABILIZE),
     #endif
@@ -50,15 +75,24 @@ AttitudeManager::AttitudeManager(
     amSchedulingCounter(0),
     noDataCount(0),
     failsafeTriggered(false),
+    #ifdef QUADCOPTER
+    mixerFrame(MotorMixing::frameFor(FrameClass_e::QUAD, FrameType_e::X)),
+    thrustCurve(),
+    #endif
     groundIdlePrev(false),
-    lastTimestamp(0),
+    lastTimestampUs(0),
     haveLastImuTimestamp(false),
     profilerId(0),
     paramSetup(this) {
         paramSetup.loadAllParams();
         paramSetup.bindAllParamCallbacks();
 
-        harmonicNotchConfig.sampleFreqHz = imuDriver->getODRHz();
+        // Decimate the IMU ODR down to the control rate, the notch runs at the decimated rate
+        imuDecimatorConfig.inputRateHz = imuDriver->getODRHz();
+        imuDecimatorConfig.outputRateHz = amSchedulingRateHz;
+        imuDecimator.init(imuDecimatorConfig);
+
+        harmonicNotchConfig.sampleFreqHz = imuDecimator.getOutputRateHz();
         harmonicNotchFilter.init(harmonicNotchConfig);
 
         /* TODO: Uncomment once using EKF
@@ -90,14 +124,14 @@ AttitudeManager::AttitudeManager(
         systemUtilsDriver->profilerRegister("AM", &profilerId);
 }
 
-void AttitudeManager::amUpdate() {
+ZP_FAST_CODE void AttitudeManager::amUpdate() {
 
     systemUtilsDriver->profilerBegin(profilerId);
 
-    amSchedulingCounter = (amSchedulingCounter + 1) % AM_SCHEDULING_RATE_HZ;
+    amSchedulingCounter = (amSchedulingCounter + 1) % amSchedulingRateHz;
 
     // Send servo output raw data to telemetry manager
-    if (amSchedulingCounter % (AM_SCHEDULING_RATE_HZ / AM_TELEMETRY_SERVO_OUTPUT_RAW_RATE_HZ) == 0) {
+    if (amSchedulingCounter % (amSchedulingRateHz / AM_TELEMETRY_SERVO_OUTPUT_RAW_RATE_HZ) == 0) {
         sendServoOutputRawToTelemetryManager();
     }
 
@@ -106,13 +140,18 @@ void AttitudeManager::amUpdate() {
     barometerDriver->readData(baroData);
 
     // Send scaled pressure data to TM
-    if (amSchedulingCounter % (AM_SCHEDULING_RATE_HZ / AM_TELEMETRY_SCALED_PRESSURE_DATA_RATE_HZ) == 0) {
+    if (amSchedulingCounter % (amSchedulingRateHz / AM_TELEMETRY_SCALED_PRESSURE_DATA_RATE_HZ) == 0) {
         sendPressureDataToTelemetryManager(baroData);
     }
 
+    // Retune RPM notches before this batch of gyro samples goes through them
+    if (harmonicNotchConfig.mode == HarmonicNotchMode_e::ESC_RPM) {
+        updateNotchFromMotorRpm();
+    }
+
     // Send IMU raw data to telemetry manager
     RawImuBatch_t imuData = imuDriver->readRawData();
-    ScaledImuBatch_t scaledImuData = imuDriver->scaleIMUData(imuData);
+    ScaledImuBatch_t scaledImuData = imuDecimator.process(imuDriver->scaleIMUData(imuData));
     for (int i = 0; i < scaledImuData.count; i++) {
         if (scaledImuData.data[i].imuId == 0) { // Only feed one IMU's data for FFT sampling as we need a continuous time stream.
             harmonicNotchFilter.pushSample(scaledImuData.data[i].xgyro, scaledImuData.data[i].ygyro, scaledImuData.data[i].zgyro);
@@ -124,17 +163,13 @@ void AttitudeManager::amUpdate() {
         if (scaledImuData.data[i].imuId != 0) continue; // Only use IMU0 for EKF
         */
 
-        /*
-        We use uint16_t instead of uint32_t as single IMU logic relies on uint16_t wraparound
-        and the delta for double IMU will be necessarily less than uint16_t max value.
-        */
-        
-        uint16_t deltaTicks = scaledImuData.data[i].timestamp - lastTimestamp;
+        // Driver timestamps are synchronized to the MCU clock, 64-bit and monotonic
+        uint64_t deltaUs = scaledImuData.data[i].timestampUs - lastTimestampUs;
 
-        lastTimestamp = scaledImuData.data[i].timestamp;
+        lastTimestampUs = scaledImuData.data[i].timestampUs;
 
-        // Make lastTimestamp hold a real timestamp the first iteration
-        if (!haveLastImuTimestamp) {
+        // Make lastTimestampUs hold a real timestamp the first iteration, and restart after long gaps
+        if (!haveLastImuTimestamp || deltaUs == 0 || deltaUs > IMU_MAX_DT_US) {
             haveLastImuTimestamp = true;
             continue;
         }
@@ -144,7 +179,7 @@ void AttitudeManager::amUpdate() {
         droneState.pitchRate = scaledImuData.data[i].ygyro - startupGyroBias.y;
         droneState.yawRate = scaledImuData.data[i].zgyro - startupGyroBias.z;
 
-        float dt = deltaTicks * TIMESTAMP_RESOLUTION;
+        float dt = static_cast<float>(deltaUs) * US_TO_S;
         
         mahonyFilter.updateIMU(
             scaledImuData.data[i].xgyro - startupGyroBias.x,
@@ -178,16 +213,21 @@ void AttitudeManager::amUpdate() {
         */
     }
 
+    // Track the measured IMU ODR so the FFT bins map to the real sample rate
+    if (amSchedulingCounter == 0) {
+        updateNotchSampleRate();
+    }
+
     Attitude_t attitude = mahonyFilter.getAttitudeRadians();
     droneState.roll = attitude.roll;
     droneState.pitch = attitude.pitch;
     droneState.yaw = attitude.yaw;
 
-    if (amSchedulingCounter % (AM_SCHEDULING_RATE_HZ / AM_TELEMETRY_RAW_IMU_DATA_RATE_HZ) == 0) {
+    if (amSchedulingCounter % (amSchedulingRateHz / AM_TELEMETRY_RAW_IMU_DATA_RATE_HZ) == 0) {
         if (imuData.count > 0) { sendRawIMUDataToTelemetryManager(imuData.data[imuData.count - 1]); } // Send the last packed of IMU data 
     }
 
-    if (amSchedulingCounter % (AM_SCHEDULING_RATE_HZ / AM_TELEMETRY_ATTITUDE_DATA_RATE_HZ) == 0) {
+    if (amSchedulingCounter % (amSchedulingRateHz / AM_TELEMETRY_ATTITUDE_DATA_RATE_HZ) == 0) {
         sendAttitudeDataToTelemetryManager(attitude);
     }
 
@@ -195,16 +235,22 @@ void AttitudeManager::amUpdate() {
     GpsData_t gpsData = gpsDriver->readData();
     if (gpsData.isNew) {
         lastValidGps = gpsData;
+        haveGpsFix = true;
     }
     
     // Send GPS data to telemetry manager
-    if (amSchedulingCounter % (AM_SCHEDULING_RATE_HZ / AM_TELEMETRY_GPS_DATA_RATE_HZ) == 0) {
+    if (amSchedulingCounter % (amSchedulingRateHz / AM_TELEMETRY_GPS_DATA_RATE_HZ) == 0) {
         if (lastValidGps.isNew) {
             sendGPSDataToTelemetryManager(lastValidGps);
             lastValidGps.isNew = false; // Mark as sent to telemetry manager, so if no new GPS data is valid the same data is not sent again
         }
     }
 
+    // Receiver telemetry downlink
+    if (rcNavTelemetry != nullptr && amSchedulingCounter % (amSchedulingRateHz / AM_TELEMETRY_ATTITUDE_DATA_RATE_HZ) == 0) {
+        publishNavTelemetry(attitude);
+    }
+
     // Get rangefinder data
     RangefinderData_t rangefinderData = {};
     if (rangefinderDriver != nullptr) {
@@ -215,7 +261,7 @@ void AttitudeManager::amUpdate() {
     }
 
     // Send rangefinder data to telemetry manager
-    if (amSchedulingCounter % (AM_SCHEDULING_RATE_HZ / AM_TELEMETRY_DISTANCE_SENSOR_DATA_RATE_HZ) == 0) {
+    if (amSchedulingCounter % (amSchedulingRateHz / AM_TELEMETRY_DISTANCE_SENSOR_DATA_RATE_HZ) == 0) {
         if (lastNewRangefinderData.isNew) {
             sendRangefinderDataToTelemetryManager(lastNewRangefinderData);
             lastNewRangefinderData.isNew = false; // Mark as sent to telemetry manager, so if no new rangefinder data is valid the same data is not sent again
@@ -228,7 +274,7 @@ void AttitudeManager::amUpdate() {
     if (controlRes != true) {
         ++noDataCount;
 
-        if (noDataCount * AM_UPDATE_LOOP_DELAY_MS > ((ZP_PARAM::get(ZP_PARAM_ID::RC_FS_TIMEOUT)) * 1000)) {
+        if (noDataCount * getUpdateLoopDelayMs() > ((params->get(ZP_PARAM_ID::RC_FS_TIMEOUT)) * 1000)) {
             RCMotorControlMessage_t motorOutputs{0};
 
             #ifdef PLANE
@@ -267,6 +313,9 @@ void AttitudeManager::amUpdate() {
         }
     }
 
+    // Overlay the latest receiver frame on the SM relayed sticks
+    applyFastPathSticks(&controlMsg);
+
     // Update armedFlag and activateFlightMode() on rising edge
     if (controlMsg.arm != armedFlag) {
         setArmFlag = true;
@@ -287,6 +336,9 @@ void AttitudeManager::amUpdate() {
             case FlightMode_e::FBWA:
                 activeCLAW = &fbwaCLAW;
                 break;
+            case FlightMode_e::SYSID:
+                activeCLAW = &sysidCLAW;
+                break;
             #endif
 
             #ifdef QUADCOPTER
@@ -296,6 +348,12 @@ void AttitudeManager::amUpdate() {
             case FlightMode_e::STABILIZE:
                 activeCLAW = &stabilizeCLAW;
                 break;
+            case FlightMode_e::AUTOTUNE:
+                activeCLAW = &autotuneCLAW;
+                break;
+            case FlightMode_e::SYSID:
+                activeCLAW = &sysidCLAW;
+                break;
             #endif
             
         }
@@ -318,6 +376,15 @@ void AttitudeManager::amUpdate() {
     // Run the active control law (skip while armed but grounded idle)
     RCMotorControlMessage_t motorOutputs = groundIdle ? controlMsg : activeCLAW->runControl(controlMsg, droneState);
 
+    #ifdef QUADCOPTER
+    if (activeCLAW == &autotuneCLAW) {
+        logAutotuneResults();
+    }
+    #endif
+    if (activeCLAW == &sysidCLAW) {
+        logSysIdData();
+    }
+
     // Disarm logic
     if (!armedFlag) {
         motorOutputs.throttle = 0;
@@ -347,17 +414,50 @@ bool AttitudeManager::getControlInputs(RCMotorControlMessage_t *pControlMsg) {
     return true;
 }
 
-void AttitudeManager::outputToMotors(const RCMotorControlMessage_t outputControlMsg, bool groundIdle) {
+void AttitudeManager::applyFastPathSticks(RCMotorControlMessage_t *pControlMsg) {
+    if (rcFastPath == nullptr) return;
+
+    if (rcFastPath->readIfNew(rcFastFrame, rcFastSeq)) {
+        haveRcFastFrame = true;
+        rcFastAgeMs = 0;
+    } else if (haveRcFastFrame) {
+        rcFastAgeMs += getUpdateLoopDelayMs();
+    }
+
+    // A stale receiver falls back to whatever SM last relayed, SM and the queue timeout handle failsafe
+    if (!haveRcFastFrame || rcFastAgeMs > params->get(ZP_PARAM_ID::RC_FS_TIMEOUT) * 1000) return;
+
+    // SM treats a link below RC_FS_LQ as lost even while frames keep coming, so don't fly them either
+    const RCLinkStats_t &link = rcFastFrame.linkStats;
+    if (link.isValid && link.linkQuality < params->get(ZP_PARAM_ID::RC_FS_LQ)) return;
+
+    // Channel order and reversal match SystemManager::sendRCDataToAttitudeManager
+    const float *ch = rcFastFrame.controlSignals;
+    pControlMsg->roll = params->get(ZP_PARAM_ID::RC1_REVERSED) != 0.0f ? 100.0f - ch[0] : ch[0];
+    pControlMsg->pitch = params->get(ZP_PARAM_ID::RC2_REVERSED) != 0.0f ? 100.0f - ch[1] : ch[1];
+    pControlMsg->throttle = params->get(ZP_PARAM_ID::RC3_REVERSED) != 0.0f ? 100.0f - ch[2] : ch[2];
+    pControlMsg->yaw = params->get(ZP_PARAM_ID::RC4_REVERSED) != 0.0f ? 100.0f - ch[3] : ch[3];
+    #ifdef PLANE
+    pControlMsg->flapAngle = ch[6];
+    #endif
+}
+
+ZP_FAST_CODE void AttitudeManager::outputToMotors(const RCMotorControlMessage_t outputControlMsg, bool groundIdle) {
 
     #ifdef PLANE
         MotorMixing::fixedWingMoterMixer(outputControlMsg, mainMotorGroup, motorPercent);
     #endif
 
     #ifdef QUADCOPTER
+        BatteryVoltage_t voltage;
+        if (batteryVoltage != nullptr && batteryVoltage->readIfNew(voltage, batteryVoltageSeq)) {
+            thrustCurve.updateVoltage(voltage.filteredVoltage);
+        }
+
         if (groundIdle) {
-            MotorMixing::quadGroundIdle(mainMotorGroup, motorPercent, motSpinArm);
+            MotorMixing::multirotorGroundIdle(*mixerFrame, mainMotorGroup, motorPercent, motSpinArm);
         } else {
-            MotorMixing::quadMotorMixer(outputControlMsg, mainMotorGroup, motorPercent);
+            MotorMixing::multirotorMixer(*mixerFrame, outputControlMsg, mainMotorGroup, motorPercent);
         }
     #endif
 
@@ -371,60 +471,54 @@ void AttitudeManager::outputToMotors(const RCMotorControlMessage_t outputControl
 
         float percent = motorPercent[i];
 
-        uint32_t cmd = 0;
+        float command = 0.0f; // Normalized [0, 1]
 
         #ifdef PLANE
-        // Set cmd based on percent and trim, min, max
+        // Set command based on percent and trim, min, max
         if (percent <= 50.0f) {
             // Scale [0, 50] to [min, trim]
-            cmd = motor->min + (percent / 50.0f) * (motor->trim - motor->min);
+            percent = motor->min + (percent / 50.0f) * (motor->trim - motor->min);
         } else {
             // Scale [50, 100] to [trim, max]
-            cmd = motor->trim + ((percent - 50.0f) / 50.0f) * (motor->max - motor->trim);
+            percent = motor->trim + ((percent - 50.0f) / 50.0f) * (motor->max - motor->trim);
         }
+        command = percent / 100.0f;
         #endif
         
         #ifdef QUADCOPTER
         if (!armedFlag || failsafeTriggered) {
             percent = 0;
         } else if (!groundIdle) {
-            percent = motSpinMin + percent * (motSpinMax - motSpinMin);
+            percent = motSpinMin + thrustCurve.thrustToActuator(percent) * (motSpinMax - motSpinMin);
         }
-        cmd = percent * 100;
+        command = percent;
         #endif
 
-        // Clamp cmd to [0, 100], safety check
-        if (cmd > 100) {
-            cmd = 100;
-        } else if (cmd < 0) {
-            cmd = 0;
+        // Clamp command to [0, 1], safety check that also catches NaN
+        if (!(command > 0.0f)) {
+            command = 0.0f;
+        } else if (command > 1.0f) {
+            command = 1.0f;
         }
 
         // Invert command if motor is inverted
         if (motor->isInverted) {
-            cmd = 100 - cmd;
+            command = 1.0f - command;
         }
 
         // Store for telemetry output
-        lastServoOutputs[i] = 1000 + (cmd * 10); // Convert to microseconds for telemetry
+        lastServoOutputs[i] = 1000 + static_cast<uint16_t>(command * 1000.0f + 0.5f); // Convert to microseconds for telemetry
 
         // Set arm flag for throttle motors, only on arm/disarm edges
         if (setArmFlag) {
 
-            #ifdef PLANE
-            bool armed = (motor->function == MotorFunction_e::THROTTLE) ? armedFlag : true;
-            #endif
-            
-            #ifdef QUADCOPTER
-            bool armed = (motor->function == MotorFunction_e::MOTOR_1 || motor->function == MotorFunction_e::MOTOR_2 
-                || motor->function == MotorFunction_e::MOTOR_3 || motor->function == MotorFunction_e::MOTOR_4) ? armedFlag : true;  
-            #endif
+            bool armed = isThrottleMotor(motor->function) ? armedFlag : true;
 
             motor->motorInstance->setArm(armed);
         }
 
         // Send command to motor
-        motor->motorInstance->set(cmd);
+        motor->motorInstance->setNormalized(command);
     }
 }
 
@@ -463,6 +557,57 @@ void AttitudeManager::sendGPSDataToTelemetryManager(const GpsData_t &gpsData) {
     tmQueue->push(&gpsDataMsg);
 }
 
+bool AttitudeManager::isValidSchedulingRateHz(int rateHz) {
+    return rateHz >= MIN_SCHEDULING_RATE_HZ && rateHz <= RTOS_TICK_RATE_HZ && (RTOS_TICK_RATE_HZ % rateHz) == 0;
+}
+
+uint16_t AttitudeManager::getConfiguredSchedulingRateHz(const ParamRegistry &params) {
+    int rateHz = static_cast<int>(params.get(ZP_PARAM_ID::SCHED_LOOP_RATE));
+    return isValidSchedulingRateHz(rateHz) ? static_cast<uint16_t>(rateHz) : AM_DEFAULT_SCHEDULING_RATE_HZ;
+}
+
+void AttitudeManager::updateNotchSampleRate() {
+    float odrHz = imuDriver->getODRHz() / imuDecimator.getFactor();
+    if (odrHz <= 0.0f || harmonicNotchConfig.sampleFreqHz <= 0.0f) return;
+
+    float relChange = std::fabs(odrHz - harmonicNotchConfig.sampleFreqHz) / harmonicNotchConfig.sampleFreqHz;
+    if (relChange < ODR_UPDATE_THRESHOLD) return;
+
+    harmonicNotchConfig.sampleFreqHz = odrHz;
+    harmonicNotchFilter.setSampleFreqHz(odrHz);
+}
+
+void AttitudeManager::updateNotchFromMotorRpm() {
+    static constexpr float SECONDS_PER_MINUTE = 60.0f;
+
+    float motorFreqHz[NUM_MOTORS];
+    uint8_t motorCount = 0;
+
+    // Every throttle output keeps its notch slot, a motor without telemetry just has its notches off
+    for (uint8_t i = 0; i < mainMotorGroup->motorCount && motorCount < NUM_MOTORS; i++) {
+        MotorInstance_t *motor = (mainMotorGroup->motors + i);
+        if (!isThrottleMotor(motor->function)) continue;
+
+        uint32_t erpm = 0;
+        if (motorPolePairs == 0 || !motor->motorInstance->readErpm(erpm)) {
+            erpm = 0;
+        }
+        motorFreqHz[motorCount++] = (motorPolePairs == 0) ? 0.0f : erpm / (motorPolePairs * SECONDS_PER_MINUTE);
+    }
+
+    harmonicNotchFilter.updateFromMotorFreqs(motorFreqHz, motorCount);
+}
+
+bool AttitudeManager::isThrottleMotor(MotorFunction_e function) {
+    #ifdef PLANE
+    return function == MotorFunction_e::THROTTLE;
+    #endif
+
+    #ifdef QUADCOPTER
+    return MotorMixing::motorIndex(function) >= 0;
+    #endif
+}
+
 void AttitudeManager::sendRawIMUDataToTelemetryManager(const RawImu_t &imuData) {
     TMMessage_t imuDataMsg = rawImuDataPack(
         systemUtilsDriver->getCurrentTimestampMs(), // time_boot_ms
@@ -505,8 +650,8 @@ void AttitudeManager::sendRangefinderDataToTelemetryManager(const RangefinderDat
 
     TMMessage_t rangefinderDataMsg = distanceSensorDataPack(
         systemUtilsDriver->getCurrentTimestampMs(), // time_boot_ms
-        ZP_PARAM::get(ZP_PARAM_ID::RNGFND_MIN),
-        ZP_PARAM::get(ZP_PARAM_ID::RNGFND_MAX),
+        params->get(ZP_PARAM_ID::RNGFND_MIN),
+        params->get(ZP_PARAM_ID::RNGFND_MAX),
         rangefinderData.distance,
         1, // id
         0.01f, // covariance from datasheet of TF02
@@ -519,6 +664,76 @@ void AttitudeManager::sendRangefinderDataToTelemetryManager(const RangefinderDat
     tmQueue->push(&rangefinderDataMsg);
 }
 
+void AttitudeManager::publishNavTelemetry(const Attitude_t &attitude) {
+    RCNavTelemetry_t nav = {};
+    nav.roll = attitude.roll;
+    nav.pitch = attitude.pitch;
+    nav.yaw = attitude.yaw;
+    nav.gpsValid = haveGpsFix;
+    nav.latitude = lastValidGps.latitude;
+    nav.longitude = lastValidGps.longitude;
+    nav.altitude = lastValidGps.altitude;
+    nav.groundSpeed = lastValidGps.groundSpeed;
+    nav.trackAngle = lastValidGps.trackAngle;
+    nav.numSatellites = lastValidGps.numSatellites;
+    rcNavTelemetry->publish(nav);
+}
+
+#ifdef QUADCOPTER
+void AttitudeManager::logAutotuneResults() {
+    static constexpr const char *AXIS_NAMES[PID3_AXES] = {"roll", "pitch", "yaw"};
+
+    // Gains printed as fixed point, the embedded printf has no float support
+    auto whole = [](float v) { return static_cast<int>(v); };
+    auto frac = [](float v) { return static_cast<int>((v - static_cast<int>(v)) * 10000.0f); };
+
+    PIDAxis_e axis;
+    while (autotuneCLAW.takeFinishedAxis(axis)) {
+        const AutotuneAxisResult_t &result = autotuneCLAW.getAxisResult(axis);
+        char msg[100];
+        if (result.status == AutotuneAxisStatus_e::CONVERGED) {
+            snprintf(msg, sizeof(msg), "Autotune %s done %u twitches %d ms P %d.%04d I %d.%04d D %d.%04d",
+                AXIS_NAMES[static_cast<uint8_t>(axis)], result.twitches, static_cast<int>(result.elapsedS * 1000.0f),
+                whole(result.kp), frac(result.kp), whole(result.ki), frac(result.ki), whole(result.kd), frac(result.kd));
+        } else {
+            snprintf(msg, sizeof(msg), "Autotune %s failed after %u twitches, gains unchanged",
+                AXIS_NAMES[static_cast<uint8_t>(axis)], result.twitches);
+        }
+        smLoggerQueue->push(&msg);
+    }
+}
+#endif
+
+void AttitudeManager::logSysIdData() {
+    static constexpr float COHERENT_THRESHOLD = 0.6f;
+
+    // A full queue drops the block, the host tool reports the gap in the sequence numbers
+    SysIdLogBlock_t block;
+    if (sysidCLAW.takeLogBlock(block) && sysIdLogQueue != nullptr) {
+        sysIdLogQueue->push(&block);
+    }
+
+    if (!sysidCLAW.takeCompletion()) return;
+
+    // Band the estimate is trustworthy over, as fixed point since the embedded printf has no float support
+    const FrequencyResponse &response = sysidCLAW.getResponse();
+    float lowHz = 0.0f;
+    float highHz = 0.0f;
+    for (uint16_t bin = 1; bin < FrequencyResponse::BIN_COUNT; bin++) {
+        FrequencyResponsePoint_t point;
+        if (!response.getPoint(bin, point) || point.coherence < COHERENT_THRESHOLD) continue;
+        if (lowHz == 0.0f) lowHz = point.freqHz;
+        highHz = point.freqHz;
+    }
+
+    char msg[100];
+    snprintf(msg, sizeof(msg), "SysID axis %u done, %u windows, coherent %d.%01d-%d.%01d Hz",
+        static_cast<unsigned>(sysidCLAW.getAxis()), response.getWindowCount(),
+        static_cast<int>(lowHz), static_cast<int>(lowHz * 10.0f) % 10,
+        static_cast<int>(highHz), static_cast<int>(highHz * 10.0f) % 10);
+    smLoggerQueue->push(&msg);
+}
+
 void AttitudeManager::sendServoOutputRawToTelemetryManager() {
     TMMessage_t servoOutputMsg = servoOutputRawPack(
         systemUtilsDriver->getCurrentTimestampMs(), // time_boot_ms
@@ -0,0 +1,318 @@
+#include <cmath>
+#include "autotune_mapping.hpp"
+#include "unit_conversions.hpp"
+
+#ifdef QUADCOPTER
+// Ranges are the ArduPilot ATC_RAT_* param ranges
+const AutotuneMapping::AxisParams_t AutotuneMapping::AXIS_PARAMS[PID3_AXES] = {
+    {ZP_PARAM_ID::ATC_RAT_RLL_P, ZP_PARAM_ID::ATC_RAT_RLL_I, ZP_PARAM_ID::ATC_RAT_RLL_D, ZP_PARAM_ID::ATC_ANG_RLL_P, true,
+        {0.01f, 0.5f}, {0.01f, 2.0f}, {0.0f, 0.05f}},
+    {ZP_PARAM_ID::ATC_RAT_PIT_P, ZP_PARAM_ID::ATC_RAT_PIT_I, ZP_PARAM_ID::ATC_RAT_PIT_D, ZP_PARAM_ID::ATC_ANG_PTCH_P, true,
+        {0.01f, 0.5f}, {0.01f, 2.0f}, {0.0f, 0.05f}},
+    {ZP_PARAM_ID::ATC_RAT_YAW_P, ZP_PARAM_ID::ATC_RAT_YAW_I, ZP_PARAM_ID::ATC_RAT_YAW_D, ZP_PARAM_ID::ATC_ANG_RLL_P, false,
+        {0.1f, 2.5f}, {0.01f, 1.0f}, {0.0f, 0.02f}},
+};
+
+AutotuneMapping::AutotuneMapping(float control_iter_period_s, StabilizeMapping &stabilize, ParamRegistry *paramRegistry) noexcept :
+    controlPeriodS(control_iter_period_s),
+    stabilizeCLAW(stabilize),
+    paramRegistry(paramRegistry != nullptr ? paramRegistry : &ZP_PARAM::registry()),
+    axesMask(0x07),
+    activeAxesMask(0x07),
+    timeConstantRatio(2.0f),
+    phase(Phase_e::DONE),
+    axis(0),
+    results{},
+    unreportedMask(0),
+    entryKp{}, entryKi{}, entryKd{}, entryAngleKp{},
+    settleTimeS(0.0f),
+    direction(1.0f),
+    twitchStartRate(0.0f),
+    twitchStartAngle(0.0f),
+    twitchSamples(0),
+    twitchRate{},
+    haveEstimate(false),
+    settledCount(0),
+    estPlantGain(0.0f),
+    estDelayS(0.0f) {}
+
+bool AutotuneMapping::setAxesMask(uint8_t newAxesMask) noexcept {
+    if (newAxesMask == 0 || newAxesMask > 0x07) return false;
+    axesMask = newAxesMask;
+    return true;
+}
+
+bool AutotuneMapping::setTimeConstantRatio(float newRatio) noexcept {
+    if (!(newRatio >= 0.5f) || newRatio > 10.0f) return false;
+    timeConstantRatio = newRatio;
+    return true;
+}
+
+const AutotuneAxisResult_t &AutotuneMapping::getAxisResult(PIDAxis_e axisId) const noexcept {
+    return results[static_cast<uint8_t>(axisId)];
+}
+
+bool AutotuneMapping::isComplete() const noexcept {
+    return phase == Phase_e::DONE;
+}
+
+bool AutotuneMapping::takeFinishedAxis(PIDAxis_e &finishedAxis) noexcept {
+    for (uint8_t i = 0; i < PID3_AXES; i++) {
+        if (unreportedMask & (1 << i)) {
+            unreportedMask &= ~(1 << i);
+            finishedAxis = static_cast<PIDAxis_e>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void AutotuneMapping::activateFlightMode() {
+    stabilizeCLAW.activateFlightMode();
+
+    activeAxesMask = axesMask;
+    unreportedMask = 0;
+    for (uint8_t i = 0; i < PID3_AXES; i++) {
+        const AxisParams_t &params = AXIS_PARAMS[i];
+        entryKp[i] = paramRegistry->get(params.rateP);
+        entryKi[i] = paramRegistry->get(params.rateI);
+        entryKd[i] = paramRegistry->get(params.rateD);
+        entryAngleKp[i] = params.hasAngleLoop ? paramRegistry->get(params.angleP) : 0.0f;
+
+        results[i] = {};
+        results[i].status = (activeAxesMask & (1 << i)) ? AutotuneAxisStatus_e::PENDING : AutotuneAxisStatus_e::SKIPPED;
+    }
+
+    startAxis(0);
+}
+
+RCMotorControlMessage_t AutotuneMapping::runControl(RCMotorControlMessage_t controlInputs, const DroneState_t &droneState) {
+    if (phase != Phase_e::DONE) {
+        results[axis].elapsedS += controlPeriodS;
+    }
+
+    // Pilot input always wins, an interrupted twitch is thrown away and the vehicle must settle again
+    if (!sticksCentred(controlInputs)) {
+        if (phase == Phase_e::TWITCH) {
+            phase = Phase_e::SETTLE;
+        }
+        settleTimeS = 0.0f;
+        return stabilizeCLAW.runControl(controlInputs, droneState);
+    }
+
+    RCMotorControlMessage_t output = stabilizeCLAW.runControl(controlInputs, droneState);
+    float *axisOutput = axis == static_cast<uint8_t>(PIDAxis_e::ROLL) ? &output.roll
+                      : axis == static_cast<uint8_t>(PIDAxis_e::PITCH) ? &output.pitch : &output.yaw;
+
+    if (phase == Phase_e::SETTLE) {
+        bool quiet = fabsf(droneState.rollRate) < SETTLE_RATE_RAD_S
+                  && fabsf(droneState.pitchRate) < SETTLE_RATE_RAD_S
+                  && fabsf(droneState.yawRate) < SETTLE_RATE_RAD_S;
+        settleTimeS = quiet ? settleTimeS + controlPeriodS : 0.0f;
+        if (settleTimeS < SETTLE_TIME_S) return output;
+
+        phase = Phase_e::TWITCH;
+        twitchSamples = 0;
+        twitchStartRate = axisRate(droneState, axis);
+        twitchStartAngle = axisAngle(droneState, axis);
+        results[axis].twitches++;
+        *axisOutput = direction * TWITCH_EFFORT;
+        return output;
+    }
+
+    if (phase != Phase_e::TWITCH) return output;
+
+    // Response so far, positive in the twitch direction
+    float rate = direction * (axisRate(droneState, axis) - twitchStartRate);
+    twitchRate[twitchSamples++] = rate;
+
+    float targetRate = axis == static_cast<uint8_t>(PIDAxis_e::YAW) ? TWITCH_RATE_YAW_RAD_S : TWITCH_RATE_RP_RAD_S;
+    bool angleExceeded = AXIS_PARAMS[axis].hasAngleLoop
+                      && fabsf(axisAngle(droneState, axis) - twitchStartAngle) >= TWITCH_ANGLE_LIMIT_RAD;
+    bool twitchDone = rate >= targetRate || angleExceeded
+                   || twitchSamples * controlPeriodS >= TWITCH_MAX_S || twitchSamples >= MAX_TWITCH_SAMPLES;
+    if (!twitchDone) {
+        *axisOutput = direction * TWITCH_EFFORT;
+        return output;
+    }
+
+    // Back to stabilize for recovery, the next twitch goes the other way
+    phase = Phase_e::SETTLE;
+    settleTimeS = 0.0f;
+    direction = -direction;
+
+    float plantGain;
+    float delayS;
+    if (fitTwitch(plantGain, delayS)) {
+        updateEstimate(plantGain, delayS);
+    }
+
+    if (haveEstimate && results[axis].twitches >= MIN_TWITCHES && settledCount >= CONVERGE_COUNT) {
+        finishAxis(commitGains() ? AutotuneAxisStatus_e::CONVERGED : AutotuneAxisStatus_e::FAILED);
+    } else if (results[axis].twitches >= MAX_TWITCHES) {
+        finishAxis(AutotuneAxisStatus_e::FAILED);
+    }
+
+    return output;
+}
+
+bool AutotuneMapping::sticksCentred(const RCMotorControlMessage_t &controlInput) noexcept {
+    return fabsf(controlInput.roll - 50.0f) <= STICK_DEADBAND
+        && fabsf(controlInput.pitch - 50.0f) <= STICK_DEADBAND
+        && fabsf(controlInput.yaw - 50.0f) <= STICK_DEADBAND;
+}
+
+float AutotuneMapping::axisRate(const DroneState_t &droneState, uint8_t axisIdx) noexcept {
+    switch (static_cast<PIDAxis_e>(axisIdx)) {
+        case PIDAxis_e::ROLL:
+            return droneState.rollRate;
+        case PIDAxis_e::PITCH:
+            return droneState.pitchRate;
+        default:
+            return droneState.yawRate;
+    }
+}
+
+float AutotuneMapping::axisAngle(const DroneState_t &droneState, uint8_t axisIdx) noexcept {
+    switch (static_cast<PIDAxis_e>(axisIdx)) {
+        case PIDAxis_e::ROLL:
+            return droneState.roll;
+        case PIDAxis_e::PITCH:
+            return droneState.pitch;
+        default:
+            return droneState.yaw;
+    }
+}
+
+float AutotuneMapping::clampToBounds(float value, float entry, GainRange_t range) noexcept {
+    if (!std::isfinite(value)) return entry;
+
+    // A ratio of 0 is still 0, so an unset gain only gets the param range
+    if (entry > 0.0f) {
+        float lower = entry / MAX_GAIN_RATIO;
+        float upper = entry * MAX_GAIN_RATIO;
+        value = value < lower ? lower : (value > upper ? upper : value);
+    }
+    return value < range.min ? range.min : (value > range.max ? range.max : value);
+}
+
+bool AutotuneMapping::commitParam(ZP_PARAM_ID id, float value) noexcept {
+    const Param_t *param = paramRegistry->getParamByIndex(static_cast<uint16_t>(id));
+    return param != nullptr && paramRegistry->setParamById(param->paramId, value);
+}
+
+void AutotuneMapping::startAxis(uint8_t first) noexcept {
+    for (uint8_t i = first; i < PID3_AXES; i++) {
+        if (results[i].status != AutotuneAxisStatus_e::PENDING) continue;
+
+        axis = i;
+        results[i].status = AutotuneAxisStatus_e::TUNING;
+        phase = Phase_e::SETTLE;
+        settleTimeS = 0.0f;
+        direction = 1.0f;
+        haveEstimate = false;
+        settledCount = 0;
+        estPlantGain = 0.0f;
+        estDelayS = 0.0f;
+        return;
+    }
+
+    phase = Phase_e::DONE;
+}
+
+void AutotuneMapping::finishAxis(AutotuneAxisStatus_e status) noexcept {
+    results[axis].status = status;
+    unreportedMask |= 1 << axis;
+    startAxis(axis + 1);
+}
+
+bool AutotuneMapping::fitTwitch(float &plantGain, float &delayS) const noexcept {
+    float peak = 0.0f;
+    for (uint16_t i = 0; i < twitchSamples; i++) {
+        peak = fmaxf(peak, twitchRate[i]);
+    }
+
+    float targetRate = axis == static_cast<uint8_t>(PIDAxis_e::YAW) ? TWITCH_RATE_YAW_RAD_S : TWITCH_RATE_RP_RAD_S;
+    if (peak < MIN_RESPONSE_RATIO * targetRate) return false;
+
+    // Least squares line through the ramp once the response is well clear of the motor lag
+    uint16_t start = 0;
+    while (start < twitchSamples && twitchRate[start] < FIT_START_RATIO * peak) {
+        start++;
+    }
+
+    float n = 0.0f;
+    float sumT = 0.0f;
+    float sumR = 0.0f;
+    float sumTT = 0.0f;
+    float sumTR = 0.0f;
+    for (uint16_t i = start; i < twitchSamples; i++) {
+        float t = (i + 1) * controlPeriodS; // Sample i sees i + 1 periods of effort
+        n += 1.0f;
+        sumT += t;
+        sumR += twitchRate[i];
+        sumTT += t * t;
+        sumTR += t * twitchRate[i];
+    }
+    if (n < 3.0f) return false;
+
+    float den = n * sumTT - sumT * sumT;
+    if (den <= 0.0f) return false;
+    float slope = (n * sumTR - sumT * sumR) / den;
+    if (!(slope > 0.0f)) return false;
+
+    // The ramp extrapolated back to zero rate marks the apparent dead time, at least one control period
+    float intercept = (sumR - slope * sumT) / n;
+    plantGain = slope / TWITCH_EFFORT;
+    delayS = fmaxf(-intercept / slope, controlPeriodS);
+    return true;
+}
+
+void AutotuneMapping::updateEstimate(float plantGain, float delayS) noexcept {
+    if (!haveEstimate) {
+        estPlantGain = plantGain;
+        estDelayS = delayS;
+        haveEstimate = true;
+        settledCount = 0;
+    } else {
+        bool gainSettled = fabsf(plantGain - estPlantGain) <= CONVERGE_TOLERANCE * estPlantGain;
+        bool delaySettled = fabsf(delayS - estDelayS) <= fmaxf(CONVERGE_TOLERANCE * estDelayS, controlPeriodS);
+        settledCount = (gainSettled && delaySettled) ? settledCount + 1 : 0;
+
+        estPlantGain += ESTIMATE_FILTER * (plantGain - estPlantGain);
+        estDelayS += ESTIMATE_FILTER * (delayS - estDelayS);
+    }
+
+    results[axis].plantGain = estPlantGain;
+    results[axis].delayS = estDelayS;
+}
+
+bool AutotuneMapping::commitGains() noexcept {
+    // SIMC for an integrating plant with dead time L: Kc = 1 / (K (tc + L)), Ti = 4 (tc + L).
+    // D covers the lag lumped into L with Td = L / 2
+    float closedLoopS = (timeConstantRatio + 1.0f) * estDelayS;
+    float kp = 1.0f / (estPlantGain * closedLoopS);
+    float ki = kp / (4.0f * closedLoopS);
+    float kd = kp * 0.5f * estDelayS;
+
+    const AxisParams_t &params = AXIS_PARAMS[axis];
+    AutotuneAxisResult_t &result = results[axis];
+    result.kp = clampToBounds(kp, entryKp[axis], params.ratePRange);
+    result.ki = clampToBounds(ki, entryKi[axis], params.rateIRange);
+    result.kd = clampToBounds(kd, entryKd[axis], params.rateDRange);
+
+    bool committed = commitParam(params.rateP, result.kp)
+                  && commitParam(params.rateI, result.ki)
+                  && commitParam(params.rateD, result.kd);
+
+    // The angle loop outputs a fraction of the acro rate limit, aim it slower than the rate loop
+    float rateLimit = ZP_UNITS::deg2rad(paramRegistry->get(ZP_PARAM_ID::ACRO_RP_RATE));
+    if (committed && params.hasAngleLoop && rateLimit > 0.0f) {
+        GainRange_t angleRange = {ANGLE_P_MIN / rateLimit, ANGLE_P_MAX / rateLimit};
+        result.angleKp = clampToBounds(1.0f / (ANGLE_TO_RATE_TC_RATIO * closedLoopS * rateLimit), entryAngleKp[axis], angleRange);
+        committed = commitParam(params.angleP, result.angleKp);
+    }
+
+    return committed;
+}
+#endif
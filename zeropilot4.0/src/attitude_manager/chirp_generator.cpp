@@ -0,0 +1,72 @@
+#include <cmath>
+#include "chirp_generator.hpp"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846f
+#endif
+
+ChirpGenerator::ChirpGenerator() noexcept :
+    fStartHz(1.0f),
+    fStopHz(1.0f),
+    recordS(0.0f),
+    fadeInS(0.0f),
+    fadeOutS(0.0f),
+    logRatio(0.0f),
+    elapsedS(0.0f),
+    phaseRad(0.0f),
+    frequencyHz(0.0f) {}
+
+bool ChirpGenerator::init(float newFStartHz, float newFStopHz, float newRecordS, float newFadeInS, float newFadeOutS) noexcept {
+    if (!(newFStartHz > 0.0f) || !(newFStopHz > newFStartHz) || !(newRecordS > 0.0f) ||
+        newFadeInS < 0.0f || newFadeOutS < 0.0f) {
+        return false;
+    }
+
+    fStartHz = newFStartHz;
+    fStopHz = newFStopHz;
+    recordS = newRecordS;
+    fadeInS = newFadeInS;
+    fadeOutS = newFadeOutS;
+    logRatio = logf(fStopHz / fStartHz);
+    reset();
+    return true;
+}
+
+void ChirpGenerator::reset() noexcept {
+    elapsedS = 0.0f;
+    phaseRad = 0.0f;
+    frequencyHz = fStartHz;
+}
+
+float ChirpGenerator::update(float dtS) noexcept {
+    if (isComplete()) {
+        frequencyHz = 0.0f;
+        return 0.0f;
+    }
+
+    float amplitude = 1.0f;
+    if (elapsedS < fadeInS) {
+        frequencyHz = fStartHz;
+        amplitude = elapsedS / fadeInS;
+    } else if (elapsedS < fadeInS + recordS) {
+        frequencyHz = fStartHz * expf(logRatio * (elapsedS - fadeInS) / recordS);
+    } else {
+        frequencyHz = fStopHz;
+        amplitude = 1.0f - (elapsedS - fadeInS - recordS) / fadeOutS;
+    }
+
+    float out = amplitude * sinf(phaseRad);
+
+    phaseRad += 2.0f * static_cast<float>(M_PI) * frequencyHz * dtS;
+    if (phaseRad >= 2.0f * static_cast<float>(M_PI)) {
+        phaseRad -= 2.0f * static_cast<float>(M_PI);
+    }
+    elapsedS += dtS;
+
+    return out;
+}
+
+float ChirpGenerator::getFrequencyHz() const noexcept { return frequencyHz; }
+float ChirpGenerator::getElapsedS() const noexcept { return elapsedS; }
+float ChirpGenerator::getDurationS() const noexcept { return fadeInS + recordS + fadeOutS; }
+bool ChirpGenerator::isComplete() const noexcept { return elapsedS >= getDurationS(); }
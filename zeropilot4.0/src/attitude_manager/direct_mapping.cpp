@@ -1,9 +1,10 @@
 #include "direct_mapping.hpp"
+#include "tcm_placement.hpp"
 
 void DirectMapping::activateFlightMode() {
     // No activation tasks for DirectMapping
 }
 
-RCMotorControlMessage_t DirectMapping::runControl(RCMotorControlMessage_t controlInputs, const DroneState_t &droneState){
+ZP_FAST_CODE RCMotorControlMessage_t DirectMapping::runControl(RCMotorControlMessage_t controlInputs, const DroneState_t &droneState){
     return controlInputs;
 }
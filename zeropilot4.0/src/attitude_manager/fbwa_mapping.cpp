@@ -1,4 +1,5 @@
 #include "fbwa_mapping.hpp"
+#include "tcm_placement.hpp"
 #include "unit_conversions.hpp"
 #include <algorithm>
 
@@ -91,7 +92,7 @@ void FBWAMapping::activateFlightMode() {
 }
 
 // Main control mapping function for FBWA mode
-RCMotorControlMessage_t FBWAMapping::runControl(RCMotorControlMessage_t controlInputs, const DroneState_t &droneState){
+ZP_FAST_CODE RCMotorControlMessage_t FBWAMapping::runControl(RCMotorControlMessage_t controlInputs, const DroneState_t &droneState){
     // Roll SP: Maps [0, 100] to [-limit, +limit]
     float rollSetpoint = ((controlInputs.roll / MAX_RC_INPUT_VAL) * 2.0f - 1.0f) * rollLimitRad;
 
@@ -1,4 +1,5 @@
 #include "fft_harmonic_notch.hpp"
+#include "tcm_placement.hpp"
 #include <cmath>
 
 #ifndef M_PI
@@ -36,17 +37,24 @@ bool FFTHarmonicNotch::init(const FFTHarmonicNotchConfig &notchConfig) {
     a = powf(10.0f, -config.attenuationDB / 40.0f);
     q = config.minFreqHz / config.bandwidthHz;
 
-    // Initialize CMSIS-DSP FFT Instance
-    if (fftDriver == nullptr || !fftDriver->init(config.fftWindowSize)) {
-        initialized = false;
-        return false;
-    }
-
     fftIndex = 0;
 
-    // Pre-compute the Hanning Window to save FPU cycles during runtime
-    for (int i = 0; i < config.fftWindowSize; i++) {
-        hanningWindow[i] = 0.5f * (1.0f - mathUtilsDriver->dspCosf(2.0f * M_PI * i / (config.fftWindowSize - 1)));
+    // RPM driven notches don't need the FFT
+    if (config.mode == HarmonicNotchMode_e::FFT) {
+        // Initialize CMSIS-DSP FFT Instance
+        if (fftDriver == nullptr || !fftDriver->init(config.fftWindowSize)) {
+            initialized = false;
+            return false;
+        }
+
+        // Pre-compute the Hanning Window to save FPU cycles during runtime
+        for (int i = 0; i < config.fftWindowSize; i++) {
+            hanningWindow[i] = 0.5f * (1.0f - mathUtilsDriver->dspCosf(2.0f * M_PI * i / (config.fftWindowSize - 1)));
+        }
+    }
+
+    for (uint8_t i = 0; i < FFT_NOTCH_MAX_HARMONICS; i++) {
+        filters[i].enabled = false;
     }
 
     // Reset filter states and mark as initialized
@@ -56,8 +64,8 @@ bool FFTHarmonicNotch::init(const FFTHarmonicNotchConfig &notchConfig) {
     return true;
 }
 
-bool FFTHarmonicNotch::pushSample(float gx, float gy, float gz) {
-    if (!initialized) return false;
+ZP_FAST_CODE bool FFTHarmonicNotch::pushSample(float gx, float gy, float gz) {
+    if (!initialized || config.mode != HarmonicNotchMode_e::FFT) return false;
     if (fftIndex >= config.fftWindowSize) return false;
 
     // Accumulate RMS energy for this FFT window
@@ -142,9 +150,6 @@ bool FFTHarmonicNotch::pushSample(float gx, float gy, float gz) {
 }
 
 void FFTHarmonicNotch::updateFilters(float peakFreqHz) {
-    static constexpr float NYQUIST_SAFETY_FACTOR = 0.48f;
-    const float NYQUIST_LIMIT = config.sampleFreqHz * NYQUIST_SAFETY_FACTOR;
-
     for (uint8_t i = 0; i < FFT_NOTCH_MAX_HARMONICS; i++) {
         // Check if this harmonic bit is enabled in the mask
         if (!((1U << i) & config.harmonicsMask)) {
@@ -152,21 +157,47 @@ void FFTHarmonicNotch::updateFilters(float peakFreqHz) {
             continue;
         }
 
-        float harmonicFreq = peakFreqHz * (i + 1);
+        setFilterFreq(i, peakFreqHz * (i + 1));
+    }
+}
 
-        // Disable filter if it exceeds Nyquist or drops below the minimum configured frequency
-        if (harmonicFreq >= NYQUIST_LIMIT || harmonicFreq < config.minFreqHz) {
-            filters[i].enabled = false;
-            continue;
+void FFTHarmonicNotch::updateFromMotorFreqs(const float *motorFreqHz, uint8_t motorCount) {
+    if (!initialized || config.mode != HarmonicNotchMode_e::ESC_RPM) return;
+
+    uint8_t filterIndex = 0;
+    for (uint8_t harmonic = 0; harmonic < FFT_NOTCH_MAX_HARMONICS; harmonic++) {
+        if (!((1U << harmonic) & config.harmonicsMask)) continue;
+
+        for (uint8_t motor = 0; motor < motorCount && filterIndex < FFT_NOTCH_MAX_HARMONICS; motor++) {
+            setFilterFreq(filterIndex++, motorFreqHz[motor] * (harmonic + 1));
         }
+    }
+
+    for (; filterIndex < FFT_NOTCH_MAX_HARMONICS; filterIndex++) {
+        filters[filterIndex].enabled = false;
+    }
+}
+
+void FFTHarmonicNotch::setFilterFreq(uint8_t index, float freqHz) {
+    static constexpr float NYQUIST_SAFETY_FACTOR = 0.48f;
+    const float NYQUIST_LIMIT = config.sampleFreqHz * NYQUIST_SAFETY_FACTOR;
+
+    // Disable filter if it exceeds Nyquist or drops below the minimum configured frequency
+    if (freqHz >= NYQUIST_LIMIT || freqHz < config.minFreqHz) {
+        filters[index].enabled = false;
+        return;
+    }
 
-        // Update coefficients for this specific harmonic
-        filters[i].updateCoefficients(mathUtilsDriver, config.sampleFreqHz, harmonicFreq, a, q);
-        filters[i].enabled = true;
+    // A filter coming back on starts from clean history rather than whatever it held last
+    if (!filters[index].enabled) {
+        filters[index].resetStates();
     }
+
+    filters[index].updateCoefficients(mathUtilsDriver, config.sampleFreqHz, freqHz, a, q);
+    filters[index].enabled = true;
 }
 
-void FFTHarmonicNotch::apply(float& gx, float& gy, float& gz) {
+ZP_FAST_CODE void FFTHarmonicNotch::apply(float& gx, float& gy, float& gz) {
     if (!initialized) return;
 
     for (uint8_t i = 0; i < FFT_NOTCH_MAX_HARMONICS; i++) {
@@ -188,6 +219,13 @@ void FFTHarmonicNotch::reset() {
     dominantAxis = GyroAxis_e::X;
 }
 
+bool FFTHarmonicNotch::setSampleFreqHz(float sampleFreqHz) {
+    if (sampleFreqHz <= 0.0f) return false;
+
+    config.sampleFreqHz = sampleFreqHz;
+    return true; // Notch coefficients pick up the new rate on the next FFT cycle
+}
+
 // ---------------------------------------------------------
 // Bi-Quadratic Filter Mathematical Implementation
 // ---------------------------------------------------------
@@ -198,15 +236,16 @@ void FFTHarmonicNotch::BiquadState::updateCoefficients(IMathUtils *mathUtilsDriv
     float cs = mathUtilsDriver->dspCosf(omega);
     float alpha = sn / (2.0f * q);
 
-    float a0 = 1.0f + alpha * A;
-    b0 = (1.0f + alpha) / a0;
+    // Gain at the centre is A^2, the attenuation depth
+    float a0 = 1.0f + alpha;
+    b0 = (1.0f + alpha * A * A) / a0;
     b1 = (-2.0f * cs) / a0;
-    b2 = (1.0f - alpha) / a0;
+    b2 = (1.0f - alpha * A * A) / a0;
     a1 = b1;
-    a2 = (1.0f - alpha * A) / a0;
+    a2 = (1.0f - alpha) / a0;
 }
 
-void FFTHarmonicNotch::BiquadState::applyTriAxis(float &gx, float &gy, float &gz) {
+ZP_FAST_CODE void FFTHarmonicNotch::BiquadState::applyTriAxis(float &gx, float &gy, float &gz) {
     // X Axis
     float outX = b0 * gx + b1 * x1X + b2 * x2X - a1 * y1X - a2 * y2X;
     x2X = x1X;
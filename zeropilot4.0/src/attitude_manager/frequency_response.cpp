@@ -0,0 +1,111 @@
+#include <cmath>
+#include <cstring>
+#include "frequency_response.hpp"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846f
+#endif
+
+FrequencyResponse::FrequencyResponse(IFFT *fftDriver) noexcept :
+    fftDriver(fftDriver),
+    initialized(false),
+    sampleRateHz(0.0f),
+    fill(0),
+    windowCount(0) {
+        for (uint16_t i = 0; i < WINDOW_LEN; i++) {
+            window[i] = 0.5f * (1.0f - cosf(2.0f * static_cast<float>(M_PI) * i / (WINDOW_LEN - 1)));
+        }
+        reset();
+}
+
+bool FrequencyResponse::init(float newSampleRateHz) noexcept {
+    if (fftDriver == nullptr || !(newSampleRateHz > 0.0f) || !fftDriver->init(WINDOW_LEN)) {
+        initialized = false;
+        return false;
+    }
+
+    sampleRateHz = newSampleRateHz;
+    reset();
+    initialized = true;
+    return true;
+}
+
+void FrequencyResponse::reset() noexcept {
+    fill = 0;
+    windowCount = 0;
+    memset(inputPower, 0, sizeof(inputPower));
+    memset(outputPower, 0, sizeof(outputPower));
+    memset(crossRe, 0, sizeof(crossRe));
+    memset(crossIm, 0, sizeof(crossIm));
+}
+
+bool FrequencyResponse::pushSample(float input, float output) noexcept {
+    if (!initialized) return false;
+
+    inputBuf[fill] = input;
+    outputBuf[fill] = output;
+    fill++;
+    if (fill < WINDOW_LEN) return false;
+
+    accumulateWindow();
+
+    // Keep the newer half as the start of the next window
+    memmove(inputBuf, inputBuf + WINDOW_LEN / 2, sizeof(float) * (WINDOW_LEN / 2));
+    memmove(outputBuf, outputBuf + WINDOW_LEN / 2, sizeof(float) * (WINDOW_LEN / 2));
+    fill = WINDOW_LEN / 2;
+    return true;
+}
+
+void FrequencyResponse::transform(const float *samples, float *spectrum) noexcept {
+    // Remove the block mean so trim offsets don't leak into the lowest bins
+    float mean = 0.0f;
+    for (uint16_t i = 0; i < WINDOW_LEN; i++) {
+        mean += samples[i];
+    }
+    mean /= WINDOW_LEN;
+
+    for (uint16_t i = 0; i < WINDOW_LEN; i++) {
+        fftInput[i] = (samples[i] - mean) * window[i];
+    }
+    fftDriver->runFFT(fftInput, spectrum, 0);
+}
+
+void FrequencyResponse::accumulateWindow() noexcept {
+    transform(inputBuf, inputSpectrum);
+    transform(outputBuf, outputSpectrum);
+
+    // Packed real FFT output: [DC, Nyquist, re1, im1, re2, im2, ...]
+    for (uint16_t bin = 1; bin < BIN_COUNT; bin++) {
+        float ur = inputSpectrum[2 * bin];
+        float ui = inputSpectrum[2 * bin + 1];
+        float yr = outputSpectrum[2 * bin];
+        float yi = outputSpectrum[2 * bin + 1];
+
+        inputPower[bin] += ur * ur + ui * ui;
+        outputPower[bin] += yr * yr + yi * yi;
+
+        // conj(U) * Y
+        crossRe[bin] += ur * yr + ui * yi;
+        crossIm[bin] += ur * yi - ui * yr;
+    }
+    windowCount++;
+}
+
+uint16_t FrequencyResponse::getWindowCount() const noexcept { return windowCount; }
+
+float FrequencyResponse::getBinFreqHz(uint16_t bin) const noexcept {
+    return bin * sampleRateHz / WINDOW_LEN;
+}
+
+bool FrequencyResponse::getPoint(uint16_t bin, FrequencyResponsePoint_t &point) const noexcept {
+    if (!initialized || windowCount == 0 || bin == 0 || bin >= BIN_COUNT) return false;
+    if (!(inputPower[bin] > 0.0f)) return false;
+
+    float crossMagSq = crossRe[bin] * crossRe[bin] + crossIm[bin] * crossIm[bin];
+
+    point.freqHz = getBinFreqHz(bin);
+    point.gain = sqrtf(crossMagSq) / inputPower[bin];
+    point.phaseDeg = atan2f(crossIm[bin], crossRe[bin]) * 180.0f / static_cast<float>(M_PI);
+    point.coherence = (outputPower[bin] > 0.0f) ? crossMagSq / (inputPower[bin] * outputPower[bin]) : 0.0f;
+    return true;
+}
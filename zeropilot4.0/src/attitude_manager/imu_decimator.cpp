@@ -0,0 +1,196 @@
+#include "imu_decimator.hpp"
+#include "tcm_placement.hpp"
+#include <cmath>
+
+static constexpr float PI_F = 3.14159265358979f;
+
+bool ImuDecimator::init(const ImuDecimatorConfig &decimatorConfig) {
+    config = decimatorConfig;
+    factor = 1;
+    numTaps = 0;
+    groupDelayS = 0.0f;
+    outputRateHz = config.inputRateHz;
+    initialized = false;
+    reset();
+
+    if (config.inputRateHz <= 0.0f || config.outputRateHz <= 0.0f || config.outputRateHz > config.inputRateHz) {
+        return false;
+    }
+
+    long m = std::lround(config.inputRateHz / config.outputRateHz);
+    if (m < 1 || m > MAX_FACTOR) {
+        return false;
+    }
+
+    factor = static_cast<uint8_t>(m);
+    outputRateHz = config.inputRateHz / factor;
+
+    if (factor > 1) {
+        switch (config.filter) {
+            case DecimationFilter_e::FIR:
+                designFir();
+                groupDelayS = (numTaps - 1) * 0.5f / config.inputRateHz;
+                break;
+            case DecimationFilter_e::CIC:
+                cicGain = 1.0f / (CIC_SCALE * factor * factor * factor);
+                groupDelayS = CIC_ORDER * (factor - 1) * 0.5f / config.inputRateHz;
+                break;
+            case DecimationFilter_e::NONE:
+            default:
+                break;
+        }
+    }
+
+    initialized = true;
+    return true;
+}
+
+void ImuDecimator::reset() {
+    for (uint8_t i = 0; i < MAX_IMUS; i++) {
+        state[i] = {};
+    }
+}
+
+void ImuDecimator::designFir() {
+    // Windowed-sinc low pass, taps scale with the factor so every polyphase branch keeps the same length
+    uint16_t n = FIR_TAPS_PER_PHASE * factor;
+    numTaps = n > FIR_MAX_TAPS ? FIR_MAX_TAPS : n;
+
+    float cutoff = FIR_CUTOFF_RATIO * 0.5f / factor; // Cycles per input sample
+    float centre = (numTaps - 1) * 0.5f;
+    float sum = 0.0f;
+
+    for (uint16_t k = 0; k < numTaps; k++) {
+        float x = k - centre;
+        float sinc = (x == 0.0f) ? 2.0f * cutoff : std::sin(2.0f * PI_F * cutoff * x) / (PI_F * x);
+        float window = 0.54f - 0.46f * std::cos(2.0f * PI_F * k / (numTaps - 1));
+        taps[k] = sinc * window;
+        sum += taps[k];
+    }
+
+    // Unity DC gain
+    for (uint16_t k = 0; k < numTaps; k++) {
+        taps[k] /= sum;
+    }
+}
+
+ZP_FAST_CODE void ImuDecimator::runFir(const ImuState &s, float (&out)[LANES]) const {
+    float acc[LANES] = {};
+    const float (*window)[LANES] = &s.history[s.head];
+
+    for (uint16_t k = 0; k < numTaps; k++) {
+        const float tap = taps[k];
+        for (uint8_t l = 0; l < LANES; l++) {
+            acc[l] += tap * window[k][l];
+        }
+    }
+
+    for (uint8_t l = 0; l < LANES; l++) {
+        out[l] = acc[l];
+    }
+}
+
+ZP_FAST_CODE void ImuDecimator::runCicComb(ImuState &s, float (&out)[LANES]) {
+    uint64_t v[LANES];
+    for (uint8_t l = 0; l < LANES; l++) {
+        v[l] = s.integrator[CIC_ORDER - 1][l];
+    }
+
+    for (uint8_t stage = 0; stage < CIC_ORDER; stage++) {
+        for (uint8_t l = 0; l < LANES; l++) {
+            uint64_t delayed = s.combDelay[stage][l];
+            s.combDelay[stage][l] = v[l];
+            v[l] -= delayed;
+        }
+    }
+
+    for (uint8_t l = 0; l < LANES; l++) {
+        out[l] = static_cast<float>(static_cast<int64_t>(v[l])) * cicGain;
+    }
+}
+
+ZP_FAST_CODE bool ImuDecimator::pushSample(ImuState &s, const float (&lane)[LANES], float (&out)[LANES]) {
+    switch (config.filter) {
+        case DecimationFilter_e::FIR:
+            for (uint8_t l = 0; l < LANES; l++) {
+                s.history[s.head][l] = lane[l];
+                s.history[s.head + numTaps][l] = lane[l];
+            }
+            s.head = (s.head + 1) % numTaps;
+            break;
+        case DecimationFilter_e::CIC:
+            for (uint8_t l = 0; l < LANES; l++) {
+                s.integrator[0][l] += static_cast<uint64_t>(static_cast<int64_t>(std::floor(lane[l] * CIC_SCALE + 0.5f)));
+            }
+            for (uint8_t stage = 1; stage < CIC_ORDER; stage++) {
+                for (uint8_t l = 0; l < LANES; l++) {
+                    s.integrator[stage][l] += s.integrator[stage - 1][l];
+                }
+            }
+            break;
+        case DecimationFilter_e::NONE:
+        default:
+            break;
+    }
+
+    if (++s.phase < factor) {
+        return false;
+    }
+    s.phase = 0;
+
+    // Polyphase: the filter is only evaluated at the decimation instants
+    switch (config.filter) {
+        case DecimationFilter_e::FIR:
+            runFir(s, out);
+            break;
+        case DecimationFilter_e::CIC:
+            runCicComb(s, out);
+            break;
+        case DecimationFilter_e::NONE:
+        default:
+            for (uint8_t l = 0; l < LANES; l++) {
+                out[l] = lane[l];
+            }
+            break;
+    }
+    return true;
+}
+
+ZP_FAST_CODE ScaledImuBatch_t ImuDecimator::process(const ScaledImuBatch_t &in) {
+    if (!initialized || factor <= 1) {
+        return in;
+    }
+
+    ScaledImuBatch_t result = {output, 0, in.readTime};
+
+    for (uint16_t i = 0; i < in.count; i++) {
+        const ScaledImu_t &sample = in.data[i];
+        if (sample.imuId >= MAX_IMUS) continue;
+
+        const float lane[LANES] = {
+            sample.xacc, sample.yacc, sample.zacc,
+            sample.xgyro, sample.ygyro, sample.zgyro,
+            0.0f, 0.0f
+        };
+        float out[LANES];
+
+        if (!pushSample(state[sample.imuId], lane, out)) continue;
+
+        if (result.count >= MAX_OUTPUT) {
+            overflowCount++;
+            continue;
+        }
+
+        ScaledImu_t &decimated = output[result.count++];
+        decimated.xacc = out[0];
+        decimated.yacc = out[1];
+        decimated.zacc = out[2];
+        decimated.xgyro = out[3];
+        decimated.ygyro = out[4];
+        decimated.zgyro = out[5];
+        decimated.timestampUs = sample.timestampUs;
+        decimated.imuId = sample.imuId;
+    }
+
+    return result;
+}
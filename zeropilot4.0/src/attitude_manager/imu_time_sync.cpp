@@ -0,0 +1,123 @@
+#include "imu_time_sync.hpp"
+#include <cmath>
+
+ImuTimeSync::ImuTimeSync(float nominalTickUs, float nominalOdrHz) noexcept :
+    nominalTickUs(nominalTickUs),
+    nominalOdrHz(nominalOdrHz),
+    lastReadUs(0),
+    lastReadRawUs(0),
+    haveReadTime(false),
+    lastEmittedUs(0) {
+        reset();
+}
+
+void ImuTimeSync::reset() noexcept {
+    ratio = nominalTickUs;
+    offsetUs = 0.0;
+    refTicks = 0;
+    lastHwTicks = 0;
+    samplePeriodTicks = 0.0f;
+    lockCount = 0;
+    synced = false;
+}
+
+uint64_t ImuTimeSync::unwrapReadTime(uint32_t readTimeUs) noexcept {
+    if (!haveReadTime) {
+        haveReadTime = true;
+        lastReadRawUs = readTimeUs;
+        lastReadUs = readTimeUs;
+        return lastReadUs;
+    }
+
+    // Unsigned subtraction absorbs the 32-bit DWT wraparound
+    uint64_t readUs = lastReadUs + (uint32_t)(readTimeUs - lastReadRawUs);
+    lastReadRawUs = readTimeUs;
+    return readUs;
+}
+
+uint64_t ImuTimeSync::ticksToUs(int64_t ticks) const noexcept {
+    double us = offsetUs + (double)ratio * (double)(ticks - refTicks);
+    return us > 0.0 ? (uint64_t)us : 0;
+}
+
+void ImuTimeSync::stampBatch(RawImu_t *data, uint16_t count, uint32_t readTimeUs) noexcept {
+    if (data == nullptr || count == 0) return;
+
+    uint64_t readUs = unwrapReadTime(readTimeUs);
+    uint16_t newestHw = (uint16_t)data[count - 1].timestamp;
+
+    if (!synced) {
+        // Hard sync: anchor the newest sample to the read time
+        refTicks = newestHw;
+        offsetUs = (double)readUs;
+        synced = true;
+    } else {
+        // The 16-bit counter wraps every ~65 ms, use elapsed DWT time to recover the missing wraps
+        uint16_t deltaHw = newestHw - lastHwTicks;
+        double expectedTicks = (double)(readUs - lastReadUs) / ratio;
+        int64_t wraps = (int64_t)std::llround((expectedTicks - deltaHw) / HW_TICK_RANGE);
+        if (wraps < 0) wraps = 0;
+        int64_t deltaTicks = deltaHw + wraps * HW_TICK_RANGE;
+
+        double predictedUs = offsetUs + (double)ratio * deltaTicks;
+        double phaseErrUs = (double)readUs - predictedUs;
+
+        if (std::fabs(phaseErrUs) > RESYNC_THRESHOLD_US) {
+            offsetUs = (double)readUs;
+            lockCount = 0;
+        } else {
+            offsetUs = predictedUs + PLL_KP * phaseErrUs;
+            if (deltaTicks > 0) {
+                ratio += PLL_KI * (float)(phaseErrUs / deltaTicks);
+            }
+            if (lockCount < LOCK_BATCHES) lockCount++;
+        }
+
+        const float ratioMin = nominalTickUs * (1.0f - MAX_RATIO_DEVIATION);
+        const float ratioMax = nominalTickUs * (1.0f + MAX_RATIO_DEVIATION);
+        if (ratio < ratioMin) ratio = ratioMin;
+        if (ratio > ratioMax) ratio = ratioMax;
+
+        refTicks += deltaTicks;
+
+        // Every sample in this batch arrived after the previous batch's newest sample
+        if (deltaTicks > 0) {
+            float period = (float)deltaTicks / count;
+            samplePeriodTicks = (samplePeriodTicks == 0.0f) ? period : samplePeriodTicks + ODR_FILTER_ALPHA * (period - samplePeriodTicks);
+        }
+    }
+
+    lastHwTicks = newestHw;
+    lastReadUs = readUs;
+
+    // Walk back from the newest sample, deltas between FIFO neighbours never exceed the 16-bit range
+    int64_t ticks = refTicks;
+    uint16_t prevHw = newestHw;
+    for (int i = count - 1; i >= 0; i--) {
+        uint16_t hw = (uint16_t)data[i].timestamp;
+        ticks -= (uint16_t)(prevHw - hw);
+        prevHw = hw;
+        data[i].timestampUs = ticksToUs(ticks);
+    }
+
+    // Enforce strictly increasing output across batches and resyncs
+    for (int i = 0; i < count; i++) {
+        if (data[i].timestampUs <= lastEmittedUs) {
+            data[i].timestampUs = lastEmittedUs + 1;
+        }
+        lastEmittedUs = data[i].timestampUs;
+    }
+}
+
+float ImuTimeSync::getMeasuredODRHz() const noexcept {
+    if (samplePeriodTicks <= 0.0f) return nominalOdrHz;
+    return 1000000.0f / (samplePeriodTicks * ratio);
+}
+
+float ImuTimeSync::getTickRatio() const noexcept {
+    return ratio;
+}
+
+bool ImuTimeSync::isLocked() const noexcept {
+    return lockCount >= LOCK_BATCHES;
+}
@@ -1,7 +1,8 @@
 #include "motor_mixing.hpp"
+#include "tcm_placement.hpp"
 
 #ifdef PLANE
-void MotorMixing::fixedWingMoterMixer(const RCMotorControlMessage_t outputControlMsg,  MotorGroupInstance_t *mainMotorGroup, float* motorPercent) {
+ZP_FAST_CODE void MotorMixing::fixedWingMoterMixer(const RCMotorControlMessage_t outputControlMsg,  MotorGroupInstance_t *mainMotorGroup, float* motorPercent) {
     for (uint8_t i = 0; i < mainMotorGroup->motorCount; i++) {
         switch (mainMotorGroup->motors[i].function) {
             case MotorFunction_e::AILERON: 
@@ -31,42 +32,106 @@ void MotorMixing::fixedWingMoterMixer(const RCMotorControlMessage_t outputContro
 #endif
 
 #ifdef QUADCOPTER
-void MotorMixing::quadMotorMixer(const RCMotorControlMessage_t outputControlMsg,  MotorGroupInstance_t *mainMotorGroup, float* motorPercent) {   
-    static constexpr uint8_t NUM_MOTORS = 4;
-    // Each motor arm sits at 45° in the X-configuration, so its contribution to the roll/pitch axes is cos(45°) = sin(45°) = sqrt(2)/2
-    static constexpr float ARM_AXIS_PROJECTION = 0.7071067811865476f;
-    static constexpr float ROLL_FACTOR[NUM_MOTORS] = { -ARM_AXIS_PROJECTION, ARM_AXIS_PROJECTION, ARM_AXIS_PROJECTION, -ARM_AXIS_PROJECTION};
-    static constexpr float PITCH_FACTOR[NUM_MOTORS] = { ARM_AXIS_PROJECTION, -ARM_AXIS_PROJECTION, ARM_AXIS_PROJECTION, -ARM_AXIS_PROJECTION};
-    static constexpr float YAW_FACTOR[NUM_MOTORS] = { 1, 1, -1, -1};
-    static constexpr float YAW_HEADROOM = 0.2f;
+// Factors are the motor position projected on each axis, arms at angle a clockwise from the nose give
+// roll -sin(a) and pitch cos(a), yaw is +1 for counter-clockwise props. Motor order matches ArduPilot
+static constexpr float SIN_22_5 = 0.3826834323650898f;
+static constexpr float COS_22_5 = 0.9238795325112867f;
+static constexpr float SIN_45 = 0.7071067811865476f;
+static constexpr float SIN_60 = 0.8660254037844386f;
 
-    // Roll, pitch, yaw in range [-1, 1], throttle in [0,1]
-    float roll = outputControlMsg.roll;
-    float pitch = outputControlMsg.pitch;
-    float yaw = outputControlMsg.yaw;
-    float throttle = outputControlMsg.throttle; 
-    float mixed[NUM_MOTORS] = {0};
+static const MixerFrame_t QUAD_X = {
+    4,
+    { -SIN_45,  SIN_45,  SIN_45, -SIN_45 },
+    {  SIN_45, -SIN_45,  SIN_45, -SIN_45 },
+    {  1,       1,      -1,      -1      }
+};
+
+static const MixerFrame_t QUAD_PLUS = {
+    4,
+    { -1, 1, 0,  0 },
+    {  0, 0, 1, -1 },
+    {  1, 1, -1, -1 }
+};
+
+static const MixerFrame_t HEXA_X = {
+    6,
+    { -1, 1,  0.5f,   -0.5f,   -0.5f,   0.5f   },
+    {  0, 0,  SIN_60, -SIN_60,  SIN_60, -SIN_60 },
+    { -1, 1, -1,       1,       1,      -1      }
+};
+
+static const MixerFrame_t HEXA_PLUS = {
+    6,
+    {  0, 0,  SIN_60, -SIN_60,  SIN_60, -SIN_60 },
+    {  1, -1, -0.5f,   0.5f,    0.5f,   -0.5f   },
+    { -1, 1, -1,       1,       1,      -1      }
+};
 
-    // Ensure the maximum average throttle across the 4 motors are at least the throttle commanded and never exceeds the set max
+static const MixerFrame_t OCTA_X = {
+    8,
+    { -SIN_22_5,  SIN_22_5, -COS_22_5, -SIN_22_5, SIN_22_5,  COS_22_5, COS_22_5, -COS_22_5 },
+    {  COS_22_5, -COS_22_5,  SIN_22_5, -COS_22_5, COS_22_5, -SIN_22_5, SIN_22_5, -SIN_22_5 },
+    { -1,        -1,         1,         1,        1,         1,        -1,       -1        }
+};
+
+static const MixerFrame_t OCTA_PLUS = {
+    8,
+    {  0,  0, -SIN_45, -SIN_45, SIN_45,  SIN_45, 1, -1 },
+    {  1, -1,  SIN_45, -SIN_45, SIN_45, -SIN_45, 0,  0 },
+    { -1, -1, 1, 1,  1,       1,      -1,      -1      }
+};
+
+// Coaxial pairs on arms at +-60 and 180 degrees, top and bottom props spin opposite ways
+static const MixerFrame_t Y6 = {
+    6,
+    { -SIN_60, SIN_60, SIN_60,  0,    -SIN_60,  0    },
+    {  0.5f,   0.5f,   0.5f,   -1,     0.5f,   -1    },
+    { -1,     -1,      1,      -1,     1,       1    }
+};
+
+const MixerFrame_t *MotorMixing::frameFor(FrameClass_e frameClass, FrameType_e frameType) {
+    switch (frameClass) {
+        case FrameClass_e::QUAD:
+            return (frameType == FrameType_e::PLUS) ? &QUAD_PLUS : (frameType == FrameType_e::X) ? &QUAD_X : nullptr;
+        case FrameClass_e::HEXA:
+            return (frameType == FrameType_e::PLUS) ? &HEXA_PLUS : (frameType == FrameType_e::X) ? &HEXA_X : nullptr;
+        case FrameClass_e::OCTA:
+            return (frameType == FrameType_e::PLUS) ? &OCTA_PLUS : (frameType == FrameType_e::X) ? &OCTA_X : nullptr;
+        case FrameClass_e::Y6:
+            return &Y6;
+        default:
+            return nullptr;
+    }
+}
+
+ZP_FAST_CODE void MotorMixing::mixFrame(const MixerFrame_t &frame, float roll, float pitch, float yaw, float throttle, float *mixed) {
+    static constexpr float YAW_HEADROOM = 0.2f;
+
+    // Ensure the maximum average throttle across the motors are at least the throttle commanded and never exceeds the set max
     float throttleAvgMax = throttle;
 
     // The optimal throttle that gives the best symmetric room for rpy (equal room for above and below)
     // 0.5 is the best but take the commanded throttle if its lower than 0.5, and take 0.5 if its higher, so the drone wont elevate when little throttle is commanded
     float idealThrottle = fminf(0.5f, throttleAvgMax);
 
+    // Every loop runs all lanes so the trip count is fixed, lanes past motorCount are masked out of the limits.
+    // Compares instead of fminf/fmaxf keep the loops branch free without fast-math
+
     // Add roll and pitch, while finding the yaw allowed at the same time
     float yawAllowed = 1.0f;
-    for (int i = 0; i < NUM_MOTORS; i++) {
-        mixed[i] = roll * ROLL_FACTOR[i] + pitch * PITCH_FACTOR[i];
+    for (uint8_t i = 0; i < MIXER_MAX_MOTORS; i++) {
+        mixed[i] = roll * frame.roll[i] + pitch * frame.pitch[i];
 
-        float predictedMotorThrust = idealThrottle + mixed[i]; 
-        float motorRoom = (yaw * YAW_FACTOR[i] >= 0) 
+        float predictedMotorThrust = idealThrottle + mixed[i];
+        float motorRoom = (yaw * frame.yaw[i] >= 0)
                             ? 1.0f - predictedMotorThrust // Yaw is added to overall thrust
                             : predictedMotorThrust; // Yaw is subtracted from overall thrust
-        yawAllowed = fminf(yawAllowed, fmaxf(motorRoom, 0)); // fmaxf(motorRoom, 0) so motorRoom being negative means 0 yaw allowed
+        motorRoom = (i < frame.motorCount) ? motorRoom : 1.0f;
+        motorRoom = (motorRoom > 0.0f) ? motorRoom : 0.0f; // motorRoom being negative means 0 yaw allowed
+        yawAllowed = (motorRoom < yawAllowed) ? motorRoom : yawAllowed;
     }
 
-    // Clip yaw 
+    // Clip yaw
     yawAllowed = fmaxf(YAW_HEADROOM, yawAllowed); // Yaw is at least the headroom reserved
     if (fabsf(yaw) > yawAllowed) {
         yaw = fmaxf(-yawAllowed, fminf(yaw, yawAllowed));
@@ -75,10 +140,13 @@ void MotorMixing::quadMotorMixer(const RCMotorControlMessage_t outputControlMsg,
     // Add yaw in and track the range rpy spans
     float rpyMax = 0.0f;
     float rpyMin = 1.0f;
-    for (int i = 0; i < NUM_MOTORS; i++) {
-        mixed[i] += yaw * YAW_FACTOR[i];
-        rpyMax = fmaxf(rpyMax, mixed[i]);
-        rpyMin = fminf(rpyMin, mixed[i]);
+    for (uint8_t i = 0; i < MIXER_MAX_MOTORS; i++) {
+        mixed[i] += yaw * frame.yaw[i];
+        bool active = i < frame.motorCount;
+        float hi = active ? mixed[i] : 0.0f;
+        float lo = active ? mixed[i] : 1.0f;
+        rpyMax = (hi > rpyMax) ? hi : rpyMax;
+        rpyMin = (lo < rpyMin) ? lo : rpyMin;
     }
 
     // Scale rpy span
@@ -88,14 +156,14 @@ void MotorMixing::quadMotorMixer(const RCMotorControlMessage_t outputControlMsg,
         rpyScale = 1.0f / (rpyMax - rpyMin);
     }
     if (throttleAvgMax + rpyMin < 0.0f) {
-        // The lowest value motor still below 0 after applying the max allowed collective thrust 
+        // The lowest value motor still below 0 after applying the max allowed collective thrust
         rpyScale = fminf(rpyScale, fabsf(throttleAvgMax / rpyMin)); // Scale down rpy together to make the lowest motor fit
     }
     rpyMax *= rpyScale;
     rpyMin *= rpyScale;
 
     // Collective throttle that prevents the lowest motor from going negative
-    float minThrottle = fabsf(rpyMin); 
+    float minThrottle = fabsf(rpyMin);
     // The amount needed to shift up from minThrottle to match the commanded throttle
     float throttleAdj = throttle - minThrottle;
     // Calculate throttle to add
@@ -112,46 +180,32 @@ void MotorMixing::quadMotorMixer(const RCMotorControlMessage_t outputControlMsg,
     float finalThrottle = minThrottle + throttleAdj;
 
     // Final output
-    for (int i = 0; i < NUM_MOTORS; i++) {
+    for (uint8_t i = 0; i < MIXER_MAX_MOTORS; i++) {
         mixed[i] = finalThrottle + rpyScale * mixed[i];
     }
+}
+
+ZP_FAST_CODE void MotorMixing::multirotorMixer(const MixerFrame_t &frame, const RCMotorControlMessage_t outputControlMsg, MotorGroupInstance_t *mainMotorGroup, float* motorPercent) {
+    // Roll, pitch, yaw in range [-1, 1], throttle in [0,1]
+    float mixed[MIXER_MAX_MOTORS];
+    mixFrame(frame, outputControlMsg.roll, outputControlMsg.pitch, outputControlMsg.yaw, outputControlMsg.throttle, mixed);
 
-        // Place mixed motor outputs into physical channels by function
+    // Place mixed motor outputs into physical channels by function
     for (uint8_t i = 0; i < mainMotorGroup->motorCount; i++) {
-        switch (mainMotorGroup->motors[i].function) {
-            case MotorFunction_e::MOTOR_1: 
-                motorPercent[i] = mixed[0]; 
-                break;
-            case MotorFunction_e::MOTOR_2: 
-                motorPercent[i] = mixed[1]; 
-                break;
-            case MotorFunction_e::MOTOR_3: 
-                motorPercent[i] = mixed[2]; 
-                break;
-            case MotorFunction_e::MOTOR_4: 
-                motorPercent[i] = mixed[3]; 
-                break;
-            default:
-                motorPercent[i] = 0.0f;
-                break;
-        }
+        int8_t idx = motorIndex(mainMotorGroup->motors[i].function);
+        motorPercent[i] = (idx >= 0 && idx < frame.motorCount) ? mixed[idx] : 0.0f;
     }
 }
 
-void MotorMixing::quadGroundIdle(MotorGroupInstance_t *mainMotorGroup, float* motorPercent, float motSpinArm) {
+ZP_FAST_CODE void MotorMixing::multirotorGroundIdle(const MixerFrame_t &frame, MotorGroupInstance_t *mainMotorGroup, float* motorPercent, float motSpinArm) {
     for (uint8_t i = 0; i < mainMotorGroup->motorCount; i++) {
-        switch (mainMotorGroup->motors[i].function) {
-            case MotorFunction_e::MOTOR_1:
-            case MotorFunction_e::MOTOR_2:
-            case MotorFunction_e::MOTOR_3:
-            case MotorFunction_e::MOTOR_4:
-                motorPercent[i] = motSpinArm;
-                break;
-            default:
-                motorPercent[i] = 0.0f;
-                break;
-        }
+        int8_t idx = motorIndex(mainMotorGroup->motors[i].function);
+        motorPercent[i] = (idx >= 0 && idx < frame.motorCount) ? motSpinArm : 0.0f;
     }
 }
-#endif
 
+int8_t MotorMixing::motorIndex(MotorFunction_e function) {
+    int16_t idx = static_cast<int16_t>(function) - static_cast<int16_t>(MotorFunction_e::MOTOR_1);
+    return (idx >= 0 && idx < MIXER_MAX_MOTORS) ? static_cast<int8_t>(idx) : -1;
+}
+#endif
@@ -1,4 +1,5 @@
 #include "pid.hpp"
+#include "tcm_placement.hpp"
 
 // Constructor
 PID::PID(float kp, float ki, float kd, float tau,
@@ -34,7 +35,7 @@ void PID::setIntegralMinLimPct(uint8_t pct) noexcept { integralMinLim = (pct / 1
 void PID::setIntegralMaxLimPct(uint8_t pct) noexcept { integralMaxLim = (pct / 100.0f) * outputMaxLim; }
 
 // Update method
-float PID::pidOutput(float setpoint, float measurement) noexcept {
+ZP_FAST_CODE float PID::pidOutput(float setpoint, float measurement) noexcept {
     // Calculate error
     float error = setpoint - measurement;
 
@@ -0,0 +1,215 @@
+#include <cmath>
+#include "pid3.hpp"
+#include "tcm_placement.hpp"
+
+PID3::PID3(float outputMinLim, float outputMaxLim, float t) noexcept :
+    t(t),
+    outputMinLim(outputMinLim),
+    outputMaxLim(outputMaxLim),
+    antiWindup(PIDAntiWindup_e::CLAMP),
+    kd{}, tau{},
+    dLpfHz{},
+    notchCenterHz(0.0f),
+    notchBandwidthHz(0.0f),
+    notchAttenuationDB(0.0f),
+    pGain{}, iGain{}, dGain{}, dDecay{}, ffGain{},
+    pWeight{1.0f, 1.0f, 1.0f},
+    dWeight{},
+    integralMinLim{outputMinLim, outputMinLim, outputMinLim},
+    integralMaxLim{outputMaxLim, outputMaxLim, outputMaxLim} {
+        for (uint8_t axis = 0; axis < PID3_AXES; axis++) {
+            setPassThrough(dNotch, axis);
+            recomputeDerivative(axis);
+        }
+        pidInitState();
+}
+
+void PID3::pidInitState() noexcept {
+    for (uint8_t axis = 0; axis < PID3_AXES; axis++) {
+        integral[axis] = 0.0f;
+        prevError[axis] = 0.0f;
+        prevDError[axis] = 0.0f;
+        dFirstOrder[axis] = 0.0f;
+    }
+    resetDelay(dLpfDelay);
+    resetDelay(dNotchDelay);
+}
+
+void PID3::setConstants(PIDAxis_e axis, float newKp, float newKi, float newKd, float newTau, uint8_t newIMaxPct) noexcept {
+    uint8_t i = static_cast<uint8_t>(axis);
+    kd[i] = newKd;
+    tau[i] = newTau;
+    pGain[i] = newKp;
+    iGain[i] = 0.5f * newKi * t;
+    setIntegralMaxPct(axis, newIMaxPct);
+    recomputeDerivative(i);
+}
+
+void PID3::setKp(PIDAxis_e axis, float newKp) noexcept {
+    pGain[static_cast<uint8_t>(axis)] = newKp;
+}
+
+void PID3::setKi(PIDAxis_e axis, float newKi) noexcept {
+    iGain[static_cast<uint8_t>(axis)] = 0.5f * newKi * t;
+}
+
+void PID3::setKd(PIDAxis_e axis, float newKd) noexcept {
+    uint8_t i = static_cast<uint8_t>(axis);
+    kd[i] = newKd;
+    recomputeDerivative(i);
+}
+
+void PID3::setTau(PIDAxis_e axis, float newTau) noexcept {
+    uint8_t i = static_cast<uint8_t>(axis);
+    tau[i] = newTau;
+    recomputeDerivative(i);
+}
+
+void PID3::setIntegralMaxPct(PIDAxis_e axis, uint8_t pct) noexcept {
+    uint8_t i = static_cast<uint8_t>(axis);
+    integralMinLim[i] = (pct / 100.0f) * outputMinLim;
+    integralMaxLim[i] = (pct / 100.0f) * outputMaxLim;
+}
+
+void PID3::setFeedforward(PIDAxis_e axis, float newKff) noexcept {
+    ffGain[static_cast<uint8_t>(axis)] = newKff;
+}
+
+void PID3::setSetpointWeights(PIDAxis_e axis, float newPWeight, float newDWeight) noexcept {
+    uint8_t i = static_cast<uint8_t>(axis);
+    pWeight[i] = newPWeight;
+    dWeight[i] = newDWeight;
+}
+
+bool PID3::setDtermLpfHz(PIDAxis_e axis, float cutoffHz) noexcept {
+    if (!(cutoffHz >= 0.0f) || cutoffHz >= MAX_FILTER_NYQUIST_RATIO * 0.5f / t) return false;
+
+    uint8_t i = static_cast<uint8_t>(axis);
+    if (cutoffHz == dLpfHz[i]) return true;
+    dLpfHz[i] = cutoffHz;
+    recomputeDerivative(i);
+    return true;
+}
+
+bool PID3::setDtermNotch(float centerHz, float bandwidthHz, float attenuationDB) noexcept {
+    if (centerHz == notchCenterHz && bandwidthHz == notchBandwidthHz && attenuationDB == notchAttenuationDB) return true;
+
+    if (centerHz == 0.0f) {
+        for (uint8_t axis = 0; axis < PID3_AXES; axis++) {
+            setPassThrough(dNotch, axis);
+        }
+    } else {
+        if (!(centerHz > 0.0f) || centerHz >= MAX_FILTER_NYQUIST_RATIO * 0.5f / t) return false;
+        if (!(bandwidthHz > 0.0f) || bandwidthHz >= 2.0f * centerHz || !(attenuationDB > 0.0f)) return false;
+
+        // Same notch design as the ArduPilot NotchFilter, gain at the centre is A^2
+        float octaves = log2f(centerHz / (centerHz - 0.5f * bandwidthHz)) * 2.0f;
+        float q = sqrtf(powf(2.0f, octaves)) / (powf(2.0f, octaves) - 1.0f);
+        float a = powf(10.0f, -attenuationDB / 40.0f);
+        float omega = 2.0f * static_cast<float>(M_PI) * centerHz * t;
+        float alpha = sinf(omega) / (2.0f * q);
+        float a0 = 1.0f + alpha;
+        for (uint8_t axis = 0; axis < PID3_AXES; axis++) {
+            dNotch.b0[axis] = (1.0f + alpha * a * a) / a0;
+            dNotch.b1[axis] = (-2.0f * cosf(omega)) / a0;
+            dNotch.b2[axis] = (1.0f - alpha * a * a) / a0;
+            dNotch.a1[axis] = dNotch.b1[axis];
+            dNotch.a2[axis] = (1.0f - alpha) / a0;
+        }
+    }
+
+    notchCenterHz = centerHz;
+    notchBandwidthHz = bandwidthHz;
+    notchAttenuationDB = attenuationDB;
+    resetDelay(dNotchDelay);
+    return true;
+}
+
+void PID3::setAntiWindup(PIDAntiWindup_e mode) noexcept {
+    antiWindup = mode;
+}
+
+ZP_FAST_CODE void PID3::update(const float setpoint[PID3_AXES], const float measurement[PID3_AXES], float output[PID3_AXES]) noexcept {
+    const bool conditional = antiWindup == PIDAntiWindup_e::CONDITIONAL;
+
+    for (uint8_t i = 0; i < PID3_AXES; i++) {
+        float error = setpoint[i] - measurement[i];
+        float pTerm = pGain[i] * (pWeight[i] * setpoint[i] - measurement[i]);
+        float ffTerm = ffGain[i] * setpoint[i];
+
+        // D-term: tau first order stage or the low-pass biquad (the other one is pass-through), then the notch
+        float dError = dWeight[i] * setpoint[i] - measurement[i];
+        float d = dGain[i] * (dError - prevDError[i]) + dDecay[i] * dFirstOrder[i];
+        dFirstOrder[i] = d;
+
+        float lpf = dLpf.b0[i] * d + dLpf.b1[i] * dLpfDelay.x1[i] + dLpf.b2[i] * dLpfDelay.x2[i]
+                  - dLpf.a1[i] * dLpfDelay.y1[i] - dLpf.a2[i] * dLpfDelay.y2[i];
+        dLpfDelay.x2[i] = dLpfDelay.x1[i];
+        dLpfDelay.x1[i] = d;
+        dLpfDelay.y2[i] = dLpfDelay.y1[i];
+        dLpfDelay.y1[i] = lpf;
+
+        float dTerm = dNotch.b0[i] * lpf + dNotch.b1[i] * dNotchDelay.x1[i] + dNotch.b2[i] * dNotchDelay.x2[i]
+                    - dNotch.a1[i] * dNotchDelay.y1[i] - dNotch.a2[i] * dNotchDelay.y2[i];
+        dNotchDelay.x2[i] = dNotchDelay.x1[i];
+        dNotchDelay.x1[i] = lpf;
+        dNotchDelay.y2[i] = dNotchDelay.y1[i];
+        dNotchDelay.y1[i] = dTerm;
+
+        // Integral with IMAX clamp, optionally held while the output is pushed further into saturation
+        float candidate = integral[i] + iGain[i] * (error + prevError[i]);
+        candidate = candidate > integralMaxLim[i] ? integralMaxLim[i] : candidate;
+        candidate = candidate < integralMinLim[i] ? integralMinLim[i] : candidate;
+        float unclamped = pTerm + candidate + dTerm + ffTerm;
+        bool windingUp = (unclamped > outputMaxLim && error > 0.0f) || (unclamped < outputMinLim && error < 0.0f);
+        if (!(conditional && windingUp)) {
+            integral[i] = candidate;
+        }
+
+        float effort = pTerm + integral[i] + dTerm + ffTerm;
+        effort = effort > outputMaxLim ? outputMaxLim : effort;
+        effort = effort < outputMinLim ? outputMinLim : effort;
+        output[i] = effort;
+
+        prevError[i] = error;
+        prevDError[i] = dError;
+    }
+}
+
+void PID3::recomputeDerivative(uint8_t axis) noexcept {
+    if (dLpfHz[axis] == 0.0f) {
+        // Bilinear first order filter with time constant tau, the PID derivative
+        dGain[axis] = (2.0f * kd[axis]) / (2.0f * tau[axis] + t);
+        dDecay[axis] = (2.0f * tau[axis] - t) / (2.0f * tau[axis] + t);
+        setPassThrough(dLpf, axis);
+        return;
+    }
+
+    // Plain backward difference followed by a Butterworth low-pass with unity DC gain
+    dGain[axis] = kd[axis] / t;
+    dDecay[axis] = 0.0f;
+
+    float omega = 2.0f * static_cast<float>(M_PI) * dLpfHz[axis] * t;
+    float cs = cosf(omega);
+    float alpha = sinf(omega) / (2.0f * BUTTERWORTH_Q);
+    float a0 = 1.0f + alpha;
+    dLpf.b0[axis] = (0.5f * (1.0f - cs)) / a0;
+    dLpf.b1[axis] = (1.0f - cs) / a0;
+    dLpf.b2[axis] = dLpf.b0[axis];
+    dLpf.a1[axis] = (-2.0f * cs) / a0;
+    dLpf.a2[axis] = (1.0f - alpha) / a0;
+}
+
+void PID3::setPassThrough(BiquadCoeffs &coeffs, uint8_t axis) noexcept {
+    coeffs.b0[axis] = 1.0f;
+    coeffs.b1[axis] = 0.0f;
+    coeffs.b2[axis] = 0.0f;
+    coeffs.a1[axis] = 0.0f;
+    coeffs.a2[axis] = 0.0f;
+}
+
+void PID3::resetDelay(BiquadDelay &delay) noexcept {
+    for (uint8_t axis = 0; axis < PID3_AXES; axis++) {
+        delay.x1[axis] = delay.x2[axis] = delay.y1[axis] = delay.y2[axis] = 0.0f;
+    }
+}
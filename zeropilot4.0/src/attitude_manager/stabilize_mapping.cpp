@@ -1,5 +1,6 @@
 #include <cmath>
 #include "stabilize_mapping.hpp"
+#include "tcm_placement.hpp"
 #include "unit_conversions.hpp"
 
 StabilizeMapping::StabilizeMapping(float control_iter_period_s, AcroMapping &acro) noexcept : 
@@ -13,7 +14,10 @@ StabilizeMapping::StabilizeMapping(float control_iter_period_s, AcroMapping &acr
     acroCLAW(acro),
     decimationCounter(0),
     stabilizeRollCmd(STABILIZE_PID_OUTPUT_SHIFT),
-    stabilizePitchCmd(STABILIZE_PID_OUTPUT_SHIFT) {
+    stabilizePitchCmd(STABILIZE_PID_OUTPUT_SHIFT),
+    rollRateOffset(0.0f),
+    pitchRateOffset(0.0f),
+    yawRateOffset(0.0f) {
         rollPID.pidInitState();
         pitchPID.pidInitState();
 }
@@ -35,6 +39,15 @@ void StabilizeMapping::resetControlLoopState() noexcept {
     decimationCounter = 0;
     stabilizeRollCmd = STABILIZE_PID_OUTPUT_SHIFT;
     stabilizePitchCmd = STABILIZE_PID_OUTPUT_SHIFT;
+    rollRateOffset = 0.0f;
+    pitchRateOffset = 0.0f;
+    yawRateOffset = 0.0f;
+}
+
+void StabilizeMapping::setRateCommandOffset(float rollOffset, float pitchOffset, float yawOffset) noexcept {
+    rollRateOffset = rollOffset;
+    pitchRateOffset = pitchOffset;
+    yawRateOffset = yawOffset;
 }
 
 // Setter for *rollLimitAngle* and *pitchLimitAngle* in rad
@@ -52,7 +65,7 @@ void StabilizeMapping::activateFlightMode() {
 }
 
 // Main control mapping function for STABILIZE mode
-RCMotorControlMessage_t StabilizeMapping::runControl(RCMotorControlMessage_t controlInputs, const DroneState_t &droneState) {
+ZP_FAST_CODE RCMotorControlMessage_t StabilizeMapping::runControl(RCMotorControlMessage_t controlInputs, const DroneState_t &droneState) {
     // Outer angle loop runs once every ANGLE_LOOP_TO_INNER_LOOP_RATIO calls
     if (decimationCounter == 0) {
         // Setpoints: Maps [0, 100] to [-limit, +limit]
@@ -69,8 +82,9 @@ RCMotorControlMessage_t StabilizeMapping::runControl(RCMotorControlMessage_t con
 
     decimationCounter = (decimationCounter + 1) % ANGLE_LOOP_TO_INNER_LOOP_RATIO;
 
-    controlInputs.roll = stabilizeRollCmd;
-    controlInputs.pitch = stabilizePitchCmd;
+    controlInputs.roll = stabilizeRollCmd + rollRateOffset;
+    controlInputs.pitch = stabilizePitchCmd + pitchRateOffset;
+    controlInputs.yaw += yawRateOffset;
 
     // Run acro control at the full AM loop rate
     controlInputs = acroCLAW.runControl(controlInputs, droneState);
@@ -0,0 +1,249 @@
+#include <cmath>
+#include "sysid_mapping.hpp"
+
+SysIdMapping::SysIdMapping(float control_iter_period_s, Flightmode &base, IFFT *fftDriver, StabilizeMapping *rateLoopHost) noexcept :
+    controlPeriodS(control_iter_period_s),
+    baseCLAW(base),
+    rateLoopHost(rateLoopHost),
+    chirp(),
+    response(fftDriver),
+    pendingAxis(SysIdAxis_e::NONE),
+    pendingMagnitude(0.1f),
+    pendingFStartHz(0.5f),
+    pendingFStopHz(40.0f),
+    pendingRecordS(30.0f),
+    pendingFadeInS(2.0f),
+    pendingFadeOutS(2.0f),
+    axis(SysIdAxis_e::NONE),
+    magnitude(0.0f),
+    running(false),
+    complete(false),
+    completionUnreported(false),
+    decimation(1),
+    decimationCount(0),
+    injectedSum(0.0f),
+    measuredSum(0.0f),
+    block{},
+    blockReady(false),
+    readyBlock{} {}
+
+bool SysIdMapping::setAxis(uint8_t newAxis) noexcept {
+    switch (static_cast<SysIdAxis_e>(newAxis)) {
+        case SysIdAxis_e::NONE:
+        case SysIdAxis_e::INPUT_ROLL:
+        case SysIdAxis_e::INPUT_PITCH:
+        case SysIdAxis_e::INPUT_YAW:
+        case SysIdAxis_e::MIX_ROLL:
+        case SysIdAxis_e::MIX_PITCH:
+        case SysIdAxis_e::MIX_YAW:
+            break;
+        case SysIdAxis_e::RATE_ROLL:
+        case SysIdAxis_e::RATE_PITCH:
+        case SysIdAxis_e::RATE_YAW:
+            if (rateLoopHost == nullptr) return false; // No rate loop to inject into
+            break;
+        default:
+            return false;
+    }
+
+    pendingAxis = static_cast<SysIdAxis_e>(newAxis);
+    return true;
+}
+
+bool SysIdMapping::setMagnitude(float newMagnitude) noexcept {
+    if (!(newMagnitude > 0.0f) || newMagnitude > MAX_MAGNITUDE) return false;
+    pendingMagnitude = newMagnitude;
+    return true;
+}
+
+bool SysIdMapping::setChirp(float fStartHz, float fStopHz, float recordS, float fadeInS, float fadeOutS) noexcept {
+    // The estimate needs a few samples per cycle at the top of the sweep even without decimation
+    if (fStopHz * ESTIMATE_SAMPLES_PER_STOP_CYCLE * controlPeriodS > 1.0f) return false;
+
+    ChirpGenerator check;
+    if (!check.init(fStartHz, fStopHz, recordS, fadeInS, fadeOutS)) return false;
+
+    pendingFStartHz = fStartHz;
+    pendingFStopHz = fStopHz;
+    pendingRecordS = recordS;
+    pendingFadeInS = fadeInS;
+    pendingFadeOutS = fadeOutS;
+    return true;
+}
+
+SysIdAxis_e SysIdMapping::getAxis() const noexcept { return axis; }
+bool SysIdMapping::isRunning() const noexcept { return running; }
+bool SysIdMapping::isComplete() const noexcept { return complete; }
+const FrequencyResponse &SysIdMapping::getResponse() const noexcept { return response; }
+
+void SysIdMapping::activateFlightMode() {
+    baseCLAW.activateFlightMode();
+
+    axis = pendingAxis;
+    magnitude = pendingMagnitude;
+    chirp.init(pendingFStartHz, pendingFStopHz, pendingRecordS, pendingFadeInS, pendingFadeOutS);
+    running = (axis != SysIdAxis_e::NONE);
+    complete = false;
+    completionUnreported = false;
+
+    // Average down to a few samples per cycle of the stop frequency so one window spans more of the sweep
+    const float controlRateHz = 1.0f / controlPeriodS;
+    decimation = static_cast<uint16_t>(controlRateHz / (ESTIMATE_SAMPLES_PER_STOP_CYCLE * pendingFStopHz));
+    if (decimation < 1) decimation = 1;
+    decimationCount = 0;
+    injectedSum = 0.0f;
+    measuredSum = 0.0f;
+    response.init(controlRateHz / decimation); // Without an FFT driver the chirp still runs and logs
+
+    block.sync = SYSID_LOG_SYNC;
+    block.axis = static_cast<uint8_t>(axis);
+    block.count = 0;
+    block.seq = 0;
+    block.sampleRateHz = controlRateHz;
+    block.startTimeS = 0.0f;
+    blockReady = false;
+}
+
+RCMotorControlMessage_t SysIdMapping::runControl(RCMotorControlMessage_t controlInput, const DroneState_t &droneState) {
+    if (!running) {
+        return baseCLAW.runControl(controlInput, droneState);
+    }
+
+    const float injected = magnitude * chirp.update(controlPeriodS);
+    const uint8_t idx = axisIndex(axis);
+    RCMotorControlMessage_t out = controlInput;
+
+    switch (injectionFor(axis)) {
+        case SysIdInjection_e::INPUT: {
+            float *stick = (idx == 0) ? &controlInput.roll : (idx == 1) ? &controlInput.pitch : &controlInput.yaw;
+            *stick = fminf(fmaxf(*stick + injected * RC_HALF_RANGE, 0.0f), 2.0f * RC_HALF_RANGE);
+            out = baseCLAW.runControl(controlInput, droneState);
+            break;
+        }
+        case SysIdInjection_e::RATE: {
+            const float offset = injected * RC_HALF_RANGE;
+            rateLoopHost->setRateCommandOffset(idx == 0 ? offset : 0.0f, idx == 1 ? offset : 0.0f, idx == 2 ? offset : 0.0f);
+            out = baseCLAW.runControl(controlInput, droneState);
+            break;
+        }
+        case SysIdInjection_e::MIXER: {
+            out = baseCLAW.runControl(controlInput, droneState);
+            float *effort = (idx == 0) ? &out.roll : (idx == 1) ? &out.pitch : &out.yaw;
+            #ifdef PLANE
+            *effort = fminf(fmaxf(*effort + injected * MIXER_FULL_SCALE, 0.0f), 2.0f * MIXER_FULL_SCALE);
+            #endif
+            #ifdef QUADCOPTER
+            *effort = fminf(fmaxf(*effort + injected * MIXER_FULL_SCALE, -MIXER_FULL_SCALE), MIXER_FULL_SCALE);
+            #endif
+            break;
+        }
+    }
+
+    recordSample(injected, measuredSignal(axis, droneState));
+
+    if (chirp.isComplete()) {
+        running = false;
+        complete = true;
+        completionUnreported = true;
+        flushBlock();
+        if (rateLoopHost != nullptr) {
+            rateLoopHost->setRateCommandOffset(0.0f, 0.0f, 0.0f);
+        }
+    }
+
+    return out;
+}
+
+bool SysIdMapping::takeLogBlock(SysIdLogBlock_t &outBlock) noexcept {
+    if (!blockReady) return false;
+    outBlock = readyBlock;
+    blockReady = false;
+    return true;
+}
+
+bool SysIdMapping::takeCompletion() noexcept {
+    if (!completionUnreported) return false;
+    completionUnreported = false;
+    return true;
+}
+
+void SysIdMapping::recordSample(float injected, float measured) noexcept {
+    block.injected[block.count] = injected;
+    block.measured[block.count] = measured;
+    block.count++;
+    if (block.count >= SYSID_LOG_BLOCK_SAMPLES) {
+        flushBlock();
+    }
+
+    injectedSum += injected;
+    measuredSum += measured;
+    if (++decimationCount >= decimation) {
+        response.pushSample(injectedSum / decimation, measuredSum / decimation);
+        decimationCount = 0;
+        injectedSum = 0.0f;
+        measuredSum = 0.0f;
+    }
+}
+
+void SysIdMapping::flushBlock() noexcept {
+    if (block.count == 0) return;
+
+    // The AM drains every tick, an untaken block would only be replaced if it stopped doing so
+    readyBlock = block;
+    blockReady = true;
+
+    block.seq++;
+    block.count = 0;
+    block.startTimeS = block.seq * SYSID_LOG_BLOCK_SAMPLES * controlPeriodS;
+}
+
+SysIdInjection_e SysIdMapping::injectionFor(SysIdAxis_e sysIdAxis) noexcept {
+    switch (sysIdAxis) {
+        case SysIdAxis_e::RATE_ROLL:
+        case SysIdAxis_e::RATE_PITCH:
+        case SysIdAxis_e::RATE_YAW:
+            return SysIdInjection_e::RATE;
+        case SysIdAxis_e::MIX_ROLL:
+        case SysIdAxis_e::MIX_PITCH:
+        case SysIdAxis_e::MIX_YAW:
+            return SysIdInjection_e::MIXER;
+        default:
+            return SysIdInjection_e::INPUT;
+    }
+}
+
+uint8_t SysIdMapping::axisIndex(SysIdAxis_e sysIdAxis) noexcept {
+    switch (sysIdAxis) {
+        case SysIdAxis_e::INPUT_PITCH:
+        case SysIdAxis_e::RATE_PITCH:
+        case SysIdAxis_e::MIX_PITCH:
+            return 1;
+        case SysIdAxis_e::INPUT_YAW:
+        case SysIdAxis_e::RATE_YAW:
+        case SysIdAxis_e::MIX_YAW:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+float SysIdMapping::measuredSignal(SysIdAxis_e sysIdAxis, const DroneState_t &droneState) noexcept {
+    // Roll and pitch sticks command an angle, the yaw stick commands a rate (or the rudder directly)
+    switch (sysIdAxis) {
+        case SysIdAxis_e::INPUT_ROLL:
+            return droneState.roll;
+        case SysIdAxis_e::INPUT_PITCH:
+            return droneState.pitch;
+        default:
+            break;
+    }
+
+    switch (axisIndex(sysIdAxis)) {
+        case 1:
+            return droneState.pitchRate;
+        case 2:
+            return droneState.yawRate;
+        default:
+            return droneState.rollRate;
+    }
+}
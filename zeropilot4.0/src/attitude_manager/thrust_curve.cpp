@@ -0,0 +1,77 @@
+#include "thrust_curve.hpp"
+#include "tcm_placement.hpp"
+#include <cmath>
+
+ThrustCurve::ThrustCurve() :
+    expo(0.0f),
+    minVoltage(0.0f),
+    maxVoltage(0.0f),
+    filteredVoltage(0.0f),
+    voltageScale(1.0f),
+    lut{} {
+    buildLut();
+}
+
+bool ThrustCurve::setExpo(float newExpo) {
+    if (!(newExpo >= -1.0f && newExpo <= 1.0f)) return false;
+    if (newExpo == expo) return true;
+
+    expo = newExpo;
+    buildLut();
+    return true;
+}
+
+bool ThrustCurve::setVoltageLimits(float newMinVoltage, float newMaxVoltage) {
+    if (!(newMinVoltage >= 0.0f && newMaxVoltage >= 0.0f)) return false;
+    if (newMinVoltage > 0.0f && newMaxVoltage > 0.0f && newMinVoltage >= newMaxVoltage) return false;
+
+    minVoltage = newMinVoltage;
+    maxVoltage = newMaxVoltage;
+    updateVoltageScale();
+    return true;
+}
+
+void ThrustCurve::updateVoltage(float newFilteredVoltage) {
+    filteredVoltage = newFilteredVoltage;
+    updateVoltageScale();
+}
+
+ZP_FAST_CODE float ThrustCurve::thrustToActuator(float thrust) const {
+    // Also catches NaN
+    if (!(thrust > 0.0f)) return 0.0f;
+    if (thrust >= 1.0f) thrust = 1.0f;
+
+    float position = thrust * LUT_SEGMENTS;
+    uint8_t index = static_cast<uint8_t>(position);
+    if (index >= LUT_SEGMENTS) index = LUT_SEGMENTS - 1;
+    float fraction = position - index;
+    float actuator = lut[index] + fraction * (lut[index + 1] - lut[index]);
+
+    actuator *= voltageScale;
+    return actuator > 1.0f ? 1.0f : actuator;
+}
+
+void ThrustCurve::buildLut() {
+    for (uint8_t i = 0; i <= LUT_SEGMENTS; i++) {
+        float thrust = static_cast<float>(i) / LUT_SEGMENTS;
+        if (expo == 0.0f) {
+            lut[i] = thrust;
+            continue;
+        }
+
+        // Positive root of expo * u^2 + (1 - expo) * u - thrust = 0
+        float discriminant = (1.0f - expo) * (1.0f - expo) + 4.0f * expo * thrust;
+        float actuator = ((expo - 1.0f) + sqrtf(fmaxf(discriminant, 0.0f))) / (2.0f * expo);
+        lut[i] = fminf(fmaxf(actuator, 0.0f), 1.0f);
+    }
+}
+
+void ThrustCurve::updateVoltageScale() {
+    if (minVoltage <= 0.0f || maxVoltage <= 0.0f || !(filteredVoltage >= NO_BATTERY_RATIO * minVoltage)) {
+        voltageScale = 1.0f;
+        return;
+    }
+
+    float voltage = fminf(fmaxf(filteredVoltage, minVoltage), maxVoltage);
+    voltageScale = maxVoltage / voltage;
+}
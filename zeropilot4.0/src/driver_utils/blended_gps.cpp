@@ -0,0 +1,177 @@
+#include <cmath>
+#include "blended_gps.hpp"
+
+static constexpr float PI_F = 3.14159265358979f;
+static constexpr float DEG_TO_RAD = PI_F / 180.0f;
+static constexpr float RAD_TO_DEG = 180.0f / PI_F;
+static constexpr float EARTH_RADIUS_M = 6378137.0f;
+
+// Time of week wraps weekly (UBX), time of day wraps daily (NMEA)
+static constexpr uint32_t MS_PER_WEEK = 604800000;
+static constexpr uint32_t MS_PER_DAY = 86400000;
+
+BlendedGPS::BlendedGPS(IGPS *gps1, IGPS *gps2, ISystemUtils *sysUtils) noexcept :
+    receivers{gps1, gps2},
+    sysUtils(sysUtils),
+    latest{},
+    lastUpdateMs{},
+    hasData{},
+    output{},
+    healthyMask(0),
+    failoverCount(0),
+    gps1Weight(0.0f) {
+    output.hAcc = INVALID_ACCURACY;
+    output.vAcc = INVALID_ACCURACY;
+}
+
+GpsData_t BlendedGPS::readData() {
+    const uint32_t now = sysUtils->getCurrentTimestampMs();
+
+    bool fresh = false;
+    uint8_t mask = 0;
+    for (uint8_t i = 0; i < NUM_RECEIVERS; i++) {
+        if (receivers[i] == nullptr) continue;
+
+        GpsData_t data = receivers[i]->readData();
+        if (data.isNew) {
+            latest[i] = data;
+            lastUpdateMs[i] = now;
+            hasData[i] = true;
+            fresh = true;
+        }
+
+        if (hasData[i] && now - lastUpdateMs[i] <= RECEIVER_TIMEOUT_MS) {
+            mask |= (1 << i);
+        }
+    }
+
+    // A receiver that was contributing has dropped out
+    if ((mask & healthyMask) != healthyMask) {
+        failoverCount++;
+    }
+    healthyMask = mask;
+
+    if (!fresh || mask == 0) {
+        output.isNew = false;
+        return output;
+    }
+
+    if (mask == 0b11) {
+        output = blend(latest[0], latest[1]);
+    } else {
+        uint8_t idx = (mask & 0b01) ? 0 : 1;
+        output = latest[idx];
+        gps1Weight = (idx == 0) ? 1.0f : 0.0f;
+    }
+
+    output.isNew = true;
+    return output;
+}
+
+GpsData_t BlendedGPS::blend(const GpsData_t &a, const GpsData_t &b) noexcept {
+    int32_t offsetMs = timeOffsetMs(b.solutionTimeMs, a.solutionTimeMs);
+    uint32_t absOffsetMs = (offsetMs < 0) ? (uint32_t)(-offsetMs) : (uint32_t)offsetMs;
+
+    // The solutions cannot be aligned, use the more accurate receiver alone
+    if (absOffsetMs > MAX_TIME_OFFSET_MS) {
+        bool useA = inverseVariance(a.hAcc) >= inverseVariance(b.hAcc);
+        gps1Weight = useA ? 1.0f : 0.0f;
+        return useA ? a : b;
+    }
+
+    // Bring the older solution forward to the epoch of the newer one
+    GpsData_t pa = (offsetMs > 0) ? propagate(a, offsetMs / 1000.0f) : a;
+    GpsData_t pb = (offsetMs < 0) ? propagate(b, -offsetMs / 1000.0f) : b;
+
+    // The newer solution supplies the time and date
+    GpsData_t out = (offsetMs > 0) ? pb : pa;
+
+    // Horizontal
+    float wa = inverseVariance(pa.hAcc);
+    float wb = inverseVariance(pb.hAcc);
+    float w = wa / (wa + wb);
+    gps1Weight = w;
+
+    float dLon = pa.longitude - pb.longitude;
+    if (dLon > 180.0f) dLon -= 360.0f;
+    if (dLon < -180.0f) dLon += 360.0f;
+    out.latitude = pb.latitude + w * (pa.latitude - pb.latitude);
+    out.longitude = pb.longitude + w * dLon;
+    if (out.longitude > 180.0f) out.longitude -= 360.0f;
+    if (out.longitude < -180.0f) out.longitude += 360.0f;
+
+    out.vx = w * pa.vx + (1.0f - w) * pb.vx;
+    out.vy = w * pa.vy + (1.0f - w) * pb.vy;
+    out.groundSpeed = w * pa.groundSpeed + (1.0f - w) * pb.groundSpeed;
+
+    bool trackA = pa.trackAngle != INVALID_TRACK_ANGLE;
+    bool trackB = pb.trackAngle != INVALID_TRACK_ANGLE;
+    if (trackA && trackB) {
+        // Blend on the unit circle so 359 and 1 deg average to 0
+        float s = w * std::sin(pa.trackAngle * DEG_TO_RAD) + (1.0f - w) * std::sin(pb.trackAngle * DEG_TO_RAD);
+        float c = w * std::cos(pa.trackAngle * DEG_TO_RAD) + (1.0f - w) * std::cos(pb.trackAngle * DEG_TO_RAD);
+        out.trackAngle = std::atan2(s, c) * RAD_TO_DEG;
+        if (out.trackAngle < 0.0f) out.trackAngle += 360.0f;
+    } else {
+        out.trackAngle = trackA ? pa.trackAngle : pb.trackAngle;
+    }
+
+    bool accA = pa.hAcc > 0.0f;
+    bool accB = pb.hAcc > 0.0f;
+    out.hAcc = (accA || accB) ? 1.0f / std::sqrt(wa + wb) : INVALID_ACCURACY;
+
+    // Vertical, only from receivers with a 3D fix
+    bool altA = pa.altitude != INVALID_ALTITUDE;
+    bool altB = pb.altitude != INVALID_ALTITUDE;
+    if (altA && altB) {
+        float va = inverseVariance(pa.vAcc);
+        float vb = inverseVariance(pb.vAcc);
+        float v = va / (va + vb);
+        out.altitude = v * pa.altitude + (1.0f - v) * pb.altitude;
+        out.vz = v * pa.vz + (1.0f - v) * pb.vz;
+        out.vAcc = (pa.vAcc > 0.0f || pb.vAcc > 0.0f) ? 1.0f / std::sqrt(va + vb) : INVALID_ACCURACY;
+    } else if (altA || altB) {
+        const GpsData_t &src = altA ? pa : pb;
+        out.altitude = src.altitude;
+        out.vz = src.vz;
+        out.vAcc = src.vAcc;
+    } else {
+        out.altitude = INVALID_ALTITUDE;
+        out.vAcc = INVALID_ACCURACY;
+    }
+
+    out.numSatellites = (pa.numSatellites > pb.numSatellites) ? pa.numSatellites : pb.numSatellites;
+
+    return out;
+}
+
+// Dead reckon along the NED velocity (vx north, vy east, vz down) for dt seconds
+GpsData_t BlendedGPS::propagate(const GpsData_t &data, float dt) noexcept {
+    GpsData_t out = data;
+    out.latitude += (data.vx * dt / EARTH_RADIUS_M) * RAD_TO_DEG;
+    float cosLat = std::cos(data.latitude * DEG_TO_RAD);
+    if (cosLat > 1e-3f) {
+        out.longitude += (data.vy * dt / (EARTH_RADIUS_M * cosLat)) * RAD_TO_DEG;
+    }
+    if (data.altitude != INVALID_ALTITUDE) {
+        out.altitude -= data.vz * dt;
+    }
+    return out;
+}
+
+float BlendedGPS::inverseVariance(float accuracy) noexcept {
+    if (accuracy <= 0.0f) accuracy = DEFAULT_ACCURACY_M;
+    if (accuracy < MIN_ACCURACY_M) accuracy = MIN_ACCURACY_M;
+    return 1.0f / (accuracy * accuracy);
+}
+
+// Signed later - earlier, unwrapping a week or day rollover between the two
+int32_t BlendedGPS::timeOffsetMs(uint32_t later, uint32_t earlier) noexcept {
+    int64_t diff = (int64_t)later - (int64_t)earlier;
+    const int64_t periods[] = {MS_PER_WEEK, MS_PER_DAY};
+    for (int64_t period : periods) {
+        if (diff > period / 2 && diff < period + period / 2) diff -= period;
+        if (diff < -period / 2 && diff > -period - period / 2) diff += period;
+    }
+    return (int32_t)diff;
+}
@@ -0,0 +1,795 @@
+#include <cstring>
+#include "can_controller.hpp"
+
+static constexpr uint32_t CAN_FRAME_EFF_BIT = 31U;
+
+// DroneCAN identifier fields, for the acceptance filters
+static constexpr uint32_t CAN_ID_SOURCE_NODE_MASK = 0x7FU;
+static constexpr uint32_t CAN_ID_SERVICE_BIT = 1U << 7;
+static constexpr uint32_t CAN_ID_MESSAGE_TYPE_SHIFT = 8U;       // 16 bit type ID, only the low 2 bits when anonymous
+static constexpr uint32_t CAN_ID_DESTINATION_SHIFT = 8U;
+static constexpr uint32_t CAN_ID_REQUEST_BIT = 1U << 15;
+static constexpr uint32_t CAN_ID_SERVICE_TYPE_SHIFT = 16U;      // 8 bit type ID
+static constexpr uint32_t CAN_ID_ANONYMOUS_TYPE_MASK = 0x3U;
+
+// Tail array optimisation drops the length of a message's last array and lets the transfer end mark
+// it. CAN FD pads frames up to the next DLC size, so FD transfers carry the length instead, which is
+// also what libcanard assumes when it decodes an FD frame.
+#if CANARD_ENABLE_TAO_OPTION
+#define TAO_ARG(tao) , (tao)
+#else
+#define TAO_ARG(tao)
+#endif
+
+// DroneCAN reserves 126 and 127
+static constexpr uint8_t MAX_DYNAMIC_NODE_ID = 125;
+
+constexpr CANController::AcceptedTransfer CANController::ACCEPTED_TRANSFERS[];
+
+static void staticOnTransferReception(CanardInstance* ins, CanardRxTransfer* transfer);
+static bool staticShouldAcceptTransfer(const CanardInstance* ins, uint64_t* outSig, uint16_t id, CanardTransferType type, uint8_t src);
+
+CANController::CANController(
+    ICANBus *bus,
+    ISystemUtils *systemUtilsDriver,
+    LatestValueSlot<CANBusStats_t> *busStats,
+    LatestValueSlot<ActuatorCommand_t> *actuatorCommands,
+    EscStatusTable *escStatus,
+    DroneCANGPS *gps,
+    DroneCANBarometer *barometer,
+    DroneCANMagnetometer *magnetometer,
+    DroneCANAirspeed *airspeed
+) :
+    bus(bus),
+    systemUtilsDriver(systemUtilsDriver),
+    busStats(busStats),
+    actuatorCommands(actuatorCommands),
+    escStatus(escStatus),
+    gps(gps),
+    barometer(barometer),
+    magnetometer(magnetometer),
+    airspeed(airspeed),
+    features((escStatus != nullptr ? FEATURE_ESC_STATUS : 0) |
+        (gps != nullptr ? FEATURE_GPS : 0) |
+        (barometer != nullptr ? FEATURE_BAROMETER : 0) |
+        (magnetometer != nullptr ? FEATURE_MAGNETOMETER : 0) |
+        (airspeed != nullptr ? FEATURE_AIRSPEED : 0)),
+    profilerId(0),
+    #if CANARD_ENABLE_CANFD
+        fdTransmit(false),
+    #endif
+    rxRing{},
+    rxHead(0),
+    rxRingOverruns(0),
+    rxFifoOverruns(0),
+    busOffEvents(0),
+    rxRingPeak(0),
+    rxTail(0),
+    rxFrames(0),
+    txFrames(0),
+    rxPoolExhausted(0),
+    txQueueFull(0),
+    nodeStatusTransferId(0),
+    dnaAllocationTransferId(0),
+    escCommandTransferId(0),
+    servoCommandTransferId(0),
+    gpsNodeId(0),
+    barometerNodeId(0),
+    magnetometerNodeId(0),
+    airspeedNodeId(0),
+    actuatorCommandSeq(0),
+    lastServoCommandMs(0),
+    nextAvailableID(CANARD_MIN_NODE_ID + 1),
+    allocationTable{},
+    allocationCount(0),
+    nodeStatus{},
+    last1HzTick(0),
+    dnaCurrentUniqueId{},
+    dnaCurrentUniqueIdLen(0),
+    dnaPreferredNodeId(UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_ANY_NODE_ID),
+    dnaLastAcceptedTick(0)
+{
+    canardInit(&canard,
+        canardMemoryPool,
+        sizeof(canardMemoryPool),
+        &staticOnTransferReception,
+        &staticShouldAcceptTransfer,
+        this
+    );
+
+    // All other nodes are default-constructed to OFFLINE.
+    canNodes[CANController::NODE_ID].markOnline(systemUtilsDriver->getCurrentTimestampMs());
+
+    canardSetLocalNodeID(&canard, CANController::NODE_ID);
+
+    // With too few filter elements the bus keeps receiving everything and libcanard drops the rest
+    static_assert(ACCEPTED_TRANSFER_COUNT <= CAN_MAX_ACCEPTANCE_FILTERS, "Every accepted transfer needs a CAN filter element");
+    CANAcceptanceFilter_t filters[ACCEPTED_TRANSFER_COUNT];
+    (void)bus->setAcceptanceFilters(filters, buildAcceptanceFilters(filters));
+
+    systemUtilsDriver->profilerRegister("BUS", &profilerId);
+}
+
+const CANController::AcceptedTransfer *CANController::findAcceptedTransfer(uint16_t dataTypeId, CanardTransferType transferType) const {
+    static_assert(acceptedTransfersSorted(), "ACCEPTED_TRANSFERS must be sorted by data type ID");
+
+    size_t low = 0;
+    size_t high = ACCEPTED_TRANSFER_COUNT;
+    while (low < high) {
+        const size_t mid = (low + high) / 2;
+        if (ACCEPTED_TRANSFERS[mid].dataTypeId < dataTypeId) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low == ACCEPTED_TRANSFER_COUNT) return nullptr;
+
+    const AcceptedTransfer &entry = ACCEPTED_TRANSFERS[low];
+    if (entry.dataTypeId != dataTypeId || entry.transferType != transferType || (entry.feature & features) != entry.feature) {
+        return nullptr;
+    }
+    return &entry;
+}
+
+uint8_t CANController::buildAcceptanceFilters(CANAcceptanceFilter_t *filters) const {
+    uint8_t count = 0;
+
+    for (const AcceptedTransfer &entry : ACCEPTED_TRANSFERS) {
+        if ((entry.feature & features) != entry.feature) continue;
+
+        CANAcceptanceFilter_t &filter = filters[count++];
+        if (entry.transferType != CanardTransferTypeBroadcast) {
+            // Service transfers addressed to us
+            filter.id = (static_cast<uint32_t>(entry.dataTypeId) << CAN_ID_SERVICE_TYPE_SHIFT) |
+                (entry.transferType == CanardTransferTypeRequest ? CAN_ID_REQUEST_BIT : 0U) |
+                (static_cast<uint32_t>(NODE_ID) << CAN_ID_DESTINATION_SHIFT) | CAN_ID_SERVICE_BIT;
+            filter.mask = (0xFFU << CAN_ID_SERVICE_TYPE_SHIFT) | CAN_ID_REQUEST_BIT |
+                (CAN_ID_SOURCE_NODE_MASK << CAN_ID_DESTINATION_SHIFT) | CAN_ID_SERVICE_BIT;
+        } else if (entry.dataTypeId == UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_ID) {
+            // Allocation requests come from anonymous nodes, whose frames only carry the low type ID bits
+            filter.id = (entry.dataTypeId & CAN_ID_ANONYMOUS_TYPE_MASK) << CAN_ID_MESSAGE_TYPE_SHIFT;
+            filter.mask = (CAN_ID_ANONYMOUS_TYPE_MASK << CAN_ID_MESSAGE_TYPE_SHIFT) | CAN_ID_SERVICE_BIT | CAN_ID_SOURCE_NODE_MASK;
+        } else {
+            filter.id = static_cast<uint32_t>(entry.dataTypeId) << CAN_ID_MESSAGE_TYPE_SHIFT;
+            filter.mask = (0xFFFFU << CAN_ID_MESSAGE_TYPE_SHIFT) | CAN_ID_SERVICE_BIT;
+        }
+    }
+    return count;
+}
+
+bool CANController::CanardShouldAcceptTransfer(
+    const CanardInstance* ins,
+    uint64_t* outDataTypeSignature,
+    uint16_t dataTypeId,
+    CanardTransferType transferType,
+    uint8_t sourceNodeId
+) {
+    (void)ins;
+    (void)sourceNodeId;
+
+    const AcceptedTransfer *entry = findAcceptedTransfer(dataTypeId, transferType);
+    if (entry == nullptr) return false;
+
+    *outDataTypeSignature = entry->signature;
+    return true;
+}
+
+void CANController::CanardOnTransferReception(CanardInstance* ins, CanardRxTransfer* transfer) {
+    (void)ins;
+
+    const AcceptedTransfer *entry = findAcceptedTransfer(transfer->data_type_id, static_cast<CanardTransferType>(transfer->transfer_type));
+    if (entry != nullptr) {
+        (this->*entry->handler)(transfer);
+    }
+}
+
+bool CANController::enqueueRxFrame(uint32_t id, uint8_t len, const uint8_t *data, bool fd) {
+    const uint32_t head = rxHead.load(std::memory_order_relaxed);
+    const uint32_t depth = head - rxTail.load(std::memory_order_acquire);
+
+    if (depth >= RX_RING_SLOTS) {
+        rxRingOverruns = rxRingOverruns + 1;
+        return false;
+    }
+
+    if (len > CAN_FRAME_MAX_DATA_LEN) {
+        len = CAN_FRAME_MAX_DATA_LEN;
+    }
+
+    RawCanFrame &slot = rxRing[head & (RX_RING_SLOTS - 1U)];
+    slot.id = id;
+    slot.timestampMs = systemUtilsDriver->getCurrentTimestampMs();
+    slot.len = len;
+    slot.fd = fd;
+    memcpy(slot.data, data, len);
+    rxHead.store(head + 1U, std::memory_order_release);
+
+    if (depth + 1U > rxRingPeak) {
+        rxRingPeak = static_cast<uint16_t>(depth + 1U);
+    }
+    return true;
+}
+
+void CANController::noteRxFifoOverrun() {
+    rxFifoOverruns = rxFifoOverruns + 1;
+}
+
+void CANController::noteBusOff() {
+    busOffEvents = busOffEvents + 1;
+}
+
+bool CANController::dequeueRxFrame(RawCanFrame *frame) {
+    const uint32_t tail = rxTail.load(std::memory_order_relaxed);
+
+    if (tail == rxHead.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    if (frame) *frame = rxRing[tail & (RX_RING_SLOTS - 1U)];
+    rxTail.store(tail + 1U, std::memory_order_release);
+    return true;
+}
+
+bool CANController::hasPendingRx() const {
+    return rxTail.load(std::memory_order_relaxed) != rxHead.load(std::memory_order_acquire);
+}
+
+void CANController::handleRxFrame(const RawCanFrame &rxFrame) {
+    const uint64_t timestampUsec = rxFrame.timestampMs * 1000ULL;
+
+    CanardCANFrame frame;
+    frame.id = rxFrame.id | (1UL << CAN_FRAME_EFF_BIT);
+    frame.data_len = rxFrame.len;
+    memcpy(frame.data, rxFrame.data, frame.data_len);
+    #if CANARD_ENABLE_CANFD
+        frame.canfd = rxFrame.fd;
+    #endif
+
+    rxFrames++;
+    if (canardHandleRxFrame(&canard, &frame, timestampUsec) == -CANARD_ERROR_OUT_OF_MEMORY) {
+        rxPoolExhausted++;
+    }
+}
+
+void CANController::handleNodeStatus(CanardRxTransfer *transfer) {
+    uint32_t tick = static_cast<uint32_t>(transfer->timestamp_usec / 1000ULL);
+
+    uavcan_protocol_NodeStatus status {};
+
+    if (uavcan_protocol_NodeStatus_decode(transfer, &status)) return;
+
+    const uint8_t sourceNodeId = transfer->source_node_id;
+
+    // Node ID out of bounds or is anonymous
+    if (sourceNodeId > CANARD_MAX_NODE_ID || sourceNodeId == 0) return;
+
+    canNodes[sourceNodeId].update(status, tick);
+}
+
+void CANController::handleEscStatus(CanardRxTransfer *transfer) {
+    uavcan_equipment_esc_Status msg {};
+
+    if (uavcan_equipment_esc_Status_decode(transfer, &msg)) return;
+
+    EscStatus_t status;
+    status.timestampMs = static_cast<uint32_t>(transfer->timestamp_usec / 1000ULL);
+    status.errorCount = msg.error_count;
+    status.voltage = msg.voltage;
+    status.current = msg.current;
+    status.temperature = msg.temperature;
+    status.rpm = msg.rpm;
+    status.powerRatingPct = msg.power_rating_pct;
+
+    escStatus->publish(msg.esc_index, status);
+}
+
+bool CANController::acceptSensorNode(uint8_t &sensorNodeId, uint8_t sourceNodeId) const {
+    // Anonymous nodes can't be told apart
+    if (sourceNodeId == 0 || sourceNodeId > CANARD_MAX_NODE_ID) return false;
+
+    if (sensorNodeId == 0) {
+        sensorNodeId = sourceNodeId;
+    }
+    return sensorNodeId == sourceNodeId;
+}
+
+void CANController::releaseOfflineSensorNodes() {
+    uint8_t *sensorNodeIds[] = {&gpsNodeId, &barometerNodeId, &magnetometerNodeId, &airspeedNodeId};
+
+    for (uint8_t *nodeId : sensorNodeIds) {
+        if (*nodeId != 0 && canNodes[*nodeId].isOffline()) {
+            if (nodeId == &magnetometerNodeId) {
+                magnetometer->resetSource();
+            }
+            *nodeId = 0;
+        }
+    }
+}
+
+void CANController::handleGnssFix2(CanardRxTransfer *transfer) {
+    if (!acceptSensorNode(gpsNodeId, transfer->source_node_id)) return;
+
+    uavcan_equipment_gnss_Fix2 msg {};
+
+    if (uavcan_equipment_gnss_Fix2_decode(transfer, &msg)) return;
+
+    gps->publishFix2(msg);
+}
+
+void CANController::handleStaticPressure(CanardRxTransfer *transfer) {
+    if (!acceptSensorNode(barometerNodeId, transfer->source_node_id)) return;
+
+    uavcan_equipment_air_data_StaticPressure msg {};
+
+    if (uavcan_equipment_air_data_StaticPressure_decode(transfer, &msg)) return;
+
+    barometer->publishStaticPressure(msg);
+}
+
+void CANController::handleStaticTemperature(CanardRxTransfer *transfer) {
+    if (!acceptSensorNode(barometerNodeId, transfer->source_node_id)) return;
+
+    uavcan_equipment_air_data_StaticTemperature msg {};
+
+    if (uavcan_equipment_air_data_StaticTemperature_decode(transfer, &msg)) return;
+
+    barometer->publishStaticTemperature(msg);
+}
+
+void CANController::handleMagneticField(CanardRxTransfer *transfer) {
+    if (!acceptSensorNode(magnetometerNodeId, transfer->source_node_id)) return;
+
+    uavcan_equipment_ahrs_MagneticFieldStrength2 msg {};
+
+    if (uavcan_equipment_ahrs_MagneticFieldStrength2_decode(transfer, &msg)) return;
+
+    magnetometer->publishMagneticField(msg);
+}
+
+void CANController::handleRawAirData(CanardRxTransfer *transfer) {
+    if (!acceptSensorNode(airspeedNodeId, transfer->source_node_id)) return;
+
+    uavcan_equipment_air_data_RawAirData msg {};
+
+    if (uavcan_equipment_air_data_RawAirData_decode(transfer, &msg)) return;
+
+    airspeed->publishRawAirData(msg);
+}
+
+void CANController::sendActuatorCommands() {
+    ActuatorCommand_t command;
+    if (actuatorCommands == nullptr || !actuatorCommands->readIfNew(command, actuatorCommandSeq)) return;
+
+    // ESC commands outrank servo commands so a servo update never delays the motors
+    if (command.escCount > 0) {
+        uavcan_equipment_esc_RawCommand msg {};
+        msg.cmd.len = command.escCount;
+        memcpy(msg.cmd.data, command.escRaw, command.escCount * sizeof(command.escRaw[0]));
+
+        uint8_t buffer[UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_MAX_SIZE];
+        const uint32_t len = uavcan_equipment_esc_RawCommand_encode(&msg, buffer TAO_ARG(useTailArrayOptimization()));
+        broadcastMessage(
+            UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_SIGNATURE,
+            UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_ID,
+            &escCommandTransferId,
+            CANARD_TRANSFER_PRIORITY_HIGH,
+            buffer,
+            static_cast<uint16_t>(len)
+        );
+    }
+
+    const uint32_t tick = systemUtilsDriver->getCurrentTimestampMs();
+    if (command.servoCount > 0 && tick - lastServoCommandMs >= CAN_SERVO_COMMAND_PERIOD_MS) {
+        lastServoCommandMs = tick;
+
+        uavcan_equipment_actuator_ArrayCommand msg {};
+        msg.commands.len = command.servoCount;
+        for (uint8_t i = 0; i < command.servoCount; i++) {
+            msg.commands.data[i].actuator_id = command.servoId[i];
+            msg.commands.data[i].command_type = UAVCAN_EQUIPMENT_ACTUATOR_COMMAND_COMMAND_TYPE_UNITLESS;
+            msg.commands.data[i].command_value = command.servoCommand[i];
+        }
+
+        uint8_t buffer[UAVCAN_EQUIPMENT_ACTUATOR_ARRAYCOMMAND_MAX_SIZE];
+        const uint32_t len = uavcan_equipment_actuator_ArrayCommand_encode(&msg, buffer TAO_ARG(useTailArrayOptimization()));
+        broadcastMessage(
+            UAVCAN_EQUIPMENT_ACTUATOR_ARRAYCOMMAND_SIGNATURE,
+            UAVCAN_EQUIPMENT_ACTUATOR_ARRAYCOMMAND_ID,
+            &servoCommandTransferId,
+            CANARD_TRANSFER_PRIORITY_MEDIUM,
+            buffer,
+            static_cast<uint16_t>(len)
+        );
+    }
+}
+
+void CANController::handleNodeAllocation(CanardRxTransfer *transfer){
+
+    const uint8_t sourceNodeId = transfer->source_node_id;
+
+    // Only process anonymous requests
+    if (sourceNodeId != 0) return;
+
+    uavcan_protocol_dynamic_node_id_Allocation msg;
+
+    if (uavcan_protocol_dynamic_node_id_Allocation_decode(transfer, &msg)) return;
+
+    const uint32_t tick = static_cast<uint32_t>(transfer->timestamp_usec / 1000ULL);
+
+    // If timeout, reset stage
+    if (tick > dnaLastAcceptedTick + UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_FOLLOWUP_TIMEOUT_MS) {
+        resetDnaInProgress();
+    }
+
+    const CANController::DnaStage incoming = detectDnaRequestStage(msg);
+    if (incoming == CANController::DnaStage::INVALID || incoming != getExpectedDnaStage()) {
+        return;
+    }
+
+    // Append the new chunk
+    memcpy(dnaCurrentUniqueId + dnaCurrentUniqueIdLen, msg.unique_id.data, msg.unique_id.len);
+    dnaCurrentUniqueIdLen += msg.unique_id.len;
+
+    if (incoming == CANController::DnaStage::FIRST_UNIQUE_ID_PART) {
+        dnaPreferredNodeId = msg.node_id;
+    }
+
+    if (dnaCurrentUniqueIdLen == UAVCAN_UNIQUE_ID_LENGTH) {
+        const int8_t newNodeId = allocateNode();
+        if (newNodeId >= 0) {
+            (void)publishDnaAllocationResponse(newNodeId, dnaCurrentUniqueId, dnaCurrentUniqueIdLen);
+        }
+        resetDnaInProgress();
+    } else {
+        if (publishDnaAllocationResponse(0, dnaCurrentUniqueId, dnaCurrentUniqueIdLen) < 0) {
+            resetDnaInProgress();
+            return;
+        }
+        dnaLastAcceptedTick = tick;
+    }
+}
+
+int8_t CANController::lookupAllocation(const uint8_t uniqueId[16]) const {
+    for (uint8_t i = 0; i < allocationCount; i++) {
+        if (memcmp(allocationTable[i].uniqueId, uniqueId, 16) == 0) {
+            return allocationTable[i].nodeId;
+        }
+    }
+    return -1;
+}
+
+bool CANController::isNodeIdAllocated(uint8_t nodeId) const {
+    for (uint8_t i = 0; i < allocationCount; i++) {
+        if (allocationTable[i].nodeId == nodeId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int8_t CANController::allocateNode() {
+
+    // Check if previously assigned
+    int8_t existingId = lookupAllocation(dnaCurrentUniqueId);
+    if (existingId > 0) {
+        return existingId;
+    }
+
+    // Try preferred ID
+    int8_t assignedId = 0;
+    if (dnaPreferredNodeId != UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_ANY_NODE_ID &&
+        dnaPreferredNodeId >= CANARD_MIN_NODE_ID &&
+        dnaPreferredNodeId <= MAX_DYNAMIC_NODE_ID &&
+        canNodes[dnaPreferredNodeId].isOffline() &&
+        !isNodeIdAllocated(dnaPreferredNodeId)) {
+        assignedId = dnaPreferredNodeId;
+    }
+
+    // Scan for free ID
+    if (assignedId == 0) {
+        for (int currId = nextAvailableID; currId <= MAX_DYNAMIC_NODE_ID && assignedId == 0; currId++) {
+            if (canNodes[currId].isOffline()
+                && !isNodeIdAllocated(currId)) {
+                nextAvailableID = currId + 1;
+                assignedId = currId;
+            }
+        }
+
+        if (assignedId == 0) {
+            return -1;
+        }
+    }
+
+    // Push to allocation table
+    if (allocationCount < MAX_ALLOCATION_ENTRIES) {
+        memcpy(allocationTable[allocationCount].uniqueId, dnaCurrentUniqueId, 16);
+        allocationTable[allocationCount].nodeId = assignedId;
+        allocationCount++;
+    }
+
+    return assignedId;
+}
+
+CANController::DnaStage CANController::detectDnaRequestStage(const uavcan_protocol_dynamic_node_id_Allocation& msg) const {
+
+    constexpr uint8_t MAX_LEN = UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_MAX_LENGTH_OF_UNIQUE_ID_IN_REQUEST;
+    constexpr uint8_t STAGE3_LEN = UAVCAN_UNIQUE_ID_LENGTH - MAX_LEN * 2U;
+
+    const uint8_t len = msg.unique_id.len;
+
+    // Length should be 6 or 4
+    if (len != MAX_LEN && len != STAGE3_LEN) {
+        return CANController::DnaStage::INVALID;
+    }
+
+    if (msg.first_part_of_unique_id) {
+        return CANController::DnaStage::FIRST_UNIQUE_ID_PART;
+    }
+
+    if (len == MAX_LEN) {
+        return CANController::DnaStage::SECOND_UNIQUE_ID_PART;
+    }
+
+    if (len == STAGE3_LEN) {
+        return CANController::DnaStage::FINAL_UNIQUE_ID_PART;
+    }
+
+    return CANController::DnaStage::INVALID;
+}
+
+CANController::DnaStage CANController::getExpectedDnaStage() const {
+    constexpr uint8_t MAX_LEN = UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_MAX_LENGTH_OF_UNIQUE_ID_IN_REQUEST;
+
+    switch (dnaCurrentUniqueIdLen) {
+        case 0:
+            return CANController::DnaStage::FIRST_UNIQUE_ID_PART;
+        case MAX_LEN:
+            return CANController::DnaStage::SECOND_UNIQUE_ID_PART;
+        case MAX_LEN * 2:
+            return CANController::DnaStage::FINAL_UNIQUE_ID_PART;
+        default:
+            return CANController::DnaStage::INVALID;
+    }
+}
+
+
+void CANController::resetDnaInProgress() {
+    dnaCurrentUniqueIdLen = 0;
+    dnaPreferredNodeId = UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_ANY_NODE_ID;
+    dnaLastAcceptedTick = 0;
+}
+
+int16_t CANController::publishDnaAllocationResponse(uint8_t nodeId, const uint8_t* unique_id, uint8_t unique_id_len) {
+    uavcan_protocol_dynamic_node_id_Allocation msg {};
+    msg.node_id = nodeId;
+    msg.first_part_of_unique_id = false;
+    msg.unique_id.len = unique_id_len;
+    memcpy(msg.unique_id.data, unique_id, unique_id_len);
+
+    uint8_t buffer[UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_MAX_SIZE];
+    uint32_t len = uavcan_protocol_dynamic_node_id_Allocation_encode(&msg, buffer TAO_ARG(useTailArrayOptimization()));
+
+    return broadcastMessage(
+        UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_SIGNATURE,
+        UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_ID,
+        &dnaAllocationTransferId,
+        CANARD_TRANSFER_PRIORITY_LOW,
+        buffer,
+        len
+    );
+}
+
+void CANController::sendCanTx() {
+    for (CanardCANFrame* frame = canardPeekTxQueue(&canard); frame != nullptr; frame = canardPeekTxQueue(&canard)) {
+        CANFrame_t txFrame;
+        txFrame.id = frame->id & CANARD_CAN_EXT_ID_MASK;
+        txFrame.len = frame->data_len;
+        #if CANARD_ENABLE_CANFD
+            txFrame.fd = frame->canfd;
+        #else
+            txFrame.fd = false;
+        #endif
+        memcpy(txFrame.data, frame->data, frame->data_len);
+
+        // FIFO full, the TX complete event runs us again
+        if (!bus->transmit(txFrame)) return;
+
+        canardPopTxQueue(&canard);
+        txFrames++;
+    }
+}
+
+bool CANController::routineTasks() {
+    systemUtilsDriver->profilerBegin(profilerId);
+    RawCanFrame frame;
+    while (dequeueRxFrame(&frame)) {
+        handleRxFrame(frame);
+    }
+
+    sendActuatorCommands();
+
+    uint32_t tick = systemUtilsDriver->getCurrentTimestampMs();
+
+    if (tick > last1HzTick + UAVCAN_PROTOCOL_NODESTATUS_MAX_BROADCASTING_PERIOD_MS / 2) {
+        last1HzTick = tick;
+        process1HzTasks();
+    }
+
+    sendCanTx();
+
+    systemUtilsDriver->profilerEnd(profilerId);
+
+    return true;
+}
+
+void CANController::sendNodeStatus() {
+    uint8_t buffer[UAVCAN_PROTOCOL_NODESTATUS_MAX_SIZE];
+
+    nodeStatus.uptime_sec = systemUtilsDriver->getCurrentTimestampMs() / 1000LL;
+    nodeStatus.health = UAVCAN_PROTOCOL_NODESTATUS_HEALTH_OK;
+    nodeStatus.mode = UAVCAN_PROTOCOL_NODESTATUS_MODE_OPERATIONAL;
+    nodeStatus.sub_mode = 0;
+    nodeStatus.vendor_specific_status_code = 1234;
+
+    uint32_t len = uavcan_protocol_NodeStatus_encode(&nodeStatus, buffer TAO_ARG(useTailArrayOptimization()));
+
+    broadcastMessage(
+            UAVCAN_PROTOCOL_NODESTATUS_SIGNATURE,
+            UAVCAN_PROTOCOL_NODESTATUS_ID,
+            &nodeStatusTransferId,
+            CANARD_TRANSFER_PRIORITY_LOW,
+            buffer,
+            len
+    );
+
+}
+
+void CANController::process1HzTasks() {
+
+    uint32_t timestampMsec = systemUtilsDriver->getCurrentTimestampMs();
+
+    // Mark remote nodes offline if they have not been seen recently
+    for (int i = CANARD_MIN_NODE_ID; i <= CANARD_MAX_NODE_ID; i++) {
+        if (i != CANController::NODE_ID) {
+            canNodes[i].updateLiveness(timestampMsec, UAVCAN_PROTOCOL_NODESTATUS_OFFLINE_TIMEOUT_MS);
+        }
+    }
+
+    // Let another node take over a sensor whose node went quiet
+    releaseOfflineSensorNodes();
+
+    // Free the pool blocks of multi-frame transfers that will never complete
+    canardCleanupStaleTransfers(&canard, timestampMsec * 1000ULL);
+
+    // Transmit NodeStatus
+    sendNodeStatus();
+
+    if (busStats != nullptr) {
+        busStats->publish(getStats());
+    }
+}
+
+CANBusStats_t CANController::getStats() {
+    const CanardPoolAllocatorStatistics pool = canardGetPoolAllocatorStatistics(&canard);
+
+    CANBusStats_t stats;
+    stats.rxFrames = rxFrames;
+    stats.txFrames = txFrames;
+    stats.rxRingOverruns = rxRingOverruns;
+    stats.rxFifoOverruns = rxFifoOverruns;
+    stats.rxPoolExhausted = rxPoolExhausted;
+    stats.txQueueFull = txQueueFull;
+    stats.busOffEvents = busOffEvents;
+    stats.rxRingPeak = rxRingPeak;
+    stats.poolPeakBlocks = pool.peak_usage_blocks;
+    stats.poolCapacityBlocks = pool.capacity_blocks;
+    return stats;
+}
+
+const CanNode &CANController::getNode(uint8_t nodeId) const {
+    return canNodes[nodeId <= CANARD_MAX_NODE_ID ? nodeId : 0];
+}
+
+
+int16_t CANController::broadcastObj(CanardTxTransfer* transfer) {
+    const int16_t result = canardBroadcastObj(&canard, transfer);
+    if (result == -CANARD_ERROR_OUT_OF_MEMORY) {
+        txQueueFull++;
+    }
+    return result;
+}
+
+int16_t CANController::broadcast(
+    CanardTransferType transferType,
+    uint64_t dataTypeSignature,
+    uint16_t dataTypeId,
+    uint8_t* inoutTransferId,
+    uint8_t priority,
+    const uint8_t* payload,
+    uint16_t payloadLen
+    #if CANARD_ENABLE_CANFD
+        , bool canfd
+    #endif
+    #if CANARD_ENABLE_DEADLINE
+        , uint64_t deadlineUsec
+    #endif
+    #if CANARD_MULTI_IFACE
+        , uint8_t ifaceMask
+    #endif
+    #if CANARD_ENABLE_TAO_OPTION
+        , bool tao
+    #endif
+)
+{
+    CanardTxTransfer transfer_object;
+    transfer_object.transfer_type = transferType;
+    transfer_object.data_type_signature = dataTypeSignature;
+    transfer_object.data_type_id = dataTypeId;
+    transfer_object.inout_transfer_id = inoutTransferId;
+    transfer_object.priority = priority;
+    transfer_object.payload = payload;
+    transfer_object.payload_len = payloadLen;
+
+    #if CANARD_ENABLE_CANFD
+        transfer_object.canfd = canfd;
+    #endif
+    #if CANARD_ENABLE_DEADLINE
+        transfer_object.deadline_usec = deadlineUsec;
+    #endif
+    #if CANARD_MULTI_IFACE
+        transfer_object.iface_mask = ifaceMask;
+    #endif
+    #if CANARD_ENABLE_TAO_OPTION
+        transfer_object.tao = tao;
+    #endif
+
+    return broadcastObj(&transfer_object);
+}
+
+bool CANController::useTailArrayOptimization() const {
+    #if CANARD_ENABLE_CANFD
+        return !fdTransmit;
+    #else
+        return true;
+    #endif
+}
+
+// Our own broadcasts, in the frame format the bus was set up for
+int16_t CANController::broadcastMessage(
+    uint64_t dataTypeSignature,
+    uint16_t dataTypeId,
+    uint8_t* inoutTransferId,
+    uint8_t priority,
+    const uint8_t* payload,
+    uint16_t payloadLen
+)
+{
+    CanardTxTransfer transfer_object {};
+    transfer_object.transfer_type = CanardTransferTypeBroadcast;
+    transfer_object.data_type_signature = dataTypeSignature;
+    transfer_object.data_type_id = dataTypeId;
+    transfer_object.inout_transfer_id = inoutTransferId;
+    transfer_object.priority = priority;
+    transfer_object.payload = payload;
+    transfer_object.payload_len = payloadLen;
+
+    #if CANARD_ENABLE_CANFD
+        transfer_object.canfd = fdTransmit;
+    #endif
+    #if CANARD_ENABLE_TAO_OPTION
+        transfer_object.tao = useTailArrayOptimization();
+    #endif
+
+    return broadcastObj(&transfer_object);
+}
+
+static void staticOnTransferReception(CanardInstance* ins, CanardRxTransfer* transfer) {
+    CANController* self = static_cast<CANController*>(canardGetUserReference(ins));
+    self->CanardOnTransferReception(ins, transfer);
+}
+
+static bool staticShouldAcceptTransfer(const CanardInstance* ins, uint64_t* outSig, uint16_t id, CanardTransferType type, uint8_t src) {
+    return static_cast<CANController*>(canardGetUserReference(ins))->CanardShouldAcceptTransfer(ins, outSig, id, type, src);
+}
@@ -0,0 +1,197 @@
+#include <cstring>
+#include "crsf_stream_parser.hpp"
+
+// Frame length byte counts type, payload and CRC
+static constexpr uint8_t MIN_LENGTH_FIELD = 2;
+static constexpr uint8_t MAX_LENGTH_FIELD = CRSF_MAX_FRAME_LEN - 2;
+
+const uint8_t CrsfStreamParser::CRC8_TABLE[256] = {
+    0x00, 0xD5, 0x7F, 0xAA, 0xFE, 0x2B, 0x81, 0x54, 0x29, 0xFC, 0x56, 0x83, 0xD7, 0x02, 0xA8, 0x7D,
+    0x52, 0x87, 0x2D, 0xF8, 0xAC, 0x79, 0xD3, 0x06, 0x7B, 0xAE, 0x04, 0xD1, 0x85, 0x50, 0xFA, 0x2F,
+    0xA4, 0x71, 0xDB, 0x0E, 0x5A, 0x8F, 0x25, 0xF0, 0x8D, 0x58, 0xF2, 0x27, 0x73, 0xA6, 0x0C, 0xD9,
+    0xF6, 0x23, 0x89, 0x5C, 0x08, 0xDD, 0x77, 0xA2, 0xDF, 0x0A, 0xA0, 0x75, 0x21, 0xF4, 0x5E, 0x8B,
+    0x9D, 0x48, 0xE2, 0x37, 0x63, 0xB6, 0x1C, 0xC9, 0xB4, 0x61, 0xCB, 0x1E, 0x4A, 0x9F, 0x35, 0xE0,
+    0xCF, 0x1A, 0xB0, 0x65, 0x31, 0xE4, 0x4E, 0x9B, 0xE6, 0x33, 0x99, 0x4C, 0x18, 0xCD, 0x67, 0xB2,
+    0x39, 0xEC, 0x46, 0x93, 0xC7, 0x12, 0xB8, 0x6D, 0x10, 0xC5, 0x6F, 0xBA, 0xEE, 0x3B, 0x91, 0x44,
+    0x6B, 0xBE, 0x14, 0xC1, 0x95, 0x40, 0xEA, 0x3F, 0x42, 0x97, 0x3D, 0xE8, 0xBC, 0x69, 0xC3, 0x16,
+    0xEF, 0x3A, 0x90, 0x45, 0x11, 0xC4, 0x6E, 0xBB, 0xC6, 0x13, 0xB9, 0x6C, 0x38, 0xED, 0x47, 0x92,
+    0xBD, 0x68, 0xC2, 0x17, 0x43, 0x96, 0x3C, 0xE9, 0x94, 0x41, 0xEB, 0x3E, 0x6A, 0xBF, 0x15, 0xC0,
+    0x4B, 0x9E, 0x34, 0xE1, 0xB5, 0x60, 0xCA, 0x1F, 0x62, 0xB7, 0x1D, 0xC8, 0x9C, 0x49, 0xE3, 0x36,
+    0x19, 0xCC, 0x66, 0xB3, 0xE7, 0x32, 0x98, 0x4D, 0x30, 0xE5, 0x4F, 0x9A, 0xCE, 0x1B, 0xB1, 0x64,
+    0x72, 0xA7, 0x0D, 0xD8, 0x8C, 0x59, 0xF3, 0x26, 0x5B, 0x8E, 0x24, 0xF1, 0xA5, 0x70, 0xDA, 0x0F,
+    0x20, 0xF5, 0x5F, 0x8A, 0xDE, 0x0B, 0xA1, 0x74, 0x09, 0xDC, 0x76, 0xA3, 0xF7, 0x22, 0x88, 0x5D,
+    0xD6, 0x03, 0xA9, 0x7C, 0x28, 0xFD, 0x57, 0x82, 0xFF, 0x2A, 0x80, 0x55, 0x01, 0xD4, 0x7E, 0xAB,
+    0x84, 0x51, 0xFB, 0x2E, 0x7A, 0xAF, 0x05, 0xD0, 0xAD, 0x78, 0xD2, 0x07, 0x53, 0x86, 0x2C, 0xF9
+};
+
+CrsfStreamParser::CrsfStreamParser() noexcept {
+    reset();
+}
+
+void CrsfStreamParser::reset() noexcept {
+    frameLen = 0;
+    stats = {};
+    memset(channels, 0, sizeof(channels));
+    newChannels = false;
+    channelFrames = 0;
+    linkStats = {};
+    newLinkStats = false;
+}
+
+void CrsfStreamParser::resync() noexcept {
+    frameLen = 0;
+}
+
+void CrsfStreamParser::feed(const uint8_t *data, uint16_t len) noexcept {
+    // Copy as much as fits, scanning consumes complete frames and always frees space when full
+    while (len > 0) {
+        uint8_t space = CRSF_MAX_FRAME_LEN - frameLen;
+        uint8_t count = (len < space) ? (uint8_t)len : space;
+        memcpy(&frame[frameLen], data, count);
+        frameLen += count;
+        data += count;
+        len -= count;
+        scan();
+    }
+}
+
+void CrsfStreamParser::feedByte(uint8_t byte) noexcept {
+    feed(&byte, 1);
+}
+
+void CrsfStreamParser::scan() noexcept {
+    while (frameLen > 0) {
+        if (!isSyncByte(frame[0])) {
+            stats.droppedBytes++;
+            discard(1);
+            continue;
+        }
+        if (frameLen < 2) return;
+
+        uint8_t lengthField = frame[1];
+        if (lengthField < MIN_LENGTH_FIELD || lengthField > MAX_LENGTH_FIELD) {
+            stats.droppedFrames++;
+            discard(1);
+            continue;
+        }
+
+        uint8_t total = lengthField + 2;
+        if (frameLen < total) return; // Rest of the frame is still in flight
+
+        if (crc8(&frame[2], lengthField - 1) != frame[total - 1]) {
+            // Resync one byte after the rejected header
+            stats.crcErrors++;
+            discard(1);
+            continue;
+        }
+
+        stats.framesOk++;
+        dispatch(frame[2], &frame[3], lengthField - 2);
+        discard(total);
+    }
+}
+
+void CrsfStreamParser::dispatch(uint8_t type, const uint8_t *payload, uint8_t payloadLen) noexcept {
+    switch (type) {
+        case CRSF_FRAMETYPE_RC_CHANNELS_PACKED:
+            if (payloadLen != CRSF_RC_CHANNELS_PAYLOAD_LEN) {
+                stats.droppedFrames++;
+                return;
+            }
+            decodeChannels(payload);
+            break;
+
+        case CRSF_FRAMETYPE_LINK_STATISTICS:
+            if (payloadLen != CRSF_LINK_STATISTICS_PAYLOAD_LEN) {
+                stats.droppedFrames++;
+                return;
+            }
+            decodeLinkStats(payload);
+            break;
+
+        default:
+            // Valid frame of a type the flight controller does not consume
+            break;
+    }
+}
+
+void CrsfStreamParser::decodeChannels(const uint8_t *payload) noexcept {
+    // 16 little endian 11 bit fields packed back to back
+    uint32_t bitBuffer = 0;
+    uint8_t bitsInBuffer = 0;
+    uint8_t payloadIndex = 0;
+
+    for (uint8_t i = 0; i < CRSF_CHANNEL_COUNT; i++) {
+        while (bitsInBuffer < 11) {
+            bitBuffer |= ((uint32_t)payload[payloadIndex++]) << bitsInBuffer;
+            bitsInBuffer += 8;
+        }
+        channels[i] = (uint16_t)(bitBuffer & 0x7FF);
+        bitBuffer >>= 11;
+        bitsInBuffer -= 11;
+    }
+
+    newChannels = true;
+    channelFrames++;
+}
+
+void CrsfStreamParser::decodeLinkStats(const uint8_t *payload) noexcept {
+    linkStats.uplinkRssi1 = payload[0];
+    linkStats.uplinkRssi2 = payload[1];
+    linkStats.uplinkLinkQuality = payload[2];
+    linkStats.uplinkSnr = (int8_t)payload[3];
+    linkStats.activeAntenna = payload[4];
+    linkStats.rfMode = payload[5];
+    linkStats.uplinkTxPower = payload[6];
+    linkStats.downlinkRssi = payload[7];
+    linkStats.downlinkLinkQuality = payload[8];
+    linkStats.downlinkSnr = (int8_t)payload[9];
+    newLinkStats = true;
+}
+
+void CrsfStreamParser::discard(uint8_t count) noexcept {
+    if (count >= frameLen) {
+        frameLen = 0;
+        return;
+    }
+    frameLen -= count;
+    memmove(frame, &frame[count], frameLen);
+}
+
+bool CrsfStreamParser::takeChannels(uint16_t (&out)[CRSF_CHANNEL_COUNT]) noexcept {
+    if (!newChannels) return false;
+    memcpy(out, channels, sizeof(channels));
+    newChannels = false;
+    return true;
+}
+
+bool CrsfStreamParser::takeLinkStats(CrsfLinkStats_t &out) noexcept {
+    if (!newLinkStats) return false;
+    out = linkStats;
+    newLinkStats = false;
+    return true;
+}
+
+bool CrsfStreamParser::isSyncByte(uint8_t byte) noexcept {
+    return byte == CRSF_SYNC_BYTE || byte == CRSF_ADDRESS_CRSF_TRANSMITTER ||
+           byte == CRSF_ADDRESS_CRSF_RECEIVER || byte == CRSF_ADDRESS_RADIO_TRANSMITTER;
+}
+
+uint8_t CrsfStreamParser::crc8(const uint8_t *data, uint8_t len) noexcept {
+    uint8_t crc = 0;
+    while (len--) {
+        crc = CRC8_TABLE[crc ^ *data++];
+    }
+    return crc;
+}
+
+uint8_t CrsfStreamParser::encodeFrame(uint8_t type, const uint8_t *payload, uint8_t payloadLen, uint8_t *out, uint8_t outSize) noexcept {
+    if (payloadLen > CRSF_MAX_PAYLOAD_LEN || payloadLen + 4 > outSize) return 0;
+
+    out[0] = CRSF_SYNC_BYTE;
+    out[1] = payloadLen + 2;
+    out[2] = type;
+    if (payloadLen > 0) memcpy(&out[3], payload, payloadLen);
+    out[3 + payloadLen] = crc8(&out[2], payloadLen + 1);
+    return payloadLen + 4;
+}
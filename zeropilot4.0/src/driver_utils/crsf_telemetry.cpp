@@ -0,0 +1,146 @@
+#include <cstring>
+#include "crsf_telemetry.hpp"
+#include "crsf_stream_parser.hpp"
+
+static constexpr uint8_t BATTERY_PAYLOAD_LEN = 8;
+static constexpr uint8_t ATTITUDE_PAYLOAD_LEN = 6;
+static constexpr uint8_t GPS_PAYLOAD_LEN = 15;
+
+static constexpr float CMPS_TO_DKMPH = 0.36f;       // cm/s to 0.1 km/h
+static constexpr float GPS_ALTITUDE_OFFSET_M = 1000.0f;
+
+static int32_t clampToInt(float value, int32_t min, int32_t max) {
+    if (value <= (float)min) return min;
+    if (value >= (float)max) return max;
+    return (int32_t)(value + (value >= 0.0f ? 0.5f : -0.5f));
+}
+
+static void putBE16(uint8_t *out, uint16_t value) {
+    out[0] = (uint8_t)(value >> 8);
+    out[1] = (uint8_t)value;
+}
+
+static void putBE32(uint8_t *out, uint32_t value) {
+    out[0] = (uint8_t)(value >> 24);
+    out[1] = (uint8_t)(value >> 16);
+    out[2] = (uint8_t)(value >> 8);
+    out[3] = (uint8_t)value;
+}
+
+CrsfTelemetry::CrsfTelemetry() noexcept :
+    system{},
+    nav{},
+    haveSystem(false),
+    haveNav(false),
+    lastRcFrameUs(0),
+    haveRcFrame(false),
+    rcPeriodUs(0),
+    lastSentUs(0),
+    haveSent(false),
+    framesSent(0),
+    nextFrame(0) {}
+
+void CrsfTelemetry::setSystem(const RCSystemTelemetry_t &newSystem) noexcept {
+    system = newSystem;
+    haveSystem = true;
+}
+
+void CrsfTelemetry::setNav(const RCNavTelemetry_t &newNav) noexcept {
+    nav = newNav;
+    haveNav = true;
+}
+
+uint8_t CrsfTelemetry::onRcFrame(uint32_t nowUs, uint8_t *out, uint8_t outSize) noexcept {
+    // Track the RC frame period, 1/8 smoothing
+    if (haveRcFrame) {
+        uint32_t interval = nowUs - lastRcFrameUs;
+        if (interval > 0 && interval <= MAX_RC_FRAME_PERIOD_US) {
+            rcPeriodUs = (rcPeriodUs == 0) ? interval : rcPeriodUs + ((int32_t)(interval - rcPeriodUs) / 8);
+        }
+    }
+    lastRcFrameUs = nowUs;
+    haveRcFrame = true;
+
+    if (rcPeriodUs == 0) return 0;
+    if (haveSent && nowUs - lastSentUs < MIN_FRAME_INTERVAL_US) return 0;
+
+    // Next frame type in the rotation that has data and fits in the slot
+    for (uint8_t i = 0; i < (uint8_t)Frame_e::COUNT; i++) {
+        Frame_e frameType = (Frame_e)((nextFrame + i) % (uint8_t)Frame_e::COUNT);
+        uint8_t len = encode(frameType, out, outSize);
+        if (len == 0) continue;
+        if (frameAirtimeUs(len) + SLOT_GUARD_US > rcPeriodUs) continue;
+
+        nextFrame = (uint8_t)(((uint8_t)frameType + 1) % (uint8_t)Frame_e::COUNT);
+        lastSentUs = nowUs;
+        haveSent = true;
+        framesSent++;
+        return len;
+    }
+
+    return 0;
+}
+
+uint8_t CrsfTelemetry::encode(Frame_e frameType, uint8_t *out, uint8_t outSize) const noexcept {
+    switch (frameType) {
+        case Frame_e::BATTERY:
+            return (haveSystem && system.batteryValid) ? encodeBattery(system, out, outSize) : 0;
+        case Frame_e::ATTITUDE:
+            return haveNav ? encodeAttitude(nav, out, outSize) : 0;
+        case Frame_e::GPS:
+            return (haveNav && nav.gpsValid) ? encodeGps(nav, out, outSize) : 0;
+        case Frame_e::FLIGHT_MODE:
+            return (haveSystem && system.flightMode[0] != '\0') ? encodeFlightMode(system, out, outSize) : 0;
+        default:
+            return 0;
+    }
+}
+
+uint8_t CrsfTelemetry::encodeBattery(const RCSystemTelemetry_t &system, uint8_t *out, uint8_t outSize) noexcept {
+    uint8_t payload[BATTERY_PAYLOAD_LEN];
+    putBE16(&payload[0], (uint16_t)clampToInt(system.batteryVoltage * 10.0f, 0, UINT16_MAX)); // 0.1 V
+    putBE16(&payload[2], (uint16_t)clampToInt(system.batteryCurrent * 10.0f, 0, UINT16_MAX)); // 0.1 A
+    uint32_t consumed = (uint32_t)clampToInt(system.consumedMah, 0, 0xFFFFFF);
+    payload[4] = (uint8_t)(consumed >> 16);
+    payload[5] = (uint8_t)(consumed >> 8);
+    payload[6] = (uint8_t)consumed;
+    payload[7] = (system.batteryRemaining > 100) ? 100 : system.batteryRemaining;
+    return CrsfStreamParser::encodeFrame(CRSF_FRAMETYPE_BATTERY_SENSOR, payload, sizeof(payload), out, outSize);
+}
+
+uint8_t CrsfTelemetry::encodeFlightMode(const RCSystemTelemetry_t &system, uint8_t *out, uint8_t outSize) noexcept {
+    // Null terminated string
+    uint8_t payload[RC_TELEM_FLIGHT_MODE_LEN];
+    uint8_t len = 0;
+    while (len < RC_TELEM_FLIGHT_MODE_LEN - 1 && system.flightMode[len] != '\0') {
+        payload[len] = (uint8_t)system.flightMode[len];
+        len++;
+    }
+    payload[len++] = '\0';
+    return CrsfStreamParser::encodeFrame(CRSF_FRAMETYPE_FLIGHT_MODE, payload, len, out, outSize);
+}
+
+uint8_t CrsfTelemetry::encodeAttitude(const RCNavTelemetry_t &nav, uint8_t *out, uint8_t outSize) noexcept {
+    // 1e-4 rad
+    uint8_t payload[ATTITUDE_PAYLOAD_LEN];
+    putBE16(&payload[0], (uint16_t)(int16_t)clampToInt(nav.pitch * 10000.0f, INT16_MIN, INT16_MAX));
+    putBE16(&payload[2], (uint16_t)(int16_t)clampToInt(nav.roll * 10000.0f, INT16_MIN, INT16_MAX));
+    putBE16(&payload[4], (uint16_t)(int16_t)clampToInt(nav.yaw * 10000.0f, INT16_MIN, INT16_MAX));
+    return CrsfStreamParser::encodeFrame(CRSF_FRAMETYPE_ATTITUDE, payload, sizeof(payload), out, outSize);
+}
+
+uint8_t CrsfTelemetry::encodeGps(const RCNavTelemetry_t &nav, uint8_t *out, uint8_t outSize) noexcept {
+    uint8_t payload[GPS_PAYLOAD_LEN];
+    putBE32(&payload[0], (uint32_t)clampToInt(nav.latitude * 1e7f, -900000000, 900000000));
+    putBE32(&payload[4], (uint32_t)clampToInt(nav.longitude * 1e7f, -1800000000, 1800000000));
+    putBE16(&payload[8], (uint16_t)clampToInt(nav.groundSpeed * CMPS_TO_DKMPH, 0, UINT16_MAX));
+    float heading = (nav.trackAngle < 0.0f) ? 0.0f : nav.trackAngle; // Invalid track angle is -1
+    putBE16(&payload[10], (uint16_t)clampToInt(heading * 100.0f, 0, 35999));
+    putBE16(&payload[12], (uint16_t)clampToInt(nav.altitude + GPS_ALTITUDE_OFFSET_M, 0, UINT16_MAX));
+    payload[14] = nav.numSatellites;
+    return CrsfStreamParser::encodeFrame(CRSF_FRAMETYPE_GPS, payload, sizeof(payload), out, outSize);
+}
+
+uint32_t CrsfTelemetry::frameAirtimeUs(uint8_t frameLen) noexcept {
+    return ((uint32_t)frameLen * 10u * 1000000u + UART_BAUD - 1) / UART_BAUD;
+}
@@ -0,0 +1,88 @@
+#include "dma_rx_ring.hpp"
+
+DmaRxRing::DmaRxRing(const volatile uint8_t *buffer, uint16_t size) noexcept :
+    buffer(buffer),
+    size(size),
+    writeTotal(0),
+    lastWritePos(0),
+    readTotal(0),
+    readPos(0),
+    overrunBytes(0),
+    restartTotal(0),
+    restarts(0),
+    seenRestarts(0),
+    discontinuity(false) {}
+
+void DmaRxRing::onDmaEvent(uint16_t writePos) noexcept {
+    if (size == 0) return;
+    writePos %= size;
+
+    uint16_t written = (writePos >= lastWritePos) ? writePos - lastWritePos : size - lastWritePos + writePos;
+    lastWritePos = writePos;
+    writeTotal = writeTotal + written;
+}
+
+void DmaRxRing::onDmaRestart() noexcept {
+    lastWritePos = 0;
+    restartTotal = writeTotal;
+    restarts = restarts + 1;
+}
+
+uint16_t DmaRxRing::available() const noexcept {
+    return (uint16_t)(writeTotal - readTotal);
+}
+
+uint16_t DmaRxRing::readSpan(const uint8_t *&data) noexcept {
+    // Resume at the start of the buffer where the restarted DMA writes, re-read if the ISR
+    // restarted again while the pair was being loaded
+    uint32_t restartCount;
+    uint32_t restartAt;
+    do {
+        restartCount = restarts;
+        restartAt = restartTotal;
+    } while (restartCount != restarts);
+    if (restartCount != seenRestarts) {
+        seenRestarts = restartCount;
+        readTotal = restartAt;
+        readPos = 0;
+        discontinuity = true;
+    }
+
+    uint32_t unread = writeTotal - readTotal;
+    if (unread == 0) return 0;
+
+    // The DMA lapped the reader, what is left is being overwritten so skip to the newest data
+    if (unread >= size) {
+        overrunBytes += unread;
+        discontinuity = true;
+        advance((uint16_t)(unread % size));
+        readTotal += unread - (unread % size);
+        return 0;
+    }
+
+    uint16_t toEnd = size - readPos;
+
+    data = const_cast<const uint8_t *>(buffer + readPos);
+    return (unread < toEnd) ? (uint16_t)unread : toEnd;
+}
+
+void DmaRxRing::advance(uint16_t count) noexcept {
+    readTotal += count;
+    readPos = (uint16_t)((readPos + count) % size);
+}
+
+bool DmaRxRing::takeDiscontinuity() noexcept {
+    bool skipped = discontinuity;
+    discontinuity = false;
+    return skipped;
+}
+
+void DmaRxRing::reset() noexcept {
+    lastWritePos = 0;
+    writeTotal = 0;
+    readTotal = 0;
+    readPos = 0;
+    restartTotal = 0;
+    seenRestarts = restarts;
+    discontinuity = false;
+}
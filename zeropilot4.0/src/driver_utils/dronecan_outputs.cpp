@@ -0,0 +1,143 @@
+#include "dronecan_outputs.hpp"
+
+DroneCANOutputGroup::DroneCANOutputGroup(LatestValueSlot<ActuatorCommand_t> *commands, const EscStatusTable *escStatus,
+    ISystemUtils *sysUtils, uint8_t motorPolePairs, CommandsReadyHook commandsReady) noexcept :
+    commands(commands),
+    escStatus(escStatus),
+    sysUtils(sysUtils),
+    motorPolePairs(motorPolePairs),
+    commandsReady(commandsReady),
+    outputs{},
+    outputCount(0),
+    escIndexMask(0),
+    activeMask(0),
+    pendingMask(0),
+    pending{},
+    publishCount(0) {}
+
+int8_t DroneCANOutputGroup::addEsc(uint8_t escIndex) {
+    if (outputCount >= MAX_OUTPUTS || escIndex >= ACTUATOR_COMMAND_MAX_ESCS || (escIndexMask & (1 << escIndex))) return -1;
+
+    escIndexMask |= 1 << escIndex;
+    if (escIndex + 1 > pending.escCount) {
+        pending.escCount = escIndex + 1;
+    }
+
+    outputs[outputCount].isEsc = true;
+    outputs[outputCount].index = escIndex;
+    activeMask |= 1 << outputCount;
+    return static_cast<int8_t>(outputCount++);
+}
+
+int8_t DroneCANOutputGroup::addServo(uint8_t actuatorId) {
+    if (outputCount >= MAX_OUTPUTS || pending.servoCount >= ACTUATOR_COMMAND_MAX_SERVOS) return -1;
+
+    for (uint8_t i = 0; i < pending.servoCount; i++) {
+        if (pending.servoId[i] == actuatorId) return -1;
+    }
+
+    outputs[outputCount].isEsc = false;
+    outputs[outputCount].index = pending.servoCount;
+    pending.servoId[pending.servoCount++] = actuatorId;
+    activeMask |= 1 << outputCount;
+    return static_cast<int8_t>(outputCount++);
+}
+
+void DroneCANOutputGroup::setEsc(uint8_t slot, int16_t raw) {
+    if (slot >= outputCount || !outputs[slot].isEsc) return;
+
+    flushIfRepeated(slot);
+    pending.escRaw[outputs[slot].index] = raw;
+    markPending(slot);
+}
+
+void DroneCANOutputGroup::setServo(uint8_t slot, float command) {
+    if (slot >= outputCount || outputs[slot].isEsc) return;
+
+    flushIfRepeated(slot);
+    pending.servoCommand[outputs[slot].index] = command;
+    markPending(slot);
+}
+
+void DroneCANOutputGroup::flushIfRepeated(uint8_t slot) {
+    // An output that was skipped, e.g. its function changed to disabled, must not hold back the others
+    if (pendingMask & (1 << slot)) {
+        publish();
+    }
+}
+
+void DroneCANOutputGroup::markPending(uint8_t slot) {
+    pendingMask |= 1 << slot;
+    if (pendingMask == activeMask) {
+        publish();
+    }
+}
+
+void DroneCANOutputGroup::publish() {
+    pendingMask = 0;
+    commands->publish(pending);
+    publishCount++;
+
+    if (commandsReady != nullptr) {
+        commandsReady();
+    }
+}
+
+bool DroneCANOutputGroup::readErpm(uint8_t slot, uint32_t &erpm) {
+    if (slot >= outputCount || !outputs[slot].isEsc || escStatus == nullptr) return false;
+
+    Output_t &output = outputs[slot];
+    EscStatus_t status;
+    if (escStatus->readIfNew(output.index, status, output.statusSeq)) {
+        output.status = status;
+        output.haveStatus = true;
+    }
+
+    if (!output.haveStatus || sysUtils->getCurrentTimestampMs() - output.status.timestampMs > ESC_STATUS_TIMEOUT_MS) {
+        return false;
+    }
+
+    const uint32_t rpm = static_cast<uint32_t>(output.status.rpm < 0 ? -output.status.rpm : output.status.rpm);
+    erpm = rpm * motorPolePairs;
+    return true;
+}
+
+DroneCANMotorControl::DroneCANMotorControl(DroneCANOutputGroup *group, DroneCANOutputType_e type, uint8_t index) :
+    group(group),
+    type(type),
+    slot(type == DroneCANOutputType_e::ESC ? group->addEsc(index) : group->addServo(index)) {}
+
+void DroneCANMotorControl::set(uint32_t percent) {
+    percent = (percent > 100) ? 100 : percent;
+    setNormalized(percent / 100.0f);
+}
+
+void DroneCANMotorControl::setNormalized(float command) {
+    if (slot < 0) return;
+
+    if (!(command > 0.0f)) {
+        command = 0.0f;
+    } else if (command > 1.0f) {
+        command = 1.0f;
+    }
+
+    if (type == DroneCANOutputType_e::ESC) {
+        const int16_t raw = armFlag ? static_cast<int16_t>(command * ESC_RAW_COMMAND_FULL_SCALE + 0.5f) : 0;
+        group->setEsc(slot, raw);
+    } else {
+        group->setServo(slot, command * 2.0f - 1.0f);
+    }
+}
+
+void DroneCANMotorControl::init() {
+    // Servos hold position until the first real command rather than being driven to one end
+    setArm(false);
+    if (type == DroneCANOutputType_e::ESC) {
+        this->set(0);
+    }
+}
+
+bool DroneCANMotorControl::readErpm(uint32_t &erpm) {
+    if (slot < 0) return false;
+    return group->readErpm(slot, erpm);
+}
@@ -0,0 +1,159 @@
+#include <cmath>
+#include "dronecan_sensors.hpp"
+
+static constexpr float KELVIN_TO_CELSIUS = -273.15f;
+static constexpr float ISA_SEA_LEVEL_TEMP_C = 15.0f;    // Used until a sensor reports a temperature
+static constexpr float ISA_SEA_LEVEL_PRESSURE_PA = 101325.0f;
+static constexpr float ISA_SEA_LEVEL_DENSITY = 1.225f;  // kg/m^3
+static constexpr float ISA_ALTITUDE_SCALE_M = 44330.77f; // T0 / L
+static constexpr float ISA_BAROMETRIC_EXPONENT = 0.190263f;
+static constexpr float RAD_TO_DEG = 57.2957795f;
+
+static constexpr uint64_t MS_PER_DAY = 86400000ULL;
+static constexpr uint64_t MS_PER_WEEK = 7ULL * MS_PER_DAY;
+static constexpr uint64_t GPS_EPOCH_UNIX_S = 315964800ULL; // 1980-01-06
+
+// Fix2 covariance is either the 6 element diagonal or the full 6x6 matrix, position first in NED order
+static constexpr uint8_t FIX2_COV_DIAGONAL_LEN = 6;
+static constexpr uint8_t FIX2_COV_FULL_LEN = 36;
+
+// Civil date from days since 1970-01-01, proleptic Gregorian
+static void dateFromUnixSeconds(uint64_t unixSeconds, GpsTime_t &time) {
+    const int64_t days = static_cast<int64_t>(unixSeconds / 86400ULL) + 719468;
+    const uint32_t secondOfDay = static_cast<uint32_t>(unixSeconds % 86400ULL);
+
+    const int64_t era = days / 146097;
+    const uint32_t dayOfEra = static_cast<uint32_t>(days - era * 146097);
+    const uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const uint32_t monthIndex = (5 * dayOfYear + 2) / 153; // March based
+    const uint32_t month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+
+    time.year = static_cast<uint16_t>(yearOfEra + era * 400 + (month <= 2 ? 1 : 0));
+    time.month = static_cast<uint8_t>(month);
+    time.day = static_cast<uint8_t>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+    time.hour = static_cast<uint8_t>(secondOfDay / 3600);
+    time.minute = static_cast<uint8_t>(secondOfDay / 60 % 60);
+    time.second = static_cast<uint8_t>(secondOfDay % 60);
+}
+
+static float kelvinToCelsius(float kelvin, float fallbackC) {
+    return std::isfinite(kelvin) && kelvin > 0.0f ? kelvin + KELVIN_TO_CELSIUS : fallbackC;
+}
+
+void DroneCANGPS::publishFix2(const uavcan_equipment_gnss_Fix2 &msg) noexcept {
+    const bool fix3D = msg.status == UAVCAN_EQUIPMENT_GNSS_FIX2_STATUS_3D_FIX;
+    if (!fix3D && msg.status != UAVCAN_EQUIPMENT_GNSS_FIX2_STATUS_2D_FIX) return;
+
+    GpsData_t data {};
+    data.latitude = static_cast<float>(msg.latitude_deg_1e8 * 1e-8);
+    data.longitude = static_cast<float>(msg.longitude_deg_1e8 * 1e-8);
+    // 2D fix carries no usable altitude
+    data.altitude = fix3D ? msg.height_msl_mm / 1000.0f : INVALID_ALTITUDE; // mm to m
+    data.numSatellites = msg.sats_used;
+
+    data.vx = msg.ned_velocity[0];
+    data.vy = msg.ned_velocity[1];
+    data.vz = msg.ned_velocity[2];
+    data.groundSpeed = std::hypot(data.vx, data.vy) * 100.0f; // m/s to cm/s
+    data.trackAngle = std::atan2(data.vy, data.vx) * RAD_TO_DEG;
+    if (data.trackAngle < 0.0f) {
+        data.trackAngle += 360.0f;
+    }
+
+    // Worst horizontal axis, like the hAcc of a serial receiver
+    const uint8_t stride = (msg.covariance.len == FIX2_COV_FULL_LEN) ? 7 : 1;
+    if (msg.covariance.len == FIX2_COV_DIAGONAL_LEN || msg.covariance.len == FIX2_COV_FULL_LEN) {
+        const float north = msg.covariance.data[0];
+        const float east = msg.covariance.data[stride];
+        const float down = msg.covariance.data[2 * stride];
+        data.hAcc = std::sqrt(north > east ? north : east);
+        data.vAcc = fix3D ? std::sqrt(down) : INVALID_ACCURACY;
+    } else {
+        data.hAcc = INVALID_ACCURACY;
+        data.vAcc = INVALID_ACCURACY;
+    }
+
+    // Time of week on GPS time, time of day on UTC, left at 0 for other time standards
+    const uint64_t gnssMs = msg.gnss_timestamp.usec / 1000ULL;
+    if (msg.gnss_time_standard == UAVCAN_EQUIPMENT_GNSS_FIX2_GNSS_TIME_STANDARD_UTC) {
+        data.solutionTimeMs = static_cast<uint32_t>(gnssMs % MS_PER_DAY);
+        dateFromUnixSeconds(gnssMs / 1000ULL, data.time);
+    } else if (msg.gnss_time_standard == UAVCAN_EQUIPMENT_GNSS_FIX2_GNSS_TIME_STANDARD_GPS) {
+        data.solutionTimeMs = static_cast<uint32_t>(gnssMs % MS_PER_WEEK);
+        if (msg.num_leap_seconds != UAVCAN_EQUIPMENT_GNSS_FIX2_NUM_LEAP_SECONDS_UNKNOWN) {
+            dateFromUnixSeconds(gnssMs / 1000ULL + GPS_EPOCH_UNIX_S - msg.num_leap_seconds, data.time);
+        }
+    }
+
+    fix.publish(data);
+}
+
+GpsData_t DroneCANGPS::readData() {
+    GpsData_t data {};
+    data.altitude = INVALID_ALTITUDE;
+    data.trackAngle = INVALID_TRACK_ANGLE;
+    data.hAcc = INVALID_ACCURACY;
+    data.vAcc = INVALID_ACCURACY;
+
+    data.isNew = fix.read(data);
+    return data;
+}
+
+DroneCANBarometer::DroneCANBarometer() noexcept : staticTemperatureC(ISA_SEA_LEVEL_TEMP_C) {}
+
+void DroneCANBarometer::publishStaticTemperature(const uavcan_equipment_air_data_StaticTemperature &msg) noexcept {
+    staticTemperatureC = kelvinToCelsius(msg.static_temperature, staticTemperatureC);
+}
+
+void DroneCANBarometer::publishStaticPressure(const uavcan_equipment_air_data_StaticPressure &msg) noexcept {
+    if (!(msg.static_pressure > 0.0f)) return;
+
+    BaroData_t data;
+    data.pressureKPa = msg.static_pressure / 1000.0f;
+    data.temperatureC = staticTemperatureC;
+    data.altitude = ISA_ALTITUDE_SCALE_M *
+        (1.0f - std::pow(msg.static_pressure / ISA_SEA_LEVEL_PRESSURE_PA, ISA_BAROMETRIC_EXPONENT));
+    sample.publish(data);
+}
+
+bool DroneCANBarometer::readData(BaroData_t &data) {
+    return sample.read(data);
+}
+
+DroneCANMagnetometer::DroneCANMagnetometer() noexcept : sensorId(-1) {}
+
+void DroneCANMagnetometer::publishMagneticField(const uavcan_equipment_ahrs_MagneticFieldStrength2 &msg) noexcept {
+    if (sensorId < 0) {
+        sensorId = msg.sensor_id;
+    } else if (msg.sensor_id != sensorId) {
+        return;
+    }
+
+    MagData_t data;
+    data.x = msg.magnetic_field_ga[0];
+    data.y = msg.magnetic_field_ga[1];
+    data.z = msg.magnetic_field_ga[2];
+    field.publish(data);
+}
+
+bool DroneCANMagnetometer::readData(MagData_t &data) {
+    return field.read(data);
+}
+
+void DroneCANAirspeed::publishRawAirData(const uavcan_equipment_air_data_RawAirData &msg) noexcept {
+    if (!std::isfinite(msg.differential_pressure)) return;
+
+    AirspeedData_t data;
+    data.differentialPressurePa = msg.differential_pressure;
+    data.temperatureC = kelvinToCelsius(msg.differential_pressure_sensor_temperature,
+        kelvinToCelsius(msg.static_air_temperature, ISA_SEA_LEVEL_TEMP_C));
+    // Negative readings are sensor offset at rest, not reverse flow
+    data.airspeed = msg.differential_pressure > 0.0f ?
+        std::sqrt(2.0f * msg.differential_pressure / ISA_SEA_LEVEL_DENSITY) : 0.0f;
+    sample.publish(data);
+}
+
+bool DroneCANAirspeed::readData(AirspeedData_t &data) {
+    return sample.read(data);
+}
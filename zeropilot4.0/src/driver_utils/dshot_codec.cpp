@@ -0,0 +1,187 @@
+#include <cstring>
+#include "dshot_codec.hpp"
+
+static constexpr uint8_t DSHOT_CRC_MASK = 0x0F;
+static constexpr uint32_t GCR_MASK = 0xFFFFF;
+static constexpr uint8_t REPLY_MAX_RUN_BITS = 3;    // GCR never has more than two zeros in a row
+static constexpr uint32_t US_PER_MINUTE = 60000000;
+static constexpr uint16_t PERIOD_MANTISSA_MAX = 0x1FF;
+static constexpr uint8_t PERIOD_EXPONENT_MAX = 7;
+
+static const uint8_t GCR_ENCODE[16] = {
+    0x19, 0x1B, 0x12, 0x13, 0x1D, 0x15, 0x16, 0x17,
+    0x1A, 0x09, 0x0A, 0x0B, 0x1E, 0x0D, 0x0E, 0x0F
+};
+
+// 0xFF marks 5 bit symbols that are not valid GCR
+static const uint8_t GCR_DECODE[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x09, 0x0A, 0x0B, 0xFF, 0x0D, 0x0E, 0x0F,
+    0xFF, 0xFF, 0x02, 0x03, 0xFF, 0x05, 0x06, 0x07,
+    0xFF, 0x00, 0x08, 0x01, 0xFF, 0x04, 0x0C, 0xFF
+};
+
+uint8_t DshotCodec::frameCrc(uint16_t data12) noexcept {
+    return (data12 ^ (data12 >> 4) ^ (data12 >> 8)) & DSHOT_CRC_MASK;
+}
+
+uint16_t DshotCodec::encodeFrame(uint16_t value, bool telemetryRequest, bool bidirectional) noexcept {
+    uint16_t data = (uint16_t)(((value & DSHOT_VALUE_MAX) << 1) | (telemetryRequest ? 1 : 0));
+    uint8_t crc = frameCrc(data);
+    if (bidirectional) {
+        crc = ~crc & DSHOT_CRC_MASK;
+    }
+    return (uint16_t)((data << 4) | crc);
+}
+
+bool DshotCodec::timingForRate(uint32_t timerClockHz, uint16_t rateKbps, DshotTiming_t &timing) noexcept {
+    if (rateKbps != 150 && rateKbps != 300 && rateKbps != 600 && rateKbps != 1200) return false;
+
+    uint32_t bitHz = (uint32_t)rateKbps * 1000;
+    uint32_t period = (timerClockHz + bitHz / 2) / bitHz;
+    if (period < DSHOT_MIN_PERIOD_TICKS || period > 0xFFFF) return false;
+
+    timing.period = (uint16_t)period;
+    timing.oneCompare = (uint16_t)(period * 3 / 4);
+    timing.zeroCompare = (uint16_t)(period * 3 / 8);
+    timing.replyBitTicks = (uint16_t)(period * 4 / 5);
+    return true;
+}
+
+uint16_t DshotCodec::scaleThrottle(uint16_t num, uint16_t den, uint16_t minValue) noexcept {
+    if (den == 0 || minValue >= DSHOT_VALUE_MAX) return minValue;
+    if (num > den) num = den;
+
+    uint32_t range = DSHOT_VALUE_MAX - minValue;
+    return (uint16_t)(minValue + ((uint32_t)num * range + den / 2) / den);
+}
+
+void DshotCodec::frameToCompare(uint16_t frame, uint16_t oneCompare, uint16_t zeroCompare, uint16_t *out, uint8_t stride) noexcept {
+    for (uint8_t i = 0; i < DSHOT_FRAME_BITS; i++) {
+        bool bit = (frame >> (DSHOT_FRAME_BITS - 1 - i)) & 1;
+        out[i * stride] = bit ? oneCompare : zeroCompare;
+    }
+    out[DSHOT_FRAME_BITS * stride] = 0;
+}
+
+bool DshotCodec::decodeEdges(const uint16_t *edges, uint8_t count, uint16_t bitTicks, uint16_t &periodCode) noexcept {
+    if (count == 0 || count > DSHOT_TELEM_MAX_EDGES || bitTicks == 0) return false;
+
+    auto runBits = [bitTicks](uint16_t ticks) -> uint16_t {
+        return (uint16_t)((ticks + bitTicks / 2) / bitTicks);
+    };
+
+    // An edge left over from the end of our own frame sits well before the reply
+    uint8_t start = 0;
+    while (start + 1 < count && runBits((uint16_t)(edges[start + 1] - edges[start])) > REPLY_MAX_RUN_BITS) {
+        start++;
+    }
+
+    // Runs alternate low and high from the falling edge of the start bit
+    uint32_t line = 0;
+    uint8_t bits = 0;
+    bool high = false;
+    for (uint8_t i = start + 1; i < count; i++) {
+        uint16_t len = runBits((uint16_t)(edges[i] - edges[i - 1]));
+        if (len == 0 || len > REPLY_MAX_RUN_BITS || bits + len > DSHOT_TELEM_LINE_BITS) return false;
+
+        line = (line << len) | (high ? ((1u << len) - 1) : 0);
+        bits += len;
+        high = !high;
+    }
+
+    // The last run has no closing edge, it merges into the idle high line
+    if (!high) return false;
+    uint8_t remaining = DSHOT_TELEM_LINE_BITS - bits;
+    if (remaining > REPLY_MAX_RUN_BITS) return false;
+    line = (line << remaining) | ((1u << remaining) - 1);
+
+    return decodeLine(line, periodCode);
+}
+
+bool DshotCodec::decodeLine(uint32_t line, uint16_t &periodCode) noexcept {
+    if (line & (1u << (DSHOT_TELEM_LINE_BITS - 1))) return false; // Start bit is low
+
+    // Every transition is a GCR one
+    uint32_t gcr = (line ^ (line >> 1)) & GCR_MASK;
+
+    uint16_t data = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        uint8_t nibble = GCR_DECODE[(gcr >> (5 * i)) & 0x1F];
+        if (nibble == 0xFF) return false;
+        data |= (uint16_t)(nibble << (4 * i));
+    }
+
+    // Reply CRC is inverted, all four nibbles xor to 0xF
+    uint16_t crc = data ^ (data >> 8);
+    crc ^= crc >> 4;
+    if ((crc & DSHOT_CRC_MASK) != DSHOT_CRC_MASK) return false;
+
+    periodCode = data >> 4;
+    return true;
+}
+
+uint32_t DshotCodec::periodCodeToErpm(uint16_t periodCode) noexcept {
+    if (periodCode == DSHOT_TELEM_STOPPED) return 0;
+
+    // eeem mmmm mmmm, period in us is the mantissa shifted by the exponent
+    uint32_t periodUs = (uint32_t)(periodCode & PERIOD_MANTISSA_MAX) << (periodCode >> 9);
+    if (periodUs == 0) return 0;
+
+    return (US_PER_MINUTE + periodUs / 2) / periodUs;
+}
+
+uint16_t DshotCodec::erpmToPeriodCode(uint32_t erpm) noexcept {
+    if (erpm == 0) return DSHOT_TELEM_STOPPED;
+
+    uint32_t periodUs = (US_PER_MINUTE + erpm / 2) / erpm;
+    uint8_t exponent = 0;
+    while (periodUs > PERIOD_MANTISSA_MAX) {
+        periodUs = (periodUs + 1) >> 1;
+        exponent++;
+    }
+    if (exponent > PERIOD_EXPONENT_MAX) return DSHOT_TELEM_STOPPED;
+
+    return (uint16_t)((exponent << 9) | periodUs);
+}
+
+uint32_t DshotCodec::encodeLine(uint16_t periodCode) noexcept {
+    periodCode &= 0x0FFF;
+    uint16_t data = (uint16_t)((periodCode << 4) | (~frameCrc(periodCode) & DSHOT_CRC_MASK));
+
+    uint32_t gcr = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        gcr |= (uint32_t)GCR_ENCODE[(data >> (4 * i)) & 0x0F] << (5 * i);
+    }
+
+    // Start bit low, then flip the line on every GCR one
+    uint32_t line = 0;
+    bool level = false;
+    for (int8_t i = DSHOT_TELEM_LINE_BITS - 2; i >= 0; i--) {
+        level ^= (gcr >> i) & 1;
+        line |= (uint32_t)level << i;
+    }
+    return line;
+}
+
+void DshotCompareTable::build(uint16_t oneCompare, uint16_t zeroCompare) noexcept {
+    for (uint8_t nibble = 0; nibble < 16; nibble++) {
+        for (uint8_t bit = 0; bit < 4; bit++) {
+            nibbles_[nibble][bit] = ((nibble >> (3 - bit)) & 1) ? oneCompare : zeroCompare;
+        }
+    }
+}
+
+void DshotCompareTable::frameToCompare(uint16_t frame, uint16_t *out, uint8_t stride) const noexcept {
+    for (uint8_t i = 0; i < 4; i++) {
+        const uint16_t *bits = nibbles_[(frame >> (12 - 4 * i)) & 0x0F];
+        if (stride == 1) {
+            memcpy(&out[4 * i], bits, sizeof(nibbles_[0]));
+        } else {
+            for (uint8_t b = 0; b < 4; b++) {
+                out[(4 * i + b) * stride] = bits[b];
+            }
+        }
+    }
+    out[DSHOT_FRAME_BITS * stride] = 0;
+}
@@ -0,0 +1,512 @@
+#include "gps_stream_parser.hpp"
+
+static constexpr uint8_t UBX_SYNC_1 = 0xB5;
+static constexpr uint8_t UBX_SYNC_2 = 0x62;
+static constexpr uint16_t UBX_HEADER_LEN = 6; // Sync chars(2), class(1), ID(1), payload length(2)
+static constexpr uint16_t UBX_CHECKSUM_LEN = 2;
+
+static constexpr uint8_t UBX_MESSAGE_CLASS_NAV = 0x01;
+static constexpr uint8_t UBX_MESSAGE_ID_PVT = 0x07;
+static constexpr uint8_t UBX_MESSAGE_ID_VELECEF = 0x11;
+
+static constexpr uint16_t PVT_EXPECTED_LEN = 92;
+static constexpr uint16_t VELECEF_EXPECTED_LEN = 20;
+
+static constexpr uint8_t NMEA_SENTENCE_START = '$';
+static constexpr uint8_t NMEA_CHECKSUM_DELIMITER = '*';
+static constexpr uint8_t NMEA_FIELD_DELIMITER = ',';
+static constexpr uint8_t NMEA_TALKER_ID_LEN = 2;
+static constexpr uint8_t NMEA_ADDRESS_LEN = 5; // Talker ID(2) + sentence type(3)
+static constexpr uint32_t DECIMAL_PRECISION = 1000000;
+static constexpr float KNOTS_TO_CM_PER_S = 51.4444f;
+
+// NMEA only reports dilution of precision, scaled by a typical single point range error to estimate accuracy
+static constexpr float NMEA_UERE_M = 2.5f;
+static constexpr float NMEA_VDOP_PER_HDOP = 1.5f;
+
+// Last NMEA field each sentence needs before it can be committed
+static constexpr uint8_t RMC_LAST_FIELD = 9;
+static constexpr uint8_t GGA_LAST_FIELD = 9;
+
+static constexpr uint8_t FIX_TYPE_2D = 2;
+static constexpr uint8_t FIX_TYPE_3D = 3;
+
+// Time Validity flags: bit0 validDate, bit1 validTime, bit2 fullyResolved
+static constexpr uint8_t PVT_VALID_TIME_MASK = 0b00000111;
+// Fix status flags: bit0 gnssFixOK
+static constexpr uint8_t PVT_GNSS_FIX_OK_MASK = 0b00000001;
+
+// rawField slots
+enum : uint8_t {
+    PVT_ITOW, PVT_YEAR, PVT_MONTH, PVT_DAY, PVT_HOUR, PVT_MIN, PVT_SEC, PVT_VALID,
+    PVT_FIX_TYPE, PVT_FLAGS, PVT_NUM_SV, PVT_LON, PVT_LAT, PVT_HMSL, PVT_HACC, PVT_VACC,
+    PVT_VEL_N, PVT_VEL_E, PVT_VEL_D, PVT_GSPEED, PVT_HEAD_MOT
+};
+enum : uint8_t {
+    VELECEF_X, VELECEF_Y, VELECEF_Z
+};
+
+// Sorted by offset, payload offsets from the u-blox interface description
+const GpsStreamParser::UbxField_t GpsStreamParser::PVT_FIELDS[] = {
+    {0, 4, PVT_ITOW}, {4, 2, PVT_YEAR}, {6, 1, PVT_MONTH}, {7, 1, PVT_DAY}, {8, 1, PVT_HOUR}, {9, 1, PVT_MIN}, {10, 1, PVT_SEC}, {11, 1, PVT_VALID},
+    {20, 1, PVT_FIX_TYPE}, {21, 1, PVT_FLAGS}, {23, 1, PVT_NUM_SV},
+    {24, 4, PVT_LON}, {28, 4, PVT_LAT}, {36, 4, PVT_HMSL}, {40, 4, PVT_HACC}, {44, 4, PVT_VACC},
+    {48, 4, PVT_VEL_N}, {52, 4, PVT_VEL_E}, {56, 4, PVT_VEL_D}, {60, 4, PVT_GSPEED}, {64, 4, PVT_HEAD_MOT}
+};
+
+const GpsStreamParser::UbxField_t GpsStreamParser::VELECEF_FIELDS[] = {
+    {4, 4, VELECEF_X}, {8, 4, VELECEF_Y}, {12, 4, VELECEF_Z}
+};
+
+// Convert ASCII hex to numeric value
+static int8_t hexValue(uint8_t c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1; // Character is not a hex digit
+}
+
+GpsStreamParser::GpsStreamParser() noexcept {
+    reset();
+}
+
+void GpsStreamParser::reset() noexcept {
+    state = State_e::IDLE;
+    stats = {};
+    data = {};
+    data.hAcc = INVALID_ACCURACY;
+    data.vAcc = INVALID_ACCURACY;
+    newData = false;
+    ubxFields = nullptr;
+    ubxFieldCount = 0;
+}
+
+void GpsStreamParser::resync() noexcept {
+    if (state != State_e::IDLE) {
+        dropFrame();
+    }
+}
+
+void GpsStreamParser::feed(const uint8_t *bytes, uint16_t len) noexcept {
+    for (uint16_t i = 0; i < len; i++) {
+        feedByte(bytes[i]);
+    }
+}
+
+void GpsStreamParser::feedByte(uint8_t byte) noexcept {
+    switch (state) {
+        case State_e::IDLE:
+            if (byte == UBX_SYNC_1) {
+                state = State_e::UBX_SYNC_2;
+            } else if (byte == NMEA_SENTENCE_START) {
+                startNMEA();
+            } else {
+                stats.droppedBytes++;
+            }
+            break;
+
+        case State_e::UBX_SYNC_2:
+            if (byte == UBX_SYNC_2) {
+                startUBX();
+            } else {
+                // False sync, the byte may still open the next frame
+                stats.droppedBytes++;
+                state = State_e::IDLE;
+                feedByte(byte);
+            }
+            break;
+
+        case State_e::UBX_CLASS:
+            ckA += byte; ckB += ckA;
+            ubxClass = byte;
+            state = State_e::UBX_ID;
+            break;
+
+        case State_e::UBX_ID:
+            ckA += byte; ckB += ckA;
+            ubxId = byte;
+            state = State_e::UBX_LEN_1;
+            break;
+
+        case State_e::UBX_LEN_1:
+            ckA += byte; ckB += ckA;
+            ubxLen = byte;
+            state = State_e::UBX_LEN_2;
+            break;
+
+        case State_e::UBX_LEN_2:
+            ckA += byte; ckB += ckA;
+            ubxLen |= (uint16_t)byte << 8;
+            if (ubxLen > UBX_MAX_PAYLOAD_LEN) {
+                dropFrame(); // Corrupted length, do not swallow the stream waiting for it
+                break;
+            }
+            ubxHeaderDone();
+            state = (ubxLen == 0) ? State_e::UBX_CK_A : State_e::UBX_PAYLOAD;
+            break;
+
+        case State_e::UBX_PAYLOAD:
+            ckA += byte; ckB += ckA;
+            ubxPayloadByte(byte);
+            if (++ubxOffset == ubxLen) {
+                state = State_e::UBX_CK_A;
+            }
+            break;
+
+        case State_e::UBX_CK_A:
+            if (byte != ckA) {
+                stats.crcErrors++;
+                state = State_e::IDLE;
+                feedByte(byte);
+            } else {
+                state = State_e::UBX_CK_B;
+            }
+            break;
+
+        case State_e::UBX_CK_B:
+            state = State_e::IDLE;
+            if (byte != ckB) {
+                stats.crcErrors++;
+                feedByte(byte);
+            } else {
+                stats.framesOk++;
+                ubxCommit();
+            }
+            break;
+
+        case State_e::NMEA_BODY:
+            if (byte == NMEA_CHECKSUM_DELIMITER) {
+                nmeaFieldDone();
+                state = State_e::NMEA_CK_1;
+            } else if (byte == NMEA_SENTENCE_START) {
+                dropFrame();
+                startNMEA();
+            } else if (byte < 0x20 || byte > 0x7E) {
+                // Binary data or a line end without a checksum
+                dropFrame();
+                feedByte(byte);
+            } else if (++nmeaLen > NMEA_MAX_SENTENCE_LEN) {
+                dropFrame();
+            } else {
+                nmeaChecksum ^= byte;
+                if (byte == NMEA_FIELD_DELIMITER) {
+                    nmeaFieldDone();
+                    nmeaFieldIdx++;
+                    resetField();
+                } else {
+                    nmeaBodyByte(byte);
+                }
+            }
+            break;
+
+        case State_e::NMEA_CK_1: {
+            int8_t high = hexValue(byte);
+            if (high < 0) {
+                dropFrame();
+                feedByte(byte);
+                break;
+            }
+            nmeaReceivedChecksum = (uint8_t)(high << 4);
+            state = State_e::NMEA_CK_2;
+            break;
+        }
+
+        case State_e::NMEA_CK_2: {
+            int8_t low = hexValue(byte);
+            if (low < 0) {
+                dropFrame();
+                feedByte(byte);
+                break;
+            }
+            state = State_e::IDLE;
+            if ((nmeaReceivedChecksum | (uint8_t)low) != nmeaChecksum) {
+                stats.crcErrors++;
+                break;
+            }
+            stats.framesOk++;
+            nmeaCommit();
+            break;
+        }
+    }
+}
+
+GpsData_t GpsStreamParser::takeData() noexcept {
+    GpsData_t out = data;
+    out.isNew = newData;
+    newData = false;
+    return out;
+}
+
+void GpsStreamParser::dropFrame() noexcept {
+    stats.droppedFrames++;
+    state = State_e::IDLE;
+}
+
+void GpsStreamParser::startUBX() noexcept {
+    ckA = 0;
+    ckB = 0;
+    ubxOffset = 0;
+    state = State_e::UBX_CLASS;
+}
+
+void GpsStreamParser::ubxHeaderDone() noexcept {
+    ubxMsg = UbxMsg_e::OTHER;
+    ubxFields = nullptr;
+    ubxFieldCount = 0;
+    ubxFieldIdx = 0;
+
+    if (ubxClass != UBX_MESSAGE_CLASS_NAV) return;
+
+    if (ubxId == UBX_MESSAGE_ID_PVT && ubxLen == PVT_EXPECTED_LEN) {
+        ubxMsg = UbxMsg_e::PVT;
+        ubxFields = PVT_FIELDS;
+        ubxFieldCount = sizeof(PVT_FIELDS) / sizeof(PVT_FIELDS[0]);
+    } else if (ubxId == UBX_MESSAGE_ID_VELECEF && ubxLen == VELECEF_EXPECTED_LEN) {
+        ubxMsg = UbxMsg_e::VELECEF;
+        ubxFields = VELECEF_FIELDS;
+        ubxFieldCount = sizeof(VELECEF_FIELDS) / sizeof(VELECEF_FIELDS[0]);
+    }
+
+    for (uint8_t i = 0; i < ubxFieldCount; i++) {
+        rawField[ubxFields[i].slot] = 0;
+    }
+}
+
+void GpsStreamParser::ubxPayloadByte(uint8_t byte) noexcept {
+    // Fields are sorted, so skip past the ones this offset has already left behind
+    while (ubxFieldIdx < ubxFieldCount && ubxOffset >= ubxFields[ubxFieldIdx].offset + ubxFields[ubxFieldIdx].size) {
+        ubxFieldIdx++;
+    }
+    if (ubxFieldIdx >= ubxFieldCount) return;
+
+    const UbxField_t &f = ubxFields[ubxFieldIdx];
+    if (ubxOffset >= f.offset) {
+        rawField[f.slot] |= (uint32_t)byte << (8 * (ubxOffset - f.offset));
+    }
+}
+
+void GpsStreamParser::ubxCommit() noexcept {
+    switch (ubxMsg) {
+        case UbxMsg_e::PVT:
+            commitPVT();
+            break;
+        case UbxMsg_e::VELECEF:
+            commitVELECEF();
+            break;
+        case UbxMsg_e::OTHER:
+        default:
+            break; // Drop all other msgs
+    }
+}
+
+void GpsStreamParser::commitPVT() noexcept {
+    uint8_t fixType = (uint8_t)rawField[PVT_FIX_TYPE];
+    bool gnssFixOK = rawField[PVT_FLAGS] & PVT_GNSS_FIX_OK_MASK;
+    if (!gnssFixOK || (fixType != FIX_TYPE_2D && fixType != FIX_TYPE_3D)) return;
+
+    if ((rawField[PVT_VALID] & PVT_VALID_TIME_MASK) == PVT_VALID_TIME_MASK) {
+        data.time.year = (uint16_t)rawField[PVT_YEAR];
+        data.time.month = (uint8_t)rawField[PVT_MONTH];
+        data.time.day = (uint8_t)rawField[PVT_DAY];
+        data.time.hour = (uint8_t)rawField[PVT_HOUR];
+        data.time.minute = (uint8_t)rawField[PVT_MIN];
+        data.time.second = (uint8_t)rawField[PVT_SEC];
+    }
+
+    data.numSatellites = (uint8_t)rawField[PVT_NUM_SV];
+    data.longitude = (int32_t)rawField[PVT_LON] * 1e-7f; // 1e-7 deg to deg
+    data.latitude = (int32_t)rawField[PVT_LAT] * 1e-7f; // 1e-7 deg to deg
+    // hMSL is height above mean sea level, 2D fix carries no usable altitude
+    data.altitude = (fixType == FIX_TYPE_3D) ? (int32_t)rawField[PVT_HMSL] / 1000.0f : INVALID_ALTITUDE; // mm to m
+
+    data.vx = (int32_t)rawField[PVT_VEL_N] / 1000.0f; // mm/s to m/s
+    data.vy = (int32_t)rawField[PVT_VEL_E] / 1000.0f;
+    data.vz = (int32_t)rawField[PVT_VEL_D] / 1000.0f;
+    data.hAcc = rawField[PVT_HACC] / 1000.0f; // mm to m
+    data.vAcc = (fixType == FIX_TYPE_3D) ? rawField[PVT_VACC] / 1000.0f : INVALID_ACCURACY;
+    data.solutionTimeMs = rawField[PVT_ITOW];
+    data.groundSpeed = (int32_t)rawField[PVT_GSPEED] / 10.0f; // mm/s to cm/s
+    data.trackAngle = (int32_t)rawField[PVT_HEAD_MOT] * 1e-5f; // 1e-5 deg to deg
+
+    newData = true;
+}
+
+void GpsStreamParser::commitVELECEF() noexcept {
+    data.vx = (int32_t)rawField[VELECEF_X] / 100.0f; // cm/s to m/s
+    data.vy = (int32_t)rawField[VELECEF_Y] / 100.0f;
+    data.vz = (int32_t)rawField[VELECEF_Z] / 100.0f;
+    newData = true;
+}
+
+void GpsStreamParser::startNMEA() noexcept {
+    state = State_e::NMEA_BODY;
+    nmeaLen = 1;
+    nmeaChecksum = 0;
+    nmeaFieldIdx = 0;
+    nmeaMsg = NmeaMsg_e::OTHER;
+    pending = data;
+    pendingValid = true;
+    resetField();
+}
+
+void GpsStreamParser::resetField() noexcept {
+    field = {0, 0, 1, 0, '\0', false, false};
+}
+
+void GpsStreamParser::nmeaBodyByte(uint8_t byte) noexcept {
+    // Address field, keep the sentence type that follows the talker ID
+    if (nmeaFieldIdx == 0) {
+        if (field.len >= NMEA_TALKER_ID_LEN && field.len < NMEA_ADDRESS_LEN) {
+            nmeaType[field.len - NMEA_TALKER_ID_LEN] = (char)byte;
+        }
+        field.len++;
+        return;
+    }
+
+    if (field.len == 0) {
+        field.first = (char)byte;
+        field.negative = (byte == '-');
+    }
+    field.len++;
+
+    if (byte >= '0' && byte <= '9') {
+        uint8_t digit = byte - '0';
+        if (!field.seenDot) {
+            field.intPart = field.intPart * 10 + digit;
+        } else if (field.fracDiv < DECIMAL_PRECISION) {
+            field.fracPart = field.fracPart * 10 + digit;
+            field.fracDiv *= 10;
+        }
+    } else if (byte == '.') {
+        field.seenDot = true;
+    }
+}
+
+float GpsStreamParser::fieldValue() const noexcept {
+    float v = (float)field.intPart + (float)field.fracPart / (float)field.fracDiv;
+    return field.negative ? -v : v;
+}
+
+// NMEA times are hhmmss.ss
+uint32_t GpsStreamParser::fieldTimeOfDayMs() const noexcept {
+    uint32_t hours = field.intPart / 10000;
+    uint32_t minutes = (field.intPart / 100) % 100;
+    uint32_t seconds = field.intPart % 100;
+    return ((hours * 60 + minutes) * 60 + seconds) * 1000 + (field.fracPart * 1000) / field.fracDiv;
+}
+
+// NMEA angles are [d]ddmm.mmmm
+float GpsStreamParser::fieldDegrees() const noexcept {
+    uint32_t degrees = field.intPart / 100;
+    float minutes = (float)(field.intPart % 100) + (float)field.fracPart / (float)field.fracDiv;
+    return (float)degrees + minutes / 60.0f;
+}
+
+void GpsStreamParser::nmeaFieldDone() noexcept {
+    if (nmeaFieldIdx == 0) {
+        if (field.len != NMEA_ADDRESS_LEN) return;
+        if (nmeaType[0] == 'R' && nmeaType[1] == 'M' && nmeaType[2] == 'C') nmeaMsg = NmeaMsg_e::RMC;
+        if (nmeaType[0] == 'G' && nmeaType[1] == 'G' && nmeaType[2] == 'A') nmeaMsg = NmeaMsg_e::GGA;
+        return;
+    }
+
+    if (nmeaMsg == NmeaMsg_e::RMC) {
+        switch (nmeaFieldIdx) {
+            case 1: // hhmmss.ss
+                if (field.len == 0) { pendingValid = false; break; }
+                pending.time.hour = field.intPart / 10000;
+                pending.time.minute = (field.intPart / 100) % 100;
+                pending.time.second = field.intPart % 100;
+                pending.solutionTimeMs = fieldTimeOfDayMs();
+                break;
+            case 2: // Status, V is a receiver warning
+                if (field.first != 'A') pendingValid = false;
+                break;
+            case 3:
+                if (field.len == 0) { pendingValid = false; break; }
+                pending.latitude = fieldDegrees();
+                break;
+            case 4:
+                if (field.first == 'S') pending.latitude = -pending.latitude;
+                break;
+            case 5:
+                if (field.len == 0) { pendingValid = false; break; }
+                pending.longitude = fieldDegrees();
+                break;
+            case 6:
+                if (field.first == 'W') pending.longitude = -pending.longitude;
+                break;
+            case 7: // Knots
+                pending.groundSpeed = fieldValue() * KNOTS_TO_CM_PER_S;
+                break;
+            case 8: // Empty when there is no course over ground
+                pending.trackAngle = (field.len == 0) ? INVALID_TRACK_ANGLE : fieldValue();
+                break;
+            case 9: // ddmmyy
+                if (field.len == 0) { pendingValid = false; break; }
+                pending.time.day = field.intPart / 10000;
+                pending.time.month = (field.intPart / 100) % 100;
+                pending.time.year = field.intPart % 100;
+                break;
+            default:
+                break;
+        }
+    } else if (nmeaMsg == NmeaMsg_e::GGA) {
+        switch (nmeaFieldIdx) {
+            case 1: // No time means no solution yet
+                if (field.len == 0) { pendingValid = false; break; }
+                pending.solutionTimeMs = fieldTimeOfDayMs();
+                break;
+            case 7:
+                pending.numSatellites = (uint8_t)field.intPart;
+                break;
+            case 8: // HDOP
+                pending.hAcc = (field.len == 0) ? INVALID_ACCURACY : fieldValue() * NMEA_UERE_M;
+                pending.vAcc = (field.len == 0) ? INVALID_ACCURACY : pending.hAcc * NMEA_VDOP_PER_HDOP;
+                break;
+            case 9: // Altitude above mean sea level
+                if (field.len == 0) { pendingValid = false; break; }
+                pending.altitude = fieldValue();
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void GpsStreamParser::nmeaCommit() noexcept {
+    if (!pendingValid) return;
+
+    if ((nmeaMsg == NmeaMsg_e::RMC && nmeaFieldIdx >= RMC_LAST_FIELD) ||
+        (nmeaMsg == NmeaMsg_e::GGA && nmeaFieldIdx >= GGA_LAST_FIELD)) {
+        data = pending;
+        newData = true;
+    }
+}
+
+void GpsStreamParser::ubxChecksum(const uint8_t *bytes, uint16_t len, uint8_t &ckA, uint8_t &ckB) noexcept {
+    ckA = 0;
+    ckB = 0;
+    for (uint16_t i = 0; i < len; i++) {
+        ckA += bytes[i];
+        ckB += ckA;
+    }
+}
+
+uint16_t GpsStreamParser::encodeUBX(uint8_t msgClass, uint8_t msgId, const uint8_t *payload, uint16_t payloadLen, uint8_t *out, uint16_t outSize) noexcept {
+    uint32_t frameLen = (uint32_t)UBX_HEADER_LEN + payloadLen + UBX_CHECKSUM_LEN;
+    if (out == nullptr || frameLen > outSize) return 0;
+
+    out[0] = UBX_SYNC_1;
+    out[1] = UBX_SYNC_2;
+    out[2] = msgClass;
+    out[3] = msgId;
+    out[4] = (uint8_t)(payloadLen);
+    out[5] = (uint8_t)(payloadLen >> 8);
+    for (uint16_t i = 0; i < payloadLen; i++) {
+        out[UBX_HEADER_LEN + i] = payload[i];
+    }
+
+    ubxChecksum(out + 2, UBX_HEADER_LEN - 2 + payloadLen, out[frameLen - 2], out[frameLen - 1]);
+    return (uint16_t)frameLen;
+}
@@ -0,0 +1,185 @@
+#include "host_fft.hpp"
+#include "host_dsp_target.hpp"
+#include <cmath>
+
+namespace {
+    constexpr double TWO_PI = 6.283185307179586476925286766559;
+
+    // The real and imaginary arrays and the twiddle tables never overlap, __restrict lets the
+    // butterfly loops vectorize without a runtime overlap check for every pair of them
+
+    // First two radix-2 passes after the bit reversal merged into one, their twiddles are 1 and -i
+    HOST_DSP_KERNEL void radix4FirstStage(float *__restrict re, float *__restrict im, uint32_t n) {
+        for (uint32_t i = 0; i < n; i += 4) {
+            float aRe0 = re[i] + re[i + 1], aIm0 = im[i] + im[i + 1];
+            float aRe1 = re[i] - re[i + 1], aIm1 = im[i] - im[i + 1];
+            float aRe2 = re[i + 2] + re[i + 3], aIm2 = im[i + 2] + im[i + 3];
+            float aRe3 = re[i + 2] - re[i + 3], aIm3 = im[i + 2] - im[i + 3];
+            re[i] = aRe0 + aRe2;     im[i] = aIm0 + aIm2;
+            re[i + 2] = aRe0 - aRe2; im[i + 2] = aIm0 - aIm2;
+            // -i * a3
+            re[i + 1] = aRe1 + aIm3; im[i + 1] = aIm1 - aRe3;
+            re[i + 3] = aRe1 - aIm3; im[i + 3] = aIm1 + aRe3;
+        }
+    }
+
+    // One radix-2 decimation in time pass over all blocks of 2 * half points
+    HOST_DSP_KERNEL void radix2Stage(float *__restrict re, float *__restrict im, uint32_t n, uint32_t half,
+                                     const float *__restrict wr, const float *__restrict wi) {
+        for (uint32_t start = 0; start < n; start += 2 * half) {
+            float *aRe = re + start, *aIm = im + start;
+            float *bRe = aRe + half, *bIm = aIm + half;
+            for (uint32_t j = 0; j < half; ++j) {
+                float tr = wr[j] * bRe[j] - wi[j] * bIm[j];
+                float ti = wr[j] * bIm[j] + wi[j] * bRe[j];
+                float ur = aRe[j], ui = aIm[j];
+                aRe[j] = ur + tr; aIm[j] = ui + ti;
+                bRe[j] = ur - tr; bIm[j] = ui - ti;
+            }
+        }
+    }
+
+    HOST_DSP_KERNEL void magnitude(const float *in, float *out, uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i) {
+            float re = in[2 * i], im = in[2 * i + 1];
+            out[i] = std::sqrt(re * re + im * im);
+        }
+    }
+}
+
+bool HostFFT::init(uint16_t fftLen) {
+    if (fftLen < MIN_LENGTH || fftLen > MAX_LENGTH || (fftLen & (fftLen - 1)) != 0) return false;
+
+    const uint32_t half = fftLen / 2;
+
+    uint32_t bits = 0;
+    while ((1u << bits) < half) bits++;
+    bitReverse.resize(half);
+    for (uint32_t i = 0; i < half; ++i) {
+        uint32_t reversed = 0;
+        for (uint32_t b = 0; b < bits; ++b) {
+            reversed |= ((i >> b) & 1u) << (bits - 1 - b);
+        }
+        bitReverse[i] = static_cast<uint16_t>(reversed);
+    }
+
+    // Stage with blocks of 2 * h points starts at offset h - 1
+    stageCos.resize(half - 1);
+    stageSin.resize(half - 1);
+    for (uint32_t h = 1; h < half; h <<= 1) {
+        for (uint32_t j = 0; j < h; ++j) {
+            double angle = -TWO_PI * j / (2.0 * h);
+            stageCos[h - 1 + j] = static_cast<float>(std::cos(angle));
+            stageSin[h - 1 + j] = static_cast<float>(std::sin(angle));
+        }
+    }
+
+    splitCos.resize(half / 2 + 1);
+    splitSin.resize(half / 2 + 1);
+    for (uint32_t k = 0; k <= half / 2; ++k) {
+        double angle = -TWO_PI * k / fftLen;
+        splitCos[k] = static_cast<float>(std::cos(angle));
+        splitSin[k] = static_cast<float>(std::sin(angle));
+    }
+
+    workRe.resize(half);
+    workIm.resize(half);
+    length = fftLen;
+    return true;
+}
+
+void HostFFT::runFFT(float *in, float *out, uint8_t dir) {
+    if (length == 0) return;
+
+    if (dir == 0) {
+        forward(in, out);
+    } else if (dir == 1) {
+        inverse(in, out);
+    }
+}
+
+void HostFFT::complexMag(const float *in, float *out, uint32_t n) {
+    magnitude(in, out, n);
+}
+
+void HostFFT::complexForward() {
+    const uint32_t n = length / 2;
+    float *re = workRe.data();
+    float *im = workIm.data();
+
+    radix4FirstStage(re, im, n);
+    for (uint32_t h = 4; h < n; h <<= 1) {
+        radix2Stage(re, im, n, h, &stageCos[h - 1], &stageSin[h - 1]);
+    }
+}
+
+void HostFFT::forward(const float *in, float *out) {
+    const uint32_t n = length / 2;
+    float *re = workRe.data();
+    float *im = workIm.data();
+
+    // Even samples as the real part and odd samples as the imaginary part of an N/2 point signal
+    for (uint32_t i = 0; i < n; ++i) {
+        re[i] = in[2 * bitReverse[i]];
+        im[i] = in[2 * bitReverse[i] + 1];
+    }
+    complexForward();
+
+    // Split Z into the spectra of the even (E) and odd (O) samples and combine, X[k] = E[k] + W^k O[k]
+    out[0] = re[0] + im[0];
+    out[1] = re[0] - im[0];
+    for (uint32_t k = 1; k <= n / 2; ++k) {
+        uint32_t j = n - k;
+        float eRe = 0.5f * (re[k] + re[j]);
+        float eIm = 0.5f * (im[k] - im[j]);
+        float oRe = 0.5f * (im[k] + im[j]);
+        float oIm = -0.5f * (re[k] - re[j]);
+        float tRe = splitCos[k] * oRe - splitSin[k] * oIm;
+        float tIm = splitCos[k] * oIm + splitSin[k] * oRe;
+
+        out[2 * k] = eRe + tRe;
+        out[2 * k + 1] = eIm + tIm;
+        // X[N/2 - k] = conj(E[k] - W^k O[k])
+        out[2 * j] = eRe - tRe;
+        out[2 * j + 1] = tIm - eIm;
+    }
+}
+
+void HostFFT::inverse(const float *in, float *out) {
+    const uint32_t n = length / 2;
+    float *re = workRe.data();
+    float *im = workIm.data();
+
+    // Rebuild Z[k] = E[k] + i O[k] from the packed spectrum, conjugated so the forward transform
+    // can run the inverse, and stored in bit reversed order for it
+    float eRe = 0.5f * (in[0] + in[1]);
+    float oRe = 0.5f * (in[0] - in[1]);
+    re[0] = eRe;
+    im[0] = -oRe;
+    for (uint32_t k = 1; k <= n / 2; ++k) {
+        uint32_t j = n - k;
+        float xkRe = in[2 * k], xkIm = in[2 * k + 1];
+        float xjRe = in[2 * j], xjIm = in[2 * j + 1];
+
+        float eKRe = 0.5f * (xkRe + xjRe);
+        float eKIm = 0.5f * (xkIm - xjIm);
+        float dRe = 0.5f * (xkRe - xjRe);
+        float dIm = 0.5f * (xkIm + xjIm);
+        // O[k] = conj(W^k) (X[k] - conj(X[N/2 - k])) / 2
+        float oKRe = splitCos[k] * dRe + splitSin[k] * dIm;
+        float oKIm = splitCos[k] * dIm - splitSin[k] * dRe;
+
+        // Z[k] = E[k] + i O[k] and Z[N/2 - k] = conj(E[k]) + i conj(O[k]), both conjugated
+        re[bitReverse[k]] = eKRe - oKIm;
+        im[bitReverse[k]] = -(eKIm + oKRe);
+        re[bitReverse[j]] = eKRe + oKIm;
+        im[bitReverse[j]] = -(oKRe - eKIm);
+    }
+    complexForward();
+
+    const float scale = 1.0f / static_cast<float>(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        out[2 * i] = re[i] * scale;
+        out[2 * i + 1] = -im[i] * scale;
+    }
+}
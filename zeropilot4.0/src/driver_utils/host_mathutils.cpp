@@ -0,0 +1,400 @@
+#include "host_mathutils.hpp"
+#include "host_dsp_target.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+    constexpr float PI_F = 3.14159265358979323846f;
+
+    // Below this many elements the dispatched kernels cost more to call than they save
+    constexpr uint32_t KERNEL_MIN_ELEMENTS = 32;
+
+    // Products with narrower B rows than one AVX2 vector are faster as plain dot products
+    constexpr uint16_t ROW_KERNEL_MIN_COLS = 8;
+
+    // Fixed-size product, fully unrolled by the compiler. Goes through a local so dst may alias a source
+    template <uint16_t ROWS, uint16_t INNER, uint16_t COLS>
+    inline void multFixed(const float* a, const float* b, float* dst) {
+        float out[ROWS * COLS];
+        for (uint16_t r = 0; r < ROWS; ++r) {
+            for (uint16_t c = 0; c < COLS; ++c) {
+                float sum = 0.0f;
+                for (uint16_t k = 0; k < INNER; ++k) {
+                    sum += a[r * INNER + k] * b[k * COLS + c];
+                }
+                out[r * COLS + c] = sum;
+            }
+        }
+        memcpy(dst, out, sizeof(out));
+    }
+
+    // Narrow B, each row of dst summed in registers. Written as row updates rather than dot
+    // products so the -O3 vectorizer doesn't turn the k loop into strided gathers
+    void multNarrow(const float* a, uint16_t rowsA, uint16_t colsA, const float* b, uint16_t colsB, float* dst) {
+        for (uint16_t r = 0; r < rowsA; ++r) {
+            float acc[ROW_KERNEL_MIN_COLS] = {};
+            for (uint16_t k = 0; k < colsA; ++k) {
+                const float aRk = a[static_cast<uint32_t>(r) * colsA + k];
+                const float* bRow = b + static_cast<uint32_t>(k) * colsB;
+                for (uint16_t c = 0; c < colsB; ++c) acc[c] += aRk * bRow[c];
+            }
+            memcpy(dst + static_cast<uint32_t>(r) * colsB, acc, colsB * sizeof(float));
+        }
+    }
+
+    // Row of A times B accumulated a row of B at a time, so the inner loop runs over contiguous
+    // memory. Each element still sums over k in order, and as with CMSIS dst must not overlap a source
+    HOST_DSP_KERNEL void multRows(const float* __restrict a, uint16_t rowsA, uint16_t colsA,
+                                     const float* __restrict b, uint16_t colsB, float* __restrict dst) {
+        for (uint16_t r = 0; r < rowsA; ++r) {
+            float* __restrict dstRow = dst + static_cast<uint32_t>(r) * colsB;
+            for (uint16_t c = 0; c < colsB; ++c) dstRow[c] = 0.0f;
+            for (uint16_t k = 0; k < colsA; ++k) {
+                const float aRk = a[static_cast<uint32_t>(r) * colsA + k];
+                const float* bRow = b + static_cast<uint32_t>(k) * colsB;
+                for (uint16_t c = 0; c < colsB; ++c) dstRow[c] += aRk * bRow[c];
+            }
+        }
+    }
+
+    HOST_DSP_KERNEL void addKernel(const float* a, const float* b, float* dst, uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i) dst[i] = a[i] + b[i];
+    }
+
+    HOST_DSP_KERNEL void subKernel(const float* a, const float* b, float* dst, uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i) dst[i] = a[i] - b[i];
+    }
+
+    HOST_DSP_KERNEL void scaleKernel(const float* src, float scale, float* dst, uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i) dst[i] = src[i] * scale;
+    }
+
+    HOST_DSP_KERNEL float dotKernel(const float* a, const float* b, uint32_t n) {
+        float sum = 0.0f;
+        for (uint32_t i = 0; i < n; ++i) sum += a[i] * b[i];
+        return sum;
+    }
+
+    // dst -= factor * src over one row of the elimination
+    HOST_DSP_KERNEL void rowUpdate(float* __restrict dst, const float* __restrict src, float factor, uint16_t n) {
+        for (uint16_t j = 0; j < n; ++j) dst[j] -= factor * src[j];
+    }
+
+    // Gauss-Jordan with partial pivoting, a is destroyed and inv receives the inverse
+    bool gaussJordan(float* a, float* inv, uint16_t dim) {
+        for (uint16_t i = 0; i < dim; ++i) {
+            for (uint16_t j = 0; j < dim; ++j) inv[i * dim + j] = (i == j) ? 1.0f : 0.0f;
+        }
+
+        for (uint16_t col = 0; col < dim; ++col) {
+            uint16_t pivot = col;
+            float best = std::fabs(a[col * dim + col]);
+            for (uint16_t r = col + 1; r < dim; ++r) {
+                float v = std::fabs(a[r * dim + col]);
+                if (v > best) { best = v; pivot = r; }
+            }
+            if (best < 1e-12f) return false; // singular
+
+            if (pivot != col) {
+                std::swap_ranges(a + col * dim, a + (col + 1) * dim, a + pivot * dim);
+                std::swap_ranges(inv + col * dim, inv + (col + 1) * dim, inv + pivot * dim);
+            }
+
+            float* aPivot = a + col * dim;
+            float* invPivot = inv + col * dim;
+            float invValue = 1.0f / aPivot[col];
+            for (uint16_t j = 0; j < dim; ++j) {
+                aPivot[j] *= invValue;
+                invPivot[j] *= invValue;
+            }
+
+            for (uint16_t r = 0; r < dim; ++r) {
+                if (r == col) continue;
+                float factor = a[r * dim + col];
+                if (factor == 0.0f) continue;
+                rowUpdate(a + r * dim, aPivot, factor, dim);
+                rowUpdate(inv + r * dim, invPivot, factor, dim);
+            }
+        }
+        return true;
+    }
+}
+
+float HostMathUtils::dspSinf(float x) {
+    return sinf(x);
+}
+
+float HostMathUtils::dspCosf(float x) {
+    return cosf(x);
+}
+
+float HostMathUtils::vectorNorm(const float* src, uint16_t dim) {
+    if (dim >= KERNEL_MIN_ELEMENTS) return std::sqrt(dotKernel(src, src, dim));
+
+    float dot = 0.0f;
+    for (uint16_t i = 0; i < dim; ++i) dot += src[i] * src[i];
+    return std::sqrt(dot);
+}
+
+bool HostMathUtils::vectorNormalize(const float* src, float* dst, uint16_t dim) {
+    float norm = vectorNorm(src, dim);
+    if (norm < 1e-7f) return false;
+    matrixScale(src, 1.0f / norm, dst, 1, dim);
+    return true;
+}
+
+bool HostMathUtils::matrixAdd(const float* srcA, const float* srcB, float* dst, uint16_t rows, uint16_t cols) {
+    uint32_t n = static_cast<uint32_t>(rows) * cols;
+    if (n >= KERNEL_MIN_ELEMENTS) {
+        addKernel(srcA, srcB, dst, n);
+    } else {
+        for (uint32_t i = 0; i < n; ++i) dst[i] = srcA[i] + srcB[i];
+    }
+    return true;
+}
+
+bool HostMathUtils::matrixSub(const float* srcA, const float* srcB, float* dst, uint16_t rows, uint16_t cols) {
+    uint32_t n = static_cast<uint32_t>(rows) * cols;
+    if (n >= KERNEL_MIN_ELEMENTS) {
+        subKernel(srcA, srcB, dst, n);
+    } else {
+        for (uint32_t i = 0; i < n; ++i) dst[i] = srcA[i] - srcB[i];
+    }
+    return true;
+}
+
+bool HostMathUtils::matrixMult(const float* srcA, uint16_t rowsA, uint16_t colsA,
+                               const float* srcB, uint16_t colsB, float* dst) {
+    // Shapes used by the attitude filters each frame
+    if (colsA == 3 && colsB == 3 && rowsA == 3) {
+        multFixed<3, 3, 3>(srcA, srcB, dst);
+    } else if (colsA == 3 && colsB == 1 && rowsA == 3) {
+        multFixed<3, 3, 1>(srcA, srcB, dst);
+    } else if (colsA == 3 && colsB == 3 && rowsA == 1) {
+        multFixed<1, 3, 3>(srcA, srcB, dst);
+    } else if (colsA == 3 && colsB == 1 && rowsA == 1) {
+        multFixed<1, 3, 1>(srcA, srcB, dst);
+    } else if (colsA == 4 && colsB == 1 && rowsA == 4) {
+        multFixed<4, 4, 1>(srcA, srcB, dst);
+    } else if (colsA == 4 && colsB == 4 && rowsA == 4) {
+        multFixed<4, 4, 4>(srcA, srcB, dst);
+    } else if (colsB < ROW_KERNEL_MIN_COLS) {
+        multNarrow(srcA, rowsA, colsA, srcB, colsB, dst);
+    } else {
+        multRows(srcA, rowsA, colsA, srcB, colsB, dst);
+    }
+    return true;
+}
+
+bool HostMathUtils::matrixTranspose(const float* src, uint16_t rows, uint16_t cols, float* dst) {
+    for (uint16_t r = 0; r < rows; ++r) {
+        for (uint16_t c = 0; c < cols; ++c) {
+            dst[c * rows + r] = src[r * cols + c];
+        }
+    }
+    return true;
+}
+
+bool HostMathUtils::matrixScale(const float* src, float scale, float* dst, uint16_t rows, uint16_t cols) {
+    uint32_t n = static_cast<uint32_t>(rows) * cols;
+    if (n >= KERNEL_MIN_ELEMENTS) {
+        scaleKernel(src, scale, dst, n);
+    } else {
+        for (uint32_t i = 0; i < n; ++i) dst[i] = src[i] * scale;
+    }
+    return true;
+}
+
+bool HostMathUtils::matrixInverse(const float* src, uint16_t dim, float* dst) {
+    uint32_t n = static_cast<uint32_t>(dim) * dim;
+    if (dim <= INVERSE_STACK_DIM) {
+        float work[INVERSE_STACK_DIM * INVERSE_STACK_DIM];
+        memcpy(work, src, n * sizeof(float));
+        return gaussJordan(work, dst, dim);
+    }
+
+    std::vector<float> work(src, src + n);
+    return gaussJordan(work.data(), dst, dim);
+}
+
+void HostMathUtils::skewSymmetric(const float* v3, float* dst3x3) {
+    float x = v3[0];
+    float y = v3[1];
+    float z = v3[2];
+
+    dst3x3[0] = 0.0f;  dst3x3[1] = -z;    dst3x3[2] = y;
+    dst3x3[3] = z;     dst3x3[4] = 0.0f;  dst3x3[5] = -x;
+    dst3x3[6] = -y;    dst3x3[7] = x;     dst3x3[8] = 0.0f;
+}
+
+bool HostMathUtils::ensureSymmetric(float* m, uint16_t dim) {
+    for (uint16_t r = 0; r < dim; ++r) {
+        for (uint16_t c = r + 1; c < dim; ++c) {
+            uint32_t idx1 = r * dim + c;
+            uint32_t idx2 = c * dim + r;
+            float val = (m[idx1] + m[idx2]) * 0.5f;
+            m[idx1] = val;
+            m[idx2] = val;
+        }
+    }
+    return true;
+}
+
+void HostMathUtils::quatMultiply(const float* q1, const float* q2, float* qOut) {
+    float w = q1[0] * q2[0] - q1[1] * q2[1] - q1[2] * q2[2] - q1[3] * q2[3];
+    float x = q1[0] * q2[1] + q1[1] * q2[0] + q1[2] * q2[3] - q1[3] * q2[2];
+    float y = q1[0] * q2[2] + q1[2] * q2[0] + q1[3] * q2[1] - q1[1] * q2[3];
+    float z = q1[0] * q2[3] + q1[3] * q2[0] + q1[1] * q2[2] - q1[2] * q2[1];
+    qOut[0] = w; qOut[1] = x; qOut[2] = y; qOut[3] = z;
+}
+
+void HostMathUtils::quatInverse(const float* q, float* qOut) {
+    float normSq = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+    if (normSq < 1e-12f) {
+        qOut[0] = 1.0f; qOut[1] = 0.0f; qOut[2] = 0.0f; qOut[3] = 0.0f;
+        return;
+    }
+    float inv = 1.0f / normSq;
+    qOut[0] =  q[0] * inv;
+    qOut[1] = -q[1] * inv;
+    qOut[2] = -q[2] * inv;
+    qOut[3] = -q[3] * inv;
+}
+
+void HostMathUtils::quatNormalize(const float* q, float* qOut) {
+    float norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    if (norm < 1e-12f) {
+        qOut[0] = 1.0f; qOut[1] = 0.0f; qOut[2] = 0.0f; qOut[3] = 0.0f;
+        return;
+    }
+    float inv = 1.0f / norm;
+    qOut[0] = q[0] * inv;
+    qOut[1] = q[1] * inv;
+    qOut[2] = q[2] * inv;
+    qOut[3] = q[3] * inv;
+}
+
+void HostMathUtils::quatAverage(const float* q1, const float* q2, float* qOut) {
+    float q1n[4], q2n[4], q1Inv[4], r[4];
+
+    quatNormalize(q1, q1n);
+    quatNormalize(q2, q2n);
+    quatInverse(q1n, q1Inv);
+    quatMultiply(q1Inv, q2n, r);
+
+    if (r[0] < 0.0f) {
+        r[0] = -r[0]; r[1] = -r[1]; r[2] = -r[2]; r[3] = -r[3];
+    }
+
+    float r0 = std::fmax(-1.0f, std::fmin(1.0f, r[0]));
+    float muNorm = 2.0f * std::acos(r0);
+
+    if (muNorm < 1e-12f) {
+        std::copy(q1n, q1n + 4, qOut);
+        return;
+    }
+
+    float sinHalf = std::sin(muNorm / 2.0f);
+    float scale = muNorm / sinHalf;
+
+    float mu[3] = {r[1] * scale, r[2] * scale, r[3] * scale};
+    float halfNorm = muNorm / 2.0f;
+
+    float rN[4];
+    rN[0] = std::cos(halfNorm / 2.0f);
+
+    float axisScale = std::sin(halfNorm / 2.0f) / muNorm;
+    rN[1] = mu[0] * axisScale;
+    rN[2] = mu[1] * axisScale;
+    rN[3] = mu[2] * axisScale;
+
+    float qAvgUnnorm[4];
+    quatMultiply(q1n, rN, qAvgUnnorm);
+    quatNormalize(qAvgUnnorm, qOut);
+}
+
+void HostMathUtils::quatExponential(const float* rotVec3, float* qOut) {
+    float theta = vectorNorm(rotVec3, 3);
+
+    if (theta < 1e-12f) {
+        qOut[0] = 1.0f; qOut[1] = 0.0f; qOut[2] = 0.0f; qOut[3] = 0.0f;
+        return;
+    }
+
+    float halfTheta = theta * 0.5f;
+    float sinHalf = std::sin(halfTheta);
+
+    qOut[0] = std::cos(halfTheta);
+    qOut[1] = (rotVec3[0] / theta) * sinHalf;
+    qOut[2] = (rotVec3[1] / theta) * sinHalf;
+    qOut[3] = (rotVec3[2] / theta) * sinHalf;
+}
+
+float HostMathUtils::quatAngularDistanceDeg(const float* qTrue, const float* qEst) {
+    float qEstInv[4], qErrUnnorm[4], qErr[4];
+
+    quatInverse(qEst, qEstInv);
+    quatMultiply(qEstInv, qTrue, qErrUnnorm);
+    quatNormalize(qErrUnnorm, qErr);
+
+    if (qErr[0] < 0.0f) qErr[0] = -qErr[0];
+
+    float w = std::fmax(-1.0f, std::fmin(1.0f, qErr[0]));
+    float angleRad = 2.0f * std::acos(w);
+
+    return angleRad * (180.0f / PI_F);
+}
+
+void HostMathUtils::quatToRotationMatrix(const float* q, float* mat3x3) {
+    float qn[4];
+    quatNormalize(q, qn);
+    float w = qn[0], x = qn[1], y = qn[2], z = qn[3];
+
+    mat3x3[0] = 1.0f - 2.0f * (y * y + z * z);
+    mat3x3[1] = 2.0f * (x * y - w * z);
+    mat3x3[2] = 2.0f * (x * z + w * y);
+    mat3x3[3] = 2.0f * (x * y + w * z);
+    mat3x3[4] = 1.0f - 2.0f * (x * x + z * z);
+    mat3x3[5] = 2.0f * (y * z - w * x);
+    mat3x3[6] = 2.0f * (x * z - w * y);
+    mat3x3[7] = 2.0f * (y * z + w * x);
+    mat3x3[8] = 1.0f - 2.0f * (x * x + y * y);
+}
+
+void HostMathUtils::quatToRotationMatrixInverse(const float* q, float* mat3x3) {
+    float qInv[4];
+    quatInverse(q, qInv);
+    quatToRotationMatrix(qInv, mat3x3);
+}
+
+void HostMathUtils::quatRotateVector(const float* q, const float* v3, float* vOut3) {
+    float rot[9];
+    quatToRotationMatrix(q, rot);
+    multFixed<3, 3, 1>(rot, v3, vOut3);
+}
+
+void HostMathUtils::quatToEuler(const float* q, float* euler3) {
+    float qn[4];
+    quatNormalize(q, qn);
+    float w = qn[0], x = qn[1], y = qn[2], z = qn[3];
+
+    // Roll
+    float sinrCosp = 2.0f * (w * x + y * z);
+    float cosrCosp = 1.0f - 2.0f * (x * x + y * y);
+    euler3[0] = std::atan2(sinrCosp, cosrCosp);
+
+    // Pitch
+    float sinp = 2.0f * (w * y - z * x);
+    if (std::fabs(sinp) >= 1.0f) {
+        euler3[1] = std::copysign(PI_F / 2.0f, sinp);
+    } else {
+        euler3[1] = std::asin(sinp);
+    }
+
+    // Yaw
+    float sinyCosp = 2.0f * (w * z + x * y);
+    float cosyCosp = 1.0f - 2.0f * (y * y + z * z);
+    euler3[2] = std::atan2(sinyCosp, cosyCosp);
+}
@@ -12,26 +12,26 @@ void SMParamSetup::loadAllParams() {
     };
     for (uint8_t i = 0; i < SM_FLIGHTMODE_COUNT; i++) {
         sm->flightModes[i] = static_cast<FlightMode_e>(
-            static_cast<uint32_t>(ZP_PARAM::get(FLTMODE_PARAMS[i])));
+            static_cast<uint32_t>(sm->params->get(FLTMODE_PARAMS[i])));
     }
-    setRC1Reversed(sm, ZP_PARAM::get(ZP_PARAM_ID::RC1_REVERSED));
-    setRC2Reversed(sm, ZP_PARAM::get(ZP_PARAM_ID::RC2_REVERSED));
-    setRC3Reversed(sm, ZP_PARAM::get(ZP_PARAM_ID::RC3_REVERSED));
-    setRC4Reversed(sm, ZP_PARAM::get(ZP_PARAM_ID::RC4_REVERSED));
+    setRC1Reversed(sm, sm->params->get(ZP_PARAM_ID::RC1_REVERSED));
+    setRC2Reversed(sm, sm->params->get(ZP_PARAM_ID::RC2_REVERSED));
+    setRC3Reversed(sm, sm->params->get(ZP_PARAM_ID::RC3_REVERSED));
+    setRC4Reversed(sm, sm->params->get(ZP_PARAM_ID::RC4_REVERSED));
 }
 
 void SMParamSetup::bindAllParamCallbacks() {
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::FLTMODE1, sm, updateFltMode1);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::FLTMODE2, sm, updateFltMode2);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::FLTMODE3, sm, updateFltMode3);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::FLTMODE4, sm, updateFltMode4);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::FLTMODE5, sm, updateFltMode5);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::FLTMODE6, sm, updateFltMode6);
+    sm->params->bindCallback(ZP_PARAM_ID::FLTMODE1, sm, updateFltMode1);
+    sm->params->bindCallback(ZP_PARAM_ID::FLTMODE2, sm, updateFltMode2);
+    sm->params->bindCallback(ZP_PARAM_ID::FLTMODE3, sm, updateFltMode3);
+    sm->params->bindCallback(ZP_PARAM_ID::FLTMODE4, sm, updateFltMode4);
+    sm->params->bindCallback(ZP_PARAM_ID::FLTMODE5, sm, updateFltMode5);
+    sm->params->bindCallback(ZP_PARAM_ID::FLTMODE6, sm, updateFltMode6);
 
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::RC1_REVERSED, sm, setRC1Reversed);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::RC2_REVERSED, sm, setRC2Reversed);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::RC3_REVERSED, sm, setRC3Reversed);
-    ZP_PARAM::bindCallback(ZP_PARAM_ID::RC4_REVERSED, sm, setRC4Reversed);
+    sm->params->bindCallback(ZP_PARAM_ID::RC1_REVERSED, sm, setRC1Reversed);
+    sm->params->bindCallback(ZP_PARAM_ID::RC2_REVERSED, sm, setRC2Reversed);
+    sm->params->bindCallback(ZP_PARAM_ID::RC3_REVERSED, sm, setRC3Reversed);
+    sm->params->bindCallback(ZP_PARAM_ID::RC4_REVERSED, sm, setRC4Reversed);
 }
 
 bool SMParamSetup::setFltMode(SystemManager* ctx, uint8_t idx, float val) {
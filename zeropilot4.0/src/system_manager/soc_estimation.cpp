@@ -2,7 +2,7 @@
 #include "system_manager.hpp"
 #include "zp_params.hpp"
 
-SocEstimator::SocEstimator(BatteryData_t batteryData) {}
+SocEstimator::SocEstimator(BatteryData_t batteryData, const ParamRegistry *params) : params(params) {}
 
 uint8_t SocEstimator::getSocPercentage(){
     return socData.socPercentage;
@@ -14,8 +14,8 @@ int32_t SocEstimator::getTimeRemaining(){
 
 void SocEstimator::calcStateOfCharge(BatteryData_t batteryData, int mode) {
     float currVoltage = batteryData.pmData.busVoltage;            
-    float batteryCharge = ZP_PARAM::get(ZP_PARAM_ID::BATT_CAPACITY) * 3.6f; // mA to C
-    uint8_t nCells = ZP_PARAM::get(ZP_PARAM_ID::BATT_N_CELLS);
+    float batteryCharge = params->get(ZP_PARAM_ID::BATT_CAPACITY) * 3.6f; // mA to C
+    uint8_t nCells = params->get(ZP_PARAM_ID::BATT_N_CELLS);
     
     if (nCells == 0) return; // Prevent division by zero
     
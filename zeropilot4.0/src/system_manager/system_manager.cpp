@@ -1,3 +1,4 @@
+#include <cstdio>
 #include "system_manager.hpp"
 #include "zp_params.hpp"
 #include "flightmode.hpp"
@@ -15,7 +16,11 @@ SystemManager::SystemManager(
     IPowerModule *pmDriver,
     IMessageQueue<RCMotorControlMessage_t> *amRCQueue,
     IMessageQueue<TMMessage_t> *tmQueue,
-    IMessageQueue<char[100]> *smLoggerQueue) :
+    IMessageQueue<char[100]> *smLoggerQueue,
+    LatestValueSlot<BatteryVoltage_t> *batteryVoltage,
+    IMessageQueue<SysIdLogBlock_t> *sysIdLogQueue,
+    LatestValueSlot<CANBusStats_t> *canBusStats,
+    ParamRegistry *params) :
         systemUtilsDriver(systemUtilsDriver),
         iwdgDriver(iwdgDriver),
         loggerDriver(loggerDriver),
@@ -25,6 +30,11 @@ SystemManager::SystemManager(
         amRCQueue(amRCQueue),
         tmQueue(tmQueue),
         smLoggerQueue(smLoggerQueue),
+        batteryVoltage(batteryVoltage),
+        sysIdLogQueue(sysIdLogQueue),
+        canBusStats(canBusStats),
+        params(params != nullptr ? params : &ZP_PARAM::registry()),
+        amBudgetUs(1000000 / AttitudeManager::getConfiguredSchedulingRateHz(*this->params)),
         smSchedulingCounter(0),
         flightModes{},
         isSafetySwitchEngaged(safetySwitchDriver == nullptr ? false : true),
@@ -35,7 +45,12 @@ SystemManager::SystemManager(
         rcConnected(false),
         rcChannelReversed{},
         batteryData({PMData_t{}, MAV_BATTERY_CHARGE_STATE_OK, 0, 0}),
-        socEstimator(batteryData),
+        filteredBusVoltage(0.0f),
+        haveFilteredBusVoltage(false),
+        socEstimator(batteryData, this->params),
+        canBusStatsSeq(0),
+        lastCanBusStats{},
+        haveCanBusStats(false),
         profilerId(0),
         paramSetup(this)
 {
@@ -60,7 +75,12 @@ void SystemManager::smUpdate() {
 
     // Get RC data from the RC receiver and passthrough to AM if new
     RCControl rcData = rcDriver->getRCData();
-    if (rcData.isDataNew) {
+
+    // Receivers that report link quality may keep sending frames after the uplink is gone
+    RCLinkStats_t linkStats = rcDriver->getLinkStats();
+    bool linkLost = linkStats.isValid && linkStats.linkQuality < params->get(ZP_PARAM_ID::RC_FS_LQ);
+
+    if (rcData.isDataNew && !linkLost) {
         oldDataCount = 0;
         sendRCDataToAttitudeManager(rcData);
 
@@ -72,7 +92,7 @@ void SystemManager::smUpdate() {
     } else {
         oldDataCount += 1;
 
-        if ((oldDataCount * SM_UPDATE_LOOP_DELAY_MS > (ZP_PARAM::get(ZP_PARAM_ID::RC_FS_TIMEOUT) * 1000)) && rcConnected) {
+        if ((oldDataCount * SM_UPDATE_LOOP_DELAY_MS > (params->get(ZP_PARAM_ID::RC_FS_TIMEOUT) * 1000)) && rcConnected) {
             sendStatusTextToTelemetryManager(MAV_SEVERITY_CRITICAL, "RC Disconnected");
             // loggerDriver->log("RC Disconnected"); (TODO: Uncomment after rearchitecture)
             rcConnected = false;
@@ -113,16 +133,28 @@ void SystemManager::smUpdate() {
     // Monitor Battery State and send Battery Data to TM at a 1Hz rate
     if (updateBatteryFSM()) {
         socEstimator.calcStateOfCharge(batteryData, SOC_CHARGE_DISCHARGE_MODE);
+        publishFilteredBusVoltage(batteryData.pmData.busVoltage);
         if (smSchedulingCounter % (SM_SCHEDULING_RATE_HZ / SM_TELEMETRY_BATTERY_DATA_RATE_HZ) == 0) {
             sendBatteryDataToTelemetryManager(batteryData, 0);
         }
     }
 
+    // Battery and flight mode for the receiver telemetry downlink
+    sendTelemetryToRCReceiver(flightMode, armed);
+
     // Log if new messages
     if (smLoggerQueue->count() > 0) {
         sendMessagesToLogger();
     }
 
+    if (sysIdLogQueue != nullptr && sysIdLogQueue->count() > 0) {
+        sendSysIdBlocksToLogger();
+    }
+
+    if (canBusStats != nullptr) {
+        checkCanBusStats();
+    }
+
     // Send profiler stats at 1Hz
     if (smSchedulingCounter % (SM_SCHEDULING_RATE_HZ / SM_TELEMETRY_HEARTBEAT_RATE_HZ) == 0) {
         uint8_t count = 0;
@@ -136,9 +168,9 @@ void SystemManager::smUpdate() {
                     sendStatusTextToTelemetryManager(MAV_SEVERITY_WARNING, "SM execution time about to exceed scheduled rate");
                 }
             } else if (strcmp(profiles[i].name, "AM") == 0) {
-                if (profiles[i].maxExecUs >= (AM_UPDATE_LOOP_DELAY_MS * 1000)) {
+                if (profiles[i].maxExecUs >= amBudgetUs) {
                     sendStatusTextToTelemetryManager(MAV_SEVERITY_CRITICAL, "AM execution time exceeding scheduled rate");
-                } else if (profiles[i].maxExecUs >= 0.8f * (AM_UPDATE_LOOP_DELAY_MS * 1000)) {
+                } else if (profiles[i].maxExecUs >= 0.8f * amBudgetUs) {
                     sendStatusTextToTelemetryManager(MAV_SEVERITY_WARNING, "AM execution time about to exceed scheduled rate");
                 }
             } else if (strcmp(profiles[i].name, "TM") == 0) {
@@ -208,16 +240,16 @@ bool SystemManager::updateBatteryFSM() {
     batteryData.isValid = true;         
     currentBatteryState = batteryData.chargeState;
 
-    if (batteryData.pmData.busVoltage >= ZP_PARAM::get(ZP_PARAM_ID::BATT_LOW_VOLT)) {
+    if (batteryData.pmData.busVoltage >= params->get(ZP_PARAM_ID::BATT_LOW_VOLT)) {
         // Normal battery
         batteryData.chargeState = MAV_BATTERY_CHARGE_STATE_OK;
         batteryData.batteryLowCounterMs = 0;
         batteryData.batteryCritcounterMs = 0;
-    } else if (batteryData.pmData.busVoltage >= ZP_PARAM::get(ZP_PARAM_ID::BATT_CRT_VOLT)) {
+    } else if (batteryData.pmData.busVoltage >= params->get(ZP_PARAM_ID::BATT_CRT_VOLT)) {
         // Low battery detection
         batteryData.batteryLowCounterMs += SM_UPDATE_LOOP_DELAY_MS;
         batteryData.batteryCritcounterMs = 0;
-        uint32_t battLowTimeMs = ZP_PARAM::get(ZP_PARAM_ID::BATT_LOW_TIMER) * 1000;
+        uint32_t battLowTimeMs = params->get(ZP_PARAM_ID::BATT_LOW_TIMER) * 1000;
         if (battLowTimeMs > 0 && batteryData.batteryLowCounterMs >= battLowTimeMs) {
             batteryData.chargeState = MAV_BATTERY_CHARGE_STATE_LOW;
         }
@@ -225,7 +257,7 @@ bool SystemManager::updateBatteryFSM() {
         // Critical battery detection
         batteryData.batteryCritcounterMs += SM_UPDATE_LOOP_DELAY_MS;
         batteryData.batteryLowCounterMs = 0;
-        uint32_t battLowTimeMs = ZP_PARAM::get(ZP_PARAM_ID::BATT_LOW_TIMER) * 1000;
+        uint32_t battLowTimeMs = params->get(ZP_PARAM_ID::BATT_LOW_TIMER) * 1000;
         if (battLowTimeMs > 0 && batteryData.batteryCritcounterMs >= battLowTimeMs) {
             batteryData.chargeState = MAV_BATTERY_CHARGE_STATE_CRITICAL;
         }
@@ -254,6 +286,24 @@ bool SystemManager::updateBatteryFSM() {
     return true;
 }
 
+void SystemManager::publishFilteredBusVoltage(float busVoltage) {
+    // First order low-pass at the SM loop rate, seeded with the first reading
+    static constexpr float DT_S = 1.0f / SM_SCHEDULING_RATE_HZ;
+    static constexpr float RC = 1.0f / (2.0f * 3.14159265f * SM_BATT_VOLT_FILTER_HZ);
+    static constexpr float ALPHA = DT_S / (DT_S + RC);
+
+    if (!haveFilteredBusVoltage) {
+        filteredBusVoltage = busVoltage;
+        haveFilteredBusVoltage = true;
+    } else {
+        filteredBusVoltage += ALPHA * (busVoltage - filteredBusVoltage);
+    }
+
+    if (batteryVoltage != nullptr) {
+        batteryVoltage->publish(BatteryVoltage_t{filteredBusVoltage});
+    }
+}
+
 void SystemManager::sendRCDataToTelemetryManager(const RCControl &rcData) {
     TMMessage_t rcDataMsg = rcDataPack(systemUtilsDriver->getCurrentTimestampMs(), rcData.controlSignals, INPUT_CHANNELS);
     tmQueue->push(&rcDataMsg);
@@ -280,6 +330,48 @@ void SystemManager::sendRCDataToAttitudeManager(const RCControl &rcData) {
     amRCQueue->push(&rcDataMessage);
 }
 
+void SystemManager::sendTelemetryToRCReceiver(FlightMode_e flightMode, bool armed) {
+    RCSystemTelemetry_t telemetry = {};
+
+    telemetry.batteryValid = batteryData.isValid;
+    if (batteryData.isValid) {
+        telemetry.batteryVoltage = batteryData.pmData.busVoltage;
+        telemetry.batteryCurrent = batteryData.pmData.current;
+        telemetry.consumedMah = (batteryData.pmData.charge * 1000.0f) / 3600.0f; // C -> mAh
+        telemetry.batteryRemaining = socEstimator.getSocPercentage();
+    }
+
+    // Disarmed is shown with a trailing '*'
+    snprintf(telemetry.flightMode, sizeof(telemetry.flightMode), "%s%s", flightModeName(flightMode), armed ? "" : "*");
+
+    rcDriver->setTelemetry(telemetry);
+}
+
+const char *SystemManager::flightModeName(FlightMode_e flightMode) {
+    switch (flightMode) {
+        #ifdef PLANE
+        case FlightMode_e::MANUAL:
+            return "MANU";
+        case FlightMode_e::FBWA:
+            return "FBWA";
+        case FlightMode_e::SYSID:
+            return "SYID";
+        #endif
+        #ifdef QUADCOPTER
+        case FlightMode_e::STABILIZE:
+            return "STAB";
+        case FlightMode_e::ACRO:
+            return "ACRO";
+        case FlightMode_e::AUTOTUNE:
+            return "ATUN";
+        case FlightMode_e::SYSID:
+            return "SYID";
+        #endif
+        default:
+            return "UNKN";
+    }
+}
+
 void SystemManager::sendBatteryDataToTelemetryManager(const BatteryData_t &batteryData, const uint8_t batteryId) {   
     static constexpr uint8_t VOLTAGE_LEN = 1;
     float voltages[VOLTAGE_LEN] = {batteryData.pmData.busVoltage};
@@ -327,13 +419,48 @@ FlightMode_e SystemManager::decodeRawFlightMode(float flightModeRawValue) {
 }
 
 void SystemManager::sendMessagesToLogger() {
-    static char messages[16][100];
     int msgCount = 0;
 
     while (smLoggerQueue->count() > 0) {
-        smLoggerQueue->get(&messages[msgCount]);
+        smLoggerQueue->get(&loggerMessages[msgCount]);
         msgCount++;
     }
 
     // loggerDriver->log(messages, msgCount); (TODO: Uncomment after rearchitecture)
 }
+
+void SystemManager::sendSysIdBlocksToLogger() {
+    int blockCount = 0;
+
+    // One SD write per cycle, anything beyond waits in the queue for the next one
+    while (blockCount < SM_SYSID_LOG_BLOCKS_PER_WRITE && sysIdLogQueue->count() > 0) {
+        sysIdLogQueue->get(&sysIdLogBlocks[blockCount]);
+        blockCount++;
+    }
+
+    loggerDriver->logBinary(sysIdLogBlocks, blockCount * sizeof(SysIdLogBlock_t));
+}
+
+void SystemManager::checkCanBusStats() {
+    CANBusStats_t stats;
+    if (!canBusStats->readIfNew(stats, canBusStatsSeq)) return;
+
+    // Counters run from boot, only report what changed since the last publish
+    const CANBusStats_t prev = haveCanBusStats ? lastCanBusStats : CANBusStats_t{};
+    lastCanBusStats = stats;
+    haveCanBusStats = true;
+
+    char text[50];
+    if (stats.busOffEvents != prev.busOffEvents) {
+        snprintf(text, sizeof(text), "CAN bus off (%lu total)", (unsigned long)stats.busOffEvents);
+        sendStatusTextToTelemetryManager(MAV_SEVERITY_CRITICAL, text);
+    }
+
+    const uint32_t rxDrops = (stats.rxRingOverruns - prev.rxRingOverruns) + (stats.rxFifoOverruns - prev.rxFifoOverruns)
+        + (stats.rxPoolExhausted - prev.rxPoolExhausted);
+    const uint32_t txDrops = stats.txQueueFull - prev.txQueueFull;
+    if (rxDrops > 0 || txDrops > 0) {
+        snprintf(text, sizeof(text), "CAN dropped %lu RX, %lu TX frames", (unsigned long)rxDrops, (unsigned long)txDrops);
+        sendStatusTextToTelemetryManager(MAV_SEVERITY_WARNING, text);
+    }
+}
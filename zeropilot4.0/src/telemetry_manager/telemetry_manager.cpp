@@ -9,15 +9,21 @@ TelemetryManager::TelemetryManager(
     ITelemLink *telemLinkDriver,
     IMessageQueue<TMMessage_t> *tmTXQueueDriver,
     IMessageQueue<RCMotorControlMessage_t> *amQueueDriver,
-    IMessageQueue<mavlink_message_t> *packedMsgBuffer
+    IMessageQueue<mavlink_message_t> *packedMsgBuffer,
+    ParamRegistry *params
 ) :
     systemUtilsDriver(systemUtilsDriver),
     telemLinkDriver(telemLinkDriver),
     tmTXQueueDriver(tmTXQueueDriver),
     amQueueDriver(amQueueDriver),
     packedMsgBuffer(packedMsgBuffer),
+    params(params != nullptr ? params : &ZP_PARAM::registry()),
+    rxParseBuffer{},
+    rxParseStatus{},
+    status{},
+    txStatus{},
     overflowMsgPending(false),
-    currParamListTxIdx(ZP_PARAM::getCount()),
+    currParamListTxIdx(ParamRegistry::getCount()),
     profilerId(0),
     paramSetup(this){
 
@@ -41,7 +47,7 @@ void TelemetryManager::processParamTx() {
     constexpr uint8_t BURST_SZ = 4;
 
     for (uint8_t i = 0; i < BURST_SZ; ++i) {
-        if (currParamListTxIdx >= ZP_PARAM::getCount()) {
+        if (currParamListTxIdx >= ParamRegistry::getCount()) {
             break;
         }
 
@@ -64,11 +70,11 @@ void TelemetryManager::processTXMsgQueue() {
             case TMMessage_t::HEARTBEAT_DATA: {
                 auto heartbeatData = tmqMessage.tmMessageData.heartbeatData;
                 #ifdef PLANE
-                    mavlink_msg_heartbeat_pack(SYSTEM_ID, COMPONENT_ID, &mavlinkMessage, MAV_TYPE_FIXED_WING, MAV_AUTOPILOT_ARDUPILOTMEGA,
+                    mavlink_msg_heartbeat_pack_status(SYSTEM_ID, COMPONENT_ID, &txStatus, &mavlinkMessage, MAV_TYPE_FIXED_WING, MAV_AUTOPILOT_ARDUPILOTMEGA,
                 	    heartbeatData.baseMode, heartbeatData.customMode, heartbeatData.systemStatus);
                 #endif
                 #ifdef QUADCOPTER
-                     mavlink_msg_heartbeat_pack(SYSTEM_ID, COMPONENT_ID, &mavlinkMessage, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_ARDUPILOTMEGA,
+                     mavlink_msg_heartbeat_pack_status(SYSTEM_ID, COMPONENT_ID, &txStatus, &mavlinkMessage, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_ARDUPILOTMEGA,
                 	    heartbeatData.baseMode, heartbeatData.customMode, heartbeatData.systemStatus);
                 #endif
                 break;
@@ -76,13 +82,13 @@ void TelemetryManager::processTXMsgQueue() {
 
             case TMMessage_t::STATUSTEXT_DATA: {
                 auto& statusTextData = tmqMessage.tmMessageData.statusTextData;
-                mavlink_msg_statustext_pack(SYSTEM_ID, COMPONENT_ID, &mavlinkMessage, statusTextData.severity, statusTextData.text, statusTextData.id, statusTextData.chunkSeq);
+                mavlink_msg_statustext_pack_status(SYSTEM_ID, COMPONENT_ID, &txStatus, &mavlinkMessage, statusTextData.severity, statusTextData.text, statusTextData.id, statusTextData.chunkSeq);
                 break;
             }
 
             case TMMessage_t::GPS_RAW_DATA: {
                 auto& g = tmqMessage.tmMessageData.gpsRawData;
-                mavlink_msg_gps_raw_int_pack(SYSTEM_ID, COMPONENT_ID, &mavlinkMessage, (uint64_t)tmqMessage.timeBootMs * 1000,
+                mavlink_msg_gps_raw_int_pack_status(SYSTEM_ID, COMPONENT_ID, &txStatus, &mavlinkMessage, (uint64_t)tmqMessage.timeBootMs * 1000,
                     g.fixType, g.lat, g.lon, g.alt, g.eph, g.epv, g.vel, g.cog, g.satellitesVisible, g.altEllipsoid, 
                     g.hAcc, g.vAcc, g.velAcc, g.hdgAcc, g.yaw);
                 break;
@@ -90,7 +96,7 @@ void TelemetryManager::processTXMsgQueue() {
 
             case TMMessage_t::SERVO_OUTPUT_RAW: {
                 auto& s = tmqMessage.tmMessageData.servoOutputRawData;
-                mavlink_msg_servo_output_raw_pack(SYSTEM_ID, COMPONENT_ID, &mavlinkMessage, tmqMessage.timeBootMs, s.port,
+                mavlink_msg_servo_output_raw_pack_status(SYSTEM_ID, COMPONENT_ID, &txStatus, &mavlinkMessage, tmqMessage.timeBootMs, s.port,
                     s.servo1Raw, s.servo2Raw, s.servo3Raw, s.servo4Raw, s.servo5Raw, s.servo6Raw, s.servo7Raw, s.servo8Raw,
                     s.servo9Raw, s.servo10Raw, s.servo11Raw, s.servo12Raw, s.servo13Raw, s.servo14Raw, s.servo15Raw, s.servo16Raw);
                 break;
@@ -105,7 +111,7 @@ void TelemetryManager::processTXMsgQueue() {
             case TMMessage_t::BATTERY_DATA: {
                 auto batteryData = tmqMessage.tmMessageData.batteryData;
                 uint32_t faultBitmask =  (batteryData.chargeState == MAV_BATTERY_CHARGE_STATE_CRITICAL) ? MAV_BATTERY_FAULT_DEEP_DISCHARGE : 0;
-                mavlink_msg_battery_status_pack(SYSTEM_ID, COMPONENT_ID, &mavlinkMessage, batteryData.batteryId, MAV_BATTERY_FUNCTION_ALL, MAV_BATTERY_TYPE_LIPO,
+                mavlink_msg_battery_status_pack_status(SYSTEM_ID, COMPONENT_ID, &txStatus, &mavlinkMessage, batteryData.batteryId, MAV_BATTERY_FUNCTION_ALL, MAV_BATTERY_TYPE_LIPO,
                 	batteryData.temperature, batteryData.voltages, batteryData.currentBattery, batteryData.currentConsumed, batteryData.energyConsumed, 
                     batteryData.batteryRemaining, batteryData.timeRemaining, batteryData.chargeState, {}, 0, faultBitmask);
                 break;
@@ -113,25 +119,25 @@ void TelemetryManager::processTXMsgQueue() {
 
             case TMMessage_t::RAW_IMU_DATA: {
                 auto rawImuData = tmqMessage.tmMessageData.rawImuData;
-                mavlink_msg_raw_imu_pack(SYSTEM_ID, COMPONENT_ID, &mavlinkMessage, tmqMessage.timeBootMs, rawImuData.xacc, rawImuData.yacc, rawImuData.zacc, rawImuData.xgyro, rawImuData.ygyro, rawImuData.zgyro, rawImuData.xmag, rawImuData.ymag, rawImuData.zmag, rawImuData.id, rawImuData.temperature);
+                mavlink_msg_raw_imu_pack_status(SYSTEM_ID, COMPONENT_ID, &txStatus, &mavlinkMessage, tmqMessage.timeBootMs, rawImuData.xacc, rawImuData.yacc, rawImuData.zacc, rawImuData.xgyro, rawImuData.ygyro, rawImuData.zgyro, rawImuData.xmag, rawImuData.ymag, rawImuData.zmag, rawImuData.id, rawImuData.temperature);
                 break;
             }
 
             case TMMessage_t::ATTITUDE_DATA: {
                 auto attitudeData = tmqMessage.tmMessageData.attitudeData;
-                mavlink_msg_attitude_pack(SYSTEM_ID, COMPONENT_ID, &mavlinkMessage, tmqMessage.timeBootMs, attitudeData.roll, attitudeData.pitch, attitudeData.yaw, attitudeData.rollspeed, attitudeData.pitchspeed, attitudeData.yawspeed);
+                mavlink_msg_attitude_pack_status(SYSTEM_ID, COMPONENT_ID, &txStatus, &mavlinkMessage, tmqMessage.timeBootMs, attitudeData.roll, attitudeData.pitch, attitudeData.yaw, attitudeData.rollspeed, attitudeData.pitchspeed, attitudeData.yawspeed);
                 break;
             }
 
             case TMMessage_t::SCALED_PRESSURE_DATA: {
                 auto scaledPressureData = tmqMessage.tmMessageData.scaledPressureData;
-                mavlink_msg_scaled_pressure_pack(SYSTEM_ID, COMPONENT_ID, &mavlinkMessage, tmqMessage.timeBootMs, scaledPressureData.pressAbs, scaledPressureData.pressDiff, scaledPressureData.temperature, scaledPressureData.temperaturePressDiff);
+                mavlink_msg_scaled_pressure_pack_status(SYSTEM_ID, COMPONENT_ID, &txStatus, &mavlinkMessage, tmqMessage.timeBootMs, scaledPressureData.pressAbs, scaledPressureData.pressDiff, scaledPressureData.temperature, scaledPressureData.temperaturePressDiff);
                 break;
             }
 
             case TMMessage_t::DISTANCE_SENSOR_DATA: {
                 auto distanceSensorData = tmqMessage.tmMessageData.distanceSensorData;
-                mavlink_msg_distance_sensor_pack(SYSTEM_ID, COMPONENT_ID, &mavlinkMessage, tmqMessage.timeBootMs, distanceSensorData.minDistance, distanceSensorData.maxDistance, distanceSensorData.currentDistance, MAV_DISTANCE_SENSOR_LASER, distanceSensorData.id, MAV_SENSOR_ROTATION_PITCH_270, distanceSensorData.covariance, distanceSensorData.horizontalFov, distanceSensorData.verticalFov, distanceSensorData.quaternion, distanceSensorData.signalQuality);
+                mavlink_msg_distance_sensor_pack_status(SYSTEM_ID, COMPONENT_ID, &txStatus, &mavlinkMessage, tmqMessage.timeBootMs, distanceSensorData.minDistance, distanceSensorData.maxDistance, distanceSensorData.currentDistance, MAV_DISTANCE_SENSOR_LASER, distanceSensorData.id, MAV_SENSOR_ROTATION_PITCH_270, distanceSensorData.covariance, distanceSensorData.horizontalFov, distanceSensorData.verticalFov, distanceSensorData.quaternion, distanceSensorData.signalQuality);
                 break;
             }
 
@@ -146,7 +152,7 @@ void TelemetryManager::processTXMsgQueue() {
 	if (rc) {
 		auto& rcData = rcMsg.tmMessageData.rcData;
 		mavlink_message_t mavlinkMessage = {0};
-		mavlink_msg_rc_channels_pack(SYSTEM_ID, COMPONENT_ID, &mavlinkMessage, rcMsg.timeBootMs, rcData.channelCount,
+		mavlink_msg_rc_channels_pack_status(SYSTEM_ID, COMPONENT_ID, &txStatus, &mavlinkMessage, rcMsg.timeBootMs, rcData.channelCount,
 			rcData.channels[0], rcData.channels[1], rcData.channels[2], rcData.channels[3], 
 			rcData.channels[4], rcData.channels[5], rcData.channels[6], rcData.channels[7], 
 			rcData.channels[8], rcData.channels[9], rcData.channels[10], rcData.channels[11], 
@@ -197,9 +203,9 @@ void TelemetryManager::receive() {
 
     const uint16_t RECEIVED_BYTES = telemLinkDriver->receive(rxBuffer, sizeof(rxBuffer));
 
-    // Use mavlink_parse_char to process one byte at a time
+    // One byte at a time into this manager's own parse buffer, mavlink_parse_char would share channel 0's
     for (uint16_t i = 0; i < RECEIVED_BYTES; ++i) {
-        if (mavlink_parse_char(0, rxBuffer[i], &msgToRX, &status)) {
+        if (mavlink_frame_char_buffer(&rxParseBuffer, &rxParseStatus, rxBuffer[i], &msgToRX, &status) == MAVLINK_FRAMING_OK) {
             processRxMsg(msgToRX);
             msgToRX = {};
         }
@@ -218,7 +224,7 @@ void TelemetryManager::processRxMsg(const mavlink_message_t &msg) {
             if (paramIndex == -1) {
                 char paramId[PARAM_MAX_IDENTIFIER_LEN];
                 mavlink_msg_param_request_read_get_param_id(&msg, paramId);
-                paramIndex = ZP_PARAM::getIndexById(paramId);
+                paramIndex = params->getIndexById(paramId);
             }
 
             enqueueParamValueTx(paramIndex);
@@ -229,8 +235,8 @@ void TelemetryManager::processRxMsg(const mavlink_message_t &msg) {
             mavlink_param_set_t setMsg;
             mavlink_msg_param_set_decode(&msg, &setMsg);
 
-            if (ZP_PARAM::setParamById(setMsg.param_id, setMsg.param_value)) {
-                enqueueParamValueTx(ZP_PARAM::getIndexById(setMsg.param_id));
+            if (params->setParamById(setMsg.param_id, setMsg.param_value)) {
+                enqueueParamValueTx(params->getIndexById(setMsg.param_id));
             }
             break;
         }
@@ -241,14 +247,14 @@ void TelemetryManager::processRxMsg(const mavlink_message_t &msg) {
 }
 
 void TelemetryManager::enqueueParamValueTx(uint16_t index) {
-    Param_t* p = ZP_PARAM::getParamByIndex(index);
+    Param_t* p = params->getParamByIndex(index);
     if (!p) return;
 
     mavlink_message_t response = {0};
-    mavlink_msg_param_value_pack(
-        SYSTEM_ID, COMPONENT_ID, &response,
+    mavlink_msg_param_value_pack_status(
+        SYSTEM_ID, COMPONENT_ID, &txStatus, &response,
         p->paramId, p->paramValue, p->paramType,
-        ZP_PARAM::getCount(), index
+        ParamRegistry::getCount(), index
     );
     packedMsgBuffer->push(&response);
 }
@@ -4,13 +4,12 @@
 #include "motor_functions.hpp"
 #include <cstring>
 
-namespace ZP_PARAM {
-
-// Internal storage hidden from other files using static linkage
-static Param_t params[static_cast<uint16_t>(ZP_PARAM_ID::PARAM_COUNT)];
+ParamRegistry::ParamRegistry() {
+    init();
+}
 
 // Internal helper to initialize a single entry
-static void initParam(ZP_PARAM_ID id, const char* name, float default_val, uint8_t type) {
+void ParamRegistry::initParam(ZP_PARAM_ID id, const char* name, float default_val, uint8_t type) {
     uint16_t index = static_cast<uint16_t>(id);
     if (index >= static_cast<uint16_t>(ZP_PARAM_ID::PARAM_COUNT)) return;
 
@@ -24,7 +23,7 @@ static void initParam(ZP_PARAM_ID id, const char* name, float default_val, uint8
     params[index].setter = nullptr;
 }
 
-void init() {
+void ParamRegistry::init() {
     std::memset(params, 0, sizeof(params));
 
     // Define your parameter set
@@ -150,7 +149,7 @@ void init() {
     initParam(ZP_PARAM_ID::SERVO12_FUNCTION, "SERVO12_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED), MAV_PARAM_TYPE_INT16);
     
     #ifdef PLANE
-    initParam(ZP_PARAM_ID::MOT_PWM_TYPE, "MOT_PWM_TYPE", 0, MAV_PARAM_TYPE_UINT16);
+    initParam(ZP_PARAM_ID::MOT_PWM_TYPE, "MOT_PWM_TYPE", 0, MAV_PARAM_TYPE_UINT16); // 0 = PWM, 4-7 = DShot150/300/600/1200
 
     initParam(ZP_PARAM_ID::RLL2SRV_P, "RLL2SRV_P", 0.5f, MAV_PARAM_TYPE_REAL32);
     initParam(ZP_PARAM_ID::RLL2SRV_I, "RLL2SRV_I", 0.2f, MAV_PARAM_TYPE_REAL32);
@@ -181,11 +180,16 @@ void init() {
     #endif
 
     #ifdef QUADCOPTER
-    initParam(ZP_PARAM_ID::MOT_PWM_TYPE, "MOT_PWM_TYPE", 5, MAV_PARAM_TYPE_UINT16);
+    initParam(ZP_PARAM_ID::MOT_PWM_TYPE, "MOT_PWM_TYPE", 5, MAV_PARAM_TYPE_UINT16); // 0 = PWM, 4-7 = DShot150/300/600/1200
     
     initParam(ZP_PARAM_ID::MOT_SPIN_MIN, "MOT_SPIN_MIN", 0.15f, MAV_PARAM_TYPE_REAL32);
     initParam(ZP_PARAM_ID::MOT_SPIN_MAX, "MOT_SPIN_MAX", 0.95f, MAV_PARAM_TYPE_REAL32);
     initParam(ZP_PARAM_ID::MOT_SPIN_ARM, "MOT_SPIN_ARM", 0.05f, MAV_PARAM_TYPE_REAL32);
+    initParam(ZP_PARAM_ID::FRAME_CLASS, "FRAME_CLASS", 1, MAV_PARAM_TYPE_UINT8); // 1 = Quad, 2 = Hexa, 3 = Octa, 5 = Y6
+    initParam(ZP_PARAM_ID::FRAME_TYPE, "FRAME_TYPE", 1, MAV_PARAM_TYPE_UINT8);   // 0 = Plus, 1 = X
+    initParam(ZP_PARAM_ID::MOT_THST_EXPO, "MOT_THST_EXPO", 0.0f, MAV_PARAM_TYPE_REAL32); // 0 = linear thrust (no linearization), 1 = thrust proportional to command squared
+    initParam(ZP_PARAM_ID::MOT_BAT_VOLT_MAX, "MOT_BAT_VOLT_MAX", 0.0f, MAV_PARAM_TYPE_REAL32); // V, 0 disables voltage compensation
+    initParam(ZP_PARAM_ID::MOT_BAT_VOLT_MIN, "MOT_BAT_VOLT_MIN", 0.0f, MAV_PARAM_TYPE_REAL32); // V, 0 disables voltage compensation
     
     initParam(ZP_PARAM_ID::ATC_RAT_RLL_P, "ATC_RAT_RLL_P", 0.140f, MAV_PARAM_TYPE_REAL32);
     initParam(ZP_PARAM_ID::ATC_RAT_RLL_I, "ATC_RAT_RLL_I", 0.140f, MAV_PARAM_TYPE_REAL32);
@@ -204,6 +208,16 @@ void init() {
     initParam(ZP_PARAM_ID::ATC_RAT_YAW_D, "ATC_RAT_YAW_D", 0.0f, MAV_PARAM_TYPE_REAL32);
     initParam(ZP_PARAM_ID::ATC_RAT_YAW_TAU, "ATC_RAT_YAW_TAU", 0.020f, MAV_PARAM_TYPE_REAL32);
     initParam(ZP_PARAM_ID::ATC_RAT_YAW_IMAX, "ATC_RAT_YAW_IMAX", 50, MAV_PARAM_TYPE_UINT8);
+
+    initParam(ZP_PARAM_ID::ATC_RAT_RLL_FF, "ATC_RAT_RLL_FF", 0.0f, MAV_PARAM_TYPE_REAL32);
+    initParam(ZP_PARAM_ID::ATC_RAT_RLL_FLTD, "ATC_RAT_RLL_FLTD", 0.0f, MAV_PARAM_TYPE_REAL32); // Hz, 0 keeps the TAU filter
+    initParam(ZP_PARAM_ID::ATC_RAT_PIT_FF, "ATC_RAT_PIT_FF", 0.0f, MAV_PARAM_TYPE_REAL32);
+    initParam(ZP_PARAM_ID::ATC_RAT_PIT_FLTD, "ATC_RAT_PIT_FLTD", 0.0f, MAV_PARAM_TYPE_REAL32);
+    initParam(ZP_PARAM_ID::ATC_RAT_YAW_FF, "ATC_RAT_YAW_FF", 0.0f, MAV_PARAM_TYPE_REAL32);
+    initParam(ZP_PARAM_ID::ATC_RAT_YAW_FLTD, "ATC_RAT_YAW_FLTD", 0.0f, MAV_PARAM_TYPE_REAL32);
+    initParam(ZP_PARAM_ID::ATC_RAT_P_WGT, "ATC_RAT_P_WGT", 1.0f, MAV_PARAM_TYPE_REAL32); // Setpoint weight on P, 1 = full error
+    initParam(ZP_PARAM_ID::ATC_RAT_D_WGT, "ATC_RAT_D_WGT", 0.0f, MAV_PARAM_TYPE_REAL32); // Setpoint weight on D, 0 = derivative on measurement
+    initParam(ZP_PARAM_ID::ATC_RAT_AWU, "ATC_RAT_AWU", 0, MAV_PARAM_TYPE_UINT8);         // 0 = IMAX clamp, 1 = conditional integration
     
     initParam(ZP_PARAM_ID::ACRO_RP_RATE, "ACRO_RP_RATE", 360.0f, MAV_PARAM_TYPE_REAL32);
     initParam(ZP_PARAM_ID::ACRO_Y_RATE, "ACRO_Y_RATE", 202.5f, MAV_PARAM_TYPE_REAL32);
@@ -222,6 +236,9 @@ void init() {
 
     initParam(ZP_PARAM_ID::ATC_ANGLE_MAX, "ATC_ANGLE_MAX", 30.0f, MAV_PARAM_TYPE_REAL32);
 
+    initParam(ZP_PARAM_ID::AUTOTUNE_AXES, "AUTOTUNE_AXES", 7, MAV_PARAM_TYPE_UINT8); // Bitmask, 1 = roll, 2 = pitch, 4 = yaw
+    initParam(ZP_PARAM_ID::AUTOTUNE_TC, "AUTOTUNE_TC", 2.0f, MAV_PARAM_TYPE_REAL32);  // Rate loop time constant over measured delay, lower is more aggressive
+
     initParam(ZP_PARAM_ID::FLTMODE1, "FLTMODE1", static_cast<float>(FlightMode_e::STABILIZE), MAV_PARAM_TYPE_UINT32);
     initParam(ZP_PARAM_ID::FLTMODE2, "FLTMODE2", static_cast<float>(FlightMode_e::ACRO), MAV_PARAM_TYPE_UINT32);
     initParam(ZP_PARAM_ID::FLTMODE3, "FLTMODE3", static_cast<float>(FlightMode_e::ACRO), MAV_PARAM_TYPE_UINT32);
@@ -251,12 +268,44 @@ void init() {
     initParam(ZP_PARAM_ID::INS_HNTCH_ATT, "INS_HNTCH_ATT", 30.0f, MAV_PARAM_TYPE_REAL32);
     initParam(ZP_PARAM_ID::INS_HNTCH_HMNCS, "INS_HNTCH_HMNCS", 0x0007, MAV_PARAM_TYPE_UINT16);
 
+    initParam(ZP_PARAM_ID::SCHED_LOOP_RATE, "SCHED_LOOP_RATE", 1000, MAV_PARAM_TYPE_UINT16);
+    initParam(ZP_PARAM_ID::INS_GYRO_RATE, "INS_GYRO_RATE", 1000, MAV_PARAM_TYPE_UINT16);
+    initParam(ZP_PARAM_ID::INS_DECIM_TYPE, "INS_DECIM_TYPE", 1, MAV_PARAM_TYPE_UINT8);
+
     initParam(ZP_PARAM_ID::RNGFND_ENABLE, "RNGFND_ENABLE", 1, MAV_PARAM_TYPE_UINT8);
     initParam(ZP_PARAM_ID::RNGFND_MIN, "RNGFND_MIN", 0.1f, MAV_PARAM_TYPE_REAL32);
     initParam(ZP_PARAM_ID::RNGFND_MAX, "RNGFND_MAX", 20.0f, MAV_PARAM_TYPE_REAL32);
+
+    initParam(ZP_PARAM_ID::GPS_RATE_MS, "GPS_RATE_MS", 200, MAV_PARAM_TYPE_UINT16);
+    // Sensor sources, read once at boot. GPS_TYPE 1 = serial receivers, 9 = DroneCAN (as ArduPilot).
+    // BARO_PRIMARY 0 = onboard barometer, 1 = DroneCAN StaticPressure
+    initParam(ZP_PARAM_ID::GPS_TYPE, "GPS_TYPE", 1, MAV_PARAM_TYPE_UINT8);
+    initParam(ZP_PARAM_ID::BARO_PRIMARY, "BARO_PRIMARY", 0, MAV_PARAM_TYPE_UINT8);
+
+    // Uplink link quality (%) below which RC counts as lost, 0 disables
+    initParam(ZP_PARAM_ID::RC_FS_LQ, "RC_FS_LQ", 1, MAV_PARAM_TYPE_UINT8);
+
+    // Harmonic notch source, 3 = ESC eRPM over bidirectional DShot, 4 = FFT peak tracking
+    initParam(ZP_PARAM_ID::INS_HNTCH_MODE, "INS_HNTCH_MODE", 4, MAV_PARAM_TYPE_UINT8);
+    initParam(ZP_PARAM_ID::SERVO_BLH_POLES, "SERVO_BLH_POLES", 14, MAV_PARAM_TYPE_UINT8);
+    // Bitmask of servo outputs running bidirectional DShot, bit 0 = SERVO1
+    initParam(ZP_PARAM_ID::SERVO_BLH_BDMASK, "SERVO_BLH_BDMASK", 0, MAV_PARAM_TYPE_UINT16);
+    // Bitmasks of servo outputs sent over DroneCAN instead of the timer pin, bit 0 = SERVO1.
+    // ESC outputs go out as RawCommand index 0 = SERVO1, servos as ArrayCommand actuator_id 1 = SERVO1
+    initParam(ZP_PARAM_ID::CAN_D1_UC_ESC_BM, "CAN_D1_UC_ESC_BM", 0, MAV_PARAM_TYPE_UINT16);
+    initParam(ZP_PARAM_ID::CAN_D1_UC_SRV_BM, "CAN_D1_UC_SRV_BM", 0, MAV_PARAM_TYPE_UINT16);
+
+    // SYSID chirp, SID_AXIS values match ArduPilot: 0 = off, 1-3 = stick input, 7-9 = rate setpoint, 10-12 = mixer input
+    initParam(ZP_PARAM_ID::SID_AXIS, "SID_AXIS", 0, MAV_PARAM_TYPE_UINT8);
+    initParam(ZP_PARAM_ID::SID_MAGNITUDE, "SID_MAGNITUDE", 0.1f, MAV_PARAM_TYPE_REAL32); // Fraction of the injection point's full scale
+    initParam(ZP_PARAM_ID::SID_F_START_HZ, "SID_F_START_HZ", 0.5f, MAV_PARAM_TYPE_REAL32);
+    initParam(ZP_PARAM_ID::SID_F_STOP_HZ, "SID_F_STOP_HZ", 40.0f, MAV_PARAM_TYPE_REAL32);
+    initParam(ZP_PARAM_ID::SID_T_REC, "SID_T_REC", 30.0f, MAV_PARAM_TYPE_REAL32);
+    initParam(ZP_PARAM_ID::SID_T_FADE_IN, "SID_T_FADE_IN", 2.0f, MAV_PARAM_TYPE_REAL32);
+    initParam(ZP_PARAM_ID::SID_T_FADE_OUT, "SID_T_FADE_OUT", 2.0f, MAV_PARAM_TYPE_REAL32);
 }
 
-void bindCallbackInternal(ZP_PARAM_ID id, void* context, ParamSetterCb_t setter) {
+void ParamRegistry::bindCallbackInternal(ZP_PARAM_ID id, void* context, ParamSetterCb_t setter) {
     uint16_t index = static_cast<uint16_t>(id);
     if (index < getCount()) {
         params[index].context = context;
@@ -264,7 +313,7 @@ void bindCallbackInternal(ZP_PARAM_ID id, void* context, ParamSetterCb_t setter)
     }
 }
 
-float get(ZP_PARAM_ID id) {
+float ParamRegistry::get(ZP_PARAM_ID id) const {
     uint16_t index = static_cast<uint16_t>(id);
     if (index < getCount()) {
         return params[index].paramValue;
@@ -272,7 +321,7 @@ float get(ZP_PARAM_ID id) {
     return 0.0f; // Should never run
 }
 
-bool setParamById(const char* paramId, float new_value) {
+bool ParamRegistry::setParamById(const char* paramId, float new_value) {
     for (uint16_t i = 0; i < getCount(); ++i) {
         if (std::strncmp(params[i].paramId, paramId, PARAM_MAX_IDENTIFIER_LEN - 1) == 0) {
             
@@ -291,14 +340,14 @@ bool setParamById(const char* paramId, float new_value) {
     return false;
 }
 
-Param_t* getParamByIndex(uint16_t index) {
+Param_t* ParamRegistry::getParamByIndex(uint16_t index) {
     if (index < getCount()) {
         return &params[index];
     }
     return nullptr;
 }
 
-int16_t getIndexById(const char* paramId) {
+int16_t ParamRegistry::getIndexById(const char* paramId) const {
     for (uint16_t i = 0; i < getCount(); ++i) {
         if (std::strncmp(params[i].paramId, paramId, PARAM_MAX_IDENTIFIER_LEN - 1) == 0) return i;
     }
@@ -306,8 +355,45 @@ int16_t getIndexById(const char* paramId) {
     return static_cast<int16_t>(ZP_PARAM_ID::PARAM_COUNT);
 }
 
-uint16_t getCount() {
+uint16_t ParamRegistry::getCount() {
     return static_cast<uint16_t>(ZP_PARAM_ID::PARAM_COUNT);
 }
 
+namespace ZP_PARAM {
+
+// Registry used by the firmware, internal storage hidden from other files using static linkage
+static ParamRegistry firmwareRegistry;
+
+ParamRegistry& registry() {
+    return firmwareRegistry;
+}
+
+void init() {
+    firmwareRegistry.init();
+}
+
+void bindCallbackInternal(ZP_PARAM_ID id, void* context, ParamSetterCb_t setter) {
+    firmwareRegistry.bindCallbackInternal(id, context, setter);
+}
+
+float get(ZP_PARAM_ID id) {
+    return firmwareRegistry.get(id);
+}
+
+bool setParamById(const char* paramId, float new_value) {
+    return firmwareRegistry.setParamById(paramId, new_value);
+}
+
+Param_t* getParamByIndex(uint16_t index) {
+    return firmwareRegistry.getParamByIndex(index);
+}
+
+int16_t getIndexById(const char* paramId) {
+    return firmwareRegistry.getIndexById(paramId);
+}
+
+uint16_t getCount() {
+    return ParamRegistry::getCount();
+}
+
 } // namespace ZP_PARAM
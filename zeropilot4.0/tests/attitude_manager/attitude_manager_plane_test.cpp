@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <cmath>
 #include "attitude_manager.hpp"
 #include "zp_params.hpp"
 #include "mock_systemutils.hpp"
@@ -19,6 +20,7 @@ using ::testing::SetArgPointee;
 using ::testing::AtLeast;
 using ::testing::Invoke;
 using ::testing::NiceMock;
+using ::testing::FloatNear;
 
 class AttitudeManagerPlaneTest : public ::testing::Test {
 protected:
@@ -96,7 +98,7 @@ protected:
         ZP_PARAM::setParamById("SERVO6_FUNCTION", static_cast<float>(MotorFunction_e::GROUND_STEERING));
 
         AM_RC_FAILSAFE_ITERATIONS =
-            static_cast<int>(((ZP_PARAM::get(ZP_PARAM_ID::RC_FS_TIMEOUT)) * 1000) / AM_UPDATE_LOOP_DELAY_MS) + 5;
+            static_cast<int>(((ZP_PARAM::get(ZP_PARAM_ID::RC_FS_TIMEOUT)) * 1000) / (1000 / AM_DEFAULT_SCHEDULING_RATE_HZ)) + 5;
 
         ON_CALL(mockSystemUtils, getCurrentTimestampMs()).WillByDefault(Return(1000));
         ON_CALL(mockIMU, readRawData()).WillByDefault(Return(RawImuBatch_t{}));      // Empty batch, count 0
@@ -134,6 +136,72 @@ TEST_F(AttitudeManagerPlaneTest, MotorOutputTest) {
     am.amUpdate();
 }
 
+TEST_F(AttitudeManagerPlaneTest, NormalizedOutputEveryFunction) {
+    // Fractional inputs that whole percent would round away
+    RCMotorControlMessage_t rcMsg;
+    rcMsg.roll = 62.35f;
+    rcMsg.pitch = 37.3f;
+    rcMsg.yaw = 55.55f;
+    rcMsg.throttle = 80.4f;
+    rcMsg.arm = true;
+    rcMsg.flapAngle = 30.25f;
+    rcMsg.flightMode = FlightMode_e::MANUAL;
+
+    EXPECT_CALL(mockAMQueue, count()).WillOnce(Return(1));
+    EXPECT_CALL(mockAMQueue, get(_)).WillOnce(DoAll(SetArgPointee<0>(rcMsg), Return(0)));
+
+    EXPECT_CALL(mockRollMotor, setNormalized(FloatNear(0.6235f, 1e-4f))).Times(AtLeast(1));
+    EXPECT_CALL(mockPitchMotor, setNormalized(FloatNear(0.373f, 1e-4f))).Times(AtLeast(1));
+    EXPECT_CALL(mockYawMotor, setNormalized(FloatNear(0.5555f, 1e-4f))).Times(AtLeast(1));
+    EXPECT_CALL(mockThrottleMotor, setNormalized(FloatNear(0.804f, 1e-4f))).Times(AtLeast(1));
+    EXPECT_CALL(mockFlapMotor, setNormalized(FloatNear(0.3025f, 1e-4f))).Times(AtLeast(1));
+    EXPECT_CALL(mockSteeringMotor, setNormalized(FloatNear(0.5555f, 1e-4f))).Times(AtLeast(1));
+
+    AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup);
+
+    am.amUpdate();
+}
+
+TEST_F(AttitudeManagerPlaneTest, NormalizedOutputInvertedAndDisabled) {
+    ZP_PARAM::setParamById("SERVO1_REVERSED", 1);
+    ZP_PARAM::setParamById("SERVO5_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED));
+    ZP_PARAM::setParamById("SERVO6_FUNCTION", static_cast<float>(MotorFunction_e::GPIO));
+
+    RCMotorControlMessage_t rcMsg;
+    rcMsg.roll = 62.35f;
+    rcMsg.pitch = 50.0f;
+    rcMsg.yaw = 50.0f;
+    rcMsg.throttle = 0.0f;
+    rcMsg.arm = true;
+    rcMsg.flapAngle = 30.0f;
+    rcMsg.flightMode = FlightMode_e::MANUAL;
+
+    EXPECT_CALL(mockAMQueue, count()).WillOnce(Return(1));
+    EXPECT_CALL(mockAMQueue, get(_)).WillOnce(DoAll(SetArgPointee<0>(rcMsg), Return(0)));
+
+    EXPECT_CALL(mockRollMotor, setNormalized(FloatNear(1.0f - 0.6235f, 1e-4f))).Times(AtLeast(1));
+    EXPECT_CALL(mockFlapMotor, setNormalized(_)).Times(0);
+    EXPECT_CALL(mockSteeringMotor, setNormalized(_)).Times(0);
+
+    AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup);
+
+    am.amUpdate();
+}
+
+TEST_F(AttitudeManagerPlaneTest, NormalizedShimRoundsToPercent) {
+    // Outputs without a native high resolution path still get the nearest whole percent
+    EXPECT_CALL(mockRollMotor, set(62));
+    EXPECT_CALL(mockRollMotor, set(63));
+    EXPECT_CALL(mockRollMotor, set(0)).Times(2);
+    EXPECT_CALL(mockRollMotor, set(100));
+
+    mockRollMotor.setNormalized(0.6235f);
+    mockRollMotor.setNormalized(0.625f);
+    mockRollMotor.setNormalized(-0.5f);
+    mockRollMotor.setNormalized(NAN);
+    mockRollMotor.setNormalized(1.5f);
+}
+
 TEST_F(AttitudeManagerPlaneTest, DisarmThrottleZero) {
     RCMotorControlMessage_t rcMsg;
     rcMsg.roll = 50.0f;
@@ -274,3 +342,144 @@ TEST_F(AttitudeManagerPlaneTest, MotorClampingUpper) {
 
     am.amUpdate();
 }
+
+TEST_F(AttitudeManagerPlaneTest, FastPathSticksBypassSMRelay) {
+    RCMotorControlMessage_t rcMsg;
+    rcMsg.roll = 50.0f;
+    rcMsg.pitch = 50.0f;
+    rcMsg.yaw = 50.0f;
+    rcMsg.throttle = 50.0f;
+    rcMsg.arm = true;
+    rcMsg.flapAngle = 0.0f;
+    rcMsg.flightMode = FlightMode_e::MANUAL;
+
+    // SM relays arm and mode once, then stays quiet
+    EXPECT_CALL(mockAMQueue, count()).WillOnce(Return(1)).WillRepeatedly(Return(0));
+    EXPECT_CALL(mockAMQueue, get(_)).WillOnce(DoAll(SetArgPointee<0>(rcMsg), Return(0)));
+
+    uint32_t rollValue = 0;
+    ON_CALL(mockRollMotor, set(_)).WillByDefault(Invoke([&rollValue](uint32_t val) { rollValue = val; }));
+
+    LatestValueSlot<RCChannelFrame_t> rcFastPath;
+    AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup, &rcFastPath);
+
+    am.amUpdate();
+    EXPECT_EQ(rollValue, 50u);
+
+    // A receiver frame reaches the servos on the very next loop
+    RCChannelFrame_t frame = {};
+    frame.controlSignals[0] = 80.0f;
+    frame.controlSignals[1] = 50.0f;
+    frame.controlSignals[2] = 50.0f;
+    frame.controlSignals[3] = 50.0f;
+    rcFastPath.publish(frame);
+
+    am.amUpdate();
+    EXPECT_EQ(rollValue, 80u);
+}
+
+TEST_F(AttitudeManagerPlaneTest, FastPathAppliesChannelReversal) {
+    ZP_PARAM::setParamById("RC1_REVERSED", 1);
+
+    RCMotorControlMessage_t rcMsg;
+    rcMsg.roll = 50.0f;
+    rcMsg.pitch = 50.0f;
+    rcMsg.yaw = 50.0f;
+    rcMsg.throttle = 50.0f;
+    rcMsg.arm = true;
+    rcMsg.flapAngle = 0.0f;
+    rcMsg.flightMode = FlightMode_e::MANUAL;
+
+    EXPECT_CALL(mockAMQueue, count()).WillOnce(Return(1));
+    EXPECT_CALL(mockAMQueue, get(_)).WillOnce(DoAll(SetArgPointee<0>(rcMsg), Return(0)));
+
+    uint32_t rollValue = 0;
+    ON_CALL(mockRollMotor, set(_)).WillByDefault(Invoke([&rollValue](uint32_t val) { rollValue = val; }));
+
+    LatestValueSlot<RCChannelFrame_t> rcFastPath;
+    RCChannelFrame_t frame = {};
+    frame.controlSignals[0] = 80.0f;
+    frame.controlSignals[1] = 50.0f;
+    frame.controlSignals[3] = 50.0f;
+    rcFastPath.publish(frame);
+
+    AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup, &rcFastPath);
+
+    am.amUpdate();
+    EXPECT_EQ(rollValue, 20u);
+}
+
+TEST_F(AttitudeManagerPlaneTest, StaleFastPathFallsBackToSMRelay) {
+    RCMotorControlMessage_t rcMsg;
+    rcMsg.roll = 50.0f;
+    rcMsg.pitch = 50.0f;
+    rcMsg.yaw = 50.0f;
+    rcMsg.throttle = 50.0f;
+    rcMsg.arm = true;
+    rcMsg.flapAngle = 0.0f;
+    rcMsg.flightMode = FlightMode_e::MANUAL;
+
+    // SM keeps relaying so failsafe never triggers
+    ON_CALL(mockAMQueue, count()).WillByDefault(Return(1));
+    ON_CALL(mockAMQueue, get(_)).WillByDefault(DoAll(SetArgPointee<0>(rcMsg), Return(0)));
+
+    uint32_t rollValue = 0;
+    ON_CALL(mockRollMotor, set(_)).WillByDefault(Invoke([&rollValue](uint32_t val) { rollValue = val; }));
+
+    LatestValueSlot<RCChannelFrame_t> rcFastPath;
+    RCChannelFrame_t frame = {};
+    frame.controlSignals[0] = 80.0f;
+    frame.controlSignals[1] = 50.0f;
+    frame.controlSignals[3] = 50.0f;
+    rcFastPath.publish(frame);
+
+    AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup, &rcFastPath);
+
+    am.amUpdate();
+    EXPECT_EQ(rollValue, 80u);
+
+    for (int i = 0; i < AM_RC_FAILSAFE_ITERATIONS; i++) {
+        am.amUpdate();
+    }
+    EXPECT_EQ(rollValue, 50u);
+}
+
+TEST_F(AttitudeManagerPlaneTest, FastPathIgnoresFramesBelowLinkQualityFailsafe) {
+    ZP_PARAM::setParamById("RC_FS_LQ", 50);
+
+    RCMotorControlMessage_t rcMsg;
+    rcMsg.roll = 50.0f;
+    rcMsg.pitch = 50.0f;
+    rcMsg.yaw = 50.0f;
+    rcMsg.throttle = 50.0f;
+    rcMsg.arm = true;
+    rcMsg.flapAngle = 0.0f;
+    rcMsg.flightMode = FlightMode_e::MANUAL;
+
+    ON_CALL(mockAMQueue, count()).WillByDefault(Return(1));
+    ON_CALL(mockAMQueue, get(_)).WillByDefault(DoAll(SetArgPointee<0>(rcMsg), Return(0)));
+
+    uint32_t rollValue = 0;
+    ON_CALL(mockRollMotor, set(_)).WillByDefault(Invoke([&rollValue](uint32_t val) { rollValue = val; }));
+
+    LatestValueSlot<RCChannelFrame_t> rcFastPath;
+    AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup, &rcFastPath);
+
+    // Receiver still decodes frames, but SM already treats the link as lost
+    RCChannelFrame_t frame = {};
+    frame.controlSignals[0] = 80.0f;
+    frame.controlSignals[1] = 50.0f;
+    frame.controlSignals[3] = 50.0f;
+    frame.linkStats.isValid = true;
+    frame.linkStats.linkQuality = 20;
+    rcFastPath.publish(frame);
+
+    am.amUpdate();
+    EXPECT_EQ(rollValue, 50u);
+
+    frame.linkStats.linkQuality = 80;
+    rcFastPath.publish(frame);
+
+    am.amUpdate();
+    EXPECT_EQ(rollValue, 80u);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <cmath>
 #include "attitude_manager.hpp"
 #include "zp_params.hpp"
 #include "mock_systemutils.hpp"
@@ -22,6 +23,7 @@ using ::testing::NiceMock;
 using ::testing::AnyNumber;
 using ::testing::Ge;
 using ::testing::Gt;
+using ::testing::FloatNear;
 
 class AttitudeManagerQuadTest : public ::testing::Test {
 protected:
@@ -63,7 +65,7 @@ protected:
         ZP_PARAM::setParamById("SERVO4_FUNCTION", static_cast<float>(MotorFunction_e::MOTOR_4));
 
         AM_RC_FAILSAFE_ITERATIONS =
-            static_cast<int>(((ZP_PARAM::get(ZP_PARAM_ID::RC_FS_TIMEOUT)) * 1000) / AM_UPDATE_LOOP_DELAY_MS) + 5;
+            static_cast<int>(((ZP_PARAM::get(ZP_PARAM_ID::RC_FS_TIMEOUT)) * 1000) / (1000 / AM_DEFAULT_SCHEDULING_RATE_HZ)) + 5;
 
         ON_CALL(mockSystemUtils, getCurrentTimestampMs()).WillByDefault(Return(1000));
         ON_CALL(mockIMU, readRawData()).WillByDefault(Return(RawImuBatch_t{}));      // Empty batch, count 0
@@ -115,6 +117,73 @@ TEST_F(AttitudeManagerQuadTest, MotorOutputTest) {
     am.amUpdate();
 }
 
+TEST_F(AttitudeManagerQuadTest, NormalizedOutputEveryMotor) {
+    // Default linear thrust, mixer output passes straight through
+
+    RCMotorControlMessage_t rcMsg;
+    rcMsg.roll = 50.0f;
+    rcMsg.pitch = 50.0f;
+    rcMsg.yaw = 50.0f;
+    rcMsg.throttle = 33.3f;
+    rcMsg.arm = true;
+    rcMsg.flightMode = FlightMode_e::ACRO;
+
+    EXPECT_CALL(mockAMQueue, count()).WillOnce(Return(1));
+    EXPECT_CALL(mockAMQueue, get(_)).WillOnce(DoAll(SetArgPointee<0>(rcMsg), Return(0)));
+
+    // Centered sticks put every motor at the same point of the spin range, finer than whole percent
+    float spinMin = ZP_PARAM::get(ZP_PARAM_ID::MOT_SPIN_MIN);
+    float spinMax = ZP_PARAM::get(ZP_PARAM_ID::MOT_SPIN_MAX);
+    float expected = spinMin + 0.333f * (spinMax - spinMin);
+
+    EXPECT_CALL(motor1, setNormalized(FloatNear(expected, 1e-4f))).Times(AtLeast(1));
+    EXPECT_CALL(motor2, setNormalized(FloatNear(expected, 1e-4f))).Times(AtLeast(1));
+    EXPECT_CALL(motor3, setNormalized(FloatNear(expected, 1e-4f))).Times(AtLeast(1));
+    EXPECT_CALL(motor4, setNormalized(FloatNear(expected, 1e-4f))).Times(AtLeast(1));
+
+    AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup);
+
+    am.amUpdate();
+}
+
+TEST_F(AttitudeManagerQuadTest, ThrustCurveAndVoltageCompensation) {
+    ZP_PARAM::setParamById("MOT_THST_EXPO", 0.65f);
+    ZP_PARAM::setParamById("MOT_BAT_VOLT_MAX", 16.8f);
+    ZP_PARAM::setParamById("MOT_BAT_VOLT_MIN", 13.2f);
+
+    RCMotorControlMessage_t rcMsg;
+    rcMsg.roll = 50.0f;
+    rcMsg.pitch = 50.0f;
+    rcMsg.yaw = 50.0f;
+    rcMsg.throttle = 33.3f;
+    rcMsg.arm = true;
+    rcMsg.flightMode = FlightMode_e::ACRO;
+
+    EXPECT_CALL(mockAMQueue, count()).WillOnce(Return(1));
+    EXPECT_CALL(mockAMQueue, get(_)).WillOnce(DoAll(SetArgPointee<0>(rcMsg), Return(0)));
+
+    LatestValueSlot<BatteryVoltage_t> batteryVoltage;
+    batteryVoltage.publish(BatteryVoltage_t{14.0f});
+
+    // Inverse of the MOT_THST_EXPO curve, boosted by the sag below MOT_BAT_VOLT_MAX
+    float expo = ZP_PARAM::get(ZP_PARAM_ID::MOT_THST_EXPO);
+    float actuator = ((expo - 1.0f) + sqrtf((1.0f - expo) * (1.0f - expo) + 4.0f * expo * 0.333f)) / (2.0f * expo);
+    actuator *= 16.8f / 14.0f;
+    float spinMin = ZP_PARAM::get(ZP_PARAM_ID::MOT_SPIN_MIN);
+    float spinMax = ZP_PARAM::get(ZP_PARAM_ID::MOT_SPIN_MAX);
+    float expected = spinMin + actuator * (spinMax - spinMin);
+
+    EXPECT_CALL(motor1, setNormalized(FloatNear(expected, 2e-4f))).Times(AtLeast(1));
+    EXPECT_CALL(motor2, setNormalized(FloatNear(expected, 2e-4f))).Times(AtLeast(1));
+    EXPECT_CALL(motor3, setNormalized(FloatNear(expected, 2e-4f))).Times(AtLeast(1));
+    EXPECT_CALL(motor4, setNormalized(FloatNear(expected, 2e-4f))).Times(AtLeast(1));
+
+    AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup,
+                       nullptr, nullptr, &batteryVoltage);
+
+    am.amUpdate();
+}
+
 TEST_F(AttitudeManagerQuadTest, DisarmThrottleZero) {
     RCMotorControlMessage_t rcMsg;
     rcMsg.roll = 50.0f;
@@ -207,3 +276,23 @@ TEST_F(AttitudeManagerQuadTest, MotorClampingUpper) {
 
     am.amUpdate();
 }
+
+TEST_F(AttitudeManagerQuadTest, RpmNotchReadsMotorTelemetry) {
+    ZP_PARAM::setParamById("INS_HNTCH_MODE", static_cast<float>(HarmonicNotchMode_e::ESC_RPM));
+
+    EXPECT_CALL(mockFFT, init(_)).Times(0);
+    EXPECT_CALL(motor1, readErpm(_)).Times(AtLeast(1)).WillRepeatedly(DoAll(testing::SetArgReferee<0>(16800u), Return(true)));
+    EXPECT_CALL(motor2, readErpm(_)).Times(AtLeast(1)).WillRepeatedly(Return(false));
+    EXPECT_CALL(motor3, readErpm(_)).Times(AtLeast(1)).WillRepeatedly(Return(false));
+    EXPECT_CALL(motor4, readErpm(_)).Times(AtLeast(1)).WillRepeatedly(Return(false));
+
+    AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup);
+    am.amUpdate();
+}
+
+TEST_F(AttitudeManagerQuadTest, FftNotchIgnoresMotorTelemetry) {
+    EXPECT_CALL(motor1, readErpm(_)).Times(0);
+
+    AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup);
+    am.amUpdate();
+}
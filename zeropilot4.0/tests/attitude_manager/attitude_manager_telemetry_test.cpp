@@ -83,7 +83,7 @@ TEST_F(AttitudeManagerTelemetryTest, RawIMUTelemetrySent) {
 
     AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup);
 
-    for (int i = 0; i < AM_SCHEDULING_RATE_HZ; i++) {
+    for (int i = 0; i < AM_DEFAULT_SCHEDULING_RATE_HZ; i++) {
         am.amUpdate();
     }
 
@@ -113,7 +113,7 @@ TEST_F(AttitudeManagerTelemetryTest, AttitudeTelemetrySent) {
 
     AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup);
 
-    for (int i = 0; i < AM_SCHEDULING_RATE_HZ; i++) {
+    for (int i = 0; i < AM_DEFAULT_SCHEDULING_RATE_HZ; i++) {
         am.amUpdate();
     }
 
@@ -147,7 +147,7 @@ TEST_F(AttitudeManagerTelemetryTest, RawGPSTelemetrySent) {
 
     AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup);
 
-    for (int i = 0; i < AM_SCHEDULING_RATE_HZ; i++) {
+    for (int i = 0; i < AM_DEFAULT_SCHEDULING_RATE_HZ; i++) {
         am.amUpdate();
     }
 
@@ -166,7 +166,7 @@ TEST_F(AttitudeManagerTelemetryTest, ServoOutputRawTelemetrySent) {
 
     AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup);
 
-    for (int i = 0; i < AM_SCHEDULING_RATE_HZ; i++) {
+    for (int i = 0; i < AM_DEFAULT_SCHEDULING_RATE_HZ; i++) {
         am.amUpdate();
     }
 
@@ -195,9 +195,44 @@ TEST_F(AttitudeManagerTelemetryTest, ScaledPressureTelemetrySent) {
 
     AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup);
 
-    for (int i = 0; i < AM_SCHEDULING_RATE_HZ; i++) {
+    for (int i = 0; i < AM_DEFAULT_SCHEDULING_RATE_HZ; i++) {
         am.amUpdate();
     }
 
     EXPECT_EQ(pressureCount, AM_TELEMETRY_SCALED_PRESSURE_DATA_RATE_HZ);
 }
+
+TEST_F(AttitudeManagerTelemetryTest, OwnParamRegistrySetsLoopRate) {
+    // A second vehicle in the same process, the firmware registry keeps its defaults
+    ParamRegistry vehicleParams;
+    ASSERT_TRUE(vehicleParams.setParamById("SCHED_LOOP_RATE", 500));
+
+    RawImu_t rawImu {};
+    RawImuBatch_t rawImuBatch{&rawImu, 1};
+    EXPECT_CALL(mockIMU, readRawData()).WillRepeatedly(Return(rawImuBatch));
+
+    int rawImuCount = 0;
+    EXPECT_CALL(mockTMQueue, push(_))
+        .WillRepeatedly(Invoke([&rawImuCount](TMMessage_t* msg) {
+            if (msg->dataType == TMMessage_t::RAW_IMU_DATA) {
+                rawImuCount++;
+            }
+            return 0;
+        }));
+
+    AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup,
+        nullptr, nullptr, nullptr, nullptr, nullptr, &vehicleParams);
+    ASSERT_EQ(am.getSchedulingRateHz(), 500);
+
+    // Callbacks went to the vehicle's registry only
+    const uint16_t rateIndex = static_cast<uint16_t>(ZP_PARAM_ID::SCHED_LOOP_RATE);
+    EXPECT_NE(vehicleParams.getParamByIndex(rateIndex)->setter, nullptr);
+    EXPECT_EQ(ZP_PARAM::getParamByIndex(rateIndex)->setter, nullptr);
+    EXPECT_FLOAT_EQ(ZP_PARAM::get(ZP_PARAM_ID::SCHED_LOOP_RATE), AM_DEFAULT_SCHEDULING_RATE_HZ);
+
+    for (int i = 0; i < 500; i++) {
+        am.amUpdate();
+    }
+
+    EXPECT_EQ(rawImuCount, AM_TELEMETRY_RAW_IMU_DATA_RATE_HZ);
+}
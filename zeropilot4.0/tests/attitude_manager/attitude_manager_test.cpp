@@ -96,7 +96,7 @@ protected:
         ZP_PARAM::setParamById("SERVO6_FUNCTION", static_cast<float>(MotorFunction_e::GROUND_STEERING));
 
         AM_RC_FAILSAFE_ITERATIONS =
-            static_cast<int>(((ZP_PARAM::get(ZP_PARAM_ID::RC_FS_TIMEOUT)) * 1000) / AM_UPDATE_LOOP_DELAY_MS) + 5;
+            static_cast<int>(((ZP_PARAM::get(ZP_PARAM_ID::RC_FS_TIMEOUT)) * 1000) / (1000 / AM_DEFAULT_SCHEDULING_RATE_HZ)) + 5;
 
         ON_CALL(mockSystemUtils, getCurrentTimestampMs()).WillByDefault(Return(1000));
         ON_CALL(mockIMU, readRawData()).WillByDefault(Return(RawImuBatch_t{}));      // empty batch, count 0
@@ -299,7 +299,7 @@ TEST_F(AttitudeManagerTest, RawIMUTelemetrySent) {
     
     AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup);
     
-    for (int i = 0; i < AM_SCHEDULING_RATE_HZ; i++) {
+    for (int i = 0; i < AM_DEFAULT_SCHEDULING_RATE_HZ; i++) {
         am.amUpdate();
     }
     
@@ -329,7 +329,7 @@ TEST_F(AttitudeManagerTest, AttitudeTelemetrySent) {
     
     AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup);
     
-    for (int i = 0; i < AM_SCHEDULING_RATE_HZ; i++) {
+    for (int i = 0; i < AM_DEFAULT_SCHEDULING_RATE_HZ; i++) {
         am.amUpdate();
     }
     
@@ -363,7 +363,7 @@ TEST_F(AttitudeManagerTest, RawGPSTelemetrySent) {
     
     AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup);
     
-    for (int i = 0; i < AM_SCHEDULING_RATE_HZ; i++) {
+    for (int i = 0; i < AM_DEFAULT_SCHEDULING_RATE_HZ; i++) {
         am.amUpdate();
     }
     
@@ -382,7 +382,7 @@ TEST_F(AttitudeManagerTest, ServoOutputRawTelemetrySent) {
     
     AttitudeManager am(&mockSystemUtils, &mockMathUtils, &mockGPS, &mockIMU, &mockFFT, &mockRangefinder, &mockBarometer, &mockAMQueue, &mockTMQueue, &mockLogQueue, &motorGroup);
     
-    for (int i = 0; i < AM_SCHEDULING_RATE_HZ; i++) {
+    for (int i = 0; i < AM_DEFAULT_SCHEDULING_RATE_HZ; i++) {
         am.amUpdate();
     }
     
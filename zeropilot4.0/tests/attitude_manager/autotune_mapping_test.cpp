@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "autotune_mapping.hpp"
+#include "unit_conversions.hpp"
+
+// Rigid body rate axis: effort -> dead time -> first order motor lag -> angular acceleration
+struct AxisPlant {
+    float gain;         // rad/s^2 per unit effort
+    float motorTauS;
+    uint16_t delaySteps;
+
+    float effortHistory[64] = {};
+    uint16_t head = 0;
+    float motorEffort = 0.0f;
+    float rate = 0.0f;
+    float angle = 0.0f;
+
+    void step(float effort, float dt) {
+        effortHistory[head] = effort;
+        float delayed = effortHistory[(head + 64 - delaySteps) % 64];
+        head = (head + 1) % 64;
+        motorEffort += (delayed - motorEffort) * dt / motorTauS;
+        rate += gain * motorEffort * dt;
+        angle += rate * dt;
+    }
+};
+
+class AutotuneMappingTest : public ::testing::Test {
+protected:
+    static constexpr float DT = 0.001f;
+    static constexpr float DEAD_TIME_S = 0.005f;
+    static constexpr float MOTOR_TAU_S = 0.02f;
+
+    AcroMapping acro{DT};
+    StabilizeMapping stabilize{DT, acro};
+    AutotuneMapping autotune{DT, stabilize};
+    AxisPlant plant[PID3_AXES] = {
+        {220.0f, MOTOR_TAU_S, 5},
+        {180.0f, MOTOR_TAU_S, 5},
+        {60.0f, MOTOR_TAU_S, 5},
+    };
+
+    void SetUp() override {
+        ZP_PARAM::init();
+
+        // Same wiring as AMParamSetup::loadAllParams
+        acro.setRollPIDConstants(ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_RLL_P), ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_RLL_I),
+            ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_RLL_D), ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_RLL_TAU), 50);
+        acro.setPitchPIDConstants(ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_PIT_P), ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_PIT_I),
+            ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_PIT_D), ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_PIT_TAU), 50);
+        acro.setYawPIDConstants(ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_YAW_P), ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_YAW_I),
+            ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_YAW_D), ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_YAW_TAU), 50);
+        acro.setRollLimitRate(ZP_UNITS::deg2rad(ZP_PARAM::get(ZP_PARAM_ID::ACRO_RP_RATE)));
+        acro.setPitchLimitRate(ZP_UNITS::deg2rad(ZP_PARAM::get(ZP_PARAM_ID::ACRO_RP_RATE)));
+        acro.setYawLimitRate(ZP_UNITS::deg2rad(ZP_PARAM::get(ZP_PARAM_ID::ACRO_Y_RATE)));
+        stabilize.setRollPIDConstants(ZP_PARAM::get(ZP_PARAM_ID::ATC_ANG_RLL_P), 0.0f, 0.0f, 0.02f, 50);
+        stabilize.setPitchPIDConstants(ZP_PARAM::get(ZP_PARAM_ID::ATC_ANG_PTCH_P), 0.0f, 0.0f, 0.02f, 50);
+        stabilize.setRollPitchLimitAngle(ZP_PARAM::get(ZP_PARAM_ID::ATC_ANGLE_MAX));
+    }
+
+    // Flies the plant in AUTOTUNE with the given sticks, returns the simulated seconds it took to finish
+    float fly(float maxSeconds, float rollStick = 50.0f) {
+        RCMotorControlMessage_t input = {rollStick, 50.0f, 50.0f, 50.0f, true, FlightMode_e::AUTOTUNE};
+        int steps = static_cast<int>(maxSeconds / DT);
+        for (int i = 0; i < steps; i++) {
+            DroneState_t state = DRONE_STATE_DEFAULT;
+            state.roll = plant[0].angle;
+            state.pitch = plant[1].angle;
+            state.yaw = plant[2].angle;
+            state.rollRate = plant[0].rate;
+            state.pitchRate = plant[1].rate;
+            state.yawRate = plant[2].rate;
+
+            RCMotorControlMessage_t out = autotune.runControl(input, state);
+            plant[0].step(out.roll, DT);
+            plant[1].step(out.pitch, DT);
+            plant[2].step(out.yaw, DT);
+
+            if (autotune.isComplete()) return (i + 1) * DT;
+        }
+        return maxSeconds;
+    }
+};
+
+TEST_F(AutotuneMappingTest, ConvergesOnSimulatedQuad) {
+    const ZP_PARAM_ID RATE_P[PID3_AXES] = {ZP_PARAM_ID::ATC_RAT_RLL_P, ZP_PARAM_ID::ATC_RAT_PIT_P, ZP_PARAM_ID::ATC_RAT_YAW_P};
+    const ZP_PARAM_ID RATE_I[PID3_AXES] = {ZP_PARAM_ID::ATC_RAT_RLL_I, ZP_PARAM_ID::ATC_RAT_PIT_I, ZP_PARAM_ID::ATC_RAT_YAW_I};
+    const ZP_PARAM_ID RATE_D[PID3_AXES] = {ZP_PARAM_ID::ATC_RAT_RLL_D, ZP_PARAM_ID::ATC_RAT_PIT_D, ZP_PARAM_ID::ATC_RAT_YAW_D};
+    float entryKp[PID3_AXES];
+    for (uint8_t axis = 0; axis < PID3_AXES; axis++) {
+        entryKp[axis] = ZP_PARAM::get(RATE_P[axis]);
+    }
+
+    autotune.activateFlightMode();
+    float seconds = fly(120.0f);
+    ASSERT_TRUE(autotune.isComplete());
+    EXPECT_LT(seconds, 60.0f);
+
+    PIDAxis_e finished;
+    int reported = 0;
+    while (autotune.takeFinishedAxis(finished)) reported++;
+    EXPECT_EQ(reported, PID3_AXES);
+
+    for (uint8_t axis = 0; axis < PID3_AXES; axis++) {
+        const AutotuneAxisResult_t &result = autotune.getAxisResult(static_cast<PIDAxis_e>(axis));
+        ASSERT_EQ(result.status, AutotuneAxisStatus_e::CONVERGED) << "axis " << int(axis);
+        EXPECT_GT(result.elapsedS, 0.0f);
+        EXPECT_LE(result.twitches, 20);
+
+        // The fit lumps the motor lag into the dead time
+        EXPECT_NEAR(result.plantGain, plant[axis].gain, 0.25f * plant[axis].gain) << "axis " << int(axis);
+        EXPECT_GT(result.delayS, 0.5f * (DEAD_TIME_S + MOTOR_TAU_S)) << "axis " << int(axis);
+        EXPECT_LT(result.delayS, 1.5f * (DEAD_TIME_S + MOTOR_TAU_S)) << "axis " << int(axis);
+
+        // Committed through the param registry and inside the safety bounds
+        EXPECT_EQ(ZP_PARAM::get(RATE_P[axis]), result.kp);
+        EXPECT_EQ(ZP_PARAM::get(RATE_I[axis]), result.ki);
+        EXPECT_EQ(ZP_PARAM::get(RATE_D[axis]), result.kd);
+        EXPECT_GE(result.kp, entryKp[axis] / 4.0f);
+        EXPECT_LE(result.kp, entryKp[axis] * 4.0f);
+
+        // Yaw D starts at 0 and still gets tuned
+        EXPECT_GT(result.kd, 0.0f) << "axis " << int(axis);
+    }
+
+    EXPECT_EQ(ZP_PARAM::get(ZP_PARAM_ID::ATC_ANG_RLL_P), autotune.getAxisResult(PIDAxis_e::ROLL).angleKp);
+    EXPECT_EQ(ZP_PARAM::get(ZP_PARAM_ID::ATC_ANG_PTCH_P), autotune.getAxisResult(PIDAxis_e::PITCH).angleKp);
+    EXPECT_GT(autotune.getAxisResult(PIDAxis_e::ROLL).angleKp, 0.0f);
+}
+
+TEST_F(AutotuneMappingTest, PilotInputHoldsOffTwitches) {
+    autotune.activateFlightMode();
+    fly(5.0f, 80.0f);
+    EXPECT_EQ(autotune.getAxisResult(PIDAxis_e::ROLL).status, AutotuneAxisStatus_e::TUNING);
+    EXPECT_EQ(autotune.getAxisResult(PIDAxis_e::ROLL).twitches, 0);
+
+    // Let go of the stick and twitching starts once the vehicle settles
+    fly(5.0f);
+    EXPECT_GT(autotune.getAxisResult(PIDAxis_e::ROLL).twitches, 0);
+}
+
+TEST_F(AutotuneMappingTest, GainsClampedToSafetyBounds) {
+    // Yaw only on a very weak airframe, the SIMC gain is far above the bound
+    ASSERT_TRUE(autotune.setAxesMask(0x04));
+    plant[2].gain = 8.0f;
+    float entryYawKp = ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_YAW_P);
+    float entryRollKp = ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_RLL_P);
+
+    autotune.activateFlightMode();
+    fly(60.0f);
+    ASSERT_TRUE(autotune.isComplete());
+
+    EXPECT_EQ(autotune.getAxisResult(PIDAxis_e::ROLL).status, AutotuneAxisStatus_e::SKIPPED);
+    EXPECT_EQ(autotune.getAxisResult(PIDAxis_e::PITCH).status, AutotuneAxisStatus_e::SKIPPED);
+    ASSERT_EQ(autotune.getAxisResult(PIDAxis_e::YAW).status, AutotuneAxisStatus_e::CONVERGED);
+    EXPECT_FLOAT_EQ(ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_YAW_P), 4.0f * entryYawKp);
+
+    // Yaw D has no entry gain to scale from, it stops at the top of the ATC_RAT_YAW_D range instead
+    EXPECT_FLOAT_EQ(ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_YAW_D), 0.02f);
+    EXPECT_EQ(ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_RLL_P), entryRollKp);
+
+    EXPECT_FALSE(autotune.setAxesMask(0));
+    EXPECT_FALSE(autotune.setAxesMask(0x08));
+    EXPECT_FALSE(autotune.setTimeConstantRatio(0.1f));
+}
+
+TEST_F(AutotuneMappingTest, NoResponseFailsWithoutTouchingGains) {
+    ASSERT_TRUE(autotune.setAxesMask(0x01));
+    plant[0].gain = 0.0f;
+    float entryKp = ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_RLL_P);
+
+    autotune.activateFlightMode();
+    fly(60.0f);
+    ASSERT_TRUE(autotune.isComplete());
+
+    const AutotuneAxisResult_t &result = autotune.getAxisResult(PIDAxis_e::ROLL);
+    EXPECT_EQ(result.status, AutotuneAxisStatus_e::FAILED);
+    EXPECT_EQ(result.twitches, 20);
+    EXPECT_EQ(ZP_PARAM::get(ZP_PARAM_ID::ATC_RAT_RLL_P), entryKp);
+}
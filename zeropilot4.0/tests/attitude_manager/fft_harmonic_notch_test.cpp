@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cmath>
+#include "fft_harmonic_notch.hpp"
+#include "mock_mathutils.hpp"
+#include "mock_fft.hpp"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+
+class FFTHarmonicNotchRpmTest : public ::testing::Test {
+protected:
+    static constexpr float SAMPLE_HZ = 1000.0f;
+
+    NiceMock<MockMathUtils> mockMathUtils;
+    NiceMock<MockFFT> mockFFT;
+    FFTHarmonicNotchConfig config;
+    uint32_t sampleIndex = 0;
+
+    void SetUp() override {
+        ON_CALL(mockMathUtils, dspSinf(_)).WillByDefault(Invoke([](float x) { return std::sin(x); }));
+        ON_CALL(mockMathUtils, dspCosf(_)).WillByDefault(Invoke([](float x) { return std::cos(x); }));
+
+        config.enabled = true;
+        config.mode = HarmonicNotchMode_e::ESC_RPM;
+        config.fftWindowSize = 256;
+        config.sampleFreqHz = SAMPLE_HZ;
+        config.minFreqHz = 50.0f;
+        config.bandwidthHz = 20.0f;
+        config.attenuationDB = 40.0f;
+        config.harmonicsMask = 0x03; // Fundamental and 2nd harmonic
+    }
+
+    // Peak gyro x after the notches have settled on a tone
+    float steadyStateAmplitude(FFTHarmonicNotch &notch, float toneHz) {
+        float peak = 0.0f;
+        for (int i = 0; i < 2000; i++, sampleIndex++) {
+            float gx = std::sin(2.0f * 3.14159265f * toneHz * sampleIndex / SAMPLE_HZ);
+            float gy = 0.0f;
+            float gz = 0.0f;
+            notch.apply(gx, gy, gz);
+            if (i > 1000) peak = std::fmax(peak, std::fabs(gx));
+        }
+        return peak;
+    }
+};
+
+TEST_F(FFTHarmonicNotchRpmTest, NotchesEachMotorAndHarmonic) {
+    FFTHarmonicNotch notch(&mockMathUtils, nullptr);
+    ASSERT_TRUE(notch.init(config)); // No FFT needed in ESC_RPM mode
+
+    const float motorHz[2] = {120.0f, 150.0f};
+    notch.updateFromMotorFreqs(motorHz, 2);
+
+    EXPECT_LT(steadyStateAmplitude(notch, 120.0f), 0.05f);
+    EXPECT_LT(steadyStateAmplitude(notch, 150.0f), 0.05f);
+    EXPECT_LT(steadyStateAmplitude(notch, 240.0f), 0.05f);
+    EXPECT_LT(steadyStateAmplitude(notch, 300.0f), 0.05f);
+
+    // Away from every notch the signal passes
+    EXPECT_GT(steadyStateAmplitude(notch, 20.0f), 0.9f);
+}
+
+TEST_F(FFTHarmonicNotchRpmTest, StoppedMotorHasNoNotch) {
+    FFTHarmonicNotch notch(&mockMathUtils, nullptr);
+    ASSERT_TRUE(notch.init(config));
+
+    const float motorHz[2] = {0.0f, 150.0f};
+    notch.updateFromMotorFreqs(motorHz, 2);
+
+    EXPECT_GT(steadyStateAmplitude(notch, 90.0f), 0.9f);
+    EXPECT_LT(steadyStateAmplitude(notch, 150.0f), 0.05f);
+}
+
+TEST_F(FFTHarmonicNotchRpmTest, TracksChangingRpm) {
+    FFTHarmonicNotch notch(&mockMathUtils, nullptr);
+    ASSERT_TRUE(notch.init(config));
+
+    float motorHz[1] = {100.0f};
+    notch.updateFromMotorFreqs(motorHz, 1);
+    EXPECT_LT(steadyStateAmplitude(notch, 100.0f), 0.05f);
+
+    motorHz[0] = 180.0f;
+    notch.updateFromMotorFreqs(motorHz, 1);
+    EXPECT_GT(steadyStateAmplitude(notch, 100.0f), 0.9f);
+    EXPECT_LT(steadyStateAmplitude(notch, 180.0f), 0.05f);
+}
+
+TEST_F(FFTHarmonicNotchRpmTest, FftUnusedInRpmMode) {
+    EXPECT_CALL(mockFFT, init(_)).Times(0);
+    EXPECT_CALL(mockFFT, runFFT(_, _, _)).Times(0);
+
+    FFTHarmonicNotch notch(&mockMathUtils, &mockFFT);
+    ASSERT_TRUE(notch.init(config));
+    for (int i = 0; i < 1024; i++) {
+        EXPECT_FALSE(notch.pushSample(1.0f, 0.0f, 0.0f));
+    }
+}
+
+TEST_F(FFTHarmonicNotchRpmTest, RpmUpdatesIgnoredInFftMode) {
+    ON_CALL(mockFFT, init(_)).WillByDefault(testing::Return(true));
+    config.mode = HarmonicNotchMode_e::FFT;
+
+    FFTHarmonicNotch notch(&mockMathUtils, &mockFFT);
+    ASSERT_TRUE(notch.init(config));
+
+    const float motorHz[1] = {120.0f};
+    notch.updateFromMotorFreqs(motorHz, 1);
+    EXPECT_GT(steadyStateAmplitude(notch, 120.0f), 0.9f);
+}
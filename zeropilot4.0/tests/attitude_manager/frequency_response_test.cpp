@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cmath>
+#include <complex>
+#include "frequency_response.hpp"
+#include "mock_fft.hpp"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+class FrequencyResponseTest : public ::testing::Test {
+protected:
+    static constexpr float SAMPLE_HZ = 200.0f;
+    static constexpr float PI_F = 3.14159265f;
+
+    NiceMock<MockFFT> mockFFT;
+    uint32_t noiseState = 12345;
+
+    void SetUp() override {
+        ON_CALL(mockFFT, init(_)).WillByDefault(Return(true));
+
+        // Naive DFT in the CMSIS packed real FFT layout: [DC, Nyquist, re1, im1, ...]
+        ON_CALL(mockFFT, runFFT(_, _, _)).WillByDefault(Invoke([](float *in, float *out, uint8_t) {
+            const int n = FrequencyResponse::WINDOW_LEN;
+            for (int k = 0; k <= n / 2; k++) {
+                double re = 0.0, im = 0.0;
+                for (int i = 0; i < n; i++) {
+                    double angle = -2.0 * M_PI * k * i / n;
+                    re += in[i] * std::cos(angle);
+                    im += in[i] * std::sin(angle);
+                }
+                if (k == 0) {
+                    out[0] = static_cast<float>(re);
+                } else if (k == n / 2) {
+                    out[1] = static_cast<float>(re);
+                } else {
+                    out[2 * k] = static_cast<float>(re);
+                    out[2 * k + 1] = static_cast<float>(im);
+                }
+            }
+        }));
+    }
+
+    // Uniform in [-1, 1], deterministic so the test is repeatable
+    float noise() {
+        noiseState = noiseState * 1664525u + 1013904223u;
+        return static_cast<float>(noiseState >> 8) / static_cast<float>(1u << 23) - 1.0f;
+    }
+};
+
+TEST_F(FrequencyResponseTest, NotInitializedIgnoresSamples) {
+    FrequencyResponse response(&mockFFT);
+    EXPECT_FALSE(response.pushSample(1.0f, 1.0f));
+
+    FrequencyResponsePoint_t point;
+    EXPECT_FALSE(response.getPoint(10, point));
+}
+
+TEST_F(FrequencyResponseTest, InitFailsWithoutFft) {
+    FrequencyResponse noDriver(nullptr);
+    EXPECT_FALSE(noDriver.init(SAMPLE_HZ));
+
+    ON_CALL(mockFFT, init(_)).WillByDefault(Return(false));
+    FrequencyResponse response(&mockFFT);
+    EXPECT_FALSE(response.init(SAMPLE_HZ));
+}
+
+TEST_F(FrequencyResponseTest, WindowsOverlapByHalf) {
+    FrequencyResponse response(&mockFFT);
+    ASSERT_TRUE(response.init(SAMPLE_HZ));
+
+    int completed = 0;
+    for (int i = 0; i < FrequencyResponse::WINDOW_LEN * 2; i++) {
+        if (response.pushSample(noise(), noise())) completed++;
+    }
+
+    // First window after WINDOW_LEN samples, then one every WINDOW_LEN / 2
+    EXPECT_EQ(completed, 3);
+    EXPECT_EQ(response.getWindowCount(), 3);
+    EXPECT_FLOAT_EQ(response.getBinFreqHz(64), 64 * SAMPLE_HZ / FrequencyResponse::WINDOW_LEN);
+}
+
+TEST_F(FrequencyResponseTest, DcAndOutOfRangeBinsNotReported) {
+    FrequencyResponse response(&mockFFT);
+    ASSERT_TRUE(response.init(SAMPLE_HZ));
+    for (int i = 0; i < FrequencyResponse::WINDOW_LEN; i++) {
+        response.pushSample(noise(), noise());
+    }
+
+    FrequencyResponsePoint_t point;
+    EXPECT_FALSE(response.getPoint(0, point));
+    EXPECT_FALSE(response.getPoint(FrequencyResponse::BIN_COUNT, point));
+    EXPECT_TRUE(response.getPoint(1, point));
+}
+
+TEST_F(FrequencyResponseTest, MatchesFirstOrderLag) {
+    FrequencyResponse response(&mockFFT);
+    ASSERT_TRUE(response.init(SAMPLE_HZ));
+
+    // y[k] = a y[k-1] + (1 - a) u[k], H(z) = (1 - a) / (1 - a z^-1)
+    const double a = 0.9;
+    float y = 0.0f;
+    for (int i = 0; i < FrequencyResponse::WINDOW_LEN * 40; i++) {
+        float u = noise();
+        y = static_cast<float>(a * y + (1.0 - a) * u);
+        response.pushSample(u, y);
+    }
+
+    for (uint16_t bin : {4, 16, 40, 100}) {
+        FrequencyResponsePoint_t point;
+        ASSERT_TRUE(response.getPoint(bin, point));
+
+        const std::complex<double> z = std::polar(1.0, 2.0 * M_PI * point.freqHz / SAMPLE_HZ);
+        const std::complex<double> h = (1.0 - a) / (1.0 - a / z);
+
+        EXPECT_NEAR(point.gain, std::abs(h), 0.05 * std::abs(h)) << "bin " << bin;
+        EXPECT_NEAR(point.phaseDeg, std::arg(h) * 180.0 / M_PI, 3.0) << "bin " << bin;
+        EXPECT_GT(point.coherence, 0.95f) << "bin " << bin;
+    }
+}
+
+TEST_F(FrequencyResponseTest, UncorrelatedOutputHasLowCoherence) {
+    FrequencyResponse response(&mockFFT);
+    ASSERT_TRUE(response.init(SAMPLE_HZ));
+
+    for (int i = 0; i < FrequencyResponse::WINDOW_LEN * 40; i++) {
+        float u = noise();
+        response.pushSample(u, noise());
+    }
+
+    FrequencyResponsePoint_t point;
+    ASSERT_TRUE(response.getPoint(30, point));
+    EXPECT_LT(point.coherence, 0.3f);
+}
+
+TEST_F(FrequencyResponseTest, InitClearsEstimate) {
+    FrequencyResponse response(&mockFFT);
+    ASSERT_TRUE(response.init(SAMPLE_HZ));
+    for (int i = 0; i < FrequencyResponse::WINDOW_LEN; i++) {
+        response.pushSample(noise(), noise());
+    }
+    ASSERT_EQ(response.getWindowCount(), 1);
+
+    ASSERT_TRUE(response.init(SAMPLE_HZ));
+    EXPECT_EQ(response.getWindowCount(), 0);
+
+    FrequencyResponsePoint_t point;
+    EXPECT_FALSE(response.getPoint(10, point));
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "imu_decimator.hpp"
+
+class ImuDecimatorTest : public ::testing::Test {
+protected:
+    static constexpr float ODR_HZ = 8000.0f;
+    static constexpr float CONTROL_HZ = 1000.0f;
+    static constexpr uint16_t BATCH = 8;
+    static constexpr uint64_t SAMPLE_PERIOD_US = 125;
+
+    ScaledImu_t input[BATCH];
+    uint64_t sampleIndex = 0;
+
+    // One control loop worth of samples of a gyro x sine (or DC when freqHz is 0)
+    ScaledImuBatch_t nextBatch(float freqHz, float amplitude, float dc = 0.0f) {
+        for (int i = 0; i < BATCH; i++) {
+            float t = sampleIndex / ODR_HZ;
+            float v = dc + amplitude * std::sin(2.0f * 3.14159265f * freqHz * t);
+            input[i] = {};
+            input[i].xgyro = v;
+            input[i].zacc = -9.81f;
+            input[i].timestampUs = (sampleIndex + 1) * SAMPLE_PERIOD_US;
+            sampleIndex++;
+        }
+        return {input, BATCH, 0};
+    }
+
+    // Peak gyro x amplitude after the filter has settled
+    float steadyStateAmplitude(ImuDecimator &decimator, float freqHz) {
+        float peak = 0.0f;
+        for (int b = 0; b < 400; b++) {
+            ScaledImuBatch_t out = decimator.process(nextBatch(freqHz, 1.0f));
+            for (int i = 0; b > 100 && i < out.count; i++) {
+                peak = std::fmax(peak, std::fabs(out.data[i].xgyro));
+            }
+        }
+        return peak;
+    }
+};
+
+TEST_F(ImuDecimatorTest, FactorOnePassesBatchThrough) {
+    ImuDecimator decimator;
+    ASSERT_TRUE(decimator.init({DecimationFilter_e::FIR, 1000.0f, 1000.0f}));
+    EXPECT_EQ(decimator.getFactor(), 1);
+    EXPECT_FLOAT_EQ(decimator.getGroupDelayS(), 0.0f);
+
+    ScaledImuBatch_t in = nextBatch(0.0f, 0.0f, 1.0f);
+    ScaledImuBatch_t out = decimator.process(in);
+    EXPECT_EQ(out.data, in.data);
+    EXPECT_EQ(out.count, in.count);
+}
+
+TEST_F(ImuDecimatorTest, RejectsInvalidRates) {
+    ImuDecimator decimator;
+    EXPECT_FALSE(decimator.init({DecimationFilter_e::FIR, 1000.0f, 2000.0f}));
+    EXPECT_FALSE(decimator.init({DecimationFilter_e::FIR, 0.0f, 1000.0f}));
+    EXPECT_FALSE(decimator.init({DecimationFilter_e::FIR, 32000.0f, 500.0f}));
+    EXPECT_EQ(decimator.getFactor(), 1);
+}
+
+TEST_F(ImuDecimatorTest, OutputCountAndTimestamps) {
+    for (DecimationFilter_e filter : {DecimationFilter_e::NONE, DecimationFilter_e::FIR, DecimationFilter_e::CIC}) {
+        ImuDecimator decimator;
+        ASSERT_TRUE(decimator.init({filter, ODR_HZ, CONTROL_HZ}));
+        EXPECT_EQ(decimator.getFactor(), 8);
+        EXPECT_FLOAT_EQ(decimator.getOutputRateHz(), CONTROL_HZ);
+
+        uint64_t last = 0;
+        for (int b = 0; b < 10; b++) {
+            ScaledImuBatch_t out = decimator.process(nextBatch(0.0f, 0.0f));
+            ASSERT_EQ(out.count, 1);
+            EXPECT_EQ(out.data[0].timestampUs, input[BATCH - 1].timestampUs); // Stamped at the decimation instant
+            if (b > 0) {
+                EXPECT_EQ(out.data[0].timestampUs - last, 1000u);
+            }
+            last = out.data[0].timestampUs;
+        }
+    }
+}
+
+TEST_F(ImuDecimatorTest, UnityDCGain) {
+    for (DecimationFilter_e filter : {DecimationFilter_e::FIR, DecimationFilter_e::CIC}) {
+        ImuDecimator decimator;
+        ASSERT_TRUE(decimator.init({filter, ODR_HZ, CONTROL_HZ}));
+
+        ScaledImuBatch_t out = {};
+        for (int b = 0; b < 20; b++) {
+            out = decimator.process(nextBatch(0.0f, 0.0f, 0.5f));
+        }
+        ASSERT_EQ(out.count, 1);
+        EXPECT_NEAR(out.data[0].xgyro, 0.5f, 1e-4f);
+        EXPECT_NEAR(out.data[0].zacc, -9.81f, 1e-3f);
+        EXPECT_NEAR(out.data[0].ygyro, 0.0f, 1e-6f);
+    }
+}
+
+TEST_F(ImuDecimatorTest, ReportsGroupDelay) {
+    ImuDecimator fir;
+    ASSERT_TRUE(fir.init({DecimationFilter_e::FIR, ODR_HZ, CONTROL_HZ}));
+    EXPECT_NEAR(fir.getGroupDelayS(), (ImuDecimator::FIR_MAX_TAPS - 1) * 0.5f / ODR_HZ, 1e-7f);
+
+    ImuDecimator cic;
+    ASSERT_TRUE(cic.init({DecimationFilter_e::CIC, ODR_HZ, CONTROL_HZ}));
+    EXPECT_NEAR(cic.getGroupDelayS(), ImuDecimator::CIC_ORDER * 7 * 0.5f / ODR_HZ, 1e-7f);
+
+    ImuDecimator none;
+    ASSERT_TRUE(none.init({DecimationFilter_e::NONE, ODR_HZ, CONTROL_HZ}));
+    EXPECT_FLOAT_EQ(none.getGroupDelayS(), 0.0f);
+}
+
+TEST_F(ImuDecimatorTest, PassesLowFrequencyMotion) {
+    ImuDecimator decimator;
+    ASSERT_TRUE(decimator.init({DecimationFilter_e::FIR, ODR_HZ, CONTROL_HZ}));
+    EXPECT_NEAR(steadyStateAmplitude(decimator, 20.0f), 1.0f, 0.02f);
+}
+
+TEST_F(ImuDecimatorTest, RejectsAliasingVibration) {
+    // 1.9 kHz motor noise would alias down to 100 Hz at the control rate without filtering
+    ImuDecimator none;
+    ASSERT_TRUE(none.init({DecimationFilter_e::NONE, ODR_HZ, CONTROL_HZ}));
+    EXPECT_GT(steadyStateAmplitude(none, 1900.0f), 0.5f);
+
+    ImuDecimator fir;
+    ASSERT_TRUE(fir.init({DecimationFilter_e::FIR, ODR_HZ, CONTROL_HZ}));
+    EXPECT_LT(steadyStateAmplitude(fir, 1900.0f), 0.01f);
+
+    ImuDecimator cic;
+    ASSERT_TRUE(cic.init({DecimationFilter_e::CIC, ODR_HZ, CONTROL_HZ}));
+    EXPECT_LT(steadyStateAmplitude(cic, 1900.0f), 0.05f);
+}
+
+TEST_F(ImuDecimatorTest, KeepsIMUsSeparate) {
+    ImuDecimator decimator;
+    ASSERT_TRUE(decimator.init({DecimationFilter_e::FIR, 2000.0f, 1000.0f}));
+
+    // Interleaved IMUs reading opposite constant rates
+    ScaledImu_t data[4];
+    ScaledImuBatch_t out = {};
+    for (int b = 0; b < 40; b++) {
+        for (int i = 0; i < 4; i++) {
+            data[i] = {};
+            data[i].imuId = i % 2;
+            data[i].xgyro = (i % 2 == 0) ? 1.0f : -1.0f;
+            data[i].timestampUs = (b * 2 + i / 2 + 1) * 500;
+        }
+        out = decimator.process({data, 4, 0});
+    }
+    ASSERT_EQ(out.count, 2);
+    for (int i = 0; i < out.count; i++) {
+        EXPECT_NEAR(out.data[i].xgyro, out.data[i].imuId == 0 ? 1.0f : -1.0f, 1e-4f);
+    }
+}
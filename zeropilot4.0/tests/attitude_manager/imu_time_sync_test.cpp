@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include "imu_time_sync.hpp"
+
+// Generates FIFO batches from an IMU whose oscillator drifts against the MCU clock
+class SyntheticImu {
+public:
+    SyntheticImu(double odrHz, double driftPpm, uint32_t mcuStartUs, uint16_t hwStartTicks) :
+        mcuPeriodUs(1000000.0 / odrHz / (1.0 + driftPpm * 1e-6)), // Fast IMU oscillator -> shorter sample period in MCU time
+        ticksPerMcuUs(1.0 + driftPpm * 1e-6),
+        mcuStartUs(mcuStartUs),
+        hwStartTicks(hwStartTicks) {}
+
+    // Fill count samples, returns the DWT read time (newest sample time plus read latency)
+    uint32_t nextBatch(RawImu_t *data, uint16_t count, double latencyUs = 0.0) {
+        for (int i = 0; i < count; i++) {
+            double mcuUs = sampleIndex * mcuPeriodUs;
+            data[i] = {};
+            data[i].timestamp = (uint16_t)(hwStartTicks + (uint64_t)std::llround(mcuUs * ticksPerMcuUs));
+            sampleIndex++;
+        }
+        lastSampleMcuUs = (sampleIndex - 1) * mcuPeriodUs;
+        return (uint32_t)(mcuStartUs + (uint64_t)std::llround(lastSampleMcuUs + latencyUs));
+    }
+
+    // Samples produced but never read, e.g. during a bus stall
+    void skip(uint32_t samples) { sampleIndex += samples; }
+
+    double mcuPeriodUs;
+    double lastSampleMcuUs = 0.0;
+
+private:
+    double ticksPerMcuUs;
+    uint32_t mcuStartUs;
+    uint16_t hwStartTicks;
+    uint64_t sampleIndex = 0;
+};
+
+class ImuTimeSyncTest : public ::testing::Test {
+protected:
+    static constexpr float ODR_HZ = 1000.0f;
+    static constexpr uint16_t BATCH = 8;
+
+    RawImu_t batch[BATCH];
+};
+
+TEST_F(ImuTimeSyncTest, NominalClockGivesNominalSpacing) {
+    ImuTimeSync sync(1.0f, ODR_HZ);
+    SyntheticImu imu(ODR_HZ, 0.0, 1000, 0);
+
+    uint64_t last = 0;
+    for (int b = 0; b < 200; b++) {
+        uint32_t readTime = imu.nextBatch(batch, BATCH);
+        sync.stampBatch(batch, BATCH, readTime);
+        for (int i = 0; i < BATCH; i++) {
+            if (b > 0 || i > 0) {
+                EXPECT_EQ(batch[i].timestampUs - last, 1000u);
+            }
+            last = batch[i].timestampUs;
+        }
+    }
+    EXPECT_NEAR(sync.getMeasuredODRHz(), ODR_HZ, 0.01f);
+    EXPECT_TRUE(sync.isLocked());
+}
+
+TEST_F(ImuTimeSyncTest, ReportsNominalODRBeforeData) {
+    ImuTimeSync sync(1.0f, ODR_HZ);
+    EXPECT_FLOAT_EQ(sync.getMeasuredODRHz(), ODR_HZ);
+    EXPECT_FALSE(sync.isLocked());
+}
+
+TEST_F(ImuTimeSyncTest, ConvergesToOscillatorDrift) {
+    const double driftPpm = 20000.0; // IMU runs 2% fast
+    ImuTimeSync sync(1.0f, ODR_HZ);
+    SyntheticImu imu(ODR_HZ, driftPpm, 5000, 1234);
+
+    for (int b = 0; b < 2000; b++) {
+        uint32_t readTime = imu.nextBatch(batch, BATCH);
+        sync.stampBatch(batch, BATCH, readTime);
+    }
+
+    EXPECT_NEAR(sync.getTickRatio(), 1.0 / (1.0 + driftPpm * 1e-6), 1e-4);
+    EXPECT_NEAR(sync.getMeasuredODRHz(), 1000000.0 / imu.mcuPeriodUs, 0.5);
+
+    // Sample spacing in MCU time follows the real period, not the nominal 1000 us
+    for (int i = 1; i < BATCH; i++) {
+        double dt = (double)(batch[i].timestampUs - batch[i - 1].timestampUs);
+        EXPECT_NEAR(dt, imu.mcuPeriodUs, 1.5);
+    }
+}
+
+TEST_F(ImuTimeSyncTest, HardwareTimestampWraparound) {
+    ImuTimeSync sync(1.0f, ODR_HZ);
+    SyntheticImu imu(ODR_HZ, -500.0, 0, 65000); // Wraps the 16-bit counter within the first batch
+
+    uint64_t last = 0;
+    bool first = true;
+    for (int b = 0; b < 5000; b++) { // 40 s, ~600 wraps
+        uint32_t readTime = imu.nextBatch(batch, BATCH);
+        sync.stampBatch(batch, BATCH, readTime);
+        for (int i = 0; i < BATCH; i++) {
+            if (!first) {
+                EXPECT_GT(batch[i].timestampUs, last);
+                EXPECT_LT(batch[i].timestampUs - last, 1100u);
+            }
+            first = false;
+            last = batch[i].timestampUs;
+        }
+    }
+    EXPECT_NEAR((double)last, imu.lastSampleMcuUs, 50.0);
+}
+
+TEST_F(ImuTimeSyncTest, GapLongerThanHardwareCounterRange) {
+    ImuTimeSync sync(1.0f, ODR_HZ);
+    SyntheticImu imu(ODR_HZ, 100.0, 0, 0);
+
+    for (int b = 0; b < 100; b++) {
+        uint32_t readTime = imu.nextBatch(batch, BATCH);
+        sync.stampBatch(batch, BATCH, readTime);
+    }
+    uint64_t beforeGap = batch[BATCH - 1].timestampUs;
+
+    imu.skip(250); // 250 ms stall, more than three 16-bit wraps
+    uint32_t readTime = imu.nextBatch(batch, BATCH);
+    sync.stampBatch(batch, BATCH, readTime);
+
+    double gapUs = (double)(batch[0].timestampUs - beforeGap);
+    EXPECT_NEAR(gapUs, 251.0 * imu.mcuPeriodUs, 20.0);
+}
+
+TEST_F(ImuTimeSyncTest, DwtWraparoundStaysMonotonic) {
+    ImuTimeSync sync(1.0f, ODR_HZ);
+    SyntheticImu imu(ODR_HZ, 0.0, UINT32_MAX - 50000, 0); // DWT wraps after ~50 ms
+
+    uint64_t last = 0;
+    for (int b = 0; b < 100; b++) {
+        uint32_t readTime = imu.nextBatch(batch, BATCH);
+        sync.stampBatch(batch, BATCH, readTime);
+        for (int i = 0; i < BATCH; i++) {
+            EXPECT_GT(batch[i].timestampUs, last);
+            last = batch[i].timestampUs;
+        }
+    }
+    EXPECT_GT(last, (uint64_t)UINT32_MAX);
+}
+
+TEST_F(ImuTimeSyncTest, ReadLatencyJitterIsFiltered) {
+    ImuTimeSync sync(1.0f, ODR_HZ);
+    SyntheticImu imu(ODR_HZ, 3000.0, 0, 0);
+    srand(42);
+
+    double maxErrUs = 0.0;
+    for (int b = 0; b < 3000; b++) {
+        double latencyUs = rand() % 200; // Read happens up to 200 us after the newest sample
+        uint32_t readTime = imu.nextBatch(batch, BATCH, latencyUs);
+        sync.stampBatch(batch, BATCH, readTime);
+        if (b > 1000) {
+            for (int i = 1; i < BATCH; i++) {
+                double dt = (double)(batch[i].timestampUs - batch[i - 1].timestampUs);
+                maxErrUs = std::fmax(maxErrUs, std::fabs(dt - imu.mcuPeriodUs));
+            }
+        }
+    }
+    EXPECT_LT(maxErrUs, 3.0);
+}
+
+TEST_F(ImuTimeSyncTest, MonotonicAcrossReset) {
+    ImuTimeSync sync(1.0f, ODR_HZ);
+    SyntheticImu imu(ODR_HZ, 0.0, 100000, 0);
+
+    uint32_t readTime = imu.nextBatch(batch, BATCH, 100.0);
+    sync.stampBatch(batch, BATCH, readTime);
+    uint64_t last = batch[BATCH - 1].timestampUs;
+
+    sync.reset();
+    readTime = imu.nextBatch(batch, BATCH, 0.0); // Hard sync after a reset must not step time backwards
+    sync.stampBatch(batch, BATCH, readTime);
+    for (int i = 0; i < BATCH; i++) {
+        EXPECT_GT(batch[i].timestampUs, last);
+        last = batch[i].timestampUs;
+    }
+}
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "motor_mixing.hpp"
+
+static constexpr float DEG_TO_RAD = 3.14159265358979f / 180.0f;
+static constexpr float CW = -1.0f;
+static constexpr float CCW = 1.0f;
+
+typedef struct {
+    FrameClass_e frameClass;
+    FrameType_e frameType;
+    uint8_t motorCount;
+    float angleDeg[MIXER_MAX_MOTORS]; // Clockwise from the nose
+    float yaw[MIXER_MAX_MOTORS];
+} FrameGeometry_t;
+
+// Motor layouts from the ArduPilot frame definitions
+static const FrameGeometry_t GEOMETRIES[] = {
+    {FrameClass_e::QUAD, FrameType_e::X, 4, {45, -135, -45, 135}, {CCW, CCW, CW, CW}},
+    {FrameClass_e::QUAD, FrameType_e::PLUS, 4, {90, -90, 0, 180}, {CCW, CCW, CW, CW}},
+    {FrameClass_e::HEXA, FrameType_e::X, 6, {90, -90, -30, 150, 30, -150}, {CW, CCW, CW, CCW, CCW, CW}},
+    {FrameClass_e::HEXA, FrameType_e::PLUS, 6, {0, 180, -120, 60, -60, 120}, {CW, CCW, CW, CCW, CCW, CW}},
+    {FrameClass_e::OCTA, FrameType_e::X, 8, {22.5f, -157.5f, 67.5f, 157.5f, -22.5f, -112.5f, -67.5f, 112.5f}, {CW, CW, CCW, CCW, CCW, CCW, CW, CW}},
+    {FrameClass_e::OCTA, FrameType_e::PLUS, 8, {0, 180, 45, 135, -45, -135, -90, 90}, {CW, CW, CCW, CCW, CCW, CCW, CW, CW}},
+    {FrameClass_e::Y6, FrameType_e::X, 6, {60, -60, -60, 180, 60, 180}, {CW, CW, CCW, CW, CCW, CCW}},
+};
+
+// Straight per motor transcription of the desaturation the mixer has always used
+static void referenceMix(const FrameGeometry_t &g, float roll, float pitch, float yaw, float throttle, float *out) {
+    float rp[MIXER_MAX_MOTORS];
+    float ideal = fminf(0.5f, throttle);
+    float yawAllowed = 1.0f;
+    for (int i = 0; i < g.motorCount; i++) {
+        float a = g.angleDeg[i] * DEG_TO_RAD;
+        rp[i] = roll * -sinf(a) + pitch * cosf(a);
+        float room = (yaw * g.yaw[i] >= 0) ? 1.0f - (ideal + rp[i]) : ideal + rp[i];
+        yawAllowed = fminf(yawAllowed, fmaxf(room, 0.0f));
+    }
+    yawAllowed = fmaxf(0.2f, yawAllowed);
+    yaw = fmaxf(-yawAllowed, fminf(yaw, yawAllowed));
+
+    float hi = 0.0f;
+    float lo = 1.0f;
+    for (int i = 0; i < g.motorCount; i++) {
+        rp[i] += yaw * g.yaw[i];
+        hi = fmaxf(hi, rp[i]);
+        lo = fminf(lo, rp[i]);
+    }
+
+    float scale = (hi - lo >= 1.0f) ? 1.0f / (hi - lo) : 1.0f;
+    if (throttle + lo < 0.0f) scale = fminf(scale, fabsf(throttle / lo));
+    hi *= scale;
+    lo *= scale;
+
+    float base = fabsf(lo);
+    float adj = throttle - base;
+    if (scale < 1.0f || adj < 0.0f) adj = 0.0f;
+    else if (adj > 1.0f - base - hi) adj = 1.0f - base - hi;
+
+    for (int i = 0; i < g.motorCount; i++) {
+        out[i] = base + adj + scale * rp[i];
+    }
+}
+
+static void expectMatchesReference(const FrameGeometry_t &g) {
+    const MixerFrame_t *frame = MotorMixing::frameFor(g.frameClass, g.frameType);
+    ASSERT_NE(frame, nullptr);
+    ASSERT_EQ(frame->motorCount, g.motorCount);
+
+    const float sticks[] = {-1.0f, -0.6f, -0.15f, 0.0f, 0.3f, 0.8f, 1.0f};
+    const float throttles[] = {0.0f, 0.1f, 0.45f, 0.7f, 1.0f};
+    for (float r : sticks) for (float p : sticks) for (float y : sticks) for (float t : throttles) {
+        float expected[MIXER_MAX_MOTORS];
+        float actual[MIXER_MAX_MOTORS];
+        referenceMix(g, r, p, y, t, expected);
+        MotorMixing::mixFrame(*frame, r, p, y, t, actual);
+        for (int i = 0; i < g.motorCount; i++) {
+            ASSERT_NEAR(actual[i], expected[i], 1e-5f) << "motor " << i + 1 << " r " << r << " p " << p << " y " << y << " t " << t;
+            ASSERT_GE(actual[i], -1e-5f);
+            ASSERT_LE(actual[i], 1.0f + 1e-5f);
+        }
+    }
+}
+
+TEST(MotorMixingTest, FrameTablesMatchGeometry) {
+    for (const FrameGeometry_t &g : GEOMETRIES) {
+        const MixerFrame_t *frame = MotorMixing::frameFor(g.frameClass, g.frameType);
+        ASSERT_NE(frame, nullptr);
+        ASSERT_EQ(frame->motorCount, g.motorCount);
+        for (int i = 0; i < MIXER_MAX_MOTORS; i++) {
+            float a = g.angleDeg[i] * DEG_TO_RAD;
+            bool active = i < g.motorCount;
+            EXPECT_NEAR(frame->roll[i], active ? -sinf(a) : 0.0f, 1e-6f) << "class " << int(g.frameClass) << " motor " << i + 1;
+            EXPECT_NEAR(frame->pitch[i], active ? cosf(a) : 0.0f, 1e-6f) << "class " << int(g.frameClass) << " motor " << i + 1;
+            EXPECT_EQ(frame->yaw[i], active ? g.yaw[i] : 0.0f) << "class " << int(g.frameClass) << " motor " << i + 1;
+        }
+    }
+
+    EXPECT_EQ(MotorMixing::frameFor(FrameClass_e::Y6, FrameType_e::PLUS), MotorMixing::frameFor(FrameClass_e::Y6, FrameType_e::X));
+    EXPECT_EQ(MotorMixing::frameFor(static_cast<FrameClass_e>(7), FrameType_e::X), nullptr);
+    EXPECT_EQ(MotorMixing::frameFor(FrameClass_e::HEXA, static_cast<FrameType_e>(3)), nullptr);
+}
+
+TEST(MotorMixingTest, FrameAxesAreDecoupled) {
+    // A pure roll, pitch or yaw command must not leak into the other two axes
+    for (const FrameGeometry_t &g : GEOMETRIES) {
+        const MixerFrame_t *frame = MotorMixing::frameFor(g.frameClass, g.frameType);
+        ASSERT_NE(frame, nullptr);
+        float yawRoll = 0.0f;
+        float yawPitch = 0.0f;
+        float rollPitch = 0.0f;
+        for (int i = 0; i < frame->motorCount; i++) {
+            yawRoll += frame->yaw[i] * frame->roll[i];
+            yawPitch += frame->yaw[i] * frame->pitch[i];
+            rollPitch += frame->roll[i] * frame->pitch[i];
+        }
+        EXPECT_NEAR(yawRoll, 0.0f, 1e-6f) << "class " << int(g.frameClass) << " type " << int(g.frameType);
+        EXPECT_NEAR(yawPitch, 0.0f, 1e-6f) << "class " << int(g.frameClass) << " type " << int(g.frameType);
+        EXPECT_NEAR(rollPitch, 0.0f, 1e-6f) << "class " << int(g.frameClass) << " type " << int(g.frameType);
+    }
+}
+
+TEST(MotorMixingTest, QuadXMatchesReference) {
+    expectMatchesReference(GEOMETRIES[0]);
+}
+
+TEST(MotorMixingTest, HexaXDesaturation) {
+    expectMatchesReference(GEOMETRIES[2]);
+
+    // Full right roll at mid throttle spans 2, scaled to half with no room left for throttle
+    float mixed[MIXER_MAX_MOTORS];
+    MotorMixing::mixFrame(*MotorMixing::frameFor(FrameClass_e::HEXA, FrameType_e::X), 1.0f, 0.0f, 0.0f, 0.5f, mixed);
+    const float expected[6] = {0.0f, 1.0f, 0.75f, 0.25f, 0.25f, 0.75f};
+    for (int i = 0; i < 6; i++) {
+        EXPECT_NEAR(mixed[i], expected[i], 1e-6f) << "motor " << i + 1;
+    }
+}
+
+TEST(MotorMixingTest, OctaXDesaturation) {
+    expectMatchesReference(GEOMETRIES[4]);
+
+    // Full yaw at hover is clipped to the room left around 0.5
+    float mixed[MIXER_MAX_MOTORS];
+    MotorMixing::mixFrame(*MotorMixing::frameFor(FrameClass_e::OCTA, FrameType_e::X), 0.0f, 0.0f, 1.0f, 0.5f, mixed);
+    const float expected[8] = {0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f};
+    for (int i = 0; i < 8; i++) {
+        EXPECT_NEAR(mixed[i], expected[i], 1e-6f) << "motor " << i + 1;
+    }
+}
+
+TEST(MotorMixingTest, Y6Desaturation) {
+    expectMatchesReference(GEOMETRIES[6]);
+
+    // Full pitch at low throttle is scaled so the rear pair stops at zero instead of going negative
+    float mixed[MIXER_MAX_MOTORS];
+    MotorMixing::mixFrame(*MotorMixing::frameFor(FrameClass_e::Y6, FrameType_e::X), 0.0f, 1.0f, 0.0f, 0.2f, mixed);
+    const float expected[6] = {0.3f, 0.3f, 0.3f, 0.0f, 0.3f, 0.0f};
+    for (int i = 0; i < 6; i++) {
+        EXPECT_NEAR(mixed[i], expected[i], 1e-6f) << "motor " << i + 1;
+    }
+
+    // Coaxial pairs only differ by yaw, positive yaw speeds up the counter-clockwise prop of each pair
+    MotorMixing::mixFrame(*MotorMixing::frameFor(FrameClass_e::Y6, FrameType_e::X), 0.4f, -0.3f, 0.5f, 0.6f, mixed);
+    EXPECT_GT(mixed[4], mixed[0]);
+    EXPECT_GT(mixed[2], mixed[1]);
+    EXPECT_GT(mixed[5], mixed[3]);
+}
+
+TEST(MotorMixingTest, PlusFramesMatchReference) {
+    expectMatchesReference(GEOMETRIES[1]);
+    expectMatchesReference(GEOMETRIES[3]);
+    expectMatchesReference(GEOMETRIES[5]);
+}
+
+TEST(MotorMixingTest, PlacesMotorsByFunction) {
+    MotorInstance_t motors[8] = {};
+    motors[0].function = MotorFunction_e::MOTOR_6;
+    motors[1].function = MotorFunction_e::MOTOR_1;
+    motors[2].function = MotorFunction_e::DISABLED;
+    motors[3].function = MotorFunction_e::MOTOR_7; // Past the end of a hexa
+    motors[4].function = MotorFunction_e::MOTOR_2;
+    motors[5].function = MotorFunction_e::MOTOR_3;
+    motors[6].function = MotorFunction_e::MOTOR_4;
+    motors[7].function = MotorFunction_e::MOTOR_5;
+    MotorGroupInstance_t group{motors, 8};
+
+    const MixerFrame_t *frame = MotorMixing::frameFor(FrameClass_e::HEXA, FrameType_e::X);
+    RCMotorControlMessage_t msg = {};
+    msg.roll = 1.0f;
+    msg.throttle = 0.5f;
+
+    float percent[8];
+    MotorMixing::multirotorMixer(*frame, msg, &group, percent);
+    EXPECT_NEAR(percent[0], 0.75f, 1e-6f);
+    EXPECT_NEAR(percent[1], 0.0f, 1e-6f);
+    EXPECT_EQ(percent[2], 0.0f);
+    EXPECT_EQ(percent[3], 0.0f);
+    EXPECT_NEAR(percent[4], 1.0f, 1e-6f);
+    EXPECT_NEAR(percent[7], 0.25f, 1e-6f);
+
+    MotorMixing::multirotorGroundIdle(*frame, &group, percent, 0.05f);
+    const float idle[8] = {0.05f, 0.05f, 0.0f, 0.0f, 0.05f, 0.05f, 0.05f, 0.05f};
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(percent[i], idle[i]) << "channel " << i;
+    }
+
+    EXPECT_EQ(MotorMixing::motorIndex(MotorFunction_e::MOTOR_8), 7);
+    EXPECT_EQ(MotorMixing::motorIndex(MotorFunction_e::GPIO), -1);
+}
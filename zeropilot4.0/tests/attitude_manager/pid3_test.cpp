@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "pid.hpp"
+#include "pid3.hpp"
+
+class PID3Test : public ::testing::Test {
+protected:
+    const float DT = 0.001f;
+    const float OUTPUT_MIN = -1.0f;
+    const float OUTPUT_MAX = 1.0f;
+    const float BASELINE_TAU = 0.0005f; // Light first order D filter to compare against, tau 0 rings at Nyquist
+
+    // Peak D-term response to a sinusoidal measurement once the filters settle
+    float dTermAmplitude(PID3 &pid, float freqHz) {
+        pid.pidInitState();
+        const float setpoint[PID3_AXES] = {};
+        float peak = 0.0f;
+        for (int i = 0; i < 2000; i++) {
+            float m = 0.01f * sinf(2.0f * static_cast<float>(M_PI) * freqHz * i * DT);
+            const float measurement[PID3_AXES] = {m, m, m};
+            float out[PID3_AXES];
+            pid.update(setpoint, measurement, out);
+            if (i >= 1000) peak = fmaxf(peak, fabsf(out[0]));
+        }
+        return peak;
+    }
+};
+
+TEST_F(PID3Test, CompatibilityModeMatchesPID) {
+    const float kp[PID3_AXES] = {0.14f, 0.2f, 0.34f};
+    const float ki[PID3_AXES] = {0.14f, 0.3f, 0.34f};
+    const float kd[PID3_AXES] = {0.0025f, 0.004f, 0.0f};
+    const float tau[PID3_AXES] = {0.02f, 0.01f, 0.02f};
+    const uint8_t iMax[PID3_AXES] = {50, 25, 50};
+
+    PID3 pid3(OUTPUT_MIN, OUTPUT_MAX, DT);
+    PID scalar[PID3_AXES] = {
+        PID(kp[0], ki[0], kd[0], tau[0], OUTPUT_MIN, OUTPUT_MAX, iMax[0], DT),
+        PID(kp[1], ki[1], kd[1], tau[1], OUTPUT_MIN, OUTPUT_MAX, iMax[1], DT),
+        PID(kp[2], ki[2], kd[2], tau[2], OUTPUT_MIN, OUTPUT_MAX, iMax[2], DT),
+    };
+    for (uint8_t axis = 0; axis < PID3_AXES; axis++) {
+        pid3.setConstants(static_cast<PIDAxis_e>(axis), kp[axis], ki[axis], kd[axis], tau[axis], iMax[axis]);
+        scalar[axis].pidInitState();
+    }
+
+    // Steps, ramps and saturation on every axis, with a gain change halfway through
+    for (int i = 0; i < 3000; i++) {
+        if (i == 1500) {
+            pid3.setKd(PIDAxis_e::PITCH, 0.01f);
+            scalar[1].setKd(0.01f);
+            pid3.setIntegralMaxPct(PIDAxis_e::YAW, 10);
+            scalar[2].setIntegralMinLimPct(10);
+            scalar[2].setIntegralMaxLimPct(10);
+        }
+
+        float setpoint[PID3_AXES];
+        float measurement[PID3_AXES];
+        for (uint8_t axis = 0; axis < PID3_AXES; axis++) {
+            setpoint[axis] = ((i / 250) % 2 ? 6.0f : -2.0f) * (axis + 1);
+            measurement[axis] = 3.0f * sinf(0.013f * i * (axis + 1));
+        }
+
+        float out[PID3_AXES];
+        pid3.update(setpoint, measurement, out);
+        for (uint8_t axis = 0; axis < PID3_AXES; axis++) {
+            float expected = scalar[axis].pidOutput(setpoint[axis], measurement[axis]);
+            ASSERT_NEAR(out[axis], expected, 1e-5f) << "axis " << int(axis) << " step " << i;
+        }
+    }
+}
+
+TEST_F(PID3Test, AxesAreIndependent) {
+    PID3 pid(OUTPUT_MIN, OUTPUT_MAX, DT);
+    pid.setConstants(PIDAxis_e::ROLL, 0.1f, 0.0f, 0.0f, 0.02f, 50);
+    pid.setConstants(PIDAxis_e::PITCH, 0.2f, 0.0f, 0.0f, 0.02f, 50);
+    pid.setConstants(PIDAxis_e::YAW, 0.3f, 0.0f, 0.0f, 0.02f, 50);
+
+    const float setpoint[PID3_AXES] = {1.0f, 1.0f, -1.0f};
+    const float measurement[PID3_AXES] = {};
+    float out[PID3_AXES];
+    pid.update(setpoint, measurement, out);
+
+    EXPECT_FLOAT_EQ(out[0], 0.1f);
+    EXPECT_FLOAT_EQ(out[1], 0.2f);
+    EXPECT_FLOAT_EQ(out[2], -0.3f);
+}
+
+TEST_F(PID3Test, FeedforwardAndSetpointWeighting) {
+    PID3 pid(OUTPUT_MIN, OUTPUT_MAX, DT);
+    pid.setConstants(PIDAxis_e::ROLL, 0.2f, 0.0f, 0.0f, 0.02f, 50);
+    pid.setFeedforward(PIDAxis_e::ROLL, 0.05f);
+    pid.setSetpointWeights(PIDAxis_e::ROLL, 0.5f, 0.0f);
+
+    const float setpoint[PID3_AXES] = {2.0f, 0.0f, 0.0f};
+    const float measurement[PID3_AXES] = {0.4f, 0.0f, 0.0f};
+    float out[PID3_AXES];
+    pid.update(setpoint, measurement, out);
+
+    // kp * (0.5 * sp - m) + kff * sp
+    EXPECT_FLOAT_EQ(out[0], 0.2f * (0.5f * 2.0f - 0.4f) + 0.05f * 2.0f);
+}
+
+TEST_F(PID3Test, DerivativeKickFollowsSetpointWeight) {
+    PID3 pid(-100.0f, 100.0f, DT);
+    pid.setConstants(PIDAxis_e::ROLL, 0.0f, 0.0f, 0.01f, 0.0f, 50);
+    pid.setConstants(PIDAxis_e::PITCH, 0.0f, 0.0f, 0.01f, 0.0f, 50);
+    pid.setSetpointWeights(PIDAxis_e::PITCH, 1.0f, 1.0f);
+
+    const float setpoint[PID3_AXES] = {1.0f, 1.0f, 0.0f};
+    const float measurement[PID3_AXES] = {};
+    float out[PID3_AXES];
+    pid.update(setpoint, measurement, out);
+
+    // Derivative on measurement ignores the step, full weight differentiates it
+    EXPECT_EQ(out[0], 0.0f);
+    EXPECT_GT(out[1], 1.0f);
+}
+
+TEST_F(PID3Test, DtermLowPassAttenuatesNoise) {
+    PID3 pid(-100.0f, 100.0f, DT);
+    for (uint8_t axis = 0; axis < PID3_AXES; axis++) {
+        pid.setConstants(static_cast<PIDAxis_e>(axis), 0.0f, 0.0f, 0.01f, BASELINE_TAU, 50);
+    }
+    float rawSignal = dTermAmplitude(pid, 5.0f);
+    float rawNoise = dTermAmplitude(pid, 200.0f);
+
+    ASSERT_TRUE(pid.setDtermLpfHz(PIDAxis_e::ROLL, 30.0f));
+    float filteredSignal = dTermAmplitude(pid, 5.0f);
+    float filteredNoise = dTermAmplitude(pid, 200.0f);
+
+    EXPECT_NEAR(filteredSignal / rawSignal, 1.0f, 0.05f);
+    EXPECT_LT(filteredNoise / rawNoise, 0.05f);
+
+    EXPECT_FALSE(pid.setDtermLpfHz(PIDAxis_e::ROLL, 480.0f));
+    EXPECT_FALSE(pid.setDtermLpfHz(PIDAxis_e::ROLL, -1.0f));
+}
+
+TEST_F(PID3Test, DtermNotchRemovesTone) {
+    PID3 pid(-100.0f, 100.0f, DT);
+    for (uint8_t axis = 0; axis < PID3_AXES; axis++) {
+        pid.setConstants(static_cast<PIDAxis_e>(axis), 0.0f, 0.0f, 0.01f, BASELINE_TAU, 50);
+    }
+    float rawTone = dTermAmplitude(pid, 150.0f);
+    float rawSignal = dTermAmplitude(pid, 10.0f);
+
+    ASSERT_TRUE(pid.setDtermNotch(150.0f, 40.0f, 40.0f));
+    EXPECT_LT(dTermAmplitude(pid, 150.0f) / rawTone, 0.05f);
+    EXPECT_NEAR(dTermAmplitude(pid, 10.0f) / rawSignal, 1.0f, 0.05f);
+
+    // Centre 0 restores the plain D-term
+    ASSERT_TRUE(pid.setDtermNotch(0.0f, 0.0f, 0.0f));
+    EXPECT_NEAR(dTermAmplitude(pid, 150.0f), rawTone, 1e-6f);
+
+    EXPECT_FALSE(pid.setDtermNotch(150.0f, 400.0f, 40.0f));
+}
+
+TEST_F(PID3Test, ConditionalIntegrationLimitsWindup) {
+    PID3 clamp(OUTPUT_MIN, OUTPUT_MAX, DT);
+    PID3 conditional(OUTPUT_MIN, OUTPUT_MAX, DT);
+    conditional.setAntiWindup(PIDAntiWindup_e::CONDITIONAL);
+    for (PID3 *pid : {&clamp, &conditional}) {
+        pid->setConstants(PIDAxis_e::ROLL, 0.5f, 2.0f, 0.0f, 0.02f, 100);
+    }
+
+    // Large error that saturates the output for a second
+    const float far[PID3_AXES] = {5.0f, 0.0f, 0.0f};
+    const float zero[PID3_AXES] = {};
+    float outClamp[PID3_AXES];
+    float outConditional[PID3_AXES];
+    for (int i = 0; i < 1000; i++) {
+        clamp.update(far, zero, outClamp);
+        conditional.update(far, zero, outConditional);
+    }
+    EXPECT_EQ(outClamp[0], OUTPUT_MAX);
+    EXPECT_EQ(outConditional[0], OUTPUT_MAX);
+
+    // Target reached, the wound up integrator keeps pushing while the conditional one lets go
+    const float reached[PID3_AXES] = {0.0f, 0.0f, 0.0f};
+    clamp.update(reached, zero, outClamp);
+    conditional.update(reached, zero, outConditional);
+    EXPECT_NEAR(outClamp[0], OUTPUT_MAX, 1e-3f);
+    EXPECT_LT(outConditional[0], 0.5f * OUTPUT_MAX);
+}
+
+TEST_F(PID3Test, StateReset) {
+    PID3 pid(OUTPUT_MIN, OUTPUT_MAX, DT);
+    pid.setConstants(PIDAxis_e::YAW, 0.1f, 1.0f, 0.01f, 0.02f, 50);
+
+    const float setpoint[PID3_AXES] = {0.0f, 0.0f, 2.0f};
+    const float measurement[PID3_AXES] = {};
+    float first[PID3_AXES];
+    float out[PID3_AXES];
+    pid.update(setpoint, measurement, first);
+    for (int i = 0; i < 100; i++) {
+        pid.update(setpoint, measurement, out);
+    }
+    EXPECT_GT(out[2], first[2]);
+
+    pid.pidInitState();
+    pid.update(setpoint, measurement, out);
+    EXPECT_FLOAT_EQ(out[2], first[2]);
+}
@@ -0,0 +1,334 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cmath>
+#include "sysid_mapping.hpp"
+#include "mock_fft.hpp"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+// Base mode that records what it was given and holds the surfaces or efforts at centre
+class CentredMode : public Flightmode {
+    public:
+        int activations = 0;
+        RCMotorControlMessage_t lastInput{};
+
+        void activateFlightMode() override { activations++; }
+
+        RCMotorControlMessage_t runControl(RCMotorControlMessage_t controlInput, const DroneState_t &droneState) override {
+            lastInput = controlInput;
+            RCMotorControlMessage_t out = controlInput;
+            out.roll = MIXER_CENTRE;
+            out.pitch = MIXER_CENTRE;
+            out.yaw = MIXER_CENTRE;
+            return out;
+        }
+
+        #ifdef PLANE
+        static constexpr float MIXER_CENTRE = 50.0f;
+        static constexpr float MIXER_FULL_SCALE = 50.0f;
+        #endif
+        #ifdef QUADCOPTER
+        static constexpr float MIXER_CENTRE = 0.0f;
+        static constexpr float MIXER_FULL_SCALE = 1.0f;
+        #endif
+};
+
+class SysIdMappingTest : public ::testing::Test {
+protected:
+    static constexpr float DT = 0.01f;
+
+    NiceMock<MockFFT> mockFFT;
+    CentredMode base;
+    DroneState_t state = DRONE_STATE_DEFAULT;
+    RCMotorControlMessage_t sticks{};
+
+    void SetUp() override {
+        ON_CALL(mockFFT, init(_)).WillByDefault(Return(true));
+
+        // Naive DFT in the CMSIS packed real FFT layout: [DC, Nyquist, re1, im1, ...]
+        ON_CALL(mockFFT, runFFT(_, _, _)).WillByDefault(Invoke([](float *in, float *out, uint8_t) {
+            const int n = FrequencyResponse::WINDOW_LEN;
+            for (int k = 0; k <= n / 2; k++) {
+                double re = 0.0, im = 0.0;
+                for (int i = 0; i < n; i++) {
+                    double angle = -2.0 * M_PI * k * i / n;
+                    re += in[i] * std::cos(angle);
+                    im += in[i] * std::sin(angle);
+                }
+                if (k == 0) {
+                    out[0] = static_cast<float>(re);
+                } else if (k == n / 2) {
+                    out[1] = static_cast<float>(re);
+                } else {
+                    out[2 * k] = static_cast<float>(re);
+                    out[2 * k + 1] = static_cast<float>(im);
+                }
+            }
+        }));
+
+        sticks.roll = 50.0f;
+        sticks.pitch = 50.0f;
+        sticks.yaw = 50.0f;
+        sticks.throttle = 50.0f;
+        sticks.arm = true;
+    }
+};
+
+TEST(ChirpGeneratorTest, SweepsFromStartToStop) {
+    ChirpGenerator chirp;
+    ASSERT_TRUE(chirp.init(1.0f, 10.0f, 4.0f, 1.0f, 1.0f));
+    EXPECT_FLOAT_EQ(chirp.getDurationS(), 6.0f);
+
+    const float dt = 0.001f;
+    float fadeInPeak = 0.0f;
+    while (chirp.getElapsedS() < 0.25f) {
+        fadeInPeak = fmaxf(fadeInPeak, fabsf(chirp.update(dt)));
+    }
+    EXPECT_LT(fadeInPeak, 0.3f);        // Still ramping up
+    EXPECT_NEAR(chirp.getFrequencyHz(), 1.0f, 1e-3f);
+
+    // Exponential sweep, halfway through the record time is the geometric mean
+    while (chirp.getElapsedS() < 3.0f) chirp.update(dt);
+    EXPECT_NEAR(chirp.getFrequencyHz(), sqrtf(10.0f), 0.05f);
+
+    while (chirp.getElapsedS() < 5.5f) chirp.update(dt);
+    EXPECT_NEAR(chirp.getFrequencyHz(), 10.0f, 1e-3f);
+    EXPECT_FALSE(chirp.isComplete());
+
+    while (chirp.getElapsedS() < 6.0f) chirp.update(dt);
+    EXPECT_TRUE(chirp.isComplete());
+    EXPECT_FLOAT_EQ(chirp.update(dt), 0.0f);
+}
+
+TEST(ChirpGeneratorTest, StaysWithinUnitAmplitude) {
+    ChirpGenerator chirp;
+    ASSERT_TRUE(chirp.init(0.5f, 40.0f, 10.0f, 2.0f, 2.0f));
+
+    float peak = 0.0f;
+    while (!chirp.isComplete()) {
+        peak = fmaxf(peak, fabsf(chirp.update(0.0025f)));
+    }
+    EXPECT_LE(peak, 1.0f);
+    EXPECT_GT(peak, 0.99f);
+}
+
+TEST(ChirpGeneratorTest, RejectsInvalidSweep) {
+    ChirpGenerator chirp;
+    EXPECT_FALSE(chirp.init(0.0f, 10.0f, 4.0f, 1.0f, 1.0f));
+    EXPECT_FALSE(chirp.init(10.0f, 1.0f, 4.0f, 1.0f, 1.0f));
+    EXPECT_FALSE(chirp.init(1.0f, 10.0f, 0.0f, 1.0f, 1.0f));
+    EXPECT_FALSE(chirp.init(1.0f, 10.0f, 4.0f, -1.0f, 1.0f));
+}
+
+TEST_F(SysIdMappingTest, RejectsInvalidSettings) {
+    SysIdMapping sysid(DT, base, &mockFFT);
+
+    EXPECT_FALSE(sysid.setAxis(static_cast<uint8_t>(SysIdAxis_e::RATE_ROLL)));   // No rate loop host
+    EXPECT_FALSE(sysid.setAxis(4));                                               // Recovery inputs unsupported
+    EXPECT_FALSE(sysid.setAxis(13));
+    EXPECT_TRUE(sysid.setAxis(static_cast<uint8_t>(SysIdAxis_e::MIX_YAW)));
+
+    EXPECT_FALSE(sysid.setMagnitude(0.0f));
+    EXPECT_FALSE(sysid.setMagnitude(0.6f));
+    EXPECT_TRUE(sysid.setMagnitude(0.5f));
+
+    // 100 Hz control loop, 40 Hz is the highest stop frequency with 2.5 samples per cycle
+    EXPECT_TRUE(sysid.setChirp(0.5f, 40.0f, 30.0f, 2.0f, 2.0f));
+    EXPECT_FALSE(sysid.setChirp(0.5f, 45.0f, 30.0f, 2.0f, 2.0f));
+    EXPECT_FALSE(sysid.setChirp(5.0f, 1.0f, 30.0f, 2.0f, 2.0f));
+}
+
+TEST_F(SysIdMappingTest, AxisNoneFliesBaseMode) {
+    SysIdMapping sysid(DT, base, &mockFFT);
+    sysid.activateFlightMode();
+    EXPECT_EQ(base.activations, 1);
+    EXPECT_FALSE(sysid.isRunning());
+
+    RCMotorControlMessage_t out = sysid.runControl(sticks, state);
+    EXPECT_FLOAT_EQ(base.lastInput.roll, 50.0f);
+    EXPECT_FLOAT_EQ(out.roll, CentredMode::MIXER_CENTRE);
+
+    SysIdLogBlock_t block;
+    EXPECT_FALSE(sysid.takeLogBlock(block));
+}
+
+TEST_F(SysIdMappingTest, InputInjectionMovesOnlyThatStick) {
+    SysIdMapping sysid(DT, base, &mockFFT);
+    ASSERT_TRUE(sysid.setAxis(static_cast<uint8_t>(SysIdAxis_e::INPUT_PITCH)));
+    ASSERT_TRUE(sysid.setMagnitude(0.2f));
+    ASSERT_TRUE(sysid.setChirp(1.0f, 5.0f, 2.0f, 0.0f, 0.0f));
+    sysid.activateFlightMode();
+    ASSERT_TRUE(sysid.isRunning());
+
+    float maxOffset = 0.0f;
+    for (int i = 0; i < 100; i++) {
+        sysid.runControl(sticks, state);
+        maxOffset = fmaxf(maxOffset, fabsf(base.lastInput.pitch - 50.0f));
+        EXPECT_FLOAT_EQ(base.lastInput.roll, 50.0f);
+        EXPECT_FLOAT_EQ(base.lastInput.yaw, 50.0f);
+    }
+    EXPECT_GT(maxOffset, 5.0f);
+    EXPECT_LE(maxOffset, 10.0f + 1e-3f);    // 0.2 of the 50 unit half range
+}
+
+TEST_F(SysIdMappingTest, InputInjectionClampsToStickRange) {
+    SysIdMapping sysid(DT, base, &mockFFT);
+    ASSERT_TRUE(sysid.setAxis(static_cast<uint8_t>(SysIdAxis_e::INPUT_ROLL)));
+    ASSERT_TRUE(sysid.setMagnitude(0.5f));
+    ASSERT_TRUE(sysid.setChirp(1.0f, 5.0f, 2.0f, 0.0f, 0.0f));
+    sysid.activateFlightMode();
+
+    sticks.roll = 95.0f;
+    for (int i = 0; i < 100; i++) {
+        sysid.runControl(sticks, state);
+        EXPECT_LE(base.lastInput.roll, 100.0f);
+        EXPECT_GE(base.lastInput.roll, 0.0f);
+    }
+}
+
+TEST_F(SysIdMappingTest, MixerInjectionOffsetsOutput) {
+    SysIdMapping sysid(DT, base, &mockFFT);
+    ASSERT_TRUE(sysid.setAxis(static_cast<uint8_t>(SysIdAxis_e::MIX_ROLL)));
+    ASSERT_TRUE(sysid.setMagnitude(0.1f));
+    ASSERT_TRUE(sysid.setChirp(1.0f, 5.0f, 2.0f, 0.0f, 0.0f));
+    sysid.activateFlightMode();
+
+    float maxOffset = 0.0f;
+    for (int i = 0; i < 100; i++) {
+        RCMotorControlMessage_t out = sysid.runControl(sticks, state);
+        maxOffset = fmaxf(maxOffset, fabsf(out.roll - CentredMode::MIXER_CENTRE));
+        EXPECT_FLOAT_EQ(out.pitch, CentredMode::MIXER_CENTRE);
+        EXPECT_FLOAT_EQ(base.lastInput.roll, 50.0f);    // Sticks untouched
+    }
+    EXPECT_GT(maxOffset, 0.05f * CentredMode::MIXER_FULL_SCALE);
+    EXPECT_LE(maxOffset, 0.1f * CentredMode::MIXER_FULL_SCALE + 1e-4f);
+}
+
+TEST_F(SysIdMappingTest, RateInjectionGoesThroughStabilize) {
+    AcroMapping acro(DT);
+    StabilizeMapping stabilize(DT, acro);
+    AcroMapping refAcro(DT);
+    StabilizeMapping reference(DT, refAcro);
+    for (AcroMapping *rateLoop : {&acro, &refAcro}) {
+        rateLoop->setYawPIDConstants(0.2f, 0.0f, 0.0f, 0.02f, 50);
+        rateLoop->setYawLimitRate(3.0f);
+    }
+
+    SysIdMapping sysid(DT, stabilize, &mockFFT, &stabilize);
+    ASSERT_TRUE(sysid.setAxis(static_cast<uint8_t>(SysIdAxis_e::RATE_YAW)));
+    ASSERT_TRUE(sysid.setMagnitude(0.2f));
+    ASSERT_TRUE(sysid.setChirp(1.0f, 5.0f, 1.0f, 0.0f, 0.0f));
+    sysid.activateFlightMode();
+    reference.activateFlightMode();
+
+    float maxDiff = 0.0f;
+    while (sysid.isRunning()) {
+        RCMotorControlMessage_t out = sysid.runControl(sticks, state);
+        RCMotorControlMessage_t ref = reference.runControl(sticks, state);
+        maxDiff = fmaxf(maxDiff, fabsf(out.yaw - ref.yaw));
+        EXPECT_FLOAT_EQ(out.roll, ref.roll);
+    }
+    EXPECT_GT(maxDiff, 0.0f);
+
+    // The offset is cleared once the chirp ends
+    stabilize.activateFlightMode();
+    reference.activateFlightMode();
+    RCMotorControlMessage_t out = sysid.runControl(sticks, state);
+    RCMotorControlMessage_t ref = reference.runControl(sticks, state);
+    EXPECT_FLOAT_EQ(out.yaw, ref.yaw);
+}
+
+TEST_F(SysIdMappingTest, StreamsLogBlocksAndReportsCompletionOnce) {
+    SysIdMapping sysid(DT, base, &mockFFT);
+    ASSERT_TRUE(sysid.setAxis(static_cast<uint8_t>(SysIdAxis_e::MIX_PITCH)));
+    ASSERT_TRUE(sysid.setChirp(1.0f, 5.0f, 1.2f, 0.0f, 0.0f));   // 120 samples, two full blocks and one of 20
+    sysid.activateFlightMode();
+
+    uint32_t blocks = 0;
+    uint32_t samples = 0;
+    uint8_t lastCount = 0;
+    int completions = 0;
+    SysIdLogBlock_t block;
+    for (int i = 0; i < 200; i++) {
+        state.pitchRate = 0.001f * i;
+        sysid.runControl(sticks, state);
+        if (sysid.takeLogBlock(block)) {
+            EXPECT_EQ(block.sync, SYSID_LOG_SYNC);
+            EXPECT_EQ(block.axis, static_cast<uint8_t>(SysIdAxis_e::MIX_PITCH));
+            EXPECT_EQ(block.seq, blocks);
+            EXPECT_FLOAT_EQ(block.sampleRateHz, 1.0f / DT);
+            EXPECT_NEAR(block.startTimeS, samples * DT, 1e-4f);
+            EXPECT_FLOAT_EQ(block.measured[0], 0.001f * samples);
+            blocks++;
+            samples += block.count;
+            lastCount = block.count;
+        }
+        if (sysid.takeCompletion()) completions++;
+    }
+
+    EXPECT_EQ(blocks, 3u);
+    EXPECT_NEAR(samples, 120u, 1u);  // Float step accumulation may add a sample
+    EXPECT_EQ(lastCount, samples - 100u);
+    EXPECT_EQ(completions, 1);
+    EXPECT_TRUE(sysid.isComplete());
+    EXPECT_FALSE(sysid.isRunning());
+}
+
+TEST_F(SysIdMappingTest, ActivationRestartsRun) {
+    SysIdMapping sysid(DT, base, &mockFFT);
+    ASSERT_TRUE(sysid.setAxis(static_cast<uint8_t>(SysIdAxis_e::MIX_ROLL)));
+    ASSERT_TRUE(sysid.setChirp(1.0f, 5.0f, 0.5f, 0.0f, 0.0f));
+    sysid.activateFlightMode();
+    while (sysid.isRunning()) sysid.runControl(sticks, state);
+    ASSERT_TRUE(sysid.isComplete());
+
+    // Settings changed in between take effect on re-entry
+    ASSERT_TRUE(sysid.setAxis(static_cast<uint8_t>(SysIdAxis_e::MIX_YAW)));
+    sysid.activateFlightMode();
+    EXPECT_TRUE(sysid.isRunning());
+    EXPECT_FALSE(sysid.isComplete());
+    EXPECT_EQ(sysid.getAxis(), SysIdAxis_e::MIX_YAW);
+}
+
+TEST_F(SysIdMappingTest, EstimatesFirstOrderRateResponse) {
+    SysIdMapping sysid(DT, base, &mockFFT);
+    ASSERT_TRUE(sysid.setAxis(static_cast<uint8_t>(SysIdAxis_e::MIX_ROLL)));
+    ASSERT_TRUE(sysid.setMagnitude(0.2f));
+    ASSERT_TRUE(sysid.setChirp(0.5f, 10.0f, 40.0f, 1.0f, 1.0f));
+    sysid.activateFlightMode();
+
+    // Roll rate lags the injected effort with a 2 Hz corner
+    const float plantGain = 4.0f;
+    const float tauS = 1.0f / (2.0f * 3.14159265f * 2.0f);
+    float rate = 0.0f;
+    while (sysid.isRunning()) {
+        RCMotorControlMessage_t out = sysid.runControl(sticks, state);
+        float effort = (out.roll - CentredMode::MIXER_CENTRE) / CentredMode::MIXER_FULL_SCALE;
+        rate += (plantGain * effort - rate) * DT / tauS;
+        state.rollRate = rate;
+    }
+
+    const FrequencyResponse &response = sysid.getResponse();
+    ASSERT_GT(response.getWindowCount(), 5);
+
+    bool checkedLow = false;
+    bool checkedCorner = false;
+    for (uint16_t bin = 1; bin < FrequencyResponse::BIN_COUNT; bin++) {
+        FrequencyResponsePoint_t point;
+        if (!response.getPoint(bin, point) || point.freqHz < 0.7f || point.freqHz > 8.0f) continue;
+
+        const float w = 2.0f * 3.14159265f * point.freqHz * tauS;
+        const float expectedGain = plantGain / sqrtf(1.0f + w * w);
+        EXPECT_GT(point.coherence, 0.8f) << point.freqHz << " Hz";
+        EXPECT_NEAR(point.gain, expectedGain, 0.15f * expectedGain) << point.freqHz << " Hz";
+        EXPECT_LT(point.phaseDeg, 0.0f) << point.freqHz << " Hz";
+
+        if (point.freqHz < 1.0f) checkedLow = true;
+        if (fabsf(point.freqHz - 2.0f) < 0.3f) checkedCorner = true;
+    }
+    EXPECT_TRUE(checkedLow);
+    EXPECT_TRUE(checkedCorner);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "thrust_curve.hpp"
+
+static constexpr float BATT_MAX_V = 16.8f;
+static constexpr float BATT_MIN_V = 13.2f;
+
+// Motor and battery the curve is meant to invert, thrust relative to full throttle on a full battery
+static float plantThrust(float expo, float command, float voltage) {
+    float effective = command * voltage / BATT_MAX_V;
+    return (1.0f - expo) * effective + expo * effective * effective;
+}
+
+TEST(ThrustCurveTest, LinearWhenExpoZero) {
+    ThrustCurve curve;
+    ASSERT_TRUE(curve.setExpo(0.0f));
+    for (int i = 0; i <= 100; i++) {
+        float thrust = i / 100.0f;
+        EXPECT_NEAR(curve.thrustToActuator(thrust), thrust, 1e-6f);
+    }
+}
+
+TEST(ThrustCurveTest, InvertsThrustModel) {
+    const float expos[] = {-0.5f, 0.3f, 0.65f, 0.8f};
+    for (float expo : expos) {
+        ThrustCurve curve;
+        ASSERT_TRUE(curve.setExpo(expo));
+        for (int i = 0; i <= 200; i++) {
+            float thrust = i / 200.0f;
+            float actuator = curve.thrustToActuator(thrust);
+            EXPECT_NEAR(plantThrust(expo, actuator, BATT_MAX_V), thrust, 1e-3f) << "expo " << expo << " thrust " << thrust;
+        }
+        EXPECT_EQ(curve.thrustToActuator(0.0f), 0.0f);
+        EXPECT_NEAR(curve.thrustToActuator(1.0f), 1.0f, 1e-6f);
+    }
+}
+
+TEST(ThrustCurveTest, ConsistentStepResponseAcrossThrottle) {
+    static constexpr float EXPO = 0.65f;
+    static constexpr float STEP = 0.05f;
+    const float hoverThrusts[] = {0.2f, 0.4f, 0.6f};
+    const float voltages[] = {16.8f, 15.0f, 13.6f};
+
+    ThrustCurve linearized;
+    ASSERT_TRUE(linearized.setExpo(EXPO));
+    ASSERT_TRUE(linearized.setVoltageLimits(BATT_MIN_V, BATT_MAX_V));
+    ThrustCurve passthrough;
+    ASSERT_TRUE(passthrough.setExpo(0.0f));
+
+    // The same thrust step gives the same change in thrust at any operating point and battery state
+    float minGain = INFINITY;
+    float maxGain = 0.0f;
+    for (float voltage : voltages) {
+        linearized.updateVoltage(voltage);
+        for (float hover : hoverThrusts) {
+            float before = plantThrust(EXPO, linearized.thrustToActuator(hover), voltage);
+            float after = plantThrust(EXPO, linearized.thrustToActuator(hover + STEP), voltage);
+            EXPECT_NEAR((after - before) / STEP, 1.0f, 0.02f) << "hover " << hover << " voltage " << voltage;
+
+            float rawBefore = plantThrust(EXPO, passthrough.thrustToActuator(hover), voltage);
+            float rawAfter = plantThrust(EXPO, passthrough.thrustToActuator(hover + STEP), voltage);
+            float rawGain = (rawAfter - rawBefore) / STEP;
+            minGain = fminf(minGain, rawGain);
+            maxGain = fmaxf(maxGain, rawGain);
+        }
+    }
+
+    // Without the curve the loop gain swings by more than 2x over the same envelope
+    EXPECT_GT(maxGain / minGain, 2.0f);
+}
+
+TEST(ThrustCurveTest, VoltageCompensation) {
+    ThrustCurve curve;
+    ASSERT_TRUE(curve.setExpo(0.0f));
+
+    // Disabled until both limits are set
+    curve.updateVoltage(14.0f);
+    EXPECT_EQ(curve.getVoltageScale(), 1.0f);
+
+    ASSERT_TRUE(curve.setVoltageLimits(BATT_MIN_V, BATT_MAX_V));
+    EXPECT_FLOAT_EQ(curve.getVoltageScale(), BATT_MAX_V / 14.0f);
+    EXPECT_FLOAT_EQ(curve.thrustToActuator(0.5f), 0.5f * BATT_MAX_V / 14.0f);
+    EXPECT_EQ(curve.thrustToActuator(0.95f), 1.0f);
+
+    // Clamped to the limits, and no compensation without a battery reading
+    curve.updateVoltage(17.5f);
+    EXPECT_FLOAT_EQ(curve.getVoltageScale(), 1.0f);
+    curve.updateVoltage(12.0f);
+    EXPECT_FLOAT_EQ(curve.getVoltageScale(), BATT_MAX_V / BATT_MIN_V);
+    curve.updateVoltage(0.0f);
+    EXPECT_EQ(curve.getVoltageScale(), 1.0f);
+}
+
+TEST(ThrustCurveTest, RejectsInvalidParams) {
+    ThrustCurve curve;
+    ASSERT_TRUE(curve.setExpo(0.65f));
+    EXPECT_FALSE(curve.setExpo(1.5f));
+    EXPECT_FALSE(curve.setExpo(NAN));
+    EXPECT_FLOAT_EQ(curve.getExpo(), 0.65f);
+
+    EXPECT_FALSE(curve.setVoltageLimits(-1.0f, BATT_MAX_V));
+    EXPECT_FALSE(curve.setVoltageLimits(BATT_MAX_V, BATT_MIN_V));
+    EXPECT_TRUE(curve.setVoltageLimits(BATT_MIN_V, 0.0f));
+
+    EXPECT_EQ(curve.thrustToActuator(NAN), 0.0f);
+    EXPECT_EQ(curve.thrustToActuator(-0.2f), 0.0f);
+    EXPECT_NEAR(curve.thrustToActuator(1.4f), 1.0f, 1e-6f);
+}
@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <limits>
+#include "MahonyAHRS.hpp"
+#include "ahrs_ekf.hpp"
+#include "host_mathutils.hpp"
+
+static constexpr float DT = 0.001f;
+
+// Slow rocking motion with gravity and the earth field rotated to match, built once so only
+// the filter update is timed
+static constexpr int SWEEP_STEPS = 64;
+struct ImuSweep {
+    float gyro[SWEEP_STEPS][3];
+    float accel[SWEEP_STEPS][3];
+    float mag[SWEEP_STEPS][3];
+
+    ImuSweep() {
+        for (int i = 0; i < SWEEP_STEPS; i++) {
+            float roll = 0.2f * sinf(0.1f * i);
+            float pitch = 0.1f * sinf(0.1f * i + 1.0f);
+            gyro[i][0] = 0.02f * cosf(0.1f * i);
+            gyro[i][1] = 0.01f * cosf(0.1f * i + 1.0f);
+            gyro[i][2] = 0.005f;
+            accel[i][0] = 9.81f * sinf(pitch);
+            accel[i][1] = -9.81f * sinf(roll) * cosf(pitch);
+            accel[i][2] = -9.81f * cosf(roll) * cosf(pitch);
+            mag[i][0] = cosf(pitch);
+            mag[i][1] = sinf(roll) * sinf(pitch);
+            mag[i][2] = cosf(roll) * sinf(pitch);
+        }
+    }
+};
+static const ImuSweep SWEEP;
+
+static void BM_MahonyUpdateIMU(benchmark::State &state) {
+    Mahony mahony;
+    mahony.begin(1.0f / DT);
+
+    int i = 0;
+    for (auto _ : state) {
+        mahony.updateIMU(SWEEP.gyro[i][0], SWEEP.gyro[i][1], SWEEP.gyro[i][2],
+                         SWEEP.accel[i][0], SWEEP.accel[i][1], SWEEP.accel[i][2], DT);
+        benchmark::DoNotOptimize(mahony.getAttitudeRadians());
+        i = (i + 1) % SWEEP_STEPS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MahonyUpdateIMU);
+
+// The configuration the AM will init the EKF with
+static AHRSEKF makeEkf(IMathUtils *math) {
+    AHRSEKF::Config cfg = {
+        4.78e-6f,                           // gyroCov
+        9.41e-4f,                           // accelCov
+        3.6e-5f,                            // magCov
+        1.0e-6f,                            // gyroBiasCov
+        0.0f,                               // accelBiasCov
+        std::numeric_limits<float>::max(),  // accelGateThreshold
+        16.3f,                              // magGateThreshold
+        1e-2f,                              // pInitAtt
+        1e-3f,                              // pInitBiasGyro
+        0.0f,                               // pInitBiasAccel
+        {0, 0, 9.81f},                      // gravityInertial
+        {1, 0, 0}                           // magInertial
+    };
+    const float gyro[3] = {0.0f, 0.0f, 0.0f};
+    const float accel[3] = {0.0f, 0.0f, -9.81f};
+    const float mag[3] = {1.0f, 0.0f, 0.0f};
+    const float quat[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+
+    AHRSEKF ekf(math);
+    ekf.init(gyro, accel, mag, quat, cfg);
+    return ekf;
+}
+
+static void BM_EKFStateExtrapolation(benchmark::State &state) {
+    HostMathUtils math;
+    AHRSEKF ekf = makeEkf(&math);
+
+    int i = 0;
+    for (auto _ : state) {
+        ekf.stateExtrapolation(SWEEP.gyro[i], DT);
+        benchmark::DoNotOptimize(ekf.p);
+        i = (i + 1) % SWEEP_STEPS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EKFStateExtrapolation);
+
+// Each correction follows a prediction step so the covariance stays in its flying range
+static void BM_EKFCorrectionAccelerometer(benchmark::State &state) {
+    HostMathUtils math;
+    AHRSEKF ekf = makeEkf(&math);
+
+    int i = 0;
+    for (auto _ : state) {
+        ekf.stateExtrapolation(SWEEP.gyro[i], DT);
+        ekf.correctionAccelerometer(SWEEP.accel[i]);
+        benchmark::DoNotOptimize(ekf.p);
+        i = (i + 1) % SWEEP_STEPS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EKFCorrectionAccelerometer);
+
+static void BM_EKFCorrectionMagnetometer(benchmark::State &state) {
+    HostMathUtils math;
+    AHRSEKF ekf = makeEkf(&math);
+
+    int i = 0;
+    for (auto _ : state) {
+        ekf.stateExtrapolation(SWEEP.gyro[i], DT);
+        ekf.correctionMagnetometer(SWEEP.mag[i]);
+        benchmark::DoNotOptimize(ekf.p);
+        i = (i + 1) % SWEEP_STEPS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EKFCorrectionMagnetometer);
@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "attitude_manager.hpp"
+#include "host_fft.hpp"
+#include "host_mathutils.hpp"
+#include "zp_params.hpp"
+#include "bench_drivers.hpp"
+
+// One full amUpdate() per iteration: IMU batch through the decimator, notch and Mahony, the
+// flight mode's control law, mixing and motor outputs, and the telemetry pushes on their ticks.
+// Args: flight mode, IMU ODR in Hz (the batch holds one control period of samples)
+static void BM_AttitudeManagerUpdate(benchmark::State &state) {
+    const FlightMode_e mode = static_cast<FlightMode_e>(state.range(0));
+    const float odrHz = static_cast<float>(state.range(1));
+
+    ParamRegistry params;
+    const uint16_t batchSize = static_cast<uint16_t>(odrHz / params.get(ZP_PARAM_ID::SCHED_LOOP_RATE));
+
+    BenchSystemUtils systemUtils;
+    HostMathUtils mathUtils;
+    HostFFT fft;
+    BenchGPS gps;
+    BenchIMU imu(odrHz, batchSize);
+    BenchRangefinder rangefinder;
+    BenchBarometer barometer;
+    BenchSinkQueue<TMMessage_t> tmQueue;
+    BenchSinkQueue<char[100]> logQueue;
+
+    RCMotorControlMessage_t rcMsg = {};
+    rcMsg.roll = 55.0f;
+    rcMsg.pitch = 45.0f;
+    rcMsg.yaw = 52.0f;
+    rcMsg.throttle = 60.0f;
+    rcMsg.arm = true;
+    rcMsg.flightMode = mode;
+    BenchReplayQueue<RCMotorControlMessage_t, 1> amQueue(&rcMsg, 1);
+
+    BenchMotor motors[4];
+    MotorInstance_t motorInstances[4] = {{&motors[0]}, {&motors[1]}, {&motors[2]}, {&motors[3]}}; // Rest loaded from params
+    MotorGroupInstance_t motorGroup{motorInstances, 4};
+
+    auto am = std::make_unique<AttitudeManager>(&systemUtils, &mathUtils, &gps, &imu, &fft, &rangefinder, &barometer,
+        &amQueue, &tmQueue, &logQueue, &motorGroup, nullptr, nullptr, nullptr, nullptr, nullptr, &params);
+
+    // Past arming and the first FFT windows so the notch filters are live
+    for (int i = 0; i < 2000; i++) {
+        am->amUpdate();
+    }
+
+    for (auto _ : state) {
+        am->amUpdate();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["imu_batch"] = batchSize;
+}
+
+BENCHMARK(BM_AttitudeManagerUpdate)
+    ->ArgNames({"mode", "odr"})
+    ->ArgsProduct({
+        #ifdef PLANE
+        {static_cast<int>(FlightMode_e::MANUAL), static_cast<int>(FlightMode_e::FBWA)},
+        #endif
+        #ifdef QUADCOPTER
+        {static_cast<int>(FlightMode_e::STABILIZE), static_cast<int>(FlightMode_e::ACRO)},
+        #endif
+        {1000, 8000}
+    });
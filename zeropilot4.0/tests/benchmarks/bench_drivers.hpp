@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cmath>
+#include <cstring>
+#include "systemutils_iface.hpp"
+#include "gps_iface.hpp"
+#include "imu_iface.hpp"
+#include "rangefinder_iface.hpp"
+#include "barometer_iface.hpp"
+#include "queue_iface.hpp"
+#include "motor_iface.hpp"
+#include "telemlink_iface.hpp"
+
+// Plain driver fakes for the manager benchmarks. The gmock mocks lock a mutex and match
+// expectations on every call, which would cost more than the code being timed.
+
+class BenchSystemUtils : public ISystemUtils {
+    public:
+        void delayMs(uint32_t) override {}
+        uint32_t getCurrentTimestampMs() override { return 1000; }
+        void profilerRegister(const char*, uint8_t* outId) override { *outId = 0; }
+        void profilerBegin(uint8_t) override {}
+        void profilerEnd(uint8_t) override {}
+        void profilerGetAll(TaskProfile*, uint8_t* count) override { *count = 0; }
+};
+
+class BenchGPS : public IGPS {
+    public:
+        GpsData_t readData() override { return GpsData_t{}; }
+};
+
+class BenchBarometer : public IBarometer {
+    public:
+        bool readData(BaroData_t &data) override { data = BaroData_t{}; return true; }
+};
+
+class BenchRangefinder : public IRangefinder {
+    public:
+        int init() override { return 0; }
+        RangefinderData_t readData() override { return RangefinderData_t{}; }
+};
+
+class BenchMotor : public IMotorControl {
+    public:
+        void set(uint32_t percent) override { last = percent; }
+        void setNormalized(float command) override { lastNormalized = command; }
+        void init() override {}
+
+        volatile uint32_t last = 0;
+        volatile float lastNormalized = 0.0f;
+};
+
+// One FIFO batch per read at a fixed ODR, gyro carries a motor-like tone for the notch to lock on to
+class BenchIMU : public IIMU {
+    public:
+        static constexpr uint16_t MAX_BATCH = 32;
+        static constexpr float TONE_HZ = 160.0f;
+
+        BenchIMU(float odrHz, uint16_t batchSize) : odrHz(odrHz), batchSize(batchSize) {
+            for (uint16_t i = 0; i < MAX_BATCH; i++) {
+                raw[i] = RawImu_t{};
+            }
+        }
+
+        int init() override { return 0; }
+        RawImuBatch_t readRawData() override { return {raw, batchSize, 0}; }
+
+        ScaledImuBatch_t scaleIMUData(const RawImuBatch_t &) override {
+            const uint64_t periodUs = static_cast<uint64_t>(1e6f / odrHz);
+            for (uint16_t i = 0; i < batchSize; i++) {
+                float tone = 0.2f * sinf(2.0f * 3.14159265f * tonePhase);
+                tonePhase += TONE_HZ / odrHz;
+                if (tonePhase >= 1.0f) tonePhase -= 1.0f;
+
+                timestampUs += periodUs;
+                scaled[i] = {0.3f, -0.2f, -9.81f, 0.05f + tone, -0.02f + 0.5f * tone, 0.01f, timestampUs, 0};
+            }
+            return {scaled, batchSize, 0};
+        }
+
+        float getODRHz() override { return odrHz; }
+        GyroBias_t getGyroStartupBias(uint8_t) override { return {0.0f, 0.0f, 0.0f}; }
+
+    private:
+        float odrHz;
+        uint16_t batchSize;
+        uint64_t timestampUs = 0;
+        float tonePhase = 0.0f;
+        RawImu_t raw[MAX_BATCH];
+        ScaledImu_t scaled[MAX_BATCH];
+};
+
+// Fixed capacity ring like the CMSIS-RTOS queues on the board, push fails when full
+template <typename T, int CAPACITY>
+class BenchQueue : public IMessageQueue<T> {
+    public:
+        int get(T *message) override {
+            if (size == 0) return -1;
+            std::memcpy(message, &slots[head], sizeof(T));
+            head = (head + 1) % CAPACITY;
+            size--;
+            return 0;
+        }
+
+        int push(T *message) override {
+            if (size == CAPACITY) return -1;
+            std::memcpy(&slots[(head + size) % CAPACITY], message, sizeof(T));
+            size++;
+            return 0;
+        }
+
+        int count() override { return size; }
+        int remainingCapacity() override { return CAPACITY - size; }
+
+    private:
+        T slots[CAPACITY];
+        int head = 0;
+        int size = 0;
+};
+
+// Always full, get() cycles through a fixed set of messages so a consumer sees a saturated
+// queue every update without the refill being timed
+template <typename T, int CAPACITY>
+class BenchReplayQueue : public IMessageQueue<T> {
+    public:
+        BenchReplayQueue(const T *messages, int messageCount) : messages(messages), messageCount(messageCount) {}
+
+        int get(T *message) override {
+            std::memcpy(message, &messages[next], sizeof(T));
+            next = (next + 1) % messageCount;
+            return 0;
+        }
+
+        int push(T *) override { return -1; }
+        int count() override { return CAPACITY; }
+        int remainingCapacity() override { return 0; }
+
+    private:
+        const T *messages;
+        int messageCount;
+        int next = 0;
+};
+
+// Accepts and drops everything, for outputs a benchmark doesn't consume
+template <typename T>
+class BenchSinkQueue : public IMessageQueue<T> {
+    public:
+        int get(T *) override { return -1; }
+        int push(T *message) override { std::memcpy(&last, message, sizeof(T)); return 0; }
+        int count() override { return 0; }
+        int remainingCapacity() override { return 1; }
+
+    private:
+        T last;
+};
+
+// Hands the same byte stream to the receiver every update, sent bytes are dropped
+class BenchTelemLink : public ITelemLink {
+    public:
+        BenchTelemLink(const uint8_t *rxStream, uint16_t rxLen) : rxStream(rxStream), rxLen(rxLen) {}
+
+        void transmit(const uint8_t *, uint16_t size) override { sent = size; }
+
+        uint16_t receive(uint8_t *buffer, uint16_t bufferSize) override {
+            uint16_t n = rxLen < bufferSize ? rxLen : bufferSize;
+            std::memcpy(buffer, rxStream, n);
+            return n;
+        }
+
+        volatile uint16_t sent = 0;
+
+    private:
+        const uint8_t *rxStream;
+        uint16_t rxLen;
+};
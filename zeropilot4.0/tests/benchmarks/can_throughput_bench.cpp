@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+#include "can_controller.hpp"
+#include "virtual_can_bus.hpp"
+#include "uavcan.protocol.debug.LogMessage.h"
+
+// zp_bench is built with CANARD_ENABLE_CANFD so both frame formats can be compared in one run
+static_assert(CANARD_ENABLE_CANFD, "CAN throughput benchmark needs CANARD_ENABLE_CANFD");
+
+// Raw payloads under the LogMessage type, standing in for log streaming
+static constexpr uint16_t STREAM_DATA_TYPE_ID = UAVCAN_PROTOCOL_DEBUG_LOGMESSAGE_ID;
+static constexpr uint64_t STREAM_SIGNATURE = UAVCAN_PROTOCOL_DEBUG_LOGMESSAGE_SIGNATURE;
+
+// Clock stands still, the controller's 1 Hz tasks run once on the first wake
+class BenchSystemUtils : public ISystemUtils {
+    public:
+        void delayMs(uint32_t) override {}
+        uint32_t getCurrentTimestampMs() override { return 1000; }
+        void profilerRegister(const char *, uint8_t *outId) override { *outId = 0; }
+        void profilerBegin(uint8_t) override {}
+        void profilerEnd(uint8_t) override {}
+        void profilerGetAll(TaskProfile *, uint8_t *count) override { *count = 0; }
+};
+
+// Receiving node, a bare libcanard instance that counts the payload it gets
+class StreamSink {
+    public:
+        explicit StreamSink(VirtualCANBus &bus) : pool{} {
+            canardInit(&canard, pool, sizeof(pool), &StreamSink::onReception, &StreamSink::shouldAccept, this);
+            canardSetLocalNodeID(&canard, 100);
+            bus.addPort([this](const CANFrame_t &frame) { receive(frame); });
+        }
+
+        uint64_t payloadBytes = 0;
+
+    private:
+        CanardInstance canard;
+        alignas(8) uint8_t pool[8192];
+
+        void receive(const CANFrame_t &frame) {
+            CanardCANFrame in;
+            in.id = frame.id | CANARD_CAN_FRAME_EFF;
+            in.data_len = frame.len;
+            in.canfd = frame.fd;
+            memcpy(in.data, frame.data, frame.len);
+            canardHandleRxFrame(&canard, &in, 1000000ULL);
+        }
+
+        static bool shouldAccept(const CanardInstance *, uint64_t *signature, uint16_t dataTypeId, CanardTransferType, uint8_t) {
+            *signature = STREAM_SIGNATURE;
+            return dataTypeId == STREAM_DATA_TYPE_ID;
+        }
+
+        static void onReception(CanardInstance *ins, CanardRxTransfer *transfer) {
+            static_cast<StreamSink *>(canardGetUserReference(ins))->payloadBytes += transfer->payload_len;
+            canardReleaseRxTransferPayload(ins, transfer);
+        }
+};
+
+// One bus task wake, then one more per TX complete until the transfer is out
+static void drain(VirtualCANBus &bus, CANController &controller) {
+    controller.routineTasks();
+    while (bus.step() > 0) {
+        controller.routineTasks();
+    }
+}
+
+// Payload bytes per second through the controller, the virtual bus and a receiving node.
+// wire_kbps is the payload rate a saturated bus would carry, 1 Mbit/s arbitration and 4 Mbit/s FD data.
+// Args: CAN FD, transfer payload bytes
+static void BM_CanPayloadThroughput(benchmark::State &state) {
+    const bool fd = state.range(0) != 0;
+    const uint16_t payloadLen = static_cast<uint16_t>(state.range(1));
+
+    BenchSystemUtils systemUtils;
+    VirtualCANBus bus;
+    VirtualCANBus::Port &port = bus.addPort(nullptr);
+    CANController controller(&port, &systemUtils);
+    controller.setFdTransmit(fd);
+    StreamSink sink(bus);
+    drain(bus, controller);
+
+    std::vector<uint8_t> payload(payloadLen);
+    for (uint16_t i = 0; i < payloadLen; i++) {
+        payload[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    uint8_t transferId = 0;
+    const uint32_t startFrames = bus.getFramesOnWire();
+    const uint64_t startBits = bus.getBitsOnWire();
+    sink.payloadBytes = 0;
+
+    for (auto _ : state) {
+        controller.broadcast(CanardTransferTypeBroadcast, STREAM_SIGNATURE, STREAM_DATA_TYPE_ID, &transferId,
+            CANARD_TRANSFER_PRIORITY_LOWEST, payload.data(), payloadLen, fd, !fd);
+        drain(bus, controller);
+    }
+
+    // FD receivers also count the padding of the last frame, so only a shortfall means lost transfers
+    if (sink.payloadBytes < static_cast<uint64_t>(state.iterations()) * payloadLen) {
+        state.SkipWithError("transfers lost on the virtual bus");
+        return;
+    }
+
+    state.SetBytesProcessed(state.iterations() * payloadLen);
+    const double wireSeconds = static_cast<double>(bus.getBitsOnWire() - startBits) / CAN_BITRATE_BPS;
+    state.counters["wire_kbps"] = state.iterations() * payloadLen * 8.0 / wireSeconds / 1000.0;
+    state.counters["frames"] = static_cast<double>(bus.getFramesOnWire() - startFrames) / state.iterations();
+}
+
+// Wire frames per second the bus task gets through while a peer floods traffic it has no use for.
+// Args: filter elements on the controller side, 8 fits the filter table, 1 falls back to receiving everything
+static void BM_CanUnwantedTraffic(benchmark::State &state) {
+    BenchSystemUtils systemUtils;
+    VirtualCANBus bus;
+    CANController *controller = nullptr;
+    VirtualCANBus::Port &port = bus.addPort([&controller](const CANFrame_t &frame) {
+        controller->enqueueRxFrame(frame.id, frame.len, frame.data, frame.fd);
+    }, 3, static_cast<uint8_t>(state.range(0)));
+    CANController bench(&port, &systemUtils);
+    controller = &bench;
+    VirtualCANBus::Port &peer = bus.addPort(nullptr);
+    drain(bus, bench);
+
+    // Single frame esc.Status from node 20, not wanted without an ESC status table
+    CANFrame_t frame {};
+    frame.id = (static_cast<uint32_t>(CANARD_TRANSFER_PRIORITY_MEDIUM) << 24) |
+        (static_cast<uint32_t>(UAVCAN_EQUIPMENT_ESC_STATUS_ID) << 8) | 20U;
+    frame.len = 8;
+
+    const uint32_t startFrames = bus.getFramesOnWire();
+    for (auto _ : state) {
+        for (uint8_t i = 0; i < 3; i++) {
+            frame.data[7] = static_cast<uint8_t>(0xC0U | (i & 0x1FU));
+            peer.transmit(frame);
+        }
+        bus.step();
+        bench.routineTasks();
+    }
+
+    state.SetItemsProcessed(bus.getFramesOnWire() - startFrames);
+    state.counters["rx_frames"] = static_cast<double>(bench.getStats().rxFrames) / state.iterations();
+}
+
+BENCHMARK(BM_CanPayloadThroughput)
+    ->ArgNames({"fd", "bytes"})
+    ->ArgsProduct({{0, 1}, {16, 64, 256}});
+BENCHMARK(BM_CanUnwantedTraffic)->ArgName("filters")->Arg(8)->Arg(1);
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "crsf_stream_parser.hpp"
+
+// RC channel frames with a link statistics frame after every fourth, as receivers send them
+static std::vector<uint8_t> makeCrsfStream() {
+    uint8_t channels[CRSF_RC_CHANNELS_PAYLOAD_LEN];
+    uint8_t link[CRSF_LINK_STATISTICS_PAYLOAD_LEN] = {60, 62, 100, 8, 0, 7, 3, 55, 100, 6};
+    uint8_t frame[CRSF_MAX_FRAME_LEN];
+
+    std::vector<uint8_t> stream;
+    for (int i = 0; i < 64; i++) {
+        for (uint8_t b = 0; b < sizeof(channels); b++) channels[b] = (uint8_t)(i * 7 + b);
+        uint8_t len = CrsfStreamParser::encodeFrame(CRSF_FRAMETYPE_RC_CHANNELS_PACKED, channels, sizeof(channels), frame, sizeof(frame));
+        stream.insert(stream.end(), frame, frame + len);
+
+        if (i % 4 == 3) {
+            len = CrsfStreamParser::encodeFrame(CRSF_FRAMETYPE_LINK_STATISTICS, link, sizeof(link), frame, sizeof(frame));
+            stream.insert(stream.end(), frame, frame + len);
+        }
+    }
+    return stream;
+}
+
+// Bytes per second through the parser, arg is the feed chunk size (DMA event size)
+static void BM_CrsfStreamParser(benchmark::State &state) {
+    static const std::vector<uint8_t> stream = makeCrsfStream();
+    CrsfStreamParser parser;
+    const uint16_t chunk = static_cast<uint16_t>(state.range(0));
+    uint16_t channels[CRSF_CHANNEL_COUNT];
+
+    for (auto _ : state) {
+        for (size_t pos = 0; pos < stream.size(); pos += chunk) {
+            size_t len = (pos + chunk <= stream.size()) ? chunk : stream.size() - pos;
+            parser.feed(stream.data() + pos, (uint16_t)len);
+        }
+        benchmark::DoNotOptimize(parser.takeChannels(channels));
+    }
+
+    state.SetBytesProcessed(state.iterations() * stream.size());
+}
+
+// Table driven CRC8 over a full size frame
+static void BM_CrsfCrc8(benchmark::State &state) {
+    uint8_t data[CRSF_MAX_FRAME_LEN - 3];
+    for (uint8_t i = 0; i < sizeof(data); i++) data[i] = (uint8_t)(i * 31);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CrsfStreamParser::crc8(data, sizeof(data)));
+    }
+
+    state.SetBytesProcessed(state.iterations() * sizeof(data));
+}
+
+BENCHMARK(BM_CrsfStreamParser)->Arg(1)->Arg(26)->Arg(64);
+BENCHMARK(BM_CrsfCrc8);
@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include "dshot_codec.hpp"
+
+// Frames per second through the per bit loop the boards used before the lookup table
+static void BM_DshotEncodeBitLoop(benchmark::State &state) {
+    uint16_t buf[DSHOT_FRAME_SLOTS];
+    uint16_t value = DSHOT_THROTTLE_MIN;
+
+    for (auto _ : state) {
+        uint16_t frame = DshotCodec::encodeFrame(value, false, false);
+        DshotCodec::frameToCompare(frame, 600, 300, buf);
+        benchmark::DoNotOptimize(buf);
+        value = (value >= DSHOT_VALUE_MAX) ? DSHOT_THROTTLE_MIN : value + 1;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Frames per second through the nibble table, single channel
+static void BM_DshotEncodeTable(benchmark::State &state) {
+    DshotCompareTable table;
+    table.build(600, 300);
+    uint16_t buf[DSHOT_FRAME_SLOTS];
+    uint16_t value = DSHOT_THROTTLE_MIN;
+
+    for (auto _ : state) {
+        uint16_t frame = DshotCodec::encodeFrame(value, false, false);
+        table.frameToCompare(frame, buf);
+        benchmark::DoNotOptimize(buf);
+        value = (value >= DSHOT_VALUE_MAX) ? DSHOT_THROTTLE_MIN : value + 1;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Four motors interleaved into one burst buffer, items are frames
+static void BM_DshotEncodeBurst4(benchmark::State &state) {
+    DshotCompareTable table;
+    table.build(600, 300);
+    uint16_t buf[DSHOT_FRAME_SLOTS * 4];
+    uint16_t value = DSHOT_THROTTLE_MIN;
+
+    for (auto _ : state) {
+        for (uint8_t motor = 0; motor < 4; motor++) {
+            uint16_t throttle = DshotCodec::scaleThrottle((uint16_t)(value + motor * 97), 0xFFFF, DSHOT_THROTTLE_MIN);
+            table.frameToCompare(DshotCodec::encodeFrame(throttle, false, true), &buf[motor], 4);
+        }
+        benchmark::DoNotOptimize(buf);
+        value += 13;
+    }
+
+    state.SetItemsProcessed(state.iterations() * 4);
+}
+
+BENCHMARK(BM_DshotEncodeBitLoop);
+BENCHMARK(BM_DshotEncodeTable);
+BENCHMARK(BM_DshotEncodeBurst4);
@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include "fft_harmonic_notch.hpp"
+#include "host_fft.hpp"
+#include "host_mathutils.hpp"
+
+static constexpr float SAMPLE_HZ = 1000.0f; // Notch runs at the decimated control rate
+
+// Gyro with a motor tone and its first harmonic, built once so only the notch is timed
+static constexpr int SWEEP_STEPS = 1024;
+struct GyroSweep {
+    float x[SWEEP_STEPS];
+    float y[SWEEP_STEPS];
+    float z[SWEEP_STEPS];
+
+    GyroSweep() {
+        for (int i = 0; i < SWEEP_STEPS; i++) {
+            float t = i / SAMPLE_HZ;
+            float tone = 0.3f * sinf(2.0f * M_PI * 125.0f * t) + 0.1f * sinf(2.0f * M_PI * 250.0f * t);
+            x[i] = 0.05f * sinf(0.01f * i) + tone;
+            y[i] = -0.02f + 0.5f * tone;
+            z[i] = 0.01f + 0.2f * tone;
+        }
+    }
+};
+static const GyroSweep SWEEP;
+
+static FFTHarmonicNotchConfig notchConfig(HarmonicNotchMode_e mode, uint16_t window, uint8_t harmonicsMask) {
+    return {true, mode, window, SAMPLE_HZ, 80.0f, 30.0f, 30.0f, harmonicsMask};
+}
+
+// Arg: FFT window length. Per sample cost with the windowed FFT, peak search and retune amortized
+// over the window, the AM pays the whole FFT on the tick that fills it
+static void BM_NotchPushSample(benchmark::State &state) {
+    const uint16_t window = state.range(0);
+    HostMathUtils math;
+    HostFFT fft;
+    FFTHarmonicNotch notch(&math, &fft);
+    if (!notch.init(notchConfig(HarmonicNotchMode_e::FFT, window, 0x07))) {
+        state.SkipWithError("notch init failed");
+        return;
+    }
+
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(notch.pushSample(SWEEP.x[i], SWEEP.y[i], SWEEP.z[i]));
+        i = (i + 1) % SWEEP_STEPS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_NotchPushSample)->ArgName("window")->Arg(256)->Arg(512)->Arg(1024);
+
+// Arg: harmonics mask. Four motors place one notch per enabled harmonic each, so the cascade
+// holds 4, 8 or 16 live biquads on all three axes
+static void BM_NotchApply(benchmark::State &state) {
+    const uint8_t mask = state.range(0);
+    HostMathUtils math;
+    FFTHarmonicNotch notch(&math, nullptr);
+    if (!notch.init(notchConfig(HarmonicNotchMode_e::ESC_RPM, 256, mask))) {
+        state.SkipWithError("notch init failed");
+        return;
+    }
+    const float motorHz[4] = {92.0f, 96.0f, 101.0f, 105.0f};
+    notch.updateFromMotorFreqs(motorHz, 4);
+
+    int i = 0;
+    for (auto _ : state) {
+        float gx = SWEEP.x[i], gy = SWEEP.y[i], gz = SWEEP.z[i];
+        notch.apply(gx, gy, gz);
+        benchmark::DoNotOptimize(gx);
+        benchmark::DoNotOptimize(gy);
+        benchmark::DoNotOptimize(gz);
+        i = (i + 1) % SWEEP_STEPS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_NotchApply)->ArgName("harmonics")->Arg(0x01)->Arg(0x03)->Arg(0x0F);
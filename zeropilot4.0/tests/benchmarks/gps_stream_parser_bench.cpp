@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <vector>
+#include "gps_stream_parser.hpp"
+
+static std::vector<uint8_t> makeUBXStream() {
+    uint8_t payload[92] = {};
+    payload[11] = 0x07;
+    payload[20] = 3;
+    payload[21] = 0x01;
+    payload[23] = 12;
+
+    std::vector<uint8_t> stream;
+    uint8_t frame[100];
+    for (int i = 0; i < 64; i++) {
+        payload[24] = (uint8_t)i;
+        uint16_t len = GpsStreamParser::encodeUBX(0x01, 0x07, payload, sizeof(payload), frame, sizeof(frame));
+        stream.insert(stream.end(), frame, frame + len);
+    }
+    return stream;
+}
+
+static std::vector<uint8_t> makeNMEAStream() {
+    const char *sentences[] = {
+        "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n",
+        "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n"
+    };
+    std::vector<uint8_t> stream;
+    for (int i = 0; i < 64; i++) {
+        const char *s = sentences[i % 2];
+        while (*s) stream.push_back((uint8_t)*s++);
+    }
+    return stream;
+}
+
+// Bytes per second through the parser, arg is the feed chunk size (DMA event size)
+static void runParser(benchmark::State &state, const std::vector<uint8_t> &stream) {
+    GpsStreamParser parser;
+    const uint16_t chunk = static_cast<uint16_t>(state.range(0));
+
+    for (auto _ : state) {
+        for (size_t pos = 0; pos < stream.size(); pos += chunk) {
+            size_t len = (pos + chunk <= stream.size()) ? chunk : stream.size() - pos;
+            parser.feed(stream.data() + pos, (uint16_t)len);
+        }
+        benchmark::DoNotOptimize(parser.takeData());
+    }
+
+    state.SetBytesProcessed(state.iterations() * stream.size());
+}
+
+static void BM_GpsStreamParserUBX(benchmark::State &state) {
+    static const std::vector<uint8_t> stream = makeUBXStream();
+    runParser(state, stream);
+}
+
+static void BM_GpsStreamParserNMEA(benchmark::State &state) {
+    static const std::vector<uint8_t> stream = makeNMEAStream();
+    runParser(state, stream);
+}
+
+BENCHMARK(BM_GpsStreamParserUBX)->Arg(1)->Arg(64)->Arg(1024);
+BENCHMARK(BM_GpsStreamParserNMEA)->Arg(1)->Arg(64)->Arg(1024);
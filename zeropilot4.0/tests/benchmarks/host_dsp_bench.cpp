@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+#include "host_fft.hpp"
+#include "host_mathutils.hpp"
+
+// The plain triple loop SITL_MathUtils used before the host backend, kept to compare against
+static void naiveMatrixMult(const float* srcA, uint16_t rowsA, uint16_t colsA,
+                            const float* srcB, uint16_t colsB, float* dst) {
+    for (uint16_t r = 0; r < rowsA; ++r) {
+        for (uint16_t c = 0; c < colsB; ++c) {
+            float sum = 0.0f;
+            for (uint16_t k = 0; k < colsA; ++k) {
+                sum += srcA[r * colsA + k] * srcB[k * colsB + c];
+            }
+            dst[r * colsB + c] = sum;
+        }
+    }
+}
+
+static std::vector<float> sweepMatrix(uint32_t n, float phase) {
+    std::vector<float> m(n);
+    for (uint32_t i = 0; i < n; ++i) m[i] = sinf(0.37f * i + phase);
+    return m;
+}
+
+// Args: rows of A, cols of A, cols of B
+static void BM_NaiveMatrixMult(benchmark::State &state) {
+    const uint16_t rowsA = state.range(0), colsA = state.range(1), colsB = state.range(2);
+    std::vector<float> a = sweepMatrix(rowsA * colsA, 0.0f);
+    std::vector<float> b = sweepMatrix(colsA * colsB, 1.0f);
+    std::vector<float> dst(rowsA * colsB);
+
+    for (auto _ : state) {
+        naiveMatrixMult(a.data(), rowsA, colsA, b.data(), colsB, dst.data());
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Through the interface, the way the attitude filters call it
+static void BM_HostMatrixMult(benchmark::State &state) {
+    const uint16_t rowsA = state.range(0), colsA = state.range(1), colsB = state.range(2);
+    std::vector<float> a = sweepMatrix(rowsA * colsA, 0.0f);
+    std::vector<float> b = sweepMatrix(colsA * colsB, 1.0f);
+    std::vector<float> dst(rowsA * colsB);
+    HostMathUtils host;
+    IMathUtils *math = &host;
+
+    for (auto _ : state) {
+        math->matrixMult(a.data(), rowsA, colsA, b.data(), colsB, dst.data());
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define MULT_SHAPES(bench) \
+    BENCHMARK(bench)->ArgNames({"rows", "inner", "cols"}) \
+        ->Args({3, 3, 3})->Args({3, 3, 1})->Args({1, 3, 3})->Args({4, 4, 1}) \
+        ->Args({9, 9, 9})->Args({18, 18, 18})
+MULT_SHAPES(BM_NaiveMatrixMult);
+MULT_SHAPES(BM_HostMatrixMult);
+
+// Arg: dimension
+static void BM_HostMatrixInverse(benchmark::State &state) {
+    const uint16_t dim = state.range(0);
+    std::vector<float> a = sweepMatrix(dim * dim, 0.0f);
+    for (uint16_t i = 0; i < dim; ++i) a[i * dim + i] += dim;
+    std::vector<float> inv(dim * dim);
+    HostMathUtils math;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(math.matrixInverse(a.data(), dim, inv.data()));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HostMatrixInverse)->ArgName("dim")->Arg(3)->Arg(9);
+
+static void BM_HostQuatRotateVector(benchmark::State &state) {
+    HostMathUtils math;
+    const float q[4] = {0.9f, 0.1f, -0.3f, 0.2f};
+    float v[3] = {1.0f, 2.0f, 3.0f};
+
+    for (auto _ : state) {
+        math.quatRotateVector(q, v, v);
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HostQuatRotateVector);
+
+// Arg: FFT length. Forward transform plus magnitudes, as the harmonic notch runs it
+static void BM_HostFFT(benchmark::State &state) {
+    const uint16_t n = state.range(0);
+    HostFFT fft;
+    if (!fft.init(n)) {
+        state.SkipWithError("unsupported length");
+        return;
+    }
+
+    std::vector<float> in = sweepMatrix(n, 0.0f);
+    std::vector<float> out(n), mag(n / 2);
+    for (auto _ : state) {
+        fft.runFFT(in.data(), out.data(), 0);
+        fft.complexMag(out.data(), mag.data(), n / 2);
+        benchmark::DoNotOptimize(mag.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * n * sizeof(float));
+}
+BENCHMARK(BM_HostFFT)->ArgName("length")->Arg(256)->Arg(512)->Arg(1024)->Arg(4096);
@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include "imu_decimator.hpp"
+
+// Input samples per second through the decimator, args: filter type, input ODR (Hz), output rate (Hz)
+static void BM_ImuDecimator(benchmark::State &state) {
+    const DecimationFilter_e filter = static_cast<DecimationFilter_e>(state.range(0));
+    const float odrHz = static_cast<float>(state.range(1));
+    const float outputHz = static_cast<float>(state.range(2));
+    const uint16_t batchSize = static_cast<uint16_t>(odrHz / outputHz);
+
+    ImuDecimator decimator;
+    decimator.init({filter, odrHz, outputHz});
+
+    ScaledImu_t samples[ImuDecimator::MAX_FACTOR];
+    for (uint16_t i = 0; i < batchSize; i++) {
+        samples[i] = {0.1f * i, -0.2f * i, -9.81f, std::sin(0.3f * i), std::cos(0.3f * i), 0.01f * i, 0, 0};
+    }
+
+    uint64_t timestampUs = 0;
+    for (auto _ : state) {
+        for (uint16_t i = 0; i < batchSize; i++) {
+            samples[i].timestampUs = ++timestampUs;
+        }
+        ScaledImuBatch_t out = decimator.process({samples, batchSize, 0});
+        benchmark::DoNotOptimize(out.data[0].xgyro);
+    }
+
+    state.SetItemsProcessed(state.iterations() * batchSize);
+    state.counters["group_delay_us"] = decimator.getGroupDelayS() * 1e6f;
+}
+
+BENCHMARK(BM_ImuDecimator)
+    ->ArgNames({"filter", "odr", "rate"})
+    ->ArgsProduct({
+        {static_cast<int>(DecimationFilter_e::NONE), static_cast<int>(DecimationFilter_e::FIR), static_cast<int>(DecimationFilter_e::CIC)},
+        {2000, 8000},
+        {500, 1000}
+    });
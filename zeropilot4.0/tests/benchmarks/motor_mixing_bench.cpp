@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include "motor_mixing.hpp"
+
+#ifdef QUADCOPTER
+// The hard-wired quad X mixer the frame table replaced, kept to compare against
+static void legacyQuadMix(float roll, float pitch, float yaw, float throttle, float *mixed) {
+    static constexpr uint8_t NUM_MOTORS = 4;
+    static constexpr float ARM_AXIS_PROJECTION = 0.7071067811865476f;
+    static constexpr float ROLL_FACTOR[NUM_MOTORS] = { -ARM_AXIS_PROJECTION, ARM_AXIS_PROJECTION, ARM_AXIS_PROJECTION, -ARM_AXIS_PROJECTION};
+    static constexpr float PITCH_FACTOR[NUM_MOTORS] = { ARM_AXIS_PROJECTION, -ARM_AXIS_PROJECTION, ARM_AXIS_PROJECTION, -ARM_AXIS_PROJECTION};
+    static constexpr float YAW_FACTOR[NUM_MOTORS] = { 1, 1, -1, -1};
+    static constexpr float YAW_HEADROOM = 0.2f;
+
+    float throttleAvgMax = throttle;
+    float idealThrottle = fminf(0.5f, throttleAvgMax);
+
+    float yawAllowed = 1.0f;
+    for (int i = 0; i < NUM_MOTORS; i++) {
+        mixed[i] = roll * ROLL_FACTOR[i] + pitch * PITCH_FACTOR[i];
+        float predictedMotorThrust = idealThrottle + mixed[i];
+        float motorRoom = (yaw * YAW_FACTOR[i] >= 0) ? 1.0f - predictedMotorThrust : predictedMotorThrust;
+        yawAllowed = fminf(yawAllowed, fmaxf(motorRoom, 0));
+    }
+
+    yawAllowed = fmaxf(YAW_HEADROOM, yawAllowed);
+    if (fabsf(yaw) > yawAllowed) {
+        yaw = fmaxf(-yawAllowed, fminf(yaw, yawAllowed));
+    }
+
+    float rpyMax = 0.0f;
+    float rpyMin = 1.0f;
+    for (int i = 0; i < NUM_MOTORS; i++) {
+        mixed[i] += yaw * YAW_FACTOR[i];
+        rpyMax = fmaxf(rpyMax, mixed[i]);
+        rpyMin = fminf(rpyMin, mixed[i]);
+    }
+
+    float rpyScale = 1.0f;
+    if (rpyMax - rpyMin >= 1.0f) {
+        rpyScale = 1.0f / (rpyMax - rpyMin);
+    }
+    if (throttleAvgMax + rpyMin < 0.0f) {
+        rpyScale = fminf(rpyScale, fabsf(throttleAvgMax / rpyMin));
+    }
+    rpyMax *= rpyScale;
+    rpyMin *= rpyScale;
+
+    float minThrottle = fabsf(rpyMin);
+    float throttleAdj = throttle - minThrottle;
+    if (rpyScale < 1.0f) {
+        throttleAdj = 0.0f;
+    } else if (throttleAdj < 0.0f) {
+        throttleAdj = 0.0f;
+    } else if (throttleAdj > (1.0f - minThrottle - rpyMax)) {
+        throttleAdj = 1.0f - minThrottle - rpyMax;
+    }
+    float finalThrottle = minThrottle + throttleAdj;
+
+    for (int i = 0; i < NUM_MOTORS; i++) {
+        mixed[i] = finalThrottle + rpyScale * mixed[i];
+    }
+}
+
+// Stick sweep that crosses the saturated and unsaturated paths, built once so only the mix is timed
+static constexpr int SWEEP_STEPS = 64;
+struct StickSweep {
+    float roll[SWEEP_STEPS];
+    float pitch[SWEEP_STEPS];
+    float yaw[SWEEP_STEPS];
+    float throttle[SWEEP_STEPS];
+
+    StickSweep() {
+        for (int i = 0; i < SWEEP_STEPS; i++) {
+            roll[i] = sinf(0.37f * i);
+            pitch[i] = sinf(0.37f * i + 1.0f);
+            yaw[i] = sinf(0.37f * i + 2.0f);
+            throttle[i] = 0.5f + 0.5f * sinf(0.37f * i + 3.0f);
+        }
+    }
+};
+static const StickSweep SWEEP;
+
+static void BM_LegacyQuadMixer(benchmark::State &state) {
+    float mixed[4];
+    int i = 0;
+    for (auto _ : state) {
+        legacyQuadMix(SWEEP.roll[i], SWEEP.pitch[i], SWEEP.yaw[i], SWEEP.throttle[i], mixed);
+        benchmark::DoNotOptimize(mixed);
+        i = (i + 1) % SWEEP_STEPS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LegacyQuadMixer);
+
+// Args: FRAME_CLASS, FRAME_TYPE
+static void BM_FrameMixer(benchmark::State &state) {
+    const MixerFrame_t *frame = MotorMixing::frameFor(static_cast<FrameClass_e>(state.range(0)), static_cast<FrameType_e>(state.range(1)));
+    if (frame == nullptr) {
+        state.SkipWithError("no frame table");
+        return;
+    }
+
+    float mixed[MIXER_MAX_MOTORS];
+    int i = 0;
+    for (auto _ : state) {
+        MotorMixing::mixFrame(*frame, SWEEP.roll[i], SWEEP.pitch[i], SWEEP.yaw[i], SWEEP.throttle[i], mixed);
+        benchmark::DoNotOptimize(mixed);
+        i = (i + 1) % SWEEP_STEPS;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["motors"] = frame->motorCount;
+}
+BENCHMARK(BM_FrameMixer)
+    ->ArgNames({"class", "type"})
+    ->Args({static_cast<int>(FrameClass_e::QUAD), static_cast<int>(FrameType_e::X)})
+    ->Args({static_cast<int>(FrameClass_e::HEXA), static_cast<int>(FrameType_e::X)})
+    ->Args({static_cast<int>(FrameClass_e::OCTA), static_cast<int>(FrameType_e::X)})
+    ->Args({static_cast<int>(FrameClass_e::Y6), static_cast<int>(FrameType_e::X)});
+#endif
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include "pid.hpp"
+#include "pid3.hpp"
+
+static constexpr float DT = 0.001f;
+
+// Gyro-like measurements built once so only the controller update is timed
+static constexpr int SWEEP_STEPS = 64;
+struct RateSweep {
+    float setpoint[SWEEP_STEPS][PID3_AXES];
+    float measurement[SWEEP_STEPS][PID3_AXES];
+
+    RateSweep() {
+        for (int i = 0; i < SWEEP_STEPS; i++) {
+            for (int axis = 0; axis < PID3_AXES; axis++) {
+                setpoint[i][axis] = 90.0f * sinf(0.11f * i + axis);
+                measurement[i][axis] = 85.0f * sinf(0.11f * i + axis - 0.2f) + 3.0f * sinf(2.3f * i);
+            }
+        }
+    }
+};
+static const RateSweep SWEEP;
+
+static void BM_PIDOutput(benchmark::State &state) {
+    PID pid(0.14f, 0.14f, 0.0025f, 0.02f, -1.0f, 1.0f, 50, DT);
+    pid.pidInitState();
+
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pid.pidOutput(SWEEP.setpoint[i][0], SWEEP.measurement[i][0]));
+        i = (i + 1) % SWEEP_STEPS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PIDOutput);
+
+static void BM_ThreeScalarPIDs(benchmark::State &state) {
+    PID pids[PID3_AXES] = {
+        PID(0.14f, 0.14f, 0.0025f, 0.02f, -1.0f, 1.0f, 50, DT),
+        PID(0.14f, 0.14f, 0.0025f, 0.02f, -1.0f, 1.0f, 50, DT),
+        PID(0.34f, 0.34f, 0.0f, 0.02f, -1.0f, 1.0f, 50, DT),
+    };
+    for (PID &pid : pids) pid.pidInitState();
+
+    float out[PID3_AXES];
+    int i = 0;
+    for (auto _ : state) {
+        for (int axis = 0; axis < PID3_AXES; axis++) {
+            out[axis] = pids[axis].pidOutput(SWEEP.setpoint[i][axis], SWEEP.measurement[i][axis]);
+        }
+        benchmark::DoNotOptimize(out);
+        i = (i + 1) % SWEEP_STEPS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ThreeScalarPIDs);
+
+// Arg: D-term low-pass cutoff in Hz, 0 keeps the tau filter
+static void BM_PID3(benchmark::State &state) {
+    PID3 pid(-1.0f, 1.0f, DT);
+    pid.setConstants(PIDAxis_e::ROLL, 0.14f, 0.14f, 0.0025f, 0.02f, 50);
+    pid.setConstants(PIDAxis_e::PITCH, 0.14f, 0.14f, 0.0025f, 0.02f, 50);
+    pid.setConstants(PIDAxis_e::YAW, 0.34f, 0.34f, 0.0f, 0.02f, 50);
+    for (int axis = 0; axis < PID3_AXES; axis++) {
+        pid.setDtermLpfHz(static_cast<PIDAxis_e>(axis), static_cast<float>(state.range(0)));
+    }
+
+    float out[PID3_AXES];
+    int i = 0;
+    for (auto _ : state) {
+        pid.update(SWEEP.setpoint[i], SWEEP.measurement[i], out);
+        benchmark::DoNotOptimize(out);
+        i = (i + 1) % SWEEP_STEPS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PID3)->ArgName("dlpf")->Arg(0)->Arg(40);
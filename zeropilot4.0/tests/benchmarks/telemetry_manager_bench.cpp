@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+#include "telemetry_manager.hpp"
+#include "zp_params.hpp"
+#include "bench_drivers.hpp"
+
+static constexpr int TM_QUEUE_DEPTH = 16;     // tmQueueId on the board
+static constexpr int PACKED_QUEUE_DEPTH = 16; // messageBufferId on the board
+
+// What the AM and SM push at their telemetry rates, cycled by the always full TM queue
+static std::vector<TMMessage_t> managerTraffic() {
+    const uint16_t servos[16] = {1500, 1500, 1500, 1100, 1000, 1000};
+    std::vector<TMMessage_t> msgs;
+    for (uint32_t t = 0; t < 4; t++) {
+        msgs.push_back(heartbeatPack(t, MAV_MODE_FLAG_SAFETY_ARMED, 0, MAV_STATE_ACTIVE));
+        msgs.push_back(attitudeDataPack(t, 0.1f, -0.05f, 1.2f));
+        msgs.push_back(rawImuDataPack(t, 12, -40, -1000, 3, -2, 1));
+        msgs.push_back(servoOutputRawPack(t, 0, servos));
+    }
+    msgs.push_back(gpsRawDataPack(4, 3, 436532000, -793832000, 100000, 100, 100, 500, 9000, 8));
+    msgs.push_back(scaledPressurePack(4, 101.3f, 0.0f, 25.0f, 0.0f));
+    return msgs;
+}
+
+// Ground station uplink: heartbeats and parameter reads by name, as many whole frames as one
+// receive() takes
+static std::vector<uint8_t> groundStationStream() {
+    static const char *const PARAM_NAMES[] = {"SCHED_LOOP_RATE", "INS_HNTCH_BW", "RC_FS_TIMEOUT", "SERVO4_FUNCTION"};
+    std::vector<uint8_t> stream;
+    uint8_t frame[MAVLINK_MAX_PACKET_LEN];
+
+    for (int i = 0;; i++) {
+        mavlink_message_t msg;
+        if (i % 2 == 0) {
+            mavlink_msg_heartbeat_pack(255, 190, &msg, MAV_TYPE_GCS, MAV_AUTOPILOT_INVALID, 0, 0, MAV_STATE_ACTIVE);
+        } else {
+            mavlink_msg_param_request_read_pack(255, 190, &msg, 1, 1, PARAM_NAMES[(i / 2) % 4], -1);
+        }
+
+        uint16_t len = mavlink_msg_to_send_buffer(frame, &msg);
+        if (stream.size() + len > TM_MAX_RX_BYTES) break;
+        stream.insert(stream.end(), frame, frame + len);
+    }
+    return stream;
+}
+
+// Every update drains a full TM queue into MAVLink frames, the packed buffer stays backed up
+// against the link budget the way it does when the radio is saturated
+static void BM_TelemetryManagerUpdateFullQueue(benchmark::State &state) {
+    const std::vector<TMMessage_t> traffic = managerTraffic();
+    ParamRegistry params;
+    BenchSystemUtils systemUtils;
+    BenchTelemLink link(nullptr, 0);
+    BenchReplayQueue<TMMessage_t, TM_QUEUE_DEPTH> tmQueue(traffic.data(), traffic.size());
+    BenchSinkQueue<RCMotorControlMessage_t> amQueue;
+    BenchQueue<mavlink_message_t, PACKED_QUEUE_DEPTH> packedQueue;
+
+    auto tm = std::make_unique<TelemetryManager>(&systemUtils, &link, &tmQueue, &amQueue, &packedQueue, &params);
+
+    for (auto _ : state) {
+        tm->tmUpdate();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * TM_QUEUE_DEPTH);
+}
+BENCHMARK(BM_TelemetryManagerUpdateFullQueue);
+
+// A full receive window of uplink through tmUpdate(), including the parameter lookups and
+// PARAM_VALUE replies it triggers
+static void BM_TelemetryManagerReceive(benchmark::State &state) {
+    const std::vector<uint8_t> stream = groundStationStream();
+    ParamRegistry params;
+    BenchSystemUtils systemUtils;
+    BenchTelemLink link(stream.data(), stream.size());
+    BenchQueue<TMMessage_t, TM_QUEUE_DEPTH> tmQueue;
+    BenchSinkQueue<RCMotorControlMessage_t> amQueue;
+    BenchQueue<mavlink_message_t, PACKED_QUEUE_DEPTH> packedQueue;
+
+    auto tm = std::make_unique<TelemetryManager>(&systemUtils, &link, &tmQueue, &amQueue, &packedQueue, &params);
+
+    for (auto _ : state) {
+        tm->tmUpdate();
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * stream.size());
+}
+BENCHMARK(BM_TelemetryManagerReceive);
+
+// The framing state machine alone, byte at a time as TelemetryManager::receive() feeds it
+static void BM_MavlinkFrameParse(benchmark::State &state) {
+    const std::vector<uint8_t> stream = groundStationStream();
+    mavlink_message_t parseBuffer{};
+    mavlink_status_t parseStatus{};
+    mavlink_status_t status{};
+    mavlink_message_t msg{};
+
+    int64_t frames = 0;
+    for (auto _ : state) {
+        for (uint8_t byte : stream) {
+            if (mavlink_frame_char_buffer(&parseBuffer, &parseStatus, byte, &msg, &status) == MAVLINK_FRAMING_OK) {
+                frames++;
+            }
+        }
+        benchmark::DoNotOptimize(msg.msgid);
+    }
+    state.SetBytesProcessed(state.iterations() * stream.size());
+    state.counters["frames"] = benchmark::Counter(frames, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_MavlinkFrameParse);
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include "zp_params.hpp"
+
+// Typed read by id, what the managers do in their update loops
+static void BM_ParamGet(benchmark::State &state) {
+    ParamRegistry params;
+    const ZP_PARAM_ID ids[4] = {ZP_PARAM_ID::RC_FS_TIMEOUT, ZP_PARAM_ID::SCHED_LOOP_RATE, ZP_PARAM_ID::INS_HNTCH_BW, ZP_PARAM_ID::FFT_MINHZ};
+
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(params.get(ids[i]));
+        i = (i + 1) & 3;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParamGet);
+
+// Arg: table index of the name looked up. Lookups by name scan the table, as PARAM_REQUEST_READ
+// and PARAM_SET from a ground station do
+static void BM_ParamIndexById(benchmark::State &state) {
+    ParamRegistry params;
+    const uint16_t index = state.range(0) < ParamRegistry::getCount() ? state.range(0) : ParamRegistry::getCount() - 1;
+    const char *name = params.getParamByIndex(index)->paramId;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(params.getIndexById(name));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParamIndexById)->ArgName("index")->Arg(0)->Arg(64)->Arg(ParamRegistry::getCount() - 1);
+
+// A name matching nothing walks the whole table
+static void BM_ParamIndexByIdMiss(benchmark::State &state) {
+    ParamRegistry params;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(params.getIndexById("NO_SUCH_PARAM"));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParamIndexByIdMiss);
+
+static void BM_ParamSetById(benchmark::State &state) {
+    ParamRegistry params;
+    const char *name = params.getParamByIndex(ParamRegistry::getCount() - 1)->paramId;
+    float value = 0.0f;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(params.setParamById(name, value));
+        value += 1.0f;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParamSetById);
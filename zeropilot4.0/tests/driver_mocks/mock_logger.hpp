@@ -7,4 +7,5 @@ class MockLogger : public ILogger {
 public:
     MOCK_METHOD(int, log, (const char message[100]), (override));
     MOCK_METHOD(int, log, (const char messages[][100], int count), (override));
+    MOCK_METHOD(int, logBinary, (const void *data, uint32_t len), (override));
 };
@@ -5,7 +5,16 @@
 
 class MockMotorControl : public IMotorControl {
 public:
+    // Normalized commands reach set() through the percent shim unless a test overrides it
+    MockMotorControl() {
+        ON_CALL(*this, setNormalized(::testing::_)).WillByDefault([this](float command) {
+            IMotorControl::setNormalized(command);
+        });
+    }
+
     MOCK_METHOD(void, set, (uint32_t percent), (override));
+    MOCK_METHOD(void, setNormalized, (float command), (override));
     MOCK_METHOD(void, setArm, (bool arm), (override));
+    MOCK_METHOD(bool, readErpm, (uint32_t &erpm), (override));
     void init() override {}
 };
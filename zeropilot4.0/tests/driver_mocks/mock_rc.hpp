@@ -7,4 +7,6 @@
 class MockRCReceiver : public IRCReceiver{
     public:
        MOCK_METHOD(RCControl, getRCData, (), (override));
+       MOCK_METHOD(RCLinkStats_t, getLinkStats, (), (override));
+       MOCK_METHOD(void, setTelemetry, (const RCSystemTelemetry_t &telemetry), (override));
 };
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "can_bus_iface.hpp"
+
+/*
+ * Loopback bus in the spirit of Linux vcan. Each port has a small TX FIFO like the controller
+ * hardware, step() puts everything in flight on the wire in identifier (priority) order and hands
+ * each frame to every other port's receiver whose acceptance filters pass it, standing in for the
+ * RX ISR. The bits each frame takes on the wire are counted so tests can work out latency and bus load.
+ */
+class VirtualCANBus {
+    public:
+        using Receiver = std::function<void(const CANFrame_t &frame)>;
+
+        class Port : public ICANBus {
+            public:
+                Port(Receiver receiver, size_t txFifoDepth, uint8_t filterElements) :
+                    receiver(std::move(receiver)), txFifoDepth(txFifoDepth), filterElements(filterElements),
+                    txRejected(0), filteredFrames(0) {}
+
+                bool transmit(const CANFrame_t &frame) override {
+                    if (txFifo.size() >= txFifoDepth) {
+                        txRejected++;
+                        return false;
+                    }
+                    txFifo.push_back(frame);
+                    return true;
+                }
+
+                bool setAcceptanceFilters(const CANAcceptanceFilter_t *newFilters, uint8_t count) override {
+                    filters.clear();
+                    if (count > filterElements) return false;
+                    filters.assign(newFilters, newFilters + count);
+                    return true;
+                }
+
+                bool accepts(const CANFrame_t &frame) const {
+                    if (filters.empty()) return true;
+                    for (const CANAcceptanceFilter_t &filter : filters) {
+                        if (((frame.id ^ filter.id) & filter.mask) == 0) return true;
+                    }
+                    return false;
+                }
+
+                size_t pendingTx() const { return txFifo.size(); }
+                uint32_t getTxRejected() const { return txRejected; }
+                uint32_t getFilteredFrames() const { return filteredFrames; }
+
+            private:
+                friend class VirtualCANBus;
+                Receiver receiver;
+                size_t txFifoDepth;
+                uint8_t filterElements;
+                uint32_t txRejected;
+                uint32_t filteredFrames;
+                std::vector<CANAcceptanceFilter_t> filters;
+                std::deque<CANFrame_t> txFifo;
+        };
+
+        // Extended data frame with worst case bit stuffing, plus the interframe space
+        static uint32_t frameBits(uint8_t len) {
+            const uint32_t stuffable = 54 + 8u * len;       // SOF through CRC
+            return stuffable + (stuffable - 1) / 4 + 13;    // CRC delimiter, ACK, EOF, IFS
+        }
+
+        // Data phase of an FD frame runs this many times faster than arbitration
+        static constexpr uint32_t FD_DATA_BITRATE_RATIO = CAN_FD_DATA_BITRATE_BPS / CAN_BITRATE_BPS;
+
+        // FD extended frame with bit rate switching and worst case stuffing, in nominal bit times
+        static uint32_t fdFrameBits(uint8_t len) {
+            const uint32_t arbitration = 36;                // SOF through BRS
+            const uint32_t stuffable = 5 + 8u * len;        // ESI, DLC and data
+            const uint32_t crc = len > 16 ? 21 : 17;
+            // Stuff count and CRC carry a fixed stuff bit every 4 bits, then the CRC delimiter
+            const uint32_t dataPhase = stuffable + stuffable / 4 + 4 + crc + (4 + crc + 3) / 4 + 1;
+            return arbitration + (arbitration - 1) / 4 + 12 +  // ACK, EOF, IFS
+                (dataPhase + FD_DATA_BITRATE_RATIO - 1) / FD_DATA_BITRATE_RATIO;
+        }
+
+        // filterElements is the most acceptance filters the port's controller can hold
+        Port &addPort(Receiver receiver, size_t txFifoDepth = 3, uint8_t filterElements = 8) {
+            ports.emplace_back(new Port(std::move(receiver), txFifoDepth, filterElements));
+            return *ports.back();
+        }
+
+        // Transmit every queued frame, lowest identifier first across ports. Returns the number sent.
+        size_t step() {
+            size_t sent = 0;
+            while (true) {
+                Port *winner = nullptr;
+                for (auto &port : ports) {
+                    if (!port->txFifo.empty() && (winner == nullptr || port->txFifo.front().id < winner->txFifo.front().id)) {
+                        winner = port.get();
+                    }
+                }
+                if (winner == nullptr) break;
+
+                const CANFrame_t frame = winner->txFifo.front();
+                winner->txFifo.pop_front();
+                bitsOnWire += frame.fd ? fdFrameBits(frame.len) : frameBits(frame.len);
+                for (auto &port : ports) {
+                    if (port.get() == winner || !port->receiver) continue;
+                    if (port->accepts(frame)) {
+                        port->receiver(frame);
+                    } else {
+                        port->filteredFrames++;
+                    }
+                }
+                sent++;
+                framesOnWire++;
+            }
+            return sent;
+        }
+
+        uint32_t getFramesOnWire() const { return framesOnWire; }
+        uint64_t getBitsOnWire() const { return bitsOnWire; }
+
+    private:
+        std::vector<std::unique_ptr<Port>> ports;
+        uint32_t framesOnWire = 0;
+        uint64_t bitsOnWire = 0;
+};
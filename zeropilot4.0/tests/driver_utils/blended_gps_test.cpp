@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <vector>
+#include "blended_gps.hpp"
+#include "gps_stream_parser.hpp"
+#include "mock_systemutils.hpp"
+
+using ::testing::NiceMock;
+using ::testing::ReturnPointee;
+
+static void putLE(uint8_t *payload, uint8_t offset, int32_t value, uint8_t size) {
+    for (uint8_t i = 0; i < size; i++) {
+        payload[offset + i] = (uint8_t)((uint32_t)value >> (8 * i));
+    }
+}
+
+typedef struct {
+    uint32_t iTOW;
+    int32_t latE7;
+    int32_t lonE7;
+    int32_t hMslMm;
+    int32_t velNMmS;
+    uint32_t hAccMm;
+    uint32_t vAccMm;
+} PvtSample_t;
+
+static std::vector<uint8_t> pvtFrame(const PvtSample_t &s) {
+    uint8_t payload[92] = {};
+    putLE(payload, 0, (int32_t)s.iTOW, 4);
+    payload[20] = 3;    // 3D fix
+    payload[21] = 0x01; // gnssFixOK
+    payload[23] = 12;
+    putLE(payload, 24, s.lonE7, 4);
+    putLE(payload, 28, s.latE7, 4);
+    putLE(payload, 36, s.hMslMm, 4);
+    putLE(payload, 40, (int32_t)s.hAccMm, 4);
+    putLE(payload, 44, (int32_t)s.vAccMm, 4);
+    putLE(payload, 48, s.velNMmS, 4);
+    putLE(payload, 60, s.velNMmS, 4);
+
+    std::vector<uint8_t> frame(100);
+    frame.resize(GpsStreamParser::encodeUBX(0x01, 0x07, payload, sizeof(payload), frame.data(), frame.size()));
+    return frame;
+}
+
+// Receiver replaying a UBX byte stream through the real parser
+class StreamGPS : public IGPS {
+    public:
+        GpsStreamParser parser;
+
+        void feed(const std::vector<uint8_t> &bytes) {
+            parser.feed(bytes.data(), (uint16_t)bytes.size());
+        }
+
+        GpsData_t readData() override {
+            return parser.takeData();
+        }
+};
+
+// 1e-7 deg per metre north, near enough for test tolerances
+static constexpr double E7_PER_M = 1e7 * 180.0 / (3.14159265358979 * 6378137.0);
+
+class BlendedGPSTest : public ::testing::Test {
+protected:
+    NiceMock<MockSystemUtils> sysUtils;
+    StreamGPS gps1;
+    StreamGPS gps2;
+    BlendedGPS blended{&gps1, &gps2, &sysUtils};
+    uint32_t nowMs = 1000;
+
+    void SetUp() override {
+        ON_CALL(sysUtils, getCurrentTimestampMs()).WillByDefault(ReturnPointee(&nowMs));
+    }
+};
+
+TEST_F(BlendedGPSTest, NoDataIsNotNew) {
+    EXPECT_FALSE(blended.readData().isNew);
+    EXPECT_EQ(blended.getHealthyMask(), 0);
+}
+
+TEST_F(BlendedGPSTest, SingleReceiverPassesThrough) {
+    gps2.feed(pvtFrame({1000, 435000000, -805000000, 300000, 0, 1500, 2500}));
+    GpsData_t data = blended.readData();
+    EXPECT_TRUE(data.isNew);
+    EXPECT_NEAR(data.latitude, 43.5f, 1e-5f);
+    EXPECT_NEAR(data.altitude, 300.0f, 1e-3f);
+    EXPECT_EQ(blended.getHealthyMask(), 0b10);
+    EXPECT_FLOAT_EQ(blended.getGps1Weight(), 0.0f);
+
+    // Nothing new from either receiver
+    EXPECT_FALSE(blended.readData().isNew);
+}
+
+TEST_F(BlendedGPSTest, WeightsByHorizontalAccuracy) {
+    // 1 m vs 3 m accuracy, inverse variance weights 9:1
+    gps1.feed(pvtFrame({1000, 435000000, -805000000, 300000, 0, 1000, 2000}));
+    gps2.feed(pvtFrame({1000, 435010000, -805000000, 300000, 0, 3000, 2000}));
+    GpsData_t data = blended.readData();
+
+    EXPECT_TRUE(data.isNew);
+    EXPECT_NEAR(blended.getGps1Weight(), 0.9f, 1e-5f);
+    EXPECT_NEAR(data.latitude, 43.5f + 0.1f * 0.001f, 1e-5f);
+    EXPECT_NEAR(data.hAcc, 1.0f / std::sqrt(1.0f + 1.0f / 9.0f), 1e-4f);
+    EXPECT_EQ(blended.getHealthyMask(), 0b11);
+}
+
+TEST_F(BlendedGPSTest, WeightsAltitudeByVerticalAccuracy) {
+    // Equal horizontal accuracy, gps2 is far better vertically
+    gps1.feed(pvtFrame({1000, 435000000, -805000000, 310000, 0, 2000, 4000}));
+    gps2.feed(pvtFrame({1000, 435000000, -805000000, 300000, 0, 2000, 1000}));
+    GpsData_t data = blended.readData();
+
+    EXPECT_NEAR(blended.getGps1Weight(), 0.5f, 1e-5f);
+    // Weights 1/16 and 1, so altitude sits 1/17 of the way towards gps1
+    EXPECT_NEAR(data.altitude, 300.0f + 10.0f / 17.0f, 1e-3f);
+}
+
+TEST_F(BlendedGPSTest, CompensatesTimeOffset) {
+    // Both receivers on the same northbound track at 20 m/s, gps1 reports 500 ms earlier
+    const int32_t lat0 = 435000000;
+    gps1.feed(pvtFrame({200000, lat0, -805000000, 300000, 20000, 2000, 3000}));
+    gps2.feed(pvtFrame({200500, lat0 + (int32_t)(10.0 * E7_PER_M), -805000000, 300000, 20000, 2000, 3000}));
+    GpsData_t data = blended.readData();
+
+    // Without compensation the blend would land 5 m behind the newer epoch
+    EXPECT_NEAR(data.latitude, (lat0 + 10.0 * E7_PER_M) * 1e-7, 1e-5);
+    EXPECT_EQ(data.solutionTimeMs, 200500u);
+}
+
+TEST_F(BlendedGPSTest, CompensatesAcrossWeekRollover) {
+    const int32_t lat0 = 435000000;
+    gps1.feed(pvtFrame({604799800, lat0, -805000000, 300000, 20000, 2000, 3000}));
+    gps2.feed(pvtFrame({300, lat0 + (int32_t)(10.0 * E7_PER_M), -805000000, 300000, 20000, 2000, 3000}));
+    GpsData_t data = blended.readData();
+
+    EXPECT_NEAR(data.latitude, (lat0 + 10.0 * E7_PER_M) * 1e-7, 1e-5);
+    EXPECT_EQ(data.solutionTimeMs, 300u);
+}
+
+TEST_F(BlendedGPSTest, UnalignableTimesUseMoreAccurateReceiver) {
+    gps1.feed(pvtFrame({100000, 435000000, -805000000, 300000, 0, 4000, 3000}));
+    gps2.feed(pvtFrame({200000, 436000000, -805000000, 300000, 0, 1000, 3000}));
+    GpsData_t data = blended.readData();
+
+    EXPECT_NEAR(data.latitude, 43.6f, 1e-5f);
+    EXPECT_FLOAT_EQ(blended.getGps1Weight(), 0.0f);
+}
+
+TEST_F(BlendedGPSTest, FailsOverWhenReceiverDrops) {
+    uint32_t iTOW = 10000;
+    for (int i = 0; i < 5; i++) {
+        gps1.feed(pvtFrame({iTOW, 435000000, -805000000, 300000, 0, 1000, 2000}));
+        gps2.feed(pvtFrame({iTOW, 435010000, -805000000, 300000, 0, 1000, 2000}));
+        EXPECT_NEAR(blended.readData().latitude, 43.5005f, 1e-5f);
+        nowMs += 100;
+        iTOW += 100;
+    }
+    EXPECT_EQ(blended.getFailoverCount(), 0u);
+
+    // gps1 goes silent, its last solution keeps contributing until the timeout
+    for (uint32_t elapsed = 0; elapsed <= BlendedGPS::RECEIVER_TIMEOUT_MS + 100; elapsed += 100) {
+        gps2.feed(pvtFrame({iTOW, 435010000, -805000000, 300000, 0, 1000, 2000}));
+        GpsData_t data = blended.readData();
+        EXPECT_TRUE(data.isNew);
+        nowMs += 100;
+        iTOW += 100;
+    }
+    EXPECT_EQ(blended.getHealthyMask(), 0b10);
+    EXPECT_EQ(blended.getFailoverCount(), 1u);
+    EXPECT_FLOAT_EQ(blended.getGps1Weight(), 0.0f);
+
+    gps2.feed(pvtFrame({iTOW, 435010000, -805000000, 300000, 0, 1000, 2000}));
+    EXPECT_NEAR(blended.readData().latitude, 43.501f, 1e-5f);
+
+    // gps1 comes back and blending resumes
+    nowMs += 100;
+    iTOW += 100;
+    gps1.feed(pvtFrame({iTOW, 435000000, -805000000, 300000, 0, 1000, 2000}));
+    gps2.feed(pvtFrame({iTOW, 435010000, -805000000, 300000, 0, 1000, 2000}));
+    EXPECT_NEAR(blended.readData().latitude, 43.5005f, 1e-5f);
+    EXPECT_EQ(blended.getHealthyMask(), 0b11);
+}
+
+TEST(BlendedGPSSingle, MissingSecondReceiverIsAllowed) {
+    NiceMock<MockSystemUtils> sysUtils;
+    StreamGPS gps1;
+    BlendedGPS blended(&gps1, nullptr, &sysUtils);
+
+    gps1.feed(pvtFrame({1000, 435000000, -805000000, 300000, 0, 1500, 2500}));
+    GpsData_t data = blended.readData();
+    EXPECT_TRUE(data.isNew);
+    EXPECT_NEAR(data.latitude, 43.5f, 1e-5f);
+    EXPECT_EQ(blended.getHealthyMask(), 0b01);
+}
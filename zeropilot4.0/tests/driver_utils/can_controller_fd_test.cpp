@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "can_controller.hpp"
+#include "mock_systemutils.hpp"
+#include "virtual_can_bus.hpp"
+
+using ::testing::NiceMock;
+using ::testing::Invoke;
+
+// Built with CANARD_ENABLE_CANFD, which also turns on the tail array optimisation option
+static_assert(CANARD_ENABLE_CANFD && CANARD_ENABLE_TAO_OPTION, "CAN FD test target needs CANARD_ENABLE_CANFD");
+
+// Remote node that can talk either frame format, a bare libcanard instance
+class FdPeerNode {
+    public:
+        FdPeerNode(VirtualCANBus &bus, uint8_t nodeId, const uint32_t &nowMs) : nowMs(nowMs), pool{} {
+            canardInit(&canard, pool, sizeof(pool), &FdPeerNode::onReception, &FdPeerNode::shouldAccept, this);
+            canardSetLocalNodeID(&canard, nodeId);
+            port = &bus.addPort([this](const CANFrame_t &frame) { receive(frame); }, TX_FIFO_DEPTH);
+        }
+
+        void broadcastFix2(const uavcan_equipment_gnss_Fix2 &fix, bool fd) {
+            uavcan_equipment_gnss_Fix2 msg = fix;
+            uint8_t buffer[UAVCAN_EQUIPMENT_GNSS_FIX2_MAX_SIZE];
+            const uint32_t len = uavcan_equipment_gnss_Fix2_encode(&msg, buffer, !fd);
+
+            CanardTxTransfer transfer {};
+            transfer.transfer_type = CanardTransferTypeBroadcast;
+            transfer.data_type_signature = UAVCAN_EQUIPMENT_GNSS_FIX2_SIGNATURE;
+            transfer.data_type_id = UAVCAN_EQUIPMENT_GNSS_FIX2_ID;
+            transfer.inout_transfer_id = &fixTransferId;
+            transfer.priority = CANARD_TRANSFER_PRIORITY_MEDIUM;
+            transfer.payload = buffer;
+            transfer.payload_len = static_cast<uint16_t>(len);
+            transfer.canfd = fd;
+            transfer.tao = !fd;
+            canardBroadcastObj(&canard, &transfer);
+            flushTx();
+        }
+
+        std::vector<uavcan_equipment_esc_RawCommand> escCommands;
+        std::vector<bool> escCommandsFd;
+        uint32_t nodeStatusCount = 0;
+
+    private:
+        static constexpr size_t TX_FIFO_DEPTH = 32;    // Deep enough for a whole classic Fix2
+        const uint32_t &nowMs;
+        CanardInstance canard;
+        alignas(8) uint8_t pool[8192];
+        VirtualCANBus::Port *port;
+        uint8_t fixTransferId = 0;
+
+        void flushTx() {
+            for (CanardCANFrame *frame = canardPeekTxQueue(&canard); frame != nullptr; frame = canardPeekTxQueue(&canard)) {
+                CANFrame_t out {};
+                out.id = frame->id & CANARD_CAN_EXT_ID_MASK;
+                out.len = frame->data_len;
+                out.fd = frame->canfd;
+                memcpy(out.data, frame->data, frame->data_len);
+                if (!port->transmit(out)) return;
+                canardPopTxQueue(&canard);
+            }
+        }
+
+        void receive(const CANFrame_t &frame) {
+            CanardCANFrame in {};
+            in.id = frame.id | CANARD_CAN_FRAME_EFF;
+            in.data_len = frame.len;
+            in.canfd = frame.fd;
+            memcpy(in.data, frame.data, frame.len);
+            canardHandleRxFrame(&canard, &in, nowMs * 1000ULL);
+        }
+
+        static bool shouldAccept(const CanardInstance *, uint64_t *signature, uint16_t dataTypeId, CanardTransferType, uint8_t) {
+            if (dataTypeId == UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_ID) {
+                *signature = UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_SIGNATURE;
+                return true;
+            }
+            if (dataTypeId == UAVCAN_PROTOCOL_NODESTATUS_ID) {
+                *signature = UAVCAN_PROTOCOL_NODESTATUS_SIGNATURE;
+                return true;
+            }
+            return false;
+        }
+
+        static void onReception(CanardInstance *ins, CanardRxTransfer *transfer) {
+            FdPeerNode *self = static_cast<FdPeerNode *>(canardGetUserReference(ins));
+            if (transfer->data_type_id == UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_ID) {
+                uavcan_equipment_esc_RawCommand msg {};
+                if (!uavcan_equipment_esc_RawCommand_decode(transfer, &msg)) {
+                    self->escCommands.push_back(msg);
+                    self->escCommandsFd.push_back(transfer->canfd);
+                }
+            } else if (transfer->data_type_id == UAVCAN_PROTOCOL_NODESTATUS_ID) {
+                self->nodeStatusCount++;
+            }
+        }
+};
+
+class CANControllerFdTest : public ::testing::Test {
+protected:
+    uint32_t nowMs = 1000;
+    NiceMock<MockSystemUtils> systemUtils;
+    VirtualCANBus bus;
+    LatestValueSlot<ActuatorCommand_t> commandSlot;
+    DroneCANGPS gps;
+    std::vector<CANFrame_t> wire;
+    VirtualCANBus::Port *controllerPort = nullptr;
+    std::unique_ptr<CANController> controller;
+    std::unique_ptr<FdPeerNode> peer;
+
+    void SetUp() override {
+        ON_CALL(systemUtils, getCurrentTimestampMs()).WillByDefault(Invoke([this]() { return nowMs; }));
+
+        controllerPort = &bus.addPort([this](const CANFrame_t &frame) {
+            controller->enqueueRxFrame(frame.id, frame.len, frame.data, frame.fd);
+        });
+        controller.reset(new CANController(controllerPort, &systemUtils, nullptr, &commandSlot, nullptr, &gps));
+        peer.reset(new FdPeerNode(bus, 20, nowMs));
+
+        // Listen only port, sees every frame on the wire
+        bus.addPort([this](const CANFrame_t &frame) { wire.push_back(frame); });
+    }
+
+    std::vector<CANFrame_t> framesFrom(uint8_t nodeId) const {
+        std::vector<CANFrame_t> frames;
+        for (const CANFrame_t &frame : wire) {
+            if ((frame.id & 0x7FU) == nodeId) frames.push_back(frame);
+        }
+        return frames;
+    }
+
+    void service() {
+        controller->routineTasks();
+        while (bus.step() > 0) {
+            controller->routineTasks();
+        }
+    }
+
+    void sendEscCommand() {
+        ActuatorCommand_t command {};
+        command.escCount = 4;
+        for (uint8_t i = 0; i < 4; i++) {
+            command.escRaw[i] = static_cast<int16_t>(1000 * (i + 1));
+        }
+        commandSlot.publish(command);
+        service();
+    }
+
+    static uavcan_equipment_gnss_Fix2 makeFix() {
+        uavcan_equipment_gnss_Fix2 fix {};
+        fix.status = UAVCAN_EQUIPMENT_GNSS_FIX2_STATUS_3D_FIX;
+        fix.latitude_deg_1e8 = 4347000000LL;
+        fix.longitude_deg_1e8 = -8054000000LL;
+        fix.height_msl_mm = 334000;
+        fix.sats_used = 14;
+        fix.ned_velocity[0] = 3.0f;
+        fix.covariance.len = 6;
+        for (uint8_t i = 0; i < 6; i++) {
+            fix.covariance.data[i] = 4.0f;
+        }
+        return fix;
+    }
+};
+
+TEST_F(CANControllerFdTest, ClassicFramesUntilFdTransmitIsEnabled) {
+    service();
+    std::vector<CANFrame_t> sent = framesFrom(CANARD_MIN_NODE_ID);
+    ASSERT_FALSE(sent.empty());
+    for (const CANFrame_t &frame : sent) {
+        EXPECT_FALSE(frame.fd);
+    }
+
+    wire.clear();
+    nowMs += 1000;
+    controller->setFdTransmit(true);
+    service();
+    sent = framesFrom(CANARD_MIN_NODE_ID);
+    ASSERT_FALSE(sent.empty());
+    for (const CANFrame_t &frame : sent) {
+        EXPECT_TRUE(frame.fd);
+    }
+    EXPECT_EQ(peer->nodeStatusCount, 2u);
+}
+
+TEST_F(CANControllerFdTest, EscCommandsDecodeInEitherFormat) {
+    // Classic frames use the tail array optimisation, FD frames carry the array length
+    sendEscCommand();
+    controller->setFdTransmit(true);
+    sendEscCommand();
+
+    ASSERT_EQ(peer->escCommands.size(), 2u);
+    EXPECT_FALSE(peer->escCommandsFd[0]);
+    EXPECT_TRUE(peer->escCommandsFd[1]);
+    for (const uavcan_equipment_esc_RawCommand &msg : peer->escCommands) {
+        ASSERT_EQ(msg.cmd.len, 4);
+        for (uint8_t i = 0; i < 4; i++) {
+            EXPECT_EQ(msg.cmd.data[i], 1000 * (i + 1));
+        }
+    }
+}
+
+TEST_F(CANControllerFdTest, MultiFrameFixTakesFewerFdFrames) {
+    peer->broadcastFix2(makeFix(), false);
+    service();
+    const size_t classicFrames = framesFrom(20).size();
+
+    GpsData_t classic = gps.readData();
+    ASSERT_TRUE(classic.isNew);
+
+    wire.clear();
+    peer->broadcastFix2(makeFix(), true);
+    service();
+    const size_t fdFrames = framesFrom(20).size();
+
+    GpsData_t fd = gps.readData();
+    ASSERT_TRUE(fd.isNew);
+    EXPECT_FLOAT_EQ(fd.latitude, classic.latitude);
+    EXPECT_FLOAT_EQ(fd.altitude, 334.0f);
+    EXPECT_EQ(fd.numSatellites, 14);
+    EXPECT_FLOAT_EQ(fd.hAcc, 2.0f);
+
+    EXPECT_GE(classicFrames, 8u);
+    EXPECT_EQ(fdFrames, 1u);
+    EXPECT_EQ(controller->getStats().rxPoolExhausted, 0u);
+}
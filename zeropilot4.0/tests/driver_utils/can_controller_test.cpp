@@ -0,0 +1,362 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstring>
+#include <vector>
+#include "can_controller.hpp"
+#include "mock_systemutils.hpp"
+#include "virtual_can_bus.hpp"
+
+using ::testing::NiceMock;
+using ::testing::Invoke;
+
+static constexpr uint32_t RING_SLOTS = CANController::RX_RING_SLOTS;
+
+// Load test: several peers each sending every millisecond, a few thousand frames per second on the bus
+static constexpr uint8_t LOAD_PEER_COUNT = 5;
+static constexpr uint32_t LOAD_DURATION_MS = 1000;
+static constexpr uint32_t LOAD_FRAMES_SENT = LOAD_PEER_COUNT * LOAD_DURATION_MS;
+
+// Remote DroneCAN node on the virtual bus, a bare libcanard instance
+class PeerNode {
+    public:
+        PeerNode(VirtualCANBus &bus, uint8_t nodeId, const uint32_t &nowMs) : nowMs(nowMs), pool{} {
+            canardInit(&canard, pool, sizeof(pool), &PeerNode::onReception, &PeerNode::shouldAccept, this);
+            if (nodeId != 0) {
+                canardSetLocalNodeID(&canard, nodeId);
+            }
+            port = &bus.addPort([this](const CANFrame_t &frame) { receive(frame); });
+        }
+
+        void broadcastNodeStatus(uint32_t uptimeSec) {
+            uavcan_protocol_NodeStatus status {};
+            status.uptime_sec = uptimeSec;
+            status.mode = UAVCAN_PROTOCOL_NODESTATUS_MODE_OPERATIONAL;
+            uint8_t buffer[UAVCAN_PROTOCOL_NODESTATUS_MAX_SIZE];
+            const uint32_t len = uavcan_protocol_NodeStatus_encode(&status, buffer);
+            canardBroadcast(&canard, UAVCAN_PROTOCOL_NODESTATUS_SIGNATURE, UAVCAN_PROTOCOL_NODESTATUS_ID,
+                &nodeStatusTransferId, CANARD_TRANSFER_PRIORITY_LOW, buffer, len);
+            flushTx();
+        }
+
+        void requestAllocation(bool firstPart, uint8_t preferredNodeId, const uint8_t *uniqueIdPart, uint8_t len) {
+            uavcan_protocol_dynamic_node_id_Allocation msg {};
+            msg.node_id = preferredNodeId;
+            msg.first_part_of_unique_id = firstPart;
+            msg.unique_id.len = len;
+            memcpy(msg.unique_id.data, uniqueIdPart, len);
+            uint8_t buffer[UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_MAX_SIZE];
+            const uint32_t encodedLen = uavcan_protocol_dynamic_node_id_Allocation_encode(&msg, buffer);
+            canardBroadcast(&canard, UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_SIGNATURE,
+                UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_ID, &allocationTransferId, CANARD_TRANSFER_PRIORITY_LOW,
+                buffer, static_cast<uint16_t>(encodedLen));
+            flushTx();
+        }
+
+        // Any message, the controller side decides from the identifier alone whether it wants it
+        void broadcastRaw(uint64_t signature, uint16_t dataTypeId, const uint8_t *payload, uint16_t len) {
+            canardBroadcast(&canard, signature, dataTypeId, &rawTransferId, CANARD_TRANSFER_PRIORITY_MEDIUM, payload, len);
+            flushTx();
+        }
+
+        std::vector<uavcan_protocol_dynamic_node_id_Allocation> allocations;
+        std::vector<uint8_t> nodeStatusSources;
+
+    private:
+        const uint32_t &nowMs;
+        CanardInstance canard;
+        alignas(8) uint8_t pool[4096];
+        VirtualCANBus::Port *port;
+        uint8_t nodeStatusTransferId = 0;
+        uint8_t allocationTransferId = 0;
+        uint8_t rawTransferId = 0;
+
+        void flushTx() {
+            for (CanardCANFrame *frame = canardPeekTxQueue(&canard); frame != nullptr; frame = canardPeekTxQueue(&canard)) {
+                CANFrame_t out {};
+                out.id = frame->id & CANARD_CAN_EXT_ID_MASK;
+                out.len = frame->data_len;
+                memcpy(out.data, frame->data, frame->data_len);
+                if (!port->transmit(out)) return;
+                canardPopTxQueue(&canard);
+            }
+        }
+
+        void receive(const CANFrame_t &frame) {
+            CanardCANFrame in;
+            in.id = frame.id | CANARD_CAN_FRAME_EFF;
+            in.data_len = frame.len;
+            memcpy(in.data, frame.data, frame.len);
+            canardHandleRxFrame(&canard, &in, nowMs * 1000ULL);
+            flushTx();
+        }
+
+        static bool shouldAccept(const CanardInstance *, uint64_t *signature, uint16_t dataTypeId, CanardTransferType, uint8_t) {
+            if (dataTypeId == UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_ID) {
+                *signature = UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_SIGNATURE;
+                return true;
+            }
+            if (dataTypeId == UAVCAN_PROTOCOL_NODESTATUS_ID) {
+                *signature = UAVCAN_PROTOCOL_NODESTATUS_SIGNATURE;
+                return true;
+            }
+            return false;
+        }
+
+        static void onReception(CanardInstance *ins, CanardRxTransfer *transfer) {
+            PeerNode *self = static_cast<PeerNode *>(canardGetUserReference(ins));
+            if (transfer->data_type_id == UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_ID) {
+                uavcan_protocol_dynamic_node_id_Allocation msg {};
+                if (!uavcan_protocol_dynamic_node_id_Allocation_decode(transfer, &msg)) {
+                    self->allocations.push_back(msg);
+                }
+            } else if (transfer->data_type_id == UAVCAN_PROTOCOL_NODESTATUS_ID) {
+                self->nodeStatusSources.push_back(transfer->source_node_id);
+            }
+        }
+};
+
+class CANControllerTest : public ::testing::Test {
+protected:
+    uint32_t nowMs = 0;
+    NiceMock<MockSystemUtils> systemUtils;
+    VirtualCANBus bus;
+    LatestValueSlot<CANBusStats_t> statsSlot;
+    CANController *controller = nullptr;
+    VirtualCANBus::Port *controllerPort = nullptr;
+
+    void SetUp() override {
+        ON_CALL(systemUtils, getCurrentTimestampMs()).WillByDefault(Invoke([this]() { return nowMs; }));
+    }
+
+    void TearDown() override {
+        delete controller;
+    }
+
+    // The RX ISR of the controller side hands every frame on the wire to the ring
+    void createController(size_t txFifoDepth = 3, uint8_t filterElements = 8) {
+        controllerPort = &bus.addPort([this](const CANFrame_t &frame) {
+            controller->enqueueRxFrame(frame.id, frame.len, frame.data);
+        }, txFifoDepth, filterElements);
+        controller = new CANController(controllerPort, &systemUtils, &statsSlot);
+    }
+
+    // One bus task wake: frames on the wire, then the task drains RX and refills TX
+    void service() {
+        bus.step();
+        controller->routineTasks();
+        bus.step();
+    }
+};
+
+TEST_F(CANControllerTest, TracksRemoteNodesFromNodeStatus) {
+    createController();
+    PeerNode peer(bus, 42, nowMs);
+
+    EXPECT_TRUE(controller->getNode(42).isOffline());
+    peer.broadcastNodeStatus(7);
+    service();
+    EXPECT_FALSE(controller->getNode(42).isOffline());
+    EXPECT_EQ(controller->getNode(42).getStatus().uptime_sec, 7u);
+
+    // Silent for longer than the offline timeout
+    for (nowMs = 0; nowMs <= UAVCAN_PROTOCOL_NODESTATUS_OFFLINE_TIMEOUT_MS + 1000; nowMs += 100) {
+        service();
+    }
+    EXPECT_TRUE(controller->getNode(42).isOffline());
+}
+
+TEST_F(CANControllerTest, BroadcastsOwnNodeStatus) {
+    createController();
+    PeerNode peer(bus, 42, nowMs);
+
+    for (nowMs = 0; nowMs <= 2000; nowMs += 10) {
+        service();
+    }
+
+    ASSERT_GE(peer.nodeStatusSources.size(), 2u);
+    EXPECT_EQ(peer.nodeStatusSources.front(), CANARD_MIN_NODE_ID);
+}
+
+TEST_F(CANControllerTest, AllocatesNodeIdToAnonymousPeer) {
+    createController();
+    PeerNode peer(bus, 0, nowMs);
+    const uint8_t uniqueId[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+
+    nowMs = 100;
+    peer.requestAllocation(true, 50, uniqueId, 6);
+    service();
+    ASSERT_EQ(peer.allocations.size(), 1u);
+    EXPECT_EQ(peer.allocations.back().node_id, 0);
+    EXPECT_EQ(peer.allocations.back().unique_id.len, 6);
+
+    nowMs = 200;
+    peer.requestAllocation(false, 50, uniqueId + 6, 6);
+    service();
+    ASSERT_EQ(peer.allocations.size(), 2u);
+    EXPECT_EQ(peer.allocations.back().unique_id.len, 12);
+
+    nowMs = 300;
+    peer.requestAllocation(false, 50, uniqueId + 12, 4);
+    service();
+    ASSERT_EQ(peer.allocations.size(), 3u);
+    EXPECT_EQ(peer.allocations.back().node_id, 50);
+    EXPECT_EQ(peer.allocations.back().unique_id.len, 16);
+    EXPECT_EQ(memcmp(peer.allocations.back().unique_id.data, uniqueId, 16), 0);
+}
+
+TEST_F(CANControllerTest, TxWaitsForFifoSpace) {
+    createController(1);
+    PeerNode peer(bus, 42, nowMs);
+
+    uint8_t transferId = 0;
+    const uint8_t payload[3] = {1, 2, 3};
+    for (int i = 0; i < 5; i++) {
+        ASSERT_GT(controller->broadcast(CanardTransferTypeBroadcast, UAVCAN_PROTOCOL_NODESTATUS_SIGNATURE,
+            UAVCAN_PROTOCOL_NODESTATUS_ID, &transferId, CANARD_TRANSFER_PRIORITY_LOW, payload, sizeof(payload)), 0);
+    }
+
+    // Each TX complete event frees one FIFO slot and wakes the task again
+    controller->routineTasks();
+    EXPECT_EQ(controllerPort->pendingTx(), 1u);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(bus.step(), 1u);
+        controller->routineTasks();
+    }
+    bus.step();
+
+    EXPECT_EQ(peer.nodeStatusSources.size(), 5u);
+    EXPECT_EQ(controller->getStats().txFrames, 5u);
+}
+
+TEST_F(CANControllerTest, CountsRingOverrunsAndIsrEvents) {
+    createController();
+    const uint8_t data[8] = {};
+
+    for (uint32_t i = 0; i < RING_SLOTS + 10; i++) {
+        controller->enqueueRxFrame(0x1000 + i, 8, data);
+    }
+    controller->noteRxFifoOverrun();
+    controller->noteBusOff();
+    EXPECT_TRUE(controller->hasPendingRx());
+
+    CANBusStats_t stats = controller->getStats();
+    EXPECT_EQ(stats.rxRingOverruns, 10u);
+    EXPECT_EQ(stats.rxRingPeak, RING_SLOTS);
+    EXPECT_EQ(stats.rxFifoOverruns, 1u);
+    EXPECT_EQ(stats.busOffEvents, 1u);
+
+    // Draining makes room again
+    nowMs = 1000;
+    controller->routineTasks();
+    EXPECT_FALSE(controller->hasPendingRx());
+    EXPECT_TRUE(controller->enqueueRxFrame(0x1000, 8, data));
+    EXPECT_EQ(controller->getStats().rxFrames, RING_SLOTS);
+}
+
+TEST_F(CANControllerTest, PublishesStatsOncePerSecond) {
+    createController();
+    uint32_t lastSeq = 0;
+    CANBusStats_t stats {};
+
+    nowMs = 10;
+    controller->routineTasks();
+    EXPECT_FALSE(statsSlot.readIfNew(stats, lastSeq));
+
+    nowMs = 1000;
+    controller->routineTasks();
+    ASSERT_TRUE(statsSlot.readIfNew(stats, lastSeq));
+    EXPECT_EQ(stats.poolCapacityBlocks, CANController::CANARD_POOL_SIZE / CANARD_MEM_BLOCK_SIZE);
+}
+
+// Traffic the controller has no use for, esc.Status without a status table and another allocator's reply
+static void sendUnwantedTraffic(VirtualCANBus &bus, PeerNode &peer) {
+    const uint8_t escStatus[14] = {};
+    peer.broadcastRaw(UAVCAN_EQUIPMENT_ESC_STATUS_SIGNATURE, UAVCAN_EQUIPMENT_ESC_STATUS_ID, escStatus, sizeof(escStatus));
+    bus.step();
+    const uint8_t allocation[4] = {};
+    peer.broadcastRaw(UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_SIGNATURE, UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_ID,
+        allocation, sizeof(allocation));
+    bus.step();
+}
+
+TEST_F(CANControllerTest, AcceptanceFiltersKeepUnwantedFramesOffTheRing) {
+    createController();
+    PeerNode peer(bus, 42, nowMs);
+
+    nowMs = 1000;
+    sendUnwantedTraffic(bus, peer);
+    const uint32_t unwantedFrames = bus.getFramesOnWire();
+    peer.broadcastNodeStatus(3);
+    service();
+
+    EXPECT_EQ(unwantedFrames, 4u);  // 3 frame esc.Status, single frame allocation
+    EXPECT_EQ(controllerPort->getFilteredFrames(), unwantedFrames);
+    EXPECT_EQ(controller->getStats().rxFrames, 1u);
+    EXPECT_FALSE(controller->getNode(42).isOffline());
+}
+
+TEST_F(CANControllerTest, AcceptsEverythingWhenFiltersDontFit) {
+    createController(3, 1);
+    PeerNode peer(bus, 42, nowMs);
+
+    nowMs = 1000;
+    sendUnwantedTraffic(bus, peer);
+    peer.broadcastNodeStatus(3);
+    service();
+
+    EXPECT_EQ(controllerPort->getFilteredFrames(), 0u);
+    EXPECT_EQ(controller->getStats().rxFrames, 5u);
+    EXPECT_FALSE(controller->getNode(42).isOffline());
+}
+
+class CANControllerLoadTest : public CANControllerTest {
+protected:
+    // Bus task woken every serviceIntervalMs
+    CANBusStats_t runLoad(uint32_t serviceIntervalMs) {
+        createController();
+        std::vector<std::unique_ptr<PeerNode>> peers;
+        for (uint8_t i = 0; i < LOAD_PEER_COUNT; i++) {
+            peers.emplace_back(new PeerNode(bus, 10 + i, nowMs));
+        }
+
+        for (nowMs = 1; nowMs <= LOAD_DURATION_MS; nowMs++) {
+            for (auto &peer : peers) {
+                peer->broadcastNodeStatus(nowMs);
+            }
+            bus.step();
+            if (nowMs % serviceIntervalMs == 0) {
+                controller->routineTasks();
+            }
+        }
+        controller->routineTasks();
+        return controller->getStats();
+    }
+};
+
+TEST_F(CANControllerLoadTest, NoDropsWhenServicedEveryMillisecond) {
+    CANBusStats_t stats = runLoad(1);
+
+    EXPECT_EQ(stats.rxFrames, LOAD_FRAMES_SENT);
+    EXPECT_EQ(stats.rxRingOverruns, 0u);
+    EXPECT_EQ(stats.rxPoolExhausted, 0u);
+    EXPECT_LE(stats.rxRingPeak, LOAD_PEER_COUNT);
+    for (uint8_t i = 0; i < LOAD_PEER_COUNT; i++) {
+        EXPECT_FALSE(controller->getNode(10 + i).isOffline());
+        EXPECT_EQ(controller->getNode(10 + i).getStatus().uptime_sec, LOAD_DURATION_MS);
+    }
+}
+
+TEST_F(CANControllerLoadTest, RingRidesOutServiceLatencyBudget) {
+    CANBusStats_t stats = runLoad(CAN_BUS_MAX_SERVICE_LATENCY_MS);
+
+    EXPECT_EQ(stats.rxFrames, LOAD_FRAMES_SENT);
+    EXPECT_EQ(stats.rxRingOverruns, 0u);
+}
+
+TEST_F(CANControllerLoadTest, StarvedTaskCountsEveryDroppedFrame) {
+    CANBusStats_t stats = runLoad(100);
+
+    EXPECT_GT(stats.rxRingOverruns, 0u);
+    EXPECT_EQ(stats.rxRingPeak, RING_SLOTS);
+    EXPECT_EQ(stats.rxFrames + stats.rxRingOverruns, LOAD_FRAMES_SENT);
+}
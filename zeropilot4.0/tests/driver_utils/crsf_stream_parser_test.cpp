@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "crsf_stream_parser.hpp"
+
+// Pack 16 channels of 11 bits, little endian, the way receivers send them
+static std::vector<uint8_t> channelsFrame(const uint16_t (&ch)[CRSF_CHANNEL_COUNT]) {
+    uint8_t payload[CRSF_RC_CHANNELS_PAYLOAD_LEN] = {};
+    uint32_t bit = 0;
+    for (uint8_t i = 0; i < CRSF_CHANNEL_COUNT; i++) {
+        for (uint8_t b = 0; b < 11; b++, bit++) {
+            if (ch[i] & (1u << b)) payload[bit / 8] |= (uint8_t)(1u << (bit % 8));
+        }
+    }
+    std::vector<uint8_t> frame(CRSF_MAX_FRAME_LEN);
+    frame.resize(CrsfStreamParser::encodeFrame(CRSF_FRAMETYPE_RC_CHANNELS_PACKED, payload, sizeof(payload), frame.data(), CRSF_MAX_FRAME_LEN));
+    return frame;
+}
+
+static std::vector<uint8_t> linkStatsFrame(uint8_t lq, uint8_t rssi, int8_t snr) {
+    uint8_t payload[CRSF_LINK_STATISTICS_PAYLOAD_LEN] = {rssi, 110, lq, (uint8_t)snr, 1, 7, 3, 80, 95, (uint8_t)-2};
+    std::vector<uint8_t> frame(CRSF_MAX_FRAME_LEN);
+    frame.resize(CrsfStreamParser::encodeFrame(CRSF_FRAMETYPE_LINK_STATISTICS, payload, sizeof(payload), frame.data(), CRSF_MAX_FRAME_LEN));
+    return frame;
+}
+
+static void append(std::vector<uint8_t> &stream, const std::vector<uint8_t> &bytes) {
+    stream.insert(stream.end(), bytes.begin(), bytes.end());
+}
+
+static const uint16_t RAMP[CRSF_CHANNEL_COUNT] = {
+    172, 992, 1811, 500, 1000, 1500, 2000, 0, 2047, 1, 2, 3, 1024, 1023, 700, 1300
+};
+
+TEST(CrsfStreamParserTest, TableCrcMatchesBitwise) {
+    uint8_t data[40];
+    for (uint8_t i = 0; i < sizeof(data); i++) data[i] = (uint8_t)(i * 37 + 11);
+
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0xD5) : (uint8_t)(crc << 1);
+    }
+    EXPECT_EQ(CrsfStreamParser::crc8(data, sizeof(data)), crc);
+}
+
+TEST(CrsfStreamParserTest, DecodesChannels) {
+    CrsfStreamParser parser;
+    std::vector<uint8_t> frame = channelsFrame(RAMP);
+    ASSERT_EQ(frame.size(), 26u);
+    parser.feed(frame.data(), (uint16_t)frame.size());
+
+    uint16_t ch[CRSF_CHANNEL_COUNT];
+    ASSERT_TRUE(parser.takeChannels(ch));
+    for (uint8_t i = 0; i < CRSF_CHANNEL_COUNT; i++) EXPECT_EQ(ch[i], RAMP[i]) << "channel " << (int)i;
+    EXPECT_FALSE(parser.takeChannels(ch));
+    EXPECT_EQ(parser.getStats().framesOk, 1u);
+}
+
+TEST(CrsfStreamParserTest, DecodesLinkStatistics) {
+    CrsfStreamParser parser;
+    std::vector<uint8_t> frame = linkStatsFrame(87, 64, -5);
+    parser.feed(frame.data(), (uint16_t)frame.size());
+
+    CrsfLinkStats_t stats;
+    ASSERT_TRUE(parser.takeLinkStats(stats));
+    EXPECT_EQ(stats.uplinkLinkQuality, 87);
+    EXPECT_EQ(stats.uplinkRssi1, 64);
+    EXPECT_EQ(stats.uplinkSnr, -5);
+    EXPECT_EQ(stats.rfMode, 7);
+    EXPECT_EQ(stats.downlinkSnr, -2);
+    EXPECT_FALSE(parser.takeLinkStats(stats));
+}
+
+TEST(CrsfStreamParserTest, SeveralFramesInOneEvent) {
+    CrsfStreamParser parser;
+    uint16_t second[CRSF_CHANNEL_COUNT];
+    for (uint8_t i = 0; i < CRSF_CHANNEL_COUNT; i++) second[i] = (uint16_t)(RAMP[i] ^ 0x155);
+
+    std::vector<uint8_t> stream;
+    append(stream, channelsFrame(RAMP));
+    append(stream, linkStatsFrame(100, 50, 9));
+    append(stream, channelsFrame(second));
+    parser.feed(stream.data(), (uint16_t)stream.size());
+
+    uint16_t ch[CRSF_CHANNEL_COUNT];
+    CrsfLinkStats_t stats;
+    ASSERT_TRUE(parser.takeChannels(ch));
+    EXPECT_EQ(ch[8], second[8]);
+    ASSERT_TRUE(parser.takeLinkStats(stats));
+    EXPECT_EQ(stats.uplinkLinkQuality, 100);
+    EXPECT_EQ(parser.getChannelFrameCount(), 2u);
+    EXPECT_EQ(parser.getStats().framesOk, 3u);
+}
+
+TEST(CrsfStreamParserTest, FramesSplitAtEveryBoundary) {
+    std::vector<uint8_t> stream;
+    append(stream, channelsFrame(RAMP));
+    append(stream, linkStatsFrame(42, 70, 3));
+
+    for (size_t split = 1; split < stream.size(); split++) {
+        CrsfStreamParser parser;
+        parser.feed(stream.data(), (uint16_t)split);
+        parser.feed(stream.data() + split, (uint16_t)(stream.size() - split));
+
+        uint16_t ch[CRSF_CHANNEL_COUNT];
+        CrsfLinkStats_t stats;
+        ASSERT_TRUE(parser.takeChannels(ch)) << "split " << split;
+        EXPECT_EQ(ch[15], RAMP[15]);
+        ASSERT_TRUE(parser.takeLinkStats(stats)) << "split " << split;
+        EXPECT_EQ(stats.uplinkLinkQuality, 42);
+    }
+}
+
+TEST(CrsfStreamParserTest, ByteAtATime) {
+    CrsfStreamParser parser;
+    std::vector<uint8_t> frame = channelsFrame(RAMP);
+    uint16_t ch[CRSF_CHANNEL_COUNT];
+    for (size_t i = 0; i + 1 < frame.size(); i++) {
+        parser.feedByte(frame[i]);
+        EXPECT_FALSE(parser.takeChannels(ch));
+    }
+    parser.feedByte(frame.back());
+    EXPECT_TRUE(parser.takeChannels(ch));
+}
+
+TEST(CrsfStreamParserTest, RejectsCorruptFrameAndRecovers) {
+    CrsfStreamParser parser;
+    std::vector<uint8_t> bad = channelsFrame(RAMP);
+    bad[10] ^= 0x40;
+
+    std::vector<uint8_t> stream;
+    append(stream, bad);
+    append(stream, linkStatsFrame(77, 60, 1));
+    parser.feed(stream.data(), (uint16_t)stream.size());
+
+    uint16_t ch[CRSF_CHANNEL_COUNT];
+    CrsfLinkStats_t stats;
+    EXPECT_FALSE(parser.takeChannels(ch));
+    EXPECT_TRUE(parser.takeLinkStats(stats));
+    EXPECT_EQ(parser.getStats().crcErrors, 1u);
+}
+
+TEST(CrsfStreamParserTest, ResyncsOnFrameBehindFalseHeader) {
+    CrsfStreamParser parser;
+    // A stray sync byte whose length field swallows the start of the real frame
+    std::vector<uint8_t> stream = {0x55, CRSF_SYNC_BYTE, 0x05};
+    append(stream, channelsFrame(RAMP));
+    parser.feed(stream.data(), (uint16_t)stream.size());
+
+    uint16_t ch[CRSF_CHANNEL_COUNT];
+    ASSERT_TRUE(parser.takeChannels(ch));
+    EXPECT_EQ(ch[0], RAMP[0]);
+    EXPECT_EQ(parser.getStats().crcErrors, 1u);
+    EXPECT_GT(parser.getStats().droppedBytes, 0u);
+}
+
+TEST(CrsfStreamParserTest, DropsInvalidLengthAndWrongPayloadSize) {
+    CrsfStreamParser parser;
+    uint8_t shortPayload[4] = {1, 2, 3, 4};
+    std::vector<uint8_t> wrongSize(CRSF_MAX_FRAME_LEN);
+    wrongSize.resize(CrsfStreamParser::encodeFrame(CRSF_FRAMETYPE_RC_CHANNELS_PACKED, shortPayload, sizeof(shortPayload), wrongSize.data(), CRSF_MAX_FRAME_LEN));
+
+    std::vector<uint8_t> stream = {CRSF_SYNC_BYTE, 0xFF};
+    append(stream, wrongSize);
+    append(stream, channelsFrame(RAMP));
+    parser.feed(stream.data(), (uint16_t)stream.size());
+
+    uint16_t ch[CRSF_CHANNEL_COUNT];
+    ASSERT_TRUE(parser.takeChannels(ch));
+    EXPECT_EQ(parser.getChannelFrameCount(), 1u);
+    EXPECT_EQ(parser.getStats().droppedFrames, 2u);
+}
+
+TEST(CrsfStreamParserTest, ResyncDropsPartialFrameAndKeepsStats) {
+    CrsfStreamParser parser;
+    std::vector<uint8_t> bad = channelsFrame(RAMP);
+    bad[10] ^= 0x40;
+    std::vector<uint8_t> good = channelsFrame(RAMP);
+
+    std::vector<uint8_t> stream;
+    append(stream, bad);
+    append(stream, linkStatsFrame(77, 60, 1));
+    stream.insert(stream.end(), good.begin(), good.begin() + 10);
+    parser.feed(stream.data(), (uint16_t)stream.size());
+
+    // DMA restart, the rest of the partial frame never arrives and the stream picks up at a fresh frame
+    parser.resync();
+    parser.feed(good.data(), (uint16_t)good.size());
+
+    uint16_t ch[CRSF_CHANNEL_COUNT];
+    CrsfLinkStats_t stats;
+    ASSERT_TRUE(parser.takeChannels(ch));
+    EXPECT_EQ(ch[0], RAMP[0]);
+    ASSERT_TRUE(parser.takeLinkStats(stats));
+    EXPECT_EQ(stats.uplinkLinkQuality, 77);
+    EXPECT_EQ(parser.getStats().framesOk, 2u);
+    EXPECT_EQ(parser.getStats().crcErrors, 1u);
+    EXPECT_EQ(parser.getChannelFrameCount(), 1u);
+}
+
+TEST(CrsfStreamParserTest, IgnoresOtherValidTypes) {
+    CrsfStreamParser parser;
+    uint8_t payload[6] = {};
+    std::vector<uint8_t> frame(CRSF_MAX_FRAME_LEN);
+    frame.resize(CrsfStreamParser::encodeFrame(CRSF_FRAMETYPE_ATTITUDE, payload, sizeof(payload), frame.data(), CRSF_MAX_FRAME_LEN));
+    parser.feed(frame.data(), (uint16_t)frame.size());
+
+    uint16_t ch[CRSF_CHANNEL_COUNT];
+    EXPECT_FALSE(parser.takeChannels(ch));
+    EXPECT_EQ(parser.getStats().framesOk, 1u);
+    EXPECT_EQ(parser.getStats().droppedFrames, 0u);
+}
+
+TEST(CrsfStreamParserTest, EncodeRejectsOversizedPayload) {
+    uint8_t payload[CRSF_MAX_PAYLOAD_LEN + 1] = {};
+    uint8_t out[CRSF_MAX_FRAME_LEN + 1];
+    EXPECT_EQ(CrsfStreamParser::encodeFrame(CRSF_FRAMETYPE_FLIGHT_MODE, payload, sizeof(payload), out, sizeof(out)), 0);
+    EXPECT_EQ(CrsfStreamParser::encodeFrame(CRSF_FRAMETYPE_FLIGHT_MODE, payload, 10, out, 13), 0);
+    EXPECT_EQ(CrsfStreamParser::encodeFrame(CRSF_FRAMETYPE_FLIGHT_MODE, payload, 10, out, 14), 14);
+}
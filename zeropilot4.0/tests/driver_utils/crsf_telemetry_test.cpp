@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "crsf_telemetry.hpp"
+#include "crsf_stream_parser.hpp"
+
+static RCSystemTelemetry_t makeSystem() {
+    RCSystemTelemetry_t system = {};
+    system.batteryValid = true;
+    system.batteryVoltage = 11.84f;
+    system.batteryCurrent = 23.46f;
+    system.consumedMah = 1234.0f;
+    system.batteryRemaining = 67;
+    strcpy(system.flightMode, "FBWA");
+    return system;
+}
+
+static RCNavTelemetry_t makeNav() {
+    RCNavTelemetry_t nav = {};
+    nav.roll = 0.5f;
+    nav.pitch = -0.25f;
+    nav.yaw = 3.0f;
+    nav.gpsValid = true;
+    nav.latitude = 43.47f;
+    nav.longitude = -80.54f;
+    nav.altitude = 331.0f;
+    nav.groundSpeed = 1000.0f; // 10 m/s
+    nav.trackAngle = 270.5f;
+    nav.numSatellites = 14;
+    return nav;
+}
+
+static uint16_t be16(const uint8_t *p) { return (uint16_t)((p[0] << 8) | p[1]); }
+static uint32_t be32(const uint8_t *p) { return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3]; }
+
+static void expectValidFrame(const uint8_t *frame, uint8_t len, uint8_t type) {
+    ASSERT_GE(len, 4);
+    EXPECT_EQ(frame[0], CRSF_SYNC_BYTE);
+    EXPECT_EQ(frame[1], len - 2);
+    EXPECT_EQ(frame[2], type);
+    EXPECT_EQ(frame[len - 1], CrsfStreamParser::crc8(&frame[2], len - 3));
+}
+
+TEST(CrsfTelemetryTest, EncodesBattery) {
+    uint8_t out[CRSF_MAX_FRAME_LEN];
+    uint8_t len = CrsfTelemetry::encodeBattery(makeSystem(), out, sizeof(out));
+    expectValidFrame(out, len, CRSF_FRAMETYPE_BATTERY_SENSOR);
+    EXPECT_EQ(be16(&out[3]), 118);
+    EXPECT_EQ(be16(&out[5]), 235);
+    EXPECT_EQ(((uint32_t)out[7] << 16) | (out[8] << 8) | out[9], 1234u);
+    EXPECT_EQ(out[10], 67);
+}
+
+TEST(CrsfTelemetryTest, EncodesAttitude) {
+    uint8_t out[CRSF_MAX_FRAME_LEN];
+    uint8_t len = CrsfTelemetry::encodeAttitude(makeNav(), out, sizeof(out));
+    expectValidFrame(out, len, CRSF_FRAMETYPE_ATTITUDE);
+    EXPECT_EQ((int16_t)be16(&out[3]), -2500);
+    EXPECT_EQ((int16_t)be16(&out[5]), 5000);
+    EXPECT_EQ((int16_t)be16(&out[7]), 30000);
+}
+
+TEST(CrsfTelemetryTest, EncodesGps) {
+    uint8_t out[CRSF_MAX_FRAME_LEN];
+    uint8_t len = CrsfTelemetry::encodeGps(makeNav(), out, sizeof(out));
+    expectValidFrame(out, len, CRSF_FRAMETYPE_GPS);
+    EXPECT_NEAR((int32_t)be32(&out[3]), 434700000, 64);
+    EXPECT_NEAR((int32_t)be32(&out[7]), -805400000, 64);
+    EXPECT_EQ(be16(&out[11]), 360);   // 36 km/h
+    EXPECT_EQ(be16(&out[13]), 27050);
+    EXPECT_EQ(be16(&out[15]), 1331);
+    EXPECT_EQ(out[17], 14);
+}
+
+TEST(CrsfTelemetryTest, EncodesFlightMode) {
+    uint8_t out[CRSF_MAX_FRAME_LEN];
+    uint8_t len = CrsfTelemetry::encodeFlightMode(makeSystem(), out, sizeof(out));
+    expectValidFrame(out, len, CRSF_FRAMETYPE_FLIGHT_MODE);
+    EXPECT_STREQ((const char *)&out[3], "FBWA");
+}
+
+TEST(CrsfTelemetryTest, SilentUntilRcPeriodKnown) {
+    CrsfTelemetry telem;
+    telem.setSystem(makeSystem());
+    uint8_t out[CRSF_MAX_FRAME_LEN];
+    EXPECT_EQ(telem.onRcFrame(1000, out, sizeof(out)), 0);
+    EXPECT_GT(telem.onRcFrame(7667, out, sizeof(out)), 0);
+    EXPECT_EQ(telem.getRcFramePeriodUs(), 6667u);
+}
+
+TEST(CrsfTelemetryTest, RotatesThroughAvailableFrames) {
+    CrsfTelemetry telem;
+    telem.setSystem(makeSystem());
+    telem.setNav(makeNav());
+
+    uint8_t out[CRSF_MAX_FRAME_LEN];
+    uint32_t now = 0;
+    telem.onRcFrame(now, out, sizeof(out));
+
+    // 150 Hz RC, one telemetry frame per slot once MIN_FRAME_INTERVAL_US has passed
+    uint8_t seen[4] = {};
+    for (int i = 0; i < 8; i++) {
+        now += 6667;
+        uint8_t len = telem.onRcFrame(now, out, sizeof(out));
+        ASSERT_GT(len, 0);
+        seen[i % 4] = out[2];
+    }
+    EXPECT_EQ(seen[0], CRSF_FRAMETYPE_BATTERY_SENSOR);
+    EXPECT_EQ(seen[1], CRSF_FRAMETYPE_ATTITUDE);
+    EXPECT_EQ(seen[2], CRSF_FRAMETYPE_GPS);
+    EXPECT_EQ(seen[3], CRSF_FRAMETYPE_FLIGHT_MODE);
+}
+
+TEST(CrsfTelemetryTest, SkipsFramesWithoutData) {
+    CrsfTelemetry telem;
+    RCNavTelemetry_t nav = makeNav();
+    nav.gpsValid = false;
+    telem.setNav(nav);
+
+    uint8_t out[CRSF_MAX_FRAME_LEN];
+    uint32_t now = 0;
+    telem.onRcFrame(now, out, sizeof(out));
+    for (int i = 0; i < 4; i++) {
+        now += 6667;
+        ASSERT_GT(telem.onRcFrame(now, out, sizeof(out)), 0);
+        EXPECT_EQ(out[2], CRSF_FRAMETYPE_ATTITUDE);
+    }
+}
+
+TEST(CrsfTelemetryTest, RespectsMinimumInterval) {
+    CrsfTelemetry telem;
+    telem.setSystem(makeSystem());
+
+    // 500 Hz RC, telemetry may only use every other slot
+    uint8_t out[CRSF_MAX_FRAME_LEN];
+    uint32_t now = 0;
+    uint32_t sent = 0;
+    for (int i = 0; i < 101; i++) {
+        if (telem.onRcFrame(now, out, sizeof(out)) > 0) sent++;
+        now += 2000;
+    }
+    EXPECT_EQ(sent, 50u);
+    EXPECT_EQ(telem.getFramesSent(), 50u);
+}
+
+TEST(CrsfTelemetryTest, OnlySendsFramesThatFitTheSlot) {
+    CrsfTelemetry telem;
+    telem.setSystem(makeSystem());
+    telem.setNav(makeNav());
+
+    // 1 kHz RC leaves 800 us per slot, only frames up to 33 bytes fit
+    uint8_t out[CRSF_MAX_FRAME_LEN];
+    uint32_t now = 0;
+    for (int i = 0; i < 200; i++) {
+        uint8_t len = telem.onRcFrame(now, out, sizeof(out));
+        if (len > 0) {
+            EXPECT_LE(CrsfTelemetry::frameAirtimeUs(len) + CrsfTelemetry::SLOT_GUARD_US, 1000u);
+        }
+        now += 1000;
+    }
+    EXPECT_GT(telem.getFramesSent(), 0u);
+
+    EXPECT_EQ(CrsfTelemetry::frameAirtimeUs(CRSF_MAX_FRAME_LEN), 1524u);
+}
+
+TEST(CrsfTelemetryTest, LinkDropDoesNotSkewPeriod) {
+    CrsfTelemetry telem;
+    uint8_t out[CRSF_MAX_FRAME_LEN];
+    telem.onRcFrame(0, out, sizeof(out));
+    telem.onRcFrame(4000, out, sizeof(out));
+    telem.onRcFrame(2000000, out, sizeof(out));
+    EXPECT_EQ(telem.getRcFramePeriodUs(), 4000u);
+}
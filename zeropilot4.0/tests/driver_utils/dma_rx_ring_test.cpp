@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "dma_rx_ring.hpp"
+
+// Emulates a circular DMA writing into the buffer and firing events at the given positions
+class DmaRxRingTest : public ::testing::Test {
+protected:
+    static constexpr uint16_t SIZE = 64;
+    uint8_t buffer[SIZE] = {};
+    DmaRxRing ring{buffer, SIZE};
+    uint16_t dmaPos = 0;
+    uint8_t nextValue = 0;
+
+    void dmaWrite(uint16_t count) {
+        for (uint16_t i = 0; i < count; i++) {
+            buffer[dmaPos] = nextValue++;
+            dmaPos = (dmaPos + 1) % SIZE;
+            if (dmaPos == SIZE / 2 || dmaPos == 0) {
+                ring.onDmaEvent(dmaPos == 0 ? SIZE : dmaPos); // Half and full transfer events
+            }
+        }
+        ring.onDmaEvent(dmaPos); // Idle event
+    }
+
+    std::vector<uint8_t> drain() {
+        std::vector<uint8_t> out;
+        const uint8_t *data;
+        uint16_t len;
+        while ((len = ring.readSpan(data)) > 0) {
+            out.insert(out.end(), data, data + len);
+            ring.advance(len);
+        }
+        return out;
+    }
+};
+
+TEST_F(DmaRxRingTest, ReadsAcrossWrap) {
+    uint8_t expected = 0;
+    for (int round = 0; round < 20; round++) {
+        dmaWrite(23);
+        std::vector<uint8_t> got = drain();
+        ASSERT_EQ(got.size(), 23u);
+        for (uint8_t b : got) {
+            EXPECT_EQ(b, expected++);
+        }
+    }
+    EXPECT_EQ(ring.getOverrunBytes(), 0u);
+    EXPECT_FALSE(ring.takeDiscontinuity());
+}
+
+TEST_F(DmaRxRingTest, EmptyRingHasNoSpan) {
+    const uint8_t *data = nullptr;
+    EXPECT_EQ(ring.readSpan(data), 0);
+    EXPECT_EQ(ring.available(), 0);
+}
+
+TEST_F(DmaRxRingTest, PartialConsumeKeepsRemainder) {
+    dmaWrite(10);
+    const uint8_t *data;
+    ASSERT_EQ(ring.readSpan(data), 10);
+    ring.advance(4);
+    EXPECT_EQ(ring.available(), 6);
+    ASSERT_EQ(ring.readSpan(data), 6);
+    EXPECT_EQ(data[0], 4);
+}
+
+TEST_F(DmaRxRingTest, OverrunSkipsToNewestData) {
+    dmaWrite(10);
+    drain();
+    dmaWrite(SIZE + 5); // Reader stalled for more than a lap
+    EXPECT_TRUE(drain().empty());
+    EXPECT_EQ(ring.getOverrunBytes(), (uint32_t)SIZE + 5);
+    EXPECT_TRUE(ring.takeDiscontinuity());
+    EXPECT_FALSE(ring.takeDiscontinuity()); // Reported once
+
+    dmaWrite(7);
+    std::vector<uint8_t> got = drain();
+    ASSERT_EQ(got.size(), 7u);
+    EXPECT_EQ(got[0], (uint8_t)(10 + SIZE + 5));
+}
+
+TEST_F(DmaRxRingTest, RestartFromISRDropsUnreadAndResumesAtBufferStart) {
+    dmaWrite(20);
+    const uint8_t *data;
+    ASSERT_EQ(ring.readSpan(data), 20);
+    ring.advance(5); // Reader is mid span when the UART error restarts the DMA
+
+    dmaPos = 0;
+    ring.onDmaRestart();
+    dmaWrite(6); // Lands before the reader looks again
+
+    std::vector<uint8_t> got = drain();
+    ASSERT_EQ(got.size(), 6u);
+    EXPECT_EQ(got[0], 20);
+    EXPECT_EQ(ring.getOverrunBytes(), 0u);
+    EXPECT_TRUE(ring.takeDiscontinuity());
+
+    dmaWrite(SIZE - 2); // Wraps normally after the restart
+    got = drain();
+    ASSERT_EQ(got.size(), (size_t)(SIZE - 2));
+    EXPECT_EQ(got[0], 26);
+    EXPECT_EQ(dmaPos, 4);
+    EXPECT_FALSE(ring.takeDiscontinuity());
+}
+
+TEST_F(DmaRxRingTest, OverrunBetweenSpansIsReportedBeforeTheNextOne) {
+    dmaWrite(10);
+    const uint8_t *data;
+    ASSERT_EQ(ring.readSpan(data), 10);
+    EXPECT_FALSE(ring.takeDiscontinuity());
+    ring.advance(10);
+
+    // The DMA laps the reader while it is still working through the same read call
+    dmaWrite(SIZE + 3);
+    EXPECT_EQ(ring.readSpan(data), 0);
+    dmaWrite(4);
+    ASSERT_EQ(ring.readSpan(data), 4);
+    EXPECT_TRUE(ring.takeDiscontinuity());
+    EXPECT_EQ(data[0], (uint8_t)(10 + SIZE + 3));
+}
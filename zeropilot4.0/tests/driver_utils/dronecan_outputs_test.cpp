@@ -0,0 +1,328 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "dronecan_outputs.hpp"
+#include "can_controller.hpp"
+#include "mock_systemutils.hpp"
+#include "virtual_can_bus.hpp"
+
+using ::testing::NiceMock;
+using ::testing::Invoke;
+
+static constexpr uint8_t POLE_PAIRS = 7;
+static constexpr uint32_t CAN_BITS_PER_US = CAN_BITRATE_BPS / 1000000;
+
+// Quad with four DroneCAN servos, the AM running at 400 Hz and every ESC reporting at 50 Hz
+static constexpr uint8_t LOAD_ESC_COUNT = 4;
+static constexpr uint8_t LOAD_SERVO_COUNT = 4;
+static constexpr uint32_t LOAD_LOOP_RATE_HZ = 400;
+static constexpr uint32_t LOAD_LOOP_PERIOD_US = 1000000 / LOAD_LOOP_RATE_HZ;
+static constexpr uint32_t LOAD_STATUS_PERIOD_MS = 20;
+static constexpr float LOAD_MAX_BUS_UTILISATION = 0.25f;
+
+static uint32_t commandsReadyCalls = 0;
+static void onCommandsReady() { commandsReadyCalls++; }
+
+// DroneCAN ESC on the virtual bus: records the commands it is sent and reports esc.Status
+class EscNode {
+    public:
+        EscNode(VirtualCANBus &bus, uint8_t nodeId, const uint32_t &nowMs) : bus(bus), nowMs(nowMs), pool{} {
+            canardInit(&canard, pool, sizeof(pool), &EscNode::onReception, &EscNode::shouldAccept, this);
+            canardSetLocalNodeID(&canard, nodeId);
+            port = &bus.addPort([this](const CANFrame_t &frame) { receive(frame); });
+        }
+
+        void sendStatus(uint8_t escIndex, int32_t rpm, float current) {
+            uavcan_equipment_esc_Status status {};
+            status.esc_index = escIndex;
+            status.rpm = rpm;
+            status.current = current;
+            status.voltage = 16.0f;
+            status.temperature = 310.0f;
+            uint8_t buffer[UAVCAN_EQUIPMENT_ESC_STATUS_MAX_SIZE];
+            const uint32_t len = uavcan_equipment_esc_Status_encode(&status, buffer);
+            canardBroadcast(&canard, UAVCAN_EQUIPMENT_ESC_STATUS_SIGNATURE, UAVCAN_EQUIPMENT_ESC_STATUS_ID,
+                &statusTransferId, CANARD_TRANSFER_PRIORITY_LOW, buffer, static_cast<uint16_t>(len));
+            flushTx();
+        }
+
+        uint32_t rawCommands = 0;
+        std::vector<int16_t> lastRaw;
+        uint64_t lastRawArrivalBits = 0;    // Bus bit count when the last RawCommand completed
+
+        uint32_t arrayCommands = 0;
+        std::vector<uavcan_equipment_actuator_Command> lastArray;
+
+    private:
+        VirtualCANBus &bus;
+        const uint32_t &nowMs;
+        CanardInstance canard;
+        alignas(8) uint8_t pool[4096];
+        VirtualCANBus::Port *port;
+        uint8_t statusTransferId = 0;
+
+        void flushTx() {
+            for (CanardCANFrame *frame = canardPeekTxQueue(&canard); frame != nullptr; frame = canardPeekTxQueue(&canard)) {
+                CANFrame_t out {};
+                out.id = frame->id & CANARD_CAN_EXT_ID_MASK;
+                out.len = frame->data_len;
+                memcpy(out.data, frame->data, frame->data_len);
+                if (!port->transmit(out)) return;
+                canardPopTxQueue(&canard);
+            }
+        }
+
+        void receive(const CANFrame_t &frame) {
+            CanardCANFrame in;
+            in.id = frame.id | CANARD_CAN_FRAME_EFF;
+            in.data_len = frame.len;
+            memcpy(in.data, frame.data, frame.len);
+            canardHandleRxFrame(&canard, &in, nowMs * 1000ULL);
+            flushTx();
+        }
+
+        static bool shouldAccept(const CanardInstance *, uint64_t *signature, uint16_t dataTypeId, CanardTransferType, uint8_t) {
+            if (dataTypeId == UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_ID) {
+                *signature = UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_SIGNATURE;
+                return true;
+            }
+            if (dataTypeId == UAVCAN_EQUIPMENT_ACTUATOR_ARRAYCOMMAND_ID) {
+                *signature = UAVCAN_EQUIPMENT_ACTUATOR_ARRAYCOMMAND_SIGNATURE;
+                return true;
+            }
+            return false;
+        }
+
+        static void onReception(CanardInstance *ins, CanardRxTransfer *transfer) {
+            EscNode *self = static_cast<EscNode *>(canardGetUserReference(ins));
+            if (transfer->data_type_id == UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_ID) {
+                uavcan_equipment_esc_RawCommand msg {};
+                if (!uavcan_equipment_esc_RawCommand_decode(transfer, &msg)) {
+                    self->rawCommands++;
+                    self->lastRaw.assign(msg.cmd.data, msg.cmd.data + msg.cmd.len);
+                    self->lastRawArrivalBits = self->bus.getBitsOnWire();
+                }
+            } else if (transfer->data_type_id == UAVCAN_EQUIPMENT_ACTUATOR_ARRAYCOMMAND_ID) {
+                uavcan_equipment_actuator_ArrayCommand msg {};
+                if (!uavcan_equipment_actuator_ArrayCommand_decode(transfer, &msg)) {
+                    self->arrayCommands++;
+                    self->lastArray.assign(msg.commands.data, msg.commands.data + msg.commands.len);
+                }
+            }
+        }
+};
+
+class DroneCANOutputsTest : public ::testing::Test {
+protected:
+    uint32_t nowMs = 1000; // libcanard reads a zero timestamp as no transfer in progress
+    NiceMock<MockSystemUtils> systemUtils;
+    VirtualCANBus bus;
+    LatestValueSlot<ActuatorCommand_t> commandSlot;
+    EscStatusTable escTable;
+    DroneCANOutputGroup group{&commandSlot, &escTable, &systemUtils, POLE_PAIRS, &onCommandsReady};
+    VirtualCANBus::Port *controllerPort = nullptr;
+    std::unique_ptr<CANController> controller;
+
+    void SetUp() override {
+        ON_CALL(systemUtils, getCurrentTimestampMs()).WillByDefault(Invoke([this]() { return nowMs; }));
+        commandsReadyCalls = 0;
+
+        controllerPort = &bus.addPort([this](const CANFrame_t &frame) {
+            controller->enqueueRxFrame(frame.id, frame.len, frame.data);
+        });
+        controller.reset(new CANController(controllerPort, &systemUtils, nullptr, &commandSlot, &escTable));
+    }
+
+    // One bus task wake from the commands-ready hook, then one more per TX complete until everything is out
+    void service() {
+        controller->routineTasks();
+        while (bus.step() > 0) {
+            controller->routineTasks();
+        }
+    }
+};
+
+TEST_F(DroneCANOutputsTest, GroupPublishesOnceEveryOutputIsSet) {
+    DroneCANMotorControl esc0(&group, DroneCANOutputType_e::ESC, 0);
+    DroneCANMotorControl esc1(&group, DroneCANOutputType_e::ESC, 1);
+    DroneCANMotorControl servo(&group, DroneCANOutputType_e::SERVO, 5);
+    DroneCANMotorControl duplicate(&group, DroneCANOutputType_e::ESC, 1);
+
+    esc0.setArm(true);
+    esc1.setArm(true);
+    esc0.setNormalized(0.5f);
+    esc1.setNormalized(1.0f);
+    duplicate.setNormalized(0.0f);
+    EXPECT_EQ(group.getPublishCount(), 0u);
+    EXPECT_EQ(commandsReadyCalls, 0u);
+
+    servo.setNormalized(0.75f);
+    EXPECT_EQ(group.getPublishCount(), 1u);
+    EXPECT_EQ(commandsReadyCalls, 1u);
+
+    ActuatorCommand_t command;
+    uint32_t seq = 0;
+    ASSERT_TRUE(commandSlot.readIfNew(command, seq));
+    EXPECT_EQ(command.escCount, 2);
+    EXPECT_EQ(command.escRaw[0], 4096);
+    EXPECT_EQ(command.escRaw[1], ESC_RAW_COMMAND_FULL_SCALE);
+    ASSERT_EQ(command.servoCount, 1);
+    EXPECT_EQ(command.servoId[0], 5);
+    EXPECT_FLOAT_EQ(command.servoCommand[0], 0.5f);
+}
+
+TEST_F(DroneCANOutputsTest, SkippedOutputDoesNotStallTheGroup) {
+    DroneCANMotorControl esc0(&group, DroneCANOutputType_e::ESC, 0);
+    DroneCANMotorControl esc1(&group, DroneCANOutputType_e::ESC, 1);
+    esc0.setArm(true);
+    esc1.setArm(true);
+
+    esc0.setNormalized(0.5f);
+    esc1.setNormalized(0.5f);
+    EXPECT_EQ(group.getPublishCount(), 1u);
+
+    // esc1 is no longer driven, the next tick of esc0 flushes the one before it
+    esc0.setNormalized(1.0f);
+    esc0.setNormalized(0.0f);
+    EXPECT_EQ(group.getPublishCount(), 2u);
+
+    ActuatorCommand_t command;
+    uint32_t seq = 0;
+    ASSERT_TRUE(commandSlot.readIfNew(command, seq));
+    EXPECT_EQ(command.escRaw[0], ESC_RAW_COMMAND_FULL_SCALE);
+    EXPECT_EQ(command.escRaw[1], 4096);
+}
+
+TEST_F(DroneCANOutputsTest, RawCommandReachesEscsWithDisarmedOutputsAtZero) {
+    EscNode escNode(bus, 20, nowMs);
+    DroneCANMotorControl esc0(&group, DroneCANOutputType_e::ESC, 0);
+    DroneCANMotorControl esc3(&group, DroneCANOutputType_e::ESC, 3);
+
+    esc0.setArm(false);
+    esc3.setArm(true);
+    esc0.setNormalized(0.8f);
+    esc3.setNormalized(0.25f);
+    service();
+
+    ASSERT_EQ(escNode.rawCommands, 1u);
+    ASSERT_EQ(escNode.lastRaw.size(), 4u);
+    EXPECT_EQ(escNode.lastRaw[0], 0);
+    EXPECT_EQ(escNode.lastRaw[1], 0);
+    EXPECT_EQ(escNode.lastRaw[2], 0);
+    EXPECT_EQ(escNode.lastRaw[3], 2048);
+}
+
+TEST_F(DroneCANOutputsTest, ServoCommandsAreRateLimited) {
+    EscNode servoNode(bus, 30, nowMs);
+    DroneCANMotorControl servo(&group, DroneCANOutputType_e::SERVO, 7);
+
+    for (uint32_t i = 0; i < 1000; i++, nowMs++) {
+        servo.setNormalized(0.75f);
+        service();
+    }
+
+    EXPECT_NEAR(servoNode.arrayCommands, 1000 / CAN_SERVO_COMMAND_PERIOD_MS, 1);
+    ASSERT_EQ(servoNode.lastArray.size(), 1u);
+    EXPECT_EQ(servoNode.lastArray[0].actuator_id, 7);
+    EXPECT_EQ(servoNode.lastArray[0].command_type, UAVCAN_EQUIPMENT_ACTUATOR_COMMAND_COMMAND_TYPE_UNITLESS);
+    EXPECT_FLOAT_EQ(servoNode.lastArray[0].command_value, 0.5f);
+}
+
+TEST_F(DroneCANOutputsTest, EscStatusFeedsTableAndErpm) {
+    EscNode escNode(bus, 20, nowMs);
+    DroneCANMotorControl esc(&group, DroneCANOutputType_e::ESC, 2);
+
+    uint32_t erpm = 0;
+    EXPECT_FALSE(esc.readErpm(erpm));
+
+    escNode.sendStatus(2, -1500, 12.5f);
+    service();
+
+    EscStatus_t status;
+    uint32_t seq = 0;
+    ASSERT_TRUE(escTable.readIfNew(2, status, seq));
+    EXPECT_EQ(status.rpm, -1500);
+    EXPECT_FLOAT_EQ(status.current, 12.5f);
+    EXPECT_FLOAT_EQ(status.voltage, 16.0f);
+
+    // Reverse rotation still gives the notch a positive frequency
+    ASSERT_TRUE(esc.readErpm(erpm));
+    EXPECT_EQ(erpm, 1500u * POLE_PAIRS);
+
+    nowMs += DroneCANOutputGroup::ESC_STATUS_TIMEOUT_MS + 1;
+    EXPECT_FALSE(esc.readErpm(erpm));
+}
+
+TEST_F(DroneCANOutputsTest, CommandLatencyAndBusUtilisationAt400Hz) {
+    std::vector<std::unique_ptr<EscNode>> escNodes;
+    std::vector<std::unique_ptr<DroneCANMotorControl>> motors;
+    std::vector<std::unique_ptr<DroneCANMotorControl>> servos;
+    for (uint8_t i = 0; i < LOAD_ESC_COUNT; i++) {
+        escNodes.emplace_back(new EscNode(bus, 20 + i, nowMs));
+        motors.emplace_back(new DroneCANMotorControl(&group, DroneCANOutputType_e::ESC, i));
+        motors.back()->setArm(true);
+    }
+    for (uint8_t i = 0; i < LOAD_SERVO_COUNT; i++) {
+        servos.emplace_back(new DroneCANMotorControl(&group, DroneCANOutputType_e::SERVO, 1 + i));
+    }
+
+    const uint32_t startMs = nowMs;
+    uint64_t maxLatencyBits = 0;
+    for (uint32_t tick = 0; tick < LOAD_LOOP_RATE_HZ; tick++) {
+        nowMs = startMs + tick * LOAD_LOOP_PERIOD_US / 1000;
+
+        // ESCs report staggered across the status period, their frames contend with the commands
+        for (uint8_t i = 0; i < LOAD_ESC_COUNT; i++) {
+            if (tick * LOAD_LOOP_PERIOD_US % (LOAD_STATUS_PERIOD_MS * 1000) == i * LOAD_STATUS_PERIOD_MS * 1000 / LOAD_ESC_COUNT) {
+                escNodes[i]->sendStatus(i, 2000 + i, 5.0f);
+            }
+        }
+
+        const uint64_t tickStartBits = bus.getBitsOnWire();
+        const float command = (tick % 100) / 100.0f;
+        for (auto &motor : motors) {
+            motor->setNormalized(command);
+        }
+        for (auto &servo : servos) {
+            servo->setNormalized(command);
+        }
+        service();
+
+        for (auto &escNode : escNodes) {
+            ASSERT_EQ(escNode->rawCommands, tick + 1) << "RawCommand of tick " << tick << " did not arrive within the tick";
+            ASSERT_EQ(escNode->lastRaw.size(), LOAD_ESC_COUNT);
+            EXPECT_EQ(escNode->lastRaw[0], static_cast<int16_t>(command * ESC_RAW_COMMAND_FULL_SCALE + 0.5f));
+        }
+
+        const uint64_t latencyBits = escNodes[0]->lastRawArrivalBits - tickStartBits;
+        if (latencyBits > maxLatencyBits) {
+            maxLatencyBits = latencyBits;
+        }
+    }
+
+    const float utilisation = static_cast<float>(bus.getBitsOnWire()) / CAN_BITRATE_BPS;
+    const uint32_t maxLatencyUs = static_cast<uint32_t>(maxLatencyBits / CAN_BITS_PER_US);
+    RecordProperty("max_command_latency_us", static_cast<int>(maxLatencyUs));
+    RecordProperty("bus_utilisation_pct", static_cast<int>(utilisation * 100.0f + 0.5f));
+
+    EXPECT_EQ(commandsReadyCalls, LOAD_LOOP_RATE_HZ);
+
+    // RawCommand outranks everything else queued, so it waits at most for one frame already on the wire
+    EXPECT_LE(maxLatencyUs, 2 * VirtualCANBus::frameBits(CAN_FRAME_MAX_DATA_LEN) / CAN_BITS_PER_US);
+    EXPECT_LT(utilisation, LOAD_MAX_BUS_UTILISATION);
+
+    EXPECT_NEAR(escNodes[0]->arrayCommands, 1000 / CAN_SERVO_COMMAND_PERIOD_MS, 1);
+
+    const CANBusStats_t stats = controller->getStats();
+    EXPECT_EQ(stats.txQueueFull, 0u);
+    EXPECT_EQ(stats.rxPoolExhausted, 0u);
+    EXPECT_EQ(stats.rxRingOverruns, 0u);
+
+    uint32_t erpm = 0;
+    for (uint8_t i = 0; i < LOAD_ESC_COUNT; i++) {
+        ASSERT_TRUE(motors[i]->readErpm(erpm));
+        EXPECT_EQ(erpm, (2000u + i) * POLE_PAIRS);
+    }
+}
@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include "dronecan_sensors.hpp"
+#include "can_controller.hpp"
+#include "mock_systemutils.hpp"
+#include "virtual_can_bus.hpp"
+
+using ::testing::NiceMock;
+using ::testing::Invoke;
+
+/*
+ * candump -L log of one second of a DroneCAN sensor bus: GNSS on node 20, baro on 21, a node with
+ * two compasses on 22, a pitot on 23 and a second GNSS on 30 that starts talking after the first.
+ * Built from known encoded values so the expectations below can be exact.
+ */
+static const char *const SENSOR_BUS_CAPTURE[] = {
+    "(1760875200.100000) can0 18015514#0C000000000000C0\n",
+    "(1760875200.100150) can0 18015515#0C000000000000C0\n",
+    "(1760875200.100300) can0 18015516#0C000000000000C0\n",
+    "(1760875200.100450) can0 18015517#0C000000000000C0\n",
+    "(1760875200.100600) can0 1801551E#28000000000000C0\n",
+    "(1760875200.110750) can0 10040515#955C003CC0\n",
+    "(1760875200.110900) can0 10040415#006EBE470044C0\n",
+    "(1760875200.121050) can0 1003EA16#00C33166AAB836C0\n",
+    "(1760875200.121200) can0 1003EA16#01CDB466AAB836C1\n",
+    "(1760875200.131350) can0 10040317#85E900006EBE4780\n",
+    "(1760875200.131500) can0 10040317#00007543007EBD20\n",
+    "(1760875200.131649) can0 10040317#5C007E007E40\n",
+    "(1760875200.141799) can0 10042714#9A79000000000080\n",
+    "(1760875200.141949) can0 10042714#00009000CEB48120\n",
+    "(1760875200.142099) can0 10042714#4106400000703C00\n",
+    "(1760875200.142249) can0 10042714#EA1FF183B8E81820\n",
+    "(1760875200.142399) can0 10042714#53208100E0382800\n",
+    "(1760875200.142549) can0 10042714#0000404000008020\n",
+    "(1760875200.142699) can0 10042714#40000000BF3B0000\n",
+    "(1760875200.142849) can0 10042714#0600341F317B3A20\n",
+    "(1760875200.142999) can0 10042714#1F211F211F21CD00\n",
+    "(1760875200.143149) can0 10042714#3C60\n",
+    "(1760875200.153299) can0 1004271E#D9A4000000000080\n",
+    "(1760875200.153449) can0 1004271E#00009000CEB48120\n",
+    "(1760875200.153599) can0 1004271E#410640000000C200\n",
+    "(1760875200.153749) can0 1004271E#EB0B00070FA82820\n",
+    "(1760875200.153899) can0 1004271E#13208100E0382800\n",
+    "(1760875200.154049) can0 1004271E#0000104100008020\n",
+    "(1760875200.154199) can0 1004271E#40000000BF3B0000\n",
+    "(1760875200.154349) can0 1004271E#0600341F317B3A20\n",
+    "(1760875200.154499) can0 1004271E#1F211F211F21CD00\n",
+    "(1760875200.154649) can0 1004271E#3C60\n",
+};
+
+static const uint16_t ACCEPTED_IDS[] = {
+    UAVCAN_PROTOCOL_DYNAMIC_NODE_ID_ALLOCATION_ID,
+    UAVCAN_PROTOCOL_NODESTATUS_ID,
+    UAVCAN_EQUIPMENT_AHRS_MAGNETICFIELDSTRENGTH2_ID,
+    UAVCAN_EQUIPMENT_AIR_DATA_RAWAIRDATA_ID,
+    UAVCAN_EQUIPMENT_AIR_DATA_STATICPRESSURE_ID,
+    UAVCAN_EQUIPMENT_AIR_DATA_STATICTEMPERATURE_ID,
+    UAVCAN_EQUIPMENT_ESC_STATUS_ID,
+    UAVCAN_EQUIPMENT_GNSS_FIX2_ID,
+};
+
+class DroneCANSensorsTest : public ::testing::Test {
+protected:
+    uint32_t nowMs = 1000; // libcanard reads a zero timestamp as no transfer in progress
+    NiceMock<MockSystemUtils> systemUtils;
+    VirtualCANBus bus;
+    VirtualCANBus::Port *port = &bus.addPort(nullptr);
+    EscStatusTable escTable;
+    DroneCANGPS gps;
+    DroneCANBarometer barometer;
+    DroneCANMagnetometer magnetometer;
+    DroneCANAirspeed airspeed;
+    std::unique_ptr<CANController> controller;
+    double captureStart = -1.0;
+
+    void SetUp() override {
+        ON_CALL(systemUtils, getCurrentTimestampMs()).WillByDefault(Invoke([this]() { return nowMs; }));
+        controller.reset(new CANController(port, &systemUtils, nullptr, nullptr, &escTable,
+            &gps, &barometer, &magnetometer, &airspeed));
+    }
+
+    // Feed candump -L lines through the RX ring, servicing the bus task after every frame
+    void replay(const char *const *lines, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            double timestamp;
+            char interface[16];
+            uint32_t id;
+            char hex[2 * CAN_FRAME_MAX_DATA_LEN + 1];
+            ASSERT_EQ(sscanf(lines[i], "(%lf) %15s %8x#%16s", &timestamp, interface, &id, hex), 4) << lines[i];
+
+            uint8_t data[CAN_FRAME_MAX_DATA_LEN];
+            const uint8_t len = static_cast<uint8_t>(strlen(hex) / 2);
+            for (uint8_t b = 0; b < len; b++) {
+                unsigned int byte;
+                sscanf(&hex[2 * b], "%2x", &byte);
+                data[b] = static_cast<uint8_t>(byte);
+            }
+
+            if (captureStart < 0.0) captureStart = timestamp;
+            nowMs = 1000 + static_cast<uint32_t>((timestamp - captureStart) * 1000.0 + 0.5);
+
+            ASSERT_TRUE(controller->enqueueRxFrame(id, len, data));
+            controller->routineTasks();
+            bus.step();
+        }
+    }
+
+    void replayCapture() {
+        replay(SENSOR_BUS_CAPTURE, sizeof(SENSOR_BUS_CAPTURE) / sizeof(SENSOR_BUS_CAPTURE[0]));
+    }
+};
+
+TEST_F(DroneCANSensorsTest, ReplayDecodesEverySensor) {
+    replayCapture();
+
+    GpsData_t fix = gps.readData();
+    ASSERT_TRUE(fix.isNew);
+    EXPECT_NEAR(fix.latitude, 43.4723f, 1e-5f);
+    EXPECT_NEAR(fix.longitude, -80.5449f, 1e-5f);
+    EXPECT_FLOAT_EQ(fix.altitude, 329.5f);
+    EXPECT_EQ(fix.numSatellites, 14);
+    EXPECT_FLOAT_EQ(fix.vx, 3.0f);
+    EXPECT_FLOAT_EQ(fix.vy, 4.0f);
+    EXPECT_FLOAT_EQ(fix.vz, -0.5f);
+    EXPECT_FLOAT_EQ(fix.groundSpeed, 500.0f);
+    EXPECT_NEAR(fix.trackAngle, 53.13f, 0.01f);
+    EXPECT_NEAR(fix.hAcc, 0.5f, 1e-3f);
+    EXPECT_NEAR(fix.vAcc, 0.9f, 1e-3f);
+    EXPECT_EQ(fix.solutionTimeMs, 12u * 3600u * 1000u + 250u);
+    EXPECT_EQ(fix.time.year, 2025);
+    EXPECT_EQ(fix.time.month, 10);
+    EXPECT_EQ(fix.time.day, 19);
+    EXPECT_EQ(fix.time.hour, 12);
+    EXPECT_EQ(fix.time.minute, 0);
+    EXPECT_EQ(fix.time.second, 0);
+
+    // Temperatures and the compass are float16 on the wire
+    BaroData_t baro;
+    ASSERT_TRUE(barometer.readData(baro));
+    EXPECT_FLOAT_EQ(baro.pressureKPa, 97.5f);
+    EXPECT_NEAR(baro.temperatureC, 20.0f, 0.2f);
+    EXPECT_NEAR(baro.altitude, 323.38f, 0.05f);
+
+    MagData_t mag;
+    ASSERT_TRUE(magnetometer.readData(mag));
+    EXPECT_NEAR(mag.x, 0.18f, 1e-3f);
+    EXPECT_NEAR(mag.y, -0.05f, 1e-3f);
+    EXPECT_NEAR(mag.z, 0.42f, 1e-3f);
+
+    AirspeedData_t air;
+    ASSERT_TRUE(airspeed.readData(air));
+    EXPECT_FLOAT_EQ(air.differentialPressurePa, 245.0f);
+    EXPECT_NEAR(air.temperatureC, 30.0f, 0.2f);
+    EXPECT_NEAR(air.airspeed, 20.0f, 1e-3f);
+}
+
+TEST_F(DroneCANSensorsTest, EachSampleIsNewOnce) {
+    replayCapture();
+
+    EXPECT_TRUE(gps.readData().isNew);
+    EXPECT_FALSE(gps.readData().isNew);
+    EXPECT_EQ(gps.getPublishCount(), 1u); // The second receiver never got through
+
+    BaroData_t baro {};
+    EXPECT_TRUE(barometer.readData(baro));
+    baro = {};
+    EXPECT_FALSE(barometer.readData(baro));
+    EXPECT_FLOAT_EQ(baro.pressureKPa, 97.5f); // Still the latest sample
+}
+
+TEST_F(DroneCANSensorsTest, NothingReadBeforeFirstSample) {
+    GpsData_t fix = gps.readData();
+    EXPECT_FALSE(fix.isNew);
+    EXPECT_EQ(fix.altitude, INVALID_ALTITUDE);
+    EXPECT_EQ(fix.hAcc, INVALID_ACCURACY);
+
+    MagData_t mag = {1.0f, 2.0f, 3.0f};
+    EXPECT_FALSE(magnetometer.readData(mag));
+    EXPECT_EQ(mag.x, 1.0f);
+}
+
+TEST_F(DroneCANSensorsTest, AcceptsExactlyTheTableIds) {
+    for (uint32_t id = 0; id <= UINT16_MAX; id++) {
+        uint64_t signature = 0;
+        const bool accepted = controller->CanardShouldAcceptTransfer(nullptr, &signature,
+            static_cast<uint16_t>(id), CanardTransferTypeBroadcast, 20);
+        const bool expected = std::find(std::begin(ACCEPTED_IDS), std::end(ACCEPTED_IDS), id) != std::end(ACCEPTED_IDS);
+        EXPECT_EQ(accepted, expected) << "data type " << id;
+    }
+
+    uint64_t signature = 0;
+    EXPECT_TRUE(controller->CanardShouldAcceptTransfer(nullptr, &signature, UAVCAN_EQUIPMENT_GNSS_FIX2_ID, CanardTransferTypeBroadcast, 20));
+    EXPECT_EQ(signature, UAVCAN_EQUIPMENT_GNSS_FIX2_SIGNATURE);
+    EXPECT_FALSE(controller->CanardShouldAcceptTransfer(nullptr, &signature, UAVCAN_EQUIPMENT_GNSS_FIX2_ID, CanardTransferTypeRequest, 20));
+}
+
+TEST_F(DroneCANSensorsTest, RejectsSensorsWithoutASlot) {
+    CANController bare(port, &systemUtils);
+    const uint16_t sensorIds[] = {
+        UAVCAN_EQUIPMENT_AHRS_MAGNETICFIELDSTRENGTH2_ID,
+        UAVCAN_EQUIPMENT_AIR_DATA_RAWAIRDATA_ID,
+        UAVCAN_EQUIPMENT_AIR_DATA_STATICPRESSURE_ID,
+        UAVCAN_EQUIPMENT_AIR_DATA_STATICTEMPERATURE_ID,
+        UAVCAN_EQUIPMENT_ESC_STATUS_ID,
+        UAVCAN_EQUIPMENT_GNSS_FIX2_ID,
+    };
+
+    uint64_t signature = 0;
+    for (uint16_t id : sensorIds) {
+        EXPECT_FALSE(bare.CanardShouldAcceptTransfer(nullptr, &signature, id, CanardTransferTypeBroadcast, 20)) << id;
+    }
+    EXPECT_TRUE(bare.CanardShouldAcceptTransfer(nullptr, &signature, UAVCAN_PROTOCOL_NODESTATUS_ID, CanardTransferTypeBroadcast, 20));
+}
+
+TEST_F(DroneCANSensorsTest, SecondReceiverTakesOverWhenFirstGoesOffline) {
+    replayCapture();
+    ASSERT_TRUE(gps.readData().isNew);
+
+    // Node 20 falls silent, node 30 keeps sending NodeStatus and its fix
+    static const char *const secondReceiverOnly[] = {
+        "(1760875201.100000) can0 1801551E#29000000000000C1\n",
+        "(1760875202.100000) can0 1801551E#2A000000000000C2\n",
+        "(1760875203.100000) can0 1801551E#2B000000000000C3\n",
+        "(1760875204.100000) can0 1801551E#2C000000000000C4\n",
+        "(1760875204.153299) can0 1004271E#D9A4000000000081\n",
+        "(1760875204.153449) can0 1004271E#00009000CEB48121\n",
+        "(1760875204.153599) can0 1004271E#410640000000C201\n",
+        "(1760875204.153749) can0 1004271E#EB0B00070FA82821\n",
+        "(1760875204.153899) can0 1004271E#13208100E0382801\n",
+        "(1760875204.154049) can0 1004271E#0000104100008021\n",
+        "(1760875204.154199) can0 1004271E#40000000BF3B0001\n",
+        "(1760875204.154349) can0 1004271E#0600341F317B3A21\n",
+        "(1760875204.154499) can0 1004271E#1F211F211F21CD01\n",
+        "(1760875204.154649) can0 1004271E#3C61\n",
+    };
+    replay(secondReceiverOnly, sizeof(secondReceiverOnly) / sizeof(secondReceiverOnly[0]));
+
+    EXPECT_FALSE(controller->getNode(30).isOffline());
+    EXPECT_TRUE(controller->getNode(20).isOffline());
+
+    GpsData_t fix = gps.readData();
+    ASSERT_TRUE(fix.isNew);
+    EXPECT_NEAR(fix.latitude, 1.0f, 1e-6f);
+    EXPECT_NEAR(fix.longitude, 2.0f, 1e-6f);
+    EXPECT_FLOAT_EQ(fix.vx, 9.0f);
+}
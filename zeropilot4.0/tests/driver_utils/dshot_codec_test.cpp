@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include "dshot_codec.hpp"
+
+static constexpr uint16_t BIT_TICKS = 640; // DShot300 reply bit at 240 MHz
+
+// Input capture timestamps for a line, one per level change, starting at the start bit
+static std::vector<uint16_t> lineToEdges(uint32_t line, uint16_t startTick, uint16_t jitter = 0) {
+    std::vector<uint16_t> edges;
+    bool level = true; // Idle high
+    for (int8_t i = DSHOT_TELEM_LINE_BITS - 1; i >= 0; i--) {
+        bool bit = (line >> i) & 1;
+        if (bit != level) {
+            uint16_t wobble = (edges.size() % 2) ? jitter : (uint16_t)-jitter;
+            edges.push_back((uint16_t)(startTick + (DSHOT_TELEM_LINE_BITS - 1 - i) * BIT_TICKS + wobble));
+            level = bit;
+        }
+    }
+    // Back to idle after the last bit
+    if (!level) edges.push_back((uint16_t)(startTick + DSHOT_TELEM_LINE_BITS * BIT_TICKS));
+    return edges;
+}
+
+TEST(DshotCodecTest, EncodesFrame) {
+    // 1046 with no telemetry request is 1000001011000110
+    EXPECT_EQ(DshotCodec::encodeFrame(1046, false, false), 0x82C6);
+    EXPECT_EQ(DshotCodec::encodeFrame(1046, false, true), 0x82C9);
+    EXPECT_EQ(DshotCodec::encodeFrame(0, false, false), 0x0000);
+    EXPECT_EQ(DshotCodec::encodeFrame(DSHOT_VALUE_MAX, true, false) >> 5, DSHOT_VALUE_MAX);
+}
+
+TEST(DshotCodecTest, EncodesKnownFrames) {
+    EXPECT_EQ(DshotCodec::encodeFrame(DSHOT_THROTTLE_MIN, false, false), 0x0606);
+    EXPECT_EQ(DshotCodec::encodeFrame(DSHOT_VALUE_MAX, false, false), 0xFFEE);
+    EXPECT_EQ(DshotCodec::encodeFrame(DSHOT_VALUE_MAX, true, false), 0xFFFF);
+}
+
+TEST(DshotCodecTest, TimingForEachRate) {
+    DshotTiming_t timing;
+
+    // H753 TIM1 at 240 MHz and L552 TIM3 at 110 MHz keep their existing DShot300 compare values
+    ASSERT_TRUE(DshotCodec::timingForRate(240000000, 300, timing));
+    EXPECT_EQ(timing.period, 800);
+    EXPECT_EQ(timing.oneCompare, 600);
+    EXPECT_EQ(timing.zeroCompare, 300);
+    EXPECT_EQ(timing.replyBitTicks, 640);
+
+    ASSERT_TRUE(DshotCodec::timingForRate(110000000, 300, timing));
+    EXPECT_EQ(timing.period, 367);
+    EXPECT_EQ(timing.oneCompare, 275);
+    EXPECT_EQ(timing.zeroCompare, 137);
+
+    ASSERT_TRUE(DshotCodec::timingForRate(240000000, 150, timing));
+    EXPECT_EQ(timing.period, 1600);
+    ASSERT_TRUE(DshotCodec::timingForRate(240000000, 600, timing));
+    EXPECT_EQ(timing.period, 400);
+    ASSERT_TRUE(DshotCodec::timingForRate(240000000, 1200, timing));
+    EXPECT_EQ(timing.period, 200);
+    EXPECT_EQ(timing.oneCompare, 150);
+    EXPECT_EQ(timing.zeroCompare, 75);
+
+    EXPECT_FALSE(DshotCodec::timingForRate(240000000, 400, timing));
+    EXPECT_FALSE(DshotCodec::timingForRate(16000000, 1200, timing));   // 13 ticks per bit
+    EXPECT_FALSE(DshotCodec::timingForRate(240000000, 0, timing));
+}
+
+TEST(DshotCodecTest, ScalesThrottleWithoutFloats) {
+    EXPECT_EQ(DshotCodec::scaleThrottle(0, 100, DSHOT_THROTTLE_MIN), DSHOT_THROTTLE_MIN);
+    EXPECT_EQ(DshotCodec::scaleThrottle(100, 100, DSHOT_THROTTLE_MIN), DSHOT_VALUE_MAX);
+    EXPECT_EQ(DshotCodec::scaleThrottle(50, 100, DSHOT_THROTTLE_MIN), 1048);
+    EXPECT_EQ(DshotCodec::scaleThrottle(250, 100, DSHOT_THROTTLE_MIN), DSHOT_VALUE_MAX);
+    EXPECT_EQ(DshotCodec::scaleThrottle(10, 0, DSHOT_THROTTLE_MIN), DSHOT_THROTTLE_MIN);
+
+    // Full 11 bit resolution, every step of a 16 bit command is monotonic
+    uint16_t last = DSHOT_THROTTLE_MIN;
+    for (uint32_t q = 0; q <= 0xFFFF; q++) {
+        uint16_t value = DshotCodec::scaleThrottle((uint16_t)q, 0xFFFF, DSHOT_THROTTLE_MIN);
+        ASSERT_GE(value, last);
+        ASSERT_LE(value - last, 1);
+        last = value;
+    }
+}
+
+TEST(DshotCodecTest, CompareTableMatchesBitLoop) {
+    DshotCompareTable table;
+    table.build(600, 300);
+
+    uint16_t expected[DSHOT_FRAME_SLOTS * 4];
+    uint16_t actual[DSHOT_FRAME_SLOTS * 4];
+    for (uint32_t frame = 0; frame <= 0xFFFF; frame++) {
+        DshotCodec::frameToCompare((uint16_t)frame, 600, 300, expected);
+        table.frameToCompare((uint16_t)frame, actual);
+        ASSERT_EQ(memcmp(expected, actual, DSHOT_FRAME_SLOTS * sizeof(uint16_t)), 0) << "frame " << frame;
+    }
+
+    uint16_t frame = DshotCodec::encodeFrame(1046, false, true);
+    DshotCodec::frameToCompare(frame, 600, 300, &expected[3], 4);
+    table.frameToCompare(frame, &actual[3], 4);
+    for (uint8_t i = 0; i < DSHOT_FRAME_SLOTS; i++) {
+        EXPECT_EQ(actual[i * 4 + 3], expected[i * 4 + 3]);
+    }
+}
+
+TEST(DshotCodecTest, FrameToCompareInterleaves) {
+    uint16_t buf[DSHOT_FRAME_SLOTS * 4];
+    for (auto &v : buf) v = 0xAAAA;
+
+    uint16_t frame = DshotCodec::encodeFrame(1046, false, false);
+    DshotCodec::frameToCompare(frame, 600, 300, &buf[2], 4);
+
+    for (uint8_t i = 0; i < DSHOT_FRAME_BITS; i++) {
+        uint16_t expected = ((frame >> (15 - i)) & 1) ? 600 : 300;
+        EXPECT_EQ(buf[i * 4 + 2], expected) << "bit " << (int)i;
+        EXPECT_EQ(buf[i * 4 + 1], 0xAAAA);
+    }
+    EXPECT_EQ(buf[DSHOT_FRAME_BITS * 4 + 2], 0);
+}
+
+TEST(DshotCodecTest, LineRoundTripsEveryPeriodCode) {
+    for (uint16_t code = 0; code <= 0x0FFF; code++) {
+        uint32_t line = DshotCodec::encodeLine(code);
+        EXPECT_EQ(line >> (DSHOT_TELEM_LINE_BITS - 1), 0u);
+
+        uint16_t decoded = 0;
+        ASSERT_TRUE(DshotCodec::decodeLine(line, decoded)) << "code " << code;
+        EXPECT_EQ(decoded, code);
+    }
+}
+
+TEST(DshotCodecTest, EdgesRoundTripWithJitter) {
+    for (uint16_t code : {0x0123, 0x0FFF, 0x0A5A, 0x0001, 0x0E00}) {
+        std::vector<uint16_t> edges = lineToEdges(DshotCodec::encodeLine(code), 65000, BIT_TICKS / 5);
+        uint16_t decoded = 0;
+        ASSERT_TRUE(DshotCodec::decodeEdges(edges.data(), (uint8_t)edges.size(), BIT_TICKS, decoded)) << "code " << code;
+        EXPECT_EQ(decoded, code);
+    }
+}
+
+TEST(DshotCodecTest, IgnoresStrayEdgeBeforeReply) {
+    uint16_t code = DshotCodec::erpmToPeriodCode(42000);
+    std::vector<uint16_t> edges = lineToEdges(DshotCodec::encodeLine(code), 20000);
+    edges.insert(edges.begin(), 20000 - 12 * BIT_TICKS); // End of our own frame
+
+    uint16_t decoded = 0;
+    ASSERT_TRUE(DshotCodec::decodeEdges(edges.data(), (uint8_t)edges.size(), BIT_TICKS, decoded));
+    EXPECT_EQ(decoded, code);
+}
+
+TEST(DshotCodecTest, RejectsCorruptReplies) {
+    uint16_t decoded = 0;
+    uint32_t line = DshotCodec::encodeLine(0x0234);
+
+    // Flipping any single line bit breaks the GCR symbol, the CRC or the start bit
+    for (uint8_t i = 0; i < DSHOT_TELEM_LINE_BITS; i++) {
+        EXPECT_FALSE(DshotCodec::decodeLine(line ^ (1u << i), decoded)) << "bit " << (int)i;
+    }
+
+    // Missing edges leave runs that are too long
+    std::vector<uint16_t> edges = lineToEdges(line, 0);
+    edges.erase(edges.begin() + 3);
+    EXPECT_FALSE(DshotCodec::decodeEdges(edges.data(), (uint8_t)edges.size(), BIT_TICKS, decoded));
+
+    EXPECT_FALSE(DshotCodec::decodeEdges(edges.data(), 0, BIT_TICKS, decoded));
+}
+
+TEST(DshotCodecTest, PeriodCodeToErpm) {
+    EXPECT_EQ(DshotCodec::periodCodeToErpm(DSHOT_TELEM_STOPPED), 0u);
+    EXPECT_EQ(DshotCodec::periodCodeToErpm(0x0000), 0u);
+
+    // 300 us period, 200000 eRPM
+    EXPECT_EQ(DshotCodec::periodCodeToErpm(300), 200000u);
+    // Mantissa 375 shifted by 2 is 1500 us
+    EXPECT_EQ(DshotCodec::periodCodeToErpm((2 << 9) | 375), 40000u);
+
+    // Conversion keeps within the mantissa resolution over the useful range
+    for (uint32_t erpm = 1000; erpm <= 300000; erpm += 997) {
+        uint32_t back = DshotCodec::periodCodeToErpm(DshotCodec::erpmToPeriodCode(erpm));
+        EXPECT_NEAR((double)back, (double)erpm, erpm * 0.004 + 1.0) << "erpm " << erpm;
+    }
+    EXPECT_EQ(DshotCodec::erpmToPeriodCode(0), DSHOT_TELEM_STOPPED);
+}
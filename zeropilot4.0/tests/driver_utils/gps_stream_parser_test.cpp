@@ -0,0 +1,295 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "gps_stream_parser.hpp"
+
+static void putLE(uint8_t *payload, uint8_t offset, int32_t value, uint8_t size) {
+    for (uint8_t i = 0; i < size; i++) {
+        payload[offset + i] = (uint8_t)((uint32_t)value >> (8 * i));
+    }
+}
+
+// NAV-PVT with a 3D fix at the given position, 1e-7 deg and mm units like the receiver
+static std::vector<uint8_t> pvtFrame(int32_t latE7, int32_t lonE7, int32_t hMslMm, int32_t gSpeedMmS = 1500, uint8_t fixType = 3) {
+    uint8_t payload[92] = {};
+    putLE(payload, 0, 388245000, 4); // iTOW
+    putLE(payload, 4, 2024, 2);
+    payload[6] = 6;   // Month
+    payload[7] = 15;  // Day
+    payload[8] = 12;  // Hour
+    payload[9] = 30;  // Minute
+    payload[10] = 45; // Second
+    payload[11] = 0x07; // validDate, validTime, fullyResolved
+    payload[20] = fixType;
+    payload[21] = 0x01; // gnssFixOK
+    payload[23] = 14; // numSV
+    putLE(payload, 24, lonE7, 4);
+    putLE(payload, 28, latE7, 4);
+    putLE(payload, 36, hMslMm, 4);
+    putLE(payload, 40, 1200, 4);   // hAcc
+    putLE(payload, 44, 2300, 4);   // vAcc
+    putLE(payload, 48, 1000, 4);   // velN
+    putLE(payload, 52, -2000, 4);  // velE
+    putLE(payload, 56, 500, 4);    // velD
+    putLE(payload, 60, gSpeedMmS, 4);
+    putLE(payload, 64, 9000000, 4); // headMot, 90 deg
+
+    std::vector<uint8_t> frame(100);
+    frame.resize(GpsStreamParser::encodeUBX(0x01, 0x07, payload, sizeof(payload), frame.data(), frame.size()));
+    return frame;
+}
+
+static std::vector<uint8_t> nmeaSentence(const std::string &body) {
+    uint8_t checksum = 0;
+    for (char c : body) checksum ^= (uint8_t)c;
+    char tail[8];
+    snprintf(tail, sizeof(tail), "*%02X\r\n", checksum);
+    std::string s = "$" + body + tail;
+    return std::vector<uint8_t>(s.begin(), s.end());
+}
+
+static const std::string RMC_BODY = "GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W";
+static const std::string GGA_BODY = "GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,";
+
+class GpsStreamParserTest : public ::testing::Test {
+protected:
+    GpsStreamParser parser;
+
+    void feed(const std::vector<uint8_t> &bytes) {
+        parser.feed(bytes.data(), (uint16_t)bytes.size());
+    }
+};
+
+TEST_F(GpsStreamParserTest, ParsesUBXPVT) {
+    feed(pvtFrame(435000000, -805000000, 350000));
+
+    GpsData_t data = parser.takeData();
+    EXPECT_TRUE(data.isNew);
+    EXPECT_NEAR(data.latitude, 43.5f, 1e-5f);
+    EXPECT_NEAR(data.longitude, -80.5f, 1e-5f);
+    EXPECT_NEAR(data.altitude, 350.0f, 1e-3f);
+    EXPECT_EQ(data.numSatellites, 14);
+    EXPECT_NEAR(data.groundSpeed, 150.0f, 1e-3f);
+    EXPECT_NEAR(data.trackAngle, 90.0f, 1e-3f);
+    EXPECT_NEAR(data.vx, 1.0f, 1e-6f);
+    EXPECT_NEAR(data.vy, -2.0f, 1e-6f);
+    EXPECT_NEAR(data.vz, 0.5f, 1e-6f);
+    EXPECT_EQ(data.time.year, 2024);
+    EXPECT_EQ(data.time.second, 45);
+    EXPECT_NEAR(data.hAcc, 1.2f, 1e-6f);
+    EXPECT_NEAR(data.vAcc, 2.3f, 1e-6f);
+    EXPECT_EQ(data.solutionTimeMs, 388245000u);
+    EXPECT_EQ(parser.getStats().framesOk, 1u);
+
+    // Reading again without a new frame returns the same solution marked as old
+    GpsData_t again = parser.takeData();
+    EXPECT_FALSE(again.isNew);
+    EXPECT_FLOAT_EQ(again.latitude, data.latitude);
+}
+
+TEST_F(GpsStreamParserTest, TwoDimensionalFixHasNoAltitude) {
+    feed(pvtFrame(435000000, -805000000, 350000, 0, 2));
+    GpsData_t data = parser.takeData();
+    EXPECT_TRUE(data.isNew);
+    EXPECT_FLOAT_EQ(data.altitude, INVALID_ALTITUDE);
+    EXPECT_FLOAT_EQ(data.vAcc, INVALID_ACCURACY);
+}
+
+TEST_F(GpsStreamParserTest, NoFixIsNotNewData) {
+    feed(pvtFrame(435000000, -805000000, 350000, 0, 0));
+    EXPECT_FALSE(parser.takeData().isNew);
+    EXPECT_EQ(parser.getStats().framesOk, 1u);
+}
+
+TEST_F(GpsStreamParserTest, ParsesNMEA) {
+    feed(nmeaSentence(RMC_BODY));
+    GpsData_t data = parser.takeData();
+    EXPECT_TRUE(data.isNew);
+    EXPECT_NEAR(data.latitude, 48.0 + 7.038 / 60.0, 1e-5);
+    EXPECT_NEAR(data.longitude, 11.0 + 31.0 / 60.0, 1e-5);
+    EXPECT_NEAR(data.groundSpeed, 22.4f * 51.4444f, 1e-2f);
+    EXPECT_NEAR(data.trackAngle, 84.4f, 1e-4f);
+    EXPECT_EQ(data.time.hour, 12);
+    EXPECT_EQ(data.time.minute, 35);
+    EXPECT_EQ(data.time.second, 19);
+    EXPECT_EQ(data.time.day, 23);
+    EXPECT_EQ(data.time.month, 3);
+    EXPECT_EQ(data.time.year, 94);
+    EXPECT_EQ(data.solutionTimeMs, (12u * 3600 + 35 * 60 + 19) * 1000);
+    EXPECT_FLOAT_EQ(data.hAcc, INVALID_ACCURACY); // RMC carries no DOP
+
+    feed(nmeaSentence(GGA_BODY));
+    data = parser.takeData();
+    EXPECT_TRUE(data.isNew);
+    EXPECT_EQ(data.numSatellites, 8);
+    EXPECT_NEAR(data.altitude, 545.4f, 1e-3f);
+    EXPECT_NEAR(data.hAcc, 0.9f * 2.5f, 1e-4f); // HDOP scaled by the range error
+    EXPECT_NEAR(data.latitude, 48.0 + 7.038 / 60.0, 1e-5); // Kept from RMC
+}
+
+TEST_F(GpsStreamParserTest, NMEAHemispheresAndMissingCourse) {
+    feed(nmeaSentence("GNRMC,000001,A,3345.000,S,07030.000,W,0.0,,010124,,"));
+    GpsData_t data = parser.takeData();
+    ASSERT_TRUE(data.isNew);
+    EXPECT_NEAR(data.latitude, -33.75f, 1e-5f);
+    EXPECT_NEAR(data.longitude, -70.5f, 1e-5f);
+    EXPECT_FLOAT_EQ(data.trackAngle, INVALID_TRACK_ANGLE);
+}
+
+TEST_F(GpsStreamParserTest, NMEAWarningIsNotNewData) {
+    feed(nmeaSentence("GPRMC,123519,V,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W"));
+    EXPECT_FALSE(parser.takeData().isNew);
+}
+
+TEST_F(GpsStreamParserTest, FramesSplitAtEveryByteBoundary) {
+    std::vector<uint8_t> stream = pvtFrame(435000000, -805000000, 350000);
+    std::vector<uint8_t> rmc = nmeaSentence(RMC_BODY);
+    stream.insert(stream.end(), rmc.begin(), rmc.end());
+
+    for (size_t split = 1; split < stream.size(); split++) {
+        GpsStreamParser p;
+        p.feed(stream.data(), (uint16_t)split);
+        p.feed(stream.data() + split, (uint16_t)(stream.size() - split));
+        EXPECT_EQ(p.getStats().framesOk, 2u) << "split at " << split;
+        EXPECT_TRUE(p.takeData().isNew);
+    }
+}
+
+TEST_F(GpsStreamParserTest, CorruptedFrameCountsCRCErrorAndResyncs) {
+    std::vector<uint8_t> bad = pvtFrame(100, 200, 300);
+    bad[30] ^= 0xFF;
+    feed(bad);
+    EXPECT_EQ(parser.getStats().crcErrors, 1u);
+    EXPECT_FALSE(parser.takeData().isNew);
+
+    std::vector<uint8_t> badNmea = nmeaSentence(RMC_BODY);
+    badNmea[10] = '9';
+    feed(badNmea);
+    EXPECT_EQ(parser.getStats().crcErrors, 2u);
+    EXPECT_FALSE(parser.takeData().isNew);
+
+    feed(pvtFrame(435000000, -805000000, 350000));
+    GpsData_t data = parser.takeData();
+    EXPECT_TRUE(data.isNew);
+    EXPECT_NEAR(data.latitude, 43.5f, 1e-5f);
+}
+
+TEST_F(GpsStreamParserTest, TruncatedSentenceIsDroppedAndNextOneParses) {
+    std::vector<uint8_t> rmc = nmeaSentence(RMC_BODY);
+    std::vector<uint8_t> stream(rmc.begin(), rmc.begin() + 20); // Receiver reset mid sentence
+    std::vector<uint8_t> gga = nmeaSentence(GGA_BODY);
+    stream.insert(stream.end(), gga.begin(), gga.end());
+
+    feed(stream);
+    EXPECT_EQ(parser.getStats().droppedFrames, 1u);
+    EXPECT_EQ(parser.getStats().framesOk, 1u);
+    EXPECT_EQ(parser.takeData().numSatellites, 8);
+}
+
+TEST_F(GpsStreamParserTest, OversizedUBXLengthResyncs) {
+    const uint8_t bogus[] = {0xB5, 0x62, 0x01, 0x07, 0xFF, 0xFF};
+    parser.feed(bogus, sizeof(bogus));
+    EXPECT_EQ(parser.getStats().droppedFrames, 1u);
+
+    feed(pvtFrame(435000000, -805000000, 350000));
+    EXPECT_TRUE(parser.takeData().isNew);
+}
+
+TEST_F(GpsStreamParserTest, NoiseBetweenFramesIsCounted) {
+    const uint8_t noise[] = {0x00, 0x11, 0xB5, 0x00, '\r', '\n'};
+    parser.feed(noise, sizeof(noise));
+    feed(pvtFrame(435000000, -805000000, 350000));
+    EXPECT_EQ(parser.getStats().droppedBytes, sizeof(noise));
+    EXPECT_EQ(parser.getStats().framesOk, 1u);
+}
+
+// Random bytes must never crash the parser or produce a solution
+TEST_F(GpsStreamParserTest, FuzzRandomBytes) {
+    srand(1234);
+    std::vector<uint8_t> junk(200000);
+    for (auto &b : junk) {
+        int r = rand() % 16;
+        b = (r == 0) ? 0xB5 : (r == 1) ? 0x62 : (r == 2) ? '$' : (r == 3) ? ',' : (uint8_t)rand();
+    }
+    feed(junk);
+    EXPECT_FALSE(parser.takeData().isNew);
+}
+
+// Valid frames with random corruption and truncation mixed in, every untouched frame must still be parsed
+TEST_F(GpsStreamParserTest, FuzzCorruptedStream) {
+    srand(42);
+    uint32_t cleanFrames = 0;
+    std::vector<uint8_t> stream;
+
+    for (int i = 0; i < 2000; i++) {
+        std::vector<uint8_t> frame = (i % 2 == 0) ? pvtFrame(435000000 + i, -805000000, 350000) : nmeaSentence(GGA_BODY);
+
+        int action = rand() % 4;
+        if (action == 0) {
+            frame[rand() % frame.size()] ^= (uint8_t)(1 + rand() % 255);
+        } else if (action == 1) {
+            frame.resize(rand() % frame.size());
+        } else {
+            cleanFrames++;
+        }
+        stream.insert(stream.end(), frame.begin(), frame.end());
+
+        // Bursty noise between some frames, kept free of sync chars
+        if (rand() % 8 == 0) {
+            for (int n = rand() % 10; n > 0; n--) stream.push_back(0x20 + rand() % 4);
+        }
+    }
+
+    // Feed in random sized chunks like DMA idle events
+    size_t pos = 0;
+    while (pos < stream.size()) {
+        size_t chunk = 1 + rand() % 300;
+        if (pos + chunk > stream.size()) chunk = stream.size() - pos;
+        parser.feed(stream.data() + pos, (uint16_t)chunk);
+        pos += chunk;
+    }
+
+    // A truncated UBX frame can swallow the frame after it, so allow for a few of those
+    const GpsParserStats_t &stats = parser.getStats();
+    EXPECT_GE(stats.framesOk, cleanFrames * 8 / 10);
+    EXPECT_LE(stats.framesOk, 2000u);
+    EXPECT_GT(stats.crcErrors + stats.droppedFrames, 0u);
+}
+
+TEST(GpsStreamParserEncode, ChecksumMatchesKnownFrame) {
+    // UBX-CFG-MSG enabling NAV-PVT, checksum from the u-blox manual example
+    const uint8_t payload[] = {0x01, 0x07, 0x01};
+    uint8_t frame[16];
+    uint16_t len = GpsStreamParser::encodeUBX(0x06, 0x01, payload, sizeof(payload), frame, sizeof(frame));
+    ASSERT_EQ(len, 11);
+    EXPECT_EQ(frame[9], 0x13);
+    EXPECT_EQ(frame[10], 0x51);
+
+    EXPECT_EQ(GpsStreamParser::encodeUBX(0x06, 0x01, payload, sizeof(payload), frame, 10), 0);
+}
+
+TEST_F(GpsStreamParserTest, ResyncDropsPartialFrameAndKeepsStats) {
+    const uint8_t bad[] = "$GPGGA,1*00\r\n";
+    parser.feed(bad, sizeof(bad) - 1);
+    feed(pvtFrame(435000000, -805000000, 350000));
+    ASSERT_TRUE(parser.takeData().isNew);
+
+    std::vector<uint8_t> pvt = pvtFrame(436000000, -805000000, 350000);
+    parser.feed(pvt.data(), 40); // DMA restarted mid frame
+    parser.resync();
+    feed(std::vector<uint8_t>(pvt.begin() + 40, pvt.end())); // Tail is noise on its own
+    EXPECT_FALSE(parser.takeData().isNew);
+
+    feed(pvt);
+    GpsData_t data = parser.takeData();
+    EXPECT_TRUE(data.isNew);
+    EXPECT_NEAR(data.latitude, 43.6f, 1e-5f);
+
+    const GpsParserStats_t &stats = parser.getStats();
+    EXPECT_EQ(stats.crcErrors, 1u);
+    EXPECT_EQ(stats.droppedFrames, 1u);
+    EXPECT_EQ(stats.framesOk, 2u);
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "host_fft.hpp"
+
+#ifdef ZP_TEST_CMSIS_DSP
+#include "arm_math.h"
+#endif
+
+// Packed spectrum of a real signal from a double precision DFT, in the CMSIS layout
+static std::vector<double> referenceSpectrum(const std::vector<float>& x) {
+    const size_t n = x.size();
+    std::vector<double> packed(n);
+    for (size_t k = 0; k <= n / 2; ++k) {
+        double re = 0.0, im = 0.0;
+        for (size_t t = 0; t < n; ++t) {
+            double angle = -2.0 * M_PI * static_cast<double>((k * t) % n) / n;
+            re += x[t] * std::cos(angle);
+            im += x[t] * std::sin(angle);
+        }
+        if (k == 0) {
+            packed[0] = re;
+        } else if (k == n / 2) {
+            packed[1] = re;
+        } else {
+            packed[2 * k] = re;
+            packed[2 * k + 1] = im;
+        }
+    }
+    return packed;
+}
+
+static std::vector<float> randomSignal(size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> x(n);
+    for (float& v : x) v = dist(rng);
+    return x;
+}
+
+// Largest bin error relative to the largest bin, float FFTs land around 1e-7 times log2(N)
+static double relativeError(const std::vector<float>& actual, const std::vector<double>& expected) {
+    double worst = 0.0, scale = 0.0;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        worst = std::fmax(worst, std::fabs(actual[i] - expected[i]));
+        scale = std::fmax(scale, std::fabs(expected[i]));
+    }
+    return worst / scale;
+}
+
+TEST(HostFFTTest, RejectsLengthsCmsisRejects) {
+    HostFFT fft;
+    EXPECT_FALSE(fft.init(16));
+    EXPECT_FALSE(fft.init(8192 - 1));
+    EXPECT_FALSE(fft.init(100));
+    EXPECT_FALSE(fft.init(0));
+    EXPECT_TRUE(fft.init(32));
+    EXPECT_TRUE(fft.init(4096));
+}
+
+TEST(HostFFTTest, ForwardMatchesReferenceDft) {
+    for (uint16_t n = HostFFT::MIN_LENGTH; n <= HostFFT::MAX_LENGTH; n *= 2) {
+        HostFFT fft;
+        ASSERT_TRUE(fft.init(n));
+
+        std::vector<float> x = randomSignal(n, n);
+        std::vector<float> in = x;
+        std::vector<float> out(n);
+        fft.runFFT(in.data(), out.data(), 0);
+
+        EXPECT_LT(relativeError(out, referenceSpectrum(x)), 2e-6) << "N = " << n;
+        EXPECT_EQ(in, x) << "N = " << n; // Input is not used as scratch
+    }
+}
+
+TEST(HostFFTTest, SinePeaksInItsBin) {
+    static constexpr uint16_t N = 1024;
+    static constexpr uint16_t BIN = 37;
+    HostFFT fft;
+    ASSERT_TRUE(fft.init(N));
+
+    std::vector<float> in(N), out(N), mag(N / 2);
+    for (uint16_t i = 0; i < N; ++i) {
+        in[i] = 0.5f + std::sin(2.0f * static_cast<float>(M_PI) * BIN * i / N);
+    }
+    fft.runFFT(in.data(), out.data(), 0);
+    fft.complexMag(out.data(), mag.data(), N / 2);
+
+    EXPECT_NEAR(out[0], 0.5f * N, 1e-2f);   // DC
+    EXPECT_NEAR(out[1], 0.0f, 1e-2f);       // Nyquist
+    EXPECT_NEAR(mag[BIN], N / 2.0f, 1e-2f);
+    for (uint16_t k = 1; k < N / 2; ++k) {
+        if (k != BIN) {
+            EXPECT_LT(mag[k], 1e-2f) << "bin " << k;
+        }
+    }
+}
+
+TEST(HostFFTTest, InverseRoundTrips) {
+    for (uint16_t n = HostFFT::MIN_LENGTH; n <= HostFFT::MAX_LENGTH; n *= 2) {
+        HostFFT fft;
+        ASSERT_TRUE(fft.init(n));
+
+        std::vector<float> x = randomSignal(n, n + 1);
+        std::vector<float> spectrum(n), back(n);
+        fft.runFFT(x.data(), spectrum.data(), 0);
+        fft.runFFT(spectrum.data(), back.data(), 1);
+
+        for (uint16_t i = 0; i < n; ++i) {
+            ASSERT_NEAR(back[i], x[i], 1e-5f) << "N = " << n << " sample " << i;
+        }
+    }
+}
+
+TEST(HostFFTTest, ReinitChangesLength) {
+    HostFFT fft;
+    ASSERT_TRUE(fft.init(4096));
+    ASSERT_TRUE(fft.init(64));
+
+    std::vector<float> x = randomSignal(64, 3);
+    std::vector<float> out(64);
+    fft.runFFT(x.data(), out.data(), 0);
+    EXPECT_LT(relativeError(out, referenceSpectrum(x)), 2e-6);
+
+    // A rejected length keeps the previous setup
+    EXPECT_FALSE(fft.init(48));
+    fft.runFFT(x.data(), out.data(), 0);
+    EXPECT_LT(relativeError(out, referenceSpectrum(x)), 2e-6);
+}
+
+#ifdef ZP_TEST_CMSIS_DSP
+TEST(HostFFTTest, MatchesCmsisRfft) {
+    for (uint16_t n = HostFFT::MIN_LENGTH; n <= HostFFT::MAX_LENGTH; n *= 2) {
+        HostFFT fft;
+        arm_rfft_fast_instance_f32 cmsis;
+        ASSERT_TRUE(fft.init(n));
+        ASSERT_EQ(arm_rfft_fast_init_f32(&cmsis, n), ARM_MATH_SUCCESS);
+
+        std::vector<float> x = randomSignal(n, 2 * n);
+        std::vector<float> hostIn = x, cmsisIn = x;
+        std::vector<float> hostOut(n), cmsisOut(n);
+        fft.runFFT(hostIn.data(), hostOut.data(), 0);
+        arm_rfft_fast_f32(&cmsis, cmsisIn.data(), cmsisOut.data(), 0);
+
+        std::vector<double> expected(cmsisOut.begin(), cmsisOut.end());
+        EXPECT_LT(relativeError(hostOut, expected), 2e-6) << "N = " << n;
+
+        std::vector<float> hostMag(n / 2), cmsisMag(n / 2);
+        fft.complexMag(hostOut.data(), hostMag.data(), n / 2);
+        arm_cmplx_mag_f32(cmsisOut.data(), cmsisMag.data(), n / 2);
+        std::vector<double> expectedMag(cmsisMag.begin(), cmsisMag.end());
+        EXPECT_LT(relativeError(hostMag, expectedMag), 2e-6) << "N = " << n;
+
+        // Inverse of the same spectrum
+        std::vector<float> hostSpectrum = hostOut, cmsisSpectrum = hostOut;
+        fft.runFFT(hostSpectrum.data(), hostIn.data(), 1);
+        arm_rfft_fast_f32(&cmsis, cmsisSpectrum.data(), cmsisIn.data(), 1);
+        for (uint16_t i = 0; i < n; ++i) {
+            ASSERT_NEAR(hostIn[i], cmsisIn[i], 1e-5f) << "N = " << n << " sample " << i;
+        }
+    }
+}
+#endif
@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "host_mathutils.hpp"
+
+#ifdef ZP_TEST_CMSIS_DSP
+#include "arm_math.h"
+#endif
+
+static std::vector<float> randomMatrix(uint32_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+    std::vector<float> m(n);
+    for (float& v : m) v = dist(rng);
+    return m;
+}
+
+static std::vector<double> referenceMult(const std::vector<float>& a, uint16_t rowsA, uint16_t colsA,
+                                         const std::vector<float>& b, uint16_t colsB) {
+    std::vector<double> out(rowsA * colsB, 0.0);
+    for (uint16_t r = 0; r < rowsA; ++r) {
+        for (uint16_t c = 0; c < colsB; ++c) {
+            for (uint16_t k = 0; k < colsA; ++k) {
+                out[r * colsB + c] += static_cast<double>(a[r * colsA + k]) * b[k * colsB + c];
+            }
+        }
+    }
+    return out;
+}
+
+// Every shape with a fixed kernel plus ones that go through the generic loop
+static const uint16_t MULT_SHAPES[][3] = {
+    {3, 3, 3}, {3, 3, 1}, {1, 3, 3}, {1, 3, 1}, {4, 4, 1}, {4, 4, 4},
+    {2, 5, 7}, {9, 9, 9}, {6, 40, 33}, {1, 64, 1}
+};
+
+TEST(HostMathUtilsTest, MatrixMultMatchesReference) {
+    HostMathUtils math;
+    uint32_t seed = 1;
+    for (const auto& shape : MULT_SHAPES) {
+        uint16_t rowsA = shape[0], colsA = shape[1], colsB = shape[2];
+        std::vector<float> a = randomMatrix(rowsA * colsA, seed++);
+        std::vector<float> b = randomMatrix(colsA * colsB, seed++);
+        std::vector<float> dst(rowsA * colsB, NAN);
+
+        ASSERT_TRUE(math.matrixMult(a.data(), rowsA, colsA, b.data(), colsB, dst.data()));
+
+        std::vector<double> expected = referenceMult(a, rowsA, colsA, b, colsB);
+        for (size_t i = 0; i < dst.size(); ++i) {
+            EXPECT_NEAR(dst[i], expected[i], 1e-5 * colsA) << rowsA << "x" << colsA << "x" << colsB << " at " << i;
+        }
+    }
+}
+
+TEST(HostMathUtilsTest, FixedKernelsAllowAliasing) {
+    HostMathUtils math;
+    std::vector<float> a = randomMatrix(9, 7);
+    std::vector<float> b = randomMatrix(9, 8);
+    std::vector<double> expected = referenceMult(a, 3, 3, b, 3);
+
+    math.matrixMult(a.data(), 3, 3, b.data(), 3, a.data());
+    for (size_t i = 0; i < 9; ++i) EXPECT_NEAR(a[i], expected[i], 1e-5);
+}
+
+TEST(HostMathUtilsTest, ElementwiseOperations) {
+    HostMathUtils math;
+    // 3x3 goes through the inline loops and 9x9 through the dispatched kernels
+    for (uint16_t dim : {3, 9}) {
+        uint32_t n = dim * dim;
+        std::vector<float> a = randomMatrix(n, dim);
+        std::vector<float> b = randomMatrix(n, dim + 100);
+        std::vector<float> sum(n), diff(n), scaled(n), transposed(n);
+
+        ASSERT_TRUE(math.matrixAdd(a.data(), b.data(), sum.data(), dim, dim));
+        ASSERT_TRUE(math.matrixSub(a.data(), b.data(), diff.data(), dim, dim));
+        ASSERT_TRUE(math.matrixScale(a.data(), -1.5f, scaled.data(), dim, dim));
+        ASSERT_TRUE(math.matrixTranspose(a.data(), dim, dim, transposed.data()));
+
+        for (uint16_t r = 0; r < dim; ++r) {
+            for (uint16_t c = 0; c < dim; ++c) {
+                uint32_t i = r * dim + c;
+                EXPECT_FLOAT_EQ(sum[i], a[i] + b[i]);
+                EXPECT_FLOAT_EQ(diff[i], a[i] - b[i]);
+                EXPECT_FLOAT_EQ(scaled[i], a[i] * -1.5f);
+                EXPECT_EQ(transposed[c * dim + r], a[i]);
+            }
+        }
+    }
+
+    float v[40];
+    for (int i = 0; i < 40; ++i) v[i] = (i % 2) ? 0.5f : -0.5f;
+    EXPECT_FLOAT_EQ(math.vectorNorm(v, 40), std::sqrt(10.0f));
+    float unit[40];
+    ASSERT_TRUE(math.vectorNormalize(v, unit, 40));
+    EXPECT_NEAR(math.vectorNorm(unit, 40), 1.0f, 1e-6f);
+
+    float zero[3] = {0.0f, 0.0f, 0.0f};
+    EXPECT_FALSE(math.vectorNormalize(zero, unit, 3));
+}
+
+TEST(HostMathUtilsTest, InverseTimesMatrixIsIdentity) {
+    HostMathUtils math;
+    // 3x3 innovation covariance size, then the stack limit and a heap sized one
+    for (uint16_t dim : {3, 16, 20}) {
+        std::vector<float> a = randomMatrix(dim * dim, dim);
+        for (uint16_t i = 0; i < dim; ++i) a[i * dim + i] += dim; // Well conditioned
+        std::vector<float> inv(dim * dim), product(dim * dim);
+
+        ASSERT_TRUE(math.matrixInverse(a.data(), dim, inv.data()));
+        math.matrixMult(a.data(), dim, dim, inv.data(), dim, product.data());
+        for (uint16_t r = 0; r < dim; ++r) {
+            for (uint16_t c = 0; c < dim; ++c) {
+                EXPECT_NEAR(product[r * dim + c], r == c ? 1.0f : 0.0f, 1e-5f) << "dim " << dim;
+            }
+        }
+    }
+
+    float singular[9] = {1, 2, 3, 2, 4, 6, 0, 1, 1};
+    float inv[9];
+    EXPECT_FALSE(math.matrixInverse(singular, 3, inv));
+}
+
+TEST(HostMathUtilsTest, QuaternionRotationsAgree) {
+    HostMathUtils math;
+    float rotVec[3] = {0.3f, -0.7f, 1.1f};
+    float q[4];
+    math.quatExponential(rotVec, q);
+
+    // Rotating about the axis leaves it unchanged
+    float axis[3], rotatedAxis[3];
+    math.vectorNormalize(rotVec, axis, 3);
+    math.quatRotateVector(q, axis, rotatedAxis);
+    for (int i = 0; i < 3; ++i) EXPECT_NEAR(rotatedAxis[i], axis[i], 1e-6f);
+
+    // q then its inverse is the identity
+    float qInv[4], identity[4];
+    math.quatInverse(q, qInv);
+    math.quatMultiply(q, qInv, identity);
+    EXPECT_NEAR(identity[0], 1.0f, 1e-6f);
+    for (int i = 1; i < 4; ++i) EXPECT_NEAR(identity[i], 0.0f, 1e-6f);
+
+    // The inverse rotation matrix is the transpose
+    float rot[9], rotInv[9], rotT[9];
+    math.quatToRotationMatrix(q, rot);
+    math.quatToRotationMatrixInverse(q, rotInv);
+    math.matrixTranspose(rot, 3, 3, rotT);
+    for (int i = 0; i < 9; ++i) EXPECT_NEAR(rotInv[i], rotT[i], 1e-6f);
+
+    EXPECT_NEAR(math.quatAngularDistanceDeg(q, identity), std::sqrt(0.09f + 0.49f + 1.21f) * 180.0f / M_PI, 1e-3f);
+
+    // Averaging with itself changes nothing
+    float avg[4];
+    math.quatAverage(q, q, avg);
+    for (int i = 0; i < 4; ++i) EXPECT_NEAR(avg[i], q[i], 1e-6f);
+
+    // Pure yaw
+    float yawVec[3] = {0.0f, 0.0f, 0.5f};
+    float yawQ[4], euler[3];
+    math.quatExponential(yawVec, yawQ);
+    math.quatToEuler(yawQ, euler);
+    EXPECT_NEAR(euler[0], 0.0f, 1e-6f);
+    EXPECT_NEAR(euler[1], 0.0f, 1e-6f);
+    EXPECT_NEAR(euler[2], 0.5f, 1e-6f);
+}
+
+TEST(HostMathUtilsTest, EnsureSymmetricAveragesOffDiagonal) {
+    HostMathUtils math;
+    float m[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    ASSERT_TRUE(math.ensureSymmetric(m, 3));
+    const float expected[9] = {1, 3, 5, 3, 5, 7, 5, 7, 9};
+    for (int i = 0; i < 9; ++i) EXPECT_FLOAT_EQ(m[i], expected[i]);
+}
+
+#ifdef ZP_TEST_CMSIS_DSP
+TEST(HostMathUtilsTest, MatchesCmsisMatrixFunctions) {
+    HostMathUtils math;
+    uint32_t seed = 50;
+    for (const auto& shape : MULT_SHAPES) {
+        uint16_t rowsA = shape[0], colsA = shape[1], colsB = shape[2];
+        std::vector<float> a = randomMatrix(rowsA * colsA, seed++);
+        std::vector<float> b = randomMatrix(colsA * colsB, seed++);
+        std::vector<float> hostOut(rowsA * colsB), cmsisOut(rowsA * colsB);
+
+        arm_matrix_instance_f32 matA, matB, matOut;
+        arm_mat_init_f32(&matA, rowsA, colsA, a.data());
+        arm_mat_init_f32(&matB, colsA, colsB, b.data());
+        arm_mat_init_f32(&matOut, rowsA, colsB, cmsisOut.data());
+        ASSERT_EQ(arm_mat_mult_f32(&matA, &matB, &matOut), ARM_MATH_SUCCESS);
+        math.matrixMult(a.data(), rowsA, colsA, b.data(), colsB, hostOut.data());
+
+        for (size_t i = 0; i < hostOut.size(); ++i) {
+            EXPECT_NEAR(hostOut[i], cmsisOut[i], 1e-5 * colsA) << rowsA << "x" << colsA << "x" << colsB;
+        }
+    }
+
+    for (uint16_t dim : {3, 9}) {
+        std::vector<float> a = randomMatrix(dim * dim, dim + 200);
+        for (uint16_t i = 0; i < dim; ++i) a[i * dim + i] += dim;
+        std::vector<float> scratch = a; // CMSIS overwrites the source
+        std::vector<float> hostInv(dim * dim), cmsisInv(dim * dim);
+
+        arm_matrix_instance_f32 matSrc, matInv;
+        arm_mat_init_f32(&matSrc, dim, dim, scratch.data());
+        arm_mat_init_f32(&matInv, dim, dim, cmsisInv.data());
+        ASSERT_EQ(arm_mat_inverse_f32(&matSrc, &matInv), ARM_MATH_SUCCESS);
+        ASSERT_TRUE(math.matrixInverse(a.data(), dim, hostInv.data()));
+
+        for (size_t i = 0; i < hostInv.size(); ++i) EXPECT_NEAR(hostInv[i], cmsisInv[i], 1e-5f) << "dim " << dim;
+    }
+}
+
+TEST(HostMathUtilsTest, TrigWithinCmsisTableError) {
+    HostMathUtils math;
+    // arm_sin_f32 interpolates a 512 entry table, good to about 2e-5
+    for (float x = -10.0f; x < 10.0f; x += 0.01f) {
+        EXPECT_NEAR(math.dspSinf(x), arm_sin_f32(x), 5e-5f) << x;
+        EXPECT_NEAR(math.dspCosf(x), arm_cos_f32(x), 5e-5f) << x;
+    }
+}
+#endif
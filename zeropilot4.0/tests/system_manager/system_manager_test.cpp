@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <cstring>
+#include <string>
+#include <vector>
 #include "system_manager.hpp"
 #include "zp_params.hpp"
 #include "mock_systemutils.hpp"
@@ -267,3 +270,221 @@ TEST_F(SystemManagerTest, RCFlightmodeSwitching) {
         ::testing::Mock::VerifyAndClearExpectations(&mockAMQueue);
     }
 }
+
+TEST_F(SystemManagerTest, LowLinkQualityTriggersRCFailsafe) {
+    ZP_PARAM::setParamById("RC_FS_LQ", 20);
+
+    RCControl rcData;
+    rcData.isDataNew = true;
+    rcData.arm = 100.0f;
+    EXPECT_CALL(mockRC, getRCData()).WillRepeatedly(Return(rcData));
+
+    // Frames keep arriving but the receiver reports the uplink as nearly gone
+    RCLinkStats_t goodLink = {true, 100, -60, 10};
+    RCLinkStats_t badLink = {true, 5, -115, -10};
+    EXPECT_CALL(mockRC, getLinkStats())
+        .WillOnce(Return(goodLink))
+        .WillRepeatedly(Return(badLink));
+
+    EXPECT_CALL(mockAMQueue, push(_)).Times(1);
+
+    int disconnectCount = 0;
+    ON_CALL(mockTMQueue, push(_)).WillByDefault(Invoke([&disconnectCount](TMMessage_t *msg) {
+        if (msg->dataType == TMMessage_t::STATUSTEXT_DATA && strcmp(msg->tmMessageData.statusTextData.text, "RC Disconnected") == 0) {
+            disconnectCount++;
+        }
+        return 0;
+    }));
+
+    SystemManager sm(&mockSystemUtils, &mockWatchdog, &mockLogger, mockSafetySwitchPtr,
+                     &mockRC, &mockPM, &mockAMQueue, &mockTMQueue, &mockLogQueue);
+
+    for (int i = 0; i <= RC_FAILSAFE_ITERATIONS; i++) {
+        sm.smUpdate();
+    }
+    EXPECT_EQ(disconnectCount, 1);
+}
+
+TEST_F(SystemManagerTest, ReceiversWithoutLinkStatsAreNotAffected) {
+    ZP_PARAM::setParamById("RC_FS_LQ", 50);
+
+    RCControl rcData;
+    rcData.isDataNew = true;
+    EXPECT_CALL(mockRC, getRCData()).WillRepeatedly(Return(rcData));
+    EXPECT_CALL(mockRC, getLinkStats()).WillRepeatedly(Return(RCLinkStats_t{}));
+    EXPECT_CALL(mockAMQueue, push(_)).Times(5);
+
+    SystemManager sm(&mockSystemUtils, &mockWatchdog, &mockLogger, mockSafetySwitchPtr,
+                     &mockRC, &mockPM, &mockAMQueue, &mockTMQueue, &mockLogQueue);
+
+    for (int i = 0; i < 5; i++) {
+        sm.smUpdate();
+    }
+}
+
+TEST_F(SystemManagerTest, TelemetrySentToRCReceiver) {
+    EXPECT_CALL(mockPM, readData(_)).WillRepeatedly(Invoke([](PMData_t *data) {
+        data->busVoltage = 12.3f;
+        data->current = 4.5f;
+        data->charge = 3600.0f; // 1000 mAh
+        return true;
+    }));
+
+    RCControl rcData;
+    rcData.isDataNew = true;
+    rcData.arm = 0.0f;
+    rcData.fltModeRaw = 10.0f; // FLTMODE1
+    EXPECT_CALL(mockRC, getRCData()).WillRepeatedly(Return(rcData));
+
+    RCSystemTelemetry_t telemetry = {};
+    EXPECT_CALL(mockRC, setTelemetry(_)).WillOnce(::testing::SaveArg<0>(&telemetry));
+
+    SystemManager sm(&mockSystemUtils, &mockWatchdog, &mockLogger, mockSafetySwitchPtr,
+                     &mockRC, &mockPM, &mockAMQueue, &mockTMQueue, &mockLogQueue);
+    sm.smUpdate();
+
+    EXPECT_TRUE(telemetry.batteryValid);
+    EXPECT_FLOAT_EQ(telemetry.batteryVoltage, 12.3f);
+    EXPECT_FLOAT_EQ(telemetry.batteryCurrent, 4.5f);
+    EXPECT_NEAR(telemetry.consumedMah, 1000.0f, 1e-3f);
+    #ifdef PLANE
+    EXPECT_STREQ(telemetry.flightMode, "MANU*");
+    #endif
+    #ifdef QUADCOPTER
+    EXPECT_STREQ(telemetry.flightMode, "STAB*");
+    #endif
+}
+
+TEST_F(SystemManagerTest, FilteredBatteryVoltagePublished) {
+    float busVoltage = 16.0f;
+    EXPECT_CALL(mockPM, readData(_)).WillRepeatedly(Invoke([&busVoltage](PMData_t *data) {
+        data->busVoltage = busVoltage;
+        return true;
+    }));
+
+    LatestValueSlot<BatteryVoltage_t> batteryVoltage;
+    SystemManager sm(&mockSystemUtils, &mockWatchdog, &mockLogger, mockSafetySwitchPtr,
+                     &mockRC, &mockPM, &mockAMQueue, &mockTMQueue, &mockLogQueue, &batteryVoltage);
+
+    // First reading seeds the filter
+    uint32_t seq = 0;
+    BatteryVoltage_t published = {};
+    sm.smUpdate();
+    ASSERT_TRUE(batteryVoltage.readIfNew(published, seq));
+    EXPECT_FLOAT_EQ(published.filteredVoltage, 16.0f);
+
+    // A sag under load is followed with the filter time constant, not instantly
+    busVoltage = 14.0f;
+    sm.smUpdate();
+    ASSERT_TRUE(batteryVoltage.readIfNew(published, seq));
+    EXPECT_GT(published.filteredVoltage, 15.5f);
+    EXPECT_LT(published.filteredVoltage, 16.0f);
+
+    // Settled after a few time constants of the 0.5 Hz cutoff
+    for (int i = 0; i < 5 * SM_SCHEDULING_RATE_HZ; i++) {
+        sm.smUpdate();
+    }
+    ASSERT_TRUE(batteryVoltage.readIfNew(published, seq));
+    EXPECT_NEAR(published.filteredVoltage, 14.0f, 0.01f);
+}
+
+TEST_F(SystemManagerTest, SysIdBlocksBatchedToBinaryLog) {
+    NiceMock<MockMessageQueue<SysIdLogBlock_t>> mockSysIdQueue;
+    int queued = SM_SYSID_LOG_BLOCKS_PER_WRITE + 2;
+    uint32_t nextSeq = 0;
+    ON_CALL(mockSysIdQueue, count()).WillByDefault(Invoke([&queued]() { return queued; }));
+    ON_CALL(mockSysIdQueue, get(_)).WillByDefault(Invoke([&queued, &nextSeq](SysIdLogBlock_t *block) {
+        block->sync = SYSID_LOG_SYNC;
+        block->seq = nextSeq++;
+        queued--;
+        return 0;
+    }));
+
+    std::vector<uint32_t> writeSizes;
+    std::vector<uint32_t> writtenSeqs;
+    EXPECT_CALL(mockLogger, logBinary(_, _)).WillRepeatedly(Invoke([&](const void *data, uint32_t len) {
+        writeSizes.push_back(len);
+        const SysIdLogBlock_t *blocks = static_cast<const SysIdLogBlock_t *>(data);
+        for (uint32_t i = 0; i < len / sizeof(SysIdLogBlock_t); i++) {
+            writtenSeqs.push_back(blocks[i].seq);
+        }
+        return 0;
+    }));
+
+    SystemManager sm(&mockSystemUtils, &mockWatchdog, &mockLogger, mockSafetySwitchPtr,
+                     &mockRC, &mockPM, &mockAMQueue, &mockTMQueue, &mockLogQueue, nullptr, &mockSysIdQueue);
+
+    // A full batch this cycle, the rest on the next, nothing once the queue is empty
+    sm.smUpdate();
+    sm.smUpdate();
+    sm.smUpdate();
+
+    ASSERT_EQ(writeSizes.size(), 2u);
+    EXPECT_EQ(writeSizes[0], SM_SYSID_LOG_BLOCKS_PER_WRITE * sizeof(SysIdLogBlock_t));
+    EXPECT_EQ(writeSizes[1], 2 * sizeof(SysIdLogBlock_t));
+    for (uint32_t i = 0; i < writtenSeqs.size(); i++) {
+        EXPECT_EQ(writtenSeqs[i], i);
+    }
+}
+
+TEST_F(SystemManagerTest, CANDropsReportedOnceWhenTheyChange) {
+    std::vector<std::string> texts;
+    EXPECT_CALL(mockTMQueue, push(_)).WillRepeatedly(Invoke([&texts](TMMessage_t *msg) {
+        if (msg->dataType == TMMessage_t::STATUSTEXT_DATA && strncmp(msg->tmMessageData.statusTextData.text, "CAN", 3) == 0) {
+            texts.push_back(msg->tmMessageData.statusTextData.text);
+        }
+        return 0;
+    }));
+
+    LatestValueSlot<CANBusStats_t> canBusStats;
+    SystemManager sm(&mockSystemUtils, &mockWatchdog, &mockLogger, mockSafetySwitchPtr,
+                     &mockRC, &mockPM, &mockAMQueue, &mockTMQueue, &mockLogQueue, nullptr, nullptr, &canBusStats);
+
+    // A healthy bus is quiet
+    CANBusStats_t stats = {};
+    stats.rxFrames = 1000;
+    canBusStats.publish(stats);
+    sm.smUpdate();
+    EXPECT_TRUE(texts.empty());
+
+    // Only the increase since the last publish is reported, and only once
+    stats.rxRingOverruns = 12;
+    stats.rxFifoOverruns = 3;
+    stats.txQueueFull = 2;
+    canBusStats.publish(stats);
+    sm.smUpdate();
+    sm.smUpdate();
+    ASSERT_EQ(texts.size(), 1u);
+    EXPECT_EQ(texts[0], "CAN dropped 15 RX, 2 TX frames");
+
+    stats.rxRingOverruns = 13;
+    stats.busOffEvents = 1;
+    canBusStats.publish(stats);
+    sm.smUpdate();
+    ASSERT_EQ(texts.size(), 3u);
+    EXPECT_EQ(texts[1], "CAN bus off (1 total)");
+    EXPECT_EQ(texts[2], "CAN dropped 1 RX, 0 TX frames");
+}
+
+TEST_F(SystemManagerTest, AMBudgetFollowsRateAtStartup) {
+    std::vector<std::string> texts;
+    EXPECT_CALL(mockTMQueue, push(_)).WillRepeatedly(Invoke([&texts](TMMessage_t *msg) {
+        if (msg->dataType == TMMessage_t::STATUSTEXT_DATA && strncmp(msg->tmMessageData.statusTextData.text, "AM", 2) == 0) {
+            texts.push_back(msg->tmMessageData.statusTextData.text);
+        }
+        return 0;
+    }));
+    EXPECT_CALL(mockSystemUtils, profilerGetAll(_, _)).WillRepeatedly(Invoke([](TaskProfile *out, uint8_t *count) {
+        out[0] = {"AM", 1500, 500};
+        *count = 1;
+    }));
+
+    // 2 ms budget at 500 Hz, a 1 kHz PARAM_SET only takes effect on reboot
+    ZP_PARAM::setParamById("SCHED_LOOP_RATE", 500);
+    SystemManager sm(&mockSystemUtils, &mockWatchdog, &mockLogger, mockSafetySwitchPtr,
+                     &mockRC, &mockPM, &mockAMQueue, &mockTMQueue, &mockLogQueue);
+    ZP_PARAM::setParamById("SCHED_LOOP_RATE", 1000);
+
+    sm.smUpdate();
+    EXPECT_TRUE(texts.empty());
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include "latest_value_slot.hpp"
+
+typedef struct {
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+} Triple_t;
+
+TEST(LatestValueSlotTest, NothingPublishedReadsNothing) {
+    LatestValueSlot<Triple_t> slot;
+    Triple_t out = {7, 7, 7};
+    uint32_t seq = 0;
+    EXPECT_FALSE(slot.readIfNew(out, seq));
+    EXPECT_EQ(out.a, 7u);
+    EXPECT_EQ(slot.getPublishCount(), 0u);
+}
+
+TEST(LatestValueSlotTest, ReadsOnlyNewestValueOnce) {
+    LatestValueSlot<Triple_t> slot;
+    uint32_t seq = 0;
+    Triple_t out = {};
+
+    slot.publish({1, 1, 1});
+    slot.publish({2, 2, 2});
+    ASSERT_TRUE(slot.readIfNew(out, seq));
+    EXPECT_EQ(out.a, 2u);
+    EXPECT_FALSE(slot.readIfNew(out, seq));
+
+    slot.publish({3, 3, 3});
+    ASSERT_TRUE(slot.readIfNew(out, seq));
+    EXPECT_EQ(out.c, 3u);
+    EXPECT_EQ(slot.getPublishCount(), 3u);
+}
+
+TEST(LatestValueSlotTest, ReadersTrackTheirOwnSequence) {
+    LatestValueSlot<Triple_t> slot;
+    uint32_t seqA = 0;
+    uint32_t seqB = 0;
+    Triple_t out = {};
+
+    slot.publish({4, 4, 4});
+    EXPECT_TRUE(slot.readIfNew(out, seqA));
+    EXPECT_TRUE(slot.readIfNew(out, seqB));
+    EXPECT_FALSE(slot.readIfNew(out, seqA));
+}
+
+TEST(LatestValueSlotTest, ConcurrentReaderNeverSeesTornValue) {
+    LatestValueSlot<Triple_t> slot;
+    std::atomic<bool> done(false);
+
+    std::thread writer([&]() {
+        for (uint32_t i = 1; i <= 200000; i++) {
+            slot.publish({i, i * 3, i * 7});
+        }
+        done = true;
+    });
+
+    uint32_t seq = 0;
+    uint32_t reads = 0;
+    uint32_t last = 0;
+    Triple_t out = {};
+    while (!done || slot.readIfNew(out, seq)) {
+        if (slot.readIfNew(out, seq)) {
+            ASSERT_EQ(out.b, out.a * 3);
+            ASSERT_EQ(out.c, out.a * 7);
+            ASSERT_GT(out.a, last);
+            last = out.a;
+            reads++;
+        }
+    }
+    writer.join();
+
+    EXPECT_GT(reads, 0u);
+}
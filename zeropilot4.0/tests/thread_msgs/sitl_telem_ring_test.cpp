@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "sitl_telem_ring.hpp"
+
+static constexpr size_t HEADER_BYTES = sizeof(SITLTelemRecordHeader_t);
+
+// Record n carries n as its timestamp and a payload that can only come from record n
+static uint32_t payloadLength(uint64_t n) {
+    return static_cast<uint32_t>(n % 37) + 1;
+}
+
+static uint8_t payloadByte(uint64_t n, uint32_t i) {
+    return static_cast<uint8_t>(n * 31 + i);
+}
+
+static void pushRecord(SITLTelemRing& ring, uint64_t n) {
+    uint8_t payload[64];
+    uint32_t length = payloadLength(n);
+    for (uint32_t i = 0; i < length; i++) {
+        payload[i] = payloadByte(n, i);
+    }
+    ring.push(static_cast<uint8_t>(n & 1), n, payload, length);
+}
+
+// Walks the records read() returned, checks each one is whole and newer than the last. Returns the
+// records in the block, counts the records skipped over into skipped
+static size_t checkRecords(const uint8_t* data, size_t bytes, uint64_t& last, uint64_t& skipped) {
+    size_t records = 0;
+    size_t offset = 0;
+    while (offset < bytes) {
+        SITLTelemRecordHeader_t header;
+        memcpy(&header, data + offset, HEADER_BYTES);
+        uint64_t n = header.timestampUs;
+
+        EXPECT_GT(n, last);
+        EXPECT_EQ(header.length, payloadLength(n));
+        EXPECT_EQ(header.direction, n & 1);
+        if (n <= last || header.length != payloadLength(n)) return records;
+
+        for (uint32_t i = 0; i < header.length; i++) {
+            if (data[offset + HEADER_BYTES + i] != payloadByte(n, i)) {
+                ADD_FAILURE() << "record " << n << " torn at byte " << i;
+                return records;
+            }
+        }
+
+        skipped += n - last - 1;
+        last = n;
+        offset += HEADER_BYTES + header.length;
+        records++;
+    }
+    EXPECT_EQ(offset, bytes);
+    return records;
+}
+
+TEST(SITLTelemRingTest, ZeroCapacityRecordsNothing) {
+    SITLTelemRing ring(0);
+    EXPECT_FALSE(ring.isEnabled());
+
+    pushRecord(ring, 1);
+    EXPECT_EQ(ring.getRecordCount(), 0u);
+    EXPECT_EQ(ring.getByteCount(), 0u);
+}
+
+TEST(SITLTelemRingTest, ReaderOnlySeesRecordsPushedAfterIt) {
+    SITLTelemRing ring(256);
+    pushRecord(ring, 1);
+
+    SITLTelemRing::Reader reader(ring);
+    pushRecord(ring, 2);
+    pushRecord(ring, 3);
+
+    std::vector<uint8_t> out(SITL_TELEM_MAX_RECORD_BYTES);
+    size_t bytes = reader.read(out.data(), out.size());
+    EXPECT_EQ(bytes, 2 * HEADER_BYTES + payloadLength(2) + payloadLength(3));
+
+    uint64_t last = 1;
+    uint64_t skipped = 0;
+    EXPECT_EQ(checkRecords(out.data(), bytes, last, skipped), 2u);
+    EXPECT_EQ(skipped, 0u);
+    EXPECT_EQ(reader.read(out.data(), out.size()), 0u);
+    EXPECT_EQ(reader.getLostBytes(), 0u);
+}
+
+TEST(SITLTelemRingTest, ReadStopsBeforeRecordThatDoesNotFit) {
+    SITLTelemRing ring(256);
+    SITLTelemRing::Reader reader(ring);
+    pushRecord(ring, 1);
+    pushRecord(ring, 2);
+
+    uint8_t out[HEADER_BYTES + 2];
+    EXPECT_EQ(reader.read(out, sizeof(out)), HEADER_BYTES + payloadLength(1));
+    EXPECT_EQ(reader.read(out, sizeof(out)), 0u); // Record 2 needs 3 payload bytes
+}
+
+TEST(SITLTelemRingTest, OversizeRecordIsCountedAndDropped) {
+    SITLTelemRing ring(64);
+    SITLTelemRing::Reader reader(ring);
+
+    uint8_t payload[64] = {};
+    ring.push(1, 1, payload, sizeof(payload));
+    EXPECT_EQ(ring.getOversizeCount(), 1u);
+    EXPECT_EQ(ring.getRecordCount(), 0u);
+
+    uint8_t out[128];
+    EXPECT_EQ(reader.read(out, sizeof(out)), 0u);
+}
+
+TEST(SITLTelemRingTest, LappedReaderCountsLostBytes) {
+    SITLTelemRing ring(128);
+    SITLTelemRing::Reader reader(ring);
+
+    for (uint64_t n = 1; n <= 40; n++) {
+        pushRecord(ring, n);
+    }
+
+    std::vector<uint8_t> out(SITL_TELEM_MAX_RECORD_BYTES);
+    size_t bytes = reader.read(out.data(), out.size());
+    ASSERT_GT(bytes, 0u);
+    EXPECT_LE(bytes, 128u);
+
+    uint64_t last = 0;
+    uint64_t skipped = 0;
+    checkRecords(out.data(), bytes, last, skipped);
+    EXPECT_EQ(last, 40u); // Newest record survives
+    EXPECT_GT(skipped, 0u);
+    EXPECT_EQ(bytes + reader.getLostBytes(), ring.getByteCount());
+}
+
+TEST(SITLTelemRingTest, ConcurrentReadersGetIntactRecordsInOrder) {
+    // A couple of records deep, so the producer laps both readers and overwrites records mid-copy
+    SITLTelemRing ring(128);
+    static constexpr uint64_t RECORDS = 200000;
+    static constexpr int READERS = 2;
+    std::atomic<bool> done(false);
+
+    struct ReaderResult {
+        uint64_t bytes = 0;
+        uint64_t records = 0;
+        uint64_t skipped = 0;
+        uint64_t last = 0;
+        uint64_t lostBytes = 0;
+    };
+    ReaderResult results[READERS];
+
+    std::vector<std::thread> readers;
+    std::atomic<int> readersStarted(0);
+    for (int r = 0; r < READERS; r++) {
+        readers.emplace_back([&, r]() {
+            SITLTelemRing::Reader reader(ring);
+            readersStarted++;
+
+            // Small reads so the producer keeps overwriting records mid-copy
+            std::vector<uint8_t> out(SITL_TELEM_MAX_RECORD_BYTES);
+            size_t capacity = (r == 0) ? HEADER_BYTES + 40 : out.size();
+            ReaderResult& result = results[r];
+            while (true) {
+                bool finished = done;
+                size_t bytes = reader.read(out.data(), capacity);
+                result.bytes += bytes;
+                result.records += checkRecords(out.data(), bytes, result.last, result.skipped);
+                if (finished && bytes == 0) break;
+            }
+            result.lostBytes = reader.getLostBytes();
+        });
+    }
+
+    while (readersStarted < READERS) {
+        std::this_thread::yield();
+    }
+
+    std::thread producer([&]() {
+        for (uint64_t n = 1; n <= RECORDS; n++) {
+            pushRecord(ring, n);
+        }
+        done = true;
+    });
+
+    producer.join();
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(ring.getRecordCount(), RECORDS);
+    for (const ReaderResult& result : results) {
+        // Every byte pushed was either read or counted as lost, and so was every record
+        EXPECT_EQ(result.bytes + result.lostBytes, ring.getByteCount());
+        EXPECT_EQ(result.records + result.skipped, RECORDS);
+        EXPECT_EQ(result.last, RECORDS);
+        EXPECT_GT(result.records, 0u);
+    }
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "zp_params.hpp"
+
+struct CallbackTarget {
+    float lastValue = 0.0f;
+    int calls = 0;
+};
+
+static bool acceptPositive(CallbackTarget* target, float value) {
+    target->calls++;
+    if (value <= 0.0f) return false;
+    target->lastValue = value;
+    return true;
+}
+
+TEST(ParamRegistryTest, StartsWithDefaults) {
+    ParamRegistry params;
+    EXPECT_FLOAT_EQ(params.get(ZP_PARAM_ID::SERVO1_TRIM), 1500.0f);
+    EXPECT_EQ(params.getIndexById("SCHED_LOOP_RATE"), static_cast<int16_t>(ZP_PARAM_ID::SCHED_LOOP_RATE));
+    EXPECT_EQ(params.getIndexById("NOT_A_PARAM"), static_cast<int16_t>(ZP_PARAM_ID::PARAM_COUNT));
+    EXPECT_EQ(params.getParamByIndex(ParamRegistry::getCount()), nullptr);
+}
+
+TEST(ParamRegistryTest, RegistriesAreIndependent) {
+    ZP_PARAM::init();
+    ParamRegistry first;
+    ParamRegistry second;
+
+    ASSERT_TRUE(first.setParamById("BATT_CAPACITY", 1234.0f));
+    EXPECT_FLOAT_EQ(first.get(ZP_PARAM_ID::BATT_CAPACITY), 1234.0f);
+    EXPECT_FLOAT_EQ(second.get(ZP_PARAM_ID::BATT_CAPACITY), ZP_PARAM::get(ZP_PARAM_ID::BATT_CAPACITY));
+    EXPECT_NE(ZP_PARAM::get(ZP_PARAM_ID::BATT_CAPACITY), 1234.0f);
+}
+
+TEST(ParamRegistryTest, CallbacksAreBoundPerRegistry) {
+    ParamRegistry first;
+    ParamRegistry second;
+    CallbackTarget target;
+    first.bindCallback(ZP_PARAM_ID::SID_MAGNITUDE, &target, acceptPositive);
+
+    EXPECT_FALSE(first.setParamById("SID_MAGNITUDE", -1.0f));
+    EXPECT_TRUE(first.setParamById("SID_MAGNITUDE", 0.3f));
+    EXPECT_FLOAT_EQ(target.lastValue, 0.3f);
+
+    // No callback on the other registry, any value is taken
+    EXPECT_TRUE(second.setParamById("SID_MAGNITUDE", -1.0f));
+    EXPECT_EQ(target.calls, 2);
+}
+
+TEST(ParamRegistryTest, InitRestoresDefaultsAndDropsCallbacks) {
+    ParamRegistry params;
+    CallbackTarget target;
+    params.bindCallback(ZP_PARAM_ID::SID_MAGNITUDE, &target, acceptPositive);
+    ASSERT_TRUE(params.setParamById("SID_MAGNITUDE", 0.5f));
+
+    params.init();
+    EXPECT_FLOAT_EQ(params.get(ZP_PARAM_ID::SID_MAGNITUDE), 0.1f);
+    EXPECT_TRUE(params.setParamById("SID_MAGNITUDE", -1.0f));
+    EXPECT_EQ(target.calls, 1);
+}
+
+TEST(ParamRegistryTest, FacadeUsesFirmwareRegistry) {
+    ZP_PARAM::init();
+    ASSERT_TRUE(ZP_PARAM::setParamById("RC_FS_TIMEOUT", 2.5f));
+    EXPECT_FLOAT_EQ(ZP_PARAM::registry().get(ZP_PARAM_ID::RC_FS_TIMEOUT), 2.5f);
+    EXPECT_EQ(ZP_PARAM::getParamByIndex(0), ZP_PARAM::registry().getParamByIndex(0));
+    ZP_PARAM::init();
+}
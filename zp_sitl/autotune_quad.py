@@ -0,0 +1,130 @@
+"""Run AUTOTUNE end to end in quad SITL and report how long each axis took to converge.
+
+Runs the managers headless against a hovering quad X with per-axis rigid body rate dynamics,
+motor lag and transport delay. Translation is held fixed, only the attitude loops see the plant.
+The vehicle takes off in STABILIZE, switches to AUTOTUNE with the sticks centred and runs until
+every axis in AUTOTUNE_AXES has converged or failed.
+
+Usage: python autotune_quad.py [--max-time S] [--roll-gain G] [--delay-ms D]
+"""
+import argparse
+import math
+import zeropilot
+
+SITL_RATE_HZ = 1000
+DT = 1.0 / SITL_RATE_HZ
+WARMUP_S = 3.0
+FLTMODE_STABILIZE = 16.5    # Switch slot 1
+FLTMODE_AUTOTUNE = 29.5     # Switch slot 2
+AUTOTUNE_MODE = 15
+HOVER_THROTTLE = 50.0
+
+# Quad X, ArduPilot motor order: roll and pitch arm projections and yaw direction
+ROLL_FACTOR = (-0.7071, 0.7071, 0.7071, -0.7071)
+PITCH_FACTOR = (0.7071, -0.7071, 0.7071, -0.7071)
+YAW_FACTOR = (1.0, 1.0, -1.0, -1.0)
+
+
+class QuadRatePlant:
+    """Angular acceleration per unit of mixed effort on each axis, through motor lag and dead time."""
+
+    def __init__(self, gains, motor_tau_s, delay_s, spin_min, spin_max):
+        self.gains = gains
+        self.motor_tau_s = motor_tau_s
+        self.delay = [[0.0] * 4 for _ in range(max(1, round(delay_s / DT)))]
+        self.spin_min = spin_min
+        self.spin_max = spin_max
+        self.thrust = [0.0] * 4
+        self.rates = [0.0, 0.0, 0.0]
+        self.angles = [0.0, 0.0, 0.0]
+
+    def step(self, motor_percent):
+        # Motor command back to normalized thrust, MOT_THST_EXPO is set to 0 so this is linear
+        command = [min(max((p / 100.0 - self.spin_min) / (self.spin_max - self.spin_min), 0.0), 1.0)
+                   for p in motor_percent]
+        self.delay.append(command)
+        delayed = self.delay.pop(0)
+        for i in range(4):
+            self.thrust[i] += (delayed[i] - self.thrust[i]) * DT / self.motor_tau_s
+
+        # Project the differential thrust back onto each axis, the inverse of the mixer
+        efforts = (
+            sum(f * t for f, t in zip(ROLL_FACTOR, self.thrust)) / sum(f * f for f in ROLL_FACTOR),
+            sum(f * t for f, t in zip(PITCH_FACTOR, self.thrust)) / sum(f * f for f in PITCH_FACTOR),
+            sum(f * t for f, t in zip(YAW_FACTOR, self.thrust)) / sum(f * f for f in YAW_FACTOR),
+        )
+        for axis in range(3):
+            self.rates[axis] += self.gains[axis] * efforts[axis] * DT
+            self.angles[axis] += self.rates[axis] * DT
+
+    def feed(self, zp):
+        roll, pitch, _ = self.angles
+        p, q, r = self.rates
+        zp.update_from_plant(roll, pitch, p, q, r, 43.47, -80.54, 100.0, 0.0, 0.0, 0.0, 0.0, 1.0, 101.325, 15.0)
+
+
+def run(args):
+    zp = zeropilot.ZeroPilot(sitl_rate_hz=SITL_RATE_HZ)
+    if len(zp.get_motor_outputs()) != 4:
+        raise SystemExit("AUTOTUNE needs the QUADCOPTER build: ./scripts/build_sitl.sh QUADCOPTER")
+
+    zp.set_param("MOT_THST_EXPO", 0.0)
+    zp.set_param("FLTMODE2", AUTOTUNE_MODE)
+    plant = QuadRatePlant(
+        (args.roll_gain, args.pitch_gain, args.yaw_gain), args.motor_tau_ms / 1000.0, args.delay_ms / 1000.0,
+        zp.get_param("MOT_SPIN_MIN"), zp.get_param("MOT_SPIN_MAX"))
+
+    params = ("ATC_RAT_RLL_P", "ATC_RAT_RLL_I", "ATC_RAT_RLL_D", "ATC_RAT_PIT_P", "ATC_RAT_PIT_I", "ATC_RAT_PIT_D",
+              "ATC_RAT_YAW_P", "ATC_RAT_YAW_I", "ATC_RAT_YAW_D", "ATC_ANG_RLL_P", "ATC_ANG_PTCH_P")
+    before = {name: zp.get_param(name) for name in params}
+
+    # Armed hover in STABILIZE first so the attitude estimate and integrators are settled
+    ticks = 0
+    fltmode = FLTMODE_STABILIZE
+    autotune_start_tick = None
+    while ticks * DT < WARMUP_S + args.max_time:
+        if autotune_start_tick is None and ticks * DT >= WARMUP_S:
+            fltmode = FLTMODE_AUTOTUNE
+            autotune_start_tick = ticks
+
+        plant.feed(zp)
+        zp.set_rc(50.0, 50.0, 50.0, HOVER_THROTTLE, 100.0, fltmode)
+        zp.update()
+        plant.step(zp.get_motor_outputs())
+        ticks += 1
+
+        if max(abs(a) for a in plant.angles[:2]) > math.radians(60):
+            raise SystemExit(f"Vehicle upset at {ticks * DT:.1f} s, roll {math.degrees(plant.angles[0]):.0f} deg, "
+                             f"pitch {math.degrees(plant.angles[1]):.0f} deg")
+
+        if autotune_start_tick is not None and ticks % SITL_RATE_HZ == 0 and zp.get_autotune_status()["complete"]:
+            break
+
+    status = zp.get_autotune_status()
+    total_s = (ticks - autotune_start_tick) * DT
+    print(f"AUTOTUNE {'complete' if status['complete'] else 'incomplete'} after {total_s:.1f} s of flight")
+    print(f"{'axis':>6} {'status':>10} {'twitches':>8} {'time s':>7} {'K rad/s2':>9} {'true K':>7} {'delay ms':>8}")
+    true_gains = {"roll": args.roll_gain, "pitch": args.pitch_gain, "yaw": args.yaw_gain}
+    for name, axis in status["axes"].items():
+        print(f"{name:>6} {axis['status']:>10} {axis['twitches']:>8} {axis['elapsed_s']:>7.2f} "
+              f"{axis['plant_gain']:>9.1f} {true_gains[name]:>7.1f} {axis['delay_s'] * 1000.0:>8.1f}")
+
+    print()
+    print(f"{'param':>16} {'before':>8} {'after':>8}")
+    for name in params:
+        print(f"{name:>16} {before[name]:>8.4f} {zp.get_param(name):>8.4f}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run AUTOTUNE against a simulated quad and report convergence.")
+    parser.add_argument("--max-time", type=float, default=120.0, help="Seconds of AUTOTUNE flight before giving up")
+    parser.add_argument("--roll-gain", type=float, default=220.0, help="Roll rad/s^2 per unit effort")
+    parser.add_argument("--pitch-gain", type=float, default=180.0, help="Pitch rad/s^2 per unit effort")
+    parser.add_argument("--yaw-gain", type=float, default=60.0, help="Yaw rad/s^2 per unit effort")
+    parser.add_argument("--motor-tau-ms", type=float, default=20.0, help="Motor spin up time constant")
+    parser.add_argument("--delay-ms", type=float, default=5.0, help="ESC and sensor transport delay")
+    run(parser.parse_args())
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,147 @@
+"""Fly a short regression profile against the built-in C++ plant, no external simulator or network.
+
+The vehicle, its sensors and the 6-DOF physics all step inside the extension, Python only sets the
+sticks between phases. Works with either build: QUADCOPTER takes off in STABILIZE and steps roll,
+pitch and yaw, PLANE takes off in FBWA, climbs and banks. Each phase checks the plant state and the
+script exits non-zero on the first failure, so it can gate CI.
+
+Usage: python headless_flight.py [--seed N] [--wind-north M/S] [--wind-east M/S]
+"""
+import argparse
+import math
+import sys
+import time
+import zeropilot
+
+SITL_RATE_HZ = 1000
+FLTMODE_SLOT1 = 16.5
+FLTMODE_SLOT2 = 29.5
+UPSET_DEG = 75.0
+
+
+class Flight:
+    def __init__(self, zp):
+        self.zp = zp
+        self.sim_s = 0.0
+        self.failures = []
+
+    def hold(self, seconds, roll=50.0, pitch=50.0, yaw=50.0, throttle=0.0, arm=100.0, fltmode=FLTMODE_SLOT1):
+        """Holds the sticks for a phase, stepping in chunks so upsets are caught near when they happen."""
+        is_plane = len(self.zp.get_motor_outputs()) == 6
+        chunk = SITL_RATE_HZ // 10
+        for _ in range(int(seconds * SITL_RATE_HZ) // chunk):
+            if is_plane:
+                self.zp.set_rc(roll, pitch, yaw, throttle, arm, 0.0, fltmode)
+            else:
+                self.zp.set_rc(roll, pitch, yaw, throttle, arm, fltmode)
+            if not self.zp.update(chunk):
+                self.fail("watchdog expired")
+                return self.zp.get_plant_state()
+            self.sim_s += chunk / SITL_RATE_HZ
+
+            state = self.zp.get_plant_state()
+            if max(abs(math.degrees(state["roll_rad"])), abs(math.degrees(state["pitch_rad"]))) > UPSET_DEG:
+                self.fail(f"upset, roll {math.degrees(state['roll_rad']):.0f} deg, pitch {math.degrees(state['pitch_rad']):.0f} deg")
+                return state
+        return self.zp.get_plant_state()
+
+    def check(self, ok, message):
+        if not ok:
+            self.fail(message)
+
+    def fail(self, message):
+        self.failures.append(f"t={self.sim_s:.1f} s: {message}")
+
+    def report(self, name, state):
+        alt = -state["position_ned_m"][2]
+        print(f"{name:>14} t={self.sim_s:5.1f} s alt={alt:6.1f} m airspeed={state['airspeed_mps']:5.1f} m/s "
+              f"roll={math.degrees(state['roll_rad']):6.1f} pitch={math.degrees(state['pitch_rad']):6.1f} "
+              f"yaw={math.degrees(state['yaw_rad']):6.1f} deg")
+
+
+def fly_quad(flight):
+    flight.report("disarmed", flight.hold(1.0, arm=0.0))
+    flight.report("armed", flight.hold(1.0))
+
+    state = flight.hold(3.0, throttle=62.0)
+    flight.report("takeoff", state)
+    flight.check(-state["position_ned_m"][2] > 5.0, "did not climb above 5 m")
+
+    state = flight.hold(3.0, throttle=52.0)
+    flight.report("hover", state)
+    flight.check(abs(math.degrees(state["roll_rad"])) < 5.0 and abs(math.degrees(state["pitch_rad"])) < 5.0, "not level in hover")
+
+    state = flight.hold(1.5, roll=75.0, throttle=52.0)
+    flight.report("roll right", state)
+    flight.check(math.degrees(state["roll_rad"]) > 15.0, "roll stick right did not bank right")
+
+    state = flight.hold(1.5, pitch=25.0, throttle=52.0)
+    flight.report("pitch up", state)
+    flight.check(math.degrees(state["pitch_rad"]) > 15.0, "pitch stick back did not pitch up")
+
+    yaw_before = flight.zp.get_plant_state()["yaw_rad"]
+    state = flight.hold(1.0, yaw=80.0, throttle=52.0)
+    flight.report("yaw right", state)
+    flight.check(math.sin(state["yaw_rad"] - yaw_before) > 0.5, "yaw stick right did not turn right")
+
+    state = flight.hold(3.0, throttle=52.0)
+    flight.report("recover", state)
+    flight.check(not state["on_ground"], "landed during the profile")
+
+
+def fly_plane(flight):
+    fbwa = FLTMODE_SLOT2
+    flight.report("disarmed", flight.hold(1.0, arm=0.0, fltmode=fbwa))
+    flight.report("armed", flight.hold(1.0, fltmode=fbwa))
+
+    state = flight.hold(5.0, throttle=100.0, fltmode=fbwa)
+    flight.report("takeoff roll", state)
+    flight.check(state["airspeed_mps"] > 15.0, "did not reach 15 m/s on the takeoff roll")
+
+    state = flight.hold(13.0, pitch=30.0, throttle=100.0, fltmode=fbwa)
+    flight.report("climb", state)
+    flight.check(-state["position_ned_m"][2] > 10.0, "did not climb above 10 m")
+
+    state = flight.hold(4.0, throttle=65.0, fltmode=fbwa)
+    flight.report("cruise", state)
+
+    yaw_before = state["yaw_rad"]
+    state = flight.hold(2.0, roll=70.0, throttle=65.0, fltmode=fbwa)
+    flight.report("bank right", state)
+    flight.check(math.degrees(state["roll_rad"]) > 10.0, "roll stick right did not bank right")
+
+    state = flight.hold(4.0, throttle=65.0, fltmode=fbwa)
+    flight.report("level", state)
+    flight.check(math.sin(state["yaw_rad"] - yaw_before) > 0.1, "bank right did not turn right")
+    flight.check(not state["on_ground"], "landed during the profile")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Fly a regression profile against the built-in plant.")
+    parser.add_argument("--seed", type=int, default=0, help="Sensor noise seed")
+    parser.add_argument("--wind-north", type=float, default=0.0, help="Wind from the south, m/s")
+    parser.add_argument("--wind-east", type=float, default=0.0, help="Wind from the west, m/s")
+    args = parser.parse_args()
+
+    zp = zeropilot.ZeroPilot(sitl_rate_hz=SITL_RATE_HZ, sim_clock=True, log=False, plant=True, seed=args.seed)
+    zp.set_wind(args.wind_north, args.wind_east, 0.0)
+    flight = Flight(zp)
+
+    start = time.perf_counter()
+    if len(zp.get_motor_outputs()) == 6:
+        fly_plane(flight)
+    else:
+        fly_quad(flight)
+    wall_s = time.perf_counter() - start
+
+    print(f"\n{flight.sim_s:.1f} s of flight in {wall_s:.2f} s of wall time, {flight.sim_s / wall_s:.0f}x real time")
+    if flight.failures:
+        print("FAILED")
+        for failure in flight.failures:
+            print(f"  {failure}")
+        sys.exit(1)
+    print("PASSED")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,86 @@
+"""Measure stick-to-motor latency through ZeroPilot with and without the RC fast path.
+
+Runs the managers headless against a level, stationary plant. Each trial steps one stick
+at a random phase of the SM schedule and counts SITL ticks until a motor output moves.
+
+Usage: python rc_latency.py [--trials N]
+"""
+import argparse
+import random
+import statistics
+import zeropilot
+
+SITL_RATE_HZ = 1000
+WARMUP_TICKS = 2000
+MAX_WAIT_TICKS = 500
+FLTMODE_1 = 16.5
+
+
+def hold_plant(zp):
+    # Level, stationary vehicle at 100 m with standard sea level pressure
+    zp.update_from_plant(0.0, 0.0, 0.0, 0.0, 0.0, 43.47, -80.54, 100.0, 0.0, 0.0, 0.0, 0.0, 1.0, 101.325, 15.0)
+
+
+def set_sticks(zp, is_plane, stick):
+    if is_plane:
+        # Roll stick, manual mode passes it straight to the ailerons
+        zp.set_rc(stick, 50.0, 50.0, 0.0, 100.0, 0.0, FLTMODE_1)
+    else:
+        # Throttle stick, mixed into every motor
+        zp.set_rc(0.0, 0.0, 0.0, stick, 100.0, FLTMODE_1)
+
+
+def run_trials(fast_path, trials, rng):
+    zp = zeropilot.ZeroPilot(sitl_rate_hz=SITL_RATE_HZ)
+    zp.set_rc_fast_path(fast_path)
+    is_plane = len(zp.get_motor_outputs()) == 6
+    low, high = (30.0, 70.0) if is_plane else (20.0, 60.0)
+
+    stick = low
+    for _ in range(WARMUP_TICKS):
+        hold_plant(zp)
+        set_sticks(zp, is_plane, stick)
+        zp.update()
+
+    latencies_ms = []
+    for _ in range(trials):
+        # Random phase relative to the SM and AM schedules
+        for _ in range(rng.randrange(SITL_RATE_HZ // 10)):
+            hold_plant(zp)
+            set_sticks(zp, is_plane, stick)
+            zp.update()
+
+        before = zp.get_motor_outputs()
+        stick = high if stick == low else low
+        for tick in range(1, MAX_WAIT_TICKS + 1):
+            hold_plant(zp)
+            set_sticks(zp, is_plane, stick)
+            zp.update()
+            if zp.get_motor_outputs() != before:
+                latencies_ms.append(tick * 1000.0 / SITL_RATE_HZ)
+                break
+
+    return latencies_ms
+
+
+def report(name, latencies_ms):
+    if not latencies_ms:
+        print(f"{name:>10}: no response")
+        return
+    print(f"{name:>10}: mean {statistics.mean(latencies_ms):6.2f} ms  "
+          f"median {statistics.median(latencies_ms):6.2f} ms  max {max(latencies_ms):6.2f} ms  "
+          f"({len(latencies_ms)} trials)")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Measure SITL stick-to-motor latency.")
+    parser.add_argument("--trials", type=int, default=100, help="Stick steps per configuration")
+    parser.add_argument("--seed", type=int, default=1, help="Seed for the step phase")
+    args = parser.parse_args()
+
+    report("SM relay", run_trials(False, args.trials, random.Random(args.seed)))
+    report("fast path", run_trials(True, args.trials, random.Random(args.seed)))
+
+
+if __name__ == '__main__':
+    main()
@@ -26,35 +26,63 @@ VEHICLE = os.environ.get('V', 'PLANE').upper()
 if VEHICLE not in ('QUADCOPTER', 'PLANE'):
     raise ValueError(f"ZP_VEHICLE must be QUADCOPTER or PLANE, got: {VEHICLE}")
 
+# DSP backend: DSP=HOST (default) uses the host-optimized math and FFT, DSP=CMSIS the CMSIS-DSP
+# reference C code the boards run, to compare against
+DSP = os.environ.get('DSP', 'HOST').upper()
+if DSP not in ('HOST', 'CMSIS'):
+    raise ValueError(f"DSP must be HOST or CMSIS, got: {DSP}")
+
 # Handle OS-specific compiler and linker settings
 if platform.system() == "Windows":
     compile_args = ['/std:c++20', '/D_USE_MATH_DEFINES', '/D_CRT_SECURE_NO_WARNINGS', '/wd4244', '/D__GNUC_PYTHON__', f'/D{VEHICLE}']
     libraries = ['ws2_32']
 else:
     # GCC/Clang Flags
-    compile_args = ['-std=c++17', '-D__GNUC_PYTHON__', f'-D{VEHICLE}']
-    libraries = []
+    compile_args = ['-std=c++17', '-pthread', '-D__GNUC_PYTHON__', f'-D{VEHICLE}']
+    libraries = ['pthread']
+
+if DSP == 'CMSIS':
+    compile_args.append('/DZP_SITL_CMSIS_DSP' if platform.system() == "Windows" else '-DZP_SITL_CMSIS_DSP')
+elif platform.system() != "Windows":
+    # The host kernels need the -O3 vectorizer, some Python builds only pass -O2
+    compile_args.append('-O3')
 
 # Collect ZeroPilot source files
-sources = ['zeropilot_wrapper.cpp']
+sources = ['zeropilot_wrapper.cpp', 'sitl_vehicle.cpp', 'sitl_batch_runner.cpp', 'sitl_plant.cpp', 'sitl_telem_capture.cpp']
 sources += glob.glob(
     os.path.join(zeropilot_root, 'src', '**', '*.cpp'),
     recursive=True
 )
 
-# Add on CMSIS-DSP source files
+# Add on CMSIS-DSP source files for the reference backend
+if DSP == 'CMSIS':
+    sources += [
+        '../external/CMSIS-DSP/Source/TransformFunctions/arm_rfft_fast_f32.c',
+        '../external/CMSIS-DSP/Source/TransformFunctions/arm_rfft_fast_init_f32.c',
+        '../external/CMSIS-DSP/Source/TransformFunctions/arm_cfft_f32.c',
+        '../external/CMSIS-DSP/Source/TransformFunctions/arm_cfft_init_f32.c',
+        '../external/CMSIS-DSP/Source/TransformFunctions/arm_cfft_radix8_f32.c',
+        '../external/CMSIS-DSP/Source/TransformFunctions/arm_bitreversal2.c',
+        '../external/CMSIS-DSP/Source/ComplexMathFunctions/arm_cmplx_mag_f32.c',
+        '../external/CMSIS-DSP/Source/FastMathFunctions/arm_sin_f32.c',
+        '../external/CMSIS-DSP/Source/FastMathFunctions/arm_cos_f32.c',
+        '../external/CMSIS-DSP/Source/CommonTables/arm_common_tables.c',
+        '../external/CMSIS-DSP/Source/CommonTables/arm_const_structs.c',
+    ]
+
+# Add on DroneCAN source files
 sources += [
-    '../external/CMSIS-DSP/Source/TransformFunctions/arm_rfft_fast_f32.c',
-    '../external/CMSIS-DSP/Source/TransformFunctions/arm_rfft_fast_init_f32.c',
-    '../external/CMSIS-DSP/Source/TransformFunctions/arm_cfft_f32.c',
-    '../external/CMSIS-DSP/Source/TransformFunctions/arm_cfft_init_f32.c',
-    '../external/CMSIS-DSP/Source/TransformFunctions/arm_cfft_radix8_f32.c',
-    '../external/CMSIS-DSP/Source/TransformFunctions/arm_bitreversal2.c',
-    '../external/CMSIS-DSP/Source/ComplexMathFunctions/arm_cmplx_mag_f32.c',
-    '../external/CMSIS-DSP/Source/FastMathFunctions/arm_sin_f32.c',
-    '../external/CMSIS-DSP/Source/FastMathFunctions/arm_cos_f32.c',
-    '../external/CMSIS-DSP/Source/CommonTables/arm_common_tables.c',
-    '../external/CMSIS-DSP/Source/CommonTables/arm_const_structs.c',
+    '../external/dronecan/libcanard/canard.c',
+    '../external/dronecan/generated/src/uavcan.protocol.NodeStatus.c',
+    '../external/dronecan/generated/src/uavcan.protocol.dynamic_node_id.Allocation.c',
+    '../external/dronecan/generated/src/uavcan.equipment.esc.RawCommand.c',
+    '../external/dronecan/generated/src/uavcan.equipment.esc.Status.c',
+    '../external/dronecan/generated/src/uavcan.equipment.actuator.ArrayCommand.c',
+    '../external/dronecan/generated/src/uavcan.equipment.gnss.Fix2.c',
+    '../external/dronecan/generated/src/uavcan.equipment.air_data.StaticPressure.c',
+    '../external/dronecan/generated/src/uavcan.equipment.air_data.StaticTemperature.c',
+    '../external/dronecan/generated/src/uavcan.equipment.air_data.RawAirData.c',
+    '../external/dronecan/generated/src/uavcan.equipment.ahrs.MagneticFieldStrength2.c',
 ]
 
 zeropilot = Extension(
@@ -68,10 +96,13 @@ zeropilot = Extension(
         f'{zeropilot_root}/include/thread_msgs',
         f'{zeropilot_root}/include/driver_ifaces',
         f'{zeropilot_root}/include/zp_param',
+        f'{zeropilot_root}/include/driver_utils',
         '../external/c_library_v2',
         '../external/c_library_v2/common',
         '../external/CMSIS-DSP/Include',
         '../external/CMSIS-DSP/PrivateInclude',
+        '../external/dronecan/libcanard',
+        '../external/dronecan/generated/include',
     ],
     libraries=libraries,
     extra_compile_args=compile_args,
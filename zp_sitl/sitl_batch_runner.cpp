@@ -0,0 +1,86 @@
+#include "sitl_batch_runner.hpp"
+
+SITLBatchRunner::SITLBatchRunner(unsigned threadCount) :
+    generation(0),
+    busyWorkers(0),
+    stopping(false),
+    jobVehicles(nullptr),
+    jobHealthy(nullptr),
+    jobCount(0),
+    jobTicks(0),
+    jobHook(nullptr),
+    nextVehicle(0) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        threadCount = 1; // hardware_concurrency() may not know
+    }
+
+    workers.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; i++) {
+        workers.emplace_back(&SITLBatchRunner::workerLoop, this);
+    }
+}
+
+SITLBatchRunner::~SITLBatchRunner() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    startCv.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void SITLBatchRunner::run(SITLVehicle* const* vehicles, bool* healthy, size_t count, uint32_t ticks, const TickHook_t& hook) {
+    if (count == 0) return;
+
+    std::lock_guard<std::mutex> runLock(runMutex);
+    std::unique_lock<std::mutex> lock(mutex);
+    jobVehicles = vehicles;
+    jobHealthy = healthy;
+    jobCount = count;
+    jobTicks = ticks;
+    jobHook = hook ? &hook : nullptr;
+    nextVehicle.store(0, std::memory_order_relaxed);
+    busyWorkers = static_cast<unsigned>(workers.size());
+    generation++;
+    startCv.notify_all();
+
+    doneCv.wait(lock, [this] { return busyWorkers == 0; });
+}
+
+void SITLBatchRunner::workerLoop() {
+    uint64_t seenGeneration = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        startCv.wait(lock, [this, seenGeneration] { return stopping || generation != seenGeneration; });
+        if (stopping) return;
+        seenGeneration = generation;
+
+        lock.unlock();
+        stepVehicles();
+        lock.lock();
+
+        if (--busyWorkers == 0) {
+            doneCv.notify_one();
+        }
+    }
+}
+
+void SITLBatchRunner::stepVehicles() {
+    for (size_t i = nextVehicle.fetch_add(1, std::memory_order_relaxed); i < jobCount;
+         i = nextVehicle.fetch_add(1, std::memory_order_relaxed)) {
+        SITLVehicle& vehicle = *jobVehicles[i];
+        bool alive = true;
+        for (uint32_t tick = 0; tick < jobTicks && alive; tick++) {
+            if (jobHook != nullptr) {
+                (*jobHook)(vehicle, i, tick);
+            }
+            alive = vehicle.update();
+        }
+        jobHealthy[i] = alive;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "sitl_vehicle.hpp"
+#include <condition_variable>
+#include <functional>
+#include <thread>
+
+/*
+ * Steps many independent vehicles on a fixed pool of worker threads, for Monte-Carlo gain and
+ * failure injection sweeps. Each worker takes whole vehicles and runs all their ticks in one go,
+ * so a vehicle never moves between threads within a run.
+ */
+class SITLBatchRunner {
+    public:
+        // Called on the worker before each tick of each vehicle, for plant updates and injected
+        // failures. Must not throw and must only touch that vehicle.
+        typedef std::function<void(SITLVehicle& vehicle, size_t vehicleIndex, uint32_t tick)> TickHook_t;
+
+        explicit SITLBatchRunner(unsigned threadCount = 0); // 0 uses every hardware thread
+        ~SITLBatchRunner();
+
+        SITLBatchRunner(const SITLBatchRunner&) = delete;
+        SITLBatchRunner& operator=(const SITLBatchRunner&) = delete;
+
+        // Runs ticks updates of every vehicle and blocks until all are done. healthy[i] goes false
+        // for a vehicle whose watchdog expired, it stops at that tick. Vehicles must be distinct.
+        void run(SITLVehicle* const* vehicles, bool* healthy, size_t count, uint32_t ticks, const TickHook_t& hook = nullptr);
+
+        unsigned getThreadCount() const { return static_cast<unsigned>(workers.size()); }
+
+    private:
+        std::vector<std::thread> workers;
+
+        std::mutex runMutex;    // One run at a time
+        std::mutex mutex;
+        std::condition_variable startCv;
+        std::condition_variable doneCv;
+        uint64_t generation;    // Bumped for each run, wakes the workers
+        unsigned busyWorkers;
+        bool stopping;
+
+        // Current run, only valid while busyWorkers > 0
+        SITLVehicle* const* jobVehicles;
+        bool* jobHealthy;
+        size_t jobCount;
+        uint32_t jobTicks;
+        const TickHook_t* jobHook;
+        std::atomic<size_t> nextVehicle;
+
+        void workerLoop();
+        void stepVehicles();
+};
@@ -6,6 +6,8 @@ namespace SITL_Driver_Configs {
 
     struct SITL_GPS_Config {
         static constexpr uint8_t NUM_SATELLITES = 12; // Number of satellites in view
+        static constexpr uint32_t H_ACC_MM = 1500;    // Reported horizontal accuracy
+        static constexpr uint32_t V_ACC_MM = 2500;    // Reported vertical accuracy
     };
 
     struct SITL_IMU_Config {
@@ -46,5 +48,6 @@ namespace SITL_Driver_Configs {
 
     struct SITL_TELEM_Config {
         static constexpr uint32_t RX_BUF_SZ_BYTES = 1048576; // 1 MB receive buffer
+        static constexpr uint32_t CAPTURE_RING_BYTES = 1048576; // Raw traffic kept for readers, per vehicle with a link
     };
 }
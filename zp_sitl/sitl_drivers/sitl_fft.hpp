@@ -1,5 +1,7 @@
 #pragma once
 
+#ifdef ZP_SITL_CMSIS_DSP
+
 #include "arm_math.h"
 #include "fft_iface.hpp"
 
@@ -19,3 +21,12 @@ class SITL_FFT : public IFFT {
     private:
         arm_rfft_fast_instance_f32 fft;
 };
+
+#else
+
+#include "host_fft.hpp"
+
+// Host real FFT, DSP=CMSIS builds the CMSIS-DSP reference C code above instead
+class SITL_FFT : public HostFFT {};
+
+#endif
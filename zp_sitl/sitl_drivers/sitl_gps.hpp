@@ -1,28 +1,67 @@
 #pragma once
+#include <cmath>
 #include "gps_iface.hpp"
+#include "gps_stream_parser.hpp"
 #include "sitl_driver_configs.hpp"
 
 class SITL_GPS : public IGPS {
 private:
     using Config = SITL_Driver_Configs::SITL_GPS_Config;
 
-    GpsData_t gpsData = {{0,0,0,0,0,0}, 0.0f, 0.0f, 0.0f, 0, 0.0f, 0.0f, false, 0.0f, 0.0f, 0.0f};
-    
+    static constexpr uint8_t NAV_PVT_LEN = 92;
+
+    // Same parser as the hardware driver, so SITL exercises the real decode path
+    GpsStreamParser parser;
+
+    static void putLE(uint8_t *payload, uint8_t offset, int32_t value, uint8_t size) {
+        for (uint8_t i = 0; i < size; i++) {
+            payload[offset + i] = (uint8_t)((uint32_t)value >> (8 * i));
+        }
+    }
+
 public:
     void update_from_plant(double lat_deg, double lon_deg, double alt_m, double ground_speed_mps, double course_deg) {
-        gpsData.latitude = lat_deg;
-        gpsData.longitude = lon_deg;
-        gpsData.altitude = alt_m;
-        gpsData.groundSpeed = ground_speed_mps * 100.0f;  // m/s to cm/s
-        gpsData.trackAngle = course_deg;
-        gpsData.vx = 0;
-        gpsData.vy = 0;
-        gpsData.vz = 0;
-        gpsData.isNew = true;
-        gpsData.numSatellites = Config::NUM_SATELLITES;
+        // Level flight along the course
+        double courseRad = course_deg * M_PI / 180.0;
+        update_from_plant_ned(lat_deg, lon_deg, alt_m, ground_speed_mps * std::cos(courseRad), ground_speed_mps * std::sin(courseRad), 0.0);
     }
-    
+
+    void update_from_plant_ned(double lat_deg, double lon_deg, double alt_m, double vel_n_mps, double vel_e_mps, double vel_d_mps) {
+        double groundSpeed = std::sqrt(vel_n_mps * vel_n_mps + vel_e_mps * vel_e_mps);
+        double course = std::atan2(vel_e_mps, vel_n_mps) * 180.0 / M_PI;
+        if (course < 0.0) course += 360.0;
+
+        // Emit the plant state as a NAV-PVT frame with a 3D fix
+        uint8_t payload[NAV_PVT_LEN] = {};
+        payload[20] = 3; // fixType
+        payload[21] = 0x01; // gnssFixOK
+        payload[23] = Config::NUM_SATELLITES;
+        putLE(payload, 24, (int32_t)std::lround(lon_deg * 1e7), 4);
+        putLE(payload, 28, (int32_t)std::lround(lat_deg * 1e7), 4);
+        putLE(payload, 36, (int32_t)std::lround(alt_m * 1000.0), 4);
+        putLE(payload, 40, (int32_t)Config::H_ACC_MM, 4);
+        putLE(payload, 44, (int32_t)Config::V_ACC_MM, 4);
+        putLE(payload, 48, (int32_t)std::lround(vel_n_mps * 1000.0), 4);
+        putLE(payload, 52, (int32_t)std::lround(vel_e_mps * 1000.0), 4);
+        putLE(payload, 56, (int32_t)std::lround(vel_d_mps * 1000.0), 4);
+        putLE(payload, 60, (int32_t)std::lround(groundSpeed * 1000.0), 4);
+        putLE(payload, 64, (int32_t)std::lround(course * 1e5), 4);
+
+        uint8_t frame[NAV_PVT_LEN + 8];
+        uint16_t len = GpsStreamParser::encodeUBX(0x01, 0x07, payload, NAV_PVT_LEN, frame, sizeof(frame));
+        parser.feed(frame, len);
+    }
+
+    // Raw receiver bytes, e.g. a recorded UBX/NMEA capture
+    void feed(const uint8_t *data, uint16_t len) {
+        parser.feed(data, len);
+    }
+
+    const GpsParserStats_t &get_stats() const {
+        return parser.getStats();
+    }
+
     GpsData_t readData() override {
-        return gpsData;
+        return parser.takeData();
     }
 };
@@ -16,10 +16,19 @@ private:
     // Constants for internal conversions
     static constexpr float RAD_TO_DEG = 57.2957795f;
     static constexpr float DEG_TO_RAD = 0.0174532925f;
+    static constexpr uint32_t SAMPLE_PERIOD_US = 1000000 / SITL_Driver_Configs::SITL_DRIVER_UPDATE_RATE_HZ;
+
+    // Clip at full scale like the real sensor instead of wrapping around
+    static int16_t saturate(float lsb) {
+        if (lsb > INT16_MAX) return INT16_MAX;
+        if (lsb < INT16_MIN) return INT16_MIN;
+        return (int16_t)lsb;
+    }
 
 public:
     int init() override {
         rawData.timestamp = 0; // Initialize timestamp
+        rawData.timestampUs = 0;
         return 0; // Success
     }
     
@@ -35,27 +44,37 @@ public:
         float cp = std::cos(pitch_rad);
 
         // Accelerometer: Gravity projection (assuming 1g static)
-        // LSB_PER_G = ACCEL_SCALE (e.g., 2048)
         float ax = Config::GRAVITY * sp;
         float ay = -Config::GRAVITY * sr * cp;
         float az = -Config::GRAVITY * cr * cp;
-        
+
+        update_from_plant_specific_force(ax, ay, az, p_rad_s, q_rad_s, r_rad_s);
+    }
+
+    /**
+     * Same as update_from_plant() for plants that model the full specific force (m/s^2, body FRD),
+     * i.e. the acceleration the accelerometer really measures including thrust, drag and contact
+     */
+    void update_from_plant_specific_force(double ax, double ay, double az, double p_rad_s, double q_rad_s, double r_rad_s) {
         // Convert m/s^2 to LSB: (Value / 9.81) * Scale_Factor
+        // LSB_PER_G = ACCEL_SCALE (e.g., 2048)
         constexpr float ACCEL_TO_LSB = (float)Config::ACCEL_SCALE / Config::GRAVITY;
-        rawData.xacc = (int16_t)(ax * ACCEL_TO_LSB);
-        rawData.yacc = (int16_t)(ay * ACCEL_TO_LSB);
-        rawData.zacc = (int16_t)(az * ACCEL_TO_LSB);
+        rawData.xacc = saturate((float)ax * ACCEL_TO_LSB);
+        rawData.yacc = saturate((float)ay * ACCEL_TO_LSB);
+        rawData.zacc = saturate((float)az * ACCEL_TO_LSB);
 
         // Gyro: Convert rad/s to deg/s then to LSB
         float p_deg_s = (float)p_rad_s * RAD_TO_DEG;
         float q_deg_s = (float)q_rad_s * RAD_TO_DEG;
         float r_deg_s = (float)r_rad_s * RAD_TO_DEG;
 
-        rawData.xgyro = (int16_t)(p_deg_s * Config::GYRO_SCALE);
-        rawData.ygyro = (int16_t)(q_deg_s * Config::GYRO_SCALE);
-        rawData.zgyro = (int16_t)(r_deg_s * Config::GYRO_SCALE);
+        rawData.xgyro = saturate(p_deg_s * Config::GYRO_SCALE);
+        rawData.ygyro = saturate(q_deg_s * Config::GYRO_SCALE);
+        rawData.zgyro = saturate(r_deg_s * Config::GYRO_SCALE);
 
-        rawData.timestamp += SITL_Driver_Configs::SITL_DRIVER_UPDATE_RATE_HZ; // Increment timestamp for simulation
+        // Simulated IMU and MCU clocks are identical, so the hardware ticks are already synchronized microseconds
+        rawData.timestamp += SAMPLE_PERIOD_US;
+        rawData.timestampUs += SAMPLE_PERIOD_US;
     }
     
     RawImuBatch_t readRawData() override {
@@ -87,7 +106,7 @@ public:
             scaledData.ygyro = (float)raw.ygyro / Config::GYRO_SCALE * ZP_UNITS::DEG_TO_RAD;
             scaledData.zgyro = (float)raw.zgyro / Config::GYRO_SCALE * ZP_UNITS::DEG_TO_RAD;
 
-            scaledData.timestamp = raw.timestamp;
+            scaledData.timestampUs = raw.timestampUs;
         }
         return scaledBatch; 
     }
@@ -15,9 +15,13 @@
 class SITL_Logger : public ILogger {
 private:
     std::ofstream logFile;
+    std::ofstream binFile;
     
 public:
-    SITL_Logger(const char* filename = "sd_card/sitl_log.txt") {
+    // Null filenames log nothing, for vehicles that should not share the sd_card files
+    SITL_Logger(const char* filename = "sd_card/sitl_log.txt", const char* binFilename = "sd_card/sitl_log.bin") {
+        if (filename == nullptr || binFilename == nullptr) return;
+
         // Create directory if it doesn't exist
         if (PLATFORM_MKDIR("sd_card") == 0) {
             std::cout << "[SITL_Logger] Created directory: sd_card" << std::endl;
@@ -28,12 +32,21 @@ public:
         if (!logFile.is_open()) {
             std::cerr << "[SITL_Logger] ERROR: Could not open log file: " << filename << std::endl;
         }
+
+        binFile.open(binFilename, std::ios::app | std::ios::binary);
+
+        if (!binFile.is_open()) {
+            std::cerr << "[SITL_Logger] ERROR: Could not open binary log file: " << binFilename << std::endl;
+        }
     }
     
     ~SITL_Logger() {
         if (logFile.is_open()) {
             logFile.close();
         }
+        if (binFile.is_open()) {
+            binFile.close();
+        }
     }
     
     int log(const char message[100]) override {
@@ -55,4 +68,13 @@ public:
         }
         return -1;
     }
+    
+    int logBinary(const void *data, uint32_t len) override {
+        if (binFile.is_open()) {
+            binFile.write(static_cast<const char *>(data), len);
+            binFile.flush();
+            return 0;
+        }
+        return -1;
+    }
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#ifdef ZP_SITL_CMSIS_DSP
+
 #include "mathutils_iface.hpp"
 #include <cmath>
 #include <cstring>
@@ -291,3 +293,12 @@ class SITL_MathUtils : public IMathUtils {
             euler3[2] = std::atan2(sinyCosp, cosyCosp);
         }
 };
+
+#else
+
+#include "host_mathutils.hpp"
+
+// Host-optimized kernels, DSP=CMSIS builds the plain reference loops above instead
+class SITL_MathUtils : public HostMathUtils {};
+
+#endif
@@ -6,12 +6,17 @@ public:
     SITL_Motor() = default;
 
     void set(uint32_t percent) override {
-        currentPercent = percent;
+        currentPercent = static_cast<float>(percent);
+    }
+
+    // Keep the mixer's full resolution, the sim takes fractional percent
+    void setNormalized(float command) override {
+        currentPercent = command * 100.0f;
     }
 
     void init() override {}
 
-    uint32_t get() {
+    float get() {
         return currentPercent;
     }
 
@@ -20,5 +25,5 @@ public:
     }
 
 private:
-    uint32_t currentPercent = 0;
+    float currentPercent = 0.0f;
 };
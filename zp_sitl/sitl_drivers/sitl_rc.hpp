@@ -1,9 +1,15 @@
 #pragma once
+#include <cstring>
 #include "rc_iface.hpp"
+#include "latest_value_slot.hpp"
 
 class SITL_RC : public IRCReceiver {
 private:
     RCControl rcData;
+
+    // Mirrors the hardware receiver publishing each frame straight to the attitude loop
+    LatestValueSlot<RCChannelFrame_t> fastPath;
+    bool fastPathEnabled = true;
     
 public:
     void update_from_commands(float roll, float pitch, float yaw, float throttle, float arm, float flap, float fltmode) {
@@ -15,6 +21,22 @@ public:
         rcData.aux2 = flap;
         rcData.fltModeRaw = fltmode;
         rcData.isDataNew = true;
+
+        if (fastPathEnabled) {
+            RCChannelFrame_t frame;
+            memcpy(frame.controlSignals, rcData.controlSignals, sizeof(frame.controlSignals));
+            frame.linkStats = getLinkStats();
+            fastPath.publish(frame);
+        }
+    }
+
+    // Disabling leaves only the SM relay, for comparing stick latency
+    void set_fast_path_enabled(bool enabled) {
+        fastPathEnabled = enabled;
+    }
+
+    const LatestValueSlot<RCChannelFrame_t> *get_fast_path() const {
+        return &fastPath;
     }
     
     RCControl getRCData() override {
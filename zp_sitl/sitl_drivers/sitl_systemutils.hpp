@@ -7,15 +7,40 @@
 class SITL_SystemUtils : public ISystemUtils {
 private:
     std::chrono::steady_clock::time_point startTime;
+
+    // Simulated clock, only moves through advanceUs() so runs faster than real time stay consistent
+    bool simulatedClock;
+    uint64_t simulatedTimeUs;
     
 public:
-    SITL_SystemUtils() : startTime(std::chrono::steady_clock::now()) {}
+    explicit SITL_SystemUtils(bool simulatedClock = false)
+        : startTime(std::chrono::steady_clock::now()), simulatedClock(simulatedClock), simulatedTimeUs(0) {}
+
+    void advanceUs(uint32_t us) {
+        simulatedTimeUs += us;
+    }
     
     void delayMs(uint32_t delay_ms) override {
+        if (simulatedClock) {
+            advanceUs(delay_ms * 1000);
+            return;
+        }
         std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
     }
     
+    // Same clock as getCurrentTimestampMs(), for SITL tooling that needs finer stamps
+    uint64_t getCurrentTimestampUs() const {
+        if (simulatedClock) {
+            return simulatedTimeUs;
+        }
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+        return static_cast<uint64_t>(duration.count());
+    }
+
     uint32_t getCurrentTimestampMs() override {
+        if (simulatedClock) {
+            return static_cast<uint32_t>(simulatedTimeUs / 1000);
+        }
         auto now = std::chrono::steady_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime);
         return static_cast<uint32_t>(duration.count());
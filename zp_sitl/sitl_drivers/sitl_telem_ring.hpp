@@ -0,0 +1,143 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// In front of every record, both in the ring and in Reader::read() output (host byte order)
+typedef struct {
+    uint64_t timestampUs;
+    uint32_t length;        // Payload bytes that follow the header
+    uint8_t direction;      // 1 = TX, 0 = RX
+    uint8_t reserved[3];
+} SITLTelemRecordHeader_t;
+
+// Largest record: the header and a full uint16_t sized link read
+static constexpr size_t SITL_TELEM_MAX_RECORD_BYTES = sizeof(SITLTelemRecordHeader_t) + UINT16_MAX;
+
+/*
+ * Single producer, multi reader byte ring for the raw telemetry traffic. The stepping thread copies
+ * each packet in behind a timestamped header and never blocks, locks or allocates. When full, the
+ * oldest records are overwritten. Each reader keeps its own cursor and counts what it missed when
+ * it was lapped. As in LatestValueSlot, readers validate every copy against the oldest intact
+ * position and resync if the producer overwrote the record mid-copy.
+ */
+class SITLTelemRing {
+    public:
+        class Reader {
+            public:
+                // Starts at the newest position, so only records pushed from now on are read
+                explicit Reader(const SITLTelemRing& ring) : ring(ring), position(ring.head.load(std::memory_order_acquire)), lostBytes(0) {}
+
+                // Copies whole records, header then payload, into out and returns the bytes written.
+                // Stops before the first record that doesn't fit, so capacity should be at least
+                // SITL_TELEM_MAX_RECORD_BYTES to always make progress
+                size_t read(uint8_t* out, size_t capacity) {
+                    size_t written = 0;
+                    while (position != ring.head.load(std::memory_order_acquire)) {
+                        uint64_t first = ring.oldest.load(std::memory_order_acquire);
+                        if (position < first) {
+                            lostBytes += first - position; // Lapped by the producer
+                            position = first;
+                            continue;
+                        }
+
+                        SITLTelemRecordHeader_t header;
+                        ring.copyOut(position, &header, sizeof(header));
+                        if (!stillIntact()) continue;
+
+                        size_t recordBytes = sizeof(header) + header.length;
+                        if (written + recordBytes > capacity) break;
+
+                        ring.copyOut(position, out + written, recordBytes);
+                        if (!stillIntact()) continue;
+
+                        written += recordBytes;
+                        position += recordBytes;
+                    }
+                    return written;
+                }
+
+                // Bytes of records overwritten before this reader got to them
+                uint64_t getLostBytes() const { return lostBytes; }
+
+            private:
+                const SITLTelemRing& ring;
+                uint64_t position;
+                uint64_t lostBytes;
+
+                bool stillIntact() const {
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    return ring.oldest.load(std::memory_order_relaxed) <= position;
+                }
+        };
+
+        // Rounded up to a power of two, 0 allocates nothing and records nothing
+        explicit SITLTelemRing(size_t capacityBytes) : mask(0), head(0), oldest(0), recordCount(0), oversizeCount(0) {
+            if (capacityBytes == 0) return;
+
+            size_t size = 1;
+            while (size < capacityBytes) size <<= 1;
+            buffer.resize(size);
+            mask = size - 1;
+        }
+
+        bool isEnabled() const { return !buffer.empty(); }
+
+        // Producer side, only ever called from the stepping thread
+        void push(uint8_t direction, uint64_t timestampUs, const uint8_t* data, uint32_t length) {
+            if (buffer.empty()) return;
+
+            SITLTelemRecordHeader_t header = {timestampUs, length, direction, {0, 0, 0}};
+            size_t recordBytes = sizeof(header) + length;
+            if (recordBytes > buffer.size()) {
+                oversizeCount.store(oversizeCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return;
+            }
+
+            uint64_t start = head.load(std::memory_order_relaxed);
+            uint64_t end = start + recordBytes;
+            uint64_t first = oldest.load(std::memory_order_relaxed);
+            if (end - first > buffer.size()) {
+                // Retire the oldest records before touching their bytes
+                while (end - first > buffer.size()) {
+                    SITLTelemRecordHeader_t old;
+                    copyOut(first, &old, sizeof(old));
+                    first += sizeof(old) + old.length;
+                }
+                oldest.store(first, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+            }
+
+            copyIn(start, &header, sizeof(header));
+            copyIn(start + sizeof(header), data, length);
+            head.store(end, std::memory_order_release);
+            recordCount.store(recordCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        uint64_t getRecordCount() const { return recordCount.load(std::memory_order_relaxed); }
+        uint64_t getByteCount() const { return head.load(std::memory_order_relaxed); } // Headers included
+        uint64_t getOversizeCount() const { return oversizeCount.load(std::memory_order_relaxed); }
+
+    private:
+        std::vector<uint8_t> buffer;
+        size_t mask;
+        std::atomic<uint64_t> head;     // Bytes ever pushed, the end of the newest record
+        std::atomic<uint64_t> oldest;   // Start of the oldest record not yet overwritten
+        std::atomic<uint64_t> recordCount;
+        std::atomic<uint64_t> oversizeCount;
+
+        void copyIn(uint64_t position, const void* data, size_t length) {
+            size_t offset = position & mask;
+            size_t firstPart = length < buffer.size() - offset ? length : buffer.size() - offset;
+            memcpy(&buffer[offset], data, firstPart);
+            memcpy(&buffer[0], static_cast<const uint8_t*>(data) + firstPart, length - firstPart);
+        }
+
+        void copyOut(uint64_t position, void* out, size_t length) const {
+            size_t offset = position & mask;
+            size_t firstPart = length < buffer.size() - offset ? length : buffer.size() - offset;
+            memcpy(out, &buffer[offset], firstPart);
+            memcpy(static_cast<uint8_t*>(out) + firstPart, &buffer[0], length - firstPart);
+        }
+};
@@ -1,11 +1,8 @@
 #pragma once
 #include "telemlink_iface.hpp"
+#include "sitl_systemutils.hpp"
+#include "sitl_telem_ring.hpp"
 #include <cstring>
-#include <functional>
-#include <string>
-#include <sstream>
-#include <iomanip>
-#include <iostream>
 
 #ifdef _WIN32
     #ifndef WIN32_LEAN_AND_MEAN
@@ -34,18 +31,31 @@ private:
     int sockfd;
 #endif
     struct sockaddr_in destAddr;
-    std::function<void(const std::string&, uint8_t)> telemLogCallback;
+
+    // Raw copies of the traffic, timestamped with the vehicle clock
+    SITLTelemRing* capture;
+    SITL_SystemUtils* clock;
 
 public:
-    SITL_TELEM(const char* ip, int port, std::function<void(const std::string&, uint8_t)> telemLogCallback = nullptr)
-        : telemLogCallback(telemLogCallback) {
+    // No socket is opened without an ip, the link then sends and receives nothing
+    SITL_TELEM(const char* ip, int port, SITLTelemRing* capture = nullptr, SITL_SystemUtils* clock = nullptr)
+        : capture(capture), clock(clock) {
 #ifdef _WIN32
+        if (ip == nullptr) {
+            sockfd = INVALID_SOCKET;
+            return;
+        }
         // Initialize Windows Sockets (Required on Windows)
         WSADATA wsaData;
         if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
             sockfd = INVALID_SOCKET;
             return;
         }
+#else
+        if (ip == nullptr) {
+            sockfd = -1;
+            return;
+        }
 #endif
         sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
         
@@ -90,17 +100,7 @@ public:
         if (sockfd >= 0) {
 #endif
             sendto(sockfd, (const char*)data, size, 0, (struct sockaddr*)&destAddr, sizeof(destAddr));
-            if (telemLogCallback) {
-                std::ostringstream oss;
-                for (uint16_t i = 0; i < size; ++i) {
-                    oss << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << (int)data[i];
-                    if (i < size - 1) {
-                        oss << " "; // Add space between bytes
-                    }
-                }
-                oss << "\n"; // Add newline for clarity
-                telemLogCallback(oss.str(), 1);
-            }
+            record(1, data, size);
         }
     }
     
@@ -115,20 +115,17 @@ public:
             int receivedBytes = recvfrom(sockfd, (char*)buffer, bufferSize, 0, (struct sockaddr*)&srcAddr, &addrLen);
             
             if (receivedBytes > 0) {
-                if (telemLogCallback) {
-                    std::ostringstream oss;
-                    for (int i = 0; i < receivedBytes; ++i) {
-                        oss << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << (int)buffer[i];
-                        if (i < receivedBytes - 1) {
-                            oss << " ";
-                        }
-                    }
-                    oss << "\n";
-                    telemLogCallback(oss.str(), 0);
-                }
+                record(0, buffer, static_cast<uint32_t>(receivedBytes));
                 return static_cast<uint16_t>(receivedBytes);
             }
         }
         return 0;
     }
+
+private:
+    void record(uint8_t direction, const uint8_t* data, uint32_t size) {
+        if (capture != nullptr) {
+            capture->push(direction, clock != nullptr ? clock->getCurrentTimestampUs() : 0, data, size);
+        }
+    }
 };
@@ -0,0 +1,391 @@
+#include "sitl_plant.hpp"
+#include "sitl_vehicle.hpp"
+#include <algorithm>
+#include <cmath>
+
+static constexpr double GRAVITY = SITL_Driver_Configs::SITL_IMU_Config::GRAVITY; // Same g the IMU driver scales by
+static constexpr double EARTH_RADIUS_M = 6378137.0;
+static constexpr double RAD_TO_DEG = 180.0 / M_PI;
+static constexpr double DEG_TO_RAD = M_PI / 180.0;
+
+// ISA troposphere
+static constexpr double SEA_LEVEL_PRESSURE_KPA = 101.325;
+static constexpr double SEA_LEVEL_TEMP_K = 288.15;
+static constexpr double TEMP_LAPSE_K_PER_M = 0.0065;
+static constexpr double GAS_CONSTANT_AIR = 287.05;
+static constexpr double PRESSURE_EXPONENT = 5.25588;
+
+static double isaTemperatureK(double altM) {
+    return SEA_LEVEL_TEMP_K - TEMP_LAPSE_K_PER_M * altM;
+}
+
+static double isaPressureKPa(double altM) {
+    return SEA_LEVEL_PRESSURE_KPA * std::pow(isaTemperatureK(altM) / SEA_LEVEL_TEMP_K, PRESSURE_EXPONENT);
+}
+
+// Body to NED and back for the unit quaternion w x y z
+static void bodyToNed(const double* q, const double* body, double* ned) {
+    double w = q[0], x = q[1], y = q[2], z = q[3];
+    ned[0] = (1 - 2 * (y * y + z * z)) * body[0] + 2 * (x * y - w * z) * body[1] + 2 * (x * z + w * y) * body[2];
+    ned[1] = 2 * (x * y + w * z) * body[0] + (1 - 2 * (x * x + z * z)) * body[1] + 2 * (y * z - w * x) * body[2];
+    ned[2] = 2 * (x * z - w * y) * body[0] + 2 * (y * z + w * x) * body[1] + (1 - 2 * (x * x + y * y)) * body[2];
+}
+
+static void nedToBody(const double* q, const double* ned, double* body) {
+    double w = q[0], x = q[1], y = q[2], z = q[3];
+    body[0] = (1 - 2 * (y * y + z * z)) * ned[0] + 2 * (x * y + w * z) * ned[1] + 2 * (x * z - w * y) * ned[2];
+    body[1] = 2 * (x * y - w * z) * ned[0] + (1 - 2 * (x * x + z * z)) * ned[1] + 2 * (y * z + w * x) * ned[2];
+    body[2] = 2 * (x * z + w * y) * ned[0] + 2 * (y * z - w * x) * ned[1] + (1 - 2 * (x * x + y * y)) * ned[2];
+}
+
+static void eulerToQuat(double roll, double pitch, double yaw, double* q) {
+    double cr = std::cos(roll / 2), sr = std::sin(roll / 2);
+    double cp = std::cos(pitch / 2), sp = std::sin(pitch / 2);
+    double cy = std::cos(yaw / 2), sy = std::sin(yaw / 2);
+    q[0] = cr * cp * cy + sr * sp * sy;
+    q[1] = sr * cp * cy - cr * sp * sy;
+    q[2] = cr * sp * cy + sr * cp * sy;
+    q[3] = cr * cp * sy - sr * sp * cy;
+}
+
+// First order lag, exact for a held input so it stays stable for any time constant
+static double lag(double current, double target, double dtS, double tauS) {
+    if (tauS <= 0.0) return target;
+    return current + (target - current) * (1.0 - std::exp(-dtS / tauS));
+}
+
+SITLPlant::SITLPlant(SITLVehicle& vehicle, const SITLPlantConfig_t& config, uint32_t sitlRateHz) :
+    vehicle(vehicle),
+    config(config),
+    dtS(1.0 / sitlRateHz),
+    state{},
+    windNedMps{0.0, 0.0, 0.0},
+    actuators{},
+    rpm(0.0),
+    #ifdef QUADCOPTER
+    frame(nullptr),
+    motorCount(0),
+    motorOutput{},
+    motorX{},
+    motorY{},
+    motorSpin{},
+    #endif
+    rng(config.seed),
+    unitNoise(0.0, 1.0),
+    gpsDivider(config.sensors.gpsRateHz > 0 ? std::max<uint32_t>(1, sitlRateHz / config.sensors.gpsRateHz) : 0),
+    tick(0) {
+    state.attitudeQuat[0] = 1.0;
+    state.onGround = true;
+    state.specificForceMps2[2] = -GRAVITY;
+    state.batteryRemainingMah = config.batteryCapacityMah;
+    std::fill(motorEfficiency, motorEfficiency + SITL_PLANT_MAX_MOTORS, 1.0);
+
+    vehicle.pm.set_max_batt_capacity(static_cast<float>(config.batteryCapacityMah));
+}
+
+void SITLPlant::setWind(double northMps, double eastMps, double downMps) {
+    windNedMps[0] = northMps;
+    windNedMps[1] = eastMps;
+    windNedMps[2] = downMps;
+}
+
+void SITLPlant::setMotorEfficiency(uint8_t motor, double efficiency) {
+    if (motor >= SITL_PLANT_MAX_MOTORS) return;
+    motorEfficiency[motor] = std::clamp(efficiency, 0.0, 1.0);
+}
+
+void SITLPlant::writeSensors() {
+    const SITLSensorConfig_t& sensors = config.sensors;
+
+    vehicle.imu.update_from_plant_specific_force(
+        state.specificForceMps2[0] + sensors.accelBiasMps2[0] + noise(sensors.accelNoiseMps2),
+        state.specificForceMps2[1] + sensors.accelBiasMps2[1] + noise(sensors.accelNoiseMps2),
+        state.specificForceMps2[2] + sensors.accelBiasMps2[2] + noise(sensors.accelNoiseMps2),
+        state.ratesRadps[0] + sensors.gyroBiasRadps[0] + noise(sensors.gyroNoiseRadps),
+        state.ratesRadps[1] + sensors.gyroBiasRadps[1] + noise(sensors.gyroNoiseRadps),
+        state.ratesRadps[2] + sensors.gyroBiasRadps[2] + noise(sensors.gyroNoiseRadps));
+
+    double altitudeM = config.homeAltM - state.positionNedM[2];
+    double baroAltM = altitudeM + noise(sensors.baroNoiseM);
+    vehicle.barometer.update_from_plant(isaPressureKPa(baroAltM), isaTemperatureK(altitudeM) - 273.15);
+
+    // Slant range along the body z axis, out of range once tilted past 60 degrees
+    double tilt = std::cos(state.rollRad) * std::cos(state.pitchRad);
+    if (tilt > 0.5) {
+        vehicle.rangefinder.update_from_plant(static_cast<float>(-state.positionNedM[2] / tilt));
+    }
+
+    vehicle.pm.update_from_plant(static_cast<float>(state.batteryRemainingMah), static_cast<float>(rpm));
+
+    if (gpsDivider != 0 && tick % gpsDivider == 0) {
+        double north = state.positionNedM[0] + noise(sensors.gpsNoiseM);
+        double east = state.positionNedM[1] + noise(sensors.gpsNoiseM);
+        double latDeg = config.homeLatDeg + north / EARTH_RADIUS_M * RAD_TO_DEG;
+        double lonDeg = config.homeLonDeg + east / (EARTH_RADIUS_M * std::cos(config.homeLatDeg * DEG_TO_RAD)) * RAD_TO_DEG;
+        vehicle.gps.update_from_plant_ned(latDeg, lonDeg, altitudeM + noise(sensors.gpsNoiseM),
+            state.velocityNedMps[0] + noise(sensors.gpsVelNoiseMps),
+            state.velocityNedMps[1] + noise(sensors.gpsVelNoiseMps),
+            state.velocityNedMps[2] + noise(sensors.gpsVelNoiseMps));
+    }
+}
+
+void SITLPlant::step() {
+    float motorPercent[SITL_NUM_MOTORS];
+    for (int i = 0; i < SITL_NUM_MOTORS; i++) {
+        motorPercent[i] = vehicle.sitlMotors[i].get();
+    }
+
+    double airNed[3] = {
+        state.velocityNedMps[0] - windNedMps[0],
+        state.velocityNedMps[1] - windNedMps[1],
+        state.velocityNedMps[2] - windNedMps[2]
+    };
+    double airBody[3];
+    nedToBody(state.attitudeQuat, airNed, airBody);
+    state.airspeedMps = std::sqrt(airBody[0] * airBody[0] + airBody[1] * airBody[1] + airBody[2] * airBody[2]);
+
+    double force[3] = {0.0, 0.0, 0.0};
+    double moment[3] = {0.0, 0.0, 0.0};
+    double previousVelocity[3] = {state.velocityNedMps[0], state.velocityNedMps[1], state.velocityNedMps[2]};
+
+    #ifdef QUADCOPTER
+    multirotorForces(motorPercent, airBody, force, moment);
+    integrate(force, moment, config.multirotor.inertiaKgM2, config.multirotor.massKg);
+    groundContact(0.0);
+    #endif
+
+    #ifdef PLANE
+    fixedWingForces(motorPercent, airBody, force, moment);
+    integrate(force, moment, config.fixedWing.inertiaKgM2, config.fixedWing.massKg);
+    groundContact(actuators[5]);
+    #endif
+
+    // The accelerometer sees every force but gravity, ground contact included
+    double accelNed[3];
+    for (int axis = 0; axis < 3; axis++) {
+        accelNed[axis] = (state.velocityNedMps[axis] - previousVelocity[axis]) / dtS;
+    }
+    accelNed[2] -= GRAVITY;
+    nedToBody(state.attitudeQuat, accelNed, state.specificForceMps2);
+
+    // Same current model as the power module driver
+    using PMConfig = SITL_Driver_Configs::SITL_PowerModule_Config;
+    double currentA = rpm * PMConfig::CURRENT_DRAW_PER_RPM + PMConfig::CURRENT_DRAW_IDLE;
+    state.batteryRemainingMah = std::max(0.0, state.batteryRemainingMah - currentA * dtS * 1000.0 / 3600.0);
+
+    tick++;
+}
+
+#ifdef QUADCOPTER
+void SITLPlant::loadFrame() {
+    const MixerFrame_t *current = MotorMixing::frameFor(
+        static_cast<FrameClass_e>(vehicle.params.get(ZP_PARAM_ID::FRAME_CLASS)),
+        static_cast<FrameType_e>(vehicle.params.get(ZP_PARAM_ID::FRAME_TYPE)));
+    // set_param() rejects these, a PARAM_SET over the telemetry link can still pick one. Flying it
+    // on a subset of its motors would look like a working frame, so it gets no thrust at all
+    if (current != nullptr && current->motorCount > SITL_NUM_MOTORS) {
+        current = nullptr;
+    }
+
+    if (current != frame) {
+        frame = current;
+        motorCount = (frame != nullptr) ? frame->motorCount : 0;
+        for (uint8_t i = 0; i < motorCount; i++) {
+            // The mixer's roll factor is -sin and pitch factor cos of the arm angle from the nose
+            motorX[i] = frame->pitch[i] * config.multirotor.armLengthM;
+            motorY[i] = -frame->roll[i] * config.multirotor.armLengthM;
+            motorSpin[i] = frame->yaw[i];
+        }
+    }
+
+    // Same SERVOn_FUNCTION lookup as the mixer, the functions can change at any time
+    std::fill(motorOutput, motorOutput + SITL_PLANT_MAX_MOTORS, -1);
+    for (int output = 0; output < SITL_NUM_MOTORS; output++) {
+        int8_t idx = MotorMixing::motorIndex(vehicle.getOutputFunction(output));
+        if (idx >= 0 && idx < motorCount && motorOutput[idx] < 0) {
+            motorOutput[idx] = static_cast<int8_t>(output);
+        }
+    }
+}
+
+void SITLPlant::multirotorForces(const float* motorPercent, const double* airBody, double* forceBody, double* momentBody) {
+    const SITLMultirotorConfig_t& mc = config.multirotor;
+    loadFrame();
+
+    double totalThrust = 0.0;
+    for (uint8_t i = 0; i < motorCount; i++) {
+        // A frame motor without an output stays stopped
+        double percent = (motorOutput[i] >= 0) ? motorPercent[motorOutput[i]] : 0.0;
+        double command = std::clamp((percent / 100.0 - mc.spinMin) / (mc.spinMax - mc.spinMin), 0.0, 1.0);
+        double target = mc.maxThrustN * ((1.0 - mc.thrustExpo) * command + mc.thrustExpo * command * command);
+        actuators[i] = lag(actuators[i], target * motorEfficiency[i], dtS, mc.motorTauS);
+
+        double thrust = actuators[i];
+        totalThrust += thrust;
+        forceBody[2] -= thrust;
+        momentBody[0] -= motorY[i] * thrust;
+        momentBody[1] += motorX[i] * thrust;
+        momentBody[2] += motorSpin[i] * mc.yawTorquePerN * thrust; // Counter-clockwise props twist the body clockwise
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        forceBody[axis] -= mc.linearDragNPerMps * airBody[axis];
+        momentBody[axis] -= mc.angularDragNmPerRadps * state.ratesRadps[axis];
+    }
+
+    // Prop speed goes with the square root of thrust
+    rpm = (motorCount > 0) ? mc.maxRpm * std::sqrt(totalThrust / (motorCount * mc.maxThrustN)) : 0.0;
+}
+#endif
+
+#ifdef PLANE
+void SITLPlant::fixedWingForces(const float* motorPercent, const double* airBody, double* forceBody, double* momentBody) {
+    const SITLFixedWingConfig_t& fw = config.fixedWing;
+
+    // Outputs in the SITL servo order: aileron, elevator, throttle, rudder, flap, steering.
+    // Positive surface deflections push toward positive roll, pitch and yaw
+    actuators[0] = lag(actuators[0], std::clamp((motorPercent[0] - 50.0) / 50.0, -1.0, 1.0), dtS, fw.servoTauS);
+    actuators[1] = lag(actuators[1], std::clamp((motorPercent[1] - 50.0) / 50.0, -1.0, 1.0), dtS, fw.servoTauS);
+    actuators[2] = lag(actuators[2], std::clamp(motorPercent[2] / 100.0, 0.0, 1.0) * motorEfficiency[2], dtS, fw.throttleTauS);
+    actuators[3] = lag(actuators[3], std::clamp((motorPercent[3] - 50.0) / 50.0, -1.0, 1.0), dtS, fw.servoTauS);
+    actuators[4] = lag(actuators[4], std::clamp(motorPercent[4] / 100.0, 0.0, 1.0), dtS, fw.servoTauS);
+    actuators[5] = lag(actuators[5], std::clamp((motorPercent[5] - 50.0) / 50.0, -1.0, 1.0), dtS, fw.servoTauS);
+    double aileron = actuators[0], elevator = actuators[1], throttle = actuators[2];
+    double rudder = actuators[3], flap = actuators[4];
+
+    double thrust = fw.maxThrustN * throttle * std::max(0.0, 1.0 - airBody[0] / fw.propMaxSpeedMps);
+    forceBody[0] += thrust;
+    rpm = fw.maxRpm * std::sqrt(throttle);
+
+    double airspeed = state.airspeedMps;
+    if (airspeed < 0.5) return; // No meaningful aero, also keeps alpha and beta defined
+
+    double alpha = std::atan2(airBody[2], airBody[0]);
+    double beta = std::asin(std::clamp(airBody[1] / airspeed, -1.0, 1.0));
+    double rho = isaPressureKPa(config.homeAltM - state.positionNedM[2]) * 1000.0 /
+        (GAS_CONSTANT_AIR * isaTemperatureK(config.homeAltM - state.positionNedM[2]));
+    double qbarS = 0.5 * rho * airspeed * airspeed * fw.wingAreaM2;
+    double p = state.ratesRadps[0], q = state.ratesRadps[1], r = state.ratesRadps[2];
+    double halfSpanOverV = fw.spanM / (2.0 * airspeed);
+    double halfChordOverV = fw.chordM / (2.0 * airspeed);
+
+    // Linear lift blended into a flat plate past the stall
+    constexpr double STALL_SHARPNESS = 50.0;
+    double ePlus = std::exp(-STALL_SHARPNESS * (alpha - fw.alphaStallRad));
+    double eMinus = std::exp(STALL_SHARPNESS * (alpha + fw.alphaStallRad));
+    double stallBlend = (1.0 + ePlus + eMinus) / ((1.0 + ePlus) * (1.0 + eMinus));
+    double sinA = std::sin(alpha), cosA = std::cos(alpha);
+    double clStatic = (1.0 - stallBlend) * (fw.cl0 + fw.clAlpha * alpha) +
+        stallBlend * 2.0 * std::copysign(sinA * sinA * cosA, alpha);
+
+    double cl = clStatic + fw.clQ * halfChordOverV * q + fw.clElevator * elevator + fw.clFlap * flap;
+    double cd = fw.cd0 + fw.cdInduced * cl * cl + fw.cdFlap * flap + stallBlend * 2.0 * sinA * sinA;
+    double cy = fw.cyBeta * beta + fw.cyRudder * rudder;
+
+    forceBody[0] += qbarS * (-cd * cosA + cl * sinA);
+    forceBody[1] += qbarS * cy;
+    forceBody[2] += qbarS * (-cd * sinA - cl * cosA);
+
+    momentBody[0] += qbarS * fw.spanM *
+        (fw.clBeta * beta + fw.clP * halfSpanOverV * p + fw.clR * halfSpanOverV * r + fw.clAileron * aileron);
+    momentBody[1] += qbarS * fw.chordM *
+        (fw.cm0 + fw.cmAlpha * alpha + fw.cmQ * halfChordOverV * q + fw.cmElevator * elevator);
+    momentBody[2] += qbarS * fw.spanM *
+        (fw.cnBeta * beta + fw.cnP * halfSpanOverV * p + fw.cnR * halfSpanOverV * r + fw.cnRudder * rudder);
+}
+#endif
+
+void SITLPlant::integrate(const double* forceBody, const double* momentBody, const double* inertia, double mass) {
+    double forceNed[3];
+    bodyToNed(state.attitudeQuat, forceBody, forceNed);
+
+    for (int axis = 0; axis < 3; axis++) {
+        double accel = forceNed[axis] / mass + (axis == 2 ? GRAVITY : 0.0);
+        state.velocityNedMps[axis] += accel * dtS;
+        state.positionNedM[axis] += state.velocityNedMps[axis] * dtS;
+    }
+
+    // Euler's rotation equations with a diagonal inertia tensor
+    double* w = state.ratesRadps;
+    double wDot[3] = {
+        (momentBody[0] - (inertia[2] - inertia[1]) * w[1] * w[2]) / inertia[0],
+        (momentBody[1] - (inertia[0] - inertia[2]) * w[2] * w[0]) / inertia[1],
+        (momentBody[2] - (inertia[1] - inertia[0]) * w[0] * w[1]) / inertia[2]
+    };
+    for (int axis = 0; axis < 3; axis++) {
+        w[axis] += wDot[axis] * dtS;
+    }
+
+    double* q = state.attitudeQuat;
+    double qDot[4] = {
+        0.5 * (-q[1] * w[0] - q[2] * w[1] - q[3] * w[2]),
+        0.5 * (q[0] * w[0] + q[2] * w[2] - q[3] * w[1]),
+        0.5 * (q[0] * w[1] - q[1] * w[2] + q[3] * w[0]),
+        0.5 * (q[0] * w[2] + q[1] * w[1] - q[2] * w[0])
+    };
+    double norm = 0.0;
+    for (int i = 0; i < 4; i++) {
+        q[i] += qDot[i] * dtS;
+        norm += q[i] * q[i];
+    }
+    norm = std::sqrt(norm);
+    for (int i = 0; i < 4; i++) {
+        q[i] /= norm;
+    }
+    updateEuler();
+}
+
+void SITLPlant::groundContact(double steering) {
+    if (state.positionNedM[2] < 0.0) {
+        state.onGround = false;
+        return;
+    }
+
+    state.onGround = true;
+    state.positionNedM[2] = 0.0;
+    state.velocityNedMps[2] = std::min(state.velocityNedMps[2], 0.0);
+
+    // Resting on the gear: wings level and the nose can only come up
+    #ifdef PLANE
+    double pitch = std::max(state.pitchRad, 0.0);
+    #else
+    double pitch = 0.0;
+    #endif
+    eulerToQuat(0.0, pitch, state.yawRad, state.attitudeQuat);
+    updateEuler();
+    state.ratesRadps[0] = 0.0;
+
+    #ifdef PLANE
+    // Weight pulls the nose back down onto the nose wheel unless the elevator holds it up
+    static constexpr double MAIN_GEAR_BEHIND_CG_M = 0.05;
+    const SITLFixedWingConfig_t& fw = config.fixedWing;
+    if (pitch > 0.0) {
+        state.ratesRadps[1] -= fw.massKg * GRAVITY * MAIN_GEAR_BEHIND_CG_M / fw.inertiaKgM2[1] * dtS;
+    } else {
+        state.ratesRadps[1] = std::max(state.ratesRadps[1], 0.0);
+    }
+
+    // Wheels roll along the heading with rolling friction and the nose wheel steers
+    double cosYaw = std::cos(state.yawRad), sinYaw = std::sin(state.yawRad);
+    double rollSpeed = state.velocityNedMps[0] * cosYaw + state.velocityNedMps[1] * sinYaw;
+    double friction = fw.rollingFriction * GRAVITY * dtS;
+    rollSpeed = (std::fabs(rollSpeed) <= friction) ? 0.0 : rollSpeed - std::copysign(friction, rollSpeed);
+    state.velocityNedMps[0] = rollSpeed * cosYaw;
+    state.velocityNedMps[1] = rollSpeed * sinYaw;
+    state.ratesRadps[2] = fw.steeringRadps * steering * rollSpeed;
+    #else
+    // Skids hold the multirotor in place until it lifts off
+    (void)steering;
+    state.velocityNedMps[0] = 0.0;
+    state.velocityNedMps[1] = 0.0;
+    state.ratesRadps[1] = 0.0;
+    state.ratesRadps[2] = 0.0;
+    #endif
+}
+
+void SITLPlant::updateEuler() {
+    const double* q = state.attitudeQuat;
+    state.rollRad = std::atan2(2.0 * (q[0] * q[1] + q[2] * q[3]), 1.0 - 2.0 * (q[1] * q[1] + q[2] * q[2]));
+    state.pitchRad = std::asin(std::clamp(2.0 * (q[0] * q[2] - q[3] * q[1]), -1.0, 1.0));
+    state.yawRad = std::atan2(2.0 * (q[0] * q[3] + q[1] * q[2]), 1.0 - 2.0 * (q[2] * q[2] + q[3] * q[3]));
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include "motor_mixing.hpp"
+#include <cstdint>
+#include <random>
+
+class SITLVehicle;
+
+static constexpr int SITL_PLANT_MAX_MOTORS = 8;
+
+// Quad X with 10 inch props, about 2:1 thrust to weight
+typedef struct {
+    double massKg = 1.5;
+    double inertiaKgM2[3] = {0.015, 0.015, 0.025};
+    double armLengthM = 0.25;
+    double maxThrustN = 7.5;        // Per motor at full command
+    double yawTorquePerN = 0.016;   // Prop drag torque per newton of thrust
+    double spinMin = 0.15;          // Motor command that starts producing thrust
+    double spinMax = 0.95;          // Motor command for full thrust
+    double thrustExpo = 0.65;       // 0 = thrust linear in command, 1 = quadratic
+    double motorTauS = 0.03;        // Spin up time constant
+    double linearDragNPerMps = 0.25;
+    double angularDragNmPerRadps = 0.002;
+    double maxRpm = 8000.0;
+} SITLMultirotorConfig_t;
+
+// Small trainer, around 1.8 m span. Control derivatives are per unit of normalized deflection
+typedef struct {
+    double massKg = 2.5;
+    double inertiaKgM2[3] = {0.12, 0.15, 0.25};
+    double wingAreaM2 = 0.45;
+    double spanM = 1.8;
+    double chordM = 0.25;
+    double maxThrustN = 20.0;
+    double propMaxSpeedMps = 35.0;  // Thrust falls to zero at this airspeed
+    double throttleTauS = 0.1;
+    double servoTauS = 0.02;
+    double maxRpm = 9000.0;
+
+    double cl0 = 0.3, clAlpha = 5.0, clQ = 7.0, clElevator = -0.2, clFlap = 0.4;
+    double alphaStallRad = 0.28;
+    double cd0 = 0.035, cdInduced = 0.05, cdFlap = 0.05;
+    double cyBeta = -0.3, cyRudder = -0.1;
+    double clBeta = -0.08, clP = -0.45, clR = 0.1, clAileron = 0.08;    // Roll moment
+    double cm0 = 0.02, cmAlpha = -0.8, cmQ = -12.0, cmElevator = 0.3;  // Pitch moment
+    double cnBeta = 0.08, cnP = -0.03, cnR = -0.12, cnRudder = 0.05;   // Yaw moment
+    double rollingFriction = 0.04;
+    double steeringRadps = 1.0;     // Ground yaw rate at full steering per m/s of ground speed
+} SITLFixedWingConfig_t;
+
+// White noise standard deviations and constant biases
+typedef struct {
+    double gyroNoiseRadps = 0.005;
+    double gyroBiasRadps[3] = {0.0, 0.0, 0.0};
+    double accelNoiseMps2 = 0.05;
+    double accelBiasMps2[3] = {0.0, 0.0, 0.0};
+    double baroNoiseM = 0.1;
+    double gpsNoiseM = 0.3;
+    double gpsVelNoiseMps = 0.05;
+    uint32_t gpsRateHz = 5;
+} SITLSensorConfig_t;
+
+typedef struct {
+    SITLMultirotorConfig_t multirotor;  // Used by the QUADCOPTER build
+    SITLFixedWingConfig_t fixedWing;    // Used by the PLANE build
+    SITLSensorConfig_t sensors;
+    double homeLatDeg = 43.4723;
+    double homeLonDeg = -80.5449;
+    double homeAltM = 330.0;        // Above sea level, the ground of the flat earth
+    double batteryCapacityMah = 5000.0;
+    uint32_t seed = 0;              // Sensor noise, runs with the same seed are identical
+} SITLPlantConfig_t;
+
+typedef struct {
+    double positionNedM[3];         // From home
+    double velocityNedMps[3];
+    double attitudeQuat[4];         // Body to NED, w x y z
+    double rollRad, pitchRad, yawRad;
+    double ratesRadps[3];           // Body FRD
+    double specificForceMps2[3];    // Body FRD, what a perfect accelerometer reads
+    double airspeedMps;
+    double batteryRemainingMah;
+    bool onGround;
+} SITLPlantState_t;
+
+/*
+ * Rigid body 6-DOF plant for headless closed loop runs. Reads the vehicle's motor outputs, integrates
+ * one SITL tick and writes the SITL_* sensors directly, so no Python, network or external FDM is in
+ * the loop. The QUADCOPTER build flies the multirotor model with geometry from the same mixer table
+ * as the firmware, the PLANE build a stability derivative fixed wing. The ground is flat at z = 0.
+ */
+class SITLPlant {
+    public:
+        SITLPlant(SITLVehicle& vehicle, const SITLPlantConfig_t& config, uint32_t sitlRateHz);
+
+        // Sensor readings for the current state, call before the managers run
+        void writeSensors();
+
+        // Advance one tick with the outputs the managers just produced
+        void step();
+
+        const SITLPlantState_t& getState() const { return state; }
+
+        void setWind(double northMps, double eastMps, double downMps);
+
+        // Failure injection, 1 = healthy motor, 0 = dead
+        void setMotorEfficiency(uint8_t motor, double efficiency);
+
+    private:
+        SITLVehicle& vehicle;
+        SITLPlantConfig_t config;
+        const double dtS;
+        SITLPlantState_t state;
+        double windNedMps[3];
+        double actuators[SITL_PLANT_MAX_MOTORS];    // Lagged motor thrust or surface positions
+        double motorEfficiency[SITL_PLANT_MAX_MOTORS];
+        double rpm;
+
+        #ifdef QUADCOPTER
+        // Geometry from the mixer table: forward and right arm position, yaw direction
+        const MixerFrame_t *frame;
+        uint8_t motorCount;
+        int8_t motorOutput[SITL_PLANT_MAX_MOTORS];  // SITL output driving each frame motor, -1 if none
+        double motorX[SITL_PLANT_MAX_MOTORS];
+        double motorY[SITL_PLANT_MAX_MOTORS];
+        double motorSpin[SITL_PLANT_MAX_MOTORS];
+        #endif
+
+        std::mt19937 rng;
+        std::normal_distribution<double> unitNoise;
+        uint32_t gpsDivider;
+        uint32_t tick;
+
+        #ifdef QUADCOPTER
+        void loadFrame();
+        void multirotorForces(const float* motorPercent, const double* airBody, double* forceBody, double* momentBody);
+        #endif
+        #ifdef PLANE
+        void fixedWingForces(const float* motorPercent, const double* airBody, double* forceBody, double* momentBody);
+        #endif
+        void integrate(const double* forceBody, const double* momentBody, const double* inertia, double mass);
+        void groundContact(double steering);
+        void updateEuler();
+
+        double noise(double sigma) { return sigma * unitNoise(rng); }
+};
@@ -0,0 +1,131 @@
+#include "sitl_telem_capture.hpp"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace {
+    // Vehicle and GCS addresses in the synthesized IPv4 headers, 10.0.0.1 and 10.0.0.2
+    constexpr uint8_t VEHICLE_ADDRESS[4] = {10, 0, 0, 1};
+    constexpr uint8_t GCS_ADDRESS[4] = {10, 0, 0, 2};
+    constexpr size_t IPV4_HEADER_BYTES = 20;
+    constexpr size_t UDP_HEADER_BYTES = 8;
+    constexpr size_t MAX_UDP_PAYLOAD = UINT16_MAX - IPV4_HEADER_BYTES - UDP_HEADER_BYTES;
+
+    void putBe16(uint8_t* out, uint16_t value) {
+        out[0] = static_cast<uint8_t>(value >> 8);
+        out[1] = static_cast<uint8_t>(value);
+    }
+
+    uint16_t ipv4Checksum(const uint8_t* header) {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < IPV4_HEADER_BYTES; i += 2) {
+            sum += static_cast<uint32_t>(header[i] << 8 | header[i + 1]);
+        }
+        while (sum >> 16) {
+            sum = (sum & 0xFFFF) + (sum >> 16);
+        }
+        return static_cast<uint16_t>(~sum);
+    }
+}
+
+SITLTelemCapture::SITLTelemCapture(const SITLTelemRing& ring, const char* path, uint16_t gcsPort) :
+    reader(ring),
+    file(fopen(path, "wb")),
+    gcsPort(gcsPort),
+    packetCount(0),
+    ipId(0),
+    stopping(false) {
+    if (file == nullptr) {
+        std::cerr << "[SITLTelemCapture] ERROR: Could not open capture file: " << path << std::endl;
+        return;
+    }
+
+    // pcap global header: microsecond timestamps, version 2.4, no snap length limit
+    const uint32_t magic = 0xA1B2C3D4;
+    const uint16_t version[2] = {2, 4};
+    const int32_t thisZone = 0;
+    const uint32_t sigFigs = 0;
+    const uint32_t snapLength = UINT16_MAX;
+    fwrite(&magic, sizeof(magic), 1, file);
+    fwrite(version, sizeof(version), 1, file);
+    fwrite(&thisZone, sizeof(thisZone), 1, file);
+    fwrite(&sigFigs, sizeof(sigFigs), 1, file);
+    fwrite(&snapLength, sizeof(snapLength), 1, file);
+    fwrite(&PCAP_LINKTYPE_IPV4, sizeof(PCAP_LINKTYPE_IPV4), 1, file);
+
+    writer = std::thread(&SITLTelemCapture::writerLoop, this);
+}
+
+void SITLTelemCapture::close() {
+    if (file == nullptr) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    stopCv.notify_one();
+    writer.join();
+    fclose(file);
+    file = nullptr;
+}
+
+void SITLTelemCapture::writerLoop() {
+    std::vector<uint8_t> chunk(SITL_TELEM_MAX_RECORD_BYTES * 4);
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        lock.unlock();
+        drain(chunk.data(), chunk.size());
+        lock.lock();
+        stopCv.wait_for(lock, std::chrono::milliseconds(POLL_PERIOD_MS), [this] { return stopping; });
+    }
+    lock.unlock();
+
+    drain(chunk.data(), chunk.size()); // Whatever arrived since the last poll
+    fflush(file);
+}
+
+void SITLTelemCapture::drain(uint8_t* chunk, size_t chunkBytes) {
+    size_t bytes;
+    while ((bytes = reader.read(chunk, chunkBytes)) > 0) {
+        size_t offset = 0;
+        while (offset < bytes) {
+            SITLTelemRecordHeader_t header;
+            memcpy(&header, chunk + offset, sizeof(header));
+            writePacket(header, chunk + offset + sizeof(header));
+            offset += sizeof(header) + header.length;
+        }
+    }
+}
+
+void SITLTelemCapture::writePacket(const SITLTelemRecordHeader_t& header, const uint8_t* payload) {
+    const bool tx = header.direction == 1;
+    const size_t payloadBytes = header.length < MAX_UDP_PAYLOAD ? header.length : MAX_UDP_PAYLOAD;
+    const uint16_t ipBytes = static_cast<uint16_t>(IPV4_HEADER_BYTES + UDP_HEADER_BYTES + payloadBytes);
+
+    uint8_t headers[IPV4_HEADER_BYTES + UDP_HEADER_BYTES] = {};
+    uint8_t* ip = headers;
+    ip[0] = 0x45;       // IPv4, 5 word header
+    putBe16(ip + 2, ipBytes);
+    putBe16(ip + 4, ipId++);
+    ip[8] = 64;         // TTL
+    ip[9] = 17;         // UDP
+    memcpy(ip + 12, tx ? VEHICLE_ADDRESS : GCS_ADDRESS, 4);
+    memcpy(ip + 16, tx ? GCS_ADDRESS : VEHICLE_ADDRESS, 4);
+    putBe16(ip + 10, ipv4Checksum(ip));
+
+    uint8_t* udp = headers + IPV4_HEADER_BYTES;
+    putBe16(udp, tx ? VEHICLE_PORT : gcsPort);
+    putBe16(udp + 2, tx ? gcsPort : VEHICLE_PORT);
+    putBe16(udp + 4, static_cast<uint16_t>(UDP_HEADER_BYTES + payloadBytes)); // Checksum 0, not computed
+
+    const uint32_t record[4] = {
+        static_cast<uint32_t>(header.timestampUs / 1000000),
+        static_cast<uint32_t>(header.timestampUs % 1000000),
+        ipBytes,
+        ipBytes
+    };
+    fwrite(record, sizeof(record), 1, file);
+    fwrite(headers, sizeof(headers), 1, file);
+    fwrite(payload, 1, payloadBytes, file);
+    packetCount++;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "sitl_drivers/sitl_telem_ring.hpp"
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+/*
+ * Writes the telemetry ring to a pcap file on its own thread, so the stepping thread never touches
+ * the disk. Each record becomes an IPv4/UDP datagram between the vehicle and the GCS port, which
+ * lets Wireshark's MAVLink dissector and other pcap tools decode the capture offline.
+ * Timestamps are the vehicle clock, simulated time when the vehicle runs on a simulated clock.
+ */
+class SITLTelemCapture {
+    public:
+        SITLTelemCapture(const SITLTelemRing& ring, const char* path, uint16_t gcsPort);
+        ~SITLTelemCapture() { close(); }
+
+        // Writes out what is left in the ring, stops the writer and closes the file
+        void close();
+
+        SITLTelemCapture(const SITLTelemCapture&) = delete;
+        SITLTelemCapture& operator=(const SITLTelemCapture&) = delete;
+
+        bool isOpen() const { return file != nullptr; }
+
+        uint64_t getPacketCount() const { return packetCount; }     // Only stable once closed
+        uint64_t getLostBytes() const { return reader.getLostBytes(); }
+
+    private:
+        static constexpr uint32_t PCAP_LINKTYPE_IPV4 = 228;
+        static constexpr uint16_t VEHICLE_PORT = 14555;
+        static constexpr uint32_t POLL_PERIOD_MS = 20;
+
+        SITLTelemRing::Reader reader;
+        FILE* file;
+        const uint16_t gcsPort;
+        uint64_t packetCount;
+        uint16_t ipId;
+
+        std::mutex mutex;
+        std::condition_variable stopCv;
+        bool stopping;
+        std::thread writer;
+
+        void writerLoop();
+        void drain(uint8_t* chunk, size_t chunkBytes);
+        void writePacket(const SITLTelemRecordHeader_t& header, const uint8_t* payload);
+};
@@ -0,0 +1,241 @@
+#include "sitl_vehicle.hpp"
+#include <algorithm>
+#include <limits>
+
+SITLVehicle::SITLVehicle(const SITLVehicleConfig_t& config) :
+    sysUtils(config.simulatedClock),
+    logger(config.logToSdCard ? "sd_card/sitl_log.txt" : nullptr, config.logToSdCard ? "sd_card/sitl_log.bin" : nullptr),
+    telemRing(config.telemIp != nullptr ? SITL_Driver_Configs::SITL_TELEM_Config::CAPTURE_RING_BYTES : 0),
+    telem(config.telemIp, config.telemPort, &telemRing, &sysUtils),
+    motorGroup{motors, SITL_NUM_MOTORS},
+    telemPort(config.telemPort),
+    sitlRateHz(config.sitlRateHz),
+    simulatedClock(config.simulatedClock),
+    smCounter(0),
+    tmCounter(0),
+    amCounter(0),
+    stepping(false),
+    telemReader(telemRing) {
+    for (int i = 0; i < SITL_NUM_MOTORS; i++) {
+        motors[i] = {&sitlMotors[i]};
+    }
+
+    // loadServoParams() in the AM constructor reads these
+    setServoParams();
+
+    sm.reset(new SystemManager(
+        &sysUtils, &iwdg, &logger, nullptr, &rc, // Safety switch is not used in SITL
+        &pm, &amQueue, &tmQueue, &logQueue, &batteryVoltage, &sysIdLogQueue, nullptr, &params
+    ));
+
+    tm.reset(new TelemetryManager(
+        &sysUtils, &telem, &tmQueue, &amQueue, &mavlinkQueue, &params
+    ));
+
+    am.reset(new AttitudeManager(
+        &sysUtils, &mathUtils, &gps, &imu, &fft, &rangefinder, &barometer,
+        &amQueue, &tmQueue, &logQueue,
+        &motorGroup, rc.get_fast_path(), nullptr, &batteryVoltage,
+        &sysIdFft, &sysIdLogQueue, &params
+    ));
+}
+
+void SITLVehicle::setServoParams() {
+    params.setParamById("SERVO1_TRIM", 1500);
+    params.setParamById("SERVO1_MIN", 1000);
+    params.setParamById("SERVO1_MAX", 2000);
+    params.setParamById("SERVO1_REVERSED", 0);
+    #ifdef PLANE
+    params.setParamById("SERVO1_FUNCTION", static_cast<float>(MotorFunction_e::AILERON));
+    #endif
+    #ifdef QUADCOPTER
+    params.setParamById("SERVO1_FUNCTION", static_cast<float>(MotorFunction_e::MOTOR_1));
+    #endif
+
+    params.setParamById("SERVO2_TRIM", 1500);
+    params.setParamById("SERVO2_MIN", 1000);
+    params.setParamById("SERVO2_MAX", 2000);
+    params.setParamById("SERVO2_REVERSED", 0);
+    #ifdef PLANE
+    params.setParamById("SERVO2_FUNCTION", static_cast<float>(MotorFunction_e::ELEVATOR));
+    #endif
+    #ifdef QUADCOPTER
+    params.setParamById("SERVO2_FUNCTION", static_cast<float>(MotorFunction_e::MOTOR_2));
+    #endif
+
+    params.setParamById("SERVO3_TRIM", 1500);
+    params.setParamById("SERVO3_MIN", 1000);
+    params.setParamById("SERVO3_MAX", 2000);
+    params.setParamById("SERVO3_REVERSED", 0);
+    #ifdef PLANE
+    params.setParamById("SERVO3_FUNCTION", static_cast<float>(MotorFunction_e::THROTTLE));
+    #endif
+    #ifdef QUADCOPTER
+    params.setParamById("SERVO3_FUNCTION", static_cast<float>(MotorFunction_e::MOTOR_3));
+    #endif
+
+    params.setParamById("SERVO4_TRIM", 1500);
+    params.setParamById("SERVO4_MIN", 1000);
+    params.setParamById("SERVO4_MAX", 2000);
+    params.setParamById("SERVO4_REVERSED", 0);
+    #ifdef PLANE
+    params.setParamById("SERVO4_FUNCTION", static_cast<float>(MotorFunction_e::RUDDER));
+    #endif
+    #ifdef QUADCOPTER
+    params.setParamById("SERVO4_FUNCTION", static_cast<float>(MotorFunction_e::MOTOR_4));
+    #endif
+
+    params.setParamById("SERVO5_TRIM", 1500);
+    params.setParamById("SERVO5_MIN", 1000);
+    params.setParamById("SERVO5_MAX", 2000);
+    params.setParamById("SERVO5_REVERSED", 0);
+    #ifdef PLANE
+    params.setParamById("SERVO5_FUNCTION", static_cast<float>(MotorFunction_e::FLAP));
+    #endif
+    #ifdef QUADCOPTER
+    params.setParamById("SERVO5_FUNCTION", static_cast<float>(MotorFunction_e::MOTOR_5)); // Hexa frames, unused by the quad
+    #endif
+
+    params.setParamById("SERVO6_TRIM", 1500);
+    params.setParamById("SERVO6_MIN", 1000);
+    params.setParamById("SERVO6_MAX", 2000);
+    params.setParamById("SERVO6_REVERSED", 0);
+    #ifdef PLANE
+    params.setParamById("SERVO6_FUNCTION", static_cast<float>(MotorFunction_e::GROUND_STEERING));
+    #endif
+    #ifdef QUADCOPTER
+    params.setParamById("SERVO6_FUNCTION", static_cast<float>(MotorFunction_e::MOTOR_6));
+    #endif
+
+    params.setParamById("SERVO7_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED));
+    params.setParamById("SERVO8_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED));
+    params.setParamById("SERVO9_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED));
+    params.setParamById("SERVO10_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED));
+    params.setParamById("SERVO11_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED));
+    params.setParamById("SERVO12_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED));
+}
+
+void SITLVehicle::attachPlant(const SITLPlantConfig_t& config) {
+    plant.reset(new SITLPlant(*this, config, sitlRateHz));
+}
+
+bool SITLVehicle::update() {
+    if (plant) {
+        plant->writeSensors();
+    }
+
+    if (smCounter % (sitlRateHz / SM_SCHEDULING_RATE_HZ) == 0) {
+        sm->smUpdate();
+    }
+    
+    if (tmCounter % (sitlRateHz / TM_SCHEDULING_RATE_HZ) == 0) {
+        tm->tmUpdate();
+    }
+    
+    if (amCounter % (sitlRateHz / am->getSchedulingRateHz()) == 0) {
+        am->amUpdate();
+    }
+    
+    smCounter++;
+    tmCounter++;
+    amCounter++;
+
+    if (plant) {
+        plant->step();
+    }
+
+    if (simulatedClock) {
+        sysUtils.advanceUs(1000000 / sitlRateHz);
+    }
+
+    return iwdg.check_watchdog(); // False if the watchdog timed out
+}
+
+uint32_t SITLVehicle::stepBatch(uint32_t ticks, const double* sensorRows, const double* rcRows, size_t rcStride, double* outRows) {
+    for (uint32_t tick = 0; tick < ticks; tick++) {
+        if (sensorRows != nullptr) {
+            applySensors(sensorRows + tick * SITL_SENSOR_COLUMNS);
+        }
+
+        if (rcRows != nullptr) {
+            const double* rcRow = rcRows + tick * rcStride;
+            rc.update_from_commands(rcRow[SITL_RC_ROLL], rcRow[SITL_RC_PITCH], rcRow[SITL_RC_YAW], rcRow[SITL_RC_THROTTLE],
+                                    rcRow[SITL_RC_ARM], rcRow[SITL_RC_FLAP], rcRow[SITL_RC_FLTMODE]);
+        }
+
+        bool healthy = update();
+
+        if (outRows != nullptr) {
+            writeOutputs(outRows + tick * SITL_OUT_COLUMNS);
+        }
+
+        if (!healthy) {
+            return tick + 1;
+        }
+    }
+    return ticks;
+}
+
+void SITLVehicle::applySensors(const double* row) {
+    imu.update_from_plant(row[SITL_SENSOR_ROLL_RAD], row[SITL_SENSOR_PITCH_RAD],
+                          row[SITL_SENSOR_P_RADPS], row[SITL_SENSOR_Q_RADPS], row[SITL_SENSOR_R_RADPS]);
+    gps.update_from_plant(row[SITL_SENSOR_LAT_DEG], row[SITL_SENSOR_LON_DEG], row[SITL_SENSOR_ALT_M],
+                          row[SITL_SENSOR_GROUND_SPEED_MPS], row[SITL_SENSOR_COURSE_DEG]);
+    pm.update_from_plant(row[SITL_SENSOR_FUEL_LBS], row[SITL_SENSOR_RPM]);
+    rangefinder.update_from_plant(row[SITL_SENSOR_RANGEFINDER_M]);
+    barometer.update_from_plant(row[SITL_SENSOR_BARO_KPA], row[SITL_SENSOR_BARO_TEMP_C]);
+}
+
+void SITLVehicle::writeOutputs(double* row) {
+    for (int i = 0; i < SITL_NUM_MOTORS; i++) {
+        row[SITL_OUT_MOTOR_1 + i] = sitlMotors[i].get();
+    }
+
+    if (!plant) {
+        std::fill(row + SITL_OUT_POS_N_M, row + SITL_OUT_COLUMNS, std::numeric_limits<double>::quiet_NaN());
+        return;
+    }
+
+    const SITLPlantState_t& state = plant->getState();
+    for (int axis = 0; axis < 3; axis++) {
+        row[SITL_OUT_POS_N_M + axis] = state.positionNedM[axis];
+        row[SITL_OUT_VEL_N_MPS + axis] = state.velocityNedMps[axis];
+        row[SITL_OUT_P_RADPS + axis] = state.ratesRadps[axis];
+    }
+    row[SITL_OUT_ROLL_RAD] = state.rollRad;
+    row[SITL_OUT_PITCH_RAD] = state.pitchRad;
+    row[SITL_OUT_YAW_RAD] = state.yawRad;
+}
+
+bool SITLVehicle::tryBeginStep() {
+    bool expected = false;
+    return stepping.compare_exchange_strong(expected, true, std::memory_order_acquire);
+}
+
+void SITLVehicle::endStep() {
+    stepping.store(false, std::memory_order_release);
+}
+
+bool SITLVehicle::isStepping() const {
+    return stepping.load(std::memory_order_acquire);
+}
+
+bool SITLVehicle::startTelemCapture(const char* path) {
+    telemCapture.reset(); // Finishes any previous capture first
+    telemCapture.reset(new SITLTelemCapture(telemRing, path, static_cast<uint16_t>(telemPort)));
+    if (!telemCapture->isOpen()) {
+        telemCapture.reset();
+        return false;
+    }
+    return true;
+}
+
+bool SITLVehicle::stopTelemCapture(uint64_t& packets, uint64_t& lostBytes) {
+    if (!telemCapture) return false;
+
+    telemCapture->close();
+    packets = telemCapture->getPacketCount();
+    lostBytes = telemCapture->getLostBytes();
+    telemCapture.reset();
+    return true;
+}
@@ -0,0 +1,179 @@
+#pragma once
+#include "zp_params.hpp"
+#include "sitl_plant.hpp"
+#include "sitl_telem_capture.hpp"
+#include "system_manager.hpp"
+#include "telemetry_manager.hpp"
+#include "attitude_manager.hpp"
+#include "sitl_drivers/sitl_systemutils.hpp"
+#include "sitl_drivers/sitl_mathutils.hpp"
+#include "sitl_drivers/sitl_iwdg.hpp"
+#include "sitl_drivers/sitl_logger.hpp"
+#include "sitl_drivers/sitl_rc.hpp"
+#include "sitl_drivers/sitl_powermodule.hpp"
+#include "sitl_drivers/sitl_barometer.hpp"
+#include "sitl_drivers/sitl_telemlink.hpp"
+#include "sitl_drivers/sitl_imu.hpp"
+#include "sitl_drivers/sitl_gps.hpp"
+#include "sitl_drivers/sitl_queue.hpp"
+#include "sitl_drivers/sitl_logqueue.hpp"
+#include "sitl_drivers/sitl_motor.hpp"
+#include "sitl_drivers/sitl_fft.hpp"
+#include "sitl_drivers/sitl_rangefinder.hpp"
+#include <atomic>
+#include <memory>
+
+static constexpr int SITL_NUM_MOTORS = 6;
+
+// Columns of the per tick float64 rows taken by stepBatch(), sensors in update_from_plant() order
+enum SITLSensorColumn_e : size_t {
+    SITL_SENSOR_ROLL_RAD = 0,
+    SITL_SENSOR_PITCH_RAD,
+    SITL_SENSOR_P_RADPS,
+    SITL_SENSOR_Q_RADPS,
+    SITL_SENSOR_R_RADPS,
+    SITL_SENSOR_LAT_DEG,
+    SITL_SENSOR_LON_DEG,
+    SITL_SENSOR_ALT_M,
+    SITL_SENSOR_GROUND_SPEED_MPS,
+    SITL_SENSOR_COURSE_DEG,
+    SITL_SENSOR_FUEL_LBS,
+    SITL_SENSOR_RPM,
+    SITL_SENSOR_RANGEFINDER_M,
+    SITL_SENSOR_BARO_KPA,
+    SITL_SENSOR_BARO_TEMP_C,
+    SITL_SENSOR_COLUMNS
+};
+
+enum SITLRcColumn_e : size_t {
+    SITL_RC_ROLL = 0,
+    SITL_RC_PITCH,
+    SITL_RC_YAW,
+    SITL_RC_THROTTLE,
+    SITL_RC_ARM,
+    SITL_RC_FLAP,           // Ignored by the QUADCOPTER build
+    SITL_RC_FLTMODE,
+    SITL_RC_COLUMNS
+};
+
+// Motor outputs in servo order, then the built-in plant's state (NaN without a plant)
+enum SITLOutColumn_e : size_t {
+    SITL_OUT_MOTOR_1 = 0,
+    SITL_OUT_POS_N_M = SITL_NUM_MOTORS,
+    SITL_OUT_POS_E_M,
+    SITL_OUT_POS_D_M,
+    SITL_OUT_VEL_N_MPS,
+    SITL_OUT_VEL_E_MPS,
+    SITL_OUT_VEL_D_MPS,
+    SITL_OUT_ROLL_RAD,
+    SITL_OUT_PITCH_RAD,
+    SITL_OUT_YAW_RAD,
+    SITL_OUT_P_RADPS,
+    SITL_OUT_Q_RADPS,
+    SITL_OUT_R_RADPS,
+    SITL_OUT_COLUMNS
+};
+
+typedef struct {
+    uint32_t sitlRateHz;    // update() calls per simulated second
+    const char* telemIp;    // MAVLink UDP destination, nullptr for no telemetry link
+    int telemPort;
+    bool simulatedClock;    // Time advances one tick per update() instead of following the wall clock
+    bool logToSdCard;       // sd_card/sitl_log.*, leave off when several vehicles share the process
+} SITLVehicleConfig_t;
+
+/*
+ * One simulated vehicle: its parameters, drivers, queues and the three managers. Nothing is shared
+ * with other vehicles, so any number can live in one process and be stepped from different threads,
+ * as long as each one is only stepped by one thread at a time (see tryBeginStep).
+ */
+class SITLVehicle {
+    public:
+        explicit SITLVehicle(const SITLVehicleConfig_t& config);
+        ~SITLVehicle() = default;
+
+        SITLVehicle(const SITLVehicle&) = delete;
+        SITLVehicle& operator=(const SITLVehicle&) = delete;
+
+        // Runs each manager whose turn it is, false once the watchdog has expired. With a plant
+        // attached it also writes the sensors before and advances the physics after
+        bool update();
+
+        // Runs ticks updates, feeding a sensor and an RC row before each and writing an output row
+        // after. Any block may be nullptr to skip it, rcStride 0 holds one RC row for every tick.
+        // Returns the ticks run, fewer than asked once the watchdog expires
+        uint32_t stepBatch(uint32_t ticks, const double* sensorRows, const double* rcRows, size_t rcStride, double* outRows);
+
+        // Sensor readings from an external simulator, the per tick form of stepBatch()'s sensor row
+        void applySensors(const double* row);
+
+        // Closes the loop through the built-in 6-DOF plant instead of update_from_plant() calls
+        void attachPlant(const SITLPlantConfig_t& config);
+
+        // Claims the vehicle for stepping, false if another thread is already stepping it
+        bool tryBeginStep();
+        void endStep();
+        bool isStepping() const;
+
+        // What the AM drives on a SITL output, from its SERVOn_FUNCTION
+        MotorFunction_e getOutputFunction(int output) const { return motors[output].function; }
+
+        // Raw telemetry records since the last call, see SITLTelemRing::Reader::read(). For one
+        // consumer thread at a time, it never blocks the stepping thread
+        size_t readTelem(uint8_t* out, size_t capacity) { return telemReader.read(out, capacity); }
+        uint64_t getTelemLostBytes() const { return telemReader.getLostBytes(); }
+
+        // pcap capture of the telemetry traffic from now on, written on a background thread
+        bool startTelemCapture(const char* path);
+        bool stopTelemCapture(uint64_t& packets, uint64_t& lostBytes); // False if none was running
+
+        ParamRegistry params;
+
+        SITL_SystemUtils sysUtils;
+        SITL_MathUtils mathUtils;
+        SITL_FFT fft;
+        SITL_FFT sysIdFft;
+        SITL_Queue<RCMotorControlMessage_t> amQueue;
+        SITL_Queue<TMMessage_t> tmQueue;
+        SITL_LogQueue logQueue;
+        SITL_Queue<SysIdLogBlock_t> sysIdLogQueue;
+        SITL_Queue<mavlink_message_t> mavlinkQueue;
+        LatestValueSlot<BatteryVoltage_t> batteryVoltage;
+
+        SITL_IWDG iwdg;
+        SITL_Logger logger;
+        SITL_RC rc;
+        SITL_PowerModule pm;
+        SITL_Barometer barometer;
+        SITLTelemRing telemRing;    // Empty without a telemetry link
+        SITL_TELEM telem;
+        SITL_IMU imu;
+        SITL_GPS gps;
+        SITL_Rangefinder rangefinder;
+        SITL_Motor sitlMotors[SITL_NUM_MOTORS];
+
+        std::unique_ptr<SystemManager> sm;
+        std::unique_ptr<TelemetryManager> tm;
+        std::unique_ptr<AttitudeManager> am;
+
+        std::unique_ptr<SITLPlant> plant; // nullptr when an external simulator feeds the sensors
+
+    private:
+        MotorInstance_t motors[SITL_NUM_MOTORS];
+        MotorGroupInstance_t motorGroup;
+
+        const int telemPort;
+        const uint32_t sitlRateHz;
+        const bool simulatedClock;
+        uint32_t smCounter;
+        uint32_t tmCounter;
+        uint32_t amCounter;
+
+        std::atomic<bool> stepping;
+
+        SITLTelemRing::Reader telemReader;
+        std::unique_ptr<SITLTelemCapture> telemCapture;
+
+        void writeOutputs(double* row);
+        void setServoParams();
+};
@@ -0,0 +1,70 @@
+"""Compare SITL steps per second with per-tick calls against step_n() blocks.
+
+The per-tick loop is what the simulator scripts do every millisecond: update_from_plant(), set_rc(),
+update() and get_motor_outputs(). step_n() takes the same sensor and RC rows as float64 blocks and
+runs a whole block per call. Both run the same vehicle setup with a fixed sensor row, so only the
+Python to C overhead differs.
+
+Usage: python step_benchmark.py [--ticks N] [--block N]
+"""
+import argparse
+import time
+import numpy as np
+import zeropilot
+
+IS_PLANE = None
+# Level, at rest at home: roll, pitch, p, q, r, lat, lon, alt, ground speed, course, fuel, rpm,
+# rangefinder, baro kPa, baro C
+SENSOR_ROW = [0.0, 0.0, 0.0, 0.0, 0.0, 43.4723, -80.5449, 330.0, 0.0, 0.0, 10.0, 0.0, 0.0, 97.4, 15.0]
+RC_ROW = [50.0, 50.0, 50.0, 0.0, 100.0, 0.0, 16.5]
+
+
+def new_vehicle():
+    return zeropilot.ZeroPilot(sim_clock=True, log=False)
+
+
+def per_tick(ticks):
+    zp = new_vehicle()
+    rc = RC_ROW if IS_PLANE else RC_ROW[:5] + RC_ROW[6:]
+    start = time.perf_counter()
+    for _ in range(ticks):
+        zp.update_from_plant(*SENSOR_ROW)
+        zp.set_rc(*rc)
+        zp.update()
+        zp.get_motor_outputs()
+    return ticks / (time.perf_counter() - start)
+
+
+def blocked(ticks, block):
+    zp = new_vehicle()
+    sensors = np.tile(np.array(SENSOR_ROW, dtype=np.float64), (block, 1))
+    rc = np.tile(np.array(RC_ROW, dtype=np.float64), (block, 1))
+    out = np.empty((block, zeropilot.OUT_COLUMNS), dtype=np.float64)
+    start = time.perf_counter()
+    for _ in range(ticks // block):
+        zp.step_n(block, sensors, rc, out)
+    return (ticks // block) * block / (time.perf_counter() - start)
+
+
+def main():
+    global IS_PLANE
+    parser = argparse.ArgumentParser(description="Benchmark per-tick SITL calls against step_n() blocks.")
+    parser.add_argument("--ticks", type=int, default=200000, help="Ticks per measurement")
+    parser.add_argument("--block", type=int, default=1000, help="Largest step_n() block")
+    args = parser.parse_args()
+
+    IS_PLANE = len(new_vehicle().get_motor_outputs()) == 6
+    assert len(SENSOR_ROW) == zeropilot.SENSOR_COLUMNS and len(RC_ROW) == zeropilot.RC_COLUMNS
+
+    baseline = per_tick(args.ticks)
+    print(f"{'per-tick calls':>16}: {baseline:10.0f} steps/s")
+
+    block = 1
+    while block <= args.block:
+        rate = blocked(args.ticks, block)
+        print(f"{f'step_n({block})':>16}: {rate:10.0f} steps/s, {rate / baseline:5.1f}x")
+        block *= 10
+
+
+if __name__ == '__main__':
+    main()
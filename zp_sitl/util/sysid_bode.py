@@ -0,0 +1,206 @@
+"""Bode plot and coherence from the SYSID binary log.
+
+Reads the SysIdLogBlock_t records SYSID writes to logN.bin on the SD card (sd_card/sitl_log.bin in
+SITL), splits them into runs, and estimates the frequency response from the injected to the measured
+signal with Welch averaged cross spectra, the same H1 = Suy / Suu estimate the vehicle computes on
+board but at the full control loop rate and over the whole run.
+
+Usage: python sysid_bode.py LOG.bin [--run N] [--window 1024] [--min-coherence 0.6] [--plot out.png]
+"""
+import argparse
+import struct
+import sys
+
+import numpy as np
+
+# Must match include/thread_msgs/sysid_log.hpp
+BLOCK_SAMPLES = 50
+SYNC = 0x5153
+BLOCK_FORMAT = '<HBBIff%df%df' % (BLOCK_SAMPLES, BLOCK_SAMPLES)
+BLOCK_SIZE = struct.calcsize(BLOCK_FORMAT)
+SYNC_BYTES = struct.pack('<H', SYNC)
+UNEXCITED_POWER_RATIO = 1e-4   # Bins with less input power than this fraction of the peak weren't swept
+
+AXIS_NAMES = {
+    1: 'INPUT_ROLL', 2: 'INPUT_PITCH', 3: 'INPUT_YAW',
+    7: 'RATE_ROLL', 8: 'RATE_PITCH', 9: 'RATE_YAW',
+    10: 'MIX_ROLL', 11: 'MIX_PITCH', 12: 'MIX_YAW',
+}
+
+
+class Run:
+    def __init__(self, axis, sample_rate_hz):
+        self.axis = axis
+        self.sample_rate_hz = sample_rate_hz
+        self.injected = []
+        self.measured = []
+        self.next_seq = 0
+        self.missing_blocks = 0
+
+
+def read_runs(path):
+    """Split the log into runs, a block with seq 0 starts a new one. Resyncs on the sync word."""
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    runs = []
+    skipped_bytes = 0
+    offset = 0
+    while offset + BLOCK_SIZE <= len(data):
+        if data[offset:offset + 2] != SYNC_BYTES:
+            nxt = data.find(SYNC_BYTES, offset + 1)
+            if nxt < 0:
+                skipped_bytes += len(data) - offset
+                break
+            skipped_bytes += nxt - offset
+            offset = nxt
+            continue
+
+        fields = struct.unpack_from(BLOCK_FORMAT, data, offset)
+        _, axis, count, seq, rate_hz, _ = fields[:6]
+        if count > BLOCK_SAMPLES or not rate_hz > 0.0:
+            # Sync word inside sample data, keep looking
+            offset += 1
+            skipped_bytes += 1
+            continue
+
+        injected = fields[6:6 + count]
+        measured = fields[6 + BLOCK_SAMPLES:6 + BLOCK_SAMPLES + count]
+
+        if seq == 0 or not runs or runs[-1].axis != axis:
+            runs.append(Run(axis, rate_hz))
+        run = runs[-1]
+        if seq != run.next_seq:
+            # Dropped blocks leave a hole, fill with zeros so the timing of the rest stays right
+            gap = max(seq - run.next_seq, 0)
+            run.missing_blocks += gap
+            run.injected.extend([0.0] * gap * BLOCK_SAMPLES)
+            run.measured.extend([0.0] * gap * BLOCK_SAMPLES)
+        run.injected.extend(injected)
+        run.measured.extend(measured)
+        run.next_seq = seq + 1
+        offset += BLOCK_SIZE
+
+    return runs, skipped_bytes
+
+
+def welch_response(u, y, sample_rate_hz, window_len):
+    """H1 estimate and coherence from Hann windowed, 50% overlapped segments."""
+    u = np.asarray(u, dtype=np.float64)
+    y = np.asarray(y, dtype=np.float64)
+    window = np.hanning(window_len)
+    step = window_len // 2
+
+    suu = np.zeros(window_len // 2 + 1)
+    syy = np.zeros(window_len // 2 + 1)
+    suy = np.zeros(window_len // 2 + 1, dtype=np.complex128)
+    segments = 0
+    for start in range(0, len(u) - window_len + 1, step):
+        us = u[start:start + window_len]
+        ys = y[start:start + window_len]
+        uf = np.fft.rfft((us - us.mean()) * window)
+        yf = np.fft.rfft((ys - ys.mean()) * window)
+        suu += np.abs(uf) ** 2
+        syy += np.abs(yf) ** 2
+        suy += np.conj(uf) * yf
+        segments += 1
+
+    freqs = np.fft.rfftfreq(window_len, 1.0 / sample_rate_hz)
+    with np.errstate(divide='ignore', invalid='ignore'):
+        h = suy / suu
+        coherence = np.abs(suy) ** 2 / (suu * syy)
+
+    # Leakage alone makes a noiseless output look coherent, zero the bins the chirp never reached
+    coherence = np.nan_to_num(coherence)
+    coherence[suu < UNEXCITED_POWER_RATIO * suu.max()] = 0.0
+
+    # Drop DC, the estimate is mean removed
+    return freqs[1:], h[1:], coherence[1:], segments
+
+
+def plot(freqs, h, coherence, min_coherence, title, out_path):
+    import matplotlib
+    if out_path:
+        matplotlib.use('Agg')
+    import matplotlib.pyplot as plt
+
+    good = coherence >= min_coherence
+    fig, (ax_gain, ax_phase, ax_coh) = plt.subplots(3, 1, sharex=True, figsize=(8, 9))
+    gain_db = 20.0 * np.log10(np.maximum(np.abs(h), 1e-12))
+    phase_deg = np.degrees(np.unwrap(np.angle(h)))
+
+    ax_gain.semilogx(freqs, gain_db, color='0.8')
+    ax_gain.semilogx(freqs[good], gain_db[good], '.')
+    ax_gain.set_ylabel('Gain (dB)')
+    ax_phase.semilogx(freqs, phase_deg, color='0.8')
+    ax_phase.semilogx(freqs[good], phase_deg[good], '.')
+    ax_phase.set_ylabel('Phase (deg)')
+    ax_coh.semilogx(freqs, coherence)
+    ax_coh.axhline(min_coherence, linestyle='--', color='r')
+    ax_coh.set_ylabel('Coherence')
+    ax_coh.set_ylim(0.0, 1.05)
+    ax_coh.set_xlabel('Frequency (Hz)')
+    for ax in (ax_gain, ax_phase, ax_coh):
+        ax.grid(True, which='both', alpha=0.3)
+    fig.suptitle(title)
+    fig.tight_layout()
+
+    if out_path:
+        fig.savefig(out_path)
+        print('Saved %s' % out_path)
+    else:
+        plt.show()
+
+
+def print_table(freqs, h, coherence, min_coherence):
+    print('%10s %10s %10s %10s' % ('freq Hz', 'gain dB', 'phase deg', 'coherence'))
+    for f, hv, c in zip(freqs, h, coherence):
+        if c < min_coherence:
+            continue
+        print('%10.3f %10.2f %10.1f %10.3f' % (f, 20.0 * np.log10(max(abs(hv), 1e-12)), np.degrees(np.angle(hv)), c))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('log', help='Binary log, logN.bin from the SD card or sd_card/sitl_log.bin')
+    parser.add_argument('--run', type=int, default=-1, help='Run index to analyse, default is the last')
+    parser.add_argument('--window', type=int, default=1024, help='Welch segment length in samples')
+    parser.add_argument('--min-coherence', type=float, default=0.6,
+                        help='Points below this are greyed out in the plot and left out of the table')
+    parser.add_argument('--plot', nargs='?', const='', default=None, metavar='OUT.png',
+                        help='Plot with matplotlib, to a file if one is given')
+    args = parser.parse_args()
+
+    runs, skipped = read_runs(args.log)
+    if not runs:
+        print('No SYSID blocks in %s' % args.log)
+        return 1
+
+    for i, run in enumerate(runs):
+        print('Run %d: %s, %d samples at %.0f Hz (%.1f s), %d missing blocks' % (
+            i, AXIS_NAMES.get(run.axis, str(run.axis)), len(run.injected), run.sample_rate_hz,
+            len(run.injected) / run.sample_rate_hz, run.missing_blocks))
+    if skipped:
+        print('Skipped %d bytes that were not SYSID blocks' % skipped)
+
+    run = runs[args.run]
+    if len(run.injected) < args.window:
+        print('Run is shorter than one %d sample window' % args.window)
+        return 1
+
+    freqs, h, coherence, segments = welch_response(run.injected, run.measured, run.sample_rate_hz, args.window)
+    title = '%s, %d segments of %d samples' % (AXIS_NAMES.get(run.axis, str(run.axis)), segments, args.window)
+    print(title)
+
+    if args.plot is not None:
+        try:
+            plot(freqs, h, coherence, args.min_coherence, title, args.plot)
+            return 0
+        except ImportError:
+            print('matplotlib not available, printing the table instead')
+    print_table(freqs, h, coherence, args.min_coherence)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
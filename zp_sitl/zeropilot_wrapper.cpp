@@ -1,374 +1,566 @@
 #include <Python.h>
-#include "zp_params.hpp"
-#include "system_manager.hpp"
-#include "telemetry_manager.hpp"
-#include "attitude_manager.hpp"
-#include "sitl_drivers/sitl_systemutils.hpp"
-#include "sitl_drivers/sitl_mathutils.hpp"
-#include "sitl_drivers/sitl_iwdg.hpp"
-#include "sitl_drivers/sitl_logger.hpp"
-#include "sitl_drivers/sitl_rc.hpp"
-#include "sitl_drivers/sitl_powermodule.hpp"
-#include "sitl_drivers/sitl_barometer.hpp"
-#include "sitl_drivers/sitl_telemlink.hpp"
-#include "sitl_drivers/sitl_imu.hpp"
-#include "sitl_drivers/sitl_gps.hpp"
-#include "sitl_drivers/sitl_queue.hpp"
-#include "sitl_drivers/sitl_logqueue.hpp"
-#include "sitl_drivers/sitl_motor.hpp"
-#include "sitl_drivers/sitl_fft.hpp"
-#include "sitl_drivers/sitl_rangefinder.hpp"
-#include <functional>
+#include "sitl_vehicle.hpp"
+#include "sitl_batch_runner.hpp"
+#include <cstring>
 #include <string>
-#include <queue>
-#include <mutex>
-
-static constexpr int SITL_NUM_MOTORS = 6;
-
-std::queue<std::string> telemTxMessages;
-std::queue<std::string> telemRxMessages;
-std::mutex telemMutex;
-
-static void telemLogCallback(const std::string& message, uint8_t direction) {
-    std::lock_guard<std::mutex> lock(telemMutex);
-    if (direction == 1) {
-        telemTxMessages.push(message);
-        if (telemTxMessages.size() > 100) {
-            telemTxMessages.pop(); // Limit the queue size to 100 messages
-        }
-    } else if (direction == 0) {
-        telemRxMessages.push(message);
-        if (telemRxMessages.size() > 100) {
-            telemRxMessages.pop();
-        }
-    }
-}
+#include <unordered_set>
+#include <vector>
 
 typedef struct {
     PyObject_HEAD
     
-    SystemManager* sm;
-    TelemetryManager* tm;
-    AttitudeManager* am;
-    
-    SITL_SystemUtils* sysUtils;
-    SITL_MathUtils* mathUtils;
-    SITL_FFT *fft;
-    SITL_Queue<RCMotorControlMessage_t>* amQueue;
-    SITL_Queue<TMMessage_t>* tmQueue;
-    SITL_LogQueue* logQueue;
-    SITL_Queue<mavlink_message_t>* mavlinkQueue;
-    
-    SITL_IWDG* iwdg;
-    SITL_Logger* logger;
-    ISafetySwitch* safetySwitch;
-    SITL_RC* rc;
-    SITL_PowerModule* pm;
-    SITL_TELEM* telem;
-    SITL_IMU* imu;
-    SITL_GPS* gps;
-    SITL_Rangefinder *rangefinder;
-    SITL_Barometer* barometer;
-    SITL_Motor* sitlMotors[SITL_NUM_MOTORS];
-    
-    MotorInstance_t motors[SITL_NUM_MOTORS];
-    MotorGroupInstance_t motorGroup;
-    
-    uint32_t sitlRateHz;
-    uint32_t smCounter;
-    uint32_t tmCounter;
-    uint32_t amCounter;
+    SITLVehicle* vehicle;
 } ZPObject;
 
 static void ZP_dealloc(ZPObject* self) {
-    delete self->sm;
-    delete self->tm;
-    delete self->am;
-    delete self->sysUtils;
-    delete self->mathUtils;
-    delete self->amQueue;
-    delete self->tmQueue;
-    delete self->logQueue;
-    delete self->mavlinkQueue;
-    delete self->iwdg;
-    delete self->logger;
-    delete self->rc;
-    delete self->pm;
-    delete self->barometer;
-    delete self->telem;
-    delete self->imu;
-    delete self->gps;
-    delete self->rangefinder;
-    for (int i = 0; i < SITL_NUM_MOTORS; i++) delete self->sitlMotors[i];
+    delete self->vehicle;
     Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
+// For methods that touch the managers, drivers or plant. Steps are only claimed with the GIL held,
+// so a vehicle that isn't stepping now can't start until the calling method returns
+static bool checkNotStepping(ZPObject* self) {
+    if (self->vehicle->isStepping()) {
+        PyErr_SetString(PyExc_RuntimeError, "ZeroPilot is being stepped by another thread");
+        return false;
+    }
+    return true;
+}
+
 static PyObject* ZP_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
     const char* ip = nullptr;
     int port = 0;
     uint32_t sitlRateHz = 1000;
+    int simClock = 0;
+    int log = 1;
+    int plant = 0;
+    unsigned int seed = 0;
    
     // Parse arguments from Python
-    static char* kwlist[] = {(char*)"sitl_rate_hz", (char*)"ip", (char*)"port", NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|isi", kwlist, &sitlRateHz, &ip, &port)) {
+    static char* kwlist[] = {(char*)"sitl_rate_hz", (char*)"ip", (char*)"port", (char*)"sim_clock", (char*)"log", (char*)"plant", (char*)"seed", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|izipppI", kwlist, &sitlRateHz, &ip, &port, &simClock, &log, &plant, &seed)) {
         return NULL;
     }
     
     ZPObject* self = (ZPObject*)type->tp_alloc(type, 0);
     if (self != NULL) {
-        ZP_PARAM::init();
-
-        self->sysUtils = new SITL_SystemUtils();
-        self->mathUtils = new SITL_MathUtils();
-        self->fft = new SITL_FFT();
-        self->amQueue = new SITL_Queue<RCMotorControlMessage_t>();
-        self->tmQueue = new SITL_Queue<TMMessage_t>();
-        self->logQueue = new SITL_LogQueue();
-        self->mavlinkQueue = new SITL_Queue<mavlink_message_t>();
-        
-        self->iwdg = new SITL_IWDG();
-        self->logger = new SITL_Logger();
-        self->safetySwitch = nullptr; // Safety switch is not used in SITL
-        self->rc = new SITL_RC();
-        self->pm = new SITL_PowerModule();
-        self->barometer = new SITL_Barometer();
-        self->telem = new SITL_TELEM(ip, port, telemLogCallback);
-        self->imu = new SITL_IMU();
-        self->gps = new SITL_GPS();
-        self->rangefinder = new SITL_Rangefinder();
-        for (int i = 0; i < SITL_NUM_MOTORS; i++) {
-            self->sitlMotors[i] = new SITL_Motor();
-            self->motors[i] = {self->sitlMotors[i]};
+        SITLVehicleConfig_t config;
+        config.sitlRateHz = sitlRateHz;
+        config.telemIp = ip;
+        config.telemPort = port;
+        config.simulatedClock = simClock != 0;
+        config.logToSdCard = log != 0;
+        self->vehicle = new SITLVehicle(config);
+
+        if (plant) {
+            SITLPlantConfig_t plantConfig;
+            plantConfig.seed = seed;
+            self->vehicle->attachPlant(plantConfig);
         }
-
-        self->motorGroup = {self->motors, SITL_NUM_MOTORS};
-
-        // Set servo params — loadServoParams() in AM constructor reads these
-        ZP_PARAM::setParamById("SERVO1_TRIM", 1500);
-        ZP_PARAM::setParamById("SERVO1_MIN", 1000);
-        ZP_PARAM::setParamById("SERVO1_MAX", 2000);
-        ZP_PARAM::setParamById("SERVO1_REVERSED", 0);
-        #ifdef PLANE
-        ZP_PARAM::setParamById("SERVO1_FUNCTION", static_cast<float>(MotorFunction_e::AILERON));
-        #endif
-        #ifdef QUADCOPTER
-        ZP_PARAM::setParamById("SERVO1_FUNCTION", static_cast<float>(MotorFunction_e::MOTOR_1));
-        #endif
-
-        ZP_PARAM::setParamById("SERVO2_TRIM", 1500);
-        ZP_PARAM::setParamById("SERVO2_MIN", 1000);
-        ZP_PARAM::setParamById("SERVO2_MAX", 2000);
-        ZP_PARAM::setParamById("SERVO2_REVERSED", 0);
-        #ifdef PLANE
-        ZP_PARAM::setParamById("SERVO2_FUNCTION", static_cast<float>(MotorFunction_e::ELEVATOR));
-        #endif
-        #ifdef QUADCOPTER
-        ZP_PARAM::setParamById("SERVO2_FUNCTION", static_cast<float>(MotorFunction_e::MOTOR_2));
-        #endif
-
-        ZP_PARAM::setParamById("SERVO3_TRIM", 1500);
-        ZP_PARAM::setParamById("SERVO3_MIN", 1000);
-        ZP_PARAM::setParamById("SERVO3_MAX", 2000);
-        ZP_PARAM::setParamById("SERVO3_REVERSED", 0);
-        #ifdef PLANE
-        ZP_PARAM::setParamById("SERVO3_FUNCTION", static_cast<float>(MotorFunction_e::THROTTLE));
-        #endif
-        #ifdef QUADCOPTER
-        ZP_PARAM::setParamById("SERVO3_FUNCTION", static_cast<float>(MotorFunction_e::MOTOR_3));
-        #endif
-
-        ZP_PARAM::setParamById("SERVO4_TRIM", 1500);
-        ZP_PARAM::setParamById("SERVO4_MIN", 1000);
-        ZP_PARAM::setParamById("SERVO4_MAX", 2000);
-        ZP_PARAM::setParamById("SERVO4_REVERSED", 0);
-        #ifdef PLANE
-        ZP_PARAM::setParamById("SERVO4_FUNCTION", static_cast<float>(MotorFunction_e::RUDDER));
-        #endif
-        #ifdef QUADCOPTER
-        ZP_PARAM::setParamById("SERVO4_FUNCTION", static_cast<float>(MotorFunction_e::MOTOR_4));
-        #endif
-
-        ZP_PARAM::setParamById("SERVO5_TRIM", 1500);
-        ZP_PARAM::setParamById("SERVO5_MIN", 1000);
-        ZP_PARAM::setParamById("SERVO5_MAX", 2000);
-        ZP_PARAM::setParamById("SERVO5_REVERSED", 0);
-        #ifdef PLANE
-        ZP_PARAM::setParamById("SERVO5_FUNCTION", static_cast<float>(MotorFunction_e::FLAP));
-        #endif
-        #ifdef QUADCOPTER
-        ZP_PARAM::setParamById("SERVO5_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED));
-        #endif
-
-        ZP_PARAM::setParamById("SERVO6_TRIM", 1500);
-        ZP_PARAM::setParamById("SERVO6_MIN", 1000);
-        ZP_PARAM::setParamById("SERVO6_MAX", 2000);
-        ZP_PARAM::setParamById("SERVO6_REVERSED", 0);
-        #ifdef PLANE
-        ZP_PARAM::setParamById("SERVO6_FUNCTION", static_cast<float>(MotorFunction_e::GROUND_STEERING));
-        #endif
-        #ifdef QUADCOPTER
-        ZP_PARAM::setParamById("SERVO6_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED));
-        #endif
-
-        ZP_PARAM::setParamById("SERVO7_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED));
-        ZP_PARAM::setParamById("SERVO8_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED));
-        ZP_PARAM::setParamById("SERVO9_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED));
-        ZP_PARAM::setParamById("SERVO10_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED));
-        ZP_PARAM::setParamById("SERVO11_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED));
-        ZP_PARAM::setParamById("SERVO12_FUNCTION", static_cast<float>(MotorFunction_e::DISABLED));
-
-        self->sm = new SystemManager(
-            self->sysUtils, self->iwdg, self->logger, self->safetySwitch, self->rc, 
-            self->pm, self->amQueue, self->tmQueue, self->logQueue
-        );
-        
-        self->tm = new TelemetryManager(
-            self->sysUtils, self->telem, self->tmQueue, self->amQueue, self->mavlinkQueue
-        );
-        
-        self->am = new AttitudeManager(
-            self->sysUtils, self->mathUtils, self->gps, self->imu, self->fft, self->rangefinder, self->barometer,
-            self->amQueue, self->tmQueue, self->logQueue,
-            &self->motorGroup
-        );
-        
-        self->sitlRateHz = sitlRateHz;
-        self->smCounter = 0;
-        self->tmCounter = 0;
-        self->amCounter = 0;
     }
     return (PyObject*)self;
 }
 
 static PyObject* ZP_updateFromPlant(ZPObject* self, PyObject* args) {
-    double roll_rad, pitch_rad;
-    double p_rad_s, q_rad_s, r_rad_s;
-    double lat_deg, lon_deg, alt_m, ground_speed_mps, course_deg;
-    float fuel_lbs, rpm;
-    float rangefinder_alt;
-    double baro_pressure_kpa, baro_temp_c;
-
-    if (!PyArg_ParseTuple(args, "ddddddddddfffdd",
-        &roll_rad, &pitch_rad,
-        &p_rad_s, &q_rad_s, &r_rad_s,
-        &lat_deg, &lon_deg, &alt_m, &ground_speed_mps, &course_deg,
-        &fuel_lbs, &rpm,
-        &rangefinder_alt,
-        &baro_pressure_kpa, &baro_temp_c))
-        return NULL;
-
-    self->imu->update_from_plant(roll_rad, pitch_rad, p_rad_s, q_rad_s, r_rad_s);
-    self->gps->update_from_plant(lat_deg, lon_deg, alt_m, ground_speed_mps, course_deg);
-    self->pm->update_from_plant(fuel_lbs, rpm);
-    self->rangefinder->update_from_plant(rangefinder_alt);
-    self->barometer->update_from_plant(baro_pressure_kpa, baro_temp_c);
+    if (!checkNotStepping(self))
+        return NULL;
+
+    double row[SITL_SENSOR_COLUMNS];
+
+    if (!PyArg_ParseTuple(args, "ddddddddddddddd",
+        &row[SITL_SENSOR_ROLL_RAD], &row[SITL_SENSOR_PITCH_RAD],
+        &row[SITL_SENSOR_P_RADPS], &row[SITL_SENSOR_Q_RADPS], &row[SITL_SENSOR_R_RADPS],
+        &row[SITL_SENSOR_LAT_DEG], &row[SITL_SENSOR_LON_DEG], &row[SITL_SENSOR_ALT_M],
+        &row[SITL_SENSOR_GROUND_SPEED_MPS], &row[SITL_SENSOR_COURSE_DEG],
+        &row[SITL_SENSOR_FUEL_LBS], &row[SITL_SENSOR_RPM],
+        &row[SITL_SENSOR_RANGEFINDER_M],
+        &row[SITL_SENSOR_BARO_KPA], &row[SITL_SENSOR_BARO_TEMP_C]))
+        return NULL;
+
+    self->vehicle->applySensors(row);
     
     Py_RETURN_NONE;
 }
 
+static PyObject* ZP_feedGps(ZPObject* self, PyObject* args) {
+    if (!checkNotStepping(self))
+        return NULL;
+
+    Py_buffer buf;
+    if (!PyArg_ParseTuple(args, "y*", &buf))
+        return NULL;
+
+    const uint8_t *data = static_cast<const uint8_t *>(buf.buf);
+    Py_ssize_t remaining = buf.len;
+    while (remaining > 0) {
+        uint16_t chunk = remaining > UINT16_MAX ? UINT16_MAX : (uint16_t)remaining;
+        self->vehicle->gps.feed(data, chunk);
+        data += chunk;
+        remaining -= chunk;
+    }
+    PyBuffer_Release(&buf);
+
+    const GpsParserStats_t &stats = self->vehicle->gps.get_stats();
+    return Py_BuildValue("{s:I,s:I,s:I,s:I}",
+        "frames_ok", stats.framesOk,
+        "crc_errors", stats.crcErrors,
+        "dropped_frames", stats.droppedFrames,
+        "dropped_bytes", stats.droppedBytes);
+}
+
 static PyObject* ZP_setBatteryCapacity(ZPObject* self, PyObject* args) {
+    if (!checkNotStepping(self))
+        return NULL;
+
     float capacity;
     if (!PyArg_ParseTuple(args, "f", &capacity))
         return NULL;
-    self->pm->set_max_batt_capacity(capacity);
+    self->vehicle->pm.set_max_batt_capacity(capacity);
     Py_RETURN_NONE;
 }
 
 static PyObject* ZP_setRC(ZPObject* self, PyObject* args) {
+    if (!checkNotStepping(self))
+        return NULL;
+
     #ifdef PLANE
     float roll, pitch, yaw, throttle, arm, flap, fltmode;
     if (!PyArg_ParseTuple(args, "fffffff", &roll, &pitch, &yaw, &throttle, &arm, &flap, &fltmode))
         return NULL;
 
-    self->rc->update_from_commands(roll, pitch, yaw, throttle, arm, flap, fltmode);
+    self->vehicle->rc.update_from_commands(roll, pitch, yaw, throttle, arm, flap, fltmode);
     #endif
     #ifdef QUADCOPTER
     float roll, pitch, yaw, throttle, arm, fltmode;
     if (!PyArg_ParseTuple(args, "ffffff", &roll, &pitch, &yaw, &throttle, &arm, &fltmode))
         return NULL;
 
-    self->rc->update_from_commands(roll, pitch, yaw, throttle, arm, 0.0f, fltmode);
+    self->vehicle->rc.update_from_commands(roll, pitch, yaw, throttle, arm, 0.0f, fltmode);
     #endif
     
     Py_RETURN_NONE;
 }
 
-static PyObject* ZP_update(ZPObject* self, PyObject* args) {
-    if (self->smCounter % (self->sitlRateHz / SM_SCHEDULING_RATE_HZ) == 0) {
-        self->sm->smUpdate();
+static PyObject* ZP_setRCFastPath(ZPObject* self, PyObject* args) {
+    if (!checkNotStepping(self))
+        return NULL;
+
+    int enabled;
+    if (!PyArg_ParseTuple(args, "p", &enabled))
+        return NULL;
+    self->vehicle->rc.set_fast_path_enabled(enabled != 0);
+    Py_RETURN_NONE;
+}
+
+static PyObject* ZP_setParam(ZPObject* self, PyObject* args) {
+    if (!checkNotStepping(self))
+        return NULL;
+
+    const char* paramId;
+    float value;
+    if (!PyArg_ParseTuple(args, "sf", &paramId, &value))
+        return NULL;
+
+    #ifdef QUADCOPTER
+    // The plant only has SITL_NUM_MOTORS outputs to fly a frame with
+    bool isFrameClass = strcmp(paramId, "FRAME_CLASS") == 0;
+    if (isFrameClass || strcmp(paramId, "FRAME_TYPE") == 0) {
+        float frameClass = isFrameClass ? value : self->vehicle->params.get(ZP_PARAM_ID::FRAME_CLASS);
+        float frameType = isFrameClass ? self->vehicle->params.get(ZP_PARAM_ID::FRAME_TYPE) : value;
+        const MixerFrame_t *frame = MotorMixing::frameFor(static_cast<FrameClass_e>(static_cast<int>(frameClass)),
+            static_cast<FrameType_e>(static_cast<int>(frameType)));
+        if (frame != nullptr && frame->motorCount > SITL_NUM_MOTORS) {
+            PyErr_Format(PyExc_ValueError, "%s %d picks a %d motor frame, SITL has %d motor outputs",
+                paramId, static_cast<int>(value), frame->motorCount, SITL_NUM_MOTORS);
+            return NULL;
+        }
     }
-    
-    if (self->tmCounter % (self->sitlRateHz / TM_SCHEDULING_RATE_HZ) == 0) {
-        self->tm->tmUpdate();
+    #endif
+
+    // Same path as a MAVLink PARAM_SET, callbacks may reject the value
+    if (self->vehicle->params.setParamById(paramId, value)) {
+        Py_RETURN_TRUE;
     }
-    
-    if (self->amCounter % (self->sitlRateHz / AM_SCHEDULING_RATE_HZ) == 0) {
-        self->am->amUpdate();
+    Py_RETURN_FALSE;
+}
+
+static PyObject* ZP_getParam(ZPObject* self, PyObject* args) {
+    if (!checkNotStepping(self))
+        return NULL;
+
+    const char* paramId;
+    if (!PyArg_ParseTuple(args, "s", &paramId))
+        return NULL;
+
+    const Param_t* param = self->vehicle->params.getParamByIndex(self->vehicle->params.getIndexById(paramId));
+    if (param == nullptr) {
+        PyErr_Format(PyExc_KeyError, "unknown param %s", paramId);
+        return NULL;
+    }
+    return PyFloat_FromDouble(param->paramValue);
+}
+
+#ifdef QUADCOPTER
+static PyObject* ZP_getAutotuneStatus(ZPObject* self, PyObject* args) {
+    if (!checkNotStepping(self))
+        return NULL;
+
+    static constexpr const char* AXIS_NAMES[PID3_AXES] = {"roll", "pitch", "yaw"};
+    static constexpr const char* STATUS_NAMES[] = {"pending", "tuning", "converged", "failed", "skipped"};
+
+    const AutotuneMapping& autotune = self->vehicle->am->getAutotune();
+    PyObject* axes = PyDict_New();
+    for (uint8_t i = 0; i < PID3_AXES; i++) {
+        const AutotuneAxisResult_t& result = autotune.getAxisResult(static_cast<PIDAxis_e>(i));
+        PyObject* axis = Py_BuildValue("{s:s,s:i,s:d,s:d,s:d,s:d,s:d,s:d,s:d}",
+            "status", STATUS_NAMES[static_cast<uint8_t>(result.status)],
+            "twitches", result.twitches,
+            "elapsed_s", result.elapsedS,
+            "plant_gain", result.plantGain,
+            "delay_s", result.delayS,
+            "kp", result.kp,
+            "ki", result.ki,
+            "kd", result.kd,
+            "angle_kp", result.angleKp);
+        PyDict_SetItemString(axes, AXIS_NAMES[i], axis);
+        Py_DECREF(axis);
+    }
+
+    PyObject* status = Py_BuildValue("{s:O,s:N}", "complete", autotune.isComplete() ? Py_True : Py_False, "axes", axes);
+    return status;
+}
+#endif
+
+static PyObject* ZP_getSysIdResponse(ZPObject* self, PyObject* args) {
+    if (!checkNotStepping(self))
+        return NULL;
+
+    const SysIdMapping& sysid = self->vehicle->am->getSysId();
+    const FrequencyResponse& response = sysid.getResponse();
+
+    PyObject* points = PyList_New(0);
+    for (uint16_t bin = 1; bin < FrequencyResponse::BIN_COUNT; bin++) {
+        FrequencyResponsePoint_t point;
+        if (!response.getPoint(bin, point)) continue;
+        PyObject* entry = Py_BuildValue("(dddd)", point.freqHz, point.gain, point.phaseDeg, point.coherence);
+        PyList_Append(points, entry);
+        Py_DECREF(entry);
+    }
+
+    return Py_BuildValue("{s:i,s:O,s:O,s:i,s:N}",
+        "axis", static_cast<int>(sysid.getAxis()),
+        "running", sysid.isRunning() ? Py_True : Py_False,
+        "complete", sysid.isComplete() ? Py_True : Py_False,
+        "windows", response.getWindowCount(),
+        "points", points);
+}
+
+static PyObject* ZP_update(ZPObject* self, PyObject* args) {
+    unsigned int ticks = 1;
+    if (!PyArg_ParseTuple(args, "|I", &ticks))
+        return NULL;
+
+    if (!self->vehicle->tryBeginStep()) {
+        PyErr_SetString(PyExc_RuntimeError, "ZeroPilot is already being stepped by another thread");
+        return NULL;
     }
-    
-    self->smCounter++;
-    self->tmCounter++;
-    self->amCounter++;
 
-    if (self->iwdg->check_watchdog() == false) {
+    // Managers never call back into Python, other threads run while this vehicle steps
+    bool healthy = true;
+    Py_BEGIN_ALLOW_THREADS
+    for (unsigned int tick = 0; tick < ticks && healthy; tick++) {
+        healthy = self->vehicle->update();
+    }
+    Py_END_ALLOW_THREADS
+    self->vehicle->endStep();
+
+    if (!healthy) {
         Py_RETURN_FALSE; // Report false if watchdog times out
     }
     
     Py_RETURN_TRUE;
 }
 
+// Borrows a C-contiguous float64 block of rows x columns. None leaves view->buf null. With
+// allowOneRow a single row is also accepted and *rowStride comes back 0 so it is held every tick
+static bool getBlock(PyObject* obj, Py_buffer* view, const char* name, uint32_t rows, size_t columns,
+                     bool writable, bool allowOneRow, size_t* rowStride) {
+    view->buf = nullptr;
+    if (obj == Py_None) return true;
+
+    int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+    if (PyObject_GetBuffer(obj, view, flags) < 0) return false;
+
+    const char* format = view->format != nullptr ? view->format : "B";
+    bool isDouble = view->itemsize == sizeof(double) && (strcmp(format, "d") == 0 || strcmp(format, "@d") == 0 || strcmp(format, "=d") == 0);
+    Py_ssize_t count = view->len / static_cast<Py_ssize_t>(sizeof(double));
+    Py_ssize_t fullCount = static_cast<Py_ssize_t>(rows) * static_cast<Py_ssize_t>(columns);
+
+    if (!isDouble) {
+        PyErr_Format(PyExc_TypeError, "%s must be a contiguous float64 buffer", name);
+    } else if (count == fullCount) {
+        if (rowStride != nullptr) *rowStride = columns;
+        return true;
+    } else if (allowOneRow && count == static_cast<Py_ssize_t>(columns)) {
+        *rowStride = 0;
+        return true;
+    } else {
+        PyErr_Format(PyExc_ValueError, "%s holds %zd values, expected %u rows of %zu", name, count, rows, columns);
+    }
+
+    PyBuffer_Release(view);
+    view->buf = nullptr;
+    return false;
+}
+
+static void releaseBlock(Py_buffer* view) {
+    if (view->buf != nullptr) PyBuffer_Release(view);
+}
+
+static PyObject* ZP_stepN(ZPObject* self, PyObject* args) {
+    unsigned int ticks;
+    PyObject* sensorObj;
+    PyObject* rcObj;
+    PyObject* outObj;
+    if (!PyArg_ParseTuple(args, "IOOO", &ticks, &sensorObj, &rcObj, &outObj))
+        return NULL;
+
+    if (sensorObj != Py_None && self->vehicle->plant) {
+        PyErr_SetString(PyExc_ValueError, "sensor_block must be None when the built-in plant feeds the sensors");
+        return NULL;
+    }
+
+    Py_buffer sensors, rc, out;
+    size_t rcStride = 0;
+    if (!getBlock(sensorObj, &sensors, "sensor_block", ticks, SITL_SENSOR_COLUMNS, false, false, nullptr))
+        return NULL;
+    if (!getBlock(rcObj, &rc, "rc_block", ticks, SITL_RC_COLUMNS, false, true, &rcStride)) {
+        releaseBlock(&sensors);
+        return NULL;
+    }
+    if (!getBlock(outObj, &out, "out_block", ticks, SITL_OUT_COLUMNS, true, false, nullptr)) {
+        releaseBlock(&sensors);
+        releaseBlock(&rc);
+        return NULL;
+    }
+
+    if (!self->vehicle->tryBeginStep()) {
+        releaseBlock(&sensors);
+        releaseBlock(&rc);
+        releaseBlock(&out);
+        PyErr_SetString(PyExc_RuntimeError, "ZeroPilot is already being stepped by another thread");
+        return NULL;
+    }
+
+    // The exported buffers can't be resized or freed until released, so the GIL isn't needed to read them
+    uint32_t ran;
+    Py_BEGIN_ALLOW_THREADS
+    ran = self->vehicle->stepBatch(ticks, static_cast<const double*>(sensors.buf), static_cast<const double*>(rc.buf),
+                                   rcStride, static_cast<double*>(out.buf));
+    Py_END_ALLOW_THREADS
+    self->vehicle->endStep();
+
+    releaseBlock(&sensors);
+    releaseBlock(&rc);
+    releaseBlock(&out);
+
+    return PyLong_FromUnsignedLong(ran); // Less than n once the watchdog expired
+}
+
 static PyObject* ZP_getMotorOutputs(ZPObject* self, PyObject* args) {
+    if (!checkNotStepping(self))
+        return NULL;
+
     // Motors indexed by servo param order: aileron, elevator, throttle, rudder, flap, steering
 
     #ifdef PLANE 
-    uint32_t roll = self->sitlMotors[0]->get();
-    uint32_t pitch = self->sitlMotors[1]->get();
-    uint32_t throttle = self->sitlMotors[2]->get();
-    uint32_t yaw = self->sitlMotors[3]->get();
-    uint32_t flap = self->sitlMotors[4]->get();
-    uint32_t steer = self->sitlMotors[5]->get();
-
-    return Py_BuildValue("(iiiiii)", roll, pitch, yaw, throttle, flap, steer);
+    float roll = self->vehicle->sitlMotors[0].get();
+    float pitch = self->vehicle->sitlMotors[1].get();
+    float throttle = self->vehicle->sitlMotors[2].get();
+    float yaw = self->vehicle->sitlMotors[3].get();
+    float flap = self->vehicle->sitlMotors[4].get();
+    float steer = self->vehicle->sitlMotors[5].get();
+
+    return Py_BuildValue("(dddddd)", roll, pitch, yaw, throttle, flap, steer);
     #endif
 
     #ifdef QUADCOPTER
-    uint32_t motor_1 = self->sitlMotors[0]->get();
-    uint32_t motor_2 = self->sitlMotors[1]->get();
-    uint32_t motor_3 = self->sitlMotors[2]->get();
-    uint32_t motor_4 = self->sitlMotors[3]->get();
+    float motor_1 = self->vehicle->sitlMotors[0].get();
+    float motor_2 = self->vehicle->sitlMotors[1].get();
+    float motor_3 = self->vehicle->sitlMotors[2].get();
+    float motor_4 = self->vehicle->sitlMotors[3].get();
 
-    return Py_BuildValue("(iiii)", motor_1, motor_2, motor_3, motor_4);
+    return Py_BuildValue("(dddd)", motor_1, motor_2, motor_3, motor_4);
     #endif
 }
 
+// Hex is only formatted here, on request, the stepping thread just copies raw bytes into the ring
 static PyObject* ZP_getTelemMessages(ZPObject* self, PyObject* args) {
-    std::lock_guard<std::mutex> lock(telemMutex);
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    std::vector<uint8_t> records(SITL_TELEM_MAX_RECORD_BYTES * 4);
+    std::string hex;
+
     PyObject* list = PyList_New(0);
+    size_t bytes;
+    while ((bytes = self->vehicle->readTelem(records.data(), records.size())) > 0) {
+        for (size_t offset = 0; offset < bytes;) {
+            SITLTelemRecordHeader_t header;
+            memcpy(&header, &records[offset], sizeof(header));
+            const uint8_t* payload = &records[offset + sizeof(header)];
+            offset += sizeof(header) + header.length;
+
+            // Same "XX XX ... XX\n" form the dashboard has always decoded
+            hex.clear();
+            for (uint32_t i = 0; i < header.length; i++) {
+                if (i > 0) hex += ' ';
+                hex += HEX_DIGITS[payload[i] >> 4];
+                hex += HEX_DIGITS[payload[i] & 0x0F];
+            }
+            hex += '\n';
+
+            PyObject* tuple = Py_BuildValue("(is)", header.direction, hex.c_str());
+            PyList_Append(list, tuple);
+            Py_DECREF(tuple);
+        }
+    }
 
-    while (!telemTxMessages.empty()) {
-        PyObject* tuple = Py_BuildValue("(is)", 1, telemTxMessages.front().c_str());
-        PyList_Append(list, tuple);
-        Py_DECREF(tuple);
-        telemTxMessages.pop();
+    return list;
+}
+
+static PyObject* ZP_readTelem(ZPObject* self, PyObject* args) {
+    Py_buffer buf;
+    if (!PyArg_ParseTuple(args, "w*", &buf))
+        return NULL;
+
+    if (static_cast<size_t>(buf.len) < SITL_TELEM_MAX_RECORD_BYTES) {
+        PyBuffer_Release(&buf);
+        PyErr_Format(PyExc_ValueError, "buffer must hold at least %zu bytes", SITL_TELEM_MAX_RECORD_BYTES);
+        return NULL;
     }
-    
-    while (!telemRxMessages.empty()) {
-        PyObject* tuple = Py_BuildValue("(is)", 0, telemRxMessages.front().c_str());
-        PyList_Append(list, tuple);
-        Py_DECREF(tuple);
-        telemRxMessages.pop();
+
+    size_t bytes = self->vehicle->readTelem(static_cast<uint8_t*>(buf.buf), static_cast<size_t>(buf.len));
+    PyBuffer_Release(&buf);
+    return PyLong_FromSize_t(bytes);
+}
+
+static PyObject* ZP_getTelemStats(ZPObject* self, PyObject* args) {
+    const SITLTelemRing& ring = self->vehicle->telemRing;
+    return Py_BuildValue("{s:K,s:K,s:K,s:K}",
+        "records", static_cast<unsigned long long>(ring.getRecordCount()),
+        "bytes", static_cast<unsigned long long>(ring.getByteCount()),
+        "oversized", static_cast<unsigned long long>(ring.getOversizeCount()),
+        "lost_bytes", static_cast<unsigned long long>(self->vehicle->getTelemLostBytes()));
+}
+
+static PyObject* ZP_startTelemCapture(ZPObject* self, PyObject* args) {
+    const char* path;
+    if (!PyArg_ParseTuple(args, "s", &path))
+        return NULL;
+
+    if (!self->vehicle->telemRing.isEnabled()) {
+        PyErr_SetString(PyExc_RuntimeError, "telemetry capture needs a telemetry link, create the ZeroPilot with an ip");
+        return NULL;
+    }
+    if (!self->vehicle->startTelemCapture(path)) {
+        PyErr_Format(PyExc_OSError, "could not open capture file %s", path);
+        return NULL;
     }
+    Py_RETURN_NONE;
+}
 
-    return list;
+static PyObject* ZP_stopTelemCapture(ZPObject* self, PyObject* args) {
+    uint64_t packets = 0;
+    uint64_t lostBytes = 0;
+    if (!self->vehicle->stopTelemCapture(packets, lostBytes)) {
+        Py_RETURN_NONE;
+    }
+    return Py_BuildValue("{s:K,s:K}",
+        "packets", static_cast<unsigned long long>(packets),
+        "lost_bytes", static_cast<unsigned long long>(lostBytes));
+}
+
+static PyObject* ZP_getPlantState(ZPObject* self, PyObject* args) {
+    if (!checkNotStepping(self))
+        return NULL;
+
+    if (!self->vehicle->plant) {
+        Py_RETURN_NONE;
+    }
+
+    const SITLPlantState_t& state = self->vehicle->plant->getState();
+    return Py_BuildValue("{s:(ddd),s:(ddd),s:d,s:d,s:d,s:(ddd),s:(ddd),s:d,s:d,s:O}",
+        "position_ned_m", state.positionNedM[0], state.positionNedM[1], state.positionNedM[2],
+        "velocity_ned_mps", state.velocityNedMps[0], state.velocityNedMps[1], state.velocityNedMps[2],
+        "roll_rad", state.rollRad,
+        "pitch_rad", state.pitchRad,
+        "yaw_rad", state.yawRad,
+        "rates_radps", state.ratesRadps[0], state.ratesRadps[1], state.ratesRadps[2],
+        "specific_force_mps2", state.specificForceMps2[0], state.specificForceMps2[1], state.specificForceMps2[2],
+        "airspeed_mps", state.airspeedMps,
+        "battery_remaining_mah", state.batteryRemainingMah,
+        "on_ground", state.onGround ? Py_True : Py_False);
+}
+
+static PyObject* ZP_setWind(ZPObject* self, PyObject* args) {
+    if (!checkNotStepping(self))
+        return NULL;
+
+    double north, east, down;
+    if (!PyArg_ParseTuple(args, "ddd", &north, &east, &down))
+        return NULL;
+
+    if (!self->vehicle->plant) {
+        PyErr_SetString(PyExc_RuntimeError, "ZeroPilot was created without plant=True");
+        return NULL;
+    }
+    self->vehicle->plant->setWind(north, east, down);
+    Py_RETURN_NONE;
+}
+
+static PyObject* ZP_setMotorEfficiency(ZPObject* self, PyObject* args) {
+    if (!checkNotStepping(self))
+        return NULL;
+
+    int motor;
+    double efficiency;
+    if (!PyArg_ParseTuple(args, "id", &motor, &efficiency))
+        return NULL;
+
+    if (!self->vehicle->plant) {
+        PyErr_SetString(PyExc_RuntimeError, "ZeroPilot was created without plant=True");
+        return NULL;
+    }
+    if (motor < 0 || motor >= SITL_PLANT_MAX_MOTORS) {
+        PyErr_SetString(PyExc_IndexError, "Motor index out of range");
+        return NULL;
+    }
+    self->vehicle->plant->setMotorEfficiency(static_cast<uint8_t>(motor), efficiency);
+    Py_RETURN_NONE;
 }
 
 static PyMethodDef ZP_methods[] = {
     {"update_from_plant", (PyCFunction)ZP_updateFromPlant, METH_VARARGS, "Update sensors from plant"},
+    {"feed_gps", (PyCFunction)ZP_feedGps, METH_VARARGS, "Feed raw UBX/NMEA bytes to the GPS, returns parser counters"},
     {"set_max_batt_capacity", (PyCFunction)ZP_setBatteryCapacity, METH_VARARGS, "Set max battery capacity"},
     {"set_rc", (PyCFunction)ZP_setRC, METH_VARARGS, "Set RC commands"},
-    {"update", (PyCFunction)ZP_update, METH_NOARGS, "Run all managers"},
+    {"set_rc_fast_path", (PyCFunction)ZP_setRCFastPath, METH_VARARGS, "Enable or disable the receiver to AM stick fast path"},
+    {"set_param", (PyCFunction)ZP_setParam, METH_VARARGS, "Set a param by name, returns False if rejected"},
+    {"get_param", (PyCFunction)ZP_getParam, METH_VARARGS, "Get a param by name"},
+    #ifdef QUADCOPTER
+    {"get_autotune_status", (PyCFunction)ZP_getAutotuneStatus, METH_NOARGS, "Get AUTOTUNE progress and results per axis"},
+    #endif
+    {"get_sysid_response", (PyCFunction)ZP_getSysIdResponse, METH_NOARGS, "Get the SYSID state and on-board frequency response (freq, gain, phase, coherence)"},
+    {"update", (PyCFunction)ZP_update, METH_VARARGS, "Run all managers, optionally for several ticks"},
+    {"step_n", (PyCFunction)ZP_stepN, METH_VARARGS, "Run n ticks from float64 sensor and RC row blocks into an output block, returns the ticks run"},
     {"get_motor_outputs", (PyCFunction)ZP_getMotorOutputs, METH_NOARGS, "Get motor outputs"},
-    {"get_telem_messages", (PyCFunction)ZP_getTelemMessages, METH_NOARGS, "Get TELEM messages"},
+    {"get_telem_messages", (PyCFunction)ZP_getTelemMessages, METH_NOARGS, "Get TELEM messages as (direction, hex string) tuples"},
+    {"read_telem", (PyCFunction)ZP_readTelem, METH_VARARGS, "Copy raw TELEM records into a writable buffer, returns the bytes written"},
+    {"get_telem_stats", (PyCFunction)ZP_getTelemStats, METH_NOARGS, "Get TELEM ring counters"},
+    {"start_telem_capture", (PyCFunction)ZP_startTelemCapture, METH_VARARGS, "Write TELEM traffic to a pcap file from now on"},
+    {"stop_telem_capture", (PyCFunction)ZP_stopTelemCapture, METH_NOARGS, "Finish the pcap capture, returns its counters or None"},
+    {"get_plant_state", (PyCFunction)ZP_getPlantState, METH_NOARGS, "Get the built-in plant's state, None without a plant"},
+    {"set_wind", (PyCFunction)ZP_setWind, METH_VARARGS, "Set the built-in plant's wind (north, east, down m/s)"},
+    {"set_motor_efficiency", (PyCFunction)ZP_setMotorEfficiency, METH_VARARGS, "Scale a motor's thrust in the built-in plant, 0 = failed"},
     {NULL}
 };
 
@@ -386,6 +578,115 @@ static PyTypeObject ZPType = {
     ZP_new,
 };
 
+typedef struct {
+    PyObject_HEAD
+
+    SITLBatchRunner* runner;
+} BatchRunnerObject;
+
+static void BatchRunner_dealloc(BatchRunnerObject* self) {
+    delete self->runner;
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* BatchRunner_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    unsigned int threads = 0;
+
+    static char* kwlist[] = {(char*)"threads", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|I", kwlist, &threads)) {
+        return NULL;
+    }
+
+    BatchRunnerObject* self = (BatchRunnerObject*)type->tp_alloc(type, 0);
+    if (self != NULL) {
+        self->runner = new SITLBatchRunner(threads);
+    }
+    return (PyObject*)self;
+}
+
+static PyObject* BatchRunner_run(BatchRunnerObject* self, PyObject* args) {
+    PyObject* list;
+    unsigned int ticks;
+    if (!PyArg_ParseTuple(args, "O!I", &PyList_Type, &list, &ticks))
+        return NULL;
+
+    // Another thread can clear or shrink the list while the GIL is released, the tuple holds a
+    // reference to every vehicle until the run is over
+    PyObject* items = PySequence_Tuple(list);
+    if (items == NULL)
+        return NULL;
+
+    Py_ssize_t count = PyTuple_GET_SIZE(items);
+    std::vector<SITLVehicle*> vehicles;
+    vehicles.reserve(count);
+    std::unordered_set<SITLVehicle*> seen;
+    for (Py_ssize_t i = 0; i < count; i++) {
+        PyObject* item = PyTuple_GET_ITEM(items, i);
+        if (!PyObject_TypeCheck(item, &ZPType)) {
+            Py_DECREF(items);
+            PyErr_SetString(PyExc_TypeError, "BatchRunner.run takes a list of ZeroPilot objects");
+            return NULL;
+        }
+        SITLVehicle* vehicle = ((ZPObject*)item)->vehicle;
+        if (!seen.insert(vehicle).second) {
+            Py_DECREF(items);
+            PyErr_SetString(PyExc_ValueError, "The same ZeroPilot appears twice in the list");
+            return NULL;
+        }
+        vehicles.push_back(vehicle);
+    }
+
+    // Claim every vehicle up front so a Python thread can't step one mid run
+    for (size_t i = 0; i < vehicles.size(); i++) {
+        if (!vehicles[i]->tryBeginStep()) {
+            for (size_t j = 0; j < i; j++) {
+                vehicles[j]->endStep();
+            }
+            Py_DECREF(items);
+            PyErr_SetString(PyExc_RuntimeError, "A ZeroPilot in the list is already being stepped by another thread");
+            return NULL;
+        }
+    }
+
+    std::unique_ptr<bool[]> healthy(new bool[vehicles.size()]);
+    Py_BEGIN_ALLOW_THREADS
+    self->runner->run(vehicles.data(), healthy.get(), vehicles.size(), ticks);
+    Py_END_ALLOW_THREADS
+
+    PyObject* result = PyList_New(count);
+    for (size_t i = 0; i < vehicles.size(); i++) {
+        vehicles[i]->endStep();
+        PyList_SET_ITEM(result, i, PyBool_FromLong(healthy[i]));
+    }
+    Py_DECREF(items);
+
+    return result;
+}
+
+static PyObject* BatchRunner_getThreadCount(BatchRunnerObject* self, PyObject* args) {
+    return PyLong_FromUnsignedLong(self->runner->getThreadCount());
+}
+
+static PyMethodDef BatchRunner_methods[] = {
+    {"run", (PyCFunction)BatchRunner_run, METH_VARARGS, "Run ticks updates of every ZeroPilot in the list in parallel, returns each one's watchdog health"},
+    {"get_thread_count", (PyCFunction)BatchRunner_getThreadCount, METH_NOARGS, "Get the number of worker threads"},
+    {NULL}
+};
+
+static PyTypeObject BatchRunnerType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "zeropilot.BatchRunner",
+    sizeof(BatchRunnerObject),
+    0,
+    (destructor)BatchRunner_dealloc,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    Py_TPFLAGS_DEFAULT,
+    0, 0, 0, 0, 0, 0, 0,
+    BatchRunner_methods,
+    0, 0, 0, 0, 0, 0, 0, 0, 0,
+    BatchRunner_new,
+};
+
 static PyModuleDef zp_module = {
     PyModuleDef_HEAD_INIT,
     "zeropilot",
@@ -398,6 +699,8 @@ PyMODINIT_FUNC PyInit_zeropilot(void) {
     PyObject* m;
     if (PyType_Ready(&ZPType) < 0)
         return NULL;
+    if (PyType_Ready(&BatchRunnerType) < 0)
+        return NULL;
     
     m = PyModule_Create(&zp_module);
     if (m == NULL)
@@ -405,5 +708,17 @@ PyMODINIT_FUNC PyInit_zeropilot(void) {
     
     Py_INCREF(&ZPType);
     PyModule_AddObject(m, "ZeroPilot", (PyObject*)&ZPType);
+    Py_INCREF(&BatchRunnerType);
+    PyModule_AddObject(m, "BatchRunner", (PyObject*)&BatchRunnerType);
+
+    // Row widths of the step_n() blocks
+    PyModule_AddIntConstant(m, "SENSOR_COLUMNS", SITL_SENSOR_COLUMNS);
+    PyModule_AddIntConstant(m, "RC_COLUMNS", SITL_RC_COLUMNS);
+    PyModule_AddIntConstant(m, "OUT_COLUMNS", SITL_OUT_COLUMNS);
+    PyModule_AddIntConstant(m, "OUT_PLANT_STATE", SITL_OUT_POS_N_M);
+
+    // read_telem() record framing
+    PyModule_AddIntConstant(m, "TELEM_RECORD_HEADER_BYTES", sizeof(SITLTelemRecordHeader_t));
+    PyModule_AddIntConstant(m, "TELEM_MAX_RECORD_BYTES", SITL_TELEM_MAX_RECORD_BYTES);
     return m;
 }